@@ -0,0 +1,133 @@
+// bench/BenchProbes.cpp
+//
+// Implementation of FrameProbe / ProcessUsage – see BenchProbes.h.
+
+#include "BenchProbes.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#ifdef Q_OS_LINUX
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace hmi::bench {
+
+// ---------------------------------------------------------------------------
+// SampleSeries
+// ---------------------------------------------------------------------------
+QJsonObject SampleSeries::toJson() const
+{
+    QJsonObject out;
+    out[QStringLiteral("count")] = m_samples.size();
+    if (m_samples.isEmpty()) {
+        return out;
+    }
+
+    QVector<double> sorted = m_samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto at = [&sorted](double p) {
+        const auto i = static_cast<int>(std::ceil(p * double(sorted.size()))) - 1;
+        return sorted[std::clamp(i, 0, int(sorted.size()) - 1)];
+    };
+    out[QStringLiteral("mean")] =
+        std::accumulate(sorted.begin(), sorted.end(), 0.0) / double(sorted.size());
+    out[QStringLiteral("p50")] = at(0.50);
+    out[QStringLiteral("p95")] = at(0.95);
+    out[QStringLiteral("p99")] = at(0.99);
+    out[QStringLiteral("max")] = sorted.last();
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// FrameProbe
+// ---------------------------------------------------------------------------
+FrameProbe::FrameProbe(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(kIntervalMs);
+    connect(&m_timer, &QTimer::timeout, this, &FrameProbe::tick);
+}
+
+void FrameProbe::addWindow(const QString& name, QWidget* window)
+{
+    m_windows.append(Window{ name, window, {} });
+}
+
+void FrameProbe::start()
+{
+    m_sinceTick.start();
+    m_timer.start();
+}
+
+void FrameProbe::stop()
+{
+    m_timer.stop();
+}
+
+void FrameProbe::reset()
+{
+    for (Window& w : m_windows) {
+        w.paintMs.clear();
+    }
+    m_latenessMs.clear();
+    m_sinceTick.restart();
+}
+
+void FrameProbe::tick()
+{
+    const double sinceMs = double(m_sinceTick.nsecsElapsed()) / 1e6;
+    m_latenessMs.add(std::max(0.0, sinceMs - kIntervalMs));
+
+    QElapsedTimer paint;
+    for (Window& w : m_windows) {
+        if (!w.widget || !w.widget->isVisible()) { continue; }
+        paint.start();
+        w.widget->repaint();
+        w.paintMs.add(double(paint.nsecsElapsed()) / 1e6);
+    }
+    m_sinceTick.restart();
+}
+
+QJsonObject FrameProbe::toJson() const
+{
+    QJsonObject windows;
+    for (const Window& w : m_windows) {
+        windows[w.name] = w.paintMs.toJson();
+    }
+    QJsonObject out;
+    out[QStringLiteral("windows")]        = windows;
+    out[QStringLiteral("loopLatenessMs")] = m_latenessMs.toJson();
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// ProcessUsage
+// ---------------------------------------------------------------------------
+ProcessUsage ProcessUsage::now()
+{
+    ProcessUsage out;
+#ifdef Q_OS_LINUX
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (statm.open(QIODevice::ReadOnly)) {
+        // "size resident shared ..." in pages.
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1) {
+            out.rssKiB = fields[1].toLongLong() * (sysconf(_SC_PAGESIZE) / 1024);
+        }
+    }
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        out.cpuSeconds = double(usage.ru_utime.tv_sec) + double(usage.ru_utime.tv_usec) / 1e6
+                       + double(usage.ru_stime.tv_sec) + double(usage.ru_stime.tv_usec) / 1e6;
+    }
+#endif
+    return out;
+}
+
+} // namespace hmi::bench
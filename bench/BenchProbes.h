@@ -0,0 +1,86 @@
+// bench/BenchProbes.h
+//
+// Measurement helpers for the UI throughput benchmark.
+//
+// FrameProbe   – ~60 Hz timer that repaints each registered window
+//                synchronously and records how long the paint took, plus how
+//                late the timer itself fired (event-loop lateness: time the
+//                main thread spent on something else, e.g. a signal storm).
+// ProcessUsage – resident set size and process CPU time.
+//
+// Both are main-thread only.
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <QWidget>
+
+#include <cstdint>
+
+namespace hmi::bench {
+
+/// Samples of one quantity in milliseconds.
+class SampleSeries {
+public:
+    void add(double ms) { m_samples.append(ms); }
+    void clear() { m_samples.clear(); }
+
+    [[nodiscard]] int count() const noexcept { return int(m_samples.size()); }
+
+    /// {count, mean, p50, p95, p99, max}; exact percentiles (sorted copy).
+    [[nodiscard]] QJsonObject toJson() const;
+
+private:
+    QVector<double> m_samples;
+};
+
+class FrameProbe : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kIntervalMs = 16;
+
+    explicit FrameProbe(QObject* parent = nullptr);
+
+    /// Repaint \a window on every tick while it is visible.
+    void addWindow(const QString& name, QWidget* window);
+
+    void start();
+    void stop();
+
+    /// Drop the samples of the previous scenario.
+    void reset();
+
+    /// {"windows": {name: SampleSeries}, "loopLatenessMs": SampleSeries}.
+    [[nodiscard]] QJsonObject toJson() const;
+
+private:
+    void tick();
+
+    struct Window {
+        QString           name;
+        QPointer<QWidget> widget;
+        SampleSeries      paintMs;
+    };
+
+    QTimer           m_timer;
+    QElapsedTimer    m_sinceTick;
+    QVector<Window>  m_windows;
+    SampleSeries     m_latenessMs;
+};
+
+struct ProcessUsage {
+    int64_t rssKiB     = 0;
+    double  cpuSeconds = 0.0;   ///< user + system, all threads
+
+    /// Current values (Linux: /proc/self/statm and getrusage; 0 elsewhere).
+    static ProcessUsage now();
+};
+
+} // namespace hmi::bench
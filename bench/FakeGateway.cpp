@@ -0,0 +1,362 @@
+// bench/FakeGateway.cpp
+//
+// Implementation of FakeGateway – see FakeGateway.h.
+
+#include "FakeGateway.h"
+
+#include <QBuffer>
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+namespace hmi::bench {
+
+namespace proto = inspection::gateway::v1;
+
+using grpc::ServerContext;
+using grpc::Status;
+
+namespace {
+
+/// Longest uninterrupted sleep; bounds how late a client cancel is noticed.
+constexpr auto kCancelPollInterval = std::chrono::milliseconds(50);
+
+const std::string kTaskId   = "bench-task";
+const std::string kPlanId   = "bench-plan";
+const std::string kCameraId = "cam0";
+
+void setNow(google::protobuf::Timestamp* ts)
+{
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const auto sec = std::chrono::duration_cast<std::chrono::seconds>(now);
+    ts->set_seconds(sec.count());
+    ts->set_nanos(static_cast<int32_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - sec).count()));
+}
+
+void setPose3D(proto::Pose3D* pose, double x, double y, double z)
+{
+    pose->mutable_position()->set_x(x);
+    pose->mutable_position()->set_y(y);
+    pose->mutable_position()->set_z(z);
+    pose->mutable_orientation()->set_w(1.0);
+}
+
+/// Gradient with a grid – compresses like a real part photo rather than
+/// a flat colour.
+std::string makeThumbnailJpeg(int px)
+{
+    QImage img(px, px, QImage::Format_RGB32);
+    for (int y = 0; y < px; ++y) {
+        auto* line = reinterpret_cast<QRgb*>(img.scanLine(y));
+        for (int x = 0; x < px; ++x) {
+            const int v = (x * 255 / px + y * 127 / px) & 0xff;
+            line[x] = qRgb(v, (v * 3) & 0xff, 255 - v);
+        }
+    }
+    QPainter painter(&img);
+    painter.setPen(QColor(0x20, 0x20, 0x20));
+    for (int i = 0; i < px; i += 16) {
+        painter.drawLine(i, 0, i, px - 1);
+        painter.drawLine(0, i, px - 1, i);
+    }
+    painter.end();
+
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    img.save(&buffer, "JPEG", 80);
+    return std::string(bytes.constData(), static_cast<std::size_t>(bytes.size()));
+}
+
+std::string captureId(uint64_t n)
+{
+    return "cap-" + std::to_string(n);
+}
+
+void fillImage(proto::ImageRef* image, const std::string& id,
+               const std::string& thumbnailJpeg)
+{
+    auto* media = image->mutable_media();
+    media->set_media_id("media-" + id);
+    media->set_mime_type("image/jpeg");
+    media->set_size_bytes(4 * 1024 * 1024);
+    image->set_width(4096);
+    image->set_height(3000);
+    image->set_thumbnail_jpeg(thumbnailJpeg);
+}
+
+void fillDefect(proto::DefectResult* defect, uint64_t n)
+{
+    defect->set_has_defect(true);
+    defect->set_defect_type(n % 2 ? "scratch" : "dent");
+    defect->set_confidence(0.5 + double(n % 50) / 100.0);
+    auto* bbox = defect->mutable_bbox();
+    bbox->set_x(0.25);
+    bbox->set_y(0.25);
+    bbox->set_w(0.2);
+    bbox->set_h(0.1);
+}
+
+} // anonymous namespace
+
+FakeGateway::FakeGateway(FakeGatewayOptions options)
+    : m_options(options)
+{
+}
+
+FakeGateway::~FakeGateway()
+{
+    shutdown();
+}
+
+// ---------------------------------------------------------------------------
+// start / shutdown
+// ---------------------------------------------------------------------------
+bool FakeGateway::start()
+{
+    buildPayloads();
+
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(this);
+    // Plans and capture pages are far beyond the 4 MiB default.
+    builder.SetMaxSendMessageSize(-1);
+    builder.SetMaxReceiveMessageSize(-1);
+    m_server = builder.BuildAndStart();
+    if (!m_server || port == 0) {
+        m_server.reset();
+        return false;
+    }
+    m_address = QStringLiteral("127.0.0.1:%1").arg(port);
+    return true;
+}
+
+void FakeGateway::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_server) {
+        m_server->Shutdown(std::chrono::system_clock::now() + std::chrono::seconds(2));
+        m_server->Wait();
+        m_server.reset();
+    }
+}
+
+bool FakeGateway::waitFor(ServerContext* context, int64_t ns)
+{
+    const auto until = std::chrono::steady_clock::now() + std::chrono::nanoseconds(ns);
+    std::unique_lock<std::mutex> lk(m_mutex);
+    for (;;) {
+        if (m_stopping || context->IsCancelled()) { return false; }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= until) { return true; }
+        const auto slice = std::min<std::chrono::steady_clock::duration>(
+            until - now, kCancelPollInterval);
+        m_wake.wait_for(lk, slice);
+    }
+}
+
+void FakeGateway::buildPayloads()
+{
+    m_thumbnailJpeg = makeThumbnailJpeg(std::max(8, m_options.thumbnailPx));
+
+    // A serpentine over a 50 m x 20 m hall; every point carries full poses
+    // so conversion cost matches a real plan.
+    const int n = std::max(0, m_options.planPoints);
+    m_path.Clear();
+    m_path.set_total_points(static_cast<uint32_t>(n));
+    m_path.set_estimated_distance_m(0.5 * n);
+    m_path.set_estimated_duration_s(4.0 * n);
+    for (int i = 0; i < n; ++i) {
+        auto* wp = m_path.add_waypoints();
+        const double x = double(i % 100) * 0.5;
+        const double y = double(i / 100) * 0.5;
+        wp->set_point_id(i + 1);
+        wp->set_group_id("group-" + std::to_string(i / 50));
+        auto* agv = wp->mutable_agv_pose();
+        agv->set_x(x);
+        agv->set_y(y);
+        agv->set_yaw(std::fmod(0.1 * i, 6.283));
+        agv->set_frame_id("map");
+        setPose3D(wp->mutable_arm_pose(),      0.3, 0.0, 0.8);
+        setPose3D(wp->mutable_tcp_pose_goal(), x, y, 1.2);
+        setPose3D(wp->mutable_camera_pose(),   x, y, 1.3);
+        wp->set_expected_quality(0.9);
+        wp->set_planning_cost(double(i));
+        wp->set_camera_id(kCameraId);
+        for (int j = 0; j < 6; ++j) {
+            wp->add_arm_joint_goal(0.1 * j);
+        }
+    }
+}
+
+// ===========================================================================
+// Streams
+// ===========================================================================
+
+Status FakeGateway::SubscribeSystemState(ServerContext* context,
+                                         const proto::SubscribeRequest* /*request*/,
+                                         grpc::ServerWriter<proto::SystemStateEvent>* writer)
+{
+    const int64_t periodNs = m_options.stateHz > 0.0
+                           ? static_cast<int64_t>(1e9 / m_options.stateHz) : 1000000000;
+    const int total = std::max(1, m_options.planPoints);
+
+    proto::SystemStateEvent ev;
+    auto* status = ev.mutable_status();
+    status->set_task_id(kTaskId);
+    status->set_plan_id(kPlanId);
+    status->set_task_name("bench");
+    status->set_phase(proto::EXECUTING);
+    status->set_total_waypoints(static_cast<uint32_t>(total));
+    status->set_interlock_ok(true);
+    status->mutable_agv()->set_connected(true);
+    status->mutable_agv()->set_moving(true);
+    status->mutable_agv()->set_map_id("bench-map");
+    status->mutable_arm()->set_connected(true);
+    status->mutable_arm()->set_servo_enabled(true);
+
+    for (uint64_t n = 0;; ++n) {
+        const int index = static_cast<int>(n % uint64_t(total));
+        status->set_current_waypoint_index(static_cast<uint32_t>(index));
+        status->set_current_point_id(index + 1);
+        status->set_progress_percent(100.0 * index / total);
+        status->set_current_action(n % 2 ? "moving" : "capturing");
+        auto* pose = status->mutable_agv()->mutable_current_pose();
+        pose->set_x(double(index % 100) * 0.5);
+        pose->set_y(double(index / 100) * 0.5);
+        pose->set_yaw(std::fmod(0.01 * double(n), 6.283));
+        status->mutable_agv()->set_battery_percent(100.0 - double(n % 1000) / 10.0);
+        setNow(status->mutable_updated_at());
+
+        if (!writer->Write(ev)) { break; }
+        m_statesSent.fetch_add(1, std::memory_order_relaxed);
+        if (!waitFor(context, periodNs)) { break; }
+    }
+    return Status::OK;
+}
+
+Status FakeGateway::SubscribeInspectionEvents(ServerContext* context,
+                                              const proto::SubscribeRequest* /*request*/,
+                                              grpc::ServerWriter<proto::InspectionEvent>* writer)
+{
+    const int64_t periodNs = int64_t(std::max(1, m_options.eventBurstPeriodMs)) * 1000000;
+    const int burst = std::max(1, m_options.eventBurst);
+
+    proto::InspectionEvent ev;
+    ev.set_task_id(kTaskId);
+    ev.set_type(proto::CAPTURED);
+    ev.set_camera_id(kCameraId);
+
+    for (uint64_t n = 0;;) {
+        for (int i = 0; i < burst; ++i, ++n) {
+            const std::string id = captureId(n);
+            ev.set_point_id(static_cast<int32_t>(n % 1000) + 1);
+            ev.set_capture_id(id);
+            ev.set_message("captured " + id);
+            setNow(ev.mutable_timestamp());
+            fillImage(ev.mutable_image(), id, m_thumbnailJpeg);
+            setPose3D(ev.mutable_camera_pose(), 0.5 * double(n % 100), 0.0, 1.3);
+            ev.clear_defects();
+            if (n % 10 == 0) {
+                ev.set_type(proto::DEFECT_FOUND);
+                fillDefect(ev.add_defects(), n);
+            } else {
+                ev.set_type(proto::CAPTURED);
+            }
+
+            if (!writer->Write(ev)) { return Status::OK; }
+            m_eventsSent.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!waitFor(context, periodNs)) { break; }
+    }
+    return Status::OK;
+}
+
+// ===========================================================================
+// Unary
+// ===========================================================================
+
+Status FakeGateway::ListCaptures(ServerContext* /*context*/,
+                                 const proto::ListCapturesRequest* request,
+                                 proto::ListCapturesResponse* response)
+{
+    int begin = 0;
+    int end   = std::max(0, m_options.captureCount);
+#ifdef HMI_PROTO_EXTENSIONS
+    // The page token is the decimal offset of the next record.
+    if (!request->page_token().empty()) {
+        begin = std::clamp(std::atoi(request->page_token().c_str()), 0, end);
+    }
+    if (request->page_size() > 0) {
+        const int limit = begin + static_cast<int>(request->page_size());
+        if (limit < end) {
+            end = limit;
+            response->set_next_page_token(std::to_string(end));
+        }
+    }
+#endif
+
+    response->mutable_result()->set_code(proto::OK);
+    response->mutable_captures()->Reserve(end - begin);
+    for (int i = begin; i < end; ++i) {
+        const auto n = static_cast<uint64_t>(i);
+        const std::string id = captureId(n);
+        auto* cr = response->add_captures();
+        cr->set_task_id(request->task_id().empty() ? kTaskId : request->task_id());
+        cr->set_point_id(static_cast<int32_t>(n % 1000) + 1);
+        cr->set_capture_id(id);
+        cr->set_camera_id(kCameraId);
+        if (request->include_thumbnails()) {
+            fillImage(cr->mutable_image(), id, m_thumbnailJpeg);
+        } else {
+            fillImage(cr->mutable_image(), id, std::string());
+        }
+        setNow(cr->mutable_captured_at());
+        if (n % 10 == 0) {
+            fillDefect(cr->add_defects(), n);
+        }
+    }
+    return Status::OK;
+}
+
+Status FakeGateway::PlanInspection(ServerContext* /*context*/,
+                                   const proto::PlanInspectionRequest* /*request*/,
+                                   proto::PlanInspectionResponse* response)
+{
+    response->mutable_result()->set_code(proto::OK);
+    response->set_plan_id(kPlanId);
+    *response->mutable_path() = m_path;
+    auto* stats = response->mutable_stats();
+    stats->set_candidate_pose_count(static_cast<uint32_t>(m_path.waypoints_size()) * 8);
+    stats->set_ik_success_count(static_cast<uint32_t>(m_path.waypoints_size()) * 4);
+    stats->set_planning_time_ms(1.0);
+    return Status::OK;
+}
+
+Status FakeGateway::GetPlan(ServerContext* /*context*/,
+                            const proto::GetPlanRequest* request,
+                            proto::GetPlanResponse* response)
+{
+    response->mutable_result()->set_code(proto::OK);
+    response->set_plan_id(request->plan_id());
+    response->set_model_id("bench-model");
+    response->set_task_name("bench");
+    *response->mutable_path() = m_path;
+    setNow(response->mutable_created_at());
+    return Status::OK;
+}
+
+} // namespace hmi::bench
@@ -0,0 +1,124 @@
+// bench/FakeGateway.h
+//
+// FakeGateway – an in-process InspectionGateway service with synthetic data,
+// so the HMI can be driven end to end without a robot, a planner or a
+// network.  It listens on 127.0.0.1 with an ephemeral port; GatewayClient
+// connects to address() like to a real gateway.
+//
+// Only the RPCs the UI throughput benchmark exercises are implemented:
+//   SubscribeSystemState       – a TaskStatus every 1/stateHz seconds
+//   SubscribeInspectionEvents  – bursts of eventBurst CAPTURED events, each
+//                                carrying a thumbnailPx² synthetic JPEG
+//   ListCaptures               – captureCount records (paged when the proto
+//                                extensions are enabled)
+//   PlanInspection / GetPlan   – a path of planPoints waypoints
+// Everything else answers UNIMPLEMENTED (the base class default).
+//
+// Thread safety: start()/shutdown() from one controlling thread; the
+// handlers run on gRPC's sync-server threads.
+
+#pragma once
+
+#include "inspection_gateway.grpc.pb.h"
+
+#include <QString>
+
+#include <grpcpp/grpcpp.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hmi::bench {
+
+struct FakeGatewayOptions {
+    double stateHz            = 50.0;   ///< SubscribeSystemState rate
+    int    eventBurst         = 20;     ///< events per burst
+    int    eventBurstPeriodMs = 250;    ///< time between bursts
+    int    captureCount       = 2000;   ///< records returned by ListCaptures
+    int    thumbnailPx        = 160;    ///< edge of the square thumbnail JPEG
+    int    planPoints         = 2000;   ///< waypoints per plan
+};
+
+class FakeGateway final : public inspection::gateway::v1::InspectionGateway::Service {
+public:
+    explicit FakeGateway(FakeGatewayOptions options = {});
+    ~FakeGateway() override;
+
+    FakeGateway(const FakeGateway&)            = delete;
+    FakeGateway& operator=(const FakeGateway&) = delete;
+
+    /// Build the synthetic payloads and start listening.  Returns false
+    /// when the server cannot bind.
+    bool start();
+
+    /// End every open stream and stop the server.
+    void shutdown();
+
+    /// "127.0.0.1:<port>" once started.
+    [[nodiscard]] QString address() const { return m_address; }
+    [[nodiscard]] const FakeGatewayOptions& options() const noexcept { return m_options; }
+
+    /// Stream messages written so far (compared with what the HMI received).
+    [[nodiscard]] uint64_t systemStatesSent() const noexcept
+    {
+        return m_statesSent.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] uint64_t eventsSent() const noexcept
+    {
+        return m_eventsSent.load(std::memory_order_relaxed);
+    }
+
+    // -- InspectionGateway::Service ---------------------------------------
+    grpc::Status SubscribeSystemState(
+        grpc::ServerContext* context,
+        const inspection::gateway::v1::SubscribeRequest* request,
+        grpc::ServerWriter<inspection::gateway::v1::SystemStateEvent>* writer) override;
+
+    grpc::Status SubscribeInspectionEvents(
+        grpc::ServerContext* context,
+        const inspection::gateway::v1::SubscribeRequest* request,
+        grpc::ServerWriter<inspection::gateway::v1::InspectionEvent>* writer) override;
+
+    grpc::Status ListCaptures(
+        grpc::ServerContext* context,
+        const inspection::gateway::v1::ListCapturesRequest* request,
+        inspection::gateway::v1::ListCapturesResponse* response) override;
+
+    grpc::Status PlanInspection(
+        grpc::ServerContext* context,
+        const inspection::gateway::v1::PlanInspectionRequest* request,
+        inspection::gateway::v1::PlanInspectionResponse* response) override;
+
+    grpc::Status GetPlan(
+        grpc::ServerContext* context,
+        const inspection::gateway::v1::GetPlanRequest* request,
+        inspection::gateway::v1::GetPlanResponse* response) override;
+
+private:
+    /// Sleep for \a ns or until shutdown() / the client cancels \a context;
+    /// false when the stream should end.
+    bool waitFor(grpc::ServerContext* context, int64_t ns);
+
+    void buildPayloads();
+
+    const FakeGatewayOptions m_options;
+    QString                  m_address;
+    std::unique_ptr<grpc::Server> m_server;
+
+    // Built once in start(); read-only afterwards.
+    std::string                              m_thumbnailJpeg;
+    inspection::gateway::v1::InspectionPath  m_path;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    bool                    m_stopping = false;
+
+    std::atomic<uint64_t> m_statesSent{0};
+    std::atomic<uint64_t> m_eventsSent{0};
+};
+
+} // namespace hmi::bench
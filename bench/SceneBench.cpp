@@ -0,0 +1,497 @@
+// bench/SceneBench.cpp
+//
+// hmi_bench_scene – Google Benchmark suite for the scene hot paths.
+//
+// Everything renders into an offscreen vtkRenderWindow (1280x720) driven by
+// a real CadScene + PointAnnotator pair; Qt runs on the "offscreen" platform
+// unless QT_QPA_PLATFORM says otherwise.  Meshes are synthetic UV spheres
+// written once per size as binary STL into a temporary directory, from 10k
+// up to --hmi_max_triangles (default 10M) triangles; target and waypoint
+// counts run from 10 to 10k.
+//
+//   CadScene/readFile, /ensureNormals, /buildLocator
+//       the stages of a blocking loadModel() (mesh cache off), timed from
+//       the load progress callbacks – manual time per stage
+//   PointAnnotator/pickSurface        ray cast through the cell locator
+//   PointAnnotator/addTargets         batched target visuals (N targets)
+//   PointAnnotator/updateTarget       one slot rewrite incl. its frustum
+//   PointAnnotator/showPath           path polyline + waypoint glyphs
+//   PointAnnotator/highlightWaypoint  waypoint recolour
+//   Render/frame                      full-resolution frame, model + N
+//                                     targets + N-waypoint path
+//   Render/interactiveFrame           the same while interacting (LOD proxy)
+//
+// Scene mutations only mark the scene dirty (renderRequested is connected),
+// so the PointAnnotator numbers are operation cost and Render/* is frame
+// cost – LOD, instancing or locator changes show up where they belong.
+//
+//   hmi_bench_scene --benchmark_filter='Render/.*' --benchmark_out=scene.json \
+//                   --benchmark_out_format=json --hmi_max_triangles=1000000
+
+#include "CadScene.h"
+#include "PointAnnotator.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QTemporaryDir>
+
+#include <benchmark/benchmark.h>
+
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSTLWriter.h>
+#include <vtkSphereSource.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kWindowWidth  = 1280;
+constexpr int kWindowHeight = 720;
+constexpr double kSphereRadius = 0.5;   // metres, like a mid-size part
+
+/// Models (triangles) and target / waypoint counts swept by the suite.
+const std::vector<int64_t> kTriangleCounts = { 10000, 100000, 1000000, 10000000 };
+const std::vector<int64_t> kTargetCounts   = { 10, 100, 1000, 10000 };
+
+/// Mesh for the annotation benchmarks, which do not depend on model size.
+constexpr int64_t kAnnotationTriangles = 10000;
+
+/// Upper bound on waiting for the LOD proxies of one model.
+constexpr int kLodWaitMs = 300000;
+
+using Clock = std::chrono::steady_clock;
+
+// ---------------------------------------------------------------------------
+// Synthetic data
+// ---------------------------------------------------------------------------
+
+QTemporaryDir& meshDir()
+{
+    static QTemporaryDir dir;
+    return dir;
+}
+
+/// Binary STL UV sphere with about \a triangles triangles (written once).
+QString meshFile(int64_t triangles)
+{
+    static std::map<int64_t, QString> files;
+    auto it = files.find(triangles);
+    if (it != files.end()) return it->second;
+
+    // A UV sphere has 2 * theta * (phi - 2) triangles.
+    const int resolution = std::max(8, static_cast<int>(std::sqrt(double(triangles) / 2.0)));
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetRadius(kSphereRadius);
+    sphere->SetThetaResolution(resolution);
+    sphere->SetPhiResolution(resolution + 2);
+    sphere->Update();
+
+    const QString path = QDir(meshDir().path())
+                             .filePath(QStringLiteral("sphere-%1.stl").arg(triangles));
+    vtkNew<vtkSTLWriter> writer;
+    writer->SetInputConnection(sphere->GetOutputPort());
+    writer->SetFileTypeToBinary();
+    writer->SetFileName(path.toLocal8Bit().constData());
+    writer->Write();
+
+    files.emplace(triangles, path);
+    return path;
+}
+
+/// \a n targets spread evenly over the sphere (Fibonacci lattice), each
+/// looking at the surface along its inward normal.
+QVector<hmi::InspectionTarget> makeTargets(int64_t n)
+{
+    QVector<hmi::InspectionTarget> targets;
+    targets.reserve(static_cast<int>(n));
+    const double golden = M_PI * (3.0 - std::sqrt(5.0));
+    for (int64_t i = 0; i < n; ++i) {
+        const double y = 1.0 - 2.0 * (double(i) + 0.5) / double(n);
+        const double r = std::sqrt(std::max(0.0, 1.0 - y * y));
+        const double a = golden * double(i);
+        const QVector3D dir(float(r * std::cos(a)), float(y), float(r * std::sin(a)));
+
+        hmi::InspectionTarget t;
+        t.pointId              = static_cast<int32_t>(i + 1);
+        t.groupId              = QStringLiteral("bench");
+        t.surface.position     = dir * float(kSphereRadius);
+        t.surface.normal       = dir;
+        t.view.viewDirection   = -dir;
+        targets.append(t);
+    }
+    return targets;
+}
+
+/// \a n waypoints on a serpentine around the model.
+hmi::InspectionPath makePath(int64_t n)
+{
+    hmi::InspectionPath path;
+    path.totalPoints = static_cast<uint32_t>(n);
+    path.waypoints.reserve(static_cast<int>(n));
+    for (int64_t i = 0; i < n; ++i) {
+        hmi::InspectionPoint wp;
+        wp.pointId     = static_cast<int32_t>(i + 1);
+        wp.agvPose.x   = -1.0 + 2.0 * double(i % 100) / 100.0;
+        wp.agvPose.y   = -1.0 + 2.0 * double(i / 100 % 100) / 100.0;
+        wp.agvPose.yaw = 0.0;
+        path.waypoints.append(wp);
+    }
+    return path;
+}
+
+// ---------------------------------------------------------------------------
+// Scene harness
+// ---------------------------------------------------------------------------
+
+/// Offscreen window + renderer + CadScene + PointAnnotator, with the model
+/// of one size loaded.  One harness is alive at a time (10M triangles need
+/// a few GiB); benchmarks are registered grouped by model size so each size
+/// is loaded once.
+struct SceneHarness {
+    vtkNew<vtkRenderWindow> window;
+    vtkNew<vtkRenderer>     renderer;
+    CadScene                scene;
+    PointAnnotator          annotator{ &scene };
+    int64_t                 triangles = 0;
+
+    // Last load, split by the progress callbacks (see loadTimed()).
+    std::chrono::nanoseconds readTime{0};
+    std::chrono::nanoseconds normalsTime{0};
+    std::chrono::nanoseconds locatorTime{0};
+
+    explicit SceneHarness(int64_t tris)
+        : triangles(tris)
+    {
+        window->SetOffScreenRendering(1);
+        window->SetSize(kWindowWidth, kWindowHeight);
+        window->AddRenderer(renderer);
+        scene.setRenderer(renderer);
+        scene.setMeshCacheEnabled(false);   // measure the parse, not the cache
+
+        // With a receiver connected, render() only marks the scene dirty.
+        QObject::connect(&scene, &CadScene::renderRequested, &scene, []() {});
+
+        QObject::connect(&scene, &CadScene::loadProgress, &scene,
+                         [this](CadScene::LoadStage stage, double) {
+                             m_lastProgress[static_cast<int>(stage)] = Clock::now();
+                         });
+    }
+
+    /// Blocking load of the synthetic mesh; fills the stage times.
+    bool loadTimed()
+    {
+        for (auto& t : m_lastProgress) t = Clock::time_point{};
+        const auto start = Clock::now();
+        if (!scene.loadModel(meshFile(triangles))) return false;
+
+        // Each stage ends with its last progress callback.
+        const auto read    = at(CadScene::LoadStage::Reading, start);
+        const auto normals = at(CadScene::LoadStage::Normals, read);
+        const auto index   = at(CadScene::LoadStage::Indexing, normals);
+        readTime    = read - start;
+        normalsTime = normals - read;
+        locatorTime = index - normals;
+
+        scene.resetCamera();
+        return true;
+    }
+
+    /// Synchronous, completed frame.
+    void frame()
+    {
+        scene.renderNow();
+        window->WaitForCompletion();
+    }
+
+    /// Pump the event loop until the LOD proxies are installed.
+    bool waitForLod()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (scene.lodLevelCount() == 0 && timer.elapsed() < kLodWaitMs) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        }
+        return scene.lodLevelCount() > 0;
+    }
+
+private:
+    Clock::time_point at(CadScene::LoadStage stage, Clock::time_point fallback) const
+    {
+        const auto t = m_lastProgress[static_cast<int>(stage)];
+        return t == Clock::time_point{} ? fallback : t;
+    }
+
+    Clock::time_point m_lastProgress[4]{};
+};
+
+std::unique_ptr<SceneHarness> g_harness;
+
+/// The harness for \a triangles, loading the model on first use.
+SceneHarness* harness(int64_t triangles, benchmark::State& state)
+{
+    if (!g_harness || g_harness->triangles != triangles) {
+        g_harness.reset();
+        g_harness = std::make_unique<SceneHarness>(triangles);
+        if (!g_harness->loadTimed()) {
+            g_harness.reset();
+            state.SkipWithError("model load failed");
+            return nullptr;
+        }
+        g_harness->frame();
+    }
+    return g_harness.get();
+}
+
+void setSizeCounters(benchmark::State& state, int64_t triangles, int64_t count = -1)
+{
+    state.counters["triangles"] = double(triangles);
+    if (count >= 0) state.counters["count"] = double(count);
+}
+
+// ===========================================================================
+// CadScene load stages
+// ===========================================================================
+
+enum class Stage { Read, Normals, Locator };
+
+void BM_LoadStage(benchmark::State& state, Stage stage)
+{
+    const int64_t tris = state.range(0);
+    SceneHarness* h = harness(tris, state);
+    if (!h) return;
+
+    for (auto _ : state) {
+        if (!h->loadTimed()) {
+            state.SkipWithError("model load failed");
+            break;
+        }
+        const auto t = stage == Stage::Read    ? h->readTime
+                     : stage == Stage::Normals ? h->normalsTime
+                                               : h->locatorTime;
+        state.SetIterationTime(std::chrono::duration<double>(t).count());
+    }
+    setSizeCounters(state, tris);
+    state.counters["cells"] = double(h->scene.modelPolyData()
+                                     ? h->scene.modelPolyData()->GetNumberOfCells() : 0);
+}
+
+// ===========================================================================
+// Picking
+// ===========================================================================
+
+void BM_PickSurface(benchmark::State& state)
+{
+    const int64_t tris = state.range(0);
+    SceneHarness* h = harness(tris, state);
+    if (!h) return;
+
+    // Pixels in the central half of the window, where the model sits after
+    // resetCamera(); misses still walk the locator.
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> px(kWindowWidth / 4, 3 * kWindowWidth / 4);
+    std::uniform_int_distribution<int> py(kWindowHeight / 4, 3 * kWindowHeight / 4);
+
+    int64_t hits = 0;
+    for (auto _ : state) {
+        auto sp = h->annotator.pickSurface(px(rng), py(rng));
+        hits += sp ? 1 : 0;
+        benchmark::DoNotOptimize(sp);
+    }
+    setSizeCounters(state, tris);
+    state.counters["hitRate"] = state.iterations() > 0
+                              ? double(hits) / double(state.iterations()) : 0.0;
+}
+
+// ===========================================================================
+// Annotation
+// ===========================================================================
+
+void BM_AddTargets(benchmark::State& state)
+{
+    const int64_t n = state.range(0);
+    SceneHarness* h = harness(kAnnotationTriangles, state);
+    if (!h) return;
+    const auto targets = makeTargets(n);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        h->annotator.clearTargets();
+        state.ResumeTiming();
+        h->annotator.addTargets(targets);
+    }
+    h->annotator.clearTargets();
+    setSizeCounters(state, kAnnotationTriangles, n);
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_UpdateTarget(benchmark::State& state)
+{
+    const int64_t n = state.range(0);
+    SceneHarness* h = harness(kAnnotationTriangles, state);
+    if (!h) return;
+    auto targets = makeTargets(n);
+    h->annotator.replaceTargets(targets);
+
+    int64_t i = 0;
+    for (auto _ : state) {
+        hmi::InspectionTarget& t = targets[static_cast<int>(i++ % n)];
+        t.view.rollDeg = std::fmod(t.view.rollDeg + 5.0, 360.0);   // new frustum
+        h->annotator.updateTarget(t);
+    }
+    h->annotator.clearTargets();
+    setSizeCounters(state, kAnnotationTriangles, n);
+}
+
+void BM_ShowPath(benchmark::State& state)
+{
+    const int64_t n = state.range(0);
+    SceneHarness* h = harness(kAnnotationTriangles, state);
+    if (!h) return;
+    const auto path = makePath(n);
+
+    for (auto _ : state) {
+        h->annotator.showPath(path);
+    }
+    h->annotator.clearPath();
+    setSizeCounters(state, kAnnotationTriangles, n);
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_HighlightWaypoint(benchmark::State& state)
+{
+    const int64_t n = state.range(0);
+    SceneHarness* h = harness(kAnnotationTriangles, state);
+    if (!h) return;
+    h->annotator.showPath(makePath(n));
+
+    int64_t i = 0;
+    for (auto _ : state) {
+        h->annotator.highlightWaypoint(static_cast<int>(i++ % n));
+    }
+    h->annotator.clearPath();
+    setSizeCounters(state, kAnnotationTriangles, n);
+}
+
+// ===========================================================================
+// Frames
+// ===========================================================================
+
+void BM_Frame(benchmark::State& state, bool interactive)
+{
+    const int64_t tris = state.range(0);
+    const int64_t n    = state.range(1);
+    SceneHarness* h = harness(tris, state);
+    if (!h) return;
+
+    if (interactive && !h->waitForLod()) {
+        state.SkipWithError("no LOD proxies for this model");
+        return;
+    }
+    h->annotator.replaceTargets(makeTargets(n));
+    h->annotator.showPath(makePath(n));
+    h->scene.setInteracting(interactive);
+    if (!interactive) h->scene.ensureFullResolution();
+    h->frame();   // upload the geometry outside the timed loop
+
+    for (auto _ : state) {
+        h->frame();
+    }
+
+    h->scene.ensureFullResolution();
+    h->annotator.clearPath();
+    h->annotator.clearTargets();
+    setSizeCounters(state, tris, n);
+    state.counters["fps"] = benchmark::Counter(double(state.iterations()),
+                                               benchmark::Counter::kIsRate);
+}
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+void registerBenchmarks(int64_t maxTriangles)
+{
+    // Grouped by model size so every harness is loaded once.
+    for (int64_t tris : kTriangleCounts) {
+        if (tris > maxTriangles) break;
+
+        benchmark::RegisterBenchmark("CadScene/readFile", BM_LoadStage, Stage::Read)
+            ->Arg(tris)->UseManualTime()->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("CadScene/ensureNormals", BM_LoadStage, Stage::Normals)
+            ->Arg(tris)->UseManualTime()->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("CadScene/buildLocator", BM_LoadStage, Stage::Locator)
+            ->Arg(tris)->UseManualTime()->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("PointAnnotator/pickSurface", BM_PickSurface)
+            ->Arg(tris)->Unit(benchmark::kMicrosecond);
+
+        for (int64_t n : kTargetCounts) {
+            benchmark::RegisterBenchmark("Render/frame", BM_Frame, false)
+                ->Args({ tris, n })->UseRealTime()->Unit(benchmark::kMillisecond);
+        }
+        if (tris > CadScene::kLodMinCells) {
+            for (int64_t n : kTargetCounts) {
+                benchmark::RegisterBenchmark("Render/interactiveFrame", BM_Frame, true)
+                    ->Args({ tris, n })->UseRealTime()->Unit(benchmark::kMillisecond);
+            }
+        }
+    }
+
+    for (int64_t n : kTargetCounts) {
+        benchmark::RegisterBenchmark("PointAnnotator/addTargets", BM_AddTargets)
+            ->Arg(n)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("PointAnnotator/updateTarget", BM_UpdateTarget)
+            ->Arg(n)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("PointAnnotator/showPath", BM_ShowPath)
+            ->Arg(n)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("PointAnnotator/highlightWaypoint", BM_HighlightWaypoint)
+            ->Arg(n)->Unit(benchmark::kMicrosecond);
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    // Our own flag; everything else goes to Google Benchmark.
+    int64_t maxTriangles = kTriangleCounts.back();
+    const char* kMaxFlag = "--hmi_max_triangles=";
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], kMaxFlag, std::strlen(kMaxFlag)) == 0) {
+            maxTriangles = std::strtoll(argv[i] + std::strlen(kMaxFlag), nullptr, 10);
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    QGuiApplication app(argc, argv);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    registerBenchmarks(maxTriangles);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    g_harness.reset();   // before the QGuiApplication goes away
+    return 0;
+}
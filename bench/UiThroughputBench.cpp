@@ -0,0 +1,354 @@
+// bench/UiThroughputBench.cpp
+//
+// hmi_bench_ui – end-to-end UI throughput benchmark.
+//
+// Starts a FakeGateway in process, connects a real GatewayClient to it and
+// wires MainWindow and OperatorWindow the way src/main.cpp does, then runs
+// one scenario per stream / RPC so each one's cost is measured on its own:
+//
+//   system-state  SubscribeSystemState at --state-hz
+//   events        SubscribeInspectionEvents, bursts of --event-burst
+//   captures      ListCaptures of --captures records, reissued on completion
+//   plan          PlanInspection of --plan-points waypoints, reissued
+//
+// Per scenario it reports messages sent / delivered, the client's delivery
+// lag and conversion time (RpcMetrics), paint times of both windows and
+// event-loop lateness (FrameProbe), RSS growth and process CPU.  The result
+// is one JSON document (--out FILE, stdout otherwise) meant to be diffed
+// between releases; keep "schema" in step with any change to its layout.
+//
+// Both windows are shown side by side; run with -platform offscreen on a
+// headless machine (VTK then needs an EGL / OSMesa capable build).
+
+#include "BenchProbes.h"
+#include "FakeGateway.h"
+
+#include "core/GatewayClient.h"
+#include "scene/QVTKWidget.h"
+#include "ui/MainWindow.h"
+#include "ui/operator/OperatorWindow.h"
+#include "ui/operator/ResultPanel.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSurfaceFormat>
+#include <QTextStream>
+#include <QTimer>
+
+#include <cstdio>
+#include <functional>
+
+namespace {
+
+using hmi::bench::FakeGateway;
+using hmi::bench::FakeGatewayOptions;
+using hmi::bench::FrameProbe;
+using hmi::bench::ProcessUsage;
+
+constexpr int kSchemaVersion = 1;
+
+/// Time given to queued deliveries after a scenario's source stops.
+constexpr int kSettleMs = 500;
+
+struct Scenario {
+    QString               name;
+    hmi::RpcMethod        method;
+    std::function<void()> begin;
+    std::function<void()> end;
+    std::function<uint64_t()> sent;   ///< messages the gateway produced; may be empty
+};
+
+void runFor(int ms)
+{
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+QJsonObject histogramJson(const hmi::HistogramSnapshot& h)
+{
+    QJsonObject out;
+    out[QStringLiteral("count")] = double(h.count);
+    out[QStringLiteral("mean")]  = h.meanUs();
+    out[QStringLiteral("p50")]   = h.percentileUs(0.50);
+    out[QStringLiteral("p95")]   = h.percentileUs(0.95);
+    out[QStringLiteral("p99")]   = h.percentileUs(0.99);
+    return out;
+}
+
+QJsonObject knobsJson(const FakeGatewayOptions& o, int durationMs)
+{
+    QJsonObject out;
+    out[QStringLiteral("stateHz")]            = o.stateHz;
+    out[QStringLiteral("eventBurst")]         = o.eventBurst;
+    out[QStringLiteral("eventBurstPeriodMs")] = o.eventBurstPeriodMs;
+    out[QStringLiteral("captureCount")]       = o.captureCount;
+    out[QStringLiteral("thumbnailPx")]        = o.thumbnailPx;
+    out[QStringLiteral("planPoints")]         = o.planPoints;
+    out[QStringLiteral("durationMs")]         = durationMs;
+    return out;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    // Same surface format as the application (see src/main.cpp).
+    QSurfaceFormat::setDefaultFormat(QVTKWidget::defaultFormat());
+
+    QApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("hmi_bench_ui"));
+    app.setApplicationVersion(QStringLiteral("1.0"));
+
+    // -----------------------------------------------------------------------
+    // Command line
+    // -----------------------------------------------------------------------
+    FakeGatewayOptions knobs;
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("UI throughput benchmark against an in-process fake gateway."));
+    parser.addHelpOption();
+    const QCommandLineOption stateHzOption(
+        QStringLiteral("state-hz"), QStringLiteral("System-state messages per second."),
+        QStringLiteral("hz"), QString::number(knobs.stateHz));
+    const QCommandLineOption burstOption(
+        QStringLiteral("event-burst"), QStringLiteral("Inspection events per burst."),
+        QStringLiteral("n"), QString::number(knobs.eventBurst));
+    const QCommandLineOption burstPeriodOption(
+        QStringLiteral("event-period-ms"), QStringLiteral("Milliseconds between event bursts."),
+        QStringLiteral("ms"), QString::number(knobs.eventBurstPeriodMs));
+    const QCommandLineOption capturesOption(
+        QStringLiteral("captures"), QStringLiteral("Records returned by ListCaptures."),
+        QStringLiteral("n"), QString::number(knobs.captureCount));
+    const QCommandLineOption thumbnailOption(
+        QStringLiteral("thumbnail-px"), QStringLiteral("Edge of the square thumbnail JPEG."),
+        QStringLiteral("px"), QString::number(knobs.thumbnailPx));
+    const QCommandLineOption planOption(
+        QStringLiteral("plan-points"), QStringLiteral("Waypoints per plan."),
+        QStringLiteral("n"), QString::number(knobs.planPoints));
+    const QCommandLineOption durationOption(
+        QStringLiteral("duration"), QStringLiteral("Seconds per scenario (default 10)."),
+        QStringLiteral("sec"), QStringLiteral("10"));
+    const QCommandLineOption scenariosOption(
+        QStringLiteral("scenarios"),
+        QStringLiteral("Comma-separated subset of system-state,events,captures,plan."),
+        QStringLiteral("list"), QStringLiteral("system-state,events,captures,plan"));
+    const QCommandLineOption outOption(
+        QStringLiteral("out"), QStringLiteral("Write the JSON results to <file>."),
+        QStringLiteral("file"));
+    parser.addOptions({ stateHzOption, burstOption, burstPeriodOption, capturesOption,
+                        thumbnailOption, planOption, durationOption, scenariosOption,
+                        outOption });
+    parser.process(app);
+
+    knobs.stateHz            = parser.value(stateHzOption).toDouble();
+    knobs.eventBurst         = parser.value(burstOption).toInt();
+    knobs.eventBurstPeriodMs = parser.value(burstPeriodOption).toInt();
+    knobs.captureCount       = parser.value(capturesOption).toInt();
+    knobs.thumbnailPx        = parser.value(thumbnailOption).toInt();
+    knobs.planPoints         = parser.value(planOption).toInt();
+    const int durationMs = qMax(1, qRound(parser.value(durationOption).toDouble() * 1000.0));
+    const QStringList selected = parser.value(scenariosOption).split(',', Qt::SkipEmptyParts);
+
+    // -----------------------------------------------------------------------
+    // Fake gateway + client + windows (wired as in src/main.cpp)
+    // -----------------------------------------------------------------------
+    FakeGateway gateway(knobs);
+    if (!gateway.start()) {
+        std::fprintf(stderr, "hmi_bench_ui: cannot start the fake gateway\n");
+        return 1;
+    }
+
+    hmi::GatewayClient client;
+
+    MainWindow engineerWindow;
+    engineerWindow.setGatewayClient(&client);
+    engineerWindow.resize(1600, 900);
+
+    OperatorWindow operatorWindow;
+    operatorWindow.resize(800, 1024);
+
+    QObject::connect(&client, &hmi::GatewayClient::systemStateReceived,
+                     &operatorWindow, [&operatorWindow](const hmi::TaskStatusSnapshot& status) {
+                         operatorWindow.updateTaskStatus(*status);
+                     });
+    QObject::connect(&client, &hmi::GatewayClient::inspectionEventReceived,
+                     &operatorWindow, [&operatorWindow](const hmi::InspectionEventSnapshot& event) {
+                         operatorWindow.addEvent(*event);
+                     });
+    QObject::connect(&client, &hmi::GatewayClient::capturePageReceived,
+                     &operatorWindow, [&operatorWindow](hmi::Result result, QString /*taskId*/,
+                                                        QVector<hmi::CaptureRecord> captures,
+                                                        bool /*last*/) {
+                         if (result.ok()) {
+                             operatorWindow.resultPanel()->appendCaptureRecords(captures);
+                         }
+                     });
+
+    engineerWindow.show();
+    operatorWindow.move(engineerWindow.geometry().right() + 1, engineerWindow.y());
+    operatorWindow.show();
+
+    // Connect and wait for READY.
+    {
+        QEventLoop loop;
+        bool connected = false;
+        const auto conn = QObject::connect(&client, &hmi::GatewayClient::connectionStateChanged,
+                                           &loop, [&](bool up) {
+                                               connected = up;
+                                               if (up) { loop.quit(); }
+                                           });
+        QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+        client.connectToGateway(gateway.address());
+        loop.exec();
+        QObject::disconnect(conn);
+        if (!connected) {
+            std::fprintf(stderr, "hmi_bench_ui: cannot connect to %s\n",
+                         qPrintable(gateway.address()));
+            return 1;
+        }
+    }
+
+    FrameProbe probe;
+    probe.addWindow(QStringLiteral("MainWindow"), &engineerWindow);
+    probe.addWindow(QStringLiteral("OperatorWindow"), &operatorWindow);
+
+    // -----------------------------------------------------------------------
+    // Scenarios
+    // -----------------------------------------------------------------------
+    // Unary scenarios reissue their call on completion while active, so the
+    // client always has exactly one in flight.
+    bool repeatCaptures = false;
+    bool repeatPlan     = false;
+    const QString taskId = QStringLiteral("bench-task");
+    QObject::connect(&client, &hmi::GatewayClient::capturesReceived, &app,
+                     [&](hmi::Result, QVector<hmi::CaptureRecord>) {
+                         if (repeatCaptures) {
+                             operatorWindow.resultPanel()->clear();
+                             client.listCaptures(taskId);
+                         }
+                     });
+    QObject::connect(&client, &hmi::GatewayClient::planInspectionFinished, &app,
+                     [&](const hmi::PlanResponseSnapshot&) {
+                         if (repeatPlan) {
+                             client.planInspection(QStringLiteral("bench-model"),
+                                                   QStringLiteral("bench"), {});
+                         }
+                     });
+
+    const QVector<Scenario> scenarios = {
+        { QStringLiteral("system-state"), hmi::RpcMethod::SubscribeSystemState,
+          [&]() { client.subscribeSystemState(); },
+          [&]() { client.stopSubscriptions(); },
+          [&]() { return gateway.systemStatesSent(); } },
+        { QStringLiteral("events"), hmi::RpcMethod::SubscribeInspectionEvents,
+          [&]() { client.subscribeInspectionEvents(); },
+          [&]() { client.stopSubscriptions(); },
+          [&]() { return gateway.eventsSent(); } },
+        { QStringLiteral("captures"), hmi::RpcMethod::ListCaptures,
+          [&]() { repeatCaptures = true; client.listCaptures(taskId); },
+          [&]() { repeatCaptures = false; },
+          {} },
+        { QStringLiteral("plan"), hmi::RpcMethod::PlanInspection,
+          [&]() {
+              repeatPlan = true;
+              client.planInspection(QStringLiteral("bench-model"), QStringLiteral("bench"), {});
+          },
+          [&]() { repeatPlan = false; },
+          {} },
+    };
+
+    QJsonArray results;
+    probe.start();
+    for (const Scenario& scenario : scenarios) {
+        if (!selected.contains(scenario.name)) { continue; }
+
+        runFor(kSettleMs);   // let the previous scenario drain
+        client.resetRpcMetrics();
+        probe.reset();
+        const uint64_t sentBefore = scenario.sent ? scenario.sent() : 0;
+        const ProcessUsage before = ProcessUsage::now();
+        QElapsedTimer wall;
+        wall.start();
+
+        scenario.begin();
+        runFor(durationMs);
+        scenario.end();
+        runFor(kSettleMs);
+
+        const double wallSec = double(wall.nsecsElapsed()) / 1e9;
+        const ProcessUsage after = ProcessUsage::now();
+        const hmi::RpcMetricsSnapshot metrics = client.rpcMetrics();
+        const hmi::RpcMethodStats& stats = metrics[scenario.method];
+        const bool stream = scenario.method == hmi::RpcMethod::SubscribeSystemState
+                         || scenario.method == hmi::RpcMethod::SubscribeInspectionEvents;
+        const uint64_t delivered = stream ? stats.messages : stats.calls;
+
+        QJsonObject r;
+        r[QStringLiteral("name")]      = scenario.name;
+        r[QStringLiteral("method")]    = QString::fromLatin1(hmi::rpcMethodName(scenario.method));
+        r[QStringLiteral("wallSec")]   = wallSec;
+        if (scenario.sent) {
+            r[QStringLiteral("sent")]  = double(scenario.sent() - sentBefore);
+        }
+        r[QStringLiteral("delivered")]     = double(delivered);
+        r[QStringLiteral("perSecond")]     = double(delivered) / (double(durationMs) / 1000.0);
+        r[QStringLiteral("bytesReceived")] = double(stats.bytesReceived);
+        r[QStringLiteral("failures")]      = double(stats.failures);
+        r[QStringLiteral("deliveryLagUs")] = histogramJson(stats.deliveryLag);
+        r[QStringLiteral("conversionUs")]  = histogramJson(stats.conversion);
+        if (!stream) {
+            r[QStringLiteral("latencyUs")] = histogramJson(stats.latency);
+        }
+        r[QStringLiteral("frames")] = probe.toJson();
+
+        QJsonObject rss;
+        rss[QStringLiteral("startKiB")]  = double(before.rssKiB);
+        rss[QStringLiteral("endKiB")]    = double(after.rssKiB);
+        rss[QStringLiteral("growthKiB")] = double(after.rssKiB - before.rssKiB);
+        r[QStringLiteral("rss")] = rss;
+
+        QJsonObject cpu;
+        const double cpuSec = after.cpuSeconds - before.cpuSeconds;
+        cpu[QStringLiteral("seconds")] = cpuSec;
+        cpu[QStringLiteral("percent")] = wallSec > 0.0 ? 100.0 * cpuSec / wallSec : 0.0;
+        r[QStringLiteral("cpu")] = cpu;
+
+        results.append(r);
+    }
+    probe.stop();
+
+    client.disconnectFromGateway();
+    gateway.shutdown();
+
+    // -----------------------------------------------------------------------
+    // Report
+    // -----------------------------------------------------------------------
+    QJsonObject doc;
+    doc[QStringLiteral("schema")]    = kSchemaVersion;
+    doc[QStringLiteral("qt")]        = QString::fromLatin1(qVersion());
+    doc[QStringLiteral("startedAt")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    doc[QStringLiteral("knobs")]     = knobsJson(knobs, durationMs);
+    doc[QStringLiteral("scenarios")] = results;
+    const QByteArray json = QJsonDocument(doc).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outOption)) {
+        QFile out(parser.value(outOption));
+        if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "hmi_bench_ui: cannot write %s\n",
+                         qPrintable(parser.value(outOption)));
+            return 1;
+        }
+        out.write(json);
+    } else {
+        QTextStream(stdout) << json;
+    }
+    return 0;
+}
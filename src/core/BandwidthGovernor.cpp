@@ -0,0 +1,205 @@
+// src/core/BandwidthGovernor.cpp
+//
+// Implementation of BandwidthGovernor – see BandwidthGovernor.h.
+
+#include "BandwidthGovernor.h"
+
+#include "GatewayClient.h"
+
+#include <QTimer>
+
+#include <algorithm>
+
+namespace hmi {
+
+namespace {
+
+constexpr RpcMethod kControlMethods[] = {
+    RpcMethod::GetTaskStatus,
+    RpcMethod::StartInspection,
+    RpcMethod::PauseInspection,
+    RpcMethod::ResumeInspection,
+    RpcMethod::StopInspection,
+};
+
+constexpr RpcMethod kMediaMethods[] = {
+    RpcMethod::DownloadMedia,
+    RpcMethod::ListCaptures,
+    RpcMethod::GetNavMap,
+};
+
+/// Weight of the newest window in the smoothed RTT.
+constexpr double kRttSmoothing = 0.5;
+
+/// Per-window decay of the status baseline while media is quiet.
+constexpr double kBaselineDecay = 0.9;
+
+uint64_t grown(uint64_t now, uint64_t before)
+{
+    return now >= before ? now - before : 0;
+}
+
+} // anonymous namespace
+
+MediaPolicy MediaPolicy::forTier(LinkTier tier)
+{
+    MediaPolicy p;
+    p.tier = tier;
+    switch (tier) {
+    case LinkTier::Good:
+        break;
+    case LinkTier::Constrained:
+        p.quality.captureThumbnails = false;
+        p.quality.thumbnailMaxPx    = 160;
+        p.prefetchDepth             = 1;
+        p.maxMediaStreams           = 2;
+        break;
+    case LinkTier::Poor:
+        p.quality.navMapThumbnail   = false;
+        p.quality.captureThumbnails = false;
+        p.quality.thumbnailMaxPx    = 96;
+        p.prefetchDepth             = 0;
+        p.maxMediaStreams           = 1;
+        break;
+    }
+    return p;
+}
+
+BandwidthGovernor::BandwidthGovernor(GatewayClient* client, QObject* parent)
+    : QObject(parent)
+    , m_client(client)
+    , m_timer(new QTimer(this))
+{
+    connect(m_timer, &QTimer::timeout, this, [this]() {
+        if (m_client) sample(m_client->rpcMetrics());
+    });
+}
+
+void BandwidthGovernor::start(int intervalMs)
+{
+    m_previous.reset();
+    if (m_client) sample(m_client->rpcMetrics());
+    m_timer->start(std::max(100, intervalMs));
+}
+
+void BandwidthGovernor::stop()
+{
+    m_timer->stop();
+    m_previous.reset();
+    m_estimate      = LinkEstimate();
+    m_rttAge        = 0;
+    m_betterSamples = 0;
+    m_calmSamples   = 0;
+    setPolicy(MediaPolicy::forTier(LinkTier::Good));
+}
+
+bool BandwidthGovernor::isRunning() const
+{
+    return m_timer->isActive();
+}
+
+void BandwidthGovernor::sample(const RpcMetricsSnapshot& now)
+{
+    if (!m_previous || now.uptimeSec <= m_previous->uptimeSec) {
+        m_previous = now;   // first snapshot, or the metrics were reset
+        return;
+    }
+    const RpcMetricsSnapshot& before = *m_previous;
+    const double dt = now.uptimeSec - before.uptimeSec;
+
+    // -----------------------------------------------------------------------
+    // Measure
+    // -----------------------------------------------------------------------
+    uint64_t received = 0;
+    for (std::size_t m = 0; m < kRpcMethodCount; ++m) {
+        received += grown(now.methods[m].bytesReceived, before.methods[m].bytesReceived);
+    }
+    uint64_t media    = 0;
+    uint64_t failures = 0;
+    for (RpcMethod m : kMediaMethods) {
+        media    += grown(now[m].bytesReceived, before[m].bytesReceived);
+        failures += grown(now[m].linkFailures, before[m].linkFailures);
+    }
+
+    HistogramSnapshot control;
+    for (RpcMethod m : kControlMethods) {
+        failures += grown(now[m].linkFailures, before[m].linkFailures);
+        for (int b = 0; b < kLatencyBuckets; ++b) {
+            control.buckets[b] += grown(now[m].latency.buckets[b], before[m].latency.buckets[b]);
+        }
+        control.count += grown(now[m].latency.count, before[m].latency.count);
+        control.sumUs += grown(now[m].latency.sumUs, before[m].latency.sumUs);
+    }
+    if (control.count > 0) {
+        const double rttMs = control.percentileUs(0.5) / 1000.0;
+        m_estimate.controlRttMs = m_estimate.controlRttMs > 0.0
+            ? kRttSmoothing * rttMs + (1.0 - kRttSmoothing) * m_estimate.controlRttMs
+            : rttMs;
+        m_rttAge = 0;
+    } else if (++m_rttAge > kRttMaxAgeSamples) {
+        m_estimate.controlRttMs = 0.0;
+    }
+
+    const bool mediaActive = media > 0;
+    const RpcMethod status = RpcMethod::SubscribeSystemState;
+    m_estimate.statusHz = double(grown(now[status].messages, before[status].messages)) / dt;
+    m_estimate.statusBaselineHz = std::max(
+        m_estimate.statusHz,
+        mediaActive ? m_estimate.statusBaselineHz : m_estimate.statusBaselineHz * kBaselineDecay);
+    m_estimate.receivedKBps = double(received) / dt / 1024.0;
+    m_estimate.mediaKBps    = double(media) / dt / 1024.0;
+    m_estimate.failures     = failures;
+    m_previous = now;
+
+    // -----------------------------------------------------------------------
+    // Classify
+    // -----------------------------------------------------------------------
+    const double statusRatio =
+        mediaActive && m_estimate.statusBaselineHz >= kMinStatusBaselineHz
+            ? m_estimate.statusHz / m_estimate.statusBaselineHz
+            : 1.0;
+    const double rtt = m_estimate.controlRttMs;
+
+    LinkTier measured = LinkTier::Good;
+    if (rtt > kPoorRttMs || statusRatio < kPoorStatusRatio) {
+        measured = LinkTier::Poor;
+    } else if (rtt > kConstrainedRttMs || statusRatio < kConstrainedStatusRatio
+               || failures > 0) {
+        measured = LinkTier::Constrained;
+    }
+
+    LinkTier tier = m_policy.tier;
+    if (measured > tier) {
+        tier = measured;
+        m_betterSamples = 0;
+    } else if (measured < tier) {
+        if (++m_betterSamples >= kRecoverSamples) {
+            tier = static_cast<LinkTier>(static_cast<int>(tier) - 1);   // one step at a time
+            m_betterSamples = 0;
+        }
+    } else {
+        m_betterSamples = 0;
+    }
+
+    bool hold = m_policy.holdPrefetch;
+    if (statusRatio < kConstrainedStatusRatio) {
+        hold = true;
+        m_calmSamples = 0;
+    } else if (hold && ++m_calmSamples >= kRecoverSamples) {
+        hold = false;
+        m_calmSamples = 0;
+    }
+
+    MediaPolicy next = MediaPolicy::forTier(tier);
+    next.holdPrefetch = hold;
+    setPolicy(next);
+}
+
+void BandwidthGovernor::setPolicy(const MediaPolicy& policy)
+{
+    if (policy == m_policy) return;
+    m_policy = policy;
+    emit policyChanged(m_policy);
+}
+
+} // namespace hmi
@@ -0,0 +1,143 @@
+// src/core/BandwidthGovernor.h
+//
+// BandwidthGovernor – adapts media traffic to the link quality, measured
+// from the RPC instrumentation (RpcMetrics) of one GatewayClient.
+//
+// Once per sample interval (default 1 s) it compares rpcMetrics() with the
+// previous snapshot and estimates for that window
+//   - throughput: bytes received in total and by media (DownloadMedia,
+//     ListCaptures, GetNavMap)
+//   - control RTT: median latency of the small unary calls (GetTaskStatus,
+//     Start/Pause/Resume/StopInspection), smoothed; it ages out when no
+//     such call completes for kRttMaxAgeSamples windows
+//   - status health: SubscribeSystemState messages/s against the rate the
+//     stream keeps without media traffic (a peak that only decays while
+//     media is quiet)
+//   - link failures of control and media calls (UNAVAILABLE,
+//     DEADLINE_EXCEEDED, RESOURCE_EXHAUSTED); cancels – which the fetch
+//     manager and held prefetch issue themselves – and application errors
+//     do not count
+// and classifies the link as Good, Constrained or Poor.  A worse tier is
+// taken at once; a better one needs kRecoverSamples windows in a row, so
+// the policy does not flap around a threshold.
+//
+// The policy keeps control and status traffic ahead of media:
+//   tier         inline thumbnails   max size  nav map thumbnail  prefetch  streams
+//   Good         yes                 gateway   yes                2         3
+//   Constrained  no (on demand)      160 px    yes                1         2
+//   Poor         no (on demand)      96 px     no                 0         1
+// Independently of the tier, holdPrefetch is raised while the status stream
+// falls behind during media traffic and released after kRecoverSamples
+// windows without that.
+//
+// The governor only emits policyChanged(); main.cpp applies the policy to
+// GatewayClient::setMediaQuality(), MediaFetchManager and ResultPanel.
+//
+// Thread safety: main thread only.
+
+#pragma once
+
+#include "RpcMetrics.h"
+#include "Types.h"
+
+#include <QObject>
+#include <QPointer>
+
+#include <cstdint>
+#include <optional>
+
+class QTimer;
+
+namespace hmi {
+
+class GatewayClient;
+
+enum class LinkTier : int {
+    Good = 0,
+    Constrained,
+    Poor,
+};
+
+/// What media traffic the link can take right now.
+struct MediaPolicy {
+    LinkTier     tier            = LinkTier::Good;
+    MediaQuality quality;                        ///< GatewayClient::setMediaQuality()
+    int          prefetchDepth   = 2;            ///< ResultPanel::setPrefetchDepth()
+    int          maxMediaStreams = 3;            ///< MediaFetchManager::setMaxConcurrent()
+    bool         holdPrefetch    = false;        ///< MediaFetchManager::setPrefetchHeld()
+
+    /// The preset of \a tier (holdPrefetch false).
+    static MediaPolicy forTier(LinkTier tier);
+
+    friend bool operator==(const MediaPolicy& a, const MediaPolicy& b) noexcept
+    {
+        return a.tier == b.tier && a.quality == b.quality
+            && a.prefetchDepth == b.prefetchDepth
+            && a.maxMediaStreams == b.maxMediaStreams
+            && a.holdPrefetch == b.holdPrefetch;
+    }
+    friend bool operator!=(const MediaPolicy& a, const MediaPolicy& b) noexcept
+    {
+        return !(a == b);
+    }
+};
+
+/// Measurements of the last sample window.
+struct LinkEstimate {
+    double   receivedKBps     = 0.0;
+    double   mediaKBps        = 0.0;
+    double   controlRttMs     = 0.0;   ///< smoothed; 0 = no recent control call
+    double   statusHz         = 0.0;   ///< SubscribeSystemState messages/s
+    double   statusBaselineHz = 0.0;   ///< rate without media load
+    uint64_t failures         = 0;     ///< control + media link failures
+};
+
+class BandwidthGovernor : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int    kDefaultIntervalMs      = 1000;
+    static constexpr double kConstrainedRttMs       = 250.0;
+    static constexpr double kPoorRttMs              = 800.0;
+    static constexpr double kConstrainedStatusRatio = 0.8;
+    static constexpr double kPoorStatusRatio        = 0.5;
+    static constexpr double kMinStatusBaselineHz    = 1.0;   ///< slower streams are not judged
+    static constexpr int    kRecoverSamples         = 5;
+    static constexpr int    kRttMaxAgeSamples       = 30;
+
+    explicit BandwidthGovernor(GatewayClient* client, QObject* parent = nullptr);
+
+    /// Sample rpcMetrics() every \a intervalMs, starting from the next one.
+    void start(int intervalMs = kDefaultIntervalMs);
+
+    /// Stop sampling and return to the Good policy (emits policyChanged()
+    /// if that changes it).
+    void stop();
+
+    [[nodiscard]] bool isRunning() const;
+
+    [[nodiscard]] const MediaPolicy&  policy() const noexcept { return m_policy; }
+    [[nodiscard]] const LinkEstimate& estimate() const noexcept { return m_estimate; }
+
+    /// Fold in one snapshot (what the timer does); the first one after
+    /// start() or a metrics reset only sets the reference.
+    void sample(const RpcMetricsSnapshot& snapshot);
+
+signals:
+    void policyChanged(const hmi::MediaPolicy& policy);
+
+private:
+    void setPolicy(const MediaPolicy& policy);
+
+    QPointer<GatewayClient>           m_client;
+    QTimer*                           m_timer = nullptr;
+    std::optional<RpcMetricsSnapshot> m_previous;
+
+    MediaPolicy  m_policy;
+    LinkEstimate m_estimate;
+    int          m_rttAge        = 0;   ///< windows since the last control call
+    int          m_betterSamples = 0;   ///< windows in a row that could upgrade
+    int          m_calmSamples   = 0;   ///< windows in a row without status lag
+};
+
+} // namespace hmi
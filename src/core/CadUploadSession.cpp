@@ -0,0 +1,546 @@
+// src/core/CadUploadSession.cpp
+//
+// See CadUploadSession.h for the transfer model.
+
+#include "CadUploadSession.h"
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QUuid>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <thread>
+
+#ifdef HMI_PROTO_EXTENSIONS
+#include <zlib.h>
+#ifdef HMI_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#endif
+
+namespace proto = inspection::gateway::v1;
+
+namespace hmi {
+
+namespace {
+
+/// Prepared chunks waiting for the writer.  Enough to hide one slow read or
+/// compression behind a write, small enough to bound memory at 2 MiB chunks.
+constexpr std::size_t kQueueDepth = 4;
+
+/// Writes faster / slower than this grow / shrink the next chunks.
+constexpr auto kFastWrite = std::chrono::milliseconds(50);
+constexpr auto kSlowWrite = std::chrono::milliseconds(800);
+
+/// Stream deadline floor and the throughput it must at least sustain.
+constexpr int    kMinDeadlineSec     = 120;
+constexpr qint64 kMinBytesPerSecond  = 64 * 1024;
+
+Result cancelledResult()
+{
+    return Result{ErrorCode::Unspecified, QStringLiteral("Cancelled")};
+}
+
+std::chrono::system_clock::time_point deadlineFromNow(qint64 seconds)
+{
+    return std::chrono::system_clock::now() + std::chrono::seconds(seconds);
+}
+
+#ifdef HMI_PROTO_EXTENSIONS
+
+constexpr qint64 kHashStepBytes     = 4 * 1024 * 1024;
+constexpr int    kQueryDeadlineSec  = 10;
+constexpr int    kBackoffBaseMs     = 500;
+constexpr int    kBackoffMaxMs      = 8000;
+
+/// A chunk is sent compressed only if that saves at least 5 %.
+constexpr double kMinSavings        = 0.05;
+/// Give up on compression if none of the first chunks was worth it.
+constexpr int    kCompressProbe     = 4;
+
+/// Transport errors after which the gateway may still hold a prefix.
+bool isRetryable(grpc::StatusCode code)
+{
+    switch (code) {
+    case grpc::StatusCode::UNAVAILABLE:
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+    case grpc::StatusCode::ABORTED:
+    case grpc::StatusCode::INTERNAL:
+    case grpc::StatusCode::UNKNOWN:
+    case grpc::StatusCode::RESOURCE_EXHAUSTED:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool gzipCompress(const char* data, std::size_t size, std::string* out)
+{
+    z_stream zs{};
+    // windowBits 15 + 16: gzip framing, so the gateway can use any gunzip.
+    if (deflateInit2(&zs, 3, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    out->resize(deflateBound(&zs, static_cast<uLong>(size)));
+    zs.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    zs.avail_in  = static_cast<uInt>(size);
+    zs.next_out  = reinterpret_cast<Bytef*>(out->data());
+    zs.avail_out = static_cast<uInt>(out->size());
+    const int rc = deflate(&zs, Z_FINISH);
+    out->resize(zs.total_out);
+    deflateEnd(&zs);
+    return rc == Z_STREAM_END;
+}
+
+#ifdef HMI_HAVE_ZSTD
+bool zstdCompress(const char* data, std::size_t size, std::string* out)
+{
+    out->resize(ZSTD_compressBound(size));
+    const std::size_t n = ZSTD_compress(out->data(), out->size(), data, size, 3);
+    if (ZSTD_isError(n)) { return false; }
+    out->resize(n);
+    return true;
+}
+#endif
+
+proto::CadChunkCompression toProtoCompression(CadUploadOptions::Compression c)
+{
+    switch (c) {
+    case CadUploadOptions::Compression::Gzip: return proto::CAD_CHUNK_COMPRESSION_GZIP;
+    case CadUploadOptions::Compression::Zstd: return proto::CAD_CHUNK_COMPRESSION_ZSTD;
+    default:                                  return proto::CAD_CHUNK_COMPRESSION_NONE;
+    }
+}
+
+#endif // HMI_PROTO_EXTENSIONS
+
+} // anonymous namespace
+
+// ===========================================================================
+// Lifetime
+// ===========================================================================
+
+CadUploadSession::CadUploadSession(Stub* stub, QString filePath,
+                                   CadUploadOptions options, RpcMetrics* metrics)
+    : m_stub(stub)
+    , m_metrics(metrics)
+    , m_path(std::move(filePath))
+    , m_options(options)
+{
+    m_uploadId = QUuid::createUuid().toString(QUuid::WithoutBraces).toStdString();
+    m_filename = QFileInfo(m_path).fileName().toStdString();
+}
+
+CadUploadSession::~CadUploadSession()
+{
+    if (m_mapped) {
+        m_file.unmap(const_cast<uchar*>(m_mapped));
+    }
+}
+
+void CadUploadSession::cancel()
+{
+    std::lock_guard<std::mutex> lk(m_ctxMutex);
+    m_cancelled.store(true, std::memory_order_relaxed);
+    if (m_activeCtx) { m_activeCtx->TryCancel(); }
+    m_wake.notify_all();
+}
+
+// ===========================================================================
+// run
+// ===========================================================================
+
+CadUploadSession::Outcome CadUploadSession::run(const ProgressFn& progress)
+{
+    Outcome out;
+
+    QString err;
+    if (!openSource(&err)) {
+        out.error = Result{ErrorCode::InvalidArgument, err};
+        return out;
+    }
+
+    qint64 offset      = 0;
+    int    maxAttempts = 1;
+
+#ifdef HMI_PROTO_EXTENSIONS
+    switch (m_options.compression) {
+    case CadUploadOptions::Compression::Auto:
+#ifdef HMI_HAVE_ZSTD
+        m_codec = CadUploadOptions::Compression::Zstd;
+#else
+        m_codec = CadUploadOptions::Compression::Gzip;
+#endif
+        break;
+    case CadUploadOptions::Compression::Zstd:
+#ifdef HMI_HAVE_ZSTD
+        m_codec = CadUploadOptions::Compression::Zstd;
+#else
+        m_codec = CadUploadOptions::Compression::Gzip;   // not built in
+#endif
+        break;
+    default:
+        m_codec = m_options.compression;
+        break;
+    }
+
+    if (!hashSource(&err)) {
+        out.error = isCancelled() ? cancelledResult()
+                                  : Result{ErrorCode::Internal, err};
+        return out;
+    }
+
+    // A gateway without QueryCadUpload simply gets a plain upload from 0.
+    QString known;
+    qint64  committed = 0;
+    if (query(&known, &committed)) {
+        if (!known.isEmpty() && m_options.skipIfKnown) {
+            out.skipped = true;
+            out.modelId = known.toStdString();
+            out.gatewayResult.set_code(proto::OK);
+            if (progress) { progress(m_size, m_size); }
+            return out;
+        }
+        if (m_options.resume && known.isEmpty()) {
+            offset = std::clamp<qint64>(committed, 0, m_size);
+        }
+    }
+    if (isCancelled()) {
+        out.error = cancelledResult();
+        return out;
+    }
+    maxAttempts = std::max(1, m_options.maxAttempts);
+#else
+    m_codec = CadUploadOptions::Compression::None;   // base proto: raw chunks
+#endif
+
+    for (int attempt = 0;; ++attempt) {
+        out.attempts    = attempt + 1;
+        out.resumedFrom = offset;
+
+        if (streamFrom(offset, progress, out) != AttemptEnd::Broken
+            || attempt + 1 >= maxAttempts) {
+            return out;
+        }
+
+#ifdef HMI_PROTO_EXTENSIONS
+        if (!backoff(attempt)) {
+            out.error = cancelledResult();
+            return out;
+        }
+        // Where did the gateway get to?  If the query fails too, the previous
+        // resume point is still valid (the committed prefix only grows).
+        QString modelId;
+        qint64  acked = 0;
+        if (query(&modelId, &acked)) {
+            if (!modelId.isEmpty()) {
+                // The stream broke after the gateway committed the file.
+                out.status  = grpc::Status::OK;
+                out.modelId = modelId.toStdString();
+                out.gatewayResult.set_code(proto::OK);
+                return out;
+            }
+            offset = m_options.resume ? std::clamp<qint64>(acked, 0, m_size) : 0;
+        }
+#endif
+    }
+}
+
+// ===========================================================================
+// Source file
+// ===========================================================================
+
+bool CadUploadSession::openSource(QString* error)
+{
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        *error = QStringLiteral("Cannot open file: ") + m_path;
+        return false;
+    }
+    m_size = m_file.size();
+    if (m_size > 0) {
+        m_mapped = m_file.map(0, m_size);   // null: fall back to read()
+    }
+    return true;
+}
+
+QByteArray CadUploadSession::readRange(qint64 offset, qint64 length)
+{
+    if (!m_file.seek(offset)) { return {}; }
+    return m_file.read(length);
+}
+
+#ifdef HMI_PROTO_EXTENSIONS
+
+bool CadUploadSession::hashSource(QString* error)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    for (qint64 pos = 0; pos < m_size; pos += kHashStepBytes) {
+        if (isCancelled()) { return false; }
+        const qint64 len = std::min(kHashStepBytes, m_size - pos);
+        if (m_mapped) {
+            hash.addData(QByteArrayView(reinterpret_cast<const char*>(m_mapped + pos), len));
+        } else {
+            const QByteArray buf = readRange(pos, len);
+            if (buf.size() != len) {
+                *error = QStringLiteral("Read failed: ") + m_path;
+                return false;
+            }
+            hash.addData(buf);
+        }
+    }
+    m_sha256Hex = hash.result().toHex().toStdString();
+    return true;
+}
+
+bool CadUploadSession::query(QString* modelId, qint64* committed)
+{
+    grpc::ClientContext ctx;
+    ctx.set_deadline(deadlineFromNow(kQueryDeadlineSec));
+    {
+        std::lock_guard<std::mutex> lk(m_ctxMutex);
+        if (isCancelled()) { return false; }
+        m_activeCtx = &ctx;
+    }
+
+    proto::QueryCadUploadRequest req;
+    req.set_sha256(m_sha256Hex);
+    req.set_size_bytes(static_cast<uint64_t>(m_size));
+    req.set_filename(m_filename);
+
+    proto::QueryCadUploadResponse resp;
+    const auto start = RpcMetrics::Clock::now();
+    const grpc::Status st = m_stub->QueryCadUpload(&ctx, req, &resp);
+    if (m_metrics) {
+        m_metrics->recordCall(RpcMethod::QueryCadUpload, RpcMetrics::Clock::now() - start,
+                              st.ok(), req.ByteSizeLong(), st.ok() ? resp.ByteSizeLong() : 0);
+    }
+    {
+        std::lock_guard<std::mutex> lk(m_ctxMutex);
+        m_activeCtx = nullptr;
+    }
+    if (!st.ok() || resp.result().code() != proto::OK) {
+        return false;
+    }
+
+    *modelId   = QString::fromStdString(resp.model_id());
+    *committed = static_cast<qint64>(resp.committed_offset());
+    if (!resp.upload_id().empty()) {
+        m_uploadId = resp.upload_id();   // continue the gateway's partial upload
+    }
+    return true;
+}
+
+bool CadUploadSession::backoff(int attempt)
+{
+    const int ms = std::min(kBackoffMaxMs, kBackoffBaseMs << std::min(attempt, 5));
+    std::unique_lock<std::mutex> lk(m_ctxMutex);
+    m_wake.wait_for(lk, std::chrono::milliseconds(ms), [this]() { return isCancelled(); });
+    return !isCancelled();
+}
+
+bool CadUploadSession::compress(const char* data, std::size_t size, std::string* out)
+{
+    bool ok = false;
+    switch (m_codec) {
+    case CadUploadOptions::Compression::Gzip:
+        ok = gzipCompress(data, size, out);
+        break;
+#ifdef HMI_HAVE_ZSTD
+    case CadUploadOptions::Compression::Zstd:
+        ok = zstdCompress(data, size, out);
+        break;
+#endif
+    default:
+        return false;
+    }
+    return ok && static_cast<double>(out->size())
+                     <= static_cast<double>(size) * (1.0 - kMinSavings);
+}
+
+#endif // HMI_PROTO_EXTENSIONS
+
+// ===========================================================================
+// Streaming
+// ===========================================================================
+
+bool CadUploadSession::prepareChunk(proto::UploadCadChunk& chunk,
+                                    qint64 offset, qint64 length, bool first)
+{
+    QByteArray buf;
+    const char* data = nullptr;
+    if (m_mapped) {
+        data = reinterpret_cast<const char*>(m_mapped + offset);
+    } else if (length > 0) {
+        buf = readRange(offset, length);
+        if (buf.size() != length) { return false; }
+        data = buf.constData();
+    }
+
+    chunk.set_upload_id(m_uploadId);
+    chunk.set_filename(m_filename);
+    chunk.set_chunk_index(m_nextChunkIndex++);
+    chunk.set_eof(offset + length >= m_size);
+
+#ifdef HMI_PROTO_EXTENSIONS
+    chunk.set_offset(static_cast<uint64_t>(offset));
+    chunk.set_raw_size(static_cast<uint32_t>(length));
+    if (first) {
+        chunk.set_sha256(m_sha256Hex);   // identifies the file for resume
+    }
+
+    if (length > 0 && m_codec != CadUploadOptions::Compression::None) {
+        std::string packed;
+        ++m_compressTried;
+        if (compress(data, static_cast<std::size_t>(length), &packed)) {
+            ++m_compressWon;
+            chunk.set_compression(toProtoCompression(m_codec));
+            chunk.set_data(std::move(packed));
+            return true;
+        }
+        if (m_compressTried >= kCompressProbe && m_compressWon == 0) {
+            m_codec = CadUploadOptions::Compression::None;   // incompressible file
+        }
+    }
+    chunk.set_compression(proto::CAD_CHUNK_COMPRESSION_NONE);
+#endif
+
+    if (length > 0) {
+        chunk.set_data(data, static_cast<std::size_t>(length));
+    }
+    return true;
+}
+
+CadUploadSession::AttemptEnd
+CadUploadSession::streamFrom(qint64 offset, const ProgressFn& progress, Outcome& out)
+{
+    grpc::ClientContext ctx;
+    ctx.set_deadline(deadlineFromNow(
+        std::max<qint64>(kMinDeadlineSec, (m_size - offset) / kMinBytesPerSecond)));
+    {
+        std::lock_guard<std::mutex> lk(m_ctxMutex);
+        if (isCancelled()) {
+            out.error = cancelledResult();
+            return AttemptEnd::Failed;
+        }
+        m_activeCtx = &ctx;
+    }
+
+    proto::UploadCadResponse response;
+    auto writer = m_stub->UploadCad(&ctx, &response);
+
+    // -- producer: slice (and compress) ahead of the writer -----------------
+    struct Prepared {
+        proto::UploadCadChunk chunk;
+        qint64                end = 0;   ///< file offset after this chunk
+    };
+    std::mutex              qMutex;
+    std::condition_variable qCv;
+    std::deque<Prepared>    queue;
+    bool stop      = false;   // writer -> producer
+    bool produced  = false;   // producer -> writer: eof chunk queued
+    bool readError = false;
+
+    std::thread producer([&]() {
+        qint64 pos = offset;
+        bool first = true;
+        do {
+            const qint64 len = std::min(m_chunkBytes.load(std::memory_order_relaxed),
+                                        m_size - pos);
+            Prepared p;
+            const bool ok = prepareChunk(p.chunk, pos, len, first);
+            first = false;
+            pos  += len;
+            p.end = pos;
+
+            std::unique_lock<std::mutex> lk(qMutex);
+            if (!ok) {
+                readError = true;
+                qCv.notify_all();
+                return;
+            }
+            qCv.wait(lk, [&]() { return stop || queue.size() < kQueueDepth; });
+            if (stop) { return; }
+            queue.push_back(std::move(p));
+            qCv.notify_all();
+        } while (pos < m_size && !isCancelled());
+
+        std::lock_guard<std::mutex> lk(qMutex);
+        produced = true;
+        qCv.notify_all();
+    });
+
+    // -- writer: this thread ------------------------------------------------
+    bool broken = false;
+    for (;;) {
+        Prepared p;
+        {
+            std::unique_lock<std::mutex> lk(qMutex);
+            qCv.wait(lk, [&]() { return !queue.empty() || produced || readError; });
+            if (queue.empty()) { break; }
+            p = std::move(queue.front());
+            queue.pop_front();
+            qCv.notify_all();
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        if (!writer->Write(p.chunk)) {
+            broken = true;
+            break;
+        }
+        if (m_metrics) {
+            m_metrics->recordMessage(RpcMethod::UploadCad, p.chunk.data().size(), /*sent=*/true);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - t0;
+        const qint64 size = m_chunkBytes.load(std::memory_order_relaxed);
+        if (elapsed < kFastWrite) {
+            m_chunkBytes.store(std::min(size * 2, kMaxChunkBytes), std::memory_order_relaxed);
+        } else if (elapsed > kSlowWrite) {
+            m_chunkBytes.store(std::max(size / 2, kMinChunkBytes), std::memory_order_relaxed);
+        }
+
+        if (progress) { progress(p.end, m_size); }
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(qMutex);
+        stop = true;
+        qCv.notify_all();
+    }
+    producer.join();
+
+    if (readError && !broken) {
+        ctx.TryCancel();   // don't let the gateway commit a truncated file
+    } else if (!broken) {
+        writer->WritesDone();
+    }
+    const grpc::Status st = writer->Finish();
+    {
+        std::lock_guard<std::mutex> lk(m_ctxMutex);
+        m_activeCtx = nullptr;
+    }
+
+    if (isCancelled()) {
+        out.error = cancelledResult();
+        return AttemptEnd::Failed;
+    }
+    if (readError) {
+        out.error = Result{ErrorCode::Internal, QStringLiteral("Read failed: ") + m_path};
+        return AttemptEnd::Failed;
+    }
+
+    out.status = st;
+    if (st.ok()) {
+        out.gatewayResult = response.result();
+        out.modelId       = response.model_id();
+        return AttemptEnd::Done;
+    }
+#ifdef HMI_PROTO_EXTENSIONS
+    if (isRetryable(st.error_code())) { return AttemptEnd::Broken; }
+#endif
+    return AttemptEnd::Failed;
+}
+
+} // namespace hmi
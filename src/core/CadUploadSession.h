@@ -0,0 +1,139 @@
+// src/core/CadUploadSession.h
+//
+// CadUploadSession – one UploadCad transfer, run synchronously on a
+// GatewayClient worker thread.
+//
+// * Source: the file is memory-mapped (QFile::map) and sliced in place; a
+//   file that cannot be mapped is read sequentially instead.
+// * Pipelining: a producer thread slices (and compresses) the next chunks
+//   into a small bounded queue while the calling thread is blocked in the
+//   stream Write(), so disk / CPU work overlaps the network.
+// * Adaptive chunks: every Write() is timed; the chunk size doubles when a
+//   write returns within 50 ms and halves when it takes over 800 ms
+//   (16 KiB .. 2 MiB).  Small chunks on a congested Wi-Fi link lose little on
+//   a drop, large ones on a fast link cut per-message overhead.
+//
+// With the gateway proto extensions (HMI_PROTO_EXTENSIONS, see
+// docs/proto_extensions.md) the session additionally
+// * hashes the file (SHA-256) and asks QueryCadUpload whether the gateway
+//   already has it – a known model completes without sending a byte;
+// * compresses chunks (zstd when built with it, else gzip), falling back to
+//   raw chunks for incompressible data;
+// * resumes a broken stream from the offset the gateway acknowledged for
+//   that hash, with exponential backoff, up to CadUploadOptions::maxAttempts.
+//
+// Thread safety: run() on one thread; cancel() from any thread.
+
+#pragma once
+
+#include "RpcMetrics.h"
+#include "Types.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include <grpcpp/grpcpp.h>
+#include "inspection_gateway.grpc.pb.h"
+
+namespace hmi {
+
+class CadUploadSession {
+public:
+    using Stub       = inspection::gateway::v1::InspectionGateway::Stub;
+    using ProgressFn = std::function<void(qint64 doneBytes, qint64 totalBytes)>;
+
+    static constexpr qint64 kMinChunkBytes     = 16 * 1024;
+    static constexpr qint64 kInitialChunkBytes = 64 * 1024;
+    static constexpr qint64 kMaxChunkBytes     = 2 * 1024 * 1024;  // < 4 MiB gRPC default
+
+    /// Result of run().  \a error is set for local failures (file, cancel);
+    /// otherwise \a status / \a gatewayResult describe the final attempt.
+    struct Outcome {
+        Result       error{ErrorCode::Ok, {}};
+        grpc::Status status;
+        inspection::gateway::v1::Result gatewayResult;
+        std::string  modelId;
+        bool         skipped     = false;   ///< gateway already had the file
+        qint64       resumedFrom = 0;       ///< first offset of the final attempt
+        int          attempts    = 0;
+    };
+
+    /// \a metrics (optional) receives QueryCadUpload calls and sent chunks.
+    CadUploadSession(Stub* stub, QString filePath, CadUploadOptions options,
+                     RpcMetrics* metrics = nullptr);
+    ~CadUploadSession();
+
+    CadUploadSession(const CadUploadSession&)            = delete;
+    CadUploadSession& operator=(const CadUploadSession&) = delete;
+
+    /// Transfer the file.  \a progress is called on this thread after every
+    /// written chunk.  A cancelled upload reports ErrorCode::Unspecified
+    /// with message "Cancelled".
+    Outcome run(const ProgressFn& progress);
+
+    /// Abort: cancels the active stream and wakes a backoff wait.
+    void cancel();
+
+private:
+    enum class AttemptEnd { Done, Broken, Failed };
+
+    bool       openSource(QString* error);
+    QByteArray readRange(qint64 offset, qint64 length);
+
+    /// One UploadCad stream from \a offset.  Broken: retryable transport
+    /// error, \a out.status holds it.
+    AttemptEnd streamFrom(qint64 offset, const ProgressFn& progress, Outcome& out);
+
+    /// Fill \a chunk with [offset, offset + length); \a first: first chunk
+    /// of this stream.  Producer thread only.
+    bool prepareChunk(inspection::gateway::v1::UploadCadChunk& chunk,
+                      qint64 offset, qint64 length, bool first);
+
+#ifdef HMI_PROTO_EXTENSIONS
+    bool  hashSource(QString* error);
+    /// Compress \a data into \a out with m_codec; false if not worth it.
+    bool  compress(const char* data, std::size_t size, std::string* out);
+    /// QueryCadUpload; false on transport failure.  \a modelId is set when
+    /// the gateway has the complete file, \a committed to the offset it
+    /// holds for m_uploadId otherwise.
+    bool  query(QString* modelId, qint64* committed);
+    /// Sleep before attempt \a attempt; false when cancelled meanwhile.
+    bool  backoff(int attempt);
+#endif
+
+    bool isCancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+    Stub*            m_stub;
+    RpcMetrics*      m_metrics;
+    QString          m_path;
+    CadUploadOptions m_options;
+
+    QFile       m_file;
+    const uchar* m_mapped = nullptr;   ///< whole file, or null (read fallback)
+    qint64      m_size    = 0;
+    std::string m_uploadId;
+    std::string m_filename;
+    std::string m_sha256Hex;           ///< extensions only
+    uint32_t    m_nextChunkIndex = 0;
+
+    // Compression, producer thread only.
+    CadUploadOptions::Compression m_codec = CadUploadOptions::Compression::None;
+    int m_compressTried = 0;
+    int m_compressWon   = 0;
+
+    std::atomic<qint64> m_chunkBytes{kInitialChunkBytes};
+    std::atomic<bool>   m_cancelled{false};
+
+    std::mutex              m_ctxMutex;
+    std::condition_variable m_wake;     ///< backoff wait
+    grpc::ClientContext*    m_activeCtx = nullptr;
+};
+
+} // namespace hmi
@@ -0,0 +1,185 @@
+// src/core/FleetClient.cpp
+//
+// Implementation of FleetClient – see FleetClient.h.
+
+#include "FleetClient.h"
+
+#include <QSet>
+
+#include <algorithm>
+
+namespace hmi {
+
+FleetClient::FleetClient(std::shared_ptr<RpcEngine> engine, QObject* parent)
+    : QObject(parent)
+    , m_engine(engine ? std::move(engine)
+                      : std::make_shared<RpcEngine>(kDefaultPollerThreads))
+{}
+
+FleetClient::~FleetClient()
+{
+    // Each client disconnects (and waits for its callbacks) while the
+    // engine is still alive.
+    m_robots.clear();
+}
+
+bool FleetClient::parseRobots(const QString& spec, QVector<FleetRobot>* robots, QString* error)
+{
+    QVector<FleetRobot> out;
+    QSet<QString>       seen;
+    for (const QString& entry : spec.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        const int eq = entry.indexOf(QLatin1Char('='));
+        FleetRobot robot;
+        robot.robotId = entry.left(eq).trimmed();
+        robot.address = eq < 0 ? QString() : entry.mid(eq + 1).trimmed();
+        if (robot.robotId.isEmpty() || robot.address.isEmpty()) {
+            if (error) *error = QStringLiteral("expected id=host:port, got \"%1\"").arg(entry);
+            return false;
+        }
+        if (seen.contains(robot.robotId)) {
+            if (error) *error = QStringLiteral("duplicate robot \"%1\"").arg(robot.robotId);
+            return false;
+        }
+        seen.insert(robot.robotId);
+        out.append(robot);
+    }
+    *robots = std::move(out);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Robots
+// ---------------------------------------------------------------------------
+
+bool FleetClient::addRobot(const FleetRobot& robot)
+{
+    if (robot.robotId.isEmpty() || indexOf(robot.robotId) >= 0) {
+        return false;
+    }
+
+    Robot entry;
+    entry.state.robotId = robot.robotId;
+    entry.state.address = robot.address;
+    entry.client = std::make_unique<GatewayClient>(m_engine);
+    GatewayClient* client = entry.client.get();
+    client->setSystemStateMaxRate(m_defaultRateHz);
+
+    const QString id = robot.robotId;
+    connect(client, &GatewayClient::connectionStateChanged, this, [this, id](bool connected) {
+        const int i = indexOf(id);
+        if (i < 0) return;
+        m_robots[static_cast<std::size_t>(i)].state.connected = connected;
+        emit connectionStateChanged(id, connected);
+    });
+    connect(client, &GatewayClient::systemStateReceived,
+            this, [this, id](const TaskStatusSnapshot& status) {
+                const int i = indexOf(id);
+                if (i < 0) return;
+                FleetRobotStatus& state = m_robots[static_cast<std::size_t>(i)].state;
+                state.hasStatus = true;
+                state.status    = status;
+                emit systemStateReceived(id, status);
+            });
+    connect(client, &GatewayClient::inspectionEventReceived,
+            this, [this, id](const InspectionEventSnapshot& event) {
+                emit inspectionEventReceived(id, event);
+            });
+    connect(client, &GatewayClient::errorOccurred, this, [this, id](const QString& error) {
+        emit errorOccurred(id, error);
+    });
+
+    m_robots.push_back(std::move(entry));
+    client->connectToGateway(robot.address);
+    subscribe(*client);
+    emit robotAdded(id);
+    return true;
+}
+
+void FleetClient::removeRobot(const QString& robotId)
+{
+    const int i = indexOf(robotId);
+    if (i < 0) return;
+    // The client's destructor disconnects; its queued emissions are dropped
+    // with it.
+    m_robots.erase(m_robots.begin() + i);
+    emit robotRemoved(robotId);
+}
+
+QStringList FleetClient::robotIds() const
+{
+    QStringList ids;
+    ids.reserve(size());
+    for (const Robot& robot : m_robots) {
+        ids.append(robot.state.robotId);
+    }
+    return ids;
+}
+
+GatewayClient* FleetClient::client(const QString& robotId) const
+{
+    const int i = indexOf(robotId);
+    return i < 0 ? nullptr : m_robots[static_cast<std::size_t>(i)].client.get();
+}
+
+// ---------------------------------------------------------------------------
+// Streams
+// ---------------------------------------------------------------------------
+
+void FleetClient::setSubscriptions(bool systemState, bool events,
+                                   const InspectionEventFilter& eventFilter)
+{
+    m_subscribeSystemState = systemState;
+    m_subscribeEvents      = events;
+    m_eventFilter          = eventFilter;
+    for (const Robot& robot : m_robots) {
+        subscribe(*robot.client);
+    }
+}
+
+void FleetClient::subscribe(GatewayClient& client) const
+{
+    // The channel connects lazily; a stream opened before it is READY fails
+    // and is retried by the client's resubscription backoff.
+    if (m_subscribeSystemState) client.subscribeSystemState();
+    if (m_subscribeEvents)      client.subscribeInspectionEvents({}, m_eventFilter);
+}
+
+void FleetClient::setSystemStateMaxRate(const QString& robotId, double hz)
+{
+    if (GatewayClient* c = client(robotId)) {
+        c->setSystemStateMaxRate(hz);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Aggregated state
+// ---------------------------------------------------------------------------
+
+QVector<FleetRobotStatus> FleetClient::statuses() const
+{
+    QVector<FleetRobotStatus> out;
+    out.reserve(size());
+    for (const Robot& robot : m_robots) {
+        out.append(robot.state);
+    }
+    return out;
+}
+
+int FleetClient::indexOf(const QString& robotId) const
+{
+    const auto it = std::find_if(m_robots.begin(), m_robots.end(),
+                                 [&robotId](const Robot& robot) {
+                                     return robot.state.robotId == robotId;
+                                 });
+    return it == m_robots.end() ? -1 : static_cast<int>(it - m_robots.begin());
+}
+
+int FleetClient::connectedCount() const
+{
+    return static_cast<int>(std::count_if(m_robots.begin(), m_robots.end(),
+                                          [](const Robot& robot) {
+                                              return robot.state.connected;
+                                          }));
+}
+
+} // namespace hmi
@@ -0,0 +1,151 @@
+// src/core/FleetClient.h
+//
+// FleetClient – one HMI watching several inspection cells: one GatewayClient
+// per robot (gateway address), all on a single shared RpcEngine.
+//
+// Every call and subscription of every robot completes on the engine's
+// poller threads (kDefaultPollerThreads in total), so a robot adds a channel
+// and a few in-flight calls, not threads.  Each robot keeps its own
+// latest-wins system-state mailbox, and with it its own delivery rate
+// (setSystemStateMaxRate(), kDefaultRobotRateHz): a fast robot cannot crowd
+// out the updates of a slow one, and an overview of N robots costs at most
+// N x rate conversions per second.
+//
+// The per-robot signals are forwarded with the robot ID; statuses() is the
+// aggregated view (connection + latest TaskStatus of every robot) that the
+// operator fleet table shows.  Subscriptions requested with
+// setSubscriptions() apply to every robot, including robots added later,
+// and are re-established by each GatewayClient after a reconnect.
+//
+// Thread safety: GUI thread only.  The clients themselves follow
+// GatewayClient's rules.
+
+#pragma once
+
+#include "GatewayClient.h"
+#include "RpcEngine.h"
+#include "Types.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+namespace hmi {
+
+/// One gateway of the fleet.
+struct FleetRobot {
+    QString robotId;   ///< unique, shown to the operator
+    QString address;   ///< host:port of the robot's gateway
+};
+
+/// Aggregated state of one robot.
+struct FleetRobotStatus {
+    QString            robotId;
+    QString            address;
+    bool               connected = false;
+    bool               hasStatus = false;   ///< a system-state update arrived
+    TaskStatusSnapshot status;              ///< latest update; empty before
+};
+
+class FleetClient : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int    kDefaultPollerThreads = 2;
+    static constexpr double kDefaultRobotRateHz   = 5.0;
+
+    /// Clients run on \a engine; null creates one with kDefaultPollerThreads.
+    explicit FleetClient(std::shared_ptr<RpcEngine> engine = {}, QObject* parent = nullptr);
+    ~FleetClient() override;
+
+    FleetClient(const FleetClient&)            = delete;
+    FleetClient& operator=(const FleetClient&) = delete;
+
+    /// Parse "id=host:port,id2=host:port".  Returns false with \a error set on
+    /// a malformed entry or a duplicate ID.
+    static bool parseRobots(const QString& spec, QVector<FleetRobot>* robots, QString* error);
+
+    [[nodiscard]] std::shared_ptr<RpcEngine> engine() const { return m_engine; }
+
+    // -----------------------------------------------------------------------
+    // Robots
+    // -----------------------------------------------------------------------
+
+    /// Connect to \a robot's gateway and open the requested subscriptions.
+    /// Returns false if the ID is already in the fleet.
+    bool addRobot(const FleetRobot& robot);
+
+    /// Disconnect and drop \a robotId (waits for its in-flight callbacks).
+    void removeRobot(const QString& robotId);
+
+    [[nodiscard]] int         size() const { return static_cast<int>(m_robots.size()); }
+    [[nodiscard]] QStringList robotIds() const;
+
+    /// The client of \a robotId, or null.  Owned by the fleet.
+    [[nodiscard]] GatewayClient* client(const QString& robotId) const;
+
+    // -----------------------------------------------------------------------
+    // Streams
+    // -----------------------------------------------------------------------
+
+    /// Subscribe every robot (all tasks) to the system-state and / or event
+    /// stream; robots added later are subscribed on addRobot().
+    void setSubscriptions(bool systemState, bool events,
+                          const InspectionEventFilter& eventFilter = {});
+
+    /// Cap \a robotId's systemStateReceived at \a hz (see
+    /// GatewayClient::setSystemStateMaxRate()).
+    void setSystemStateMaxRate(const QString& robotId, double hz);
+
+    /// Rate used for robots added from now on (default kDefaultRobotRateHz).
+    void setDefaultSystemStateMaxRate(double hz) { m_defaultRateHz = hz; }
+
+    // -----------------------------------------------------------------------
+    // Aggregated state
+    // -----------------------------------------------------------------------
+
+    /// Every robot in addRobot() order.
+    [[nodiscard]] QVector<FleetRobotStatus> statuses() const;
+
+    /// Robot \a index of statuses(), without copying the others.
+    [[nodiscard]] const FleetRobotStatus& statusAt(int index) const
+    {
+        return m_robots[static_cast<std::size_t>(index)].state;
+    }
+
+    /// Index of \a robotId in statuses(), or -1.
+    [[nodiscard]] int indexOf(const QString& robotId) const;
+
+    [[nodiscard]] int connectedCount() const;
+
+signals:
+    void robotAdded(QString robotId);
+    void robotRemoved(QString robotId);
+
+    void connectionStateChanged(QString robotId, bool connected);
+    void systemStateReceived(QString robotId, hmi::TaskStatusSnapshot status);
+    void inspectionEventReceived(QString robotId, hmi::InspectionEventSnapshot event);
+    void errorOccurred(QString robotId, QString error);
+
+private:
+    struct Robot {
+        FleetRobotStatus               state;
+        std::unique_ptr<GatewayClient> client;
+    };
+
+    void subscribe(GatewayClient& client) const;
+
+    std::shared_ptr<RpcEngine> m_engine;   ///< declared first: outlives the clients
+    std::vector<Robot>         m_robots;
+    double                     m_defaultRateHz = kDefaultRobotRateHz;
+
+    bool                  m_subscribeSystemState = false;
+    bool                  m_subscribeEvents      = false;
+    InspectionEventFilter m_eventFilter;
+};
+
+} // namespace hmi
@@ -0,0 +1,222 @@
+// src/core/FrameProfiler.cpp
+//
+// Implementation of FrameProfiler – see FrameProfiler.h.
+
+#include "FrameProfiler.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <vector>
+
+namespace hmi {
+
+std::atomic<bool> FrameProfiler::s_enabled{false};
+
+const char* profileCategoryName(ProfileCategory category)
+{
+    switch (category) {
+    case ProfileCategory::Paint:     return "paint";
+    case ProfileCategory::Render:    return "render";
+    case ProfileCategory::Resize:    return "resize";
+    case ProfileCategory::Slot:      return "slot";
+    case ProfileCategory::EventLoop: return "eventloop";
+    case ProfileCategory::Startup:   return "startup";
+    }
+    return "?";
+}
+
+namespace {
+
+int64_t toUs(FrameProfiler::Clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+/// Small stable per-thread number for the trace's "tid".
+uint32_t threadIndex()
+{
+    static std::atomic<uint32_t> next{1};
+    thread_local const uint32_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+QString jsonEscaped(const char* s)
+{
+    QString out = QString::fromUtf8(s);
+    out.replace(QLatin1Char('\\'), QLatin1String("\\\\"));
+    out.replace(QLatin1Char('"'), QLatin1String("\\\""));
+    return out;
+}
+
+} // anonymous namespace
+
+FrameProfiler& FrameProfiler::instance()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+FrameProfiler::FrameProfiler(QObject* parent)
+    : QObject(parent)
+    , m_epoch(Clock::now())
+    , m_trace(kTraceCapacity)
+{
+    m_probe.setTimerType(Qt::PreciseTimer);
+    m_probe.setInterval(kEventLoopProbeMs);
+    connect(&m_probe, &QTimer::timeout, this, &FrameProfiler::probeEventLoop);
+}
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+    if (s_enabled.exchange(enabled, std::memory_order_relaxed) == enabled) { return; }
+    if (enabled) {
+        m_probeExpected = Clock::now() + std::chrono::milliseconds(kEventLoopProbeMs);
+        m_probe.start();
+    } else {
+        m_probe.stop();
+    }
+    emit enabledChanged(enabled);
+}
+
+void FrameProfiler::setStallThresholdMs(double ms)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_stallUs = std::max<int64_t>(1, static_cast<int64_t>(ms * 1000.0));
+}
+
+double FrameProfiler::stallThresholdMs() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return double(m_stallUs) / 1000.0;
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+void FrameProfiler::record(const char* name, ProfileCategory category,
+                           Clock::time_point start, Clock::time_point end)
+{
+    const int64_t durUs = std::max<int64_t>(0, toUs(end - start));
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    std::unique_ptr<Section>& section = m_sections[name];
+    if (!section) {
+        section = std::make_unique<Section>();
+        section->category = category;
+    }
+    section->histogram.record(end - start);
+    section->maxUs = std::max(section->maxUs, static_cast<uint64_t>(durUs));
+    if (durUs >= m_stallUs) {
+        ++section->stalls;
+        ++m_longStalls;
+    }
+
+    // The event-loop probe fires every 10 ms; only its late wake-ups are
+    // worth a trace entry.
+    if (category != ProfileCategory::EventLoop || durUs >= m_stallUs) {
+        m_trace.push_back(TraceEvent{ name, category, threadIndex(),
+                                      toUs(start - m_epoch), durUs });
+    }
+}
+
+void FrameProfiler::probeEventLoop()
+{
+    const Clock::time_point now = Clock::now();
+    if (now > m_probeExpected) {
+        // The span the loop was busy past the deadline.
+        record("event loop latency", ProfileCategory::EventLoop, m_probeExpected, now);
+    } else {
+        record("event loop latency", ProfileCategory::EventLoop, now, now);
+    }
+    m_probeExpected = now + std::chrono::milliseconds(kEventLoopProbeMs);
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+FrameProfileSnapshot FrameProfiler::snapshot() const
+{
+    FrameProfileSnapshot out;
+    std::lock_guard<std::mutex> lk(m_mutex);
+    out.longStalls       = m_longStalls;
+    out.stallThresholdMs = double(m_stallUs) / 1000.0;
+    out.sections.reserve(int(m_sections.size()));
+
+    for (const auto& [name, section] : m_sections) {
+        ProfileSectionStats s;
+        s.name      = QString::fromUtf8(name);
+        s.category  = section->category;
+        s.histogram = section->histogram.snapshot();
+        s.stalls    = section->stalls;
+        s.maxUs     = section->maxUs;
+
+        HistogramSnapshot* total = nullptr;
+        if (s.category == ProfileCategory::Paint)     { total = &out.frames; }
+        if (s.category == ProfileCategory::EventLoop) { total = &out.eventLoopLag; }
+        if (total) {
+            for (std::size_t i = 0; i < total->buckets.size(); ++i) {
+                total->buckets[i] += s.histogram.buckets[i];
+            }
+            total->count += s.histogram.count;
+            total->sumUs += s.histogram.sumUs;
+        }
+        out.sections.append(std::move(s));
+    }
+
+    std::sort(out.sections.begin(), out.sections.end(),
+              [](const ProfileSectionStats& a, const ProfileSectionStats& b) {
+                  if (a.stalls != b.stalls) { return a.stalls > b.stalls; }
+                  return a.maxUs > b.maxUs;
+              });
+    return out;
+}
+
+void FrameProfiler::reset()
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_sections.clear();
+    m_trace.clear();
+    m_longStalls = 0;
+}
+
+bool FrameProfiler::writeChromeTrace(const QString& filePath, QString* error) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        if (error) { *error = file.errorString(); }
+        return false;
+    }
+
+    // Copy under the lock, format without it.
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        events.reserve(m_trace.size());
+        for (std::size_t i = 0; i < m_trace.size(); ++i) {
+            events.push_back(m_trace[i]);
+        }
+    }
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+           "\"args\":{\"name\":\"inspection_hmi\"}}";
+    for (const TraceEvent& e : events) {
+        out << ",\n{\"name\":\"" << jsonEscaped(e.name)
+            << "\",\"cat\":\"" << profileCategoryName(e.category)
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+            << ",\"ts\":" << e.startUs << ",\"dur\":" << e.durUs << '}';
+    }
+    out << "\n]}\n";
+    out.flush();
+
+    if (file.error() != QFileDevice::NoError) {
+        if (error) { *error = file.errorString(); }
+        return false;
+    }
+    return true;
+}
+
+} // namespace hmi
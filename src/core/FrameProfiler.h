@@ -0,0 +1,172 @@
+// src/core/FrameProfiler.h
+//
+// FrameProfiler – optional GUI-thread instrumentation for finding stutter.
+//
+// Instrumented code opens a ProfileScope around the work it wants charged:
+// QVTKWidget::paintGL (frame time), the VTK Render() call, resizeGL, and the
+// slots connected to GatewayClient signals (OperatorWindow::updateTaskStatus,
+// ResultPanel::addCaptureEvent, ...).  A 10 ms timer on the GUI thread
+// measures event-loop latency: how late it fires is time the loop spent
+// elsewhere.  Any sample above the stall threshold (50 ms by default) counts
+// as a long stall against its section.
+//
+// Per section the profiler keeps a log2 histogram (as RpcMetrics), the
+// worst sample and the stall count; every span also goes into a bounded
+// trace ring that writeChromeTrace() exports in the Chrome trace event
+// format (chrome://tracing, Perfetto).
+//
+// Disabled (the default) a ProfileScope is one relaxed atomic load.
+// FrameProfilerOverlay shows the numbers; see main.cpp for the toggles.
+//
+// Thread safety: ProfileScope / record() from any thread; setEnabled() and
+// the event-loop probe belong to the GUI thread.
+
+#pragma once
+
+#include "RingBuffer.h"
+#include "RpcMetrics.h"
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace hmi {
+
+enum class ProfileCategory : uint8_t {
+    Paint,       ///< widget paint (QVTKWidget::paintGL) – the frame time
+    Render,      ///< VTK Render()
+    Resize,      ///< resizeGL
+    Slot,        ///< slot connected to a GatewayClient signal
+    EventLoop,   ///< event-loop latency probe
+    Startup,     ///< startup phase (StartupTimeline)
+};
+
+const char* profileCategoryName(ProfileCategory category);
+
+struct ProfileSectionStats {
+    QString           name;
+    ProfileCategory   category = ProfileCategory::Slot;
+    HistogramSnapshot histogram;
+    uint64_t          stalls = 0;    ///< samples above the stall threshold
+    uint64_t          maxUs  = 0;
+};
+
+struct FrameProfileSnapshot {
+    HistogramSnapshot frames;        ///< all Paint samples
+    HistogramSnapshot eventLoopLag;
+    uint64_t          longStalls = 0;
+    double            stallThresholdMs = 0.0;
+    /// Every section, worst first (stalls, then maximum).
+    QVector<ProfileSectionStats> sections;
+};
+
+class FrameProfiler : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int         kEventLoopProbeMs = 10;
+    static constexpr std::size_t kTraceCapacity    = 200000;
+
+    /// The process-wide profiler; create it on the GUI thread first.
+    static FrameProfiler& instance();
+
+    [[nodiscard]] static bool isEnabled() noexcept
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Start / stop recording (and the event-loop probe).
+    void setEnabled(bool enabled);
+
+    void   setStallThresholdMs(double ms);
+    double stallThresholdMs() const;
+
+    /// One span of \a name (a string literal: it is the section key).
+    void record(const char* name, ProfileCategory category,
+                Clock::time_point start, Clock::time_point end);
+
+    [[nodiscard]] FrameProfileSnapshot snapshot() const;
+    void reset();
+
+    /// Write the trace ring as Chrome trace JSON.  Returns false and sets
+    /// \a error when the file cannot be written.
+    bool writeChromeTrace(const QString& filePath, QString* error = nullptr) const;
+
+signals:
+    void enabledChanged(bool enabled);
+
+private:
+    explicit FrameProfiler(QObject* parent = nullptr);
+
+    void probeEventLoop();
+
+    struct Section {
+        ProfileCategory  category = ProfileCategory::Slot;
+        LatencyHistogram histogram;
+        uint64_t         stalls = 0;
+        uint64_t         maxUs  = 0;
+    };
+
+    struct TraceEvent {
+        const char*     name     = nullptr;
+        ProfileCategory category = ProfileCategory::Slot;
+        uint32_t        thread   = 0;
+        int64_t         startUs  = 0;   ///< since m_epoch
+        int64_t         durUs    = 0;
+    };
+
+    static std::atomic<bool> s_enabled;
+
+    const Clock::time_point m_epoch;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<const char*, std::unique_ptr<Section>> m_sections;
+    RingBuffer<TraceEvent> m_trace;
+    uint64_t               m_longStalls = 0;
+    int64_t                m_stallUs    = 50000;
+
+    // GUI thread only.
+    QTimer            m_probe;
+    Clock::time_point m_probeExpected;
+};
+
+/// Records the lifetime of the scope as one span of \a name while the
+/// profiler is enabled.  \a name must be a string literal.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name,
+                          ProfileCategory category = ProfileCategory::Slot) noexcept
+        : m_name(FrameProfiler::isEnabled() ? name : nullptr)
+        , m_category(category)
+    {
+        if (m_name) { m_start = FrameProfiler::Clock::now(); }
+    }
+    ~ProfileScope()
+    {
+        if (m_name) {
+            FrameProfiler::instance().record(m_name, m_category, m_start,
+                                             FrameProfiler::Clock::now());
+        }
+    }
+
+    ProfileScope(const ProfileScope&)            = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char*                      m_name;
+    ProfileCategory                  m_category;
+    FrameProfiler::Clock::time_point m_start{};
+};
+
+} // namespace hmi
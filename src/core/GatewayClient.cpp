@@ -8,20 +8,33 @@
 // Generated protobuf headers (in build/proto_gen/).
 #include "inspection_gateway.pb.h"
 
+#include <google/protobuf/arena.h>
+
 // gRPC runtime (grpcpp.h already included via header).
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
+#include "CadUploadSession.h"
+#include "MediaSink.h"
+#include "PlanCache.h"
+#include "TelemetryReplayer.h"
+
 // Qt.
 #include <QDateTime>
 #include <QDebug>
+#include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMetaObject>
 #include <QString>
+#include <QTemporaryFile>
+#include <QTimer>
 #include <QUuid>
 
 // std.
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <fstream>
@@ -102,13 +115,13 @@ hmi::Result fromGrpcStatus(const Status& st)
 // ---------------------------------------------------------------------------
 // Geometry
 // ---------------------------------------------------------------------------
-hmi::Pose2D fromProtoPose2D(const proto::Pose2D& p)
+hmi::Pose2D fromProtoPose2D(const proto::Pose2D& p, StringPool* pool = nullptr)
 {
     return hmi::Pose2D{
         p.x(),
         p.y(),
         p.yaw(),
-        QString::fromStdString(p.frame_id())
+        toQString(p.frame_id(), pool)
     };
 }
 
@@ -122,7 +135,7 @@ proto::Pose2D toProtoPose2D(const hmi::Pose2D& p)
     return out;
 }
 
-hmi::Pose3D fromProtoPose3D(const proto::Pose3D& p)
+hmi::Pose3D fromProtoPose3D(const proto::Pose3D& p, StringPool* pool = nullptr)
 {
     hmi::Pose3D out;
     if (p.has_position()) {
@@ -139,7 +152,7 @@ hmi::Pose3D fromProtoPose3D(const proto::Pose3D& p)
             static_cast<float>(p.orientation().y()),
             static_cast<float>(p.orientation().z()));
     }
-    out.frameId = QString::fromStdString(p.frame_id());
+    out.frameId = toQString(p.frame_id(), pool);
     return out;
 }
 
@@ -222,27 +235,32 @@ proto::ViewHint toProtoViewHint(const hmi::ViewHint& vh)
 // ---------------------------------------------------------------------------
 // Media
 // ---------------------------------------------------------------------------
-hmi::MediaRef fromProtoMediaRef(const proto::MediaRef& m)
+hmi::MediaRef fromProtoMediaRef(const proto::MediaRef& m, StringPool* pool = nullptr)
 {
     hmi::MediaRef out;
     out.mediaId   = QString::fromStdString(m.media_id());
-    out.mimeType  = QString::fromStdString(m.mime_type());
+    out.mimeType  = toQString(m.mime_type(), pool);
     out.sha256    = QString::fromStdString(m.sha256());
     out.url       = QString::fromStdString(m.url());
     out.sizeBytes = m.size_bytes();
     return out;
 }
 
-hmi::ImageRef fromProtoImageRef(const proto::ImageRef& img)
+hmi::ImageRef fromProtoImageRef(const proto::ImageRef& img, StringPool* pool = nullptr)
 {
     hmi::ImageRef out;
     if (img.has_media()) {
-        out.media = fromProtoMediaRef(img.media());
+        out.media = fromProtoMediaRef(img.media(), pool);
     }
     out.width         = img.width();
     out.height        = img.height();
     const auto& thumb = img.thumbnail_jpeg();
     out.thumbnailJpeg = QByteArray(thumb.data(), static_cast<int>(thumb.size()));
+#ifdef HMI_PROTO_EXTENSIONS
+    if (img.has_thumbnail_media()) {
+        out.thumbnailMedia = fromProtoMediaRef(img.thumbnail_media(), pool);
+    }
+#endif
     return out;
 }
 
@@ -254,11 +272,12 @@ hmi::BoundingBox2D fromProtoBbox(const proto::BoundingBox2D& bb)
     return hmi::BoundingBox2D{bb.x(), bb.y(), bb.w(), bb.h()};
 }
 
-hmi::DefectResult fromProtoDefectResult(const proto::DefectResult& dr)
+hmi::DefectResult fromProtoDefectResult(const proto::DefectResult& dr,
+                                       StringPool* pool = nullptr)
 {
     hmi::DefectResult out;
     out.hasDefect  = dr.has_defect();
-    out.defectType = QString::fromStdString(dr.defect_type());
+    out.defectType = toQString(dr.defect_type(), pool);
     out.confidence = dr.confidence();
     if (dr.has_bbox()) {
         out.bbox = fromProtoBbox(dr.bbox());
@@ -355,13 +374,19 @@ hmi::InspectionPoint fromProtoInspectionPoint(const proto::InspectionPoint& ip)
     return out;
 }
 
+constexpr int kMaxReservedWaypoints = 100000;
+
 hmi::InspectionPath fromProtoInspectionPath(const proto::InspectionPath& path)
 {
     hmi::InspectionPath out;
     out.totalPoints        = path.total_points();
     out.estimatedDistanceM = path.estimated_distance_m();
     out.estimatedDurationS = path.estimated_duration_s();
-    out.waypoints.reserve(path.waypoints_size());
+    // total_points is the planner's count; trust it for the reservation only
+    // within reason, the repeated field is authoritative.
+    out.waypoints.reserve(std::max(path.waypoints_size(),
+                                   std::clamp(static_cast<int>(path.total_points()), 0,
+                                              kMaxReservedWaypoints)));
     for (const auto& wp : path.waypoints()) {
         out.waypoints.append(fromProtoInspectionPoint(wp));
     }
@@ -399,35 +424,35 @@ hmi::TaskPhase fromProtoTaskPhase(proto::TaskPhase ph)
 // ---------------------------------------------------------------------------
 // AgvStatus / ArmStatus / TaskStatus
 // ---------------------------------------------------------------------------
-hmi::AgvStatus fromProtoAgvStatus(const proto::AgvStatus& a)
+hmi::AgvStatus fromProtoAgvStatus(const proto::AgvStatus& a, StringPool* pool)
 {
     hmi::AgvStatus out;
     out.connected           = a.connected();
     out.arrived             = a.arrived();
     out.moving              = a.moving();
     out.stopped             = a.stopped();
-    if (a.has_current_pose()) { out.currentPose = fromProtoPose2D(a.current_pose()); }
+    if (a.has_current_pose()) { out.currentPose = fromProtoPose2D(a.current_pose(), pool); }
     out.batteryPercent      = a.battery_percent();
-    out.errorCode           = QString::fromStdString(a.error_code());
+    out.errorCode           = toQString(a.error_code(), pool);
     out.linearVelocityMps   = a.linear_velocity_mps();
     out.angularVelocityRps  = a.angular_velocity_rps();
-    if (a.has_goal_pose())    { out.goalPose = fromProtoPose2D(a.goal_pose()); }
-    out.mapId               = QString::fromStdString(a.map_id());
+    if (a.has_goal_pose())    { out.goalPose = fromProtoPose2D(a.goal_pose(), pool); }
+    out.mapId               = toQString(a.map_id(), pool);
     out.localizationQuality = a.localization_quality();
     return out;
 }
 
-hmi::ArmStatus fromProtoArmStatus(const proto::ArmStatus& a)
+hmi::ArmStatus fromProtoArmStatus(const proto::ArmStatus& a, StringPool* pool)
 {
     hmi::ArmStatus out;
     out.connected      = a.connected();
     out.arrived        = a.arrived();
     out.moving         = a.moving();
     out.manipulability = a.manipulability();
-    out.errorCode      = QString::fromStdString(a.error_code());
+    out.errorCode      = toQString(a.error_code(), pool);
     out.servoEnabled   = a.servo_enabled();
-    if (a.has_tcp_pose())  { out.tcpPose  = fromProtoPose3D(a.tcp_pose());  }
-    if (a.has_base_pose()) { out.basePose = fromProtoPose3D(a.base_pose()); }
+    if (a.has_tcp_pose())  { out.tcpPose  = fromProtoPose3D(a.tcp_pose(), pool);  }
+    if (a.has_base_pose()) { out.basePose = fromProtoPose3D(a.base_pose(), pool); }
 
     const int nj = std::min(a.current_joints_size(), 6);
     for (int i = 0; i < nj; ++i) {
@@ -436,26 +461,27 @@ hmi::ArmStatus fromProtoArmStatus(const proto::ArmStatus& a)
     return out;
 }
 
-hmi::TaskStatus fromProtoTaskStatus(const proto::TaskStatus& ts)
+/// \a pool interns the identifier-like fields (see StringPool).
+hmi::TaskStatus fromProtoTaskStatus(const proto::TaskStatus& ts, StringPool* pool = nullptr)
 {
     hmi::TaskStatus out;
-    out.taskId          = QString::fromStdString(ts.task_id());
+    out.taskId          = toQString(ts.task_id(), pool);
     out.phase           = fromProtoTaskPhase(ts.phase());
     out.progressPercent = ts.progress_percent();
-    out.currentAction   = QString::fromStdString(ts.current_action());
+    out.currentAction   = toQString(ts.current_action(), pool);
     out.errorMessage    = QString::fromStdString(ts.error_message());
-    if (ts.has_agv())   { out.agv = fromProtoAgvStatus(ts.agv()); }
-    if (ts.has_arm())   { out.arm = fromProtoArmStatus(ts.arm()); }
+    if (ts.has_agv())   { out.agv = fromProtoAgvStatus(ts.agv(), pool); }
+    if (ts.has_arm())   { out.arm = fromProtoArmStatus(ts.arm(), pool); }
     if (ts.has_updated_at())  { out.updatedAt  = fromTimestamp(ts.updated_at());  }
     if (ts.has_started_at())  { out.startedAt  = fromTimestamp(ts.started_at());  }
     if (ts.has_finished_at()) { out.finishedAt = fromTimestamp(ts.finished_at()); }
-    out.planId                  = QString::fromStdString(ts.plan_id());
-    out.taskName                = QString::fromStdString(ts.task_name());
+    out.planId                  = toQString(ts.plan_id(), pool);
+    out.taskName                = toQString(ts.task_name(), pool);
     out.currentWaypointIndex    = ts.current_waypoint_index();
     out.currentPointId          = ts.current_point_id();
     out.totalWaypoints          = ts.total_waypoints();
     out.interlockOk             = ts.interlock_ok();
-    out.interlockMessage        = QString::fromStdString(ts.interlock_message());
+    out.interlockMessage        = toQString(ts.interlock_message(), pool);
     out.remainingTimeEstS       = ts.remaining_time_est_s();
     return out;
 }
@@ -475,24 +501,51 @@ hmi::InspectionEventType fromProtoEventType(proto::InspectionEventType et)
     }
 }
 
+#ifdef HMI_PROTO_EXTENSIONS
+// ---------------------------------------------------------------------------
+// InspectionEventFilter → SubscribeRequest (extension fields)
+// ---------------------------------------------------------------------------
+void toProtoEventFilter(const hmi::InspectionEventFilter& filter, proto::SubscribeRequest& req)
+{
+    using T = hmi::InspectionEventType;
+    static constexpr std::pair<T, proto::InspectionEventType> kTypes[] = {
+        { T::Info,        proto::INFO },
+        { T::Warn,        proto::WARN },
+        { T::Error,       proto::ERROR },
+        { T::Captured,    proto::CAPTURED },
+        { T::DefectFound, proto::DEFECT_FOUND },
+    };
+    if (filter.typeMask != hmi::InspectionEventFilter::kAllTypes) {
+        for (const auto& [type, protoType] : kTypes) {
+            if (filter.acceptsType(type)) { req.add_event_types(protoType); }
+        }
+    }
+    req.set_min_point_id(filter.minPointId);
+    req.set_max_point_id(filter.maxPointId);
+    req.set_omit_thumbnails(!filter.includeThumbnails);
+}
+#endif
+
 // ---------------------------------------------------------------------------
 // InspectionEvent
 // ---------------------------------------------------------------------------
-hmi::InspectionEvent fromProtoInspectionEvent(const proto::InspectionEvent& ev)
+hmi::InspectionEvent fromProtoInspectionEvent(const proto::InspectionEvent& ev,
+                                              StringPool* pool = nullptr)
 {
     hmi::InspectionEvent out;
-    out.taskId    = QString::fromStdString(ev.task_id());
+    out.taskId    = toQString(ev.task_id(), pool);
     out.pointId   = ev.point_id();
     out.type      = fromProtoEventType(ev.type());
     out.message   = QString::fromStdString(ev.message());
-    if (ev.has_defect())    { out.defect    = fromProtoDefectResult(ev.defect()); }
+    if (ev.has_defect())    { out.defect    = fromProtoDefectResult(ev.defect(), pool); }
     if (ev.has_timestamp()) { out.timestamp = fromTimestamp(ev.timestamp()); }
-    out.captureId = QString::fromStdString(ev.capture_id());
-    out.cameraId  = QString::fromStdString(ev.camera_id());
-    if (ev.has_image())      { out.image     = fromProtoImageRef(ev.image()); }
-    if (ev.has_camera_pose()){ out.cameraPose = fromProtoPose3D(ev.camera_pose()); }
+    out.captureId = QString::fromStdString(ev.capture_id());   // unique per capture
+    out.cameraId  = toQString(ev.camera_id(), pool);
+    if (ev.has_image())      { out.image     = fromProtoImageRef(ev.image(), pool); }
+    if (ev.has_camera_pose()){ out.cameraPose = fromProtoPose3D(ev.camera_pose(), pool); }
+    out.defects.reserve(ev.defects_size());
     for (const auto& d : ev.defects()) {
-        out.defects.append(fromProtoDefectResult(d));
+        out.defects.append(fromProtoDefectResult(d, pool));
     }
     return out;
 }
@@ -500,17 +553,19 @@ hmi::InspectionEvent fromProtoInspectionEvent(const proto::InspectionEvent& ev)
 // ---------------------------------------------------------------------------
 // CaptureRecord
 // ---------------------------------------------------------------------------
-hmi::CaptureRecord fromProtoCaptureRecord(const proto::CaptureRecord& cr)
+hmi::CaptureRecord fromProtoCaptureRecord(const proto::CaptureRecord& cr,
+                                          StringPool* pool = nullptr)
 {
     hmi::CaptureRecord out;
-    out.taskId    = QString::fromStdString(cr.task_id());
+    out.taskId    = toQString(cr.task_id(), pool);
     out.pointId   = cr.point_id();
     out.captureId = QString::fromStdString(cr.capture_id());
-    out.cameraId  = QString::fromStdString(cr.camera_id());
-    if (cr.has_image())      { out.image     = fromProtoImageRef(cr.image()); }
+    out.cameraId  = toQString(cr.camera_id(), pool);
+    if (cr.has_image())      { out.image     = fromProtoImageRef(cr.image(), pool); }
     if (cr.has_captured_at()){ out.capturedAt = fromTimestamp(cr.captured_at()); }
+    out.defects.reserve(cr.defects_size());
     for (const auto& d : cr.defects()) {
-        out.defects.append(fromProtoDefectResult(d));
+        out.defects.append(fromProtoDefectResult(d, pool));
     }
     return out;
 }
@@ -540,14 +595,89 @@ std::chrono::system_clock::time_point deadlineFromNow(int seconds)
     return std::chrono::system_clock::now() + std::chrono::seconds(seconds);
 }
 
+// Connection monitoring.
+constexpr int kStateWatchSafetySec = 60;
+constexpr int kResubscribeBaseMs   = 250;
+constexpr int kResubscribeMaxMs    = 10000;
+
+// HTTP/2 keepalive: ping every 10 s, declare the link dead after 5 s without
+// an ack, also while no call is active (the gateway must permit this, see
+// its keepalive enforcement policy).
+constexpr int kKeepaliveTimeMs      = 10000;
+constexpr int kKeepaliveTimeoutMs   = 5000;
+// Reconnect quickly after a drop instead of gRPC's default 1 s .. 120 s.
+constexpr int kReconnectBackoffMinMs = 250;
+constexpr int kReconnectBackoffMaxMs = 5000;
+
+grpc::ChannelArguments channelArguments()
+{
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, kKeepaliveTimeMs);
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, kKeepaliveTimeoutMs);
+    args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+    args.SetInt(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+    args.SetInt(GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS, kReconnectBackoffMinMs);
+    args.SetInt(GRPC_ARG_MIN_RECONNECT_BACKOFF_MS, kReconnectBackoffMinMs);
+    args.SetInt(GRPC_ARG_MAX_RECONNECT_BACKOFF_MS, kReconnectBackoffMaxMs);
+    return args;
+}
+
+/// Failures the link caused, as opposed to our own cancels (pre-empted
+/// downloads, held prefetch) and application errors such as NOT_FOUND.
+bool isLinkFailure(const grpc::Status& st)
+{
+    switch (st.error_code()) {
+    case grpc::StatusCode::UNAVAILABLE:
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+    case grpc::StatusCode::RESOURCE_EXHAUSTED:
+        return true;
+    default:
+        return false;
+    }
+}
+
 } // anonymous namespace
 
+// ===========================================================================
+// Instrumented unary calls
+// ===========================================================================
+
+template <typename Response, typename Request, typename PrepareFn>
+void GatewayClient::startTimedUnary(RpcMethod method, const Request& request,
+                                    std::chrono::system_clock::time_point deadline,
+                                    PrepareFn&& prepare,
+                                    RpcEngine::UnaryDoneFn<Response> done,
+                                    RpcEngine::ArenaPool::Lease arena)
+{
+    const auto        start     = RpcMetrics::Clock::now();
+    const std::size_t bytesSent = request.ByteSizeLong();
+    m_engine->startUnary<Response>(
+        m_calls, request, deadline, std::forward<PrepareFn>(prepare),
+        [this, method, start, bytesSent, done = std::move(done)](
+            const Status& st, Response& resp) {
+            m_metrics.recordCall(method, RpcMetrics::Clock::now() - start, st.ok(),
+                                 bytesSent, st.ok() ? resp.ByteSizeLong() : 0,
+                                 isLinkFailure(st));
+            done(st, resp);
+        },
+        std::move(arena));
+}
+
 // ===========================================================================
 // GatewayClient – constructor / destructor
 // ===========================================================================
 
 GatewayClient::GatewayClient(const QString& address, QObject* parent)
+    : GatewayClient(std::make_shared<RpcEngine>(1), address, parent)
+{}
+
+GatewayClient::GatewayClient(std::shared_ptr<RpcEngine> engine, const QString& address,
+                             QObject* parent)
     : QObject(parent)
+    , m_engine(std::move(engine))
+    , m_calls(std::make_shared<RpcEngine::CallSet>())
+    , m_sysStateCalls(std::make_shared<RpcEngine::CallSet>())
+    , m_eventsCalls(std::make_shared<RpcEngine::CallSet>())
 {
     // Register Qt metatypes so they cross thread boundaries in queued signals.
     qRegisterMetaType<hmi::Result>();
@@ -556,10 +686,18 @@ GatewayClient::GatewayClient(const QString& address, QObject* parent)
     qRegisterMetaType<hmi::PlanResponse>();
     qRegisterMetaType<hmi::GetPlanResponse>();
     qRegisterMetaType<hmi::NavMapInfo>();
+    qRegisterMetaType<hmi::MediaRef>();
+    qRegisterMetaType<hmi::MediaPayload>();
     qRegisterMetaType<hmi::CaptureRecord>();
     qRegisterMetaType<QVector<hmi::CaptureRecord>>();
     qRegisterMetaType<QVector<hmi::DefectResult>>();
     qRegisterMetaType<QVector<hmi::InspectionTarget>>();
+    qRegisterMetaType<hmi::TaskStatusSnapshot>();
+    qRegisterMetaType<hmi::InspectionEventSnapshot>();
+    qRegisterMetaType<hmi::PlanResponseSnapshot>();
+    qRegisterMetaType<hmi::GetPlanResponseSnapshot>();
+
+    m_planCachePool.setMaxThreadCount(1);
 
     if (!address.isEmpty()) {
         connectToGateway(address);
@@ -568,7 +706,10 @@ GatewayClient::GatewayClient(const QString& address, QObject* parent)
 
 GatewayClient::~GatewayClient()
 {
+    stopTelemetryReplay();
     disconnectFromGateway();
+    m_planCachePool.waitForDone();   // after the last RPC callback that can post
+    stopTelemetryRecording();
 }
 
 // ===========================================================================
@@ -586,6 +727,235 @@ QString GatewayClient::currentAddress() const
     return m_address;
 }
 
+// ===========================================================================
+// System-state delivery rate
+// ===========================================================================
+
+void GatewayClient::setSystemStateMaxRate(double hz)
+{
+    const int intervalMs = hz > 0.0 ? std::max(1, qRound(1000.0 / hz)) : 0;
+    m_sysStateIntervalMs.store(intervalMs, std::memory_order_relaxed);
+}
+
+double GatewayClient::systemStateMaxRate() const noexcept
+{
+    const int intervalMs = m_sysStateIntervalMs.load(std::memory_order_relaxed);
+    return intervalMs > 0 ? 1000.0 / intervalMs : 0.0;
+}
+
+MailboxStats GatewayClient::systemStateStats() const
+{
+    return m_sysStateMailbox.stats();
+}
+
+void GatewayClient::setRobotStateObserver(RobotStateObserver observer)
+{
+    std::shared_ptr<const RobotStateObserver> next;
+    if (observer) {
+        next = std::make_shared<const RobotStateObserver>(std::move(observer));
+    }
+    std::atomic_store(&m_robotObserver, std::move(next));
+}
+
+// ---------------------------------------------------------------------------
+// drainSystemState – runs on the main thread.
+//
+// Scheduled by the reader thread only when it fills an empty mailbox, so at
+// most one drain is outstanding at any time.  If the previous emission was
+// too recent the drain re-arms itself for the remainder of the interval; the
+// mailbox keeps absorbing newer updates meanwhile.  The proto message is
+// converted here, so only delivered updates pay for fromProtoTaskStatus().
+// ---------------------------------------------------------------------------
+void GatewayClient::drainSystemState()
+{
+    const int intervalMs = m_sysStateIntervalMs.load(std::memory_order_relaxed);
+    if (intervalMs > 0 && m_sysStateLastDelivery.isValid()) {
+        const qint64 elapsed = m_sysStateLastDelivery.elapsed();
+        if (elapsed < intervalMs) {
+            QTimer::singleShot(static_cast<int>(intervalMs - elapsed),
+                               Qt::PreciseTimer, this,
+                               [this]() { drainSystemState(); });
+            return;
+        }
+    }
+
+    std::optional<proto::TaskStatus> raw = m_sysStateMailbox.take();
+    if (!raw) { return; }
+
+    const auto convertAt = RpcMetrics::Clock::now();
+    const hmi::TaskStatusSnapshot ts(fromProtoTaskStatus(*raw, &m_sysStatePool));
+    const auto convertedAt = RpcMetrics::Clock::now();
+    m_metrics.recordConversion(RpcMethod::SubscribeSystemState, convertedAt - convertAt);
+
+    const RpcMetrics::Clock::time_point readAt{RpcMetrics::Clock::duration{
+        m_sysStateReadAtNs.load(std::memory_order_relaxed)}};
+    m_metrics.recordDeliveryLag(RpcMethod::SubscribeSystemState, convertedAt - readAt);
+
+    m_sysStateLastDelivery.start();
+    emit systemStateReceived(ts);
+}
+
+// ---------------------------------------------------------------------------
+// Stream delivery – shared by the reader threads and telemetry replay.
+// ---------------------------------------------------------------------------
+void GatewayClient::publishSystemState(proto::SystemStateEvent& ev,
+                                       RpcMetrics::Clock::time_point readAt)
+{
+    // The observer sees every message, including those the mailbox will
+    // supersede; only the scalar fields are read.
+    if (const auto observer = std::atomic_load(&m_robotObserver)) {
+        const proto::TaskStatus& ts = ev.status();
+        RobotStateSample sample;
+        if (ts.has_agv() && ts.agv().has_current_pose()) {
+            const proto::Pose2D& p = ts.agv().current_pose();
+            sample.hasAgv = true;
+            sample.agvX   = p.x();
+            sample.agvY   = p.y();
+            sample.agvYaw = p.yaw();
+        }
+        if (ts.has_arm() && ts.arm().current_joints_size() > 0) {
+            sample.hasArm = true;
+            const int nj = std::min(ts.arm().current_joints_size(), 6);
+            for (int i = 0; i < nj; ++i) {
+                sample.joints[static_cast<std::size_t>(i)] = ts.arm().current_joints(i);
+            }
+        }
+        (*observer)(sample);
+    }
+
+    // Hand over the raw message (a swap, no copy); the drain converts.
+    proto::TaskStatus status;
+    status.Swap(ev.mutable_status());
+
+    // Latest-wins: only the first update into an empty mailbox schedules a
+    // drain; later ones overwrite it until then.
+    m_sysStateReadAtNs.store(readAt.time_since_epoch().count(), std::memory_order_relaxed);
+    if (m_sysStateMailbox.publish(std::move(status))) {
+        QMetaObject::invokeMethod(this, [this]() {
+            drainSystemState();
+        }, Qt::QueuedConnection);
+    }
+}
+
+void GatewayClient::deliverInspectionEvent(proto::InspectionEvent& ev,
+                                           const hmi::InspectionEventFilter& filter,
+                                           StringPool& pool, RpcMetrics::Clock::time_point readAt)
+{
+    // Checked on the raw message: a rejected event costs two comparisons,
+    // and an unwanted thumbnail is dropped before it is copied out.
+    if (!filter.accepts(fromProtoEventType(ev.type()), ev.point_id())) { return; }
+    if (!filter.includeThumbnails && ev.has_image()) {
+        ev.mutable_image()->clear_thumbnail_jpeg();
+    }
+
+    hmi::InspectionEventSnapshot out(fromProtoInspectionEvent(ev, &pool));
+    m_metrics.recordConversion(RpcMethod::SubscribeInspectionEvents,
+                               RpcMetrics::Clock::now() - readAt);
+    QMetaObject::invokeMethod(this, [this, out, readAt]() {
+        m_metrics.recordDeliveryLag(RpcMethod::SubscribeInspectionEvents,
+                                    RpcMetrics::Clock::now() - readAt);
+        emit inspectionEventReceived(out);
+    }, Qt::QueuedConnection);
+}
+
+// ===========================================================================
+// Telemetry recording / replay
+// ===========================================================================
+
+template <typename Message>
+void GatewayClient::recordTelemetry(TelemetryStream stream, const Message& message,
+                                    std::string& scratch)
+{
+    const std::shared_ptr<TelemetryRecorder> recorder = std::atomic_load(&m_recorder);
+    if (!recorder) { return; }
+    scratch.clear();
+    message.SerializeToString(&scratch);
+    const int64_t receivedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    recorder->record(stream, receivedNs, scratch);
+}
+
+hmi::Result GatewayClient::startTelemetryRecording(const QString& directory,
+                                                   const TelemetryRecorderOptions& options)
+{
+    stopTelemetryRecording();
+    auto recorder = std::make_shared<TelemetryRecorder>(directory, options);
+    if (!recorder->start()) {
+        return { hmi::ErrorCode::InvalidArgument, recorder->errorString() };
+    }
+    std::atomic_store(&m_recorder, std::move(recorder));
+    return { hmi::ErrorCode::Ok, {} };
+}
+
+void GatewayClient::stopTelemetryRecording()
+{
+    // Readers holding the old pointer finish their record() call; the
+    // recorder flushes when the last reference goes.
+    std::shared_ptr<TelemetryRecorder> recorder =
+        std::atomic_exchange(&m_recorder, std::shared_ptr<TelemetryRecorder>());
+    if (recorder) {
+        recorder->stop();
+    }
+}
+
+TelemetryRecorderStats GatewayClient::telemetryRecorderStats() const
+{
+    const std::shared_ptr<TelemetryRecorder> recorder = std::atomic_load(&m_recorder);
+    return recorder ? recorder->stats() : TelemetryRecorderStats{};
+}
+
+hmi::Result GatewayClient::startTelemetryReplay(const QString& path, double speed)
+{
+    stopTelemetryReplay();
+
+    // Frames arrive on the replay thread and take the same delivery path
+    // as the live readers (mailbox for system state, queued emission for
+    // events), so the UI cannot tell a replay from a live stream.
+    // Replayed events pass the filter of the current event subscription,
+    // as live ones would.
+    hmi::InspectionEventFilter filter;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        filter = m_eventsFilter;
+    }
+    auto pool = std::make_shared<StringPool>();
+    auto replayer = std::make_unique<TelemetryReplayer>(
+        path, speed,
+        [this, pool, filter](TelemetryStream stream, int64_t /*receivedNs*/,
+                     const char* data, std::size_t size) {
+            const auto readAt = RpcMetrics::Clock::now();
+            if (stream == TelemetryStream::SystemState) {
+                proto::SystemStateEvent ev;
+                if (ev.ParseFromArray(data, static_cast<int>(size))) {
+                    publishSystemState(ev, readAt);
+                }
+            } else if (stream == TelemetryStream::InspectionEvent) {
+                proto::InspectionEvent ev;
+                if (ev.ParseFromArray(data, static_cast<int>(size))) {
+                    deliverInspectionEvent(ev, filter, *pool, readAt);
+                }
+            }
+        },
+        [this](const hmi::Result& result, uint64_t /*frames*/) {
+            QMetaObject::invokeMethod(this, [this, result]() {
+                emit telemetryReplayFinished(result);
+            }, Qt::QueuedConnection);
+        });
+    if (!replayer->start()) {
+        return { hmi::ErrorCode::NotFound, replayer->errorString() };
+    }
+    m_replayer = std::move(replayer);
+    return { hmi::ErrorCode::Ok, {} };
+}
+
+void GatewayClient::stopTelemetryReplay()
+{
+    if (m_replayer) {
+        m_replayer->stop();
+        m_replayer.reset();
+    }
+}
+
 // ===========================================================================
 // Connection management
 // ===========================================================================
@@ -598,9 +968,11 @@ void GatewayClient::connectToGateway(const QString& address)
     {
         std::lock_guard<std::mutex> lk(m_mutex);
         m_address = address;
-        m_channel = grpc::CreateChannel(
+        m_channel = grpc::CreateCustomChannel(
             address.toStdString(),
-            grpc::InsecureChannelCredentials());
+            grpc::InsecureChannelCredentials(),
+            channelArguments());
+        m_connStats = {};
         m_stub = proto::InspectionGateway::NewStub(m_channel);
     }
 
@@ -611,12 +983,23 @@ void GatewayClient::disconnectFromGateway()
 {
     stopSubscriptions();
     stopConnectionMonitor();
+    // A GetPlan revalidation already queued on the cache pool could start its
+    // RPC after the cancel below: retire the generation, then let the
+    // pool drain so that no task is between its check and its RPC start.
+    m_connectionGeneration.fetch_add(1, std::memory_order_acq_rel);
+    m_planCachePool.waitForDone();
+    // Unary calls are cancelled rather than awaited; their callbacks still run
+    // (with CANCELLED) before cancelAndWait() returns.
+    m_calls->cancelAndWait();
     joinAllWorkers();
 
     std::lock_guard<std::mutex> lk(m_mutex);
     m_stub.reset();
     m_channel.reset();
     m_address.clear();
+    // Another gateway (or a restarted one) may hold a different set.
+    m_targetSync.clear();
+    m_deltaUnsupported.store(false, std::memory_order_relaxed);
 
     if (m_connected.exchange(false)) {
         QMetaObject::invokeMethod(this, [this]() {
@@ -630,11 +1013,19 @@ void GatewayClient::disconnectFromGateway()
 // ---------------------------------------------------------------------------
 void GatewayClient::stopSubscriptions()
 {
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        // Keep the generations, so ends of the cancelled streams stay stale.
+        for (StreamWant* w : { &m_sysStateWant, &m_eventsWant }) {
+            const uint64_t generation = w->generation;
+            *w = {};
+            w->generation = generation;
+        }
+    }
     cancelAllContexts();
 
-    if (m_sysStateThread.joinable())  { m_sysStateThread.join(); }
-    if (m_eventsThread.joinable())    { m_eventsThread.join(); }
-    if (m_downloadThread.joinable())  { m_downloadThread.join(); }
+    m_sysStateCalls->cancelAndWait();
+    m_eventsCalls->cancelAndWait();
 }
 
 // ---------------------------------------------------------------------------
@@ -643,13 +1034,20 @@ void GatewayClient::stopSubscriptions()
 void GatewayClient::cancelAllContexts()
 {
     std::lock_guard<std::mutex> lk(m_mutex);
-    if (m_sysStateCtx)  { m_sysStateCtx->TryCancel(); }
-    if (m_eventsCtx)    { m_eventsCtx->TryCancel(); }
-    if (m_downloadCtx)  { m_downloadCtx->TryCancel(); }
+    m_sysStateCalls->cancelAll();
+    m_eventsCalls->cancelAll();
+    // Media downloads complete asynchronously with a "Cancelled" result.
+    for (const auto& [id, dl] : m_downloads) {
+        dl.ctx->TryCancel();
+    }
+    // CAD uploads end on their worker threads (joinAllWorkers).
+    for (const auto& session : m_uploads) {
+        session->cancel();
+    }
 }
 
 // ---------------------------------------------------------------------------
-// Internal: joinAllWorkers  – wait for all one-shot RPC threads.
+// Internal: joinAllWorkers  – wait for all upload worker threads.
 // ---------------------------------------------------------------------------
 void GatewayClient::joinAllWorkers()
 {
@@ -664,50 +1062,218 @@ void GatewayClient::joinAllWorkers()
 }
 
 // ---------------------------------------------------------------------------
-// Internal: connection state monitor thread.
+// Internal: connection state monitor.
 //
-// Polls the gRPC channel state every 500 ms and emits connectionStateChanged
-// when it transitions between READY and anything else.
+// One NotifyOnStateChange watch is outstanding on the RpcEngine queue at any
+// time; its callback reads the new state, reports READY <-> not-READY
+// transitions and re-arms.  The deadline is only a safety net – nothing runs
+// while the state is stable.  Destroying the channel (disconnect) completes
+// the last watch, whose callback then finds the owner cleared.
 // ---------------------------------------------------------------------------
 void GatewayClient::startConnectionMonitor()
 {
-    m_stopMonitor.store(false);
-    m_connMonitorThread = std::thread([this]() {
-        bool lastReady = false;
-        while (!m_stopMonitor.load(std::memory_order_relaxed)) {
-            std::shared_ptr<grpc::Channel> ch;
-            {
-                std::lock_guard<std::mutex> lk(m_mutex);
-                ch = m_channel;
+    auto watch = std::make_shared<ChannelWatch>();
+    watch->owner = this;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        watch->channel = m_channel;
+        m_channelWatch = watch;
+    }
+    std::lock_guard<std::mutex> lk(watch->mutex);
+    armChannelWatch(watch);
+}
+
+void GatewayClient::stopConnectionMonitor()
+{
+    std::shared_ptr<ChannelWatch> watch;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        watch = std::move(m_channelWatch);
+    }
+    if (watch) {
+        std::lock_guard<std::mutex> lk(watch->mutex);
+        watch->owner = nullptr;
+    }
+}
+
+void GatewayClient::armChannelWatch(const std::shared_ptr<ChannelWatch>& watch)
+{
+    std::shared_ptr<grpc::Channel> ch = watch->channel.lock();
+    if (!ch) { return; }
+
+    const grpc_connectivity_state state = ch->GetState(/*try_to_connect=*/true);
+    const bool nowReady = (state == GRPC_CHANNEL_READY);
+
+    if (nowReady != watch->ready) {
+        watch->ready = nowReady;
+        m_connected.store(nowReady, std::memory_order_relaxed);
+
+        const auto now = std::chrono::steady_clock::now();
+        qint64 reconnectMs = -1;
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (!nowReady) {
+                watch->lost   = true;
+                watch->lostAt = now;
+                ++m_connStats.drops;
+            } else if (watch->lost) {
+                watch->lost = false;
+                reconnectMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  now - watch->lostAt).count();
+                ++m_connStats.reconnects;
+                m_connStats.lastReconnectMs   = reconnectMs;
+                m_connStats.maxReconnectMs    = std::max(m_connStats.maxReconnectMs, reconnectMs);
+                m_connStats.totalReconnectMs += reconnectMs;
             }
-            if (!ch) { break; }
+        }
 
-            grpc_connectivity_state state = ch->GetState(/*try_to_connect=*/true);
-            bool nowReady = (state == GRPC_CHANNEL_READY);
+        QMetaObject::invokeMethod(this, [this, nowReady, reconnectMs]() {
+            emit connectionStateChanged(nowReady);
+            if (nowReady && reconnectMs >= 0) {
+                resubscribe(Stream::SystemState);
+                resubscribe(Stream::Events);
+            }
+        }, Qt::QueuedConnection);
+    }
 
-            if (nowReady != lastReady) {
-                lastReady = nowReady;
-                m_connected.store(nowReady, std::memory_order_relaxed);
-                QMetaObject::invokeMethod(this, [this, nowReady]() {
-                    emit connectionStateChanged(nowReady);
-                }, Qt::QueuedConnection);
+    m_engine->notifyOnStateChange(*ch, state, deadlineFromNow(kStateWatchSafetySec),
+        [watch](bool /*changed*/) {
+            std::lock_guard<std::mutex> lk(watch->mutex);
+            if (watch->owner) {
+                watch->owner->armChannelWatch(watch);
             }
+        });
+}
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        }
-    });
+ConnectionStats GatewayClient::connectionStats() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_connStats;
 }
 
-void GatewayClient::stopConnectionMonitor()
+// ===========================================================================
+// RPC instrumentation
+// ===========================================================================
+
+RpcMetricsSnapshot GatewayClient::rpcMetrics() const
+{
+    return m_metrics.snapshot();
+}
+
+void GatewayClient::resetRpcMetrics()
+{
+    m_metrics.reset();
+    m_lastMetricsDump = {};
+}
+
+void GatewayClient::setRpcMetricsDump(const QString& filePath, int intervalMs)
+{
+    m_metricsDumpPath = filePath;
+    if (filePath.isEmpty()) {
+        if (m_metricsDumpTimer) { m_metricsDumpTimer->stop(); }
+        return;
+    }
+    if (!m_metricsDumpTimer) {
+        m_metricsDumpTimer = new QTimer(this);
+        connect(m_metricsDumpTimer, &QTimer::timeout, this, [this]() { dumpRpcMetrics(); });
+    }
+    m_lastMetricsDump = m_metrics.snapshot();
+    m_metricsDumpTimer->start(std::max(100, intervalMs));
+}
+
+void GatewayClient::setMediaQuality(const MediaQuality& quality)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_mediaQuality = quality;
+}
+
+MediaQuality GatewayClient::mediaQuality() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_mediaQuality;
+}
+
+void GatewayClient::dumpRpcMetrics()
+{
+    QFile file(m_metricsDumpPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "GatewayClient: cannot write RPC metrics to" << m_metricsDumpPath;
+        return;
+    }
+
+    const RpcMetricsSnapshot now   = m_metrics.snapshot();
+    const ConnectionStats    stats = connectionStats();
+
+    QJsonObject conn;
+    conn[QStringLiteral("connected")]       = isConnected();
+    conn[QStringLiteral("drops")]           = double(stats.drops);
+    conn[QStringLiteral("reconnects")]      = double(stats.reconnects);
+    conn[QStringLiteral("resubscribes")]    = double(stats.resubscribes);
+    conn[QStringLiteral("lastReconnectMs")] = double(stats.lastReconnectMs);
+    conn[QStringLiteral("maxReconnectMs")]  = double(stats.maxReconnectMs);
+
+    QJsonObject line = now.toJson(&m_lastMetricsDump);
+    line[QStringLiteral("time")]       = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    line[QStringLiteral("connection")] = conn;
+    file.write(QJsonDocument(line).toJson(QJsonDocument::Compact));
+    file.write("\n");
+
+    m_lastMetricsDump = now;
+}
+
+// ---------------------------------------------------------------------------
+// Internal: automatic resubscription.
+//
+// A subscription that ends with an error other than CANCELLED (gateway
+// restart, keepalive timeout, ...) is reopened after 250 ms, doubling up to
+// 10 s while it keeps failing; the first message on a stream resets the
+// backoff.  While the channel is down the retry waits for READY instead.
+// ---------------------------------------------------------------------------
+GatewayClient::StreamWant& GatewayClient::want(Stream stream)
+{
+    return stream == Stream::SystemState ? m_sysStateWant : m_eventsWant;
+}
+
+void GatewayClient::scheduleResubscribe(Stream stream, uint64_t generation)
+{
+    int delayMs = 0;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        StreamWant& w = want(stream);
+        if (w.generation != generation) { return; }   // already reopened
+        w.running = false;
+        if (!w.active) { return; }
+        delayMs = std::min(kResubscribeMaxMs,
+                           kResubscribeBaseMs << std::min(w.failures, 6));
+        ++w.failures;
+    }
+    QTimer::singleShot(delayMs, this, [this, stream]() { resubscribe(stream); });
+}
+
+void GatewayClient::resubscribe(Stream stream)
 {
-    m_stopMonitor.store(true);
-    if (m_connMonitorThread.joinable()) {
-        m_connMonitorThread.join();
+    if (!m_connected.load(std::memory_order_relaxed)) {
+        return;   // retried from the READY transition
+    }
+    QString taskId;
+    hmi::InspectionEventFilter filter;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        const StreamWant& w = want(stream);
+        if (!w.active || w.running) { return; }
+        taskId = w.taskId;
+        filter = m_eventsFilter;
+        ++m_connStats.resubscribes;
+    }
+    if (stream == Stream::SystemState) {
+        subscribeSystemState(taskId);
+    } else {
+        subscribeInspectionEvents(taskId, filter);
     }
 }
 
 // ===========================================================================
-// Helpers: spawn a one-shot worker thread and track it.
+// Helpers: spawn an upload worker thread and track it.
 // ===========================================================================
 namespace {
 
@@ -730,13 +1296,12 @@ void reapFinishedWorkers(std::vector<std::thread>& workers)
 // RPC – UploadCad (client-streaming)
 // ===========================================================================
 
-void GatewayClient::uploadCad(const QString& filePath)
+void GatewayClient::uploadCad(const QString& filePath,
+                              const hmi::CadUploadOptions& options)
 {
-    std::shared_ptr<grpc::Channel> ch;
     proto::InspectionGateway::Stub* stub = nullptr;
     {
         std::lock_guard<std::mutex> lk(m_mutex);
-        ch   = m_channel;
         stub = m_stub.get();
     }
     if (!stub) {
@@ -749,88 +1314,52 @@ void GatewayClient::uploadCad(const QString& filePath)
         return;
     }
 
-    // Capture what we need for the thread by value.
-    QString path = filePath;
-
-    std::thread worker([this, path, stub]() {
-        // Build upload session id.
-        const std::string uploadId =
-            QUuid::createUuid().toString(QUuid::WithoutBraces).toStdString();
-        const std::string filename =
-            QFileInfo(path).fileName().toStdString();
-
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(300)); // 5-minute max upload
-
-        proto::UploadCadResponse response;
-        auto writer = stub->UploadCad(&ctx, &response);
-
-        // Open the file.
-        QFile file(path);
-        if (!file.open(QIODevice::ReadOnly)) {
-            hmi::Result r;
-            r.code    = hmi::ErrorCode::InvalidArgument;
-            r.message = QStringLiteral("Cannot open file: ") + path;
-            QMetaObject::invokeMethod(this, [this, r]() {
-                emit uploadCadFinished(r, {});
-            }, Qt::QueuedConnection);
-            return;
-        }
+    // Registered before the thread starts so that a disconnect racing with
+    // this call still cancels it.
+    auto session = std::make_shared<CadUploadSession>(stub, filePath, options, &m_metrics);
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_uploads.push_back(session);
+    }
 
-        constexpr qint64 CHUNK_SIZE = 64 * 1024; // 64 KB
-        const qint64 totalBytes = file.size();
-        qint64 bytesSent = 0;
-        uint32_t chunkIndex = 0;
+    std::thread worker([this, session]() {
+        const auto started = RpcMetrics::Clock::now();
         int lastPercent = -1;
-
-        while (!file.atEnd()) {
-            QByteArray buf = file.read(CHUNK_SIZE);
-            if (buf.isEmpty()) { break; }
-
-            proto::UploadCadChunk chunk;
-            chunk.set_upload_id(uploadId);
-            chunk.set_filename(filename);
-            chunk.set_data(buf.constData(), static_cast<std::size_t>(buf.size()));
-            chunk.set_chunk_index(chunkIndex++);
-
-            bytesSent += buf.size();
-            const bool isLast = file.atEnd();
-            chunk.set_eof(isLast);
-
-            if (!writer->Write(chunk)) {
-                // Stream broken.
-                hmi::Result r;
-                r.code    = hmi::ErrorCode::Internal;
-                r.message = QStringLiteral("Stream write failed at chunk %1").arg(chunkIndex - 1);
-                QMetaObject::invokeMethod(this, [this, r]() {
-                    emit uploadCadFinished(r, {});
+        const CadUploadSession::Outcome out = session->run(
+            [this, &lastPercent](qint64 done, qint64 total) {
+                const int pct = total > 0 ? static_cast<int>((done * 100) / total) : 100;
+                if (pct == lastPercent) { return; }
+                lastPercent = pct;
+                QMetaObject::invokeMethod(this, [this, pct]() {
+                    emit uploadCadProgress(pct);
                 }, Qt::QueuedConnection);
-                return;
-            }
+            });
 
-            // Progress notification.
-            if (totalBytes > 0) {
-                int pct = static_cast<int>((bytesSent * 100) / totalBytes);
-                if (pct != lastPercent) {
-                    lastPercent = pct;
-                    QMetaObject::invokeMethod(this, [this, pct]() {
-                        emit uploadCadProgress(pct);
-                    }, Qt::QueuedConnection);
-                }
-            }
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_uploads.erase(std::remove(m_uploads.begin(), m_uploads.end(), session),
+                            m_uploads.end());
         }
-
-        writer->WritesDone();
-        Status st = writer->Finish();
+        // Chunk bytes were counted per message.
+        m_metrics.recordCall(RpcMethod::UploadCad, RpcMetrics::Clock::now() - started,
+                             out.error.ok() && out.status.ok(), 0, 0,
+                             isLinkFailure(out.status));
 
         hmi::Result r;
-        QString modelId;
-        if (st.ok()) {
-            r       = fromProtoResult(response.result());
-            modelId = QString::fromStdString(response.model_id());
+        if (!out.error.ok()) {
+            r = out.error;
+        } else if (!out.status.ok()) {
+            r = fromGrpcStatus(out.status);
+            if (out.attempts > 1) {
+                r.message += QStringLiteral(" (after %1 attempts)").arg(out.attempts);
+            }
         } else {
-            r = fromGrpcStatus(st);
+            r = fromProtoResult(out.gatewayResult);
+            if (out.skipped) {
+                r.message = QStringLiteral("Already on gateway");
+            }
         }
+        const QString modelId = QString::fromStdString(out.modelId);
 
         QMetaObject::invokeMethod(this, [this, r, modelId]() {
             emit uploadCadFinished(r, modelId);
@@ -844,6 +1373,14 @@ void GatewayClient::uploadCad(const QString& filePath)
     }
 }
 
+void GatewayClient::cancelCadUploads()
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (const auto& session : m_uploads) {
+        session->cancel();
+    }
+}
+
 // ===========================================================================
 // RPC – SetInspectionTargets (unary)
 // ===========================================================================
@@ -854,165 +1391,454 @@ void GatewayClient::setInspectionTargets(
     const hmi::CaptureConfig& config,
     const QString& operatorId)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-    }
-    if (!stub) {
+    TargetSnapshot next = TargetSync::snapshot(targets, config);
+    sendAllTargets(TargetUpload{ modelId, targets, config, operatorId },
+                   std::move(next), /*tracked=*/false);
+}
+
+void GatewayClient::sendAllTargets(TargetUpload upload, TargetSnapshot next, bool tracked)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
         hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
-        QMetaObject::invokeMethod(this, [this, r]() {
+        const QString modelId = upload.modelId;
+        QMetaObject::invokeMethod(this, [this, r, modelId, tracked]() {
             emit setTargetsFinished(r, 0);
+            if (tracked) finishTargetSync(modelId);
         }, Qt::QueuedConnection);
         return;
     }
 
-    std::thread worker([this, stub, modelId, targets, config, operatorId]() {
-        proto::SetInspectionTargetsRequest req;
-        req.set_model_id(modelId.toStdString());
-        req.set_operator_id(operatorId.toStdString());
-        *req.mutable_capture() = toProtoCaptureConfig(config);
-        for (const auto& t : targets) {
-            *req.add_targets() = toProtoTarget(t);
-        }
-
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(60));
+    proto::SetInspectionTargetsRequest req;
+    req.set_model_id(upload.modelId.toStdString());
+    req.set_operator_id(upload.operatorId.toStdString());
+    *req.mutable_capture() = toProtoCaptureConfig(upload.config);
+    req.mutable_targets()->Reserve(upload.targets.size());
+    for (const auto& t : upload.targets) {
+        *req.add_targets() = toProtoTarget(t);
+    }
+
+    auto* stub = m_stub.get();
+    const QString modelId = upload.modelId;
+    startTimedUnary<proto::SetInspectionTargetsResponse>(
+        RpcMethod::SetInspectionTargets, req, deadlineFromNow(60),
+        [stub](ClientContext* ctx, const proto::SetInspectionTargetsRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncSetInspectionTargets(ctx, rq, cq);
+        },
+        [this, modelId, tracked, next = std::move(next)](
+            const Status& st, proto::SetInspectionTargetsResponse& resp) mutable {
+            hmi::Result r;
+            uint32_t total = 0;
+            if (st.ok()) {
+                r     = fromProtoResult(resp.result());
+                total = resp.total_targets();
+            } else {
+                r = fromGrpcStatus(st);
+            }
 
-        proto::SetInspectionTargetsResponse resp;
-        Status st = stub->SetInspectionTargets(&ctx, req, &resp);
+            {
+                // A failed replace leaves the gateway's set unknown.
+                std::lock_guard<std::mutex> lk(m_mutex);
+                TargetSyncEntry& entry = m_targetSync[modelId];
+                if (r.ok()) {
+#ifdef HMI_PROTO_EXTENSIONS
+                    next.revision = resp.revision();
+#endif
+                    entry.acked = std::move(next);
+                } else {
+                    entry.acked.reset();
+                }
+            }
 
-        hmi::Result r;
-        uint32_t total = 0;
-        if (st.ok()) {
-            r     = fromProtoResult(resp.result());
-            total = resp.total_targets();
-        } else {
-            r = fromGrpcStatus(st);
-        }
+            QMetaObject::invokeMethod(this, [this, r, total, modelId, tracked]() {
+                emit setTargetsFinished(r, total);
+                if (tracked) finishTargetSync(modelId);
+            }, Qt::QueuedConnection);
+        });
+}
 
-        QMetaObject::invokeMethod(this, [this, r, total]() {
-            emit setTargetsFinished(r, total);
-        }, Qt::QueuedConnection);
-    });
+// ---------------------------------------------------------------------------
+// Incremental uploads
+// ---------------------------------------------------------------------------
 
+void GatewayClient::syncInspectionTargets(
+    const QString& modelId,
+    const QVector<hmi::InspectionTarget>& targets,
+    const hmi::CaptureConfig& config,
+    const QString& operatorId)
+{
+    TargetUpload upload{ modelId, targets, config, operatorId };
     {
         std::lock_guard<std::mutex> lk(m_mutex);
-        reapFinishedWorkers(m_workers);
-        m_workers.push_back(std::move(worker));
-    }
+        TargetSyncEntry& entry = m_targetSync[modelId];
+        if (entry.inFlight) {
+            entry.queued = std::move(upload);   // latest wins
+            return;
+        }
+        entry.inFlight = true;
+    }
+    startTargetSync(std::move(upload));
 }
 
-// ===========================================================================
-// RPC – PlanInspection (unary)
-// ===========================================================================
+void GatewayClient::resetTargetSync()
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (auto it = m_targetSync.begin(); it != m_targetSync.end(); ++it) {
+        it->acked.reset();
+    }
+}
 
-void GatewayClient::planInspection(const QString& modelId,
-                                   const QString& taskName,
-                                   const hmi::PlanOptions& options)
+void GatewayClient::startTargetSync(TargetUpload upload)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
+    TargetSnapshot next = TargetSync::snapshot(upload.targets, upload.config);
+
+    std::optional<TargetSnapshot> acked;
     {
         std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
+        auto it = m_targetSync.constFind(upload.modelId);
+        if (it != m_targetSync.constEnd()) acked = it->acked;
     }
-    if (!stub) {
-        hmi::PlanResponse resp;
-        resp.result = { hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
-        QMetaObject::invokeMethod(this, [this, resp]() {
-            emit planInspectionFinished(resp);
+    if (!acked) {
+        sendAllTargets(std::move(upload), std::move(next), /*tracked=*/true);
+        return;
+    }
+
+    const TargetDelta delta = TargetSync::diff(*acked, next, upload.targets);
+    if (delta.isEmpty()) {
+        // The gateway already holds exactly this set.
+        hmi::Result r{ hmi::ErrorCode::Ok, {} };
+        const auto total = static_cast<uint32_t>(upload.targets.size());
+        const QString modelId = upload.modelId;
+        QMetaObject::invokeMethod(this, [this, r, total, modelId]() {
+            emit setTargetsFinished(r, total);
+            finishTargetSync(modelId);
         }, Qt::QueuedConnection);
         return;
     }
 
-    std::thread worker([this, stub, modelId, taskName, options]() {
-        proto::PlanInspectionRequest req;
-        req.set_model_id(modelId.toStdString());
-        req.set_task_name(taskName.toStdString());
-        *req.mutable_options() = toProtoPlanOptions(options);
+#ifdef HMI_PROTO_EXTENSIONS
+    if (acked->revision != 0 && !m_deltaUnsupported.load(std::memory_order_relaxed)) {
+        sendTargetDelta(std::move(upload), std::move(next), acked->revision, delta);
+        return;
+    }
+#endif
+    sendAllTargets(std::move(upload), std::move(next), /*tracked=*/true);
+}
 
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(120)); // planning can take a while
+#ifdef HMI_PROTO_EXTENSIONS
+void GatewayClient::sendTargetDelta(TargetUpload upload, TargetSnapshot next,
+                                    uint64_t baseRevision, const TargetDelta& delta)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
+        hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
+        const QString modelId = upload.modelId;
+        QMetaObject::invokeMethod(this, [this, r, modelId]() {
+            emit setTargetsFinished(r, 0);
+            finishTargetSync(modelId);
+        }, Qt::QueuedConnection);
+        return;
+    }
 
-        proto::PlanInspectionResponse resp;
-        Status st = stub->PlanInspection(&ctx, req, &resp);
+    proto::UpdateInspectionTargetsRequest req;
+    req.set_model_id(upload.modelId.toStdString());
+    req.set_operator_id(upload.operatorId.toStdString());
+    req.set_base_revision(baseRevision);
+    req.mutable_upserts()->Reserve(delta.upserts.size());
+    for (const auto& t : delta.upserts) {
+        *req.add_upserts() = toProtoTarget(t);
+    }
+    req.mutable_removed_point_ids()->Reserve(delta.removed.size());
+    for (int32_t id : delta.removed) {
+        req.add_removed_point_ids(id);
+    }
+    if (delta.configChanged) {
+        *req.mutable_capture() = toProtoCaptureConfig(upload.config);
+    }
+
+    auto* stub = m_stub.get();
+    startTimedUnary<proto::UpdateInspectionTargetsResponse>(
+        RpcMethod::UpdateInspectionTargets, req, deadlineFromNow(60),
+        [stub](ClientContext* ctx, const proto::UpdateInspectionTargetsRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncUpdateInspectionTargets(ctx, rq, cq);
+        },
+        [this, upload = std::move(upload), next = std::move(next)](
+            const Status& st, proto::UpdateInspectionTargetsResponse& resp) mutable {
+            const bool unimplemented = st.error_code() == grpc::StatusCode::UNIMPLEMENTED;
+            hmi::Result r = st.ok() ? fromProtoResult(resp.result()) : fromGrpcStatus(st);
+
+            // Older gateway, or our base revision is stale: replace the
+            // whole set instead (from the main thread, so a disconnect that
+            // is waiting for this callback is not handed a new call).
+            if (unimplemented || r.code == hmi::ErrorCode::Conflict) {
+                if (unimplemented) m_deltaUnsupported.store(true, std::memory_order_relaxed);
+                QMetaObject::invokeMethod(this, [this, upload, next]() mutable {
+                    sendAllTargets(std::move(upload), std::move(next), /*tracked=*/true);
+                }, Qt::QueuedConnection);
+                return;
+            }
 
-        hmi::PlanResponse out;
-        if (st.ok()) {
-            out.result = fromProtoResult(resp.result());
-            out.planId = QString::fromStdString(resp.plan_id());
-            if (resp.has_path())  { out.path  = fromProtoInspectionPath(resp.path()); }
-            if (resp.has_stats()) { out.stats = fromProtoPlanningStats(resp.stats()); }
-        } else {
-            out.result = fromGrpcStatus(st);
-        }
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                TargetSyncEntry& entry = m_targetSync[upload.modelId];
+                if (r.ok()) {
+                    next.revision = resp.revision();
+                    entry.acked = std::move(next);
+                } else {
+                    entry.acked.reset();
+                }
+            }
 
-        QMetaObject::invokeMethod(this, [this, out]() {
-            emit planInspectionFinished(out);
-        }, Qt::QueuedConnection);
-    });
+            const uint32_t total   = st.ok() ? resp.total_targets() : 0;
+            const QString  modelId = upload.modelId;
+            QMetaObject::invokeMethod(this, [this, r, total, modelId]() {
+                emit setTargetsFinished(r, total);
+                finishTargetSync(modelId);
+            }, Qt::QueuedConnection);
+        });
+}
+#endif // HMI_PROTO_EXTENSIONS
 
+void GatewayClient::finishTargetSync(const QString& modelId)
+{
+    std::optional<TargetUpload> queued;
     {
         std::lock_guard<std::mutex> lk(m_mutex);
-        reapFinishedWorkers(m_workers);
-        m_workers.push_back(std::move(worker));
+        auto it = m_targetSync.find(modelId);
+        if (it == m_targetSync.end()) return;
+        queued = std::move(it->queued);
+        it->queued.reset();
+        it->inFlight = queued.has_value();
+    }
+    if (queued) {
+        startTargetSync(std::move(*queued));
     }
 }
 
+// ===========================================================================
+// RPC – PlanInspection (unary)
+// ===========================================================================
+
+void GatewayClient::planInspection(const QString& modelId,
+                                   const QString& taskName,
+                                   const hmi::PlanOptions& options)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
+        hmi::PlanResponse resp;
+        resp.result = { hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
+        QMetaObject::invokeMethod(this, [this, snap = hmi::PlanResponseSnapshot(resp)]() {
+            emit planInspectionFinished(snap);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    // The response carries the whole InspectionPath: build request and
+    // response on a pooled arena instead of one heap block per waypoint.
+    RpcEngine::ArenaPool::Lease arena = m_engine->arenas().acquire();
+    auto* req = google::protobuf::Arena::CreateMessage<proto::PlanInspectionRequest>(arena.get());
+    req->set_model_id(modelId.toStdString());
+    req->set_task_name(taskName.toStdString());
+    *req->mutable_options() = toProtoPlanOptions(options);
+
+    auto* stub = m_stub.get();
+    hmi::GetPlanResponse request;   // what the plan cache keeps besides the response
+    request.modelId  = modelId;
+    request.taskName = taskName;
+    request.options  = options;
+    startTimedUnary<proto::PlanInspectionResponse>(
+        RpcMethod::PlanInspection, *req, deadlineFromNow(120), // planning can take a while
+        [stub](ClientContext* ctx, const proto::PlanInspectionRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncPlanInspection(ctx, rq, cq);
+        },
+        [this, request = std::move(request)](const Status& st,
+                                             proto::PlanInspectionResponse& resp) {
+            hmi::PlanResponse out;
+            uint64_t revision = 0;
+            if (st.ok()) {
+                ScopedConversionTimer conv(m_metrics, RpcMethod::PlanInspection);
+                out.result = fromProtoResult(resp.result());
+                out.planId = QString::fromStdString(resp.plan_id());
+                if (resp.has_path())  { out.path  = fromProtoInspectionPath(resp.path()); }
+                if (resp.has_stats()) { out.stats = fromProtoPlanningStats(resp.stats()); }
+#ifdef HMI_PROTO_EXTENSIONS
+                revision = resp.revision();
+#endif
+            } else {
+                out.result = fromGrpcStatus(st);
+            }
+
+            // Shared from here on: the path is never copied again on its way
+            // to the receivers.
+            hmi::PlanResponseSnapshot snap(std::move(out));
+            if (snap->result.ok() && !snap->planId.isEmpty()) {
+                if (std::shared_ptr<PlanCache> cache = planCache()) {
+                    hmi::GetPlanResponse plan = request;
+                    plan.result    = snap->result;
+                    plan.planId    = snap->planId;
+                    plan.path      = snap->path;   // implicitly shared waypoints
+                    plan.stats     = snap->stats;
+                    plan.createdAt = QDateTime::currentDateTimeUtc();
+                    storePlan(std::move(cache), hmi::GetPlanResponseSnapshot(std::move(plan)),
+                              revision);
+                }
+            }
+            QMetaObject::invokeMethod(this, [this, snap = std::move(snap)]() {
+                emit planInspectionFinished(snap);
+            }, Qt::QueuedConnection);
+        },
+        std::move(arena));
+}
+
 // ===========================================================================
 // RPC – GetPlan (unary)
 // ===========================================================================
 
-void GatewayClient::getPlan(const QString& planId)
+void GatewayClient::getPlan(const QString& planId, hmi::PlanFetchPolicy policy)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
+    const uint64_t generation = m_connectionGeneration.load(std::memory_order_acquire);
+    std::shared_ptr<PlanCache> cache = planCache();
+    if (!cache || policy == hmi::PlanFetchPolicy::Refresh) {
+        fetchPlan(planId, 0, generation);
+        return;
     }
-    if (!stub) {
+
+#ifdef HMI_PROTO_EXTENSIONS
+    // Revalidate: the gateway answers not_modified when the cached revision
+    // is current, and the waypoints are read from disk instead.
+    m_planCachePool.start([this, cache = std::move(cache), planId, generation]() {
+        fetchPlan(planId, cache->revision(planId), generation);
+    });
+#else
+    // Without revisions a plan never changes under its ID.
+    servePlanFromCache(std::move(cache), planId, generation);
+#endif
+}
+
+void GatewayClient::fetchPlan(const QString& planId, uint64_t knownRevision,
+                              uint64_t generation)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub || generation != m_connectionGeneration.load(std::memory_order_acquire)) {
+        hmi::Result unavailable{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
+        if (std::shared_ptr<PlanCache> cache = knownRevision != 0 ? planCache() : nullptr) {
+            servePlanFromCache(std::move(cache), planId, generation, unavailable);
+            return;
+        }
         hmi::GetPlanResponse r;
-        r.result = { hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
-        QMetaObject::invokeMethod(this, [this, r]() {
-            emit getPlanFinished(r);
-        }, Qt::QueuedConnection);
+        r.result = std::move(unavailable);
+        emitGetPlanFinished(std::move(r));
         return;
     }
 
-    std::thread worker([this, stub, planId]() {
-        proto::GetPlanRequest req;
-        req.set_plan_id(planId.toStdString());
+    RpcEngine::ArenaPool::Lease arena = m_engine->arenas().acquire();   // see planInspection()
+    auto* req = google::protobuf::Arena::CreateMessage<proto::GetPlanRequest>(arena.get());
+    req->set_plan_id(planId.toStdString());
+#ifdef HMI_PROTO_EXTENSIONS
+    req->set_known_revision(knownRevision);
+#endif
+
+    auto* stub = m_stub.get();
+    startTimedUnary<proto::GetPlanResponse>(
+        RpcMethod::GetPlan, *req, deadlineFromNow(30),
+        [stub](ClientContext* ctx, const proto::GetPlanRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncGetPlan(ctx, rq, cq);
+        },
+        [this, planId, knownRevision, generation](const Status& st, proto::GetPlanResponse& resp) {
+            std::shared_ptr<PlanCache> cache = planCache();
+            if (!st.ok() && knownRevision != 0 && cache) {
+                // Revalidation failed: the cached copy beats no plan at all.
+                servePlanFromCache(std::move(cache), planId, generation, fromGrpcStatus(st));
+                return;
+            }
+#ifdef HMI_PROTO_EXTENSIONS
+            if (st.ok() && resp.not_modified() && cache) {
+                servePlanFromCache(std::move(cache), planId, generation);
+                return;
+            }
+#endif
+
+            hmi::GetPlanResponse out;
+            uint64_t revision = 0;
+            if (st.ok()) {
+                ScopedConversionTimer conv(m_metrics, RpcMethod::GetPlan);
+                out.result    = fromProtoResult(resp.result());
+                out.planId    = QString::fromStdString(resp.plan_id());
+                out.modelId   = QString::fromStdString(resp.model_id());
+                out.taskName  = QString::fromStdString(resp.task_name());
+                if (resp.has_options())  { out.options = fromProtoPlanOptions(resp.options()); }
+                if (resp.has_path())     { out.path    = fromProtoInspectionPath(resp.path()); }
+                if (resp.has_stats())    { out.stats   = fromProtoPlanningStats(resp.stats()); }
+                if (resp.has_created_at()){ out.createdAt = fromTimestamp(resp.created_at()); }
+#ifdef HMI_PROTO_EXTENSIONS
+                revision = resp.revision();
+                out.revision = revision;
+#endif
+            } else {
+                out.result = fromGrpcStatus(st);
+            }
+
+            hmi::GetPlanResponseSnapshot snap(std::move(out));
+            if (cache && snap->result.ok() && !snap->planId.isEmpty()) {
+                storePlan(std::move(cache), snap, revision);
+            }
+            QMetaObject::invokeMethod(this, [this, snap = std::move(snap)]() {
+                emit getPlanFinished(snap);
+            }, Qt::QueuedConnection);
+        },
+        std::move(arena));
+}
 
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(30));
+void GatewayClient::emitGetPlanFinished(hmi::GetPlanResponse response)
+{
+    QMetaObject::invokeMethod(this, [this, snap = hmi::GetPlanResponseSnapshot(std::move(response))]() {
+        emit getPlanFinished(snap);
+    }, Qt::QueuedConnection);
+}
 
-        proto::GetPlanResponse resp;
-        Status st = stub->GetPlan(&ctx, req, &resp);
+// ===========================================================================
+// Plan cache
+// ===========================================================================
 
-        hmi::GetPlanResponse out;
-        if (st.ok()) {
-            out.result    = fromProtoResult(resp.result());
-            out.planId    = QString::fromStdString(resp.plan_id());
-            out.modelId   = QString::fromStdString(resp.model_id());
-            out.taskName  = QString::fromStdString(resp.task_name());
-            if (resp.has_options())  { out.options = fromProtoPlanOptions(resp.options()); }
-            if (resp.has_path())     { out.path    = fromProtoInspectionPath(resp.path()); }
-            if (resp.has_stats())    { out.stats   = fromProtoPlanningStats(resp.stats()); }
-            if (resp.has_created_at()){ out.createdAt = fromTimestamp(resp.created_at()); }
+void GatewayClient::setPlanCache(std::shared_ptr<PlanCache> cache)
+{
+    std::atomic_store(&m_planCache, std::move(cache));
+}
+
+std::shared_ptr<PlanCache> GatewayClient::planCache() const
+{
+    return std::atomic_load(&m_planCache);
+}
+
+void GatewayClient::servePlanFromCache(std::shared_ptr<PlanCache> cache, const QString& planId,
+                                       uint64_t generation, std::optional<hmi::Result> failure)
+{
+    m_planCachePool.start([this, cache = std::move(cache), planId, generation, failure]() {
+        if (std::optional<hmi::GetPlanResponse> plan = cache->load(planId)) {
+            plan->fromCache = true;
+            emitGetPlanFinished(std::move(*plan));
+        } else if (failure) {
+            hmi::GetPlanResponse r;
+            r.result = *failure;
+            emitGetPlanFinished(std::move(r));
         } else {
-            out.result = fromGrpcStatus(st);
+            fetchPlan(planId, 0, generation);   // evicted or never stored
         }
-
-        QMetaObject::invokeMethod(this, [this, out]() {
-            emit getPlanFinished(out);
-        }, Qt::QueuedConnection);
     });
+}
 
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        reapFinishedWorkers(m_workers);
-        m_workers.push_back(std::move(worker));
-    }
+void GatewayClient::storePlan(std::shared_ptr<PlanCache> cache,
+                              hmi::GetPlanResponseSnapshot plan, uint64_t revision)
+{
+    m_planCachePool.start([cache = std::move(cache), plan = std::move(plan), revision]() {
+        if (!cache->store(*plan, revision)) {
+            qWarning() << "PlanCache: failed to store plan" << plan->planId;
+        }
+    });
 }
 
 // ===========================================================================
@@ -1021,12 +1847,8 @@ void GatewayClient::getPlan(const QString& planId)
 
 void GatewayClient::startInspection(const QString& planId, bool dryRun)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-    }
-    if (!stub) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
         hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
         QMetaObject::invokeMethod(this, [this, r]() {
             emit startInspectionFinished(r, {});
@@ -1034,36 +1856,31 @@ void GatewayClient::startInspection(const QString& planId, bool dryRun)
         return;
     }
 
-    std::thread worker([this, stub, planId, dryRun]() {
-        proto::StartInspectionRequest req;
-        req.set_plan_id(planId.toStdString());
-        req.set_dry_run(dryRun);
-
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(30));
-
-        proto::StartInspectionResponse resp;
-        Status st = stub->StartInspection(&ctx, req, &resp);
+    proto::StartInspectionRequest req;
+    req.set_plan_id(planId.toStdString());
+    req.set_dry_run(dryRun);
 
-        hmi::Result r;
-        QString taskId;
-        if (st.ok()) {
-            r      = fromProtoResult(resp.result());
-            taskId = QString::fromStdString(resp.task_id());
-        } else {
-            r = fromGrpcStatus(st);
-        }
-
-        QMetaObject::invokeMethod(this, [this, r, taskId]() {
-            emit startInspectionFinished(r, taskId);
-        }, Qt::QueuedConnection);
-    });
+    auto* stub = m_stub.get();
+    startTimedUnary<proto::StartInspectionResponse>(
+        RpcMethod::StartInspection, req, deadlineFromNow(30),
+        [stub](ClientContext* ctx, const proto::StartInspectionRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncStartInspection(ctx, rq, cq);
+        },
+        [this](const Status& st, proto::StartInspectionResponse& resp) {
+            hmi::Result r;
+            QString taskId;
+            if (st.ok()) {
+                r      = fromProtoResult(resp.result());
+                taskId = QString::fromStdString(resp.task_id());
+            } else {
+                r = fromGrpcStatus(st);
+            }
 
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        reapFinishedWorkers(m_workers);
-        m_workers.push_back(std::move(worker));
-    }
+            QMetaObject::invokeMethod(this, [this, r, taskId]() {
+                emit startInspectionFinished(r, taskId);
+            }, Qt::QueuedConnection);
+        });
 }
 
 // ===========================================================================
@@ -1071,109 +1888,64 @@ void GatewayClient::startInspection(const QString& planId, bool dryRun)
 // ===========================================================================
 
 // Internal helper to reduce code duplication for the three control RPCs.
-namespace {
-
-using ControlRpcFn = std::function<Status(ClientContext*,
-                                          const proto::ControlTaskRequest&,
-                                          proto::ControlTaskResponse*)>;
-
-void runControlRpc(GatewayClient* self,
-                   proto::InspectionGateway::Stub* stub,
-                   const QString& taskId,
-                   const QString& reason,
-                   ControlRpcFn fn)
+// \a prepare selects the stub's PrepareAsync<Method> member.
+void GatewayClient::startControlRpc(const QString& taskId,
+                                    const QString& reason,
+                                    ControlPrepareFn prepare,
+                                    RpcMethod method)
 {
-    std::thread worker([self, stub, taskId, reason, fn = std::move(fn)]() {
-        proto::ControlTaskRequest req;
-        req.set_task_id(taskId.toStdString());
-        req.set_reason(reason.toStdString());
-
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(30));
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
+        hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
+        QMetaObject::invokeMethod(this, [this, r]() { emit controlTaskFinished(r); },
+                                  Qt::QueuedConnection);
+        return;
+    }
 
-        proto::ControlTaskResponse resp;
-        Status st = fn(&ctx, req, &resp);
+    proto::ControlTaskRequest req;
+    req.set_task_id(taskId.toStdString());
+    req.set_reason(reason.toStdString());
 
-        hmi::Result r;
-        if (st.ok()) {
-            r = fromProtoResult(resp.result());
-        } else {
-            r = fromGrpcStatus(st);
-        }
-
-        QMetaObject::invokeMethod(self, [self, r]() {
-            emit self->controlTaskFinished(r);
-        }, Qt::QueuedConnection);
-    });
+    auto* stub = m_stub.get();
+    startTimedUnary<proto::ControlTaskResponse>(
+        method, req, deadlineFromNow(30),
+        [stub, prepare](ClientContext* ctx, const proto::ControlTaskRequest& rq,
+                        grpc::CompletionQueue* cq) {
+            return (stub->*prepare)(ctx, rq, cq);
+        },
+        [this](const Status& st, proto::ControlTaskResponse& resp) {
+            hmi::Result r;
+            if (st.ok()) {
+                r = fromProtoResult(resp.result());
+            } else {
+                r = fromGrpcStatus(st);
+            }
 
-    // Note: we cannot access m_workers here (different translation unit scope
-    // for the anonymous namespace).  Detach; the task is short-lived.
-    worker.detach();
+            QMetaObject::invokeMethod(this, [this, r]() {
+                emit controlTaskFinished(r);
+            }, Qt::QueuedConnection);
+        });
 }
 
-} // anonymous namespace
-
 void GatewayClient::pauseInspection(const QString& taskId, const QString& reason)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-    }
-    if (!stub) {
-        hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
-        QMetaObject::invokeMethod(this, [this, r]() { emit controlTaskFinished(r); },
-                                  Qt::QueuedConnection);
-        return;
-    }
-    runControlRpc(this, stub, taskId, reason,
-        [stub](ClientContext* ctx,
-               const proto::ControlTaskRequest& req,
-               proto::ControlTaskResponse* resp) {
-            return stub->PauseInspection(ctx, req, resp);
-        });
+    startControlRpc(taskId, reason,
+                    &proto::InspectionGateway::Stub::PrepareAsyncPauseInspection,
+                    RpcMethod::PauseInspection);
 }
 
 void GatewayClient::resumeInspection(const QString& taskId, const QString& reason)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-    }
-    if (!stub) {
-        hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
-        QMetaObject::invokeMethod(this, [this, r]() { emit controlTaskFinished(r); },
-                                  Qt::QueuedConnection);
-        return;
-    }
-    runControlRpc(this, stub, taskId, reason,
-        [stub](ClientContext* ctx,
-               const proto::ControlTaskRequest& req,
-               proto::ControlTaskResponse* resp) {
-            return stub->ResumeInspection(ctx, req, resp);
-        });
+    startControlRpc(taskId, reason,
+                    &proto::InspectionGateway::Stub::PrepareAsyncResumeInspection,
+                    RpcMethod::ResumeInspection);
 }
 
 void GatewayClient::stopInspection(const QString& taskId, const QString& reason)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-    }
-    if (!stub) {
-        hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
-        QMetaObject::invokeMethod(this, [this, r]() { emit controlTaskFinished(r); },
-                                  Qt::QueuedConnection);
-        return;
-    }
-    runControlRpc(this, stub, taskId, reason,
-        [stub](ClientContext* ctx,
-               const proto::ControlTaskRequest& req,
-               proto::ControlTaskResponse* resp) {
-            return stub->StopInspection(ctx, req, resp);
-        });
+    startControlRpc(taskId, reason,
+                    &proto::InspectionGateway::Stub::PrepareAsyncStopInspection,
+                    RpcMethod::StopInspection);
 }
 
 // ===========================================================================
@@ -1182,47 +1954,42 @@ void GatewayClient::stopInspection(const QString& taskId, const QString& reason)
 
 void GatewayClient::getTaskStatus(const QString& taskId)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-    }
-    if (!stub) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
         QMetaObject::invokeMethod(this, [this]() {
             emit errorOccurred(QStringLiteral("GetTaskStatus: not connected"));
         }, Qt::QueuedConnection);
         return;
     }
 
-    std::thread worker([this, stub, taskId]() {
-        proto::GetTaskStatusRequest req;
-        req.set_task_id(taskId.toStdString());
-
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(15));
-
-        proto::GetTaskStatusResponse resp;
-        Status st = stub->GetTaskStatus(&ctx, req, &resp);
+    proto::GetTaskStatusRequest req;
+    req.set_task_id(taskId.toStdString());
+
+    auto* stub = m_stub.get();
+    startTimedUnary<proto::GetTaskStatusResponse>(
+        RpcMethod::GetTaskStatus, req, deadlineFromNow(15),
+        [stub](ClientContext* ctx, const proto::GetTaskStatusRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncGetTaskStatus(ctx, rq, cq);
+        },
+        [this](const Status& st, proto::GetTaskStatusResponse& resp) {
+            if (!st.ok()) {
+                QString err = QString::fromStdString(st.error_message());
+                QMetaObject::invokeMethod(this, [this, err]() {
+                    emit errorOccurred(QStringLiteral("GetTaskStatus: ") + err);
+                }, Qt::QueuedConnection);
+                return;
+            }
 
-        if (!st.ok()) {
-            QString err = QString::fromStdString(st.error_message());
-            QMetaObject::invokeMethod(this, [this, err]() {
-                emit errorOccurred(QStringLiteral("GetTaskStatus: ") + err);
+            hmi::TaskStatus ts;
+            {
+                ScopedConversionTimer conv(m_metrics, RpcMethod::GetTaskStatus);
+                ts = fromProtoTaskStatus(resp.status());
+            }
+            QMetaObject::invokeMethod(this, [this, snap = hmi::TaskStatusSnapshot(std::move(ts))]() {
+                emit taskStatusReceived(snap);
             }, Qt::QueuedConnection);
-            return;
-        }
-
-        hmi::TaskStatus ts = fromProtoTaskStatus(resp.status());
-        QMetaObject::invokeMethod(this, [this, ts]() {
-            emit taskStatusReceived(ts);
-        }, Qt::QueuedConnection);
-    });
-
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        reapFinishedWorkers(m_workers);
-        m_workers.push_back(std::move(worker));
-    }
+        });
 }
 
 // ===========================================================================
@@ -1231,126 +1998,145 @@ void GatewayClient::getTaskStatus(const QString& taskId)
 
 void GatewayClient::subscribeSystemState(const QString& taskId)
 {
-    // Cancel any existing subscription.
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        if (m_sysStateCtx) {
-            m_sysStateCtx->TryCancel();
-        }
-    }
-    if (m_sysStateThread.joinable()) {
-        m_sysStateThread.join();
-    }
+    // Cancel any existing subscription and wait for its last callback.
+    m_sysStateCalls->cancelAndWait();
 
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-        m_sysStateCtx = std::make_unique<ClientContext>();
-    }
-    if (!stub) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
         QMetaObject::invokeMethod(this, [this]() {
             emit errorOccurred(QStringLiteral("SubscribeSystemState: not connected"));
         }, Qt::QueuedConnection);
         return;
     }
+    m_sysStateWant.active  = true;
+    m_sysStateWant.running = true;
+    m_sysStateWant.taskId  = taskId;
+    const uint64_t generation = ++m_sysStateWant.generation;
+
+    proto::SubscribeRequest req;
+    req.set_task_id(taskId.toStdString());
+    req.set_include_snapshot(true);
+
+    auto* stub = m_stub.get();
+    const auto        opened   = RpcMetrics::Clock::now();
+    const std::size_t reqBytes = req.ByteSizeLong();
+
+    // Callbacks of one stream never overlap, so the per-stream state below
+    // needs no lock even with several poller threads.
+    m_engine->startServerStream<proto::SystemStateEvent>(
+        m_sysStateCalls, req,
+        [stub](ClientContext* c, const proto::SubscribeRequest& rq, grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncSubscribeSystemState(c, rq, cq);
+        },
+        [this, first = true, recordScratch = std::string()]
+        (proto::SystemStateEvent& ev) mutable -> bool {
+            if (first) {
+                first = false;
+                std::lock_guard<std::mutex> guard(m_mutex);
+                m_sysStateWant.failures = 0;   // the stream works again
+            }
+            const auto readAt = RpcMetrics::Clock::now();
+            m_metrics.recordMessage(RpcMethod::SubscribeSystemState, ev.ByteSizeLong());
+            recordTelemetry(TelemetryStream::SystemState, ev, recordScratch);
+            publishSystemState(ev, readAt);
+            return true;
+        },
+        [this, generation, opened, reqBytes](const Status& st) {
+            finishSubscription(Stream::SystemState, generation, st, opened, reqBytes);
+        });
+}
 
-    m_sysStateThread = std::thread([this, stub, taskId]() {
-        proto::SubscribeRequest req;
-        req.set_task_id(taskId.toStdString());
-        req.set_include_snapshot(true);
-
-        ClientContext* ctx = nullptr;
-        {
-            std::lock_guard<std::mutex> lk(m_mutex);
-            ctx = m_sysStateCtx.get();
-        }
-        if (!ctx) { return; }
-
-        auto reader = stub->SubscribeSystemState(ctx, req);
-
-        proto::SystemStateEvent ev;
-        while (reader->Read(&ev)) {
-            hmi::TaskStatus ts = fromProtoTaskStatus(ev.status());
-            QMetaObject::invokeMethod(this, [this, ts]() {
-                emit systemStateReceived(ts);
-            }, Qt::QueuedConnection);
-        }
-
-        // Stream ended (cancelled, server closed, or error).
-        Status st = reader->Finish();
-        if (!st.ok() &&
-            st.error_code() != grpc::StatusCode::CANCELLED)
-        {
-            QString err = QString::fromStdString(st.error_message());
-            QMetaObject::invokeMethod(this, [this, err]() {
-                emit errorOccurred(QStringLiteral("SubscribeSystemState ended: ") + err);
-            }, Qt::QueuedConnection);
+// ---------------------------------------------------------------------------
+// finishSubscription – a stream ended (cancelled, server closed, or error).
+// Runs on a poller thread.
+// ---------------------------------------------------------------------------
+void GatewayClient::finishSubscription(Stream stream, uint64_t generation, const Status& st,
+                                       RpcMetrics::Clock::time_point opened,
+                                       std::size_t requestBytes)
+{
+    const RpcMethod method = stream == Stream::SystemState
+                                 ? RpcMethod::SubscribeSystemState
+                                 : RpcMethod::SubscribeInspectionEvents;
+    m_metrics.recordCall(method, RpcMetrics::Clock::now() - opened,
+                         st.ok() || st.error_code() == grpc::StatusCode::CANCELLED,
+                         requestBytes, 0, isLinkFailure(st));
+    if (!st.ok() && st.error_code() != grpc::StatusCode::CANCELLED) {
+        const QString err = QString::fromStdString(st.error_message());
+        QMetaObject::invokeMethod(this, [this, stream, generation, err]() {
+            emit errorOccurred((stream == Stream::SystemState
+                                    ? QStringLiteral("SubscribeSystemState ended: ")
+                                    : QStringLiteral("SubscribeInspectionEvents ended: ")) + err);
+            scheduleResubscribe(stream, generation);
+        }, Qt::QueuedConnection);
+    } else {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        StreamWant& w = want(stream);
+        if (w.generation == generation) {
+            w.running = false;
         }
-    });
+    }
 }
 
 // ===========================================================================
 // RPC – SubscribeInspectionEvents (server-streaming)
 // ===========================================================================
 
-void GatewayClient::subscribeInspectionEvents(const QString& taskId)
+void GatewayClient::subscribeInspectionEvents(const QString& taskId,
+                                              const hmi::InspectionEventFilter& filter)
 {
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        if (m_eventsCtx) {
-            m_eventsCtx->TryCancel();
-        }
-    }
-    if (m_eventsThread.joinable()) {
-        m_eventsThread.join();
-    }
+    m_eventsCalls->cancelAndWait();
 
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-        m_eventsCtx = std::make_unique<ClientContext>();
-    }
-    if (!stub) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
         QMetaObject::invokeMethod(this, [this]() {
             emit errorOccurred(QStringLiteral("SubscribeInspectionEvents: not connected"));
         }, Qt::QueuedConnection);
         return;
     }
-
-    m_eventsThread = std::thread([this, stub, taskId]() {
-        proto::SubscribeRequest req;
-        req.set_task_id(taskId.toStdString());
-        req.set_include_snapshot(true);
-
-        ClientContext* ctx = nullptr;
-        {
-            std::lock_guard<std::mutex> lk(m_mutex);
-            ctx = m_eventsCtx.get();
-        }
-        if (!ctx) { return; }
-
-        auto reader = stub->SubscribeInspectionEvents(ctx, req);
-
-        proto::InspectionEvent ev;
-        while (reader->Read(&ev)) {
-            hmi::InspectionEvent out = fromProtoInspectionEvent(ev);
-            QMetaObject::invokeMethod(this, [this, out]() {
-                emit inspectionEventReceived(out);
-            }, Qt::QueuedConnection);
-        }
-
-        Status st = reader->Finish();
-        if (!st.ok() &&
-            st.error_code() != grpc::StatusCode::CANCELLED)
-        {
-            QString err = QString::fromStdString(st.error_message());
-            QMetaObject::invokeMethod(this, [this, err]() {
-                emit errorOccurred(QStringLiteral("SubscribeInspectionEvents ended: ") + err);
-            }, Qt::QueuedConnection);
-        }
-    });
+    m_eventsWant.active  = true;
+    m_eventsWant.running = true;
+    m_eventsWant.taskId  = taskId;
+    m_eventsFilter       = filter;
+    const uint64_t generation = ++m_eventsWant.generation;
+
+    proto::SubscribeRequest req;
+    req.set_task_id(taskId.toStdString());
+    req.set_include_snapshot(true);
+#ifdef HMI_PROTO_EXTENSIONS
+    // A gateway without the filter fields ignores them and sends every
+    // event; deliverInspectionEvent() filters again either way.
+    toProtoEventFilter(filter, req);
+#endif
+
+    auto* stub = m_stub.get();
+    const auto        opened   = RpcMetrics::Clock::now();
+    const std::size_t reqBytes = req.ByteSizeLong();
+
+    // The engine parses every event into the same message object, whose
+    // sub-messages and string buffers are kept across Clear(), so a steady
+    // stream allocates next to nothing.  Identifiers are interned through a
+    // pool owned by this stream.
+    m_engine->startServerStream<proto::InspectionEvent>(
+        m_eventsCalls, req,
+        [stub](ClientContext* c, const proto::SubscribeRequest& rq, grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncSubscribeInspectionEvents(c, rq, cq);
+        },
+        [this, filter, pool = std::make_shared<StringPool>(), first = true,
+         recordScratch = std::string()](proto::InspectionEvent& ev) mutable -> bool {
+            if (first) {
+                first = false;
+                std::lock_guard<std::mutex> guard(m_mutex);
+                m_eventsWant.failures = 0;
+            }
+            const auto readAt = RpcMetrics::Clock::now();
+            m_metrics.recordMessage(RpcMethod::SubscribeInspectionEvents, ev.ByteSizeLong());
+            recordTelemetry(TelemetryStream::InspectionEvent, ev, recordScratch);
+            deliverInspectionEvent(ev, filter, *pool, readAt);
+            return true;
+        },
+        [this, generation, opened, reqBytes](const Status& st) {
+            finishSubscription(Stream::Events, generation, st, opened, reqBytes);
+        });
 }
 
 // ===========================================================================
@@ -1359,12 +2145,8 @@ void GatewayClient::subscribeInspectionEvents(const QString& taskId)
 
 void GatewayClient::getNavMap(const QString& mapId)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-    }
-    if (!stub) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
         hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
         hmi::NavMapInfo empty;
         QMetaObject::invokeMethod(this, [this, r, empty]() {
@@ -1373,160 +2155,353 @@ void GatewayClient::getNavMap(const QString& mapId)
         return;
     }
 
-    std::thread worker([this, stub, mapId]() {
-        proto::GetNavMapRequest req;
-        req.set_map_id(mapId.toStdString());
-        req.set_include_image_thumbnail(true);
-
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(30));
-
-        proto::GetNavMapResponse resp;
-        Status st = stub->GetNavMap(&ctx, req, &resp);
+    proto::GetNavMapRequest req;
+    req.set_map_id(mapId.toStdString());
+    req.set_include_image_thumbnail(m_mediaQuality.navMapThumbnail);
+#ifdef HMI_PROTO_EXTENSIONS
+    if (m_mediaQuality.thumbnailMaxPx > 0) {
+        req.set_thumbnail_max_px(static_cast<uint32_t>(m_mediaQuality.thumbnailMaxPx));
+    }
+#endif
 
-        hmi::Result r;
-        hmi::NavMapInfo info;
-        if (st.ok()) {
-            r    = fromProtoResult(resp.result());
-            if (resp.has_map()) {
-                info = fromProtoNavMapInfo(resp.map());
+    auto* stub = m_stub.get();
+    startTimedUnary<proto::GetNavMapResponse>(
+        RpcMethod::GetNavMap, req, deadlineFromNow(30),
+        [stub](ClientContext* ctx, const proto::GetNavMapRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncGetNavMap(ctx, rq, cq);
+        },
+        [this](const Status& st, proto::GetNavMapResponse& resp) {
+            hmi::Result r;
+            hmi::NavMapInfo info;
+            if (st.ok()) {
+                ScopedConversionTimer conv(m_metrics, RpcMethod::GetNavMap);
+                r    = fromProtoResult(resp.result());
+                if (resp.has_map()) {
+                    info = fromProtoNavMapInfo(resp.map());
+                }
+            } else {
+                r = fromGrpcStatus(st);
             }
-        } else {
-            r = fromGrpcStatus(st);
-        }
-
-        QMetaObject::invokeMethod(this, [this, r, info]() {
-            emit navMapReceived(r, info);
-        }, Qt::QueuedConnection);
-    });
 
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        reapFinishedWorkers(m_workers);
-        m_workers.push_back(std::move(worker));
-    }
+            QMetaObject::invokeMethod(this, [this, r, info]() {
+                emit navMapReceived(r, info);
+            }, Qt::QueuedConnection);
+        });
 }
 
 // ===========================================================================
-// RPC – ListCaptures (unary)
+// RPC – ListCaptures (unary, paged)
+//
+// With the proto extensions the records are requested page_size at a time
+// and each page is emitted as soon as it is converted, so the gallery fills
+// while later pages are in flight and no single response grows past the
+// message limits.  A base gateway ignores the paging fields and answers with
+// everything (an empty next_page_token), which ends the listing after one
+// page.  Pages are chained from the main thread; a newer listCaptures()
+// bumps m_captureListingSeq and the older listing stops.  fetchCapturePage()
+// runs one page through the same path and leaves the chaining to its caller.
 // ===========================================================================
 
-void GatewayClient::listCaptures(const QString& taskId, int32_t pointId)
+void GatewayClient::listCaptures(const QString& taskId, int32_t pointId,
+                                 const hmi::CaptureListOptions& options)
 {
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-    }
-    if (!stub) {
+    auto listing = std::make_shared<CaptureListing>();
+    listing->taskId  = taskId;
+    listing->pointId = pointId;
+    listing->options = options;
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    listing->seq = ++m_captureListingSeq;
+    startCapturePage(std::move(listing));
+}
+
+void GatewayClient::fetchCapturePage(const QString& taskId, int32_t pointId,
+                                     const hmi::CaptureListOptions& options,
+                                     const QString& pageToken, CapturePageFn done)
+{
+    auto listing = std::make_shared<CaptureListing>();
+    listing->taskId    = taskId;
+    listing->pointId   = pointId;
+    listing->options   = options;
+    listing->pageToken = pageToken.toStdString();
+    listing->onPage    = std::move(done);
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    startCapturePage(std::move(listing));
+}
+
+void GatewayClient::startCapturePage(std::shared_ptr<CaptureListing> listing)
+{
+    if (!m_stub) {
         hmi::Result r{ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") };
-        QMetaObject::invokeMethod(this, [this, r]() {
-            emit capturesReceived(r, {});
+        QMetaObject::invokeMethod(this, [this, listing, r]() {
+            finishCapturePage(listing, r, {}, {});
         }, Qt::QueuedConnection);
         return;
     }
 
-    std::thread worker([this, stub, taskId, pointId]() {
-        proto::ListCapturesRequest req;
-        req.set_task_id(taskId.toStdString());
-        req.set_point_id(pointId);
-        req.set_include_thumbnails(true);
-
-        ClientContext ctx;
-        ctx.set_deadline(deadlineFromNow(30));
-
-        proto::ListCapturesResponse resp;
-        Status st = stub->ListCaptures(&ctx, req, &resp);
-
-        hmi::Result r;
-        QVector<hmi::CaptureRecord> records;
-        if (st.ok()) {
-            r = fromProtoResult(resp.result());
-            records.reserve(resp.captures_size());
-            for (const auto& cr : resp.captures()) {
-                records.append(fromProtoCaptureRecord(cr));
+    // Capture lists embed thumbnails and defect lists; see planInspection().
+    RpcEngine::ArenaPool::Lease arena = m_engine->arenas().acquire();
+    auto* req = google::protobuf::Arena::CreateMessage<proto::ListCapturesRequest>(arena.get());
+    req->set_task_id(listing->taskId.toStdString());
+    req->set_point_id(listing->pointId);
+    req->set_include_thumbnails(listing->options.includeThumbnails
+                                && m_mediaQuality.captureThumbnails);
+#ifdef HMI_PROTO_EXTENSIONS
+    if (listing->options.pageSize > 0) {
+        req->set_page_size(static_cast<uint32_t>(listing->options.pageSize));
+    }
+    req->set_page_token(listing->pageToken);
+    // The tighter of the caller's and the link's limit; 0 = none.
+    const int caller = listing->options.thumbnailMaxPx;
+    const int link   = m_mediaQuality.thumbnailMaxPx;
+    const int maxPx  = caller > 0 && link > 0 ? std::min(caller, link) : std::max(caller, link);
+    if (maxPx > 0) {
+        req->set_thumbnail_max_px(static_cast<uint32_t>(maxPx));
+    }
+#endif
+
+    auto* stub = m_stub.get();
+    startTimedUnary<proto::ListCapturesResponse>(
+        RpcMethod::ListCaptures, *req, deadlineFromNow(30),
+        [stub](ClientContext* ctx, const proto::ListCapturesRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncListCaptures(ctx, rq, cq);
+        },
+        [this, listing](const Status& st, proto::ListCapturesResponse& resp) {
+            hmi::Result r;
+            QVector<hmi::CaptureRecord> records;
+            std::string next;
+            if (st.ok()) {
+                ScopedConversionTimer conv(m_metrics, RpcMethod::ListCaptures);
+                r = fromProtoResult(resp.result());
+                records.reserve(resp.captures_size());
+                StringPool pool;   // task / camera IDs repeat across records
+                for (const auto& cr : resp.captures()) {
+                    records.append(fromProtoCaptureRecord(cr, &pool));
+                }
+#ifdef HMI_PROTO_EXTENSIONS
+                next = resp.next_page_token();
+#endif
+            } else {
+                r = fromGrpcStatus(st);
             }
-        } else {
-            r = fromGrpcStatus(st);
-        }
 
-        QMetaObject::invokeMethod(this, [this, r, records]() {
-            emit capturesReceived(r, records);
-        }, Qt::QueuedConnection);
-    });
+            QMetaObject::invokeMethod(this, [this, listing, r, records, next]() {
+                finishCapturePage(listing, r, records, next);
+            }, Qt::QueuedConnection);
+        },
+        std::move(arena));
+}
+
+void GatewayClient::finishCapturePage(const std::shared_ptr<CaptureListing>& listing,
+                                      const hmi::Result& result,
+                                      QVector<hmi::CaptureRecord> page,
+                                      const std::string& nextPageToken)
+{
+    if (listing->onPage) {
+        const bool last = !result.ok() || nextPageToken.empty()
+                          || nextPageToken == listing->pageToken;
+        listing->onPage(result, std::move(page),
+                        last ? QString() : QString::fromStdString(nextPageToken));
+        return;
+    }
 
     {
         std::lock_guard<std::mutex> lk(m_mutex);
-        reapFinishedWorkers(m_workers);
-        m_workers.push_back(std::move(worker));
+        if (listing->seq != m_captureListingSeq) { return; }   // superseded
+    }
+
+    // A gateway that repeats the token would page forever.
+    const bool last = !result.ok() || nextPageToken.empty()
+                      || nextPageToken == listing->pageToken;
+    listing->records += page;
+    emit capturePageReceived(result, listing->taskId, std::move(page), last);
+
+    if (last) {
+        emit capturesReceived(result, std::move(listing->records));
+        return;
+    }
+
+    listing->pageToken = nextPageToken;
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (listing->seq == m_captureListingSeq) {
+        startCapturePage(listing);
     }
 }
 
 // ===========================================================================
 // RPC – DownloadMedia (server-streaming)
 //
-// Reassembles all chunks in-order into a single QByteArray, then emits
-// mediaDownloaded once the stream closes with eof on the final chunk.
+// Runs on the RpcEngine.  Chunks go straight into a MediaSink that was
+// preallocated from MediaRef::sizeBytes (memory buffer or memory-mapped
+// file), the SHA-256 is accumulated per chunk, and the finished buffer is
+// moved – not copied – into the queued completion signal.
 // ===========================================================================
 
-void GatewayClient::downloadMedia(const QString& mediaId)
+namespace {
+
+// Emit a progress update at most every percent (known size) or every
+// kProgressStepBytes (unknown size).
+constexpr qint64 kProgressStepBytes = 1024 * 1024;
+
+hmi::Result downloadResultFromStatus(const Status& st)
 {
-    // Cancel any existing download.
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        if (m_downloadCtx) {
-            m_downloadCtx->TryCancel();
-        }
-    }
-    if (m_downloadThread.joinable()) {
-        m_downloadThread.join();
+    if (st.error_code() == grpc::StatusCode::CANCELLED) {
+        return { hmi::ErrorCode::Unspecified, QStringLiteral("Cancelled") };
     }
+    return fromGrpcStatus(st);
+}
 
-    proto::InspectionGateway::Stub* stub = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        stub = m_stub.get();
-        m_downloadCtx = std::make_unique<ClientContext>();
-    }
-    if (!stub) {
-        QMetaObject::invokeMethod(this, [this]() {
-            emit errorOccurred(QStringLiteral("DownloadMedia: not connected"));
-        }, Qt::QueuedConnection);
-        return;
-    }
+} // anonymous namespace
 
-    m_downloadThread = std::thread([this, stub, mediaId]() {
-        proto::DownloadMediaRequest req;
-        req.set_media_id(mediaId.toStdString());
+quint64 GatewayClient::downloadMedia(const QString& mediaId)
+{
+    hmi::MediaRef ref;
+    ref.mediaId = mediaId;
+    return fetchMedia(ref);
+}
 
-        ClientContext* ctx = nullptr;
-        {
-            std::lock_guard<std::mutex> lk(m_mutex);
-            ctx = m_downloadCtx.get();
+quint64 GatewayClient::fetchMedia(const hmi::MediaRef& media,
+                                  const hmi::MediaDownloadOptions& options)
+{
+    const QString mediaId = media.mediaId;
+    const uint64_t downloadId = m_nextDownloadId.fetch_add(1, std::memory_order_relaxed);
+    auto fail = [this, mediaId, downloadId](const hmi::Result& r) {
+        hmi::MediaPayload payload;
+        payload.mediaId    = mediaId;
+        payload.downloadId = downloadId;
+        QMetaObject::invokeMethod(this, [this, r, payload]() {
+            emit errorOccurred(QStringLiteral("DownloadMedia failed: ") + r.message);
+            emit mediaFetched(r, payload);
+        }, Qt::QueuedConnection);
+    };
+
+    // Resolve the sink location before taking the lock (touches the disk).
+    QString path = options.filePath;
+    if (path.isEmpty() && options.useTempFile) {
+        QTemporaryFile tmp(QDir::temp().filePath(QStringLiteral("hmi-media-XXXXXX")));
+        tmp.setAutoRemove(false);
+        if (!tmp.open()) {
+            fail({ hmi::ErrorCode::Internal,
+                   QStringLiteral("Cannot create temp file: ") + tmp.errorString() });
+            return downloadId;
         }
-        if (!ctx) { return; }
+        path = tmp.fileName();
+    }
 
-        auto reader = stub->DownloadMedia(ctx, req);
+    auto sink = std::make_shared<MediaSink>(path);
+    const qint64 total = static_cast<qint64>(media.sizeBytes);
+    if (!sink->open(total)) {
+        fail({ hmi::ErrorCode::Internal, sink->errorString() });
+        return downloadId;
+    }
+    const QString expectedSha =
+        options.verifySha256 ? media.sha256.trimmed().toLower() : QString();
 
-        QByteArray assembled;
-        proto::MediaChunk chunk;
-        while (reader->Read(&chunk)) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_stub) {
+        sink->discard();
+        fail({ hmi::ErrorCode::Unavailable, QStringLiteral("Not connected") });
+        return downloadId;
+    }
+
+    proto::DownloadMediaRequest req;
+    req.set_media_id(mediaId.toStdString());
+
+    auto* stub = m_stub.get();
+    const auto        opened   = RpcMetrics::Clock::now();
+    const std::size_t reqBytes = req.ByteSizeLong();
+
+    grpc::ClientContext* ctx = m_engine->startServerStream<proto::MediaChunk>(
+        m_calls, req,
+        [stub](ClientContext* c, const proto::DownloadMediaRequest& rq,
+               grpc::CompletionQueue* cq) {
+            return stub->PrepareAsyncDownloadMedia(c, rq, cq);
+        },
+        [this, sink, mediaId, downloadId, total, lastReported = qint64(-1)]
+        (proto::MediaChunk& chunk) mutable -> bool {
             const auto& data = chunk.data();
-            assembled.append(data.data(), static_cast<int>(data.size()));
-        }
+            m_metrics.recordMessage(RpcMethod::DownloadMedia, data.size());
+            if (!sink->append(data.data(), static_cast<qint64>(data.size()))) {
+                return false;   // sink error → cancel; reported in onDone
+            }
 
-        Status st = reader->Finish();
-        if (st.ok()) {
-            QMetaObject::invokeMethod(this, [this, mediaId, assembled]() {
-                emit mediaDownloaded(mediaId, assembled);
-            }, Qt::QueuedConnection);
-        } else if (st.error_code() != grpc::StatusCode::CANCELLED) {
-            QString err = QString::fromStdString(st.error_message());
-            QMetaObject::invokeMethod(this, [this, err]() {
-                emit errorOccurred(QStringLiteral("DownloadMedia failed: ") + err);
-            }, Qt::QueuedConnection);
-        }
-    });
+            const qint64 received = sink->bytesWritten();
+            const qint64 step = total > 0 ? std::max<qint64>(1, total / 100)
+                                          : kProgressStepBytes;
+            if (lastReported < 0 || received - lastReported >= step) {
+                lastReported = received;
+                QMetaObject::invokeMethod(this, [this, mediaId, downloadId, received, total]() {
+                    emit mediaDownloadProgress(mediaId, received, total, downloadId);
+                }, Qt::QueuedConnection);
+            }
+            return true;
+        },
+        [this, sink, mediaId, expectedSha, downloadId, total, opened, reqBytes](
+            const Status& st) {
+            m_metrics.recordCall(RpcMethod::DownloadMedia, RpcMetrics::Clock::now() - opened,
+                                 st.ok(), reqBytes, 0, isLinkFailure(st));
+            {
+                std::lock_guard<std::mutex> guard(m_mutex);
+                m_downloads.erase(downloadId);
+            }
+
+            hmi::Result r;
+            hmi::MediaPayload payload;
+            payload.mediaId    = mediaId;
+            payload.downloadId = downloadId;
+
+            if (!sink->errorString().isEmpty()) {
+                r = { hmi::ErrorCode::Internal, sink->errorString() };
+            } else if (!st.ok()) {
+                r = downloadResultFromStatus(st);
+            } else if (!expectedSha.isEmpty() && sink->sha256Hex() != expectedSha) {
+                r = { hmi::ErrorCode::Internal,
+                      QStringLiteral("SHA-256 mismatch for media %1").arg(mediaId) };
+            } else if (!sink->finish()) {
+                r = { hmi::ErrorCode::Internal, sink->errorString() };
+            } else {
+                r.code            = hmi::ErrorCode::Ok;
+                payload.sizeBytes = sink->bytesWritten();
+                payload.sha256    = sink->sha256Hex();
+                payload.filePath  = sink->isFileSink() ? sink->filePath() : QString();
+                payload.data      = sink->takeData();
+            }
+
+            if (!r.ok()) {
+                sink->discard();
+            }
+
+            const qint64 received = payload.sizeBytes;
+            QMetaObject::invokeMethod(this,
+                [this, r, payload = std::move(payload), received, total]() {
+                    if (r.ok()) {
+                        emit mediaDownloadProgress(payload.mediaId, received,
+                                                   total > 0 ? total : received,
+                                                   payload.downloadId);
+                        if (payload.filePath.isEmpty()) {
+                            emit mediaDownloaded(payload.mediaId, payload.data);
+                        }
+                    } else if (r.code != hmi::ErrorCode::Unspecified) {
+                        emit errorOccurred(QStringLiteral("DownloadMedia failed: ") + r.message);
+                    }
+                    emit mediaFetched(r, payload);
+                }, Qt::QueuedConnection);
+        });
+
+    m_downloads.emplace(downloadId, ActiveDownload{ ctx });
+    return downloadId;
+}
+
+void GatewayClient::cancelMediaDownload(quint64 downloadId)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    auto it = m_downloads.find(downloadId);
+    if (it != m_downloads.end()) {
+        it->second.ctx->TryCancel();
+    }
 }
 
 } // namespace hmi
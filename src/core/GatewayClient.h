@@ -6,21 +6,87 @@
 //
 // Design notes
 // ------------
-// * Unary RPCs execute on a dedicated std::thread per call so the Qt main
-//   thread is never blocked.  Signals are emitted back to the main thread via
-//   QMetaObject::invokeMethod with Qt::QueuedConnection.
+// * Unary RPCs are started asynchronously on an RpcEngine: one
+//   grpc::CompletionQueue drained by a fixed poller thread that owns every
+//   in-flight call, so a call costs one allocation instead of one thread.
+//   Completion callbacks convert the response on the poller thread and emit
+//   back to the main thread via QMetaObject::invokeMethod with
+//   Qt::QueuedConnection.  disconnectFromGateway() cancels in-flight calls and
+//   waits for their callbacks (RpcEngine::CallSet).  The large ones
+//   (PlanInspection, GetPlan, ListCaptures) build request and response on a
+//   pooled protobuf arena (RpcEngine::ArenaPool).
 //
-// * Server-streaming RPCs (SubscribeSystemState, SubscribeInspectionEvents,
-//   DownloadMedia) each run their Read loop on a dedicated std::thread.  The
-//   associated grpc::ClientContext is stored in a member that can be cancelled
-//   via stopSubscriptions() / disconnectFromGateway().
+// * Server-streaming subscriptions (SubscribeSystemState,
+//   SubscribeInspectionEvents) run on the RpcEngine as well: every Read
+//   completes on a poller thread, so a client owns no thread of its own.
+//   Each stream has its own CallSet, which stopSubscriptions() /
+//   disconnectFromGateway() and a resubscription cancel and wait for.
 //
-// * Client-streaming RPC (UploadCad) reads the given file in 64 KB chunks on
-//   a worker thread, streams them to the server, and emits uploadCadProgress
-//   periodically followed by uploadCadFinished.
+// * The engine can be shared: clients constructed with the same RpcEngine
+//   (FleetClient, one per robot) share its completion queue and pollers.
 //
-// * Connection state is polled on a separate thread and surfaced through the
-//   connectionStateChanged signal.
+// * DownloadMedia streams run on the RpcEngine and write each chunk straight
+//   into a MediaSink (preallocated buffer or memory-mapped file) while the
+//   SHA-256 is checked incrementally; progress is reported per percent and
+//   the payload is handed over as an implicitly shared QByteArray or a path.
+//
+// * SubscribeSystemState is latest-wins: the reader thread swaps the raw
+//   TaskStatus message into a single-slot mailbox, and the main thread drains
+//   it at most once per frame (setSystemStateMaxRate()), converting only the
+//   value it actually delivers.  Updates overwritten in between are counted
+//   in systemStateStats() instead of piling up in the event queue, and are
+//   never converted.  setRobotStateObserver() sees every message's AGV pose
+//   and joint angles on the reader thread, before the coalescing, for work
+//   that belongs off the GUI thread (the 3D twin's forward kinematics).
+//
+// * Task status, inspection events and plans are emitted as immutable
+//   snapshots (hmi::Snapshot): every queued connection shares one converted
+//   value instead of copying it per receiver.
+//
+// * Stream conversions intern repeated identifiers (task / plan / frame /
+//   camera IDs, error codes) through a per-stream StringPool, and the
+//   inspection-event stream parses every message into the engine's reused
+//   message object.
+//
+// * syncInspectionTargets() uploads only what changed since the gateway last
+//   acknowledged a target set for the model (TargetSync fingerprints).  An
+//   unchanged set completes without a round trip; with the proto extensions
+//   (HMI_PROTO_EXTENSIONS) a changed set is sent as UpdateInspectionTargets
+//   upserts / removals against the acknowledged revision, and a revision
+//   conflict or an older gateway falls back to the full SetInspectionTargets.
+//   Syncs for one model are serialised; a sync requested while one is in
+//   flight replaces any older queued one.
+//
+// * Client-streaming RPC (UploadCad) runs a CadUploadSession on a worker
+//   thread: memory-mapped, pipelined, adaptively sized chunks (and, with the
+//   proto extensions, known-file skip, compression and resume).  It emits
+//   uploadCadProgress per percent followed by uploadCadFinished; a disconnect
+//   or cancelCadUploads() aborts it promptly.
+//
+// * Connection state is event-driven: a channel connectivity watch on the
+//   RpcEngine queue (no thread, no polling) re-arms itself on every change
+//   and surfaces READY / not-READY through connectionStateChanged.  The
+//   channel uses HTTP/2 keepalive pings so a dead link fails streams within
+//   seconds.  Subscriptions that end with an error are re-established with
+//   exponential backoff (immediately once the channel is READY again);
+//   connectionStats() reports drops and reconnect latency.
+//
+// * Both subscriptions can be recorded to a segmented, memory-mapped log
+//   (startTelemetryRecording) and replayed through the same signals at 1x,
+//   10x or full speed (startTelemetryReplay).
+//
+// * Plans are kept in an optional on-disk PlanCache (setPlanCache()): every
+//   successful PlanInspection / GetPlan result is stored, and getPlan() with
+//   PlanFetchPolicy::PreferCache serves a cached copy without decoding a
+//   response.  With the proto extensions the copy is revalidated first
+//   (known_revision / not_modified, docs/proto_extensions.md §4); without
+//   them plans are immutable and the copy is served directly.  Cache I/O
+//   runs on a private one-thread pool, never on the poller or GUI thread.
+//
+// * Every RPC and stream is instrumented (RpcMetrics): latency histograms,
+//   bytes, stream message counts, fromProto* conversion time and the lag
+//   between Read() and the queued main-thread emission.  rpcMetrics() returns
+//   a snapshot; setRpcMetricsDump() appends them to a JSON-lines file.
 //
 // Thread safety
 // -------------
@@ -30,16 +96,31 @@
 
 #pragma once
 
+#include "LatestValueMailbox.h"
+#include "RpcEngine.h"
+#include "RpcMetrics.h"
+#include "StringPool.h"
+#include "TelemetryRecorder.h"
+#include "TargetSync.h"
 #include "Types.h"
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QObject>
 #include <QString>
+#include <QThreadPool>
+#include <QTimer>
 #include <QVector>
 
 #include <atomic>
+#include <array>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 // gRPC headers required for member declarations.
@@ -48,6 +129,25 @@
 
 namespace hmi {
 
+class CadUploadSession;
+class PlanCache;
+class TelemetryReplayer;
+
+/// Channel-level connection counters since connectToGateway().
+struct ConnectionStats {
+    uint64_t drops             = 0;   ///< READY -> not READY transitions
+    uint64_t reconnects        = 0;   ///< not READY -> READY after a drop
+    uint64_t resubscribes      = 0;   ///< streams re-established automatically
+    qint64   lastReconnectMs   = -1;  ///< latency of the latest reconnect
+    qint64   maxReconnectMs    = -1;
+    qint64   totalReconnectMs  = 0;   ///< sum, for the mean
+
+    [[nodiscard]] double meanReconnectMs() const noexcept
+    {
+        return reconnects > 0 ? double(totalReconnectMs) / double(reconnects) : -1.0;
+    }
+};
+
 class GatewayClient : public QObject {
     Q_OBJECT
 
@@ -55,6 +155,11 @@ public:
     /// Construct with an optional initial gateway address.
     /// Call connectToGateway() to (re-)connect at any time.
     explicit GatewayClient(const QString& address = {}, QObject* parent = nullptr);
+
+    /// Construct on a shared \a engine; every call and stream of this client
+    /// completes on its poller threads.  The engine outlives the client.
+    explicit GatewayClient(std::shared_ptr<RpcEngine> engine, const QString& address = {},
+                           QObject* parent = nullptr);
     ~GatewayClient() override;
 
     // Non-copyable, non-movable (QObject semantics).
@@ -68,6 +173,101 @@ public:
     // -----------------------------------------------------------------------
     [[nodiscard]] bool isConnected() const noexcept;
     [[nodiscard]] QString currentAddress() const;
+    [[nodiscard]] std::shared_ptr<RpcEngine> engine() const { return m_engine; }
+
+    // -----------------------------------------------------------------------
+    // System-state delivery rate
+    // -----------------------------------------------------------------------
+
+    /// Cap systemStateReceived at \a hz emissions per second (default 30).
+    /// hz <= 0 removes the cap; updates are still coalesced per event-loop
+    /// pass.
+    void setSystemStateMaxRate(double hz);
+    [[nodiscard]] double systemStateMaxRate() const noexcept;
+
+    /// Published / delivered / superseded counters of the system-state
+    /// mailbox since construction.
+    [[nodiscard]] MailboxStats systemStateStats() const;
+
+    /// Robot pose fields of one SubscribeSystemState message.
+    struct RobotStateSample {
+        bool                  hasAgv = false;
+        double                agvX = 0.0, agvY = 0.0, agvYaw = 0.0;   ///< map frame
+        bool                  hasArm = false;
+        std::array<double, 6> joints{};                               ///< rad
+    };
+    using RobotStateObserver = std::function<void(const RobotStateSample&)>;
+
+    /// Call \a observer for every system-state message on the thread that
+    /// read it (stream reader or telemetry replay), before latest-wins
+    /// coalescing.  It must be quick and thread-safe.  Empty to remove.
+    void setRobotStateObserver(RobotStateObserver observer);
+
+    /// Drop / reconnect counters of the current connection.
+    [[nodiscard]] ConnectionStats connectionStats() const;
+
+    // -----------------------------------------------------------------------
+    // RPC instrumentation
+    // -----------------------------------------------------------------------
+
+    /// Latency / size / rate counters of every RPC since construction or
+    /// resetRpcMetrics().
+    [[nodiscard]] RpcMetricsSnapshot rpcMetrics() const;
+    void resetRpcMetrics();
+
+    /// Append one JSON line (rpcMetrics() and connectionStats()) to
+    /// \a filePath every \a intervalMs.  An empty path stops dumping.
+    void setRpcMetricsDump(const QString& filePath, int intervalMs = 10000);
+
+    /// Thumbnail limits for GetNavMap / ListCaptures requests issued from
+    /// now on (a listing that is paging picks them up with its next page).
+    void setMediaQuality(const MediaQuality& quality);
+    [[nodiscard]] MediaQuality mediaQuality() const;
+
+    // -----------------------------------------------------------------------
+    // Telemetry recording / replay
+    // -----------------------------------------------------------------------
+
+    /// Record every SubscribeSystemState / SubscribeInspectionEvents message
+    /// into segment files under \a directory (see TelemetryRecorder).
+    hmi::Result startTelemetryRecording(const QString& directory,
+                                        const TelemetryRecorderOptions& options = {});
+    void stopTelemetryRecording();
+    [[nodiscard]] TelemetryRecorderStats telemetryRecorderStats() const;
+
+    /// Feed a recording (directory or segment file) back through
+    /// systemStateReceived / inspectionEventReceived at \a speed times the
+    /// recorded pace (TelemetryReplayer::kMaxSpeed: as fast as possible).
+    /// Ends with telemetryReplayFinished.  Live subscriptions keep running.
+    hmi::Result startTelemetryReplay(const QString& path, double speed = 1.0);
+    void stopTelemetryReplay();
+
+    // -----------------------------------------------------------------------
+    // Plan cache
+    // -----------------------------------------------------------------------
+
+    /// Store plans in \a cache and serve getPlan() from it (null: no cache).
+    void setPlanCache(std::shared_ptr<PlanCache> cache);
+    [[nodiscard]] std::shared_ptr<PlanCache> planCache() const;
+
+    // -----------------------------------------------------------------------
+    // Pulled capture listings
+    // -----------------------------------------------------------------------
+
+    /// Result of fetchCapturePage(); \a nextPageToken is empty on the last
+    /// page and on failure.
+    using CapturePageFn = std::function<void(const hmi::Result& result,
+                                             QVector<hmi::CaptureRecord> page,
+                                             QString nextPageToken)>;
+
+    /// Fetch the single ListCaptures page at \a pageToken (empty: first page)
+    /// and hand it to \a done on the main thread.  Unlike listCaptures() the
+    /// caller asks for the next page itself, so a consumer that is slower
+    /// than the gateway holds one page at a time; such fetches neither
+    /// supersede nor are superseded by listCaptures().
+    void fetchCapturePage(const QString& taskId, int32_t pointId,
+                          const hmi::CaptureListOptions& options,
+                          const QString& pageToken, CapturePageFn done);
 
 signals:
     // -----------------------------------------------------------------------
@@ -86,10 +286,10 @@ signals:
     void setTargetsFinished(hmi::Result result, uint32_t totalTargets);
 
     // PlanInspection
-    void planInspectionFinished(hmi::PlanResponse response);
+    void planInspectionFinished(hmi::PlanResponseSnapshot response);
 
     // GetPlan
-    void getPlanFinished(hmi::GetPlanResponse response);
+    void getPlanFinished(hmi::GetPlanResponseSnapshot response);
 
     // StartInspection
     void startInspectionFinished(hmi::Result result, QString taskId);
@@ -98,23 +298,40 @@ signals:
     void controlTaskFinished(hmi::Result result);
 
     // GetTaskStatus
-    void taskStatusReceived(hmi::TaskStatus status);
+    void taskStatusReceived(hmi::TaskStatusSnapshot status);
 
     // SubscribeSystemState (server-streaming)
-    void systemStateReceived(hmi::TaskStatus status);
+    void systemStateReceived(hmi::TaskStatusSnapshot status);
 
     // SubscribeInspectionEvents (server-streaming)
-    void inspectionEventReceived(hmi::InspectionEvent event);
+    void inspectionEventReceived(hmi::InspectionEventSnapshot event);
 
     // GetNavMap
     void navMapReceived(hmi::Result result, hmi::NavMapInfo mapInfo);
 
     // ListCaptures
+    /// One page of a listCaptures() call; \a last is set on the final page
+    /// and on failure.  Pages of a superseded listing are not emitted.
+    void capturePageReceived(hmi::Result result, QString taskId,
+                             QVector<hmi::CaptureRecord> captures, bool last);
+    /// Emitted once after the last page with every record of the listing.
     void capturesReceived(hmi::Result result, QVector<hmi::CaptureRecord> captures);
 
-    // DownloadMedia (server-streaming reassembled)
+    // DownloadMedia (server-streaming)
+    void mediaDownloadProgress(QString mediaId, qint64 receivedBytes, qint64 totalBytes,
+                               quint64 downloadId);
+    /// Emitted once per fetchMedia()/downloadMedia() call, with the call's
+    /// token in payload.downloadId.  A cancelled download reports
+    /// ErrorCode::Unspecified with message "Cancelled".
+    void mediaFetched(hmi::Result result, hmi::MediaPayload payload);
+    /// Legacy: emitted in addition to mediaFetched for successful in-memory
+    /// downloads.
     void mediaDownloaded(QString mediaId, QByteArray data);
 
+    /// startTelemetryReplay() reached the end of the recording or was
+    /// stopped (ErrorCode::Unspecified, "Cancelled").
+    void telemetryReplayFinished(hmi::Result result);
+
 public slots:
     // -----------------------------------------------------------------------
     // Connection management
@@ -126,22 +343,43 @@ public slots:
     // RPCs
     // -----------------------------------------------------------------------
 
-    /// Upload a CAD file to the gateway.  Reads filePath in 64 KB chunks.
-    void uploadCad(const QString& filePath);
+    /// Upload a CAD file to the gateway (see CadUploadSession).  A file the
+    /// gateway already holds completes with Ok and message
+    /// "Already on gateway"; a cancelled upload reports
+    /// ErrorCode::Unspecified with message "Cancelled".
+    void uploadCad(const QString& filePath,
+                   const hmi::CadUploadOptions& options = {});
 
-    /// Set the list of inspection targets for modelId.
+    /// Abort every running uploadCad().
+    void cancelCadUploads();
+
+    /// Set the list of inspection targets for modelId (full replace).
     void setInspectionTargets(const QString& modelId,
                               const QVector<hmi::InspectionTarget>& targets,
                               const hmi::CaptureConfig& config,
                               const QString& operatorId);
 
+    /// Make the gateway's target list for modelId equal \a targets, sending
+    /// only the difference to the last acknowledged upload where possible.
+    /// Completes with setTargetsFinished() like setInspectionTargets().
+    void syncInspectionTargets(const QString& modelId,
+                               const QVector<hmi::InspectionTarget>& targets,
+                               const hmi::CaptureConfig& config,
+                               const QString& operatorId);
+
+    /// Forget every acknowledged target set; the next sync is a full upload.
+    void resetTargetSync();
+
     /// Ask the planner to generate an inspection path.
     void planInspection(const QString& modelId,
                         const QString& taskName,
                         const hmi::PlanOptions& options);
 
-    /// Retrieve a previously generated plan by ID.
-    void getPlan(const QString& planId);
+    /// Retrieve a previously generated plan by ID.  With a plan cache and
+    /// PreferCache the result may come from disk (GetPlanResponse::fromCache);
+    /// a cached copy is also served when revalidating it fails.
+    void getPlan(const QString& planId,
+                 hmi::PlanFetchPolicy policy = hmi::PlanFetchPolicy::PreferCache);
 
     /// Start executing an inspection plan.
     void startInspection(const QString& planId, bool dryRun = false);
@@ -163,32 +401,188 @@ public slots:
     void subscribeSystemState(const QString& taskId = {});
 
     /// Start a server-streaming subscription to inspection events.
-    /// taskId empty → all tasks.
-    void subscribeInspectionEvents(const QString& taskId = {});
-
-    /// Retrieve navigation map info (and optional image thumbnail).
+    /// taskId empty → all tasks.  Only events \a filter accepts are
+    /// converted and emitted; with the proto extensions the gateway drops
+    /// the others before sending.  Resubscriptions keep the filter.
+    void subscribeInspectionEvents(const QString& taskId = {},
+                                   const hmi::InspectionEventFilter& filter = {});
+
+    /// Retrieve navigation map info (and, unless mediaQuality() turns it
+    /// off, the image thumbnail).
     void getNavMap(const QString& mapId = {});
 
     /// List all capture records for a task.  pointId == 0 → all points.
-    void listCaptures(const QString& taskId, int32_t pointId = 0);
-
-    /// Download a binary media blob by ID.  Reassembles all chunks then emits
-    /// mediaDownloaded with the full payload.
-    void downloadMedia(const QString& mediaId);
+    /// Records arrive page by page (capturePageReceived); a new call
+    /// supersedes a listing that is still paging.
+    void listCaptures(const QString& taskId, int32_t pointId = 0,
+                      const hmi::CaptureListOptions& options = {});
+
+    /// Download a binary media blob by ID into memory.  Equivalent to
+    /// fetchMedia() with only the mediaId known.
+    quint64 downloadMedia(const QString& mediaId);
+
+    /// Stream a media blob into memory or to disk (see MediaDownloadOptions).
+    /// media.sizeBytes preallocates the destination and media.sha256, when
+    /// present, is verified.  Any number of downloads may run concurrently,
+    /// several of the same mediaId included.  Returns the call's token
+    /// (never 0), echoed in mediaFetched() / mediaDownloadProgress().
+    quint64 fetchMedia(const hmi::MediaRef& media,
+                       const hmi::MediaDownloadOptions& options = {});
+
+    /// Cancel the download started with token \a downloadId; other
+    /// downloads of the same mediaId keep running.
+    void cancelMediaDownload(quint64 downloadId);
 
     /// Cancel all active streaming subscriptions (system-state, events,
-    /// download).  Does NOT disconnect the channel.
+    /// downloads) and stop resubscribing them.  Does NOT disconnect the
+    /// channel.
     void stopSubscriptions();
 
 private:
     // -----------------------------------------------------------------------
     // Internal helpers
     // -----------------------------------------------------------------------
+    /// Shared between the connectivity watch callbacks and the client; the
+    /// owner pointer is cleared (under \a mutex) when monitoring stops.
+    struct ChannelWatch {
+        std::mutex                            mutex;
+        GatewayClient*                        owner = nullptr;
+        std::weak_ptr<grpc::Channel>          channel;
+        bool                                  ready = false;
+        bool                                  lost  = false;  ///< dropped since last READY
+        std::chrono::steady_clock::time_point lostAt;
+    };
+
     void startConnectionMonitor();
     void stopConnectionMonitor();
+    /// Read the channel state, report a transition, and wait for the next
+    /// one.  Called with \a watch->mutex held.
+    void armChannelWatch(const std::shared_ptr<ChannelWatch>& watch);
+
+    enum class Stream { SystemState, Events };
+
+    /// A subscription the caller asked for; re-established after errors.
+    struct StreamWant {
+        bool     active     = false;   ///< requested and not stopped
+        bool     running    = false;   ///< a stream is open or being opened
+        QString  taskId;
+        int      failures   = 0;       ///< consecutive, for the backoff
+        uint64_t generation = 0;       ///< bumped for every stream opened
+    };
+    StreamWant& want(Stream stream);   ///< m_mutex held
+
+    /// Poller thread: the \a generation stream of \a stream ended; reports
+    /// an error and schedules the resubscription, or marks the stream
+    /// stopped.  An end of a superseded generation changes no state.
+    void finishSubscription(Stream stream, uint64_t generation, const grpc::Status& st,
+                            RpcMetrics::Clock::time_point opened, std::size_t requestBytes);
+    /// Main thread: the \a generation stream ended with an error; ignored
+    /// once a newer stream has been opened.
+    void scheduleResubscribe(Stream stream, uint64_t generation);
+    /// Main thread: reopen \a stream if it is wanted and not running.
+    void resubscribe(Stream stream);
     void joinAllWorkers();
     void cancelAllContexts();
 
+    /// Stub member selecting one of the three control RPCs
+    /// (PrepareAsyncPause/Resume/StopInspection).
+    using ControlPrepareFn =
+        std::unique_ptr<grpc::ClientAsyncResponseReader<
+            inspection::gateway::v1::ControlTaskResponse>>
+        (inspection::gateway::v1::InspectionGateway::Stub::*)(
+            grpc::ClientContext*,
+            const inspection::gateway::v1::ControlTaskRequest&,
+            grpc::CompletionQueue*);
+
+    void startControlRpc(const QString& taskId, const QString& reason,
+                         ControlPrepareFn prepare, RpcMethod method);
+
+    /// RpcEngine::startUnary on m_calls, recording latency and message sizes
+    /// of \a method in m_metrics before \a done runs.  \a arena (from
+    /// m_engine->arenas()) backs the response, see RpcEngine::ArenaPool.
+    template <typename Response, typename Request, typename PrepareFn>
+    void startTimedUnary(RpcMethod method, const Request& request,
+                         std::chrono::system_clock::time_point deadline,
+                         PrepareFn&& prepare,
+                         RpcEngine::UnaryDoneFn<Response> done,
+                         RpcEngine::ArenaPool::Lease arena = {});
+
+    /// One target upload (the arguments of a sync / set call).
+    struct TargetUpload {
+        QString                        modelId;
+        QVector<hmi::InspectionTarget> targets;
+        hmi::CaptureConfig             config;
+        QString                        operatorId;
+    };
+
+    /// Full SetInspectionTargets; on success \a next becomes the model's
+    /// acknowledged snapshot.  \a tracked: part of a sync sequence.
+    void sendAllTargets(TargetUpload upload, TargetSnapshot next, bool tracked);
+
+    /// Diff against the acknowledged snapshot and send the cheapest upload.
+    void startTargetSync(TargetUpload upload);
+
+#ifdef HMI_PROTO_EXTENSIONS
+    /// UpdateInspectionTargets with \a delta against \a baseRevision.
+    void sendTargetDelta(TargetUpload upload, TargetSnapshot next,
+                         uint64_t baseRevision, const TargetDelta& delta);
+#endif
+
+    /// Main thread: end of one sync; starts the queued one, if any.
+    void finishTargetSync(const QString& modelId);
+
+    /// State of one paged listCaptures() call.
+    struct CaptureListing {
+        uint64_t                    seq = 0;
+        QString                     taskId;
+        int32_t                     pointId = 0;
+        hmi::CaptureListOptions     options;
+        std::string                 pageToken;
+        QVector<hmi::CaptureRecord> records;   ///< accumulated for capturesReceived
+        CapturePageFn               onPage;    ///< set: one pulled page, no signals
+    };
+
+    /// Request the next page of \a listing.  Called with m_mutex held.
+    void startCapturePage(std::shared_ptr<CaptureListing> listing);
+
+    /// Main thread: emit a finished page and request the next one.
+    void finishCapturePage(const std::shared_ptr<CaptureListing>& listing,
+                           const hmi::Result& result,
+                           QVector<hmi::CaptureRecord> page,
+                           const std::string& nextPageToken);
+
+    /// Stream delivery shared by the reader threads and telemetry replay:
+    /// hand \a ev's status to the latest-wins mailbox / convert and queue
+    /// \a ev for emission.
+    void publishSystemState(inspection::gateway::v1::SystemStateEvent& ev,
+                            RpcMetrics::Clock::time_point readAt);
+    /// Events \a filter rejects are dropped here, before conversion.
+    void deliverInspectionEvent(inspection::gateway::v1::InspectionEvent& ev,
+                                const hmi::InspectionEventFilter& filter,
+                                StringPool& pool, RpcMetrics::Clock::time_point readAt);
+
+    /// Serialize \a message into the active recorder, if any.
+    template <typename Message>
+    void recordTelemetry(TelemetryStream stream, const Message& message,
+                         std::string& scratch);
+
+    /// Main-thread side of the system-state mailbox: emits the latest update
+    /// or re-arms itself until the rate limit allows the next emission.
+    void drainSystemState();
+
+    /// GetPlan RPC; \a knownRevision != 0 asks for not_modified (extensions).
+    /// Answers Unavailable once the connection \a generation has ended.
+    void fetchPlan(const QString& planId, uint64_t knownRevision, uint64_t generation);
+    /// On m_planCachePool: emit the cached copy of \a planId.  On a miss,
+    /// emit \a failure, or fetch the plan (in \a generation) when there is none.
+    void servePlanFromCache(std::shared_ptr<PlanCache> cache, const QString& planId,
+                            uint64_t generation,
+                            std::optional<hmi::Result> failure = std::nullopt);
+    /// On m_planCachePool: store a successful plan.
+    void storePlan(std::shared_ptr<PlanCache> cache, hmi::GetPlanResponseSnapshot plan,
+                   uint64_t revision);
+    void emitGetPlanFinished(hmi::GetPlanResponse response);
+
     // -----------------------------------------------------------------------
     // State
     // -----------------------------------------------------------------------
@@ -200,28 +594,94 @@ private:
     // The stub is created once per channel; access under m_mutex.
     std::unique_ptr<inspection::gateway::v1::InspectionGateway::Stub> m_stub;
 
+    // -----------------------------------------------------------------------
+    // Async engine for unary RPCs and streams (possibly shared)
+    // -----------------------------------------------------------------------
+    std::shared_ptr<RpcEngine>           m_engine;
+    std::shared_ptr<RpcEngine::CallSet>  m_calls;   ///< In-flight unary calls.
+    std::shared_ptr<RpcEngine::CallSet>  m_sysStateCalls;   ///< The system-state stream.
+    std::shared_ptr<RpcEngine::CallSet>  m_eventsCalls;     ///< The event stream.
+
     // -----------------------------------------------------------------------
     // Worker threads
     // -----------------------------------------------------------------------
-    std::vector<std::thread> m_workers;   ///< One-shot RPC threads.
+    std::vector<std::thread> m_workers;   ///< UploadCad threads.
+    /// Running uploads, for cancellation; guarded by m_mutex.
+    std::vector<std::shared_ptr<CadUploadSession>> m_uploads;
+
+    // Media downloads on the engine, keyed by a per-client download id.
+    struct ActiveDownload {
+        grpc::ClientContext* ctx = nullptr;   ///< Valid while in the map.
+    };
+    std::unordered_map<uint64_t, ActiveDownload> m_downloads;
+    std::atomic<uint64_t>                        m_nextDownloadId{1};   ///< Token source, no lock
+
+    // -----------------------------------------------------------------------
+    // Incremental target uploads (under m_mutex)
+    // -----------------------------------------------------------------------
+    struct TargetSyncEntry {
+        std::optional<TargetSnapshot> acked;     ///< what the gateway holds
+        bool                          inFlight = false;
+        std::optional<TargetUpload>   queued;    ///< latest request while in flight
+    };
+    QHash<QString, TargetSyncEntry> m_targetSync;   ///< keyed by model ID
+
+    uint64_t m_captureListingSeq = 0;   ///< latest listCaptures(); under m_mutex
+    MediaQuality m_mediaQuality;        ///< under m_mutex
+    std::atomic<bool>               m_deltaUnsupported{false};
+
+    // -----------------------------------------------------------------------
+    // Latest-wins system-state delivery
+    // -----------------------------------------------------------------------
+    /// Raw messages; converted in drainSystemState() so superseded updates
+    /// cost no conversion.
+    LatestValueMailbox<inspection::gateway::v1::TaskStatus> m_sysStateMailbox;
+    std::atomic<int>                    m_sysStateIntervalMs{33};
+    /// Read by the stream threads with std::atomic_load.
+    std::shared_ptr<const RobotStateObserver> m_robotObserver;
+    QElapsedTimer                       m_sysStateLastDelivery; ///< Main thread only.
+    StringPool                          m_sysStatePool;         ///< Main thread only.
+
+    // -----------------------------------------------------------------------
+    // Instrumentation
+    // -----------------------------------------------------------------------
+    RpcMetrics           m_metrics;
+    std::atomic<int64_t> m_sysStateReadAtNs{0};  ///< Read() of the mailbox value
+    QTimer*              m_metricsDumpTimer = nullptr;   ///< Main thread only.
+    QString              m_metricsDumpPath;
+    RpcMetricsSnapshot   m_lastMetricsDump;
+
+    void dumpRpcMetrics();
+
+    // -----------------------------------------------------------------------
+    // Telemetry
+    // -----------------------------------------------------------------------
+    /// Read by the stream threads with std::atomic_load.
+    std::shared_ptr<TelemetryRecorder> m_recorder;
+    std::unique_ptr<TelemetryReplayer> m_replayer;   ///< Main thread only.
 
-    // Long-lived streaming threads.
-    std::thread m_sysStateThread;
-    std::thread m_eventsThread;
-    std::thread m_downloadThread;
-    std::thread m_connMonitorThread;
+    // -----------------------------------------------------------------------
+    // Plan cache
+    // -----------------------------------------------------------------------
+    /// Read with std::atomic_load.
+    std::shared_ptr<PlanCache> m_planCache;
+    QThreadPool                m_planCachePool;   ///< one thread: ordered disk I/O
+    /// Bumped by disconnectFromGateway(); queued plan-cache tasks of an
+    /// older connection no longer start RPCs.
+    std::atomic<uint64_t>      m_connectionGeneration{0};
 
     // -----------------------------------------------------------------------
-    // Cancellation tokens for streaming contexts
+    // Connection monitoring (under m_mutex)
     // -----------------------------------------------------------------------
-    std::unique_ptr<grpc::ClientContext> m_sysStateCtx;
-    std::unique_ptr<grpc::ClientContext> m_eventsCtx;
-    std::unique_ptr<grpc::ClientContext> m_downloadCtx;
+    std::shared_ptr<ChannelWatch> m_channelWatch;
+    ConnectionStats               m_connStats;
+    StreamWant                    m_sysStateWant;
+    StreamWant                    m_eventsWant;
+    hmi::InspectionEventFilter    m_eventsFilter;   ///< of the wanted event stream
 
     // -----------------------------------------------------------------------
     // Flags
     // -----------------------------------------------------------------------
-    std::atomic<bool> m_stopMonitor{false};
     std::atomic<bool> m_connected{false};
 };
 
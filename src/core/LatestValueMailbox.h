@@ -0,0 +1,88 @@
+// src/core/LatestValueMailbox.h
+//
+// LatestValueMailbox<T> – single-slot, latest-wins hand-off between a
+// producer thread (a gRPC stream reader) and a consumer thread (the Qt GUI).
+//
+// The producer overwrites the slot on every message; the consumer takes the
+// most recent value whenever it is ready.  Values that are overwritten before
+// being taken are counted as superseded instead of queuing up behind a slow
+// consumer.
+//
+// Thread safety: publish() and take() may be called concurrently from
+// different threads.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace hmi {
+
+/// Delivery counters of a LatestValueMailbox.
+struct MailboxStats {
+    uint64_t published  = 0;   ///< Values written by the producer.
+    uint64_t delivered  = 0;   ///< Values taken by the consumer.
+    uint64_t superseded = 0;   ///< Values overwritten before being taken.
+};
+
+template <typename T>
+class LatestValueMailbox {
+public:
+    /// Store \a value, replacing any value that has not been taken yet.
+    /// Returns true when the slot was empty, i.e. the consumer has to be
+    /// notified; false when a notification is already outstanding.
+    bool publish(T value)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        const bool wasEmpty = !m_slot.has_value();
+        if (!wasEmpty) {
+            m_superseded.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_slot = std::move(value);
+        m_published.fetch_add(1, std::memory_order_relaxed);
+        return wasEmpty;
+    }
+
+    /// Take the latest value, leaving the slot empty.
+    std::optional<T> take()
+    {
+        std::optional<T> out;
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            out.swap(m_slot);
+        }
+        if (out) {
+            m_delivered.fetch_add(1, std::memory_order_relaxed);
+        }
+        return out;
+    }
+
+    /// Discard a pending value without counting it as delivered.
+    void clear()
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_slot.reset();
+    }
+
+    [[nodiscard]] MailboxStats stats() const
+    {
+        MailboxStats s;
+        s.published  = m_published.load(std::memory_order_relaxed);
+        s.delivered  = m_delivered.load(std::memory_order_relaxed);
+        s.superseded = m_superseded.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    mutable std::mutex    m_mutex;
+    std::optional<T>      m_slot;
+
+    std::atomic<uint64_t> m_published{0};
+    std::atomic<uint64_t> m_delivered{0};
+    std::atomic<uint64_t> m_superseded{0};
+};
+
+} // namespace hmi
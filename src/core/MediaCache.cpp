@@ -0,0 +1,293 @@
+// src/core/MediaCache.cpp
+//
+// Implementation of MediaCache – see MediaCache.h.
+
+#include "MediaCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <vector>
+
+namespace hmi {
+
+namespace {
+
+/// Only well-formed digests become file names (no path tricks via mediaId).
+bool isSha256(const QString& key)
+{
+    if (key.size() != 64) {
+        return false;
+    }
+    for (QChar c : key) {
+        const bool hex = (c >= QLatin1Char('0') && c <= QLatin1Char('9'))
+                      || (c >= QLatin1Char('a') && c <= QLatin1Char('f'));
+        if (!hex) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString normalized(const QString& sha256)
+{
+    return sha256.trimmed().toLower();
+}
+
+} // anonymous namespace
+
+// ===========================================================================
+// Lifetime
+// ===========================================================================
+
+MediaCache::MediaCache(const QString& rootDir, qint64 maxDiskBytes, QObject* parent)
+    : QObject(parent)
+    , m_root(rootDir.isEmpty()
+                 ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                       + QStringLiteral("/media")
+                 : rootDir)
+    , m_maxDiskBytes(std::max<qint64>(0, maxDiskBytes))
+    , m_pixmaps(kDefaultMaxPixmapCostKb)
+{
+    m_io.setMaxThreadCount(1);
+    QDir().mkpath(m_root);
+    scanDisk();
+    evict();
+}
+
+MediaCache::~MediaCache()
+{
+    m_io.waitForDone();
+}
+
+QString MediaCache::keyFor(const MediaRef& media)
+{
+    const QString sha = normalized(media.sha256);
+    return sha.isEmpty() ? QStringLiteral("media:") + media.mediaId : sha;
+}
+
+QString MediaCache::pathFor(const QString& sha256) const
+{
+    return m_root + QLatin1Char('/') + sha256.left(2) + QLatin1Char('/') + sha256;
+}
+
+void MediaCache::setMaxDiskBytes(qint64 bytes)
+{
+    m_maxDiskBytes = std::max<qint64>(0, bytes);
+    evict();
+}
+
+void MediaCache::setMaxPixmapCostKb(int kb)
+{
+    m_pixmaps.setMaxCost(std::max(0, kb));
+}
+
+// ---------------------------------------------------------------------------
+// scanDisk – rebuild the LRU index from the files left by earlier sessions.
+// ---------------------------------------------------------------------------
+void MediaCache::scanDisk()
+{
+    struct Found {
+        QString sha256;
+        qint64  size;
+        qint64  mtime;
+    };
+    std::vector<Found> found;
+
+    QDirIterator it(m_root, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fi = it.fileInfo();
+        if (!isSha256(fi.fileName())) {
+            // Leftover of an interrupted QSaveFile or a foreign file.
+            QFile::remove(fi.absoluteFilePath());
+            continue;
+        }
+        found.push_back({ fi.fileName(), fi.size(),
+                          fi.lastModified().toMSecsSinceEpoch() });
+    }
+
+    std::sort(found.begin(), found.end(),
+              [](const Found& a, const Found& b) { return a.mtime > b.mtime; });
+
+    for (const Found& f : found) {
+        m_lru.push_back({ f.sha256, f.size });
+        m_index.insert(f.sha256, std::prev(m_lru.end()));
+        m_diskBytes += f.size;
+    }
+}
+
+// ===========================================================================
+// Disk tier
+// ===========================================================================
+
+bool MediaCache::containsOnDisk(const QString& sha256) const
+{
+    return m_index.contains(normalized(sha256));
+}
+
+bool MediaCache::load(const QString& sha256)
+{
+    const QString key = normalized(sha256);
+    auto found = m_index.constFind(key);
+    if (found == m_index.constEnd()) {
+        ++m_stats.diskMisses;
+        return false;
+    }
+    touch(found.value());
+
+    const QString path = pathFor(key);
+    m_io.start([this, key, path]() {
+        QByteArray data;
+        bool ok = false;
+
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly)) {
+            data = file.readAll();
+            ok = QCryptographicHash::hash(data, QCryptographicHash::Sha256)
+                     .toHex() == key.toLatin1();
+            // Persist the LRU position for the next session.
+            file.setFileTime(QDateTime::currentDateTime(),
+                             QFileDevice::FileModificationTime);
+        }
+
+        QMetaObject::invokeMethod(this, [this, key, data, ok]() {
+            if (ok) {
+                ++m_stats.diskHits;
+                m_stats.bytesFromDisk += data.size();
+                emit diskLoaded(key, data);
+            } else {
+                ++m_stats.diskMisses;
+                erase(key);
+                emit diskLoaded(key, QByteArray());
+            }
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void MediaCache::store(const QString& sha256, const QByteArray& data)
+{
+    const QString key = normalized(sha256);
+    if (!isSha256(key) || data.isEmpty()) {
+        return;
+    }
+
+    auto found = m_index.constFind(key);
+    if (found != m_index.constEnd()) {
+        touch(found.value());
+        return;
+    }
+
+    m_lru.push_front({ key, data.size() });
+    m_index.insert(key, m_lru.begin());
+    m_diskBytes += data.size();
+    ++m_stats.stores;
+
+    const QString path = pathFor(key);
+    m_io.start([path, data]() {
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        // QSaveFile writes to a temporary and renames on commit, so a crash
+        // never leaves a truncated entry under a valid name.
+        QSaveFile file(path);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(data);
+            file.commit();
+        }
+    });
+
+    evict();
+}
+
+void MediaCache::clear()
+{
+    m_lru.clear();
+    m_index.clear();
+    m_diskBytes = 0;
+    m_pixmaps.clear();
+
+    const QString root = m_root;
+    m_io.start([root]() {
+        QDir dir(root);
+        dir.removeRecursively();
+        QDir().mkpath(root);
+    });
+}
+
+void MediaCache::touch(LruList::iterator it)
+{
+    m_lru.splice(m_lru.begin(), m_lru, it);
+}
+
+void MediaCache::erase(const QString& sha256)
+{
+    auto found = m_index.find(sha256);
+    if (found == m_index.end()) {
+        return;
+    }
+    m_diskBytes -= found.value()->size;
+    m_lru.erase(found.value());
+    m_index.erase(found);
+
+    const QString path = pathFor(sha256);
+    m_io.start([path]() { QFile::remove(path); });
+}
+
+void MediaCache::evict()
+{
+    while (m_diskBytes > m_maxDiskBytes && !m_lru.empty()) {
+        ++m_stats.evictions;
+        erase(m_lru.back().sha256);
+    }
+}
+
+// ===========================================================================
+// Memory tier
+// ===========================================================================
+
+QPixmap MediaCache::pixmap(const QString& key)
+{
+    if (const QPixmap* p = m_pixmaps.object(key)) {
+        ++m_stats.pixmapHits;
+        return *p;
+    }
+    ++m_stats.pixmapMisses;
+    return QPixmap();
+}
+
+void MediaCache::insertPixmap(const QString& key, const QPixmap& pixmap)
+{
+    if (pixmap.isNull()) {
+        return;
+    }
+    const qint64 bytes = static_cast<qint64>(pixmap.width()) * pixmap.height()
+                       * pixmap.depth() / 8;
+    const qsizetype costKb = std::max<qsizetype>(1, bytes / 1024);
+    m_pixmaps.insert(key, new QPixmap(pixmap), costKb);
+}
+
+// ===========================================================================
+// Statistics
+// ===========================================================================
+
+MediaCacheStats MediaCache::stats() const
+{
+    MediaCacheStats s = m_stats;
+    s.diskBytes   = m_diskBytes;
+    s.diskEntries = static_cast<int>(m_index.size());
+    return s;
+}
+
+void MediaCache::resetStats()
+{
+    m_stats = MediaCacheStats();
+}
+
+} // namespace hmi
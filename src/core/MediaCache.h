@@ -0,0 +1,143 @@
+// src/core/MediaCache.h
+//
+// MediaCache – persistent, content-addressed cache for DownloadMedia
+// payloads, plus a memory tier of decoded pixmaps.
+//
+// Disk tier
+// ---------
+// Payloads are stored under <root>/<sha[0..1]>/<sha256> and looked up by
+// MediaRef::sha256, so the same image is never downloaded twice, across HMI
+// restarts and across tasks.  The tier is an LRU bounded by maxDiskBytes();
+// file modification times carry the LRU order across restarts.  Reads are
+// re-hashed, and a corrupt entry is dropped and reported as a miss.
+//
+// All file I/O runs on one private I/O thread.  Because it is a single
+// thread, a read queued after a store or an eviction of the same entry sees
+// the result of that operation.  The index itself is only touched on the
+// owning (main) thread.
+//
+// Memory tier
+// -----------
+// A QCache of decoded QPixmaps keyed by keyFor(MediaRef), bounded by
+// decoded size.  It lets views drop their own copies of full images.
+//
+// Thread safety: main-thread only, like the widgets that use it.
+
+#pragma once
+
+#include "Types.h"
+
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QObject>
+#include <QPixmap>
+#include <QString>
+#include <QThreadPool>
+
+#include <cstdint>
+#include <list>
+
+namespace hmi {
+
+/// Hit/miss counters of a MediaCache.
+struct MediaCacheStats {
+    uint64_t pixmapHits    = 0;   ///< pixmap() found a decoded image.
+    uint64_t pixmapMisses  = 0;
+    uint64_t diskHits      = 0;   ///< load() delivered a verified payload.
+    uint64_t diskMisses    = 0;   ///< Not cached, or dropped as corrupt.
+    uint64_t stores        = 0;   ///< Payloads written to the disk tier.
+    uint64_t evictions     = 0;   ///< Entries removed to honour the size cap.
+    qint64   bytesFromDisk = 0;   ///< Download volume saved by disk hits.
+    qint64   diskBytes     = 0;   ///< Current disk tier size.
+    int      diskEntries   = 0;
+};
+
+class MediaCache : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr qint64 kDefaultMaxDiskBytes   = 2LL * 1024 * 1024 * 1024;
+    static constexpr int    kDefaultMaxPixmapCostKb = 256 * 1024;
+
+    /// \a rootDir empty → <CacheLocation>/media.  Scans the existing entries
+    /// synchronously to rebuild the LRU index.
+    explicit MediaCache(const QString& rootDir = {},
+                        qint64 maxDiskBytes = kDefaultMaxDiskBytes,
+                        QObject* parent = nullptr);
+
+    /// Waits for pending disk I/O.
+    ~MediaCache() override;
+
+    /// Cache key of \a media: its lower-case sha256, or the mediaId when the
+    /// gateway did not announce a digest (memory tier only).
+    [[nodiscard]] static QString keyFor(const MediaRef& media);
+
+    [[nodiscard]] QString rootDir() const { return m_root; }
+
+    void setMaxDiskBytes(qint64 bytes);
+    [[nodiscard]] qint64 maxDiskBytes() const noexcept { return m_maxDiskBytes; }
+
+    void setMaxPixmapCostKb(int kb);
+    [[nodiscard]] int maxPixmapCostKb() const { return static_cast<int>(m_pixmaps.maxCost()); }
+
+    // -----------------------------------------------------------------------
+    // Disk tier
+    // -----------------------------------------------------------------------
+
+    [[nodiscard]] bool containsOnDisk(const QString& sha256) const;
+
+    /// Start reading \a sha256 from disk.  Returns false (and counts a miss)
+    /// when it is not cached; otherwise diskLoaded() follows.
+    bool load(const QString& sha256);
+
+    /// Write \a data under \a sha256 and evict down to the size cap.
+    void store(const QString& sha256, const QByteArray& data);
+
+    /// Remove every disk and memory entry.
+    void clear();
+
+    // -----------------------------------------------------------------------
+    // Memory tier
+    // -----------------------------------------------------------------------
+
+    /// Decoded image for \a key, or a null pixmap.
+    [[nodiscard]] QPixmap pixmap(const QString& key);
+    /// Like pixmap() != null, without touching the statistics or LRU order.
+    [[nodiscard]] bool containsPixmap(const QString& key) const { return m_pixmaps.contains(key); }
+    void insertPixmap(const QString& key, const QPixmap& pixmap);
+
+    [[nodiscard]] MediaCacheStats stats() const;
+    void resetStats();
+
+signals:
+    /// Result of load(): \a data is empty when the entry turned out to be
+    /// missing or corrupt (already counted as a miss).
+    void diskLoaded(QString sha256, QByteArray data);
+
+private:
+    struct Entry {
+        QString sha256;
+        qint64  size = 0;
+    };
+    using LruList = std::list<Entry>;   ///< front = most recently used
+
+    [[nodiscard]] QString pathFor(const QString& sha256) const;
+
+    void scanDisk();
+    void touch(LruList::iterator it);
+    void erase(const QString& sha256);
+    void evict();
+
+    QString                             m_root;
+    qint64                              m_maxDiskBytes;
+    qint64                              m_diskBytes = 0;
+    LruList                             m_lru;
+    QHash<QString, LruList::iterator>   m_index;
+
+    QCache<QString, QPixmap>            m_pixmaps;
+    QThreadPool                         m_io;     ///< one thread, ordered I/O
+    MediaCacheStats                     m_stats;
+};
+
+} // namespace hmi
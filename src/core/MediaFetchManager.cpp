@@ -0,0 +1,337 @@
+// src/core/MediaFetchManager.cpp
+//
+// Implementation of MediaFetchManager – see MediaFetchManager.h.
+
+#include "MediaFetchManager.h"
+#include "GatewayClient.h"
+#include "MediaCache.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace hmi {
+
+namespace {
+
+hmi::Result cancelledResult()
+{
+    // Same shape as a cancelled GatewayClient download.
+    return { hmi::ErrorCode::Unspecified, QStringLiteral("Cancelled") };
+}
+
+} // anonymous namespace
+
+MediaFetchManager::MediaFetchManager(GatewayClient* client, QObject* parent)
+    : QObject(parent)
+    , m_client(client)
+{
+    if (client) {
+        connect(client, &GatewayClient::mediaFetched,
+                this, &MediaFetchManager::onMediaFetched);
+        connect(client, &GatewayClient::mediaDownloadProgress,
+                this, &MediaFetchManager::onMediaProgress);
+    }
+}
+
+void MediaFetchManager::setCache(MediaCache* cache)
+{
+    if (m_cache) {
+        disconnect(m_cache, nullptr, this, nullptr);
+    }
+    m_cache = cache;
+    if (cache) {
+        connect(cache, &MediaCache::diskLoaded,
+                this, &MediaFetchManager::onCacheLoaded);
+    }
+}
+
+void MediaFetchManager::setMaxConcurrent(int n)
+{
+    m_maxConcurrent = std::max(1, n);
+    pump();
+}
+
+void MediaFetchManager::setPrefetchHeld(bool held)
+{
+    if (m_prefetchHeld == held) return;
+    m_prefetchHeld = held;
+    if (held && m_client) {
+        for (auto it = m_active.begin(); it != m_active.end(); ++it) {
+            if (it->job.priority != Priority::Prefetch || it->cancelled || it->preempted) {
+                continue;
+            }
+            it->preempted = true;
+            m_client->cancelMediaDownload(it->downloadId);
+        }
+    }
+    pump();
+}
+
+bool MediaFetchManager::isPending(const QString& mediaId) const
+{
+    return m_active.contains(mediaId)
+        || m_cacheReads.contains(mediaId)
+        || indexOf(m_visible, mediaId) >= 0
+        || indexOf(m_prefetch, mediaId) >= 0;
+}
+
+int MediaFetchManager::indexOf(const QList<Job>& queue, const QString& mediaId)
+{
+    for (int i = 0; i < queue.size(); ++i) {
+        if (queue[i].media.mediaId == mediaId) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// request
+// ---------------------------------------------------------------------------
+void MediaFetchManager::request(const hmi::MediaRef& media,
+                                Priority priority,
+                                const hmi::MediaDownloadOptions& options)
+{
+    const QString& id = media.mediaId;
+    if (id.isEmpty()) {
+        return;
+    }
+
+    // Already running: upgrade in place.  A cancel that is still in flight
+    // is turned into a requeue so the request is not lost.
+    auto running = m_active.find(id);
+    if (running != m_active.end()) {
+        if (priority == Priority::Visible) {
+            running->job.priority = Priority::Visible;
+        }
+        if (running->cancelled) {
+            running->cancelled = false;
+            running->preempted = true;
+        }
+        pump();
+        return;
+    }
+
+    auto reading = m_cacheReads.find(id);
+    if (reading != m_cacheReads.end()) {
+        if (priority == Priority::Visible) {
+            reading->priority = Priority::Visible;
+        }
+        return;
+    }
+
+    int idx = indexOf(m_visible, id);
+    if (idx >= 0) {
+        m_visible.move(idx, 0);   // most recent visible request first
+        pump();
+        return;
+    }
+
+    idx = indexOf(m_prefetch, id);
+    if (idx >= 0) {
+        if (priority == Priority::Visible) {
+            Job job = m_prefetch.takeAt(idx);
+            job.priority = Priority::Visible;
+            m_visible.prepend(job);
+            pump();
+        }
+        return;
+    }
+
+    Job job{ media, priority, options };
+
+    // Disk tier first; only in-memory requests can be answered from it.
+    const bool inMemory = options.filePath.isEmpty() && !options.useTempFile;
+    if (m_cache && inMemory && !media.sha256.isEmpty()) {
+        m_cacheReads.insert(id, job);
+        if (m_cache->load(media.sha256)) {
+            return;
+        }
+        m_cacheReads.remove(id);
+    }
+
+    enqueue(job);
+    pump();
+}
+
+void MediaFetchManager::enqueue(const Job& job)
+{
+    if (job.priority == Priority::Visible) {
+        m_visible.prepend(job);
+    } else {
+        m_prefetch.append(job);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// cancel / cancelAll
+// ---------------------------------------------------------------------------
+void MediaFetchManager::cancel(const QString& mediaId)
+{
+    if (m_cacheReads.remove(mediaId) > 0) {
+        MediaPayload payload;
+        payload.mediaId = mediaId;
+        emit fetched(cancelledResult(), payload);
+        return;
+    }
+
+    for (QList<Job>* queue : { &m_visible, &m_prefetch }) {
+        const int idx = indexOf(*queue, mediaId);
+        if (idx >= 0) {
+            queue->removeAt(idx);
+            MediaPayload payload;
+            payload.mediaId = mediaId;
+            emit fetched(cancelledResult(), payload);
+            return;
+        }
+    }
+
+    auto running = m_active.find(mediaId);
+    if (running != m_active.end() && !running->cancelled) {
+        running->cancelled = true;
+        running->preempted = false;
+        if (m_client) {
+            m_client->cancelMediaDownload(running->downloadId);
+        }
+    }
+}
+
+void MediaFetchManager::cancelAll()
+{
+    QList<Job> dropped = m_visible + m_prefetch + m_cacheReads.values();
+    m_visible.clear();
+    m_prefetch.clear();
+    m_cacheReads.clear();
+
+    for (auto it = m_active.begin(); it != m_active.end(); ++it) {
+        if (it->cancelled) { continue; }
+        it->cancelled = true;
+        it->preempted = false;
+        if (m_client) {
+            m_client->cancelMediaDownload(it->downloadId);
+        }
+    }
+
+    for (const Job& job : dropped) {
+        MediaPayload payload;
+        payload.mediaId = job.media.mediaId;
+        emit fetched(cancelledResult(), payload);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// pump – fill free slots, then preempt prefetches for waiting visible jobs.
+// ---------------------------------------------------------------------------
+void MediaFetchManager::pump()
+{
+    while (m_active.size() < m_maxConcurrent
+           && (!m_visible.isEmpty() || (!m_prefetchHeld && !m_prefetch.isEmpty()))) {
+        Job job = !m_visible.isEmpty() ? m_visible.takeFirst()
+                                       : m_prefetch.takeFirst();
+
+        if (!m_client) {
+            MediaPayload payload;
+            payload.mediaId = job.media.mediaId;
+            emit fetched({ hmi::ErrorCode::Unavailable,
+                           QStringLiteral("No gateway client") }, payload);
+            continue;
+        }
+
+        // fetchMedia() reports asynchronously, so the token is recorded
+        // before any completion for it can arrive.
+        const quint64 downloadId = m_client->fetchMedia(job.media, job.options);
+        m_active.insert(job.media.mediaId, Running{ job, downloadId });
+    }
+
+    // Slots that are already being released (cancel or preemption pending).
+    int releasing = 0;
+    for (const Running& run : std::as_const(m_active)) {
+        if (run.cancelled || run.preempted) { ++releasing; }
+    }
+
+    for (auto it = m_active.begin();
+         it != m_active.end() && m_visible.size() > releasing; ++it) {
+        if (it->job.priority != Priority::Prefetch || it->cancelled || it->preempted) {
+            continue;
+        }
+        it->preempted = true;
+        ++releasing;
+        m_client->cancelMediaDownload(it->downloadId);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// GatewayClient signal handlers
+// ---------------------------------------------------------------------------
+void MediaFetchManager::onMediaFetched(const hmi::Result& result,
+                                       const hmi::MediaPayload& payload)
+{
+    auto it = m_active.find(payload.mediaId);
+    if (it == m_active.end() || it->downloadId != payload.downloadId) {
+        return;   // not one of ours
+    }
+    const Running run = it.value();
+    m_active.erase(it);
+
+    if (run.preempted && !result.ok()) {
+        // Yielded its slot; resume ahead of the other queued jobs.
+        if (run.job.priority == Priority::Visible) {
+            m_visible.prepend(run.job);
+        } else {
+            m_prefetch.prepend(run.job);
+        }
+    } else {
+        if (result.ok() && payload.filePath.isEmpty() && m_cache) {
+            m_cache->store(payload.sha256, payload.data);
+        }
+        emit fetched(result, payload);
+        if (result.ok() && payload.filePath.isEmpty()) {
+            emit mediaReady(payload.mediaId, payload.data);
+        }
+    }
+
+    pump();
+}
+
+void MediaFetchManager::onCacheLoaded(const QString& sha256, const QByteArray& data)
+{
+    // Several mediaIds may share one digest; answer all of them.
+    QList<Job> matched;
+    for (auto it = m_cacheReads.begin(); it != m_cacheReads.end();) {
+        if (it->media.sha256.trimmed().compare(sha256, Qt::CaseInsensitive) == 0) {
+            matched.append(it.value());
+            it = m_cacheReads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const Job& job : matched) {
+        if (data.isEmpty()) {
+            enqueue(job);   // missing or corrupt on disk – download it
+            continue;
+        }
+        MediaPayload payload;
+        payload.mediaId   = job.media.mediaId;
+        payload.data      = data;
+        payload.sizeBytes = data.size();
+        payload.sha256    = sha256;
+        emit fetched({ hmi::ErrorCode::Ok, QString() }, payload);
+        emit mediaReady(payload.mediaId, payload.data);
+    }
+
+    pump();
+}
+
+void MediaFetchManager::onMediaProgress(const QString& mediaId,
+                                        qint64 received, qint64 total,
+                                        quint64 downloadId)
+{
+    auto it = m_active.constFind(mediaId);
+    if (it != m_active.constEnd() && it->downloadId == downloadId
+        && !it->preempted && !it->cancelled) {
+        emit progress(mediaId, received, total);
+    }
+}
+
+} // namespace hmi
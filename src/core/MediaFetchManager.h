@@ -0,0 +1,143 @@
+// src/core/MediaFetchManager.h
+//
+// MediaFetchManager – schedules DownloadMedia transfers on a GatewayClient.
+//
+// Requests are deduplicated per mediaId and queued by priority:
+//   - Visible:  the image the operator is looking at right now.  The most
+//               recent visible request is served first (LIFO), so clicking
+//               through the gallery always favours the last click.
+//   - Prefetch: neighbours that are likely to be opened next (FIFO).
+//
+// Each running download is tracked by its GatewayClient token, so several
+// managers on one client (gallery, exporter) never act on each other's
+// streams even for the same mediaId.
+//
+// At most maxConcurrent() streams run in parallel.  When every slot is busy
+// and a visible request is waiting, one running prefetch is cancelled and
+// put back at the head of the prefetch queue.  setPrefetchHeld() does the
+// same to every running prefetch and starts no new one until it is released,
+// so a congested link is left to control / status traffic and visible images
+// (BandwidthGovernor).
+//
+// With a MediaCache attached (setCache()), in-memory requests whose
+// MediaRef carries a sha256 are served from the disk tier first and only
+// fall through to the gateway on a miss; verified downloads are stored.
+//
+// Thread safety: main-thread only (the manager lives next to the widgets and
+// reacts to GatewayClient signals delivered on the main thread).
+
+#pragma once
+
+#include "Types.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+namespace hmi {
+
+class GatewayClient;
+class MediaCache;
+
+class MediaFetchManager : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Priority {
+        Visible  = 0,
+        Prefetch = 1,
+    };
+    Q_ENUM(Priority)
+
+    explicit MediaFetchManager(GatewayClient* client, QObject* parent = nullptr);
+
+    /// Serve and store payloads through \a cache (may be null).
+    void setCache(MediaCache* cache);
+    [[nodiscard]] MediaCache* cache() const { return m_cache; }
+
+    /// Number of parallel DownloadMedia streams (default 3, minimum 1).
+    void setMaxConcurrent(int n);
+    [[nodiscard]] int maxConcurrent() const noexcept { return m_maxConcurrent; }
+
+    /// Hold prefetches: running ones are preempted and requeued, queued ones
+    /// wait until the hold is released.  Visible requests are unaffected.
+    void setPrefetchHeld(bool held);
+    [[nodiscard]] bool isPrefetchHeld() const noexcept { return m_prefetchHeld; }
+
+    [[nodiscard]] int activeCount() const { return m_active.size(); }
+    [[nodiscard]] int pendingCount() const
+    {
+        return m_visible.size() + m_prefetch.size() + m_cacheReads.size();
+    }
+
+    /// True while \a mediaId is queued or being downloaded.
+    [[nodiscard]] bool isPending(const QString& mediaId) const;
+
+public slots:
+    /// Queue \a media.  A repeated request for a queued or running mediaId is
+    /// merged; it can only raise the priority, never lower it.
+    void request(const hmi::MediaRef& media,
+                 hmi::MediaFetchManager::Priority priority = Priority::Visible,
+                 const hmi::MediaDownloadOptions& options = {});
+
+    /// Drop \a mediaId from the queue or cancel its running download.
+    void cancel(const QString& mediaId);
+
+    /// Drop every queued request and cancel every running download.
+    void cancelAll();
+
+signals:
+    /// Emitted for every finished request (ok, failed or cancelled).
+    void fetched(hmi::Result result, hmi::MediaPayload payload);
+
+    /// Convenience: successful in-memory downloads only.
+    void mediaReady(QString mediaId, QByteArray data);
+
+    /// Forwarded GatewayClient progress for downloads owned by this manager.
+    void progress(QString mediaId, qint64 receivedBytes, qint64 totalBytes);
+
+private slots:
+    void onMediaFetched(const hmi::Result& result, const hmi::MediaPayload& payload);
+    void onMediaProgress(const QString& mediaId, qint64 received, qint64 total,
+                         quint64 downloadId);
+    void onCacheLoaded(const QString& sha256, const QByteArray& data);
+
+private:
+    struct Job {
+        MediaRef             media;
+        Priority             priority = Priority::Visible;
+        MediaDownloadOptions options;
+    };
+
+    struct Running {
+        Job     job;
+        quint64 downloadId = 0;      ///< GatewayClient::fetchMedia() token
+        bool    cancelled = false;   ///< cancel() – report, don't retry
+        bool    preempted = false;   ///< yielded to a visible request – requeue
+    };
+
+    /// Put \a job into its priority queue.
+    void enqueue(const Job& job);
+
+    /// Index of \a mediaId in \a queue, or -1.
+    static int indexOf(const QList<Job>& queue, const QString& mediaId);
+
+    /// Start queued jobs while slots are free; preempt a prefetch if a
+    /// visible job is still waiting afterwards.
+    void pump();
+
+    QPointer<GatewayClient>  m_client;
+    QPointer<MediaCache>     m_cache;
+    int                      m_maxConcurrent = 3;
+    bool                     m_prefetchHeld  = false;
+
+    QList<Job>               m_visible;    ///< front = next to start
+    QList<Job>               m_prefetch;   ///< front = next to start
+    QHash<QString, Running>  m_active;     ///< keyed by mediaId
+    QHash<QString, Job>      m_cacheReads; ///< disk-tier lookups, by mediaId
+};
+
+} // namespace hmi
@@ -0,0 +1,173 @@
+// src/core/MediaSink.cpp
+//
+// Implementation of MediaSink – see MediaSink.h.
+
+#include "MediaSink.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace hmi {
+
+namespace {
+
+// Growth step when the announced size is unknown or too small.
+constexpr qint64 kMinGrowBytes = 1 * 1024 * 1024;
+
+} // anonymous namespace
+
+MediaSink::MediaSink(const QString& filePath)
+    : m_path(filePath)
+{
+}
+
+MediaSink::~MediaSink()
+{
+    unmap();
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// open
+// ---------------------------------------------------------------------------
+bool MediaSink::open(qint64 expectedSize)
+{
+    m_written = 0;
+    m_hash.reset();
+    m_error.clear();
+
+    if (!isFileSink()) {
+        if (expectedSize > 0) {
+            // Qt 6: resize() leaves the new bytes uninitialised.
+            m_buffer.resize(expectedSize);
+            m_capacity = expectedSize;
+        }
+        return true;
+    }
+
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        m_error = QStringLiteral("Cannot open %1: %2").arg(m_path, m_file.errorString());
+        return false;
+    }
+    return expectedSize > 0 ? resizeFile(expectedSize) : true;
+}
+
+// ---------------------------------------------------------------------------
+// append
+// ---------------------------------------------------------------------------
+bool MediaSink::append(const char* data, qint64 size)
+{
+    if (size <= 0) { return true; }
+
+    m_hash.addData(data, size);
+
+    if (m_written + size > m_capacity && !reserve(m_written + size)) {
+        return false;
+    }
+
+    char* dst = isFileSink() ? reinterpret_cast<char*>(m_map) : m_buffer.data();
+    std::memcpy(dst + m_written, data, static_cast<std::size_t>(size));
+    m_written += size;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// finish
+// ---------------------------------------------------------------------------
+bool MediaSink::finish()
+{
+    if (!isFileSink()) {
+        m_buffer.resize(m_written);
+        // Give back a grossly over-announced preallocation.
+        if (m_buffer.capacity() > m_written + m_written / 4 + kMinGrowBytes) {
+            m_buffer.squeeze();
+        }
+        return true;
+    }
+
+    unmap();
+    if (!m_file.resize(m_written)) {
+        m_error = QStringLiteral("Cannot truncate %1: %2").arg(m_path, m_file.errorString());
+        m_file.close();
+        return false;
+    }
+    m_file.close();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// discard
+// ---------------------------------------------------------------------------
+void MediaSink::discard()
+{
+    m_buffer = QByteArray();
+    m_capacity = 0;
+    m_written  = 0;
+    if (isFileSink()) {
+        unmap();
+        if (m_file.isOpen()) {
+            m_file.close();
+        }
+        QFile::remove(m_path);
+    }
+}
+
+QString MediaSink::sha256Hex() const
+{
+    return QString::fromLatin1(m_hash.result().toHex());
+}
+
+QByteArray MediaSink::takeData()
+{
+    m_capacity = 0;
+    return std::move(m_buffer);
+}
+
+// ---------------------------------------------------------------------------
+// reserve – grow capacity to at least `needed`, amortised.
+// ---------------------------------------------------------------------------
+bool MediaSink::reserve(qint64 needed)
+{
+    const qint64 target = std::max({needed, m_capacity + m_capacity / 2,
+                                    m_capacity + kMinGrowBytes});
+
+    if (!isFileSink()) {
+        m_buffer.resize(target);
+        m_capacity = target;
+        return true;
+    }
+
+    return resizeFile(target);
+}
+
+// ---------------------------------------------------------------------------
+// resizeFile – set the file to exactly `size` bytes and map all of it.
+// ---------------------------------------------------------------------------
+bool MediaSink::resizeFile(qint64 size)
+{
+    unmap();
+    if (!m_file.resize(size)) {
+        m_error = QStringLiteral("Cannot resize %1: %2").arg(m_path, m_file.errorString());
+        return false;
+    }
+    m_map = m_file.map(0, size);
+    if (!m_map) {
+        m_error = QStringLiteral("Cannot map %1: %2").arg(m_path, m_file.errorString());
+        return false;
+    }
+    m_capacity = size;
+    return true;
+}
+
+void MediaSink::unmap()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+}
+
+} // namespace hmi
@@ -0,0 +1,79 @@
+// src/core/MediaSink.h
+//
+// MediaSink – destination for a streamed DownloadMedia payload.
+//
+// Two modes:
+//   - memory: chunks are copied into one QByteArray that is preallocated from
+//     the expected size, so the buffer is never reallocated for a correctly
+//     announced MediaRef::sizeBytes.  The finished buffer is handed out by
+//     move (implicitly shared from then on).
+//   - file:   chunks are written straight into a memory-mapped file that is
+//     pre-sized to the expected size and truncated to the received size on
+//     finish().  Nothing but the current chunk is ever held in RAM.
+//
+// A SHA-256 digest is accumulated incrementally while chunks arrive.
+//
+// Thread safety: a MediaSink is driven by exactly one thread at a time (the
+// RPC poller thread executing the download).
+
+#pragma once
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QString>
+
+namespace hmi {
+
+class MediaSink {
+public:
+    /// \a filePath empty → memory sink; otherwise the payload is written to
+    /// \a filePath (created or truncated).
+    explicit MediaSink(const QString& filePath = {});
+    ~MediaSink();
+
+    MediaSink(const MediaSink&)            = delete;
+    MediaSink& operator=(const MediaSink&) = delete;
+
+    /// Prepare the sink for a payload of roughly \a expectedSize bytes
+    /// (0 when unknown).  Returns false and sets errorString() on failure.
+    bool open(qint64 expectedSize);
+
+    /// Append one chunk.  Returns false and sets errorString() on failure.
+    bool append(const char* data, qint64 size);
+
+    /// Trim the storage to the bytes actually received and release the
+    /// mapping.  Returns false and sets errorString() on failure.
+    bool finish();
+
+    /// Drop everything received so far; file sinks remove their file.
+    void discard();
+
+    [[nodiscard]] bool    isFileSink() const noexcept { return !m_path.isEmpty(); }
+    [[nodiscard]] QString filePath() const { return m_path; }
+    [[nodiscard]] qint64  bytesWritten() const noexcept { return m_written; }
+    [[nodiscard]] QString errorString() const { return m_error; }
+
+    /// Lower-case hex SHA-256 of everything appended so far.
+    [[nodiscard]] QString sha256Hex() const;
+
+    /// Move the in-memory payload out (memory sinks, after finish()).
+    [[nodiscard]] QByteArray takeData();
+
+private:
+    /// Grow the backing storage so that at least \a needed bytes fit.
+    bool reserve(qint64 needed);
+    bool resizeFile(qint64 size);
+    void unmap();
+
+    QString            m_path;
+    QByteArray         m_buffer;       ///< memory mode storage
+    QFile              m_file;         ///< file mode storage
+    uchar*             m_map      = nullptr;
+    qint64             m_capacity = 0;
+    qint64             m_written  = 0;
+    QCryptographicHash m_hash{QCryptographicHash::Sha256};
+    QString            m_error;
+};
+
+} // namespace hmi
@@ -0,0 +1,344 @@
+// src/core/PlanCache.cpp
+//
+// Implementation of PlanCache – see PlanCache.h.
+
+#include "PlanCache.h"
+
+#include "WaypointRecords.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace hmi {
+
+namespace {
+
+constexpr char     kMagic[8] = {'H', 'M', 'I', 'P', 'L', 'A', 'N', '1'};
+constexpr uint32_t kVersion  = 1;
+
+struct EntryHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordBytes;      ///< sizeof(WaypointRecord) of the writer
+    uint64_t revision;
+    uint64_t waypointCount;
+    uint64_t metaOffset;
+    uint64_t metaBytes;
+    uint64_t recordsOffset;
+};
+
+uint64_t hashRecords(const std::vector<WaypointRecord>& records, const QStringList& strings)
+{
+    uint64_t h = kFnv1aBasis;
+    h = fnv1a64(h, records.data(), records.size() * sizeof(WaypointRecord));
+    for (const QString& s : strings) {
+        h = fnv1a64(h, s.constData(), static_cast<std::size_t>(s.size()) * sizeof(QChar));
+        h = fnv1a64(h, "\0", 1);
+    }
+    return h != 0 ? h : 1;
+}
+
+QByteArray encodeMeta(const GetPlanResponse& plan, const QStringList& strings)
+{
+    QByteArray meta;
+    QDataStream out(&meta, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << plan.planId << plan.modelId << plan.taskName << plan.createdAt
+        << plan.path.totalPoints << plan.path.estimatedDistanceM
+        << plan.path.estimatedDurationS;
+    const PlanOptions& o = plan.options;
+    out << o.candidateRadiusM << o.candidateYawStepDeg << o.enableCollisionCheck
+        << o.enableTspOptimization << o.ikSolver
+        << o.weights.wAgvDistance << o.weights.wJointDelta << o.weights.wManipulability
+        << o.weights.wViewError << o.weights.wJointLimit;
+    const PlanningStatistics& s = plan.stats;
+    out << s.candidatePoseCount << s.ikSuccessCount << s.collisionFilteredCount
+        << s.planningTimeMs;
+    out << strings;
+    return meta;
+}
+
+bool decodeMeta(const QByteArray& meta, GetPlanResponse* plan, QStringList* strings)
+{
+    QDataStream in(meta);
+    in.setVersion(QDataStream::Qt_6_0);
+    in >> plan->planId >> plan->modelId >> plan->taskName >> plan->createdAt
+       >> plan->path.totalPoints >> plan->path.estimatedDistanceM
+       >> plan->path.estimatedDurationS;
+    PlanOptions& o = plan->options;
+    in >> o.candidateRadiusM >> o.candidateYawStepDeg >> o.enableCollisionCheck
+       >> o.enableTspOptimization >> o.ikSolver
+       >> o.weights.wAgvDistance >> o.weights.wJointDelta >> o.weights.wManipulability
+       >> o.weights.wViewError >> o.weights.wJointLimit;
+    PlanningStatistics& s = plan->stats;
+    in >> s.candidatePoseCount >> s.ikSuccessCount >> s.collisionFilteredCount
+       >> s.planningTimeMs;
+    in >> *strings;
+    return in.status() == QDataStream::Ok;
+}
+
+/// An open, validated entry: header and metadata read, records mapped.
+struct OpenEntry {
+    QFile                 file;
+    EntryHeader           header{};
+    PlanCacheEntry        meta;
+    QStringList           strings;
+    const WaypointRecord* records = nullptr;
+
+    explicit OpenEntry(const QString& path) : file(path) {}
+
+    bool open(bool mapRecords)
+    {
+        if (!file.open(QIODevice::ReadOnly)) return false;
+        const qint64 size = file.size();
+        if (file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                != static_cast<qint64>(sizeof(header))
+            || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+            || header.version != kVersion
+            || header.recordBytes != sizeof(WaypointRecord)) {
+            return false;
+        }
+        const uint64_t recordsEnd =
+            header.recordsOffset + header.waypointCount * sizeof(WaypointRecord);
+        if (header.metaOffset + header.metaBytes > static_cast<uint64_t>(size)
+            || recordsEnd > static_cast<uint64_t>(size)
+            || header.waypointCount > uint64_t(INT32_MAX)) {
+            return false;
+        }
+
+        if (!file.seek(static_cast<qint64>(header.metaOffset))) return false;
+        const QByteArray metaBytes = file.read(static_cast<qint64>(header.metaBytes));
+        if (metaBytes.size() != static_cast<qint64>(header.metaBytes)
+            || !decodeMeta(metaBytes, &meta.plan, &strings)) {
+            return false;
+        }
+        meta.revision      = header.revision;
+        meta.waypointCount = static_cast<int>(header.waypointCount);
+        meta.plan.result   = { ErrorCode::Ok, {} };
+        meta.plan.revision = header.revision;
+
+        if (mapRecords && header.waypointCount > 0) {
+            const uchar* base = file.map(0, size);
+            if (!base) return false;
+            records = reinterpret_cast<const WaypointRecord*>(base + header.recordsOffset);
+        }
+        return true;
+    }
+
+    /// Refresh the LRU position.
+    void touch()
+    {
+        file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    }
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// Lifetime
+// ===========================================================================
+
+PlanCache::PlanCache(const QString& rootDir, qint64 maxBytes)
+    : m_root(rootDir.isEmpty()
+                 ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                       + QStringLiteral("/plans")
+                 : rootDir)
+    , m_maxBytes(std::max<qint64>(0, maxBytes))
+{
+    QDir().mkpath(m_root);
+}
+
+QString PlanCache::entryPath(const QString& planId) const
+{
+    const QByteArray key =
+        QCryptographicHash::hash(planId.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_root + QLatin1Char('/') + QString::fromLatin1(key) + QStringLiteral(".plan");
+}
+
+// ===========================================================================
+// Lookup
+// ===========================================================================
+
+uint64_t PlanCache::revision(const QString& planId) const
+{
+    const auto e = entry(planId);
+    return e ? e->revision : 0;
+}
+
+std::optional<PlanCacheEntry> PlanCache::entry(const QString& planId) const
+{
+    if (planId.isEmpty()) return std::nullopt;
+    OpenEntry e(entryPath(planId));
+    if (!e.open(/*mapRecords=*/false) || e.meta.plan.planId != planId) {
+        return std::nullopt;
+    }
+    return e.meta;
+}
+
+std::optional<GetPlanResponse> PlanCache::load(const QString& planId) const
+{
+    if (planId.isEmpty()) return std::nullopt;
+    const QString path = entryPath(planId);
+    OpenEntry e(path);
+    if (!e.open(/*mapRecords=*/true) || e.meta.plan.planId != planId) {
+        if (e.file.exists()) remove(planId);   // corrupt or a hash collision
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    GetPlanResponse plan = std::move(e.meta.plan);
+    plan.path.waypoints.reserve(e.meta.waypointCount);
+    for (int i = 0; i < e.meta.waypointCount; ++i) {
+        plan.path.waypoints.append(decodeWaypoint(e.records[i], e.strings));
+    }
+    e.touch();
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    m_bytesRead.fetch_add(qint64(e.meta.waypointCount) * qint64(sizeof(WaypointRecord)),
+                          std::memory_order_relaxed);
+    return plan;
+}
+
+bool PlanCache::readWaypoints(const QString& planId, int first, int count,
+                              QVector<InspectionPoint>* out) const
+{
+    if (planId.isEmpty()) return false;
+    OpenEntry e(entryPath(planId));
+    if (!e.open(/*mapRecords=*/true) || e.meta.plan.planId != planId) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const int begin = std::clamp(first, 0, e.meta.waypointCount);
+    const int end   = std::clamp(first + std::max(0, count), begin, e.meta.waypointCount);
+    out->clear();
+    out->reserve(end - begin);
+    for (int i = begin; i < end; ++i) {
+        out->append(decodeWaypoint(e.records[i], e.strings));
+    }
+    e.touch();
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    m_bytesRead.fetch_add(qint64(end - begin) * qint64(sizeof(WaypointRecord)),
+                          std::memory_order_relaxed);
+    return true;
+}
+
+// ===========================================================================
+// Store
+// ===========================================================================
+
+uint64_t PlanCache::contentRevision(const InspectionPath& path)
+{
+    RecordStringTable strings;
+    const std::vector<WaypointRecord> records = encodeWaypoints(path, strings);
+    return hashRecords(records, strings.strings());
+}
+
+bool PlanCache::store(const GetPlanResponse& plan, uint64_t revision) const
+{
+    if (plan.planId.isEmpty()) return false;
+
+    RecordStringTable strings;
+    const std::vector<WaypointRecord> records = encodeWaypoints(plan.path, strings);
+    const QByteArray meta = encodeMeta(plan, strings.strings());
+
+    EntryHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version       = kVersion;
+    h.recordBytes   = sizeof(WaypointRecord);
+    h.revision      = revision != 0 ? revision : hashRecords(records, strings.strings());
+    h.waypointCount = records.size();
+    h.metaOffset    = sizeof(EntryHeader);
+    h.metaBytes     = static_cast<uint64_t>(meta.size());
+    // Records start 8-byte aligned so the mapped array can be read in place.
+    h.recordsOffset = (h.metaOffset + h.metaBytes + 7) / 8 * 8;
+
+    QSaveFile out(entryPath(plan.planId));
+    if (!out.open(QIODevice::WriteOnly)) return false;
+    const qint64 pad = static_cast<qint64>(h.recordsOffset - h.metaOffset - h.metaBytes);
+    const qint64 recordBytes = static_cast<qint64>(records.size() * sizeof(WaypointRecord));
+    bool ok = out.write(reinterpret_cast<const char*>(&h), sizeof(h)) == qint64(sizeof(h))
+           && out.write(meta) == meta.size()
+           && out.write(QByteArray(pad, '\0')) == pad
+           && out.write(reinterpret_cast<const char*>(records.data()), recordBytes) == recordBytes;
+    if (!ok) {
+        out.cancelWriting();
+        return false;
+    }
+    if (!out.commit()) return false;
+
+    m_stores.fetch_add(1, std::memory_order_relaxed);
+    prune();
+    return true;
+}
+
+// ===========================================================================
+// Maintenance
+// ===========================================================================
+
+void PlanCache::remove(const QString& planId) const
+{
+    QFile::remove(entryPath(planId));
+}
+
+void PlanCache::clear() const
+{
+    QDir(m_root).removeRecursively();
+    QDir().mkpath(m_root);
+}
+
+void PlanCache::prune() const
+{
+    struct Found {
+        QString path;
+        qint64  size;
+        qint64  mtime;
+    };
+    std::vector<Found> found;
+    qint64 total = 0;
+
+    QDirIterator it(m_root, {QStringLiteral("*.plan")}, QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fi = it.fileInfo();
+        found.push_back({ fi.absoluteFilePath(), fi.size(),
+                          fi.lastModified().toMSecsSinceEpoch() });
+        total += fi.size();
+    }
+    if (total <= m_maxBytes) return;
+
+    std::sort(found.begin(), found.end(),
+              [](const Found& a, const Found& b) { return a.mtime < b.mtime; });
+    for (const Found& f : found) {
+        if (total <= m_maxBytes) break;
+        if (QFile::remove(f.path)) {
+            total -= f.size;
+            m_evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+PlanCacheStats PlanCache::stats() const
+{
+    PlanCacheStats s;
+    s.hits      = m_hits.load(std::memory_order_relaxed);
+    s.misses    = m_misses.load(std::memory_order_relaxed);
+    s.stores    = m_stores.load(std::memory_order_relaxed);
+    s.evictions = m_evictions.load(std::memory_order_relaxed);
+    s.bytesRead = m_bytesRead.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace hmi
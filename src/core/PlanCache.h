@@ -0,0 +1,113 @@
+// src/core/PlanCache.h
+//
+// PlanCache – on-disk cache of inspection plans, keyed by plan ID.
+//
+// GetPlan and PlanInspection both hand over the whole InspectionPath.
+// Switching to operator mode, restarting the HMI or reopening a task used to
+// fetch and convert the same plan again; GatewayClient now keeps every plan
+// it receives here and getPlan() serves repeat requests from it (see
+// PlanFetchPolicy and docs/proto_extensions.md §4).
+//
+// Each entry carries a content revision: the gateway's plan revision with
+// the proto extensions, otherwise a 64-bit hash of the waypoint records.
+// Without the extensions a plan is treated as immutable once created (a
+// re-plan gets a new plan ID), so a cached copy is served without asking.
+//
+// Entry layout <root>/<sha1(planId)>.plan (native endianness):
+//   header | metadata (QDataStream: IDs, options, stats, string table) |
+//   WaypointRecord[waypointCount] (WaypointRecords.h)
+// Records have a fixed size, with their strings (group / frame / camera IDs)
+// replaced by string-table indices, so readWaypoints() maps the file and
+// decodes only the requested range – a list or a scrubber can page through
+// a large plan without loading all of it.  The directory is an LRU bounded
+// by maxBytes() (file modification times, refreshed on every hit).
+//
+// Thread safety: every method touches only the file system and may be
+// called from any thread, concurrently.  Entries are written with QSaveFile,
+// so a reader sees either the old or the new entry.
+
+#pragma once
+
+#include "Types.h"
+
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace hmi {
+
+/// Everything a cache entry holds except the waypoints.
+struct PlanCacheEntry {
+    GetPlanResponse plan;           ///< path.waypoints empty
+    uint64_t        revision = 0;
+    int             waypointCount = 0;
+};
+
+struct PlanCacheStats {
+    uint64_t hits        = 0;   ///< load() / readWaypoints() served
+    uint64_t misses      = 0;   ///< no entry, or a corrupt one (dropped)
+    uint64_t stores      = 0;
+    uint64_t evictions   = 0;
+    qint64   bytesRead   = 0;   ///< waypoint bytes decoded from disk
+};
+
+class PlanCache
+{
+public:
+    static constexpr qint64 kDefaultMaxBytes = qint64(256) << 20;   // 256 MiB
+
+    /// \a rootDir empty → <CacheLocation>/plans.
+    explicit PlanCache(const QString& rootDir = QString(),
+                       qint64 maxBytes = kDefaultMaxBytes);
+
+    QString rootDir() const { return m_root; }
+    qint64  maxBytes() const { return m_maxBytes; }
+
+    /// Revision of the cached copy of \a planId, 0 when there is none.
+    uint64_t revision(const QString& planId) const;
+
+    /// Header and metadata only (cheap: no waypoint is decoded).
+    std::optional<PlanCacheEntry> entry(const QString& planId) const;
+
+    /// The whole plan, or nullopt on a miss.
+    std::optional<GetPlanResponse> load(const QString& planId) const;
+
+    /// Waypoints [first, first + count) of \a planId, clamped to the plan.
+    /// Returns false on a miss.
+    bool readWaypoints(const QString& planId, int first, int count,
+                       QVector<InspectionPoint>* out) const;
+
+    /// Store \a plan under \a revision (0: use contentRevision()).  Returns
+    /// false when the write failed.
+    bool store(const GetPlanResponse& plan, uint64_t revision = 0) const;
+
+    void remove(const QString& planId) const;
+
+    /// Remove every entry.
+    void clear() const;
+
+    PlanCacheStats stats() const;
+
+    /// Content hash of \a path's waypoints (never 0).
+    static uint64_t contentRevision(const InspectionPath& path);
+
+private:
+    QString m_root;
+    qint64  m_maxBytes;
+
+    mutable std::atomic<uint64_t> m_hits{0};
+    mutable std::atomic<uint64_t> m_misses{0};
+    mutable std::atomic<uint64_t> m_stores{0};
+    mutable std::atomic<uint64_t> m_evictions{0};
+    mutable std::atomic<qint64>   m_bytesRead{0};
+
+    QString entryPath(const QString& planId) const;
+
+    /// Drop the least recently used entries until under maxBytes().
+    void prune() const;
+};
+
+} // namespace hmi
@@ -0,0 +1,597 @@
+// src/core/ProjectFile.cpp
+//
+// Implementation of ProjectFile – see ProjectFile.h.
+
+#include "ProjectFile.h"
+
+#include "WaypointRecords.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QStringList>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace hmi {
+
+namespace {
+
+constexpr char     kMagic[8]    = {'H', 'M', 'I', 'P', 'R', 'O', 'J', '1'};
+constexpr uint32_t kVersion     = 1;
+constexpr qint64   kPage        = 4096;
+constexpr int      kSlotCount   = 2;
+constexpr qint64   kDataStart   = kSlotCount * kPage;
+constexpr int      kZlibLevel   = 6;
+
+enum Section : int {
+    Meta = 0,
+    TargetColumns,
+    TargetStrings,
+    PlanIndex,
+    PlanRecords,
+    SectionCount
+};
+
+enum SectionFlags : uint32_t {
+    Compressed = 1u << 0,   ///< qCompress()ed; rawBytes is the inflated size
+};
+
+struct SectionEntry {
+    uint64_t offset;     ///< 0 = empty section
+    uint64_t bytes;      ///< as stored
+    uint64_t rawBytes;
+    uint64_t count;      ///< targets / strings / plans / records
+    uint64_t hash;       ///< FNV-1a of the raw bytes
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct Header {
+    char         magic[8];
+    uint32_t     version;
+    uint32_t     recordBytes;    ///< sizeof(WaypointRecord) of the writer
+    uint64_t     generation;     ///< the higher valid slot wins
+    SectionEntry sections[SectionCount];
+    uint64_t     checksum;       ///< FNV-1a of everything above
+};
+static_assert(std::is_trivially_copyable<Header>::value, "headers are memcpy'd");
+static_assert(sizeof(Header) <= kPage, "a header slot is one page");
+
+qint64 alignUp(qint64 v)
+{
+    return (v + kPage - 1) / kPage * kPage;
+}
+
+uint64_t headerChecksum(const Header& h)
+{
+    return fnv1a64(kFnv1aBasis, &h, offsetof(Header, checksum));
+}
+
+/// Byte offsets of the TargetColumns arrays for \a n targets.
+struct TargetLayout {
+    enum Column {
+        PointId, FaceIndex, Group, Frame, Position, Normal, ViewDirection, Roll,
+        ColumnCount
+    };
+
+    uint64_t offset[ColumnCount];
+    uint64_t total = 0;
+
+    explicit TargetLayout(uint64_t n)
+    {
+        const uint64_t bytes[ColumnCount] = {
+            n * sizeof(int32_t), n * sizeof(uint32_t), n * sizeof(uint32_t),
+            n * sizeof(uint32_t), n * 3 * sizeof(float), n * 3 * sizeof(float),
+            n * 3 * sizeof(float), n * sizeof(double),
+        };
+        for (int c = 0; c < ColumnCount; ++c) {
+            offset[c] = total;
+            total     = (total + bytes[c] + 7) / 8 * 8;
+        }
+    }
+};
+
+/// One section as it will be written.
+struct Encoded {
+    QByteArray stored;
+    uint64_t   rawBytes = 0;
+    uint64_t   count    = 0;
+    uint64_t   hash     = 0;
+    uint32_t   flags    = 0;
+
+    bool sameAs(const SectionEntry& e) const
+    {
+        return e.hash == hash && e.rawBytes == rawBytes && e.count == count && e.flags == flags;
+    }
+};
+
+Encoded rawSection(QByteArray bytes, uint64_t count)
+{
+    Encoded e;
+    e.hash     = fnv1a64(kFnv1aBasis, bytes.constData(), static_cast<std::size_t>(bytes.size()));
+    e.rawBytes = static_cast<uint64_t>(bytes.size());
+    e.count    = count;
+    e.stored   = std::move(bytes);
+    return e;
+}
+
+Encoded compressedSection(const QByteArray& bytes, uint64_t count)
+{
+    Encoded e;
+    e.hash     = fnv1a64(kFnv1aBasis, bytes.constData(), static_cast<std::size_t>(bytes.size()));
+    e.rawBytes = static_cast<uint64_t>(bytes.size());
+    e.count    = count;
+    e.flags    = Compressed;
+    e.stored   = qCompress(bytes, kZlibLevel);
+    return e;
+}
+
+template <typename T>
+void putColumn(QByteArray* bytes, uint64_t offset, const std::vector<T>& column)
+{
+    if (!column.empty()) {
+        std::memcpy(bytes->data() + offset, column.data(), column.size() * sizeof(T));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Section codecs
+// ---------------------------------------------------------------------------
+
+QByteArray encodeMeta(const Project& p)
+{
+    QByteArray meta;
+    QDataStream out(&meta, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << p.modelPath << p.modelSha256 << p.modelBytes;
+    const CaptureConfig& c = p.captureConfig;
+    out << c.cameraId << c.focusDistanceM << c.fovHDeg << c.fovVDeg << c.maxTiltFromNormalDeg;
+    const PlanOptions& o = p.planOptions;
+    out << o.candidateRadiusM << o.candidateYawStepDeg << o.enableCollisionCheck
+        << o.enableTspOptimization << o.ikSolver
+        << o.weights.wAgvDistance << o.weights.wJointDelta << o.weights.wManipulability
+        << o.weights.wViewError << o.weights.wJointLimit;
+    return meta;
+}
+
+bool decodeMeta(const QByteArray& meta, Project* p)
+{
+    QDataStream in(meta);
+    in.setVersion(QDataStream::Qt_6_0);
+    in >> p->modelPath >> p->modelSha256 >> p->modelBytes;
+    CaptureConfig& c = p->captureConfig;
+    in >> c.cameraId >> c.focusDistanceM >> c.fovHDeg >> c.fovVDeg >> c.maxTiltFromNormalDeg;
+    PlanOptions& o = p->planOptions;
+    in >> o.candidateRadiusM >> o.candidateYawStepDeg >> o.enableCollisionCheck
+       >> o.enableTspOptimization >> o.ikSolver
+       >> o.weights.wAgvDistance >> o.weights.wJointDelta >> o.weights.wManipulability
+       >> o.weights.wViewError >> o.weights.wJointLimit;
+    return in.status() == QDataStream::Ok;
+}
+
+QByteArray encodeStrings(const QStringList& strings)
+{
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << strings;
+    return bytes;
+}
+
+void encodeTargets(const QVector<InspectionTarget>& targets,
+                   Encoded* columnsOut, Encoded* stringsOut)
+{
+    const auto n = static_cast<std::size_t>(targets.size());
+    std::vector<int32_t>  pointIds(n);
+    std::vector<uint32_t> faces(n), groups(n), frames(n);
+    std::vector<float>    positions(3 * n), normals(3 * n), views(3 * n);
+    std::vector<double>   rolls(n);
+
+    RecordStringTable strings;
+    for (std::size_t i = 0; i < n; ++i) {
+        const InspectionTarget& t = targets[static_cast<int>(i)];
+        pointIds[i] = t.pointId;
+        faces[i]    = t.surface.faceIndex;
+        groups[i]   = strings.index(t.groupId);
+        frames[i]   = strings.index(t.surface.frameId);
+        for (int k = 0; k < 3; ++k) {
+            positions[3 * i + k] = t.surface.position[k];
+            normals[3 * i + k]   = t.surface.normal[k];
+            views[3 * i + k]     = t.view.viewDirection[k];
+        }
+        rolls[i] = t.view.rollDeg;
+    }
+
+    const TargetLayout layout(n);
+    QByteArray bytes(static_cast<qsizetype>(layout.total), '\0');
+    putColumn(&bytes, layout.offset[TargetLayout::PointId],       pointIds);
+    putColumn(&bytes, layout.offset[TargetLayout::FaceIndex],     faces);
+    putColumn(&bytes, layout.offset[TargetLayout::Group],         groups);
+    putColumn(&bytes, layout.offset[TargetLayout::Frame],         frames);
+    putColumn(&bytes, layout.offset[TargetLayout::Position],      positions);
+    putColumn(&bytes, layout.offset[TargetLayout::Normal],        normals);
+    putColumn(&bytes, layout.offset[TargetLayout::ViewDirection], views);
+    putColumn(&bytes, layout.offset[TargetLayout::Roll],          rolls);
+
+    *columnsOut = rawSection(std::move(bytes), n);
+    *stringsOut = compressedSection(encodeStrings(strings.strings()),
+                                    static_cast<uint64_t>(strings.strings().size()));
+}
+
+/// \a columns is the raw TargetColumns section, 8-byte aligned (mapped).
+bool decodeTargets(const QByteArray& columns, uint64_t n, const QByteArray& stringBytes,
+                   QVector<InspectionTarget>* targets)
+{
+    QStringList strings;
+    QDataStream in(stringBytes);
+    in.setVersion(QDataStream::Qt_6_0);
+    in >> strings;
+    if (in.status() != QDataStream::Ok) return false;
+
+    const TargetLayout layout(n);
+    const char* base = columns.constData();
+    const auto* pointIds  = reinterpret_cast<const int32_t*>(base + layout.offset[TargetLayout::PointId]);
+    const auto* faces     = reinterpret_cast<const uint32_t*>(base + layout.offset[TargetLayout::FaceIndex]);
+    const auto* groups    = reinterpret_cast<const uint32_t*>(base + layout.offset[TargetLayout::Group]);
+    const auto* frames    = reinterpret_cast<const uint32_t*>(base + layout.offset[TargetLayout::Frame]);
+    const auto* positions = reinterpret_cast<const float*>(base + layout.offset[TargetLayout::Position]);
+    const auto* normals   = reinterpret_cast<const float*>(base + layout.offset[TargetLayout::Normal]);
+    const auto* views     = reinterpret_cast<const float*>(base + layout.offset[TargetLayout::ViewDirection]);
+    const auto* rolls     = reinterpret_cast<const double*>(base + layout.offset[TargetLayout::Roll]);
+
+    targets->resize(static_cast<int>(n));
+    InspectionTarget* out = targets->data();
+    for (uint64_t i = 0; i < n; ++i) {
+        InspectionTarget& t = out[i];
+        t.pointId             = pointIds[i];
+        t.groupId             = recordString(strings, groups[i]);
+        t.surface.position    = QVector3D(positions[3 * i], positions[3 * i + 1], positions[3 * i + 2]);
+        t.surface.normal      = QVector3D(normals[3 * i], normals[3 * i + 1], normals[3 * i + 2]);
+        t.surface.frameId     = recordString(strings, frames[i]);
+        t.surface.faceIndex   = faces[i];
+        t.view.viewDirection  = QVector3D(views[3 * i], views[3 * i + 1], views[3 * i + 2]);
+        t.view.rollDeg        = rolls[i];
+    }
+    return true;
+}
+
+void encodePlans(const QVector<ProjectPlan>& plans, Encoded* indexOut, Encoded* recordsOut)
+{
+    RecordStringTable strings;
+    std::vector<WaypointRecord> records;
+
+    QByteArray index;
+    QDataStream out(&index, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << static_cast<quint32>(plans.size());
+    for (const ProjectPlan& plan : plans) {
+        const std::vector<WaypointRecord> planRecords = encodeWaypoints(plan.path, strings);
+        out << plan.planId << plan.taskName << plan.path.totalPoints
+            << plan.path.estimatedDistanceM << plan.path.estimatedDurationS
+            << static_cast<quint64>(records.size()) << static_cast<quint64>(planRecords.size());
+        records.insert(records.end(), planRecords.begin(), planRecords.end());
+    }
+    out << strings.strings();
+
+    *indexOut   = compressedSection(index, static_cast<uint64_t>(plans.size()));
+    *recordsOut = rawSection(QByteArray(reinterpret_cast<const char*>(records.data()),
+                                        static_cast<qsizetype>(records.size() * sizeof(WaypointRecord))),
+                             records.size());
+}
+
+/// \a records is the raw PlanRecords section, 8-byte aligned (mapped).
+bool decodePlans(const QByteArray& index, const QByteArray& records, uint64_t recordCount,
+                 QVector<ProjectPlan>* plans)
+{
+    QDataStream in(index);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 count = 0;
+    in >> count;
+    struct Range { quint64 first = 0, size = 0; };
+    QVector<Range> ranges;
+    plans->clear();
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        ProjectPlan plan;
+        Range range;
+        in >> plan.planId >> plan.taskName >> plan.path.totalPoints
+           >> plan.path.estimatedDistanceM >> plan.path.estimatedDurationS
+           >> range.first >> range.size;
+        if (range.first > recordCount || range.size > recordCount - range.first) return false;
+        plans->append(std::move(plan));
+        ranges.append(range);
+    }
+    QStringList strings;
+    in >> strings;
+    if (in.status() != QDataStream::Ok) return false;
+
+    const auto* base = reinterpret_cast<const WaypointRecord*>(records.constData());
+    for (int p = 0; p < plans->size(); ++p) {
+        QVector<InspectionPoint>& waypoints = (*plans)[p].path.waypoints;
+        waypoints.reserve(static_cast<int>(ranges[p].size));
+        for (quint64 i = 0; i < ranges[p].size; ++i) {
+            waypoints.append(decodeWaypoint(base[ranges[p].first + i], strings));
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Headers
+// ---------------------------------------------------------------------------
+
+bool headerValid(const Header& h, qint64 fileSize)
+{
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0
+        || h.version != kVersion
+        || h.recordBytes != sizeof(WaypointRecord)
+        || h.checksum != headerChecksum(h)) {
+        return false;
+    }
+    for (const SectionEntry& e : h.sections) {
+        if (e.offset == 0) {
+            if (e.bytes != 0) return false;
+            continue;
+        }
+        if (e.offset % kPage != 0 || e.offset < static_cast<uint64_t>(kDataStart)
+            || e.bytes > static_cast<uint64_t>(fileSize)
+            || e.offset > static_cast<uint64_t>(fileSize) - e.bytes) {
+            return false;
+        }
+        if (!(e.flags & Compressed) && e.bytes != e.rawBytes) return false;
+    }
+    const SectionEntry& columns = h.sections[TargetColumns];
+    const SectionEntry& records = h.sections[PlanRecords];
+    return columns.rawBytes == TargetLayout(columns.count).total
+        && records.rawBytes == records.count * sizeof(WaypointRecord)
+        && columns.count <= uint64_t(INT32_MAX) && records.count <= uint64_t(INT32_MAX);
+}
+
+/// The current header of a file whose first kDataStart bytes are \a pages.
+bool pickHeader(const char* pages, qint64 fileSize, Header* out, int* slot)
+{
+    bool found = false;
+    for (int s = 0; s < kSlotCount; ++s) {
+        Header h;
+        std::memcpy(&h, pages + s * kPage, sizeof(h));
+        if (headerValid(h, fileSize) && (!found || h.generation > out->generation)) {
+            *out  = h;
+            *slot = s;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/// Write \a bytes at \a offset (>= pos()), zero-filling the gap.
+bool writeAt(QFileDevice& file, qint64 offset, const char* bytes, qint64 size)
+{
+    static const QByteArray zeros(kPage, '\0');
+    for (qint64 pad = offset - file.pos(); pad > 0; pad -= kPage) {
+        const qint64 n = std::min(pad, kPage);
+        if (file.write(zeros.constData(), n) != n) return false;
+    }
+    return file.write(bytes, size) == size;
+}
+
+void fillEntry(SectionEntry* e, const Encoded& enc, uint64_t offset)
+{
+    e->offset   = enc.stored.isEmpty() ? 0 : offset;
+    e->bytes    = static_cast<uint64_t>(enc.stored.size());
+    e->rawBytes = enc.rawBytes;
+    e->count    = enc.count;
+    e->hash     = enc.hash;
+    e->flags    = enc.flags;
+    e->reserved = 0;
+}
+
+} // anonymous namespace
+
+// ===========================================================================
+// Save
+// ===========================================================================
+
+bool ProjectFile::save(const QString& path, const Project& project,
+                       ProjectSaveStats* stats, QString* error)
+{
+    ProjectSaveStats local;
+    ProjectSaveStats& st = stats ? *stats : local;
+    st = ProjectSaveStats();
+    const auto fail = [error](const QString& message) {
+        if (error) *error = message;
+        return false;
+    };
+
+    Encoded enc[SectionCount];
+    enc[Meta] = compressedSection(encodeMeta(project), 1);
+    encodeTargets(project.targets, &enc[TargetColumns], &enc[TargetStrings]);
+    encodePlans(project.plans, &enc[PlanIndex], &enc[PlanRecords]);
+
+    // -----------------------------------------------------------------------
+    // Incremental: append the changed sections, then flip the header slot.
+    // -----------------------------------------------------------------------
+    Header old;
+    int    oldSlot  = 0;
+    bool   haveOld  = false;
+    qint64 fileSize = 0;
+    {
+        QFile in(path);
+        if (in.open(QIODevice::ReadOnly)) {
+            fileSize = in.size();
+            const QByteArray pages = in.read(kDataStart);
+            haveOld = pages.size() == kDataStart
+                      && pickHeader(pages.constData(), fileSize, &old, &oldSlot);
+        }
+    }
+
+    if (haveOld) {
+        const qint64 end = alignUp(fileSize);
+        qint64 live     = kDataStart;
+        qint64 appended = 0;
+        bool   changed[SectionCount];
+        int    changedCount = 0;
+        for (int s = 0; s < SectionCount; ++s) {
+            changed[s] = !enc[s].sameAs(old.sections[s]);
+            const qint64 pages = alignUp(enc[s].stored.size());
+            live += pages;
+            if (changed[s]) {
+                appended += pages;
+                ++changedCount;
+            }
+        }
+        if (changedCount == 0) {
+            return true;
+        }
+
+        if (end + appended - live <= live) {
+            QFile out(path);
+            if (!out.open(QIODevice::ReadWrite) || !out.seek(fileSize)) {
+                return fail(out.errorString());
+            }
+            Header next = old;
+            next.generation = old.generation + 1;
+            qint64 pos = end;
+            for (int s = 0; s < SectionCount; ++s) {
+                if (!changed[s]) continue;
+                fillEntry(&next.sections[s], enc[s], static_cast<uint64_t>(pos));
+                if (enc[s].stored.isEmpty()) continue;
+                if (!writeAt(out, pos, enc[s].stored.constData(), enc[s].stored.size())) {
+                    return fail(out.errorString());
+                }
+                st.bytesWritten += enc[s].stored.size();
+                ++st.sectionsWritten;
+                pos = alignUp(pos + enc[s].stored.size());
+            }
+            next.checksum = headerChecksum(next);
+
+            // The sections are on disk before the header that refers to them.
+            if (!out.flush() || !out.seek((oldSlot ^ 1) * kPage)
+                || out.write(reinterpret_cast<const char*>(&next), sizeof(next))
+                       != static_cast<qint64>(sizeof(next))
+                || !out.flush()) {
+                return fail(out.errorString());
+            }
+            st.bytesWritten += static_cast<qint64>(sizeof(next));
+            return true;
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Full rewrite: new file, foreign file, or too many stale sections.
+    // -----------------------------------------------------------------------
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version     = kVersion;
+    h.recordBytes = sizeof(WaypointRecord);
+    h.generation  = haveOld ? old.generation + 1 : 1;
+    qint64 pos = kDataStart;
+    for (int s = 0; s < SectionCount; ++s) {
+        fillEntry(&h.sections[s], enc[s], static_cast<uint64_t>(pos));
+        pos = alignUp(pos + enc[s].stored.size());
+    }
+    h.checksum = headerChecksum(h);
+
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly)) {
+        return fail(out.errorString());
+    }
+    bool ok = writeAt(out, 0, reinterpret_cast<const char*>(&h), sizeof(h));
+    for (int s = 0; ok && s < SectionCount; ++s) {
+        if (enc[s].stored.isEmpty()) continue;
+        ok = writeAt(out, static_cast<qint64>(h.sections[s].offset),
+                     enc[s].stored.constData(), enc[s].stored.size());
+        st.bytesWritten += enc[s].stored.size();
+        ++st.sectionsWritten;
+    }
+    // Slot 1 stays zero (invalid) until the next incremental save.
+    if (ok && out.pos() < kDataStart) {
+        ok = writeAt(out, kDataStart, nullptr, 0);
+    }
+    if (!ok) {
+        out.cancelWriting();
+        return fail(out.errorString());
+    }
+    if (!out.commit()) {
+        return fail(out.errorString());
+    }
+    st.bytesWritten += static_cast<qint64>(sizeof(h));
+    st.rewritten = true;
+    return true;
+}
+
+// ===========================================================================
+// Load
+// ===========================================================================
+
+bool ProjectFile::load(const QString& path, Project* project, QString* error)
+{
+    const auto fail = [error](const QString& message) {
+        if (error) *error = message;
+        return false;
+    };
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(file.errorString());
+    }
+    const qint64 fileSize = file.size();
+    if (fileSize < kDataStart) {
+        return fail(QStringLiteral("Not a project file"));
+    }
+    const uchar* base = file.map(0, fileSize);
+    if (!base) {
+        return fail(file.errorString());
+    }
+    const auto* bytes = reinterpret_cast<const char*>(base);
+
+    Header h;
+    int    slot = 0;
+    if (!pickHeader(bytes, fileSize, &h, &slot)) {
+        return fail(QStringLiteral("Not a project file, or from another version"));
+    }
+
+    // Raw sections are wrapped without a copy (valid while mapped);
+    // compressed ones are inflated.  Every section is checked against its
+    // hash before it is decoded.
+    QByteArray raw[SectionCount];
+    for (int s = 0; s < SectionCount; ++s) {
+        const SectionEntry& e = h.sections[s];
+        const QByteArray stored = QByteArray::fromRawData(
+            bytes + e.offset, static_cast<qsizetype>(e.offset ? e.bytes : 0));
+        raw[s] = (e.flags & Compressed) ? qUncompress(stored) : stored;
+        if (static_cast<uint64_t>(raw[s].size()) != e.rawBytes
+            || fnv1a64(kFnv1aBasis, raw[s].constData(),
+                       static_cast<std::size_t>(raw[s].size())) != e.hash) {
+            return fail(QStringLiteral("Project file is corrupt"));
+        }
+    }
+
+    Project loaded;
+    if (!decodeMeta(raw[Meta], &loaded)
+        || !decodeTargets(raw[TargetColumns], h.sections[TargetColumns].count,
+                          raw[TargetStrings], &loaded.targets)
+        || !decodePlans(raw[PlanIndex], raw[PlanRecords], h.sections[PlanRecords].count,
+                        &loaded.plans)) {
+        return fail(QStringLiteral("Project file is corrupt"));
+    }
+    *project = std::move(loaded);
+    return true;
+}
+
+QString ProjectFile::fileSha256(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return {};
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file)) return {};
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+} // namespace hmi
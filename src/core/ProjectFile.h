@@ -0,0 +1,98 @@
+// src/core/ProjectFile.h
+//
+// ProjectFile – save / load of an engineer-mode project: the CAD model
+// reference, the inspection targets, the capture configuration and plan
+// options, and the plans generated for it.
+//
+// File layout (native endianness, 4 KiB pages):
+//   page 0, page 1   two header slots; the valid one with the higher
+//                    generation describes the project
+//   sections         each starting on a page boundary, in any order
+//
+// Sections:
+//   Meta           zlib  QDataStream: model path / SHA-256 / size,
+//                        CaptureConfig, PlanOptions
+//   TargetColumns  raw   int32 pointId[n] | uint32 faceIndex[n] |
+//                        uint32 group[n] | uint32 frame[n] |
+//                        float32 position[3n] | float32 normal[3n] |
+//                        float32 viewDirection[3n] | float64 roll[n]
+//                        (every column 8-byte aligned)
+//   TargetStrings  zlib  QStringList: group / frame IDs of the targets
+//   PlanIndex      zlib  QDataStream: ID, task name, totals and record range
+//                        of every plan, and the records' string table
+//   PlanRecords    raw   WaypointRecord[] of every plan, back to back
+//                        (WaypointRecords.h)
+// The raw sections are flat arrays that are read in place from a mapping of
+// the file; only strings and the small metadata are compressed.  Each
+// header slot holds, per section, its offset, stored and raw size, element
+// count and an FNV-1a hash of the raw bytes, and is covered by a checksum.
+//
+// Incremental saves
+// -----------------
+// Encoding a project is cheap compared with writing it, so save() encodes
+// every section and compares its hash with the table on disk: unchanged
+// sections keep their place, changed ones are appended after the end of the
+// file, and the header goes into the inactive slot last.  The old header
+// describes a complete project until then, so an interrupted save loads as
+// the previous one.  Once the stale bytes outgrow the live ones the file is
+// rewritten compactly through QSaveFile.
+//
+// Thread safety: stateless; any thread, one writer per file.
+
+#pragma once
+
+#include "Types.h"
+
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+namespace hmi {
+
+/// One plan kept with the project.
+struct ProjectPlan {
+    QString        planId;
+    QString        taskName;
+    InspectionPath path;
+};
+
+/// Everything a project file holds.
+struct Project {
+    QString                   modelPath;     ///< CAD file as imported
+    QString                   modelSha256;   ///< lower-case hex; empty if unknown
+    qint64                    modelBytes = 0;
+    CaptureConfig             captureConfig;
+    PlanOptions               planOptions;
+    QVector<InspectionTarget> targets;
+    QVector<ProjectPlan>      plans;         ///< oldest first
+};
+
+/// What one save() wrote.
+struct ProjectSaveStats {
+    int    sectionsWritten = 0;
+    qint64 bytesWritten    = 0;
+    bool   rewritten       = false;   ///< whole file (new, foreign or compacted)
+};
+
+class ProjectFile
+{
+public:
+    /// File name suffix used by the project dialogs.
+    static constexpr const char* kSuffix = "hmiproj";
+
+    /// Write \a project to \a path, touching only the sections that differ
+    /// from the file already there.  Returns false with \a error set when
+    /// the file cannot be written.
+    static bool save(const QString& path, const Project& project,
+                     ProjectSaveStats* stats = nullptr, QString* error = nullptr);
+
+    /// Read \a path into \a project.  Returns false with \a error set when
+    /// the file is missing, truncated, corrupt or from another format.
+    static bool load(const QString& path, Project* project, QString* error = nullptr);
+
+    /// SHA-256 (lower-case hex) of \a filePath's bytes, empty if unreadable.
+    static QString fileSha256(const QString& filePath);
+};
+
+} // namespace hmi
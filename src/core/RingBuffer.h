@@ -0,0 +1,92 @@
+// src/core/RingBuffer.h
+//
+// RingBuffer<T> – fixed-capacity FIFO over one contiguous allocation.
+//
+// push_back() on a full buffer overwrites the oldest element, so the storage
+// never grows past capacity() no matter how long the producer runs.  Index
+// 0 is the oldest element.
+//
+// Thread safety: none; guard externally if shared.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace hmi {
+
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(std::size_t capacity)
+        : m_slots(std::max<std::size_t>(1, capacity))
+    {}
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_slots.size(); }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool        empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] bool        full() const noexcept { return m_size == m_slots.size(); }
+
+    /// Append \a value.  Returns true when the oldest element was overwritten.
+    bool push_back(T value)
+    {
+        const bool overwrite = full();
+        m_slots[(m_head + m_size) % m_slots.size()] = std::move(value);
+        if (overwrite) {
+            m_head = (m_head + 1) % m_slots.size();
+        } else {
+            ++m_size;
+        }
+        return overwrite;
+    }
+
+    /// Drop the \a n oldest elements (clamped to size()).
+    void pop_front(std::size_t n = 1)
+    {
+        n = std::min(n, m_size);
+        for (std::size_t i = 0; i < n; ++i) {
+            m_slots[(m_head + i) % m_slots.size()] = T();   // release resources
+        }
+        m_head = (m_head + n) % m_slots.size();
+        m_size -= n;
+    }
+
+    /// Element \a i, 0 = oldest.  \a i must be < size().
+    [[nodiscard]] const T& operator[](std::size_t i) const
+    {
+        return m_slots[(m_head + i) % m_slots.size()];
+    }
+    [[nodiscard]] T& operator[](std::size_t i)
+    {
+        return m_slots[(m_head + i) % m_slots.size()];
+    }
+
+    void clear()
+    {
+        pop_front(m_size);
+        m_head = 0;
+    }
+
+    /// Change the capacity, keeping the newest elements.
+    void setCapacity(std::size_t capacity)
+    {
+        capacity = std::max<std::size_t>(1, capacity);
+        std::vector<T> slots(capacity);
+        const std::size_t keep = std::min(m_size, capacity);
+        for (std::size_t i = 0; i < keep; ++i) {
+            slots[i] = std::move((*this)[m_size - keep + i]);
+        }
+        m_slots = std::move(slots);
+        m_head  = 0;
+        m_size  = keep;
+    }
+
+private:
+    std::vector<T> m_slots;
+    std::size_t    m_head = 0;
+    std::size_t    m_size = 0;
+};
+
+} // namespace hmi
@@ -0,0 +1,174 @@
+// src/core/RpcEngine.cpp
+//
+// Poller threads and CallSet bookkeeping for RpcEngine.  The call templates
+// themselves live in RpcEngine.h.
+
+#include "RpcEngine.h"
+
+#include <algorithm>
+
+namespace hmi {
+
+// ===========================================================================
+// RpcEngine – lifetime
+// ===========================================================================
+
+RpcEngine::RpcEngine(int pollerThreads)
+{
+    const int n = std::max(1, pollerThreads);
+    m_pollers.reserve(static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        m_pollers.emplace_back([this]() { pollLoop(); });
+    }
+}
+
+RpcEngine::~RpcEngine()
+{
+    // Shutdown() makes Next() return false once every pending tag has been
+    // delivered, which terminates the poll loops.
+    m_cq.Shutdown();
+    for (auto& t : m_pollers) {
+        if (t.joinable()) { t.join(); }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// pollLoop – drain the completion queue until it is shut down.
+// ---------------------------------------------------------------------------
+void RpcEngine::pollLoop()
+{
+    void* tag = nullptr;
+    bool  ok  = false;
+    while (m_cq.Next(&tag, &ok)) {
+        auto* t = static_cast<Tag*>(tag);
+        if (!t->proceed(ok)) {
+            delete t;
+        }
+    }
+}
+
+// ===========================================================================
+// RpcEngine::ArenaPool
+// ===========================================================================
+
+RpcEngine::ArenaPool::Lease RpcEngine::ArenaPool::acquire()
+{
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (!m_idle.empty()) {
+            Entry entry = std::move(m_idle.back());
+            m_idle.pop_back();
+            return Lease(this, std::move(entry));
+        }
+    }
+
+    // The first block is owned by the entry, so Reset() keeps it and a
+    // recycled arena starts with kBlockBytes already allocated.
+    Entry entry;
+    entry.block = std::make_unique<char[]>(kBlockBytes);
+    google::protobuf::ArenaOptions options;
+    options.initial_block      = entry.block.get();
+    options.initial_block_size = kBlockBytes;
+    options.max_block_size     = kMaxBlockBytes;
+    entry.arena = std::make_unique<google::protobuf::Arena>(options);
+    return Lease(this, std::move(entry));
+}
+
+std::size_t RpcEngine::ArenaPool::idle() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_idle.size();
+}
+
+void RpcEngine::ArenaPool::recycle(Entry entry) noexcept
+{
+    entry.arena->Reset();   // frees every block but the owned first one
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_idle.size() < kMaxIdle) {
+        m_idle.push_back(std::move(entry));
+    }
+}
+
+void RpcEngine::ArenaPool::Lease::release() noexcept
+{
+    if (m_pool && m_entry.arena) {
+        m_pool->recycle(std::move(m_entry));
+    }
+    m_pool  = nullptr;
+    m_entry = {};
+}
+
+// ===========================================================================
+// RpcEngine – channel connectivity
+// ===========================================================================
+
+class RpcEngine::StateWatch final : public RpcEngine::Tag {
+public:
+    explicit StateWatch(StateChangeFn done) : m_done(std::move(done)) {}
+
+    bool proceed(bool ok) override
+    {
+        if (m_done) {
+            m_done(ok);
+        }
+        return false;
+    }
+
+private:
+    StateChangeFn m_done;
+};
+
+void RpcEngine::notifyOnStateChange(grpc::ChannelInterface& channel,
+                                    grpc_connectivity_state lastObserved,
+                                    std::chrono::system_clock::time_point deadline,
+                                    StateChangeFn done)
+{
+    channel.NotifyOnStateChange(lastObserved, deadline, &m_cq,
+                                new StateWatch(std::move(done)));
+}
+
+// ===========================================================================
+// RpcEngine::CallSet
+// ===========================================================================
+
+void RpcEngine::CallSet::add(grpc::ClientContext* ctx)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_contexts.insert(ctx);
+}
+
+void RpcEngine::CallSet::remove(grpc::ClientContext* ctx)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_contexts.erase(ctx);
+    if (m_contexts.empty()) {
+        m_idle.notify_all();
+    }
+}
+
+void RpcEngine::CallSet::cancelAll()
+{
+    // Contexts stay alive while they are in the set (the owning call removes
+    // itself under the same mutex before it is deleted).
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (auto* ctx : m_contexts) {
+        ctx->TryCancel();
+    }
+}
+
+void RpcEngine::CallSet::cancelAndWait()
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    for (auto* ctx : m_contexts) {
+        ctx->TryCancel();
+    }
+    m_idle.wait(lk, [this]() { return m_contexts.empty(); });
+}
+
+std::size_t RpcEngine::CallSet::inFlight() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_contexts.size();
+}
+
+} // namespace hmi
@@ -0,0 +1,405 @@
+// src/core/RpcEngine.h
+//
+// RpcEngine – completion-queue driven execution engine for asynchronous gRPC
+// calls.
+//
+// A single grpc::CompletionQueue is drained by a small, fixed set of poller
+// threads (one by default).  Every in-flight call is a heap-allocated tag
+// object that owns its ClientContext, response message and completion
+// callback; starting a call is therefore one allocation instead of one OS
+// thread.
+//
+// The engine is deliberately Qt-free.  Completion callbacks run on a poller
+// thread and are expected to hop back to the Qt main thread themselves (see
+// GatewayClient, which uses QMetaObject::invokeMethod + Qt::QueuedConnection).
+//
+// Large unary messages can opt into protobuf arenas: an ArenaPool::Lease
+// passed to startUnary() backs the response (and, if the caller built it
+// there, the request), so a message tree of thousands of sub-messages is one
+// bump allocation each and tearing it down is a single Reset().  Released
+// arenas keep their first block and go back to the engine's pool.
+//
+// Thread safety: start*() may be called from any thread.  Callbacks must not
+// block – they share the poller threads with every other call.
+
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/support/async_stream.h>
+#include <grpcpp/support/async_unary_call.h>
+
+#include <google/protobuf/arena.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace hmi {
+
+class RpcEngine {
+public:
+    /// Start \a pollerThreads threads draining the completion queue.
+    explicit RpcEngine(int pollerThreads = 1);
+
+    /// Shuts the queue down and joins the poller threads.  All CallSets that
+    /// were used with this engine must be idle (see CallSet::cancelAndWait).
+    ~RpcEngine();
+
+    RpcEngine(const RpcEngine&)            = delete;
+    RpcEngine& operator=(const RpcEngine&) = delete;
+
+    // -----------------------------------------------------------------------
+    // Completion-queue tags
+    // -----------------------------------------------------------------------
+
+    /// Base class of every object placed on the queue as a tag.
+    class Tag {
+    public:
+        virtual ~Tag() = default;
+
+        /// Called on a poller thread when the operation associated with this
+        /// tag completes.  Return false once the tag is finished; the engine
+        /// then deletes it.
+        virtual bool proceed(bool ok) = 0;
+    };
+
+    // -----------------------------------------------------------------------
+    // CallSet – per-owner bookkeeping of in-flight calls
+    // -----------------------------------------------------------------------
+
+    /// Tracks the ClientContexts of all calls started on behalf of one owner
+    /// (e.g. one GatewayClient) so the owner can cancel them and wait until
+    /// every completion callback has returned before it is destroyed.
+    class CallSet {
+    public:
+        void add(grpc::ClientContext* ctx);
+        void remove(grpc::ClientContext* ctx);
+
+        /// TryCancel() every in-flight call without waiting.
+        void cancelAll();
+
+        /// Cancel every in-flight call and block until all callbacks ran.
+        void cancelAndWait();
+
+        [[nodiscard]] std::size_t inFlight() const;
+
+    private:
+        mutable std::mutex                       m_mutex;
+        std::condition_variable                  m_idle;
+        std::unordered_set<grpc::ClientContext*> m_contexts;
+    };
+
+    // -----------------------------------------------------------------------
+    // ArenaPool – recycled protobuf arenas for large unary messages
+    // -----------------------------------------------------------------------
+
+    class ArenaPool {
+    public:
+        static constexpr std::size_t kBlockBytes = 64 * 1024;   ///< kept across leases
+        static constexpr std::size_t kMaxBlockBytes = 1024 * 1024;
+        static constexpr std::size_t kMaxIdle = 8;
+
+        struct Entry {
+            std::unique_ptr<char[]>                  block;
+            std::unique_ptr<google::protobuf::Arena> arena;
+        };
+
+        /// Exclusive use of one arena; Reset() and returned to the pool on
+        /// destruction.  A default-constructed lease holds no arena.
+        class Lease {
+        public:
+            Lease() = default;
+            Lease(ArenaPool* pool, Entry entry) noexcept
+                : m_pool(pool), m_entry(std::move(entry)) {}
+            Lease(Lease&& other) noexcept
+                : m_pool(std::exchange(other.m_pool, nullptr))
+                , m_entry(std::move(other.m_entry)) {}
+            Lease& operator=(Lease&& other) noexcept
+            {
+                if (this != &other) {
+                    release();
+                    m_pool  = std::exchange(other.m_pool, nullptr);
+                    m_entry = std::move(other.m_entry);
+                }
+                return *this;
+            }
+            Lease(const Lease&)            = delete;
+            Lease& operator=(const Lease&) = delete;
+            ~Lease() { release(); }
+
+            [[nodiscard]] google::protobuf::Arena* get() const noexcept
+            {
+                return m_entry.arena.get();
+            }
+            explicit operator bool() const noexcept { return m_entry.arena != nullptr; }
+
+        private:
+            void release() noexcept;
+
+            ArenaPool* m_pool = nullptr;
+            Entry      m_entry;
+        };
+
+        /// An idle arena, or a fresh one when none is left.
+        [[nodiscard]] Lease acquire();
+
+        /// Arenas currently waiting for reuse.
+        [[nodiscard]] std::size_t idle() const;
+
+    private:
+        void recycle(Entry entry) noexcept;
+
+        mutable std::mutex m_mutex;
+        std::vector<Entry> m_idle;
+    };
+
+    /// The engine's arena pool.  Leases must not outlive the engine.
+    [[nodiscard]] ArenaPool& arenas() noexcept { return m_arenas; }
+
+    // -----------------------------------------------------------------------
+    // Unary calls
+    // -----------------------------------------------------------------------
+
+    template <typename Response>
+    using UnaryDoneFn = std::function<void(const grpc::Status&, Response&)>;
+
+    /// Start an asynchronous unary call.
+    ///
+    /// \a prepare is invoked synchronously as
+    ///     prepare(grpc::ClientContext*, const Request&, grpc::CompletionQueue*)
+    /// and must return the stub's PrepareAsyncXxx() reader.  \a done runs on a
+    /// poller thread once the call has finished (successfully or not).
+    ///
+    /// With a non-empty \a arena the response is created on it; the lease is
+    /// held (so a request built on the same arena stays valid) until \a done
+    /// has returned.
+    template <typename Response, typename Request, typename PrepareFn>
+    void startUnary(const std::shared_ptr<CallSet>& calls,
+                    const Request& request,
+                    std::chrono::system_clock::time_point deadline,
+                    PrepareFn&& prepare,
+                    UnaryDoneFn<Response> done,
+                    ArenaPool::Lease arena = {});
+
+    // -----------------------------------------------------------------------
+    // Server-streaming calls
+    // -----------------------------------------------------------------------
+
+    /// Invoked for every received message; return false to cancel the stream.
+    template <typename Response>
+    using StreamMessageFn = std::function<bool(Response&)>;
+
+    /// Invoked exactly once when the stream has finished.
+    using StreamDoneFn = std::function<void(const grpc::Status&)>;
+
+    /// Start an asynchronous server-streaming call.
+    ///
+    /// \a prepare is invoked synchronously as
+    ///     prepare(grpc::ClientContext*, const Request&, grpc::CompletionQueue*)
+    /// and must return the stub's PrepareAsyncXxx() reader.  The received
+    /// message object is reused between \a onMessage invocations.
+    ///
+    /// Returns the call's context so the caller can TryCancel() it; the
+    /// pointer stays valid until \a onDone has returned.
+    template <typename Response, typename Request, typename PrepareFn>
+    grpc::ClientContext* startServerStream(
+        const std::shared_ptr<CallSet>& calls,
+        const Request& request,
+        PrepareFn&& prepare,
+        StreamMessageFn<Response> onMessage,
+        StreamDoneFn onDone,
+        std::chrono::system_clock::time_point deadline =
+            std::chrono::system_clock::time_point::max());
+
+    // -----------------------------------------------------------------------
+    // Channel connectivity
+    // -----------------------------------------------------------------------
+
+    /// Invoked once: \a changed is false when the deadline expired first.
+    using StateChangeFn = std::function<void(bool changed)>;
+
+    /// Call \a done on a poller thread when \a channel leaves
+    /// \a lastObserved or at \a deadline, whichever comes first.  No thread
+    /// waits meanwhile.  Destroying the channel completes the watch (the
+    /// channel shuts down), so a pending watch never outlives it for long.
+    void notifyOnStateChange(grpc::ChannelInterface& channel,
+                             grpc_connectivity_state lastObserved,
+                             std::chrono::system_clock::time_point deadline,
+                             StateChangeFn done);
+
+    /// The queue drained by the poller threads.
+    [[nodiscard]] grpc::CompletionQueue* queue() noexcept { return &m_cq; }
+
+    /// Number of poller threads driving the queue.
+    [[nodiscard]] int pollerCount() const noexcept
+    {
+        return static_cast<int>(m_pollers.size());
+    }
+
+private:
+    template <typename Response>
+    class UnaryCall;
+
+    template <typename Response>
+    class ServerStreamCall;
+
+    class StateWatch;
+
+    void pollLoop();
+
+    ArenaPool                m_arenas;   ///< declared first: outlives every call
+    grpc::CompletionQueue    m_cq;
+    std::vector<std::thread> m_pollers;
+};
+
+// ===========================================================================
+// Template implementation
+// ===========================================================================
+
+template <typename Response>
+class RpcEngine::UnaryCall final : public RpcEngine::Tag {
+public:
+    UnaryCall(std::shared_ptr<CallSet> calls, UnaryDoneFn<Response> done,
+              ArenaPool::Lease arena)
+        : m_arena(std::move(arena))
+        , m_response(m_arena ? google::protobuf::Arena::CreateMessage<Response>(m_arena.get())
+                             : &m_ownResponse)
+        , m_calls(std::move(calls))
+        , m_done(std::move(done))
+    {}
+
+    bool proceed(bool /*ok*/) override
+    {
+        // Finish() always completes with ok == true; the outcome lives in
+        // m_status.
+        if (m_done) {
+            m_done(m_status, *m_response);
+        }
+        if (m_calls) {
+            m_calls->remove(&m_ctx);
+        }
+        return false;
+    }
+
+    // The reader is declared last so it is destroyed before the arena.
+    ArenaPool::Lease                                           m_arena;
+    Response                                                   m_ownResponse;
+    Response*                                                  m_response;
+    grpc::ClientContext                                        m_ctx;
+    grpc::Status                                               m_status;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> m_reader;
+
+private:
+    std::shared_ptr<CallSet> m_calls;
+    UnaryDoneFn<Response>    m_done;
+};
+
+template <typename Response, typename Request, typename PrepareFn>
+void RpcEngine::startUnary(const std::shared_ptr<CallSet>& calls,
+                           const Request& request,
+                           std::chrono::system_clock::time_point deadline,
+                           PrepareFn&& prepare,
+                           UnaryDoneFn<Response> done,
+                           ArenaPool::Lease arena)
+{
+    auto* call = new UnaryCall<Response>(calls, std::move(done), std::move(arena));
+    call->m_ctx.set_deadline(deadline);
+    if (calls) {
+        calls->add(&call->m_ctx);
+    }
+
+    call->m_reader = prepare(&call->m_ctx, request, &m_cq);
+    call->m_reader->StartCall();
+    call->m_reader->Finish(call->m_response, &call->m_status, call);
+}
+
+// ---------------------------------------------------------------------------
+// ServerStreamCall – StartCall → Read* → Finish state machine.
+// ---------------------------------------------------------------------------
+template <typename Response>
+class RpcEngine::ServerStreamCall final : public RpcEngine::Tag {
+public:
+    enum class State { Starting, Reading, Finishing };
+
+    ServerStreamCall(std::shared_ptr<CallSet> calls,
+                     StreamMessageFn<Response> onMessage,
+                     StreamDoneFn onDone)
+        : m_calls(std::move(calls))
+        , m_onMessage(std::move(onMessage))
+        , m_onDone(std::move(onDone))
+    {}
+
+    bool proceed(bool ok) override
+    {
+        switch (m_state) {
+        case State::Starting:
+        case State::Reading:
+            if (!ok) {
+                // Stream closed by the server, cancelled or broken.
+                m_state = State::Finishing;
+                m_reader->Finish(&m_status, this);
+                return true;
+            }
+            if (m_state == State::Reading && m_onMessage && !m_onMessage(m_message)) {
+                m_ctx.TryCancel();
+            }
+            m_state = State::Reading;
+            m_reader->Read(&m_message, this);
+            return true;
+
+        case State::Finishing:
+            if (m_onDone) {
+                m_onDone(m_status);
+            }
+            if (m_calls) {
+                m_calls->remove(&m_ctx);
+            }
+            return false;
+        }
+        return false;
+    }
+
+    grpc::ClientContext                                m_ctx;
+    std::unique_ptr<grpc::ClientAsyncReader<Response>> m_reader;
+
+private:
+    State                     m_state = State::Starting;
+    Response                  m_message;
+    grpc::Status              m_status;
+    std::shared_ptr<CallSet>  m_calls;
+    StreamMessageFn<Response> m_onMessage;
+    StreamDoneFn              m_onDone;
+};
+
+template <typename Response, typename Request, typename PrepareFn>
+grpc::ClientContext* RpcEngine::startServerStream(
+    const std::shared_ptr<CallSet>& calls,
+    const Request& request,
+    PrepareFn&& prepare,
+    StreamMessageFn<Response> onMessage,
+    StreamDoneFn onDone,
+    std::chrono::system_clock::time_point deadline)
+{
+    auto* call = new ServerStreamCall<Response>(calls, std::move(onMessage),
+                                                std::move(onDone));
+    if (deadline != std::chrono::system_clock::time_point::max()) {
+        call->m_ctx.set_deadline(deadline);
+    }
+    if (calls) {
+        calls->add(&call->m_ctx);
+    }
+
+    grpc::ClientContext* ctx = &call->m_ctx;
+    call->m_reader = prepare(ctx, request, &m_cq);
+    call->m_reader->StartCall(call);
+    return ctx;
+}
+
+} // namespace hmi
@@ -0,0 +1,220 @@
+// src/core/RpcMetrics.cpp
+
+#include "RpcMetrics.h"
+
+#include <algorithm>
+
+namespace hmi {
+
+const char* rpcMethodName(RpcMethod method)
+{
+    switch (method) {
+    case RpcMethod::UploadCad:                 return "UploadCad";
+    case RpcMethod::QueryCadUpload:            return "QueryCadUpload";
+    case RpcMethod::SetInspectionTargets:      return "SetInspectionTargets";
+    case RpcMethod::UpdateInspectionTargets:   return "UpdateInspectionTargets";
+    case RpcMethod::PlanInspection:            return "PlanInspection";
+    case RpcMethod::GetPlan:                   return "GetPlan";
+    case RpcMethod::StartInspection:           return "StartInspection";
+    case RpcMethod::PauseInspection:           return "PauseInspection";
+    case RpcMethod::ResumeInspection:          return "ResumeInspection";
+    case RpcMethod::StopInspection:            return "StopInspection";
+    case RpcMethod::GetTaskStatus:             return "GetTaskStatus";
+    case RpcMethod::SubscribeSystemState:      return "SubscribeSystemState";
+    case RpcMethod::SubscribeInspectionEvents: return "SubscribeInspectionEvents";
+    case RpcMethod::GetNavMap:                 return "GetNavMap";
+    case RpcMethod::ListCaptures:              return "ListCaptures";
+    case RpcMethod::DownloadMedia:             return "DownloadMedia";
+    case RpcMethod::Count:                     break;
+    }
+    return "?";
+}
+
+// ===========================================================================
+// Histogram
+// ===========================================================================
+
+double HistogramSnapshot::percentileUs(double p) const noexcept
+{
+    if (count == 0) { return 0.0; }
+    const double target = std::clamp(p, 0.0, 1.0) * double(count);
+    double seen = 0.0;
+    for (int i = 0; i < kLatencyBuckets; ++i) {
+        const double n = double(buckets[static_cast<std::size_t>(i)]);
+        if (n > 0.0 && seen + n >= target) {
+            const double lo = i == 0 ? 0.0 : double(uint64_t(1) << i);
+            const double hi = double(uint64_t(1) << (i + 1));
+            return lo + (hi - lo) * ((target - seen) / n);
+        }
+        seen += n;
+    }
+    return double(uint64_t(1) << kLatencyBuckets);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) noexcept
+{
+    const auto us = static_cast<uint64_t>(
+        std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+    int bucket = 0;
+    for (uint64_t v = us >> 1; v != 0 && bucket < kLatencyBuckets - 1; v >>= 1) {
+        ++bucket;
+    }
+    m_buckets[static_cast<std::size_t>(bucket)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sumUs.fetch_add(us, std::memory_order_relaxed);
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const noexcept
+{
+    HistogramSnapshot s;
+    for (std::size_t i = 0; i < s.buckets.size(); ++i) {
+        s.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    s.count = m_count.load(std::memory_order_relaxed);
+    s.sumUs = m_sumUs.load(std::memory_order_relaxed);
+    return s;
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    for (auto& b : m_buckets) { b.store(0, std::memory_order_relaxed); }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sumUs.store(0, std::memory_order_relaxed);
+}
+
+// ===========================================================================
+// Snapshot
+// ===========================================================================
+
+double RpcMetricsSnapshot::messagesPerSecond(RpcMethod method,
+                                             const RpcMetricsSnapshot& previous) const
+{
+    const double dt = uptimeSec - previous.uptimeSec;
+    const uint64_t now  = (*this)[method].messages;
+    const uint64_t then = previous[method].messages;
+    if (dt <= 0.0 || now < then) { return 0.0; }   // reset in between
+    return double(now - then) / dt;
+}
+
+namespace {
+
+QJsonObject histogramJson(const HistogramSnapshot& h)
+{
+    QJsonObject o;
+    o[QStringLiteral("count")]  = double(h.count);
+    o[QStringLiteral("meanUs")] = h.meanUs();
+    o[QStringLiteral("p50Us")]  = h.percentileUs(0.50);
+    o[QStringLiteral("p95Us")]  = h.percentileUs(0.95);
+    o[QStringLiteral("p99Us")]  = h.percentileUs(0.99);
+    return o;
+}
+
+} // anonymous namespace
+
+QJsonObject RpcMetricsSnapshot::toJson(const RpcMetricsSnapshot* previous) const
+{
+    QJsonObject methodsJson;
+    for (std::size_t i = 0; i < kRpcMethodCount; ++i) {
+        const auto method = static_cast<RpcMethod>(i);
+        const RpcMethodStats& m = methods[i];
+        if (m.calls == 0 && m.messages == 0) { continue; }
+
+        QJsonObject o;
+        o[QStringLiteral("calls")]         = double(m.calls);
+        o[QStringLiteral("failures")]      = double(m.failures);
+        o[QStringLiteral("linkFailures")]  = double(m.linkFailures);
+        o[QStringLiteral("messages")]      = double(m.messages);
+        o[QStringLiteral("bytesSent")]     = double(m.bytesSent);
+        o[QStringLiteral("bytesReceived")] = double(m.bytesReceived);
+        o[QStringLiteral("latency")]       = histogramJson(m.latency);
+        o[QStringLiteral("conversion")]    = histogramJson(m.conversion);
+        o[QStringLiteral("deliveryLag")]   = histogramJson(m.deliveryLag);
+        if (previous) {
+            o[QStringLiteral("messagesPerSec")] = messagesPerSecond(method, *previous);
+        }
+        methodsJson[QLatin1String(rpcMethodName(method))] = o;
+    }
+
+    QJsonObject root;
+    root[QStringLiteral("uptimeSec")] = uptimeSec;
+    root[QStringLiteral("methods")]   = methodsJson;
+    return root;
+}
+
+// ===========================================================================
+// RpcMetrics
+// ===========================================================================
+
+RpcMetrics::RpcMetrics()
+    : m_startNs(Clock::now().time_since_epoch().count())
+{}
+
+void RpcMetrics::recordCall(RpcMethod method, std::chrono::nanoseconds latency, bool ok,
+                            std::size_t bytesSent, std::size_t bytesReceived,
+                            bool linkFailure) noexcept
+{
+    Slot& s = slot(method);
+    s.calls.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) { s.failures.fetch_add(1, std::memory_order_relaxed); }
+    if (!ok && linkFailure) { s.linkFailures.fetch_add(1, std::memory_order_relaxed); }
+    s.bytesSent.fetch_add(bytesSent, std::memory_order_relaxed);
+    s.bytesReceived.fetch_add(bytesReceived, std::memory_order_relaxed);
+    s.latency.record(latency);
+}
+
+void RpcMetrics::recordMessage(RpcMethod method, std::size_t bytes, bool sent) noexcept
+{
+    Slot& s = slot(method);
+    s.messages.fetch_add(1, std::memory_order_relaxed);
+    (sent ? s.bytesSent : s.bytesReceived).fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void RpcMetrics::recordConversion(RpcMethod method, std::chrono::nanoseconds duration) noexcept
+{
+    slot(method).conversion.record(duration);
+}
+
+void RpcMetrics::recordDeliveryLag(RpcMethod method, std::chrono::nanoseconds lag) noexcept
+{
+    slot(method).deliveryLag.record(lag);
+}
+
+RpcMetricsSnapshot RpcMetrics::snapshot() const
+{
+    RpcMetricsSnapshot out;
+    for (std::size_t i = 0; i < kRpcMethodCount; ++i) {
+        const Slot& s = m_slots[i];
+        RpcMethodStats& m = out.methods[i];
+        m.calls         = s.calls.load(std::memory_order_relaxed);
+        m.failures      = s.failures.load(std::memory_order_relaxed);
+        m.linkFailures  = s.linkFailures.load(std::memory_order_relaxed);
+        m.messages      = s.messages.load(std::memory_order_relaxed);
+        m.bytesSent     = s.bytesSent.load(std::memory_order_relaxed);
+        m.bytesReceived = s.bytesReceived.load(std::memory_order_relaxed);
+        m.latency       = s.latency.snapshot();
+        m.conversion    = s.conversion.snapshot();
+        m.deliveryLag   = s.deliveryLag.snapshot();
+    }
+    const int64_t now = Clock::now().time_since_epoch().count();
+    out.uptimeSec = double(now - m_startNs.load(std::memory_order_relaxed))
+                    * double(Clock::period::num) / double(Clock::period::den);
+    return out;
+}
+
+void RpcMetrics::reset()
+{
+    for (Slot& s : m_slots) {
+        s.calls.store(0, std::memory_order_relaxed);
+        s.failures.store(0, std::memory_order_relaxed);
+        s.linkFailures.store(0, std::memory_order_relaxed);
+        s.messages.store(0, std::memory_order_relaxed);
+        s.bytesSent.store(0, std::memory_order_relaxed);
+        s.bytesReceived.store(0, std::memory_order_relaxed);
+        s.latency.reset();
+        s.conversion.reset();
+        s.deliveryLag.reset();
+    }
+    m_startNs.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+} // namespace hmi
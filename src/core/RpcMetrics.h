@@ -0,0 +1,196 @@
+// src/core/RpcMetrics.h
+//
+// RpcMetrics – client-side latency / throughput counters for every gateway
+// RPC and stream, recorded by GatewayClient.
+//
+// Per RpcMethod it keeps
+// * call latency (start -> completion on the poller / worker thread),
+// * calls, failures (and the share of them caused by the link: unavailable,
+//   deadline exceeded, resource exhausted), bytes sent / received
+//   (serialized message sizes),
+// * stream messages (messages/s is the delta between two snapshots),
+// * proto -> hmi conversion time (the fromProto* helpers),
+// * delivery lag: Read()/completion returning -> the queued main-thread
+//   lambda that emits the signal actually running.
+//
+// Histograms are log2-bucketed microseconds backed by relaxed atomics, so
+// recording is a handful of uncontended atomic adds on any thread; readers
+// take a consistent-enough RpcMetricsSnapshot.
+
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace hmi {
+
+/// Every RPC issued by GatewayClient.
+enum class RpcMethod : int {
+    UploadCad,
+    QueryCadUpload,
+    SetInspectionTargets,
+    UpdateInspectionTargets,
+    PlanInspection,
+    GetPlan,
+    StartInspection,
+    PauseInspection,
+    ResumeInspection,
+    StopInspection,
+    GetTaskStatus,
+    SubscribeSystemState,
+    SubscribeInspectionEvents,
+    GetNavMap,
+    ListCaptures,
+    DownloadMedia,
+    Count
+};
+
+constexpr std::size_t kRpcMethodCount = static_cast<std::size_t>(RpcMethod::Count);
+
+/// Gateway method name ("GetNavMap", ...).
+const char* rpcMethodName(RpcMethod method);
+
+// ---------------------------------------------------------------------------
+// Histogram
+// ---------------------------------------------------------------------------
+
+/// Bucket i counts samples in [2^i, 2^(i+1)) µs; bucket 0 also holds < 1 µs.
+/// 32 buckets reach ~70 min, far past any deadline.
+constexpr int kLatencyBuckets = 32;
+
+struct HistogramSnapshot {
+    std::array<uint64_t, kLatencyBuckets> buckets{};
+    uint64_t count = 0;
+    uint64_t sumUs = 0;
+
+    [[nodiscard]] double meanUs() const noexcept
+    {
+        return count > 0 ? double(sumUs) / double(count) : 0.0;
+    }
+
+    /// Estimate of the \a p quantile (0..1), interpolated inside its bucket;
+    /// 0 without samples.
+    [[nodiscard]] double percentileUs(double p) const noexcept;
+};
+
+class LatencyHistogram {
+public:
+    void record(std::chrono::nanoseconds duration) noexcept;
+    [[nodiscard]] HistogramSnapshot snapshot() const noexcept;
+    void reset() noexcept;
+
+private:
+    std::array<std::atomic<uint64_t>, kLatencyBuckets> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sumUs{0};
+};
+
+// ---------------------------------------------------------------------------
+// Snapshot
+// ---------------------------------------------------------------------------
+
+struct RpcMethodStats {
+    uint64_t calls         = 0;   ///< completed calls / ended streams
+    uint64_t failures      = 0;   ///< non-OK status (cancellations included)
+    uint64_t linkFailures  = 0;   ///< failures caused by the link itself
+    uint64_t messages      = 0;   ///< stream messages received (or chunks sent)
+    uint64_t bytesSent     = 0;
+    uint64_t bytesReceived = 0;
+    HistogramSnapshot latency;
+    HistogramSnapshot conversion;
+    HistogramSnapshot deliveryLag;
+};
+
+struct RpcMetricsSnapshot {
+    std::array<RpcMethodStats, kRpcMethodCount> methods{};
+    double uptimeSec = 0.0;   ///< since construction / reset()
+
+    [[nodiscard]] const RpcMethodStats& operator[](RpcMethod m) const
+    {
+        return methods[static_cast<std::size_t>(m)];
+    }
+
+    /// Messages per second of \a method between \a previous and this.
+    [[nodiscard]] double messagesPerSecond(RpcMethod method,
+                                           const RpcMetricsSnapshot& previous) const;
+
+    /// One JSON object per method with any activity; rates are included
+    /// when \a previous is given.
+    [[nodiscard]] QJsonObject toJson(const RpcMetricsSnapshot* previous = nullptr) const;
+};
+
+// ---------------------------------------------------------------------------
+// RpcMetrics
+// ---------------------------------------------------------------------------
+
+class RpcMetrics {
+public:
+    RpcMetrics();
+
+    RpcMetrics(const RpcMetrics&)            = delete;
+    RpcMetrics& operator=(const RpcMetrics&) = delete;
+
+    /// A unary call, a finished stream, or one upload.  \a linkFailure marks
+    /// a failure the link caused (see isLinkFailure() in GatewayClient.cpp),
+    /// as opposed to a cancel or an application error.
+    void recordCall(RpcMethod method, std::chrono::nanoseconds latency, bool ok,
+                    std::size_t bytesSent, std::size_t bytesReceived,
+                    bool linkFailure = false) noexcept;
+
+    /// One stream message of \a bytes (received, or sent for UploadCad).
+    void recordMessage(RpcMethod method, std::size_t bytes, bool sent = false) noexcept;
+
+    void recordConversion(RpcMethod method, std::chrono::nanoseconds duration) noexcept;
+    void recordDeliveryLag(RpcMethod method, std::chrono::nanoseconds lag) noexcept;
+
+    [[nodiscard]] RpcMetricsSnapshot snapshot() const;
+    void reset();
+
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> linkFailures{0};
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> bytesSent{0};
+        std::atomic<uint64_t> bytesReceived{0};
+        LatencyHistogram      latency;
+        LatencyHistogram      conversion;
+        LatencyHistogram      deliveryLag;
+    };
+
+    Slot& slot(RpcMethod m) noexcept { return m_slots[static_cast<std::size_t>(m)]; }
+
+    std::array<Slot, kRpcMethodCount> m_slots;
+    std::atomic<int64_t>              m_startNs;   ///< Clock epoch of reset()
+};
+
+/// Records the lifetime of the scope as conversion time of one method.
+class ScopedConversionTimer {
+public:
+    ScopedConversionTimer(RpcMetrics& metrics, RpcMethod method) noexcept
+        : m_metrics(metrics), m_method(method), m_start(RpcMetrics::Clock::now())
+    {}
+    ~ScopedConversionTimer()
+    {
+        m_metrics.recordConversion(m_method, RpcMetrics::Clock::now() - m_start);
+    }
+
+    ScopedConversionTimer(const ScopedConversionTimer&)            = delete;
+    ScopedConversionTimer& operator=(const ScopedConversionTimer&) = delete;
+
+private:
+    RpcMetrics&                   m_metrics;
+    RpcMethod                     m_method;
+    RpcMetrics::Clock::time_point m_start;
+};
+
+} // namespace hmi
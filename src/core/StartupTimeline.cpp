@@ -0,0 +1,85 @@
+// src/core/StartupTimeline.cpp
+//
+// Implementation of StartupTimeline – see StartupTimeline.h.
+
+#include "StartupTimeline.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+namespace hmi {
+
+StartupTimeline& StartupTimeline::instance()
+{
+    static StartupTimeline timeline;
+    return timeline;
+}
+
+StartupTimeline::StartupTimeline()
+    : m_epoch(Clock::now())
+{}
+
+double StartupTimeline::toMs(Clock::time_point t) const
+{
+    return std::chrono::duration<double, std::milli>(t - m_epoch).count();
+}
+
+double StartupTimeline::elapsedMs() const
+{
+    return toMs(Clock::now());
+}
+
+void StartupTimeline::record(const char* name, Clock::time_point start, Clock::time_point end)
+{
+    m_phases.append({ QString::fromUtf8(name), toMs(start), toMs(end) - toMs(start) });
+    if (FrameProfiler::isEnabled()) {
+        FrameProfiler::instance().record(name, ProfileCategory::Startup, start, end);
+    }
+}
+
+void StartupTimeline::mark(const char* name)
+{
+    m_phases.append({ QString::fromUtf8(name), elapsedMs(), 0.0 });
+}
+
+void StartupTimeline::complete()
+{
+    if (m_complete) { return; }
+    m_complete = true;
+    const double totalMs = elapsedMs();
+
+    QStringList parts;
+    QJsonArray  phases;
+    for (const StartupPhase& p : m_phases) {
+        parts << (p.durationMs > 0.0
+                      ? QStringLiteral("%1 %2 ms").arg(p.name).arg(p.durationMs, 0, 'f', 1)
+                      : QStringLiteral("%1 @%2 ms").arg(p.name).arg(p.startMs, 0, 'f', 1));
+        QJsonObject phase;
+        phase[QStringLiteral("name")]    = p.name;
+        phase[QStringLiteral("startMs")] = p.startMs;
+        phase[QStringLiteral("ms")]      = p.durationMs;
+        phases.append(phase);
+    }
+    qInfo().noquote() << QStringLiteral("Startup %1 ms:").arg(totalMs, 0, 'f', 1)
+                      << parts.join(QStringLiteral(", "));
+
+    if (m_reportPath.isEmpty()) { return; }
+    QFile file(m_reportPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "StartupTimeline: cannot write startup timings to" << m_reportPath;
+        return;
+    }
+    QJsonObject line;
+    line[QStringLiteral("time")]    = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    line[QStringLiteral("totalMs")] = totalMs;
+    line[QStringLiteral("phases")]  = phases;
+    file.write(QJsonDocument(line).toJson(QJsonDocument::Compact));
+    file.write("\n");
+}
+
+} // namespace hmi
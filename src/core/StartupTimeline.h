@@ -0,0 +1,93 @@
+// src/core/StartupTimeline.h
+//
+// StartupTimeline – wall-clock phases of application startup, so cold-start
+// regressions (VTK / OpenGL initialisation, window construction) show up as
+// numbers rather than impressions.
+//
+// main() opens a StartupScope around each phase (Qt / theme set-up, each
+// window, the deferred VTK initialisation, ...) and mark()s milestones such
+// as the first window being shown.  Times are milliseconds since the
+// timeline was first used, i.e. the top of main().  complete() ends the
+// startup: it logs one summary line and, with a report path set, appends
+// the phases as one JSON line to that file (as the RPC metrics dump), so
+// runs can be compared over time.
+//
+// While FrameProfiler is enabled every phase is also recorded there as a
+// ProfileCategory::Startup span and shows up in the Chrome trace.
+//
+// Thread safety: GUI thread only.
+
+#pragma once
+
+#include "FrameProfiler.h"
+
+#include <QString>
+#include <QVector>
+
+namespace hmi {
+
+struct StartupPhase {
+    QString name;
+    double  startMs    = 0.0;   ///< since the timeline epoch
+    double  durationMs = 0.0;   ///< 0 for a milestone
+};
+
+class StartupTimeline
+{
+public:
+    using Clock = FrameProfiler::Clock;
+
+    /// The process-wide timeline; its epoch is the first call.
+    static StartupTimeline& instance();
+
+    /// Non-empty: complete() appends the phases as a JSON line to \a path.
+    void setReportPath(const QString& path) { m_reportPath = path; }
+
+    /// One phase of \a name (a string literal) from \a start to \a end.
+    void record(const char* name, Clock::time_point start, Clock::time_point end);
+
+    /// A zero-length milestone of \a name at the current time.
+    void mark(const char* name);
+
+    [[nodiscard]] double elapsedMs() const;
+    [[nodiscard]] QVector<StartupPhase> phases() const { return m_phases; }
+
+    /// End the startup: summary to the log and the report file.  Later
+    /// calls do nothing; phases recorded afterwards (a deferred
+    /// initialisation on first use) are kept but not reported.
+    void complete();
+    [[nodiscard]] bool isComplete() const { return m_complete; }
+
+private:
+    StartupTimeline();
+
+    double toMs(Clock::time_point t) const;
+
+    const Clock::time_point m_epoch;
+    QVector<StartupPhase>   m_phases;
+    QString                 m_reportPath;
+    bool                    m_complete = false;
+};
+
+/// Records the lifetime of the scope as startup phase \a name.  \a name
+/// must be a string literal.
+class StartupScope {
+public:
+    explicit StartupScope(const char* name) noexcept
+        : m_name(name)
+        , m_start(StartupTimeline::Clock::now())
+    {}
+    ~StartupScope()
+    {
+        StartupTimeline::instance().record(m_name, m_start, StartupTimeline::Clock::now());
+    }
+
+    StartupScope(const StartupScope&)            = delete;
+    StartupScope& operator=(const StartupScope&) = delete;
+
+private:
+    const char*                        m_name;
+    StartupTimeline::Clock::time_point m_start;
+};
+
+} // namespace hmi
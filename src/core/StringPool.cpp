@@ -0,0 +1,36 @@
+// src/core/StringPool.cpp
+
+#include "StringPool.h"
+
+namespace hmi {
+
+QString StringPool::intern(const std::string& s)
+{
+    if (s.empty()) {
+        return {};
+    }
+    if (s.size() > kMaxLength) {
+        return QString::fromStdString(s);
+    }
+
+    auto it = m_strings.find(s);
+    if (it != m_strings.end()) {
+        ++m_hits;
+        return it->second;
+    }
+
+    ++m_misses;
+    if (m_strings.size() >= kMaxEntries) {
+        m_strings.clear();   // unique values churned through; start over
+    }
+    QString value = QString::fromStdString(s);
+    m_strings.emplace(s, value);
+    return value;
+}
+
+void StringPool::clear()
+{
+    m_strings.clear();
+}
+
+} // namespace hmi
@@ -0,0 +1,55 @@
+// src/core/StringPool.h
+//
+// StringPool – interns short, repeated protobuf strings as shared QStrings.
+//
+// Stream messages repeat the same identifiers over and over (task / plan
+// IDs, frame IDs, camera IDs, map IDs, error codes, the current action).
+// QString::fromStdString() decodes UTF-8 and allocates for every field of
+// every message; intern() instead looks the bytes up and hands out the
+// implicitly shared QString from the first conversion – no decode, no
+// allocation on a hit.
+//
+// Long strings (free-text messages) bypass the pool, and the pool clears
+// itself once it holds kMaxEntries strings, so a stream of unique values
+// cannot grow it without bound.
+//
+// Not thread-safe: one pool per converting thread.
+
+#pragma once
+
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace hmi {
+
+class StringPool {
+public:
+    static constexpr std::size_t kMaxLength  = 64;     ///< longer: not interned
+    static constexpr std::size_t kMaxEntries = 4096;
+
+    /// QString for the UTF-8 bytes \a s, shared with earlier identical calls.
+    QString intern(const std::string& s);
+
+    void clear();
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_strings.size(); }
+    [[nodiscard]] uint64_t hits() const noexcept { return m_hits; }
+    [[nodiscard]] uint64_t misses() const noexcept { return m_misses; }
+
+private:
+    std::unordered_map<std::string, QString> m_strings;
+    uint64_t m_hits   = 0;
+    uint64_t m_misses = 0;
+};
+
+/// intern() through \a pool when given, plain conversion otherwise.
+inline QString toQString(const std::string& s, StringPool* pool)
+{
+    return pool ? pool->intern(s) : QString::fromStdString(s);
+}
+
+} // namespace hmi
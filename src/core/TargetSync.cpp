@@ -0,0 +1,110 @@
+// src/core/TargetSync.cpp
+
+#include "TargetSync.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace hmi {
+
+namespace {
+
+/// FNV-1a, 64 bit.
+class Fnv1a {
+public:
+    void bytes(const void* data, std::size_t size)
+    {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            m_hash ^= p[i];
+            m_hash *= 1099511628211ULL;
+        }
+    }
+
+    template <typename T>
+    void value(T v) { bytes(&v, sizeof(v)); }
+
+    void string(const QString& s)
+    {
+        value(static_cast<int32_t>(s.size()));   // length prefix: "ab"+"c" != "a"+"bc"
+        bytes(s.constData(), static_cast<std::size_t>(s.size()) * sizeof(QChar));
+    }
+
+    void vector(const QVector3D& v)
+    {
+        value(v.x());
+        value(v.y());
+        value(v.z());
+    }
+
+    [[nodiscard]] quint64 result() const noexcept { return m_hash; }
+
+private:
+    quint64 m_hash = 14695981039346656037ULL;
+};
+
+} // namespace
+
+namespace TargetSync {
+
+quint64 fingerprint(const InspectionTarget& target)
+{
+    Fnv1a h;
+    h.value(target.pointId);
+    h.string(target.groupId);
+    h.vector(target.surface.position);
+    h.vector(target.surface.normal);
+    h.string(target.surface.frameId);
+    h.value(target.surface.faceIndex);
+    h.vector(target.view.viewDirection);
+    h.value(target.view.rollDeg);
+    return h.result();
+}
+
+quint64 fingerprint(const CaptureConfig& config)
+{
+    Fnv1a h;
+    h.string(config.cameraId);
+    h.value(config.focusDistanceM);
+    h.value(config.fovHDeg);
+    h.value(config.fovVDeg);
+    h.value(config.maxTiltFromNormalDeg);
+    return h.result();
+}
+
+TargetSnapshot snapshot(const QVector<InspectionTarget>& targets,
+                        const CaptureConfig& config)
+{
+    TargetSnapshot out;
+    out.targets.reserve(targets.size());
+    for (const auto& t : targets) {
+        out.targets.insert(t.pointId, fingerprint(t));
+    }
+    out.config = fingerprint(config);
+    return out;
+}
+
+TargetDelta diff(const TargetSnapshot& base,
+                 const TargetSnapshot& next,
+                 const QVector<InspectionTarget>& targets)
+{
+    TargetDelta delta;
+    for (const auto& t : targets) {
+        auto it = base.targets.constFind(t.pointId);
+        if (it == base.targets.constEnd() || it.value() != next.targets.value(t.pointId)) {
+            delta.upserts.append(t);
+        }
+    }
+    for (auto it = base.targets.constBegin(); it != base.targets.constEnd(); ++it) {
+        if (!next.targets.contains(it.key())) {
+            delta.removed.append(it.key());
+        }
+    }
+    std::sort(delta.removed.begin(), delta.removed.end());
+    delta.configChanged = base.config != next.config;
+    return delta;
+}
+
+} // namespace TargetSync
+
+} // namespace hmi
@@ -0,0 +1,64 @@
+// src/core/TargetSync.h
+//
+// TargetSync – client-side bookkeeping for incremental SetInspectionTargets.
+//
+// GatewayClient remembers what the gateway last acknowledged for each model
+// as a TargetSnapshot: one 64-bit fingerprint per point ID plus one for the
+// capture config, tagged with the gateway's target revision.  The next upload
+// is diffed against that snapshot, so moving one point sends one upsert
+// instead of re-encoding thousands of targets.
+//
+// Fingerprints hash every field that is sent to the gateway (FNV-1a over the
+// field bytes); a collision only costs a skipped update of that one target,
+// and the full-replace fallback restores the exact set.
+//
+// Pure value types, Qt Core only; no locking (GatewayClient guards them).
+
+#pragma once
+
+#include "Types.h"
+
+#include <QHash>
+#include <QVector>
+
+#include <cstdint>
+
+namespace hmi {
+
+/// What the gateway holds for one model, as fingerprints.
+struct TargetSnapshot {
+    QHash<int32_t, quint64> targets;     ///< point ID -> fingerprint
+    quint64                 config = 0;  ///< CaptureConfig fingerprint
+    uint64_t                revision = 0; ///< gateway revision (0 = unknown)
+};
+
+/// Changes between an acknowledged snapshot and the current target list.
+struct TargetDelta {
+    QVector<InspectionTarget> upserts;        ///< added or changed targets
+    QVector<int32_t>          removed;        ///< point IDs to drop
+    bool                      configChanged = false;
+
+    [[nodiscard]] bool isEmpty() const noexcept
+    {
+        return upserts.isEmpty() && removed.isEmpty() && !configChanged;
+    }
+};
+
+namespace TargetSync {
+
+quint64 fingerprint(const InspectionTarget& target);
+quint64 fingerprint(const CaptureConfig& config);
+
+/// Snapshot of \a targets / \a config as they will be sent (revision 0).
+TargetSnapshot snapshot(const QVector<InspectionTarget>& targets,
+                        const CaptureConfig& config);
+
+/// Delta that turns \a base into \a next; \a targets must be the list that
+/// \a next was taken from.  Removed IDs are sorted.
+TargetDelta diff(const TargetSnapshot& base,
+                 const TargetSnapshot& next,
+                 const QVector<InspectionTarget>& targets);
+
+} // namespace TargetSync
+
+} // namespace hmi
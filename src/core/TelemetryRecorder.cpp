@@ -0,0 +1,251 @@
+// src/core/TelemetryRecorder.cpp
+//
+// Implementation of TelemetryRecorder – see TelemetryRecorder.h.
+
+#include "TelemetryRecorder.h"
+
+#include <QDir>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace hmi {
+
+namespace telemetry {
+
+QString segmentFileName(int index)
+{
+    return QStringLiteral("telemetry-%1.hmitlm").arg(index, 6, 10, QLatin1Char('0'));
+}
+
+} // namespace telemetry
+
+namespace {
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+void put(uchar* dst, T value)
+{
+    std::memcpy(dst, &value, sizeof(T));
+}
+
+} // anonymous namespace
+
+TelemetryRecorder::TelemetryRecorder(QString directory, TelemetryRecorderOptions options)
+    : m_directory(std::move(directory))
+    , m_options(options)
+    , m_pending(options.ringFrames)
+{
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    stop();
+}
+
+// ---------------------------------------------------------------------------
+// start / stop
+// ---------------------------------------------------------------------------
+bool TelemetryRecorder::start()
+{
+    if (!QDir().mkpath(m_directory)) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_error = QStringLiteral("Cannot create %1").arg(m_directory);
+        return false;
+    }
+
+    // Continue the numbering of an existing recording instead of
+    // overwriting it.
+    const QStringList existing = QDir(m_directory).entryList(
+        { QStringLiteral("telemetry-*.hmitlm") }, QDir::Files, QDir::Name);
+    if (!existing.isEmpty()) {
+        m_segmentIndex = existing.last().mid(10, 6).toInt();
+    }
+
+    if (!openSegment(0)) {
+        return false;
+    }
+    m_writer = std::thread([this]() { writerLoop(); });
+    return true;
+}
+
+void TelemetryRecorder::stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    closeSegment();
+}
+
+// ---------------------------------------------------------------------------
+// record – reader threads
+// ---------------------------------------------------------------------------
+void TelemetryRecorder::record(TelemetryStream stream, int64_t receivedNs,
+                               const std::string& payload)
+{
+    bool wasEmpty = false;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_stopping) { return; }
+        wasEmpty = m_pending.empty();
+        if (m_pending.push_back(Frame{ stream, receivedNs, payload })) {
+            m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (wasEmpty) {
+        m_wake.notify_one();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// writerLoop – drains the ring into the mapped segment.
+// ---------------------------------------------------------------------------
+void TelemetryRecorder::writerLoop()
+{
+    std::vector<Frame> batch;
+    for (;;) {
+        bool stopping = false;
+        {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            m_wake.wait(lk, [this]() { return m_stopping || !m_pending.empty(); });
+            batch.reserve(m_pending.size());
+            for (std::size_t i = 0; i < m_pending.size(); ++i) {
+                batch.push_back(std::move(m_pending[i]));
+            }
+            m_pending.clear();
+            stopping = m_stopping;
+        }
+
+        for (const Frame& frame : batch) {
+            if (!write(frame)) {
+                m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        batch.clear();
+
+        if (stopping) { return; }
+    }
+}
+
+bool TelemetryRecorder::write(const Frame& frame)
+{
+    const qint64 size = qint64(telemetry::kFrameHeaderBytes) + qint64(frame.payload.size());
+    if (!m_map || m_used + size > m_capacity) {
+        closeSegment();
+        if (!openSegment(size)) {
+            return false;
+        }
+    }
+
+    uchar* dst = m_map + m_used;
+    put(dst,      static_cast<uint32_t>(frame.payload.size()));
+    put(dst + 4,  static_cast<uint8_t>(frame.stream));
+    std::memset(dst + 5, 0, 3);
+    put(dst + 8,  frame.receivedNs);
+    std::memcpy(dst + telemetry::kFrameHeaderBytes, frame.payload.data(), frame.payload.size());
+    m_used += size;
+
+    m_framesWritten.fetch_add(1, std::memory_order_relaxed);
+    m_bytesWritten.fetch_add(static_cast<uint64_t>(size), std::memory_order_relaxed);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Segments
+// ---------------------------------------------------------------------------
+bool TelemetryRecorder::openSegment(qint64 minBytes)
+{
+    ++m_segmentIndex;
+    const qint64 capacity = std::max<qint64>(
+        m_options.segmentBytes, qint64(telemetry::kSegmentHeaderBytes) + minBytes);
+
+    m_file.setFileName(QDir(m_directory).filePath(telemetry::segmentFileName(m_segmentIndex)));
+    auto fail = [this](const QString& what) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_error = QStringLiteral("%1 %2: %3").arg(what, m_file.fileName(), m_file.errorString());
+        m_file.close();
+        return false;
+    };
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        return fail(QStringLiteral("Cannot open"));
+    }
+    // resize() zero-fills: the unused tail reads as the end marker.
+    if (!m_file.resize(capacity)) {
+        return fail(QStringLiteral("Cannot resize"));
+    }
+    m_map = m_file.map(0, capacity);
+    if (!m_map) {
+        return fail(QStringLiteral("Cannot map"));
+    }
+    m_capacity = capacity;
+
+    std::memcpy(m_map, telemetry::kMagic, sizeof(telemetry::kMagic));
+    put(m_map + 8,  telemetry::kVersion);
+    put(m_map + 12, static_cast<uint32_t>(m_segmentIndex));
+    put(m_map + 16, nowNs());
+    put(m_map + 24, int64_t(0));
+    m_used = qint64(telemetry::kSegmentHeaderBytes);
+
+    m_segments.fetch_add(1, std::memory_order_relaxed);
+    pruneSegments();
+    return true;
+}
+
+void TelemetryRecorder::closeSegment()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_file.resize(m_used);
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_capacity = 0;
+    m_used     = 0;
+}
+
+void TelemetryRecorder::pruneSegments()
+{
+    if (m_options.maxSegments <= 0) { return; }
+    QDir dir(m_directory);
+    QStringList segments = dir.entryList(
+        { QStringLiteral("telemetry-*.hmitlm") }, QDir::Files, QDir::Name);
+    while (segments.size() > m_options.maxSegments) {
+        dir.remove(segments.takeFirst());
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+QString TelemetryRecorder::errorString() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_error;
+}
+
+TelemetryRecorderStats TelemetryRecorder::stats() const
+{
+    TelemetryRecorderStats s;
+    s.framesWritten = m_framesWritten.load(std::memory_order_relaxed);
+    s.framesDropped = m_framesDropped.load(std::memory_order_relaxed);
+    s.bytesWritten  = m_bytesWritten.load(std::memory_order_relaxed);
+    s.segments      = m_segments.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace hmi
@@ -0,0 +1,138 @@
+// src/core/TelemetryRecorder.h
+//
+// TelemetryRecorder – records the raw messages of the SubscribeSystemState
+// and SubscribeInspectionEvents streams for post-incident analysis and
+// replay (see TelemetryReplayer).
+//
+// Log format
+// ----------
+// A recording is a directory of segment files telemetry-000001.hmitlm, ...
+// Each segment starts with a 32-byte header followed by frames:
+//
+//     header:  char magic[8] = "HMITLM01"; uint32 version; uint32 segment index;
+//              int64 created (ns since epoch); int64 reserved
+//     frame:   uint32 payload length; uint8 stream; uint8[3] zero;
+//              int64 received (ns since epoch); payload (serialized proto)
+//
+// Integers are host byte order (little-endian on every supported target).
+// Segments are memory-mapped, pre-sized to segmentBytes and truncated to the
+// bytes used when they are closed; a segment cut short by a crash keeps its
+// zero-filled tail, and a frame with stream 0 marks the end.
+//
+// The reader threads only copy the serialized frame into a bounded ring;
+// a writer thread owns the mapping, so a page fault or a slow disk never
+// stalls a stream.  When the ring is full the oldest pending frame is
+// dropped and counted.
+//
+// Thread safety: record() may be called from any thread; start()/stop()
+// from one controlling thread.
+
+#pragma once
+
+#include "RingBuffer.h"
+
+#include <QFile>
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace hmi {
+
+/// Stream a recorded frame came from.  0 is reserved as end marker.
+enum class TelemetryStream : uint8_t {
+    SystemState     = 1,   ///< proto SystemStateEvent
+    InspectionEvent = 2,   ///< proto InspectionEvent
+};
+
+namespace telemetry {
+
+constexpr char        kMagic[8]        = { 'H', 'M', 'I', 'T', 'L', 'M', '0', '1' };
+constexpr uint32_t    kVersion         = 1;
+constexpr std::size_t kSegmentHeaderBytes = 32;
+constexpr std::size_t kFrameHeaderBytes   = 16;
+
+/// File name of segment \a index inside a recording directory.
+QString segmentFileName(int index);
+
+} // namespace telemetry
+
+struct TelemetryRecorderOptions {
+    qint64      segmentBytes = 64 * 1024 * 1024;  ///< a new segment beyond this
+    int         maxSegments  = 0;                 ///< oldest deleted beyond this; 0 = keep all
+    std::size_t ringFrames   = 4096;              ///< frames pending for the writer
+};
+
+struct TelemetryRecorderStats {
+    uint64_t framesWritten = 0;
+    uint64_t framesDropped = 0;   ///< ring overflow or write failure
+    uint64_t bytesWritten  = 0;
+    int      segments      = 0;   ///< segments opened so far
+};
+
+class TelemetryRecorder {
+public:
+    explicit TelemetryRecorder(QString directory, TelemetryRecorderOptions options = {});
+    ~TelemetryRecorder();
+
+    TelemetryRecorder(const TelemetryRecorder&)            = delete;
+    TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+    /// Create the directory and the first segment and start the writer.
+    /// Returns false and sets errorString() on failure.
+    bool start();
+
+    /// Write every pending frame, close the segment and join the writer.
+    void stop();
+
+    /// Queue one serialized message received at \a receivedNs (ns since
+    /// epoch).  Never blocks on disk.
+    void record(TelemetryStream stream, int64_t receivedNs, const std::string& payload);
+
+    [[nodiscard]] QString directory() const { return m_directory; }
+    [[nodiscard]] QString errorString() const;
+    [[nodiscard]] TelemetryRecorderStats stats() const;
+
+private:
+    struct Frame {
+        TelemetryStream stream = TelemetryStream::SystemState;
+        int64_t         receivedNs = 0;
+        std::string     payload;
+    };
+
+    void writerLoop();
+    bool write(const Frame& frame);
+    bool openSegment(qint64 minBytes);
+    void closeSegment();
+    void pruneSegments();
+
+    const QString                  m_directory;
+    const TelemetryRecorderOptions m_options;
+
+    // Ring between record() and the writer (under m_mutex).
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_wake;
+    RingBuffer<Frame>       m_pending;
+    bool                    m_stopping = false;
+    QString                 m_error;
+
+    // Writer thread only.
+    std::thread m_writer;
+    QFile       m_file;
+    uchar*      m_map      = nullptr;
+    qint64      m_capacity = 0;
+    qint64      m_used     = 0;
+    int         m_segmentIndex = 0;
+
+    std::atomic<uint64_t> m_framesWritten{0};
+    std::atomic<uint64_t> m_framesDropped{0};
+    std::atomic<uint64_t> m_bytesWritten{0};
+    std::atomic<int>      m_segments{0};
+};
+
+} // namespace hmi
@@ -0,0 +1,180 @@
+// src/core/TelemetryReplayer.cpp
+//
+// Implementation of TelemetryReplayer – see TelemetryReplayer.h.
+
+#include "TelemetryReplayer.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <cstring>
+#include <utility>
+
+namespace hmi {
+
+namespace {
+
+template <typename T>
+T get(const uchar* src)
+{
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+} // anonymous namespace
+
+TelemetryReplayer::TelemetryReplayer(QString path, double speed,
+                                     FrameFn onFrame, DoneFn onDone)
+    : m_path(std::move(path))
+    , m_speed(speed > 0.0 ? speed : kMaxSpeed)
+    , m_onFrame(std::move(onFrame))
+    , m_onDone(std::move(onDone))
+{
+}
+
+TelemetryReplayer::~TelemetryReplayer()
+{
+    stop();
+}
+
+QStringList TelemetryReplayer::segmentsOf(const QString& path)
+{
+    const QFileInfo info(path);
+    if (info.isFile()) {
+        return { info.absoluteFilePath() };
+    }
+    QDir dir(path);
+    QStringList files;
+    const QStringList names = dir.entryList(
+        { QStringLiteral("telemetry-*.hmitlm") }, QDir::Files, QDir::Name);
+    for (const QString& name : names) {
+        files.append(dir.absoluteFilePath(name));
+    }
+    return files;
+}
+
+bool TelemetryReplayer::start()
+{
+    m_segments = segmentsOf(m_path);
+    if (m_segments.isEmpty()) {
+        m_error = QStringLiteral("No telemetry segments in %1").arg(m_path);
+        return false;
+    }
+    m_thread = std::thread([this]() { run(); });
+    return true;
+}
+
+void TelemetryReplayer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// run – replay thread
+// ---------------------------------------------------------------------------
+void TelemetryReplayer::run()
+{
+    int64_t  firstNs = -1;
+    auto     wallStart = std::chrono::steady_clock::now();
+    uint64_t frames = 0;
+    QString  error;
+
+    bool stopped = false;
+    for (const QString& file : m_segments) {
+        if (!playSegment(file, firstNs, wallStart, frames, error)) {
+            stopped = true;
+            break;
+        }
+    }
+
+    hmi::Result result{ hmi::ErrorCode::Ok, error };
+    if (stopped) {
+        result = { hmi::ErrorCode::Unspecified, QStringLiteral("Cancelled") };
+    } else if (frames == 0 && !error.isEmpty()) {
+        result.code = hmi::ErrorCode::InvalidArgument;
+    }
+    if (m_onDone) {
+        m_onDone(result, frames);
+    }
+}
+
+bool TelemetryReplayer::playSegment(const QString& path, int64_t& firstNs,
+                                    std::chrono::steady_clock::time_point& wallStart,
+                                    uint64_t& frames, QString& error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = QStringLiteral("Cannot open %1: %2").arg(path, file.errorString());
+        return true;
+    }
+    const qint64 size = file.size();
+    if (size < qint64(telemetry::kSegmentHeaderBytes)) {
+        error = QStringLiteral("%1: truncated header").arg(path);
+        return true;
+    }
+    const uchar* map = file.map(0, size);
+    if (!map) {
+        error = QStringLiteral("Cannot map %1: %2").arg(path, file.errorString());
+        return true;
+    }
+    if (std::memcmp(map, telemetry::kMagic, sizeof(telemetry::kMagic)) != 0
+        || get<uint32_t>(map + 8) != telemetry::kVersion) {
+        error = QStringLiteral("%1: not a telemetry segment").arg(path);
+        return true;
+    }
+
+    qint64 pos = qint64(telemetry::kSegmentHeaderBytes);
+    while (pos + qint64(telemetry::kFrameHeaderBytes) <= size) {
+        const uchar*   header  = map + pos;
+        const uint32_t length  = get<uint32_t>(header);
+        const uint8_t  stream  = get<uint8_t>(header + 4);
+        const int64_t  stampNs = get<int64_t>(header + 8);
+        if (stream == 0) { break; }   // end marker / zero-filled tail
+        const qint64 next = pos + qint64(telemetry::kFrameHeaderBytes) + qint64(length);
+        if (next > size) {
+            error = QStringLiteral("%1: truncated frame at %2").arg(path).arg(pos);
+            break;
+        }
+
+        if (m_speed > 0.0) {
+            if (firstNs < 0) {
+                firstNs   = stampNs;
+                wallStart = std::chrono::steady_clock::now();
+            }
+            const auto offset = std::chrono::nanoseconds(
+                static_cast<int64_t>(double(stampNs - firstNs) / m_speed));
+            if (!waitUntil(wallStart + offset)) {
+                return false;
+            }
+        } else {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (m_stopping) { return false; }
+        }
+
+        if (m_onFrame) {
+            m_onFrame(static_cast<TelemetryStream>(stream), stampNs,
+                      reinterpret_cast<const char*>(header + telemetry::kFrameHeaderBytes),
+                      length);
+        }
+        ++frames;
+        pos = next;
+    }
+    return true;
+}
+
+bool TelemetryReplayer::waitUntil(std::chrono::steady_clock::time_point until)
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    return !m_wake.wait_until(lk, until, [this]() { return m_stopping; });
+}
+
+} // namespace hmi
@@ -0,0 +1,92 @@
+// src/core/TelemetryReplayer.h
+//
+// TelemetryReplayer – plays a TelemetryRecorder log back on its own thread.
+//
+// Segments are memory-mapped read-only and walked frame by frame; every
+// frame is handed to the FrameFn with a pointer into the mapping (valid only
+// during the call).  Frames are paced by their recorded receive times
+// divided by the speed factor: 1.0 reproduces the original timing, 10.0
+// plays ten times as fast, and 0 (kMaxSpeed) delivers back to back – a
+// deterministic load source for the UI.
+//
+// A truncated or corrupt segment ends that segment at the last intact
+// frame; the remaining segments still play.
+//
+// Thread safety: start()/stop() from one controlling thread; the callbacks
+// run on the replay thread.
+
+#pragma once
+
+#include "TelemetryRecorder.h"
+#include "Types.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace hmi {
+
+class TelemetryReplayer {
+public:
+    static constexpr double kMaxSpeed = 0.0;
+
+    /// One recorded frame; \a data points into the mapped segment.
+    using FrameFn = std::function<void(TelemetryStream stream, int64_t receivedNs,
+                                       const char* data, std::size_t size)>;
+
+    /// Invoked once on the replay thread when playback ends.  A stop()
+    /// reports ErrorCode::Unspecified with message "Cancelled".
+    using DoneFn = std::function<void(const hmi::Result& result, uint64_t frames)>;
+
+    /// \a path is a recording directory or a single segment file.
+    TelemetryReplayer(QString path, double speed, FrameFn onFrame, DoneFn onDone);
+    ~TelemetryReplayer();
+
+    TelemetryReplayer(const TelemetryReplayer&)            = delete;
+    TelemetryReplayer& operator=(const TelemetryReplayer&) = delete;
+
+    /// Resolve the segments and start the replay thread.  Returns false and
+    /// sets errorString() when there is nothing to play.
+    bool start();
+
+    /// Abort playback and join the replay thread.
+    void stop();
+
+    [[nodiscard]] QString errorString() const { return m_error; }
+
+    /// Segment files of \a path in playback order.
+    static QStringList segmentsOf(const QString& path);
+
+private:
+    void run();
+
+    /// Play one segment; false when stopped.  \a firstNs / \a wallStart
+    /// anchor the pacing across segments.
+    bool playSegment(const QString& path, int64_t& firstNs,
+                     std::chrono::steady_clock::time_point& wallStart,
+                     uint64_t& frames, QString& error);
+
+    /// Sleep until \a until or stop(); false when stopped.
+    bool waitUntil(std::chrono::steady_clock::time_point until);
+
+    const QString m_path;
+    const double  m_speed;
+    FrameFn       m_onFrame;
+    DoneFn        m_onDone;
+    QStringList   m_segments;
+    QString       m_error;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    bool                    m_stopping = false;
+    std::thread             m_thread;
+};
+
+} // namespace hmi
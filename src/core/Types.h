@@ -18,8 +18,11 @@
 #include <QQuaternion>
 #include <QVector>
 #include <QVector3D>
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <memory>
+#include <utility>
 
 namespace hmi {
 
@@ -95,6 +98,37 @@ struct ImageRef {
     uint32_t    width  = 0;
     uint32_t    height = 0;
     QByteArray  thumbnailJpeg;  ///< Optional small preview for UI.
+    MediaRef    thumbnailMedia; ///< Preview to download when not inlined (proto extensions).
+};
+
+/// Where a streamed DownloadMedia payload is written.
+struct MediaDownloadOptions {
+    QString filePath;            ///< Write to this file (memory-mapped) when set.
+    bool    useTempFile  = false;///< Write to a fresh temp file if filePath is empty.
+    bool    verifySha256 = true; ///< Compare against MediaRef::sha256 when present.
+};
+
+/// How UploadCad transfers a file (see CadUploadSession).  Compression,
+/// resume and the known-hash skip need the gateway proto extensions
+/// (HMI_PROTO_EXTENSIONS); without them the file is streamed uncompressed in
+/// one attempt.
+struct CadUploadOptions {
+    enum class Compression { Auto, None, Gzip, Zstd };
+
+    Compression compression = Compression::Auto; ///< Auto: zstd if built, else gzip
+    bool        skipIfKnown = true;   ///< Skip when the gateway has the file hash
+    bool        resume      = true;   ///< Continue from the acknowledged offset
+    int         maxAttempts = 5;      ///< Stream attempts including the first
+};
+
+/// A completed DownloadMedia transfer.
+struct MediaPayload {
+    QString    mediaId;
+    quint64    downloadId = 0; ///< GatewayClient::fetchMedia() token; 0 if not downloaded.
+    QByteArray data;           ///< In-memory payload; empty for file downloads.
+    QString    filePath;       ///< Set when the payload was written to disk.
+    qint64     sizeBytes = 0;
+    QString    sha256;         ///< Lower-case hex digest of the received bytes.
 };
 
 // ---------------------------------------------------------------------------
@@ -275,6 +309,78 @@ struct InspectionEvent {
     Pose3D                cameraPose;
 };
 
+/// Which inspection events a subscription delivers.  Sent to the gateway by
+/// GatewayClient::subscribeInspectionEvents() (proto extensions) and always
+/// applied by the client before conversion, so a rejected event is never
+/// converted or emitted.  Events without a point (pointId 0: task-level
+/// messages) pass any point range.
+struct InspectionEventFilter {
+    static constexpr uint32_t kAllTypes = 0;
+
+    uint32_t typeMask          = kAllTypes;  ///< typeBit()s; kAllTypes = every type
+    int32_t  minPointId        = 0;          ///< inclusive; 0 = no lower bound
+    int32_t  maxPointId        = 0;          ///< inclusive; 0 = no upper bound
+    bool     includeThumbnails = true;       ///< false: ImageRef::thumbnailJpeg left empty
+
+    static constexpr uint32_t typeBit(InspectionEventType type) noexcept
+    {
+        return 1u << static_cast<uint32_t>(type);
+    }
+
+    [[nodiscard]] bool acceptsType(InspectionEventType type) const noexcept
+    {
+        return typeMask == kAllTypes || (typeMask & typeBit(type)) != 0;
+    }
+
+    [[nodiscard]] bool acceptsPoint(int32_t pointId) const noexcept
+    {
+        return pointId == 0 ||
+               ((minPointId == 0 || pointId >= minPointId) &&
+                (maxPointId == 0 || pointId <= maxPointId));
+    }
+
+    [[nodiscard]] bool accepts(InspectionEventType type, int32_t pointId) const noexcept
+    {
+        return acceptsType(type) && acceptsPoint(pointId);
+    }
+    [[nodiscard]] bool accepts(const InspectionEvent& event) const noexcept
+    {
+        return accepts(event.type, event.pointId);
+    }
+
+    [[nodiscard]] bool acceptsAll() const noexcept
+    {
+        return typeMask == kAllTypes && minPointId == 0 && maxPointId == 0 && includeThumbnails;
+    }
+
+    /// The narrowest filter that passes everything \a a or \a b passes
+    /// (point ranges join into one span) – the subscription filter for
+    /// several consumers.
+    static InspectionEventFilter united(const InspectionEventFilter& a,
+                                        const InspectionEventFilter& b) noexcept
+    {
+        InspectionEventFilter out;
+        out.typeMask = (a.typeMask == kAllTypes || b.typeMask == kAllTypes)
+                           ? kAllTypes : (a.typeMask | b.typeMask);
+        out.minPointId = (a.minPointId == 0 || b.minPointId == 0)
+                             ? 0 : std::min(a.minPointId, b.minPointId);
+        out.maxPointId = (a.maxPointId == 0 || b.maxPointId == 0)
+                             ? 0 : std::max(a.maxPointId, b.maxPointId);
+        out.includeThumbnails = a.includeThumbnails || b.includeThumbnails;
+        return out;
+    }
+
+    friend bool operator==(const InspectionEventFilter& a, const InspectionEventFilter& b) noexcept
+    {
+        return a.typeMask == b.typeMask && a.minPointId == b.minPointId &&
+               a.maxPointId == b.maxPointId && a.includeThumbnails == b.includeThumbnails;
+    }
+    friend bool operator!=(const InspectionEventFilter& a, const InspectionEventFilter& b) noexcept
+    {
+        return !(a == b);
+    }
+};
+
 // ---------------------------------------------------------------------------
 // Capture records
 // ---------------------------------------------------------------------------
@@ -289,6 +395,35 @@ struct CaptureRecord {
     QDateTime             capturedAt;
 };
 
+/// How GatewayClient::listCaptures() fetches a task's records.  Paging needs
+/// the gateway proto extensions (HMI_PROTO_EXTENSIONS); without them the
+/// whole list arrives as one page.
+struct CaptureListOptions {
+    bool includeThumbnails = true;  ///< false: metadata only, previews fetched on demand
+    int  pageSize          = 200;   ///< records per ListCaptures call; 0 = gateway default
+    int  thumbnailMaxPx    = 0;     ///< longest thumbnail edge; 0 = gateway default
+};
+
+/// Link-dependent limits that GatewayClient applies to every request that
+/// carries images (GetNavMap, ListCaptures); set by BandwidthGovernor.  The
+/// size limit needs the gateway proto extensions (HMI_PROTO_EXTENSIONS).
+struct MediaQuality {
+    bool navMapThumbnail   = true;   ///< GetNavMap include_image_thumbnail
+    bool captureThumbnails = true;   ///< false overrides CaptureListOptions
+    int  thumbnailMaxPx    = 0;      ///< 0 = no limit
+
+    friend bool operator==(const MediaQuality& a, const MediaQuality& b) noexcept
+    {
+        return a.navMapThumbnail == b.navMapThumbnail
+            && a.captureThumbnails == b.captureThumbnails
+            && a.thumbnailMaxPx == b.thumbnailMaxPx;
+    }
+    friend bool operator!=(const MediaQuality& a, const MediaQuality& b) noexcept
+    {
+        return !(a == b);
+    }
+};
+
 // ---------------------------------------------------------------------------
 // Navigation map
 // ---------------------------------------------------------------------------
@@ -324,8 +459,51 @@ struct GetPlanResponse {
     InspectionPath     path;
     PlanningStatistics stats;
     QDateTime          createdAt;
+    uint64_t           revision  = 0;       ///< plan content revision (see PlanCache)
+    bool               fromCache = false;   ///< served from the local PlanCache
+};
+
+/// How GatewayClient::getPlan() uses the local PlanCache.
+enum class PlanFetchPolicy {
+    PreferCache,   ///< cached copy when present (revalidated with the extensions)
+    Refresh,       ///< always fetch the whole plan
+};
+
+// ---------------------------------------------------------------------------
+// Shared snapshots
+// ---------------------------------------------------------------------------
+
+/// Immutable value shared by every copy.  The large types travel through
+/// queued signals as snapshots: each queued connection and each receiver
+/// copies one pointer instead of the whole struct (a TaskStatus has a dozen
+/// strings and nested poses; a plan carries every waypoint).  Receivers that
+/// need to modify the value copy it out explicitly with value().
+template <typename T>
+class Snapshot {
+public:
+    /// A default-constructed T (shared by all empty snapshots).
+    Snapshot() : m_value(empty()) {}
+    explicit Snapshot(T value) : m_value(std::make_shared<const T>(std::move(value))) {}
+
+    [[nodiscard]] const T& operator*() const noexcept { return *m_value; }
+    [[nodiscard]] const T* operator->() const noexcept { return m_value.get(); }
+    [[nodiscard]] const T& value() const noexcept { return *m_value; }
+
+private:
+    static const std::shared_ptr<const T>& empty()
+    {
+        static const std::shared_ptr<const T> value = std::make_shared<const T>();
+        return value;
+    }
+
+    std::shared_ptr<const T> m_value;
 };
 
+using TaskStatusSnapshot      = Snapshot<TaskStatus>;
+using InspectionEventSnapshot = Snapshot<InspectionEvent>;
+using PlanResponseSnapshot    = Snapshot<PlanResponse>;
+using GetPlanResponseSnapshot = Snapshot<GetPlanResponse>;
+
 } // namespace hmi
 
 // Register value types with Qt's meta-object system so they can travel
@@ -339,7 +517,13 @@ Q_DECLARE_METATYPE(hmi::InspectionEvent)
 Q_DECLARE_METATYPE(hmi::PlanResponse)
 Q_DECLARE_METATYPE(hmi::GetPlanResponse)
 Q_DECLARE_METATYPE(hmi::NavMapInfo)
+Q_DECLARE_METATYPE(hmi::MediaRef)
+Q_DECLARE_METATYPE(hmi::MediaPayload)
 Q_DECLARE_METATYPE(hmi::CaptureRecord)
 Q_DECLARE_METATYPE(QVector<hmi::CaptureRecord>)
 Q_DECLARE_METATYPE(QVector<hmi::DefectResult>)
 Q_DECLARE_METATYPE(QVector<hmi::InspectionTarget>)
+Q_DECLARE_METATYPE(hmi::TaskStatusSnapshot)
+Q_DECLARE_METATYPE(hmi::InspectionEventSnapshot)
+Q_DECLARE_METATYPE(hmi::PlanResponseSnapshot)
+Q_DECLARE_METATYPE(hmi::GetPlanResponseSnapshot)
@@ -0,0 +1,99 @@
+// src/core/WaypointRecords.cpp
+//
+// Implementation of the waypoint record codec – see WaypointRecords.h.
+
+#include "WaypointRecords.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace hmi {
+
+namespace {
+
+PoseRecord encodePose(const Pose3D& p, RecordStringTable& strings)
+{
+    PoseRecord r{};
+    r.position[0]    = p.position.x();
+    r.position[1]    = p.position.y();
+    r.position[2]    = p.position.z();
+    r.orientation[0] = p.orientation.scalar();
+    r.orientation[1] = p.orientation.x();
+    r.orientation[2] = p.orientation.y();
+    r.orientation[3] = p.orientation.z();
+    r.frame          = strings.index(p.frameId);
+    return r;
+}
+
+Pose3D decodePose(const PoseRecord& r, const QStringList& strings)
+{
+    Pose3D p;
+    p.position    = QVector3D(r.position[0], r.position[1], r.position[2]);
+    p.orientation = QQuaternion(r.orientation[0], r.orientation[1],
+                                r.orientation[2], r.orientation[3]);
+    p.frameId     = recordString(strings, r.frame);
+    return p;
+}
+
+} // anonymous namespace
+
+std::vector<WaypointRecord> encodeWaypoints(const InspectionPath& path,
+                                            RecordStringTable& strings)
+{
+    std::vector<WaypointRecord> records(static_cast<std::size_t>(path.waypoints.size()));
+    for (int i = 0; i < path.waypoints.size(); ++i) {
+        const InspectionPoint& wp = path.waypoints[i];
+        WaypointRecord& r = records[static_cast<std::size_t>(i)];
+        r.agvX   = wp.agvPose.x;
+        r.agvY   = wp.agvPose.y;
+        r.agvYaw = wp.agvPose.yaw;
+        std::copy(wp.armJointGoal.begin(), wp.armJointGoal.end(), r.joints);
+        r.expectedQuality = wp.expectedQuality;
+        r.planningCost    = wp.planningCost;
+        r.arm      = encodePose(wp.armPose, strings);
+        r.tcp      = encodePose(wp.tcpPoseGoal, strings);
+        r.camera   = encodePose(wp.cameraPose, strings);
+        r.pointId  = wp.pointId;
+        r.group    = strings.index(wp.groupId);
+        r.agvFrame = strings.index(wp.agvPose.frameId);
+        r.cameraId = strings.index(wp.cameraId);
+    }
+    return records;
+}
+
+InspectionPoint decodeWaypoint(const WaypointRecord& r, const QStringList& strings)
+{
+    InspectionPoint wp;
+    wp.pointId         = r.pointId;
+    wp.groupId         = recordString(strings, r.group);
+    wp.agvPose.x       = r.agvX;
+    wp.agvPose.y       = r.agvY;
+    wp.agvPose.yaw     = r.agvYaw;
+    wp.agvPose.frameId = recordString(strings, r.agvFrame);
+    wp.armPose         = decodePose(r.arm, strings);
+    std::copy(std::begin(r.joints), std::end(r.joints), wp.armJointGoal.begin());
+    wp.expectedQuality = r.expectedQuality;
+    wp.planningCost    = r.planningCost;
+    wp.tcpPoseGoal     = decodePose(r.tcp, strings);
+    wp.cameraPose      = decodePose(r.camera, strings);
+    wp.cameraId        = recordString(strings, r.cameraId);
+    return wp;
+}
+
+const QString& recordString(const QStringList& strings, uint32_t i)
+{
+    static const QString kEmpty;
+    return i < static_cast<uint32_t>(strings.size()) ? strings[static_cast<int>(i)] : kEmpty;
+}
+
+uint64_t fnv1a64(uint64_t h, const void* data, std::size_t bytes)
+{
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < bytes; ++i) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+} // namespace hmi
@@ -0,0 +1,87 @@
+// src/core/WaypointRecords.h
+//
+// Fixed-size binary records of InspectionPoint, shared by the files that
+// store plans (PlanCache entries, ProjectFile plan sections).
+//
+// A record holds the numeric fields as they are and its strings (group /
+// frame / camera IDs) as indices into a string table that the file stores
+// separately.  Records are trivially copyable and free of padding, so a
+// file can be memory-mapped and read in place, and equal paths encode to
+// equal bytes (see fnv1a64()).
+//
+// Native endianness; the record size is part of each file's header so that
+// a file written by another build is rejected instead of misread.
+
+#pragma once
+
+#include "Types.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace hmi {
+
+/// Pose3D with its frame ID as a string-table index.
+struct PoseRecord {
+    float    position[3];
+    float    orientation[4];   ///< (w, x, y, z)
+    uint32_t frame;
+};
+
+/// One InspectionPoint, fixed size.
+struct WaypointRecord {
+    double     agvX, agvY, agvYaw;
+    double     joints[6];
+    double     expectedQuality;
+    double     planningCost;
+    PoseRecord arm, tcp, camera;
+    int32_t    pointId;
+    uint32_t   group;
+    uint32_t   agvFrame;
+    uint32_t   cameraId;
+};
+static_assert(std::is_trivially_copyable<WaypointRecord>::value, "records are memcpy'd");
+static_assert(sizeof(WaypointRecord) == 200, "record layout has no padding");
+
+/// Interns the strings of records while they are encoded.
+class RecordStringTable {
+public:
+    uint32_t index(const QString& s)
+    {
+        auto it = m_index.constFind(s);
+        if (it != m_index.constEnd()) return it.value();
+        const auto i = static_cast<uint32_t>(m_strings.size());
+        m_strings.append(s);
+        m_index.insert(s, i);
+        return i;
+    }
+    const QStringList& strings() const { return m_strings; }
+
+private:
+    QStringList              m_strings;
+    QHash<QString, uint32_t> m_index;
+};
+
+/// \a path's waypoints as records; their strings are added to \a strings.
+std::vector<WaypointRecord> encodeWaypoints(const InspectionPath& path,
+                                            RecordStringTable& strings);
+
+/// The waypoint of \a record; string indices outside \a strings decode as
+/// empty strings.
+InspectionPoint decodeWaypoint(const WaypointRecord& record, const QStringList& strings);
+
+/// \a strings[i], or an empty string when \a i is out of range.
+const QString& recordString(const QStringList& strings, uint32_t i);
+
+constexpr uint64_t kFnv1aBasis = 0xcbf29ce484222325ULL;
+
+/// FNV-1a, 64 bit, continuing from \a h (kFnv1aBasis to start).
+uint64_t fnv1a64(uint64_t h, const void* data, std::size_t bytes);
+
+} // namespace hmi
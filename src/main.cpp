@@ -5,25 +5,137 @@
 // Responsibilities:
 //   - Initialize Qt application with proper OpenGL surface format for VTK
 //   - Apply dark theme stylesheet
-//   - Create GatewayClient
+//   - Create GatewayClient, plus the MediaCache and MediaFetchManager in
+//     front of its DownloadMedia stream and the PlanCache behind GetPlan
+//   - Fetch the running task's plan for the operator nav map
 //   - Create MainWindow (Engineer mode) and OperatorWindow (Operator mode)
 //   - Wire up mode switching signals
 //   - Connect gateway client signals to both windows
+//   - Hidden diagnostics window (Ctrl+Shift+D) and optional RPC metrics dump
+//     (--rpc-metrics-dump FILE [--rpc-metrics-interval SEC])
+//   - Stream telemetry recording (--record-telemetry DIR) and replay
+//     (--replay-telemetry PATH [--replay-speed 1|10|max])
+//   - 3D robot twin in the engineer view (--robot-twin FILE|default); the
+//     same description drives the plan preview's arm poses
+//   - Nav map renderer (--nav-map-renderer raster|opengl)
+//   - Result export from the operator control panel (ResultExporter:
+//     images with defect overlays + captures.csv + report.json)
+//   - Fleet table in the operator window: status of several robots through
+//     a FleetClient on the same RpcEngine (--fleet id=host:port,...)
+//   - Inspection event filters per window; the subscription asks for their
+//     union (--event-types LIST, --event-points FROM-TO,
+//     --no-event-thumbnails)
+//   - Bandwidth governor: thumbnail inclusion / size, prefetch depth and
+//     download streams follow the link measured by RpcMetrics
+//     (--fixed-media-quality turns it off)
+//   - Frame-time profiler overlay (Ctrl+Shift+P; --profile records from
+//     startup, --profile-trace FILE writes a Chrome trace on exit)
+//   - Cold start: the engineer window is shown before the 3D view, the
+//     operator result panel and the operator native window are initialised;
+//     those follow one per event-loop turn (--eager-init builds everything
+//     before the first show).  Phase timings go to the log and, with
+//     --startup-timings FILE, as a JSON line to FILE (StartupTimeline)
 //   - Enter Qt event loop
 
+#include "core/FleetClient.h"
+#include "core/FrameProfiler.h"
 #include "core/GatewayClient.h"
+#include "core/MediaCache.h"
+#include "core/BandwidthGovernor.h"
+#include "core/MediaFetchManager.h"
+#include "core/PlanCache.h"
+#include "core/StartupTimeline.h"
+#include "core/TelemetryReplayer.h"
+#include "ui/DiagnosticsPanel.h"
+#include "ui/FrameProfilerOverlay.h"
 #include "ui/MainWindow.h"
 #include "ui/operator/OperatorWindow.h"
 #include "ui/operator/ControlPanel.h"
+#include "ui/operator/ResultExporter.h"
 #include "ui/operator/ResultPanel.h"
 #include "ui/operator/NavMapWidget.h"
+#include "scene/CadScene.h"
+#include "scene/PlanPreview.h"
 #include "scene/QVTKWidget.h"
+#include "scene/RobotTwin.h"
+#include "ui/SceneViewport.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QFileDialog>
+#include <QKeySequence>
+#include <QMessageBox>
+#include <QShortcut>
 #include <QSurfaceFormat>
+#include <QTimer>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace {
+
+/// Restricts \a filter by --event-types LIST (comma-separated info, warn,
+/// error, captured, defect) and --event-points FROM-TO.  Returns false with
+/// \a error set on an unknown type or a malformed range.
+bool restrictEventFilter(const QString& types, const QString& points,
+                         hmi::InspectionEventFilter* filter, QString* error)
+{
+    using T = hmi::InspectionEventType;
+    static const std::pair<const char*, T> kNames[] = {
+        { "info", T::Info }, { "warn", T::Warn }, { "error", T::Error },
+        { "captured", T::Captured }, { "defect", T::DefectFound },
+    };
+    if (!types.isEmpty()) {
+        uint32_t mask = 0;
+        for (const QString& name : types.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+            const auto it = std::find_if(std::begin(kNames), std::end(kNames),
+                                         [&name](const auto& entry) {
+                                             return name.trimmed() == QLatin1String(entry.first);
+                                         });
+            if (it == std::end(kNames)) {
+                *error = QStringLiteral("unknown event type \"%1\"").arg(name);
+                return false;
+            }
+            mask |= hmi::InspectionEventFilter::typeBit(it->second);
+        }
+        filter->typeMask = mask;
+    }
+    if (!points.isEmpty()) {
+        const QStringList range = points.split(QLatin1Char('-'));
+        bool okFrom = false;
+        bool okTo   = false;
+        const int from = range.value(0).toInt(&okFrom);
+        const int to   = range.value(1).toInt(&okTo);
+        if (range.size() != 2 || !okFrom || !okTo || from < 1 || to < from) {
+            *error = QStringLiteral("malformed point range \"%1\"").arg(points);
+            return false;
+        }
+        filter->minPointId = from;
+        filter->maxPointId = to;
+    }
+    return true;
+}
+
+} // namespace
 
 int main(int argc, char* argv[])
 {
+    // Startup phases are timed from here; phaseDone() closes the current one.
+    using StartupClock = hmi::StartupTimeline::Clock;
+    hmi::StartupTimeline& startup = hmi::StartupTimeline::instance();
+    StartupClock::time_point phaseStart = StartupClock::now();
+    const auto phaseDone = [&startup, &phaseStart](const char* name) {
+        const StartupClock::time_point now = StartupClock::now();
+        startup.record(name, phaseStart, now);
+        phaseStart = now;
+    };
+
     // VTK CRITICAL: Must set default surface format BEFORE creating QApplication.
     // QVTKWidget requires a core OpenGL 3.2+ profile with depth/stencil.
     QSurfaceFormat::setDefaultFormat(QVTKWidget::defaultFormat());
@@ -33,6 +145,106 @@ int main(int argc, char* argv[])
     app.setApplicationVersion("1.0");
     app.setOrganizationName("InspectionSystem");
 
+    // -----------------------------------------------------------------------
+    // Command line
+    // -----------------------------------------------------------------------
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    const QCommandLineOption metricsDumpOption(
+        QStringLiteral("rpc-metrics-dump"),
+        QStringLiteral("Append gateway RPC metrics as JSON lines to <file>."),
+        QStringLiteral("file"));
+    const QCommandLineOption metricsIntervalOption(
+        QStringLiteral("rpc-metrics-interval"),
+        QStringLiteral("Seconds between RPC metrics dumps (default 10)."),
+        QStringLiteral("sec"), QStringLiteral("10"));
+    const QCommandLineOption recordTelemetryOption(
+        QStringLiteral("record-telemetry"),
+        QStringLiteral("Record the system-state and event streams into <dir>."),
+        QStringLiteral("dir"));
+    const QCommandLineOption replayTelemetryOption(
+        QStringLiteral("replay-telemetry"),
+        QStringLiteral("Replay a telemetry recording (directory or segment file)."),
+        QStringLiteral("path"));
+    const QCommandLineOption replaySpeedOption(
+        QStringLiteral("replay-speed"),
+        QStringLiteral("Replay speed factor, or \"max\" (default 1)."),
+        QStringLiteral("speed"), QStringLiteral("1"));
+    const QCommandLineOption profileOption(
+        QStringLiteral("profile"),
+        QStringLiteral("Record frame times and GUI-thread stalls from startup."));
+    const QCommandLineOption profileTraceOption(
+        QStringLiteral("profile-trace"),
+        QStringLiteral("Write the profiler trace as Chrome trace JSON to <file> on exit."),
+        QStringLiteral("file"));
+    const QCommandLineOption navMapRendererOption(
+        QStringLiteral("nav-map-renderer"),
+        QStringLiteral("Operator nav map renderer: \"raster\" (default) or \"opengl\"."),
+        QStringLiteral("renderer"), QStringLiteral("raster"));
+    const QCommandLineOption eagerInitOption(
+        QStringLiteral("eager-init"),
+        QStringLiteral("Initialise the 3D view and both windows completely before showing "
+                       "the first one (default: defer to the first event-loop turns)."));
+    const QCommandLineOption startupTimingsOption(
+        QStringLiteral("startup-timings"),
+        QStringLiteral("Append the startup phase timings as a JSON line to <file>."),
+        QStringLiteral("file"));
+    const QCommandLineOption robotTwinOption(
+        QStringLiteral("robot-twin"),
+        QStringLiteral("Show the AGV + arm twin in the 3D view, described by the JSON <file> "
+                       "(\"default\": built-in arm and placeholder meshes)."),
+        QStringLiteral("file"));
+    const QCommandLineOption eventTypesOption(
+        QStringLiteral("event-types"),
+        QStringLiteral("Subscribe to these inspection event types only "
+                       "(comma-separated: info,warn,error,captured,defect)."),
+        QStringLiteral("list"));
+    const QCommandLineOption eventPointsOption(
+        QStringLiteral("event-points"),
+        QStringLiteral("Subscribe to events of inspection points <from>-<to> only."),
+        QStringLiteral("range"));
+    const QCommandLineOption noEventThumbnailsOption(
+        QStringLiteral("no-event-thumbnails"),
+        QStringLiteral("Leave capture thumbnails out of the event stream; the gallery "
+                       "downloads them when shown."));
+    const QCommandLineOption fixedMediaQualityOption(
+        QStringLiteral("fixed-media-quality"),
+        QStringLiteral("Always request full thumbnails and prefetch, whatever the link "
+                       "quality (no bandwidth governor)."));
+    const QCommandLineOption fleetOption(
+        QStringLiteral("fleet"),
+        QStringLiteral("Also watch these robots in the operator fleet table "
+                       "(comma-separated id=host:port)."),
+        QStringLiteral("robots"));
+    parser.addOption(metricsDumpOption);
+    parser.addOption(metricsIntervalOption);
+    parser.addOption(recordTelemetryOption);
+    parser.addOption(replayTelemetryOption);
+    parser.addOption(replaySpeedOption);
+    parser.addOption(profileOption);
+    parser.addOption(profileTraceOption);
+    parser.addOption(navMapRendererOption);
+    parser.addOption(robotTwinOption);
+    parser.addOption(eagerInitOption);
+    parser.addOption(startupTimingsOption);
+    parser.addOption(eventTypesOption);
+    parser.addOption(eventPointsOption);
+    parser.addOption(noEventThumbnailsOption);
+    parser.addOption(fixedMediaQualityOption);
+    parser.addOption(fleetOption);
+    parser.process(app);
+
+    const bool eagerInit = parser.isSet(eagerInitOption);
+    startup.setReportPath(parser.value(startupTimingsOption));
+
+    // Created here so it lives on the GUI thread.
+    hmi::FrameProfiler& profiler = hmi::FrameProfiler::instance();
+    if (parser.isSet(profileOption) || parser.isSet(profileTraceOption)) {
+        profiler.setEnabled(true);
+    }
+    phaseDone("application");
+
     // -----------------------------------------------------------------------
     // Dark palette — ensures ALL widgets default to dark background.
     // Without this, QScrollArea viewports, QGroupBox interiors, and other
@@ -166,42 +378,160 @@ int main(int argc, char* argv[])
             padding: 4px;
         }
     )");
+    phaseDone("theme");
 
     // -----------------------------------------------------------------------
     // Gateway client
     // -----------------------------------------------------------------------
-    // Initially disconnected; user must connect via UI.
-    hmi::GatewayClient client;
+    // Initially disconnected; user must connect via UI.  In fleet mode this
+    // client and the fleet's share one RpcEngine (one completion queue, a
+    // fixed set of pollers for every robot).
+    QVector<hmi::FleetRobot> fleetRobots;
+    if (parser.isSet(fleetOption)) {
+        QString error;
+        if (!hmi::FleetClient::parseRobots(parser.value(fleetOption), &fleetRobots, &error)) {
+            qWarning() << "Fleet mode disabled:" << error;
+        }
+    }
+    const auto engine = std::make_shared<hmi::RpcEngine>(
+        fleetRobots.isEmpty() ? 1 : hmi::FleetClient::kDefaultPollerThreads);
+    hmi::GatewayClient client(engine);
+    if (parser.isSet(metricsDumpOption)) {
+        const double sec = parser.value(metricsIntervalOption).toDouble();
+        client.setRpcMetricsDump(parser.value(metricsDumpOption),
+                                 sec > 0.0 ? qRound(sec * 1000.0) : 10000);
+    }
+    if (parser.isSet(recordTelemetryOption)) {
+        const hmi::Result r = client.startTelemetryRecording(parser.value(recordTelemetryOption));
+        if (!r.ok()) {
+            qWarning() << "Telemetry recording disabled:" << r.message;
+        }
+    }
+
+    // Schedules full-image downloads for the result panel (bounded,
+    // deduplicated, visible image before prefetch).
+    hmi::MediaFetchManager mediaFetcher(&client);
+
+    // Content-addressed media cache (disk LRU by sha256 + decoded pixmaps),
+    // so reopening results does not download the images again.
+    hmi::MediaCache mediaCache;
+    mediaFetcher.setCache(&mediaCache);
+
+    // Plans received once are read back from disk (see PlanCache).
+    client.setPlanCache(std::make_shared<hmi::PlanCache>());
+    phaseDone("gateway client");
 
     // -----------------------------------------------------------------------
     // Engineer mode window (MainWindow)
     // -----------------------------------------------------------------------
     MainWindow engineerWindow;
     engineerWindow.setGatewayClient(&client);
+
+    // Digital twin: forward kinematics on the system-state stream thread,
+    // applied at the system-state delivery cadence.
+    if (parser.isSet(robotTwinOption)) {
+        RobotTwin* twin = engineerWindow.sceneViewport()->cadScene()->robotTwin();
+        const QString path = parser.value(robotTwinOption);
+        RobotTwinDescription description = RobotTwinDescription::defaultArm();
+        QString error;
+        bool ok = path == QLatin1String("default")
+                  || RobotTwinDescription::fromJsonFile(path, &description, &error);
+        ok = ok && twin->load(description, &error);
+        if (ok) {
+            twin->attach(&client);
+            engineerWindow.sceneViewport()->cadScene()->planPreview()
+                ->setRobotDescription(description);
+        } else {
+            qWarning() << "Robot twin disabled:" << error;
+        }
+    }
     engineerWindow.setWindowTitle(QStringLiteral("检测系统 HMI - 工程师模式"));
     engineerWindow.resize(1600, 900);
+    phaseDone("engineer window");
 
     // -----------------------------------------------------------------------
     // Operator mode window (OperatorWindow)
     // -----------------------------------------------------------------------
     OperatorWindow operatorWindow;
     operatorWindow.setWindowTitle(QStringLiteral("检测系统 HMI - 操作员模式"));
+    if (parser.value(navMapRendererOption) == QLatin1String("opengl")) {
+        operatorWindow.navMap()->setRenderMode(NavMapWidget::RenderMode::OpenGL);
+    }
     operatorWindow.resize(800, 1024);
 
+    // Fleet overview: system state of every robot, each at its own rate.
+    std::unique_ptr<hmi::FleetClient> fleet;
+    if (!fleetRobots.isEmpty()) {
+        fleet = std::make_unique<hmi::FleetClient>(engine);
+        fleet->setSubscriptions(/*systemState=*/true, /*events=*/false);
+        for (const hmi::FleetRobot& robot : fleetRobots) {
+            fleet->addRobot(robot);
+        }
+        operatorWindow.setFleetClient(fleet.get());
+    }
+    phaseDone("operator window");
+
+    // -----------------------------------------------------------------------
+    // Event filters
+    // -----------------------------------------------------------------------
+    // Each window drops the event kinds it does not show before holding or
+    // converting anything; the subscription asks the gateway for the union,
+    // so events neither window shows are not sent at all (extensions).
+    {
+        hmi::InspectionEventFilter engineerFilter = engineerWindow.eventFilter();
+        hmi::InspectionEventFilter operatorFilter = operatorWindow.eventFilter();
+        QString error;
+        for (hmi::InspectionEventFilter* filter : { &engineerFilter, &operatorFilter }) {
+            if (!restrictEventFilter(parser.value(eventTypesOption),
+                                     parser.value(eventPointsOption), filter, &error)) {
+                break;
+            }
+            if (parser.isSet(noEventThumbnailsOption)) filter->includeThumbnails = false;
+        }
+        if (error.isEmpty()) {
+            engineerWindow.setEventFilter(engineerFilter);
+            operatorWindow.setEventFilter(operatorFilter);
+        } else {
+            qWarning() << "Event filter ignored:" << error;
+        }
+        engineerWindow.setSubscriptionFilter(hmi::InspectionEventFilter::united(
+            engineerWindow.eventFilter(), operatorWindow.eventFilter()));
+    }
+
     // -----------------------------------------------------------------------
     // Connect gateway signals to operator window
     // -----------------------------------------------------------------------
-    // System state updates are streamed continuously when subscribed.
+    // System state updates are streamed continuously when subscribed; the
+    // snapshot overload holds the latest one while the window is hidden.
     QObject::connect(&client, &hmi::GatewayClient::systemStateReceived,
-                     &operatorWindow, &OperatorWindow::updateTaskStatus);
+                     &operatorWindow, [&operatorWindow](const hmi::TaskStatusSnapshot& status) {
+                         operatorWindow.updateTaskStatus(status);
+                     });
+
+    // The running task's plan is drawn on the nav map; a plan ID seen before
+    // (a restart, a resumed task) comes from the plan cache.
+    QObject::connect(&client, &hmi::GatewayClient::systemStateReceived, &operatorWindow,
+                     [&client, shownPlanId = QString()](const hmi::TaskStatusSnapshot& status) mutable {
+                         if (status->planId.isEmpty() || status->planId == shownPlanId) return;
+                         shownPlanId = status->planId;
+                         client.getPlan(shownPlanId);
+                     });
+    QObject::connect(&client, &hmi::GatewayClient::getPlanFinished, &operatorWindow,
+                     [&operatorWindow](const hmi::GetPlanResponseSnapshot& plan) {
+                         if (plan->result.ok()) operatorWindow.navMap()->setPath(plan->path);
+                     });
 
     // Inspection events (captures, defects, etc.) are pushed to the result panel.
     QObject::connect(&client, &hmi::GatewayClient::inspectionEventReceived,
-                     &operatorWindow, &OperatorWindow::addEvent);
+                     &operatorWindow, [&operatorWindow](const hmi::InspectionEventSnapshot& event) {
+                         operatorWindow.addEvent(event);
+                     });
 
-    // Navigation map updates (used when switching tasks or maps).
+    // Navigation map updates (used when switching tasks or maps).  The
+    // thumbnail is shown at once; the full-resolution image follows through
+    // DownloadMedia and is tiled by the widget (see NavMapTilePyramid).
     QObject::connect(&client, &hmi::GatewayClient::navMapReceived,
-                     [&operatorWindow](hmi::Result result, hmi::NavMapInfo mapInfo) {
+                     [&operatorWindow, &mediaFetcher](hmi::Result result, hmi::NavMapInfo mapInfo) {
                          if (result.ok() && !mapInfo.image.media.mediaId.isEmpty()) {
                              // Convert thumbnail JPEG to QImage
                              QImage img;
@@ -209,22 +539,27 @@ int main(int argc, char* argv[])
                                  img.loadFromData(mapInfo.image.thumbnailJpeg, "JPEG");
                              }
                              operatorWindow.navMap()->setNavMap(mapInfo, img);
+                             mediaFetcher.request(mapInfo.image.media,
+                                                  hmi::MediaFetchManager::Priority::Prefetch);
                          }
                      });
 
     // -----------------------------------------------------------------------
     // Mode switching
     // -----------------------------------------------------------------------
+    // The incoming window is shown first: its showEvent applies what it held
+    // while idle, so it is current before the outgoing window goes idle and
+    // there is no frame without a window on screen.
     // Switch from Engineer → Operator mode.
     QObject::connect(&engineerWindow, &MainWindow::switchToOperatorMode, [&]() {
-        engineerWindow.hide();
         operatorWindow.show();
+        engineerWindow.hide();
     });
 
     // Switch from Operator → Engineer mode.
     QObject::connect(&operatorWindow, &OperatorWindow::switchToEngineerMode, [&]() {
-        operatorWindow.hide();
         engineerWindow.show();
+        operatorWindow.hide();
     });
 
     // -----------------------------------------------------------------------
@@ -239,21 +574,202 @@ int main(int argc, char* argv[])
     QObject::connect(operatorWindow.controlPanel(), &ControlPanel::stopRequested,
                      &client, &hmi::GatewayClient::stopInspection);
 
+    // -----------------------------------------------------------------------
+    // Result export (ControlPanel "导出结果")
+    // -----------------------------------------------------------------------
+    // Shares the client and the media cache; its own fetch queue keeps it
+    // from delaying the result panel's downloads.
+    ResultExporter resultExporter(&client, &mediaCache);
+    QObject::connect(operatorWindow.controlPanel(), &ControlPanel::exportRequested,
+                     [&operatorWindow, &resultExporter](const QString& taskId) {
+                         const QString dir = QFileDialog::getExistingDirectory(
+                             &operatorWindow, QStringLiteral("选择导出目录"));
+                         if (dir.isEmpty()) {
+                             return;
+                         }
+                         ResultExporter::Options options;
+                         options.outputDir = QDir(dir).filePath(
+                             QStringLiteral("task-%1").arg(taskId));
+                         QString error;
+                         if (!resultExporter.start(taskId, options, &error)) {
+                             QMessageBox::warning(&operatorWindow,
+                                                  QStringLiteral("导出失败"), error);
+                             return;
+                         }
+                         operatorWindow.controlPanel()->setExportProgress(0, 0);
+                     });
+    QObject::connect(&resultExporter, &ResultExporter::progress,
+                     operatorWindow.controlPanel(), &ControlPanel::setExportProgress);
+    QObject::connect(&resultExporter, &ResultExporter::finished,
+                     [&operatorWindow](const hmi::Result& result,
+                                       const ResultExporter::Summary& summary) {
+                         operatorWindow.controlPanel()->setExportProgress(-1, 0);
+                         qInfo() << "Export of" << summary.taskId << "to" << summary.outputDir
+                                 << ":" << summary.captures << "captures,"
+                                 << summary.imagesWritten << "images,"
+                                 << summary.imageFailures << "image failures in"
+                                 << summary.elapsedMs << "ms" << result.message;
+                         if (!result.ok()) {
+                             QMessageBox::warning(&operatorWindow, QStringLiteral("导出失败"),
+                                                  result.message);
+                         }
+                     });
+
     // -----------------------------------------------------------------------
     // Result panel download requests
     // -----------------------------------------------------------------------
+    operatorWindow.resultPanel()->setMediaCache(&mediaCache);
     QObject::connect(operatorWindow.resultPanel(), &ResultPanel::downloadImageRequested,
-                     &client, &hmi::GatewayClient::downloadMedia);
-    QObject::connect(&client, &hmi::GatewayClient::mediaDownloaded,
+                     [&mediaFetcher](const hmi::MediaRef& media) {
+                         mediaFetcher.request(media, hmi::MediaFetchManager::Priority::Visible);
+                     });
+    QObject::connect(operatorWindow.resultPanel(), &ResultPanel::prefetchImageRequested,
+                     [&mediaFetcher](const hmi::MediaRef& media) {
+                         mediaFetcher.request(media, hmi::MediaFetchManager::Priority::Prefetch);
+                     });
+    QObject::connect(operatorWindow.resultPanel(), &ResultPanel::thumbnailImageRequested,
+                     [&mediaFetcher](const hmi::MediaRef& media) {
+                         mediaFetcher.request(media, hmi::MediaFetchManager::Priority::Prefetch);
+                     });
+    QObject::connect(&mediaFetcher, &hmi::MediaFetchManager::mediaReady,
                      operatorWindow.resultPanel(), &ResultPanel::setFullImage);
+    QObject::connect(&mediaFetcher, &hmi::MediaFetchManager::mediaReady,
+                     operatorWindow.navMap(), &NavMapWidget::setMapImageData);
+    // Paged capture listings fill the gallery as each page arrives.
+    QObject::connect(&client, &hmi::GatewayClient::capturePageReceived,
+                     [&operatorWindow](hmi::Result result, QString /*taskId*/,
+                                       QVector<hmi::CaptureRecord> captures, bool /*last*/) {
+                         if (result.ok()) {
+                             operatorWindow.resultPanel()->appendCaptureRecords(captures);
+                         }
+                     });
+    // Pending downloads belong to the previous connection.
+    QObject::connect(&client, &hmi::GatewayClient::connectionStateChanged,
+                     [&mediaFetcher](bool connected) {
+                         if (!connected) {
+                             mediaFetcher.cancelAll();
+                         }
+                     });
+
+    // -----------------------------------------------------------------------
+    // Bandwidth governor: thumbnails, prefetch and download streams follow
+    // the measured link so that media never starves control / status.
+    // -----------------------------------------------------------------------
+    hmi::BandwidthGovernor bandwidthGovernor(&client);
+    QObject::connect(&bandwidthGovernor, &hmi::BandwidthGovernor::policyChanged,
+                     [&client, &mediaFetcher, &operatorWindow](
+                         const hmi::MediaPolicy& policy) {
+                         client.setMediaQuality(policy.quality);
+                         mediaFetcher.setMaxConcurrent(policy.maxMediaStreams);
+                         mediaFetcher.setPrefetchHeld(policy.holdPrefetch);
+                         operatorWindow.resultPanel()->setPrefetchDepth(policy.prefetchDepth);
+                     });
+    if (!parser.isSet(fixedMediaQualityOption)) {
+        QObject::connect(&client, &hmi::GatewayClient::connectionStateChanged,
+                         [&bandwidthGovernor](bool connected) {
+                             if (connected) {
+                                 bandwidthGovernor.start();
+                             } else {
+                                 bandwidthGovernor.stop();
+                             }
+                         });
+    }
+
+    // -----------------------------------------------------------------------
+    // Hidden diagnostics window – Ctrl+Shift+D in either mode
+    // -----------------------------------------------------------------------
+    DiagnosticsPanel diagnostics(&client);
+    for (QWidget* window : { static_cast<QWidget*>(&engineerWindow),
+                             static_cast<QWidget*>(&operatorWindow) }) {
+        auto* shortcut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+D")), window);
+        QObject::connect(shortcut, &QShortcut::activated,
+                         &diagnostics, &DiagnosticsPanel::toggle);
+    }
+
+    // -----------------------------------------------------------------------
+    // Frame-time profiler overlay – Ctrl+Shift+P, one per window
+    // -----------------------------------------------------------------------
+    for (QWidget* window : { static_cast<QWidget*>(&engineerWindow),
+                             static_cast<QWidget*>(&operatorWindow) }) {
+        auto* overlay  = new FrameProfilerOverlay(window);
+        auto* shortcut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+P")), window);
+        QObject::connect(shortcut, &QShortcut::activated,
+                         overlay, &FrameProfilerOverlay::toggle);
+    }
+
+    phaseDone("wiring");
+
+    // -----------------------------------------------------------------------
+    // Deferred initialisation
+    // -----------------------------------------------------------------------
+    // Work the first frame does not need.  Each step also runs on first use
+    // (SceneViewport / ResultPanel initialise themselves when shown or
+    // used), so the order only decides what is ready soonest.
+    std::deque<std::function<void()>> warmUp;
+    warmUp.push_back([&engineerWindow]() {
+        engineerWindow.sceneViewport()->initializeView();
+    });
+    warmUp.push_back([&operatorWindow]() {
+        operatorWindow.resultPanel()->ensureContents();
+    });
+    // Pre-warm the operator window: polish the widget tree and create the
+    // native window, so the first switch to operator mode only has to map
+    // it.  Until then the window is idle and holds the stream updates
+    // (ViewActivity).
+    warmUp.push_back([&operatorWindow]() {
+        hmi::StartupScope phase("operator window polish");
+        operatorWindow.ensurePolished();
+        operatorWindow.winId();
+    });
+    if (eagerInit) {
+        for (auto& step : warmUp) { step(); }
+        warmUp.clear();
+        phaseDone("eager initialization");
+    }
 
     // -----------------------------------------------------------------------
     // Show engineer window by default
     // -----------------------------------------------------------------------
     engineerWindow.show();
+    phaseDone("show");
+    startup.mark("first window shown");
+
+    // One step per event-loop turn, so input and repaints get in between.
+    QTimer warmUpTimer;
+    QObject::connect(&warmUpTimer, &QTimer::timeout, [&warmUp, &warmUpTimer, &startup]() {
+        if (warmUp.empty()) {
+            warmUpTimer.stop();
+            startup.complete();
+            return;
+        }
+        const std::function<void()> step = std::move(warmUp.front());
+        warmUp.pop_front();
+        step();
+    });
+    warmUpTimer.start(0);
+
+    // Replay starts once every receiver is connected.
+    if (parser.isSet(replayTelemetryOption)) {
+        const QString speedText = parser.value(replaySpeedOption);
+        const double speed = speedText.compare(QLatin1String("max"), Qt::CaseInsensitive) == 0
+                           ? hmi::TelemetryReplayer::kMaxSpeed
+                           : std::max(0.01, speedText.toDouble());
+        const hmi::Result r = client.startTelemetryReplay(parser.value(replayTelemetryOption), speed);
+        if (!r.ok()) {
+            qWarning() << "Telemetry replay failed:" << r.message;
+        }
+    }
 
     // -----------------------------------------------------------------------
     // Enter Qt event loop
     // -----------------------------------------------------------------------
-    return app.exec();
+    const int exitCode = app.exec();
+
+    if (parser.isSet(profileTraceOption)) {
+        QString error;
+        if (!profiler.writeChromeTrace(parser.value(profileTraceOption), &error)) {
+            qWarning() << "Profiler trace not written:" << error;
+        }
+    }
+    return exitCode;
 }
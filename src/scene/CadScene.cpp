@@ -1,14 +1,25 @@
 // src/scene/CadScene.cpp
 
 #include "CadScene.h"
+#include "CoverageEngine.h"
+#include "MeshCache.h"
+#include "MeshNormals.h"
+#include "PlanPreview.h"
+#include "RobotTwin.h"
 
 #include <QFileInfo>
+#include <QMetaMethod>
+#include <QMetaObject>
 #include <QString>
 
+#include <algorithm>
+#include <cmath>
+
 // VTK – rendering
 #include <vtkRenderer.h>
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
+#include <vtkInteractorObserver.h>
 #include <vtkCamera.h>
 #include <vtkLight.h>
 #include <vtkLightCollection.h>
@@ -21,8 +32,14 @@
 // VTK – geometry
 #include <vtkPolyData.h>
 #include <vtkPolyDataNormals.h>
+#include <vtkQuadricDecimation.h>
+#include <vtkTriangleFilter.h>
 #include <vtkPointData.h>
 #include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkStaticCellLocator.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
 
 // VTK – file readers
 #include <vtkSTLReader.h>
@@ -33,8 +50,103 @@
 #include <vtkAxesActor.h>
 #include <vtkOrientationMarkerWidget.h>
 
-// VTK – smart pointer
+// VTK – smart pointer / pipeline observers
 #include <vtkSmartPointer.h>
+#include <vtkAlgorithm.h>
+#include <vtkCallbackCommand.h>
+#include <vtkCommand.h>
+
+// ============================================================================
+// Background load job
+// ============================================================================
+
+struct CadScene::LoadJob {
+    QString           filePath;
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> finished{false};
+};
+
+namespace {
+
+/// Relays vtkCommand::ProgressEvent of one pipeline stage to a ProgressFn,
+/// throttled to whole percent, and aborts the algorithm once cancelled.
+struct StageObserver {
+    CadScene::LoadStage                                    stage;
+    const std::function<void(CadScene::LoadStage, double)>* progress;
+    const std::atomic<bool>*                               cancelled;
+    int                                                    lastPercent = -1;
+
+    static void onProgress(vtkObject* caller, unsigned long /*eventId*/,
+                           void* clientData, void* callData)
+    {
+        auto* self = static_cast<StageObserver*>(clientData);
+        if (self->cancelled && self->cancelled->load()) {
+            if (auto* algo = vtkAlgorithm::SafeDownCast(caller)) {
+                algo->AbortExecuteOn();
+            }
+            return;
+        }
+        const double fraction = callData ? *static_cast<double*>(callData) : 0.0;
+        const int percent = static_cast<int>(fraction * 100.0);
+        if (percent != self->lastPercent && self->progress && *self->progress) {
+            self->lastPercent = percent;
+            (*self->progress)(self->stage, fraction);
+        }
+    }
+
+    /// Attach to \a algo; the observer must outlive algo->Update().
+    void attach(vtkAlgorithm* algo)
+    {
+        auto cb = vtkSmartPointer<vtkCallbackCommand>::New();
+        cb->SetCallback(&StageObserver::onProgress);
+        cb->SetClientData(this);
+        algo->AddObserver(vtkCommand::ProgressEvent, cb);
+    }
+};
+
+bool isCancelled(const std::atomic<bool>* cancelled)
+{
+    return cancelled && cancelled->load();
+}
+
+/// Per LOD proxy cell: the model cell nearest to its centroid.
+constexpr const char* kLodSourceCellArray = "ModelCellId";
+
+/// Fill kLodSourceCellArray of \a proxy from the locator over the model.
+bool mapProxyCells(vtkPolyData* proxy, vtkStaticCellLocator* modelLocator,
+                   const std::atomic<bool>* cancelled)
+{
+    constexpr vtkIdType kCancelCheckCells = 4096;
+
+    const vtkIdType cells = proxy->GetNumberOfCells();
+    auto source = vtkSmartPointer<vtkIdTypeArray>::New();
+    source->SetName(kLodSourceCellArray);
+    source->SetNumberOfTuples(cells);
+
+    auto pts = vtkSmartPointer<vtkIdList>::New();
+    double centroid[3], p[3], closest[3], dist2 = 0.0;
+    vtkIdType cellId = -1;
+    int       subId  = 0;
+    for (vtkIdType c = 0; c < cells; ++c) {
+        if (c % kCancelCheckCells == 0 && isCancelled(cancelled)) return false;
+        proxy->GetCellPoints(c, pts);
+        centroid[0] = centroid[1] = centroid[2] = 0.0;
+        const vtkIdType n = pts->GetNumberOfIds();
+        for (vtkIdType k = 0; k < n; ++k) {
+            proxy->GetPoint(pts->GetId(k), p);
+            centroid[0] += p[0]; centroid[1] += p[1]; centroid[2] += p[2];
+        }
+        if (n > 0) {
+            centroid[0] /= n; centroid[1] /= n; centroid[2] /= n;
+        }
+        modelLocator->FindClosestPoint(centroid, closest, cellId, subId, dist2);
+        source->SetValue(c, cellId);
+    }
+    proxy->GetCellData()->AddArray(source);
+    return true;
+}
+
+} // anonymous namespace
 
 // ============================================================================
 // Construction / destruction
@@ -42,9 +154,39 @@
 
 CadScene::CadScene(QObject* parent)
     : QObject(parent)
-{}
+    , m_meshCache(std::make_unique<MeshCache>(QString(), MeshCache::kDefaultMaxBytes,
+                                              normalsPipelineKey()))
+{
+    m_robotTwin   = new RobotTwin(this);
+    m_planPreview = new PlanPreview(this);
+    m_coverage    = new CoverageEngine(this);
+
+    // Full resolution comes back once interaction has been idle this long.
+    m_lodIdleTimer.setSingleShot(true);
+    m_lodIdleTimer.setInterval(250);
+    connect(&m_lodIdleTimer, &QTimer::timeout, this, [this]() {
+        m_interacting = false;
+        applyLod();
+        render();
+    });
+}
 
-CadScene::~CadScene() = default;
+CadScene::~CadScene()
+{
+    if (m_observedStyle) {
+        m_observedStyle->RemoveObserver(m_startInteractionTag);
+        m_observedStyle->RemoveObserver(m_endInteractionTag);
+    }
+    if (m_lodJob) m_lodJob->cancelled = true;
+
+    // Raise the abort flag on every worker and wait for them; a reader that
+    // does not poll the flag still has to finish its current file.
+    if (m_loadJob) m_loadJob->cancelled = true;
+    for (auto& w : m_loadWorkers) {
+        w.job->cancelled = true;
+        if (w.thread.joinable()) w.thread.join();
+    }
+}
 
 // ============================================================================
 // Renderer binding
@@ -60,6 +202,21 @@ vtkRenderer* CadScene::renderer() const
     return m_renderer.Get();
 }
 
+RobotTwin* CadScene::robotTwin() const
+{
+    return m_robotTwin;
+}
+
+PlanPreview* CadScene::planPreview() const
+{
+    return m_planPreview;
+}
+
+CoverageEngine* CadScene::coverage() const
+{
+    return m_coverage;
+}
+
 // ============================================================================
 // Model loading
 // ============================================================================
@@ -71,17 +228,141 @@ bool CadScene::loadModel(const QString& filePath)
         return false;
     }
 
-    // Remove the previous model (if any) from the scene.
-    clearModel();
+    // A synchronous load supersedes any background one.
+    cancelLoad();
 
-    auto pd = readFile(filePath);
+    QString error;
+    const ProgressFn progress = [this](LoadStage stage, double fraction) {
+        emit loadProgress(stage, fraction);
+    };
+    auto pd = runLoadPipeline(filePath, m_meshCacheEnabled ? m_meshCache.get() : nullptr,
+                              progress, nullptr, &error);
     if (!pd) {
-        emit errorOccurred(QStringLiteral("Failed to read file: %1").arg(filePath));
+        emit errorOccurred(error);
         return false;
     }
 
-    ensureNormals(pd);
-    m_modelData = pd;
+    installModel(filePath, pd, buildLocator(pd, progress, nullptr));
+    return true;
+}
+
+void CadScene::loadModelAsync(const QString& filePath)
+{
+    if (!m_renderer) {
+        emit errorOccurred(QStringLiteral("Cannot load model: no renderer set."));
+        return;
+    }
+
+    cancelLoad();
+    reapLoadWorkers();
+
+    auto job = std::make_shared<LoadJob>();
+    job->filePath = filePath;
+    m_loadJob = job;
+
+    // The worker only captures the job, the cache and `this`; the destructor
+    // joins every worker, so neither queued deliveries nor cache access
+    // outlive the scene.
+    const MeshCache* cache = m_meshCacheEnabled ? m_meshCache.get() : nullptr;
+    std::thread worker([this, job, cache]() {
+        const ProgressFn progress = [this, job](LoadStage stage, double fraction) {
+            QMetaObject::invokeMethod(this, [this, job, stage, fraction]() {
+                if (job == m_loadJob) {
+                    emit loadProgress(stage, fraction);
+                }
+            }, Qt::QueuedConnection);
+        };
+
+        QString error;
+        vtkSmartPointer<vtkPolyData> pd =
+            runLoadPipeline(job->filePath, cache, progress, &job->cancelled, &error);
+        vtkSmartPointer<vtkStaticCellLocator> locator;
+        if (pd) {
+            locator = buildLocator(pd, progress, &job->cancelled);
+        }
+
+        job->finished = true;   // before posting: finishLoad() reaps this thread
+        QMetaObject::invokeMethod(this, [this, job, pd, locator, error]() {
+            finishLoad(job, pd, locator, error);
+        }, Qt::QueuedConnection);
+    });
+    m_loadWorkers.push_back(LoadWorker{job, std::move(worker)});
+
+    emit loadStarted(filePath);
+}
+
+void CadScene::cancelLoad()
+{
+    if (!m_loadJob) return;
+
+    m_loadJob->cancelled = true;
+    const QString filePath = m_loadJob->filePath;
+    m_loadJob.reset();   // the worker's result is now ignored
+    emit loadCancelled(filePath);
+}
+
+bool CadScene::isLoading() const
+{
+    return m_loadJob != nullptr;
+}
+
+void CadScene::setMeshCacheEnabled(bool enabled)
+{
+    m_meshCacheEnabled = enabled;
+}
+
+bool CadScene::isMeshCacheEnabled() const
+{
+    return m_meshCacheEnabled;
+}
+
+MeshCache* CadScene::meshCache() const
+{
+    return m_meshCache.get();
+}
+
+void CadScene::finishLoad(const std::shared_ptr<LoadJob>&       job,
+                          vtkSmartPointer<vtkPolyData>          pd,
+                          vtkSmartPointer<vtkStaticCellLocator> locator,
+                          const QString&                        error)
+{
+    reapLoadWorkers();
+    if (job != m_loadJob) return;   // superseded or cancelled
+    m_loadJob.reset();
+
+    if (!pd) {
+        emit errorOccurred(error);
+        return;
+    }
+
+    emit loadProgress(LoadStage::Finalizing, 0.0);
+    installModel(job->filePath, pd, locator);
+    emit loadProgress(LoadStage::Finalizing, 1.0);
+}
+
+void CadScene::reapLoadWorkers()
+{
+    auto done = [](LoadWorker& w) {
+        if (!w.job->finished.load()) return false;
+        if (w.thread.joinable()) w.thread.join();
+        return true;
+    };
+    m_loadWorkers.erase(std::remove_if(m_loadWorkers.begin(), m_loadWorkers.end(), done),
+                        m_loadWorkers.end());
+}
+
+void CadScene::installModel(const QString&                        filePath,
+                            vtkSmartPointer<vtkPolyData>          pd,
+                            vtkSmartPointer<vtkStaticCellLocator> locator)
+{
+    // Clearing the old model and framing the new one render as one frame.
+    UpdateBatch batch(this);
+
+    // Remove the previous model (if any) from the scene.
+    clearModel();
+
+    m_modelData    = pd;
+    m_modelLocator = locator ? locator : buildLocator(pd, ProgressFn(), nullptr);
 
     // Create mapper + actor.
     auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
@@ -102,18 +383,22 @@ bool CadScene::loadModel(const QString& filePath)
     resetCamera();
 
     emit modelLoaded(filePath);
-    return true;
+
+    startLodBuild();
 }
 
 void CadScene::clearModel()
 {
+    clearLod();
     if (m_modelActor && m_renderer) {
         m_renderer->RemoveActor(m_modelActor);
     }
-    m_modelActor  = nullptr;
-    m_modelData   = nullptr;
+    m_modelActor   = nullptr;
+    m_modelData    = nullptr;
+    m_modelLocator = nullptr;
     m_modelFilePath.clear();
 
+    render();
     emit modelCleared();
 }
 
@@ -141,6 +426,11 @@ vtkActor* CadScene::modelActor() const
     return m_modelActor.Get();
 }
 
+vtkAbstractCellLocator* CadScene::modelLocator() const
+{
+    return m_modelLocator.Get();
+}
+
 // ============================================================================
 // Camera control
 // ============================================================================
@@ -190,6 +480,24 @@ void CadScene::setViewIsometric()
 // ============================================================================
 
 void CadScene::render()
+{
+    if (m_updateDepth > 0) {
+        m_renderDeferred = true;
+        return;
+    }
+
+    // No viewport scheduling renders for us – draw immediately instead.
+    static const QMetaMethod renderRequestedSignal =
+        QMetaMethod::fromSignal(&CadScene::renderRequested);
+    if (!isSignalConnected(renderRequestedSignal)) {
+        renderNow();
+        return;
+    }
+
+    emit renderRequested();
+}
+
+void CadScene::renderNow()
 {
     if (!m_renderer) return;
     auto* rw = m_renderer->GetRenderWindow();
@@ -198,6 +506,275 @@ void CadScene::render()
     }
 }
 
+void CadScene::beginUpdate()
+{
+    ++m_updateDepth;
+}
+
+void CadScene::endUpdate()
+{
+    if (m_updateDepth == 0) return;
+    if (--m_updateDepth == 0 && m_renderDeferred) {
+        m_renderDeferred = false;
+        render();
+    }
+}
+
+bool CadScene::isUpdating() const
+{
+    return m_updateDepth > 0;
+}
+
+// ============================================================================
+// Level of detail
+// ============================================================================
+
+void CadScene::setInteractiveCellBudget(int cells)
+{
+    m_interactiveCellBudget = std::max(1, cells);
+    applyLod();
+}
+
+int CadScene::interactiveCellBudget() const
+{
+    return m_interactiveCellBudget;
+}
+
+int CadScene::lodLevelCount() const
+{
+    return static_cast<int>(m_lodLevels.size());
+}
+
+std::vector<vtkActor*> CadScene::lodActors() const
+{
+    std::vector<vtkActor*> actors;
+    actors.reserve(m_lodLevels.size());
+    for (const auto& level : m_lodLevels) actors.push_back(level.actor);
+    return actors;
+}
+
+void CadScene::syncLodCellArray(const char* name)
+{
+    vtkDataArray* values = m_modelData ? m_modelData->GetCellData()->GetArray(name) : nullptr;
+    if (!values) return;
+
+    for (const auto& level : m_lodLevels) {
+        vtkCellData* cd = level.data->GetCellData();
+        auto* source = vtkIdTypeArray::SafeDownCast(cd->GetArray(kLodSourceCellArray));
+        if (!source) continue;
+
+        vtkDataArray* out = cd->GetArray(name);
+        if (!out || out->GetDataType() != values->GetDataType()
+            || out->GetNumberOfComponents() != values->GetNumberOfComponents()) {
+            vtkSmartPointer<vtkDataArray> created =
+                vtk::TakeSmartPointer(values->NewInstance());
+            created->SetName(name);
+            created->SetNumberOfComponents(values->GetNumberOfComponents());
+            created->SetNumberOfTuples(level.cells);
+            cd->AddArray(created);
+            out = created;
+        }
+        const vtkIdType modelCells = values->GetNumberOfTuples();
+        for (vtkIdType c = 0; c < level.cells; ++c) {
+            const vtkIdType from = source->GetValue(c);
+            if (from >= 0 && from < modelCells) out->SetTuple(c, from, values);
+        }
+        out->Modified();
+    }
+}
+
+void CadScene::setInteracting(bool interacting)
+{
+    if (interacting) {
+        m_lodIdleTimer.stop();
+        if (!m_interacting) {
+            m_interacting = true;
+            applyLod();
+        }
+    } else if (m_interacting) {
+        m_lodIdleTimer.start();
+    }
+}
+
+void CadScene::ensureFullResolution()
+{
+    m_lodIdleTimer.stop();
+    if (m_interacting) {
+        m_interacting = false;
+        applyLod();
+    }
+}
+
+void CadScene::observeInteraction(vtkRenderWindowInteractor* interactor)
+{
+    if (m_observedStyle) {
+        m_observedStyle->RemoveObserver(m_startInteractionTag);
+        m_observedStyle->RemoveObserver(m_endInteractionTag);
+        m_observedStyle = nullptr;
+    }
+    vtkInteractorObserver* style = interactor ? interactor->GetInteractorStyle() : nullptr;
+    if (!style) return;
+
+    auto cb = vtkSmartPointer<vtkCallbackCommand>::New();
+    cb->SetClientData(this);
+    cb->SetCallback([](vtkObject*, unsigned long eventId, void* clientData, void*) {
+        static_cast<CadScene*>(clientData)->setInteracting(
+            eventId == vtkCommand::StartInteractionEvent);
+    });
+    m_startInteractionTag = style->AddObserver(vtkCommand::StartInteractionEvent, cb);
+    m_endInteractionTag   = style->AddObserver(vtkCommand::EndInteractionEvent, cb);
+    m_observedStyle       = style;
+}
+
+void CadScene::startLodBuild()
+{
+    clearLod();
+    if (!m_modelData || m_modelData->GetNumberOfCells() < kLodMinCells) return;
+
+    // The worker gets its own data object (sharing the arrays), so lazily
+    // built cell links on m_modelData (picking) never race the decimation.
+    auto input = vtkSmartPointer<vtkPolyData>::New();
+    input->ShallowCopy(m_modelData);
+
+    auto job = std::make_shared<LoadJob>();
+    job->filePath = m_modelFilePath;
+    m_lodJob = job;
+
+    std::thread worker([this, job, input]() {
+        auto levels = buildLodLevels(input, &job->cancelled);
+        job->finished = true;
+        QMetaObject::invokeMethod(this, [this, job, levels]() {
+            finishLodBuild(job, levels);
+        }, Qt::QueuedConnection);
+    });
+    m_loadWorkers.push_back(LoadWorker{job, std::move(worker)});
+}
+
+std::vector<vtkSmartPointer<vtkPolyData>>
+CadScene::buildLodLevels(vtkSmartPointer<vtkPolyData> input, const std::atomic<bool>* cancelled)
+{
+    constexpr int    kMaxLevels    = 3;
+    constexpr double kReduction    = 0.75;    // each level keeps 25 % of the previous
+    constexpr int    kMinProxyCells = 5000;
+
+    std::vector<vtkSmartPointer<vtkPolyData>> levels;
+
+    // Quadric decimation needs triangles (OBJ / PLY may carry quads).
+    auto tri = vtkSmartPointer<vtkTriangleFilter>::New();
+    tri->SetInputData(input);
+    tri->PassVertsOff();
+    tri->PassLinesOff();
+    StageObserver triObserver{LoadStage::Finalizing, nullptr, cancelled};   // abort only
+    triObserver.attach(tri);
+    tri->Update();
+    if (isCancelled(cancelled)) return {};
+
+    vtkSmartPointer<vtkPolyData> current = vtkSmartPointer<vtkPolyData>::New();
+    current->ShallowCopy(tri->GetOutput());
+
+    // Model cell ids of the proxy cells, so that cell arrays of the model
+    // (the coverage heatmap) can be shown on the proxies too.
+    auto modelLocator = vtkSmartPointer<vtkStaticCellLocator>::New();
+    modelLocator->SetDataSet(input);
+    modelLocator->BuildLocator();
+    if (isCancelled(cancelled)) return {};
+
+    for (int i = 0; i < kMaxLevels; ++i) {
+        if (current->GetNumberOfPolys() * (1.0 - kReduction) < kMinProxyCells) break;
+
+        auto decimate = vtkSmartPointer<vtkQuadricDecimation>::New();
+        decimate->SetInputData(current);
+        decimate->SetTargetReduction(kReduction);
+        decimate->VolumePreservationOn();
+        StageObserver observer{LoadStage::Finalizing, nullptr, cancelled};
+        observer.attach(decimate);
+        decimate->Update();
+        if (isCancelled(cancelled)) return {};
+
+        // Decimation drops the normals; proxies are small, so recompute.
+        auto normals = vtkSmartPointer<vtkPolyDataNormals>::New();
+        normals->SetInputConnection(decimate->GetOutputPort());
+        normals->ComputePointNormalsOn();
+        normals->ComputeCellNormalsOff();
+        normals->SplittingOff();
+        normals->ConsistencyOn();
+        normals->Update();
+
+        auto level = vtkSmartPointer<vtkPolyData>::New();
+        level->ShallowCopy(normals->GetOutput());
+        if (!mapProxyCells(level, modelLocator, cancelled)) return {};
+        levels.push_back(level);
+        current = level;
+    }
+    return levels;
+}
+
+void CadScene::finishLodBuild(const std::shared_ptr<LoadJob>&                  job,
+                              const std::vector<vtkSmartPointer<vtkPolyData>>& levels)
+{
+    reapLoadWorkers();
+    if (job != m_lodJob) return;   // model changed meanwhile
+    m_lodJob.reset();
+    if (levels.empty() || !m_modelActor || !m_renderer) return;
+
+    for (const auto& pd : levels) {
+        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        mapper->SetInputData(pd);
+        mapper->ScalarVisibilityOff();
+
+        LodLevel level;
+        level.data  = pd;
+        level.cells = pd->GetNumberOfCells();
+        level.actor = vtkSmartPointer<vtkActor>::New();
+        level.actor->SetMapper(mapper);
+        level.actor->SetProperty(m_modelActor->GetProperty());   // same material
+        level.actor->PickableOff();      // picks always hit the full mesh
+        level.actor->VisibilityOff();
+        m_renderer->AddActor(level.actor);
+        m_lodLevels.push_back(level);
+    }
+
+    applyLod();
+    emit lodReady(static_cast<int>(m_lodLevels.size()));
+}
+
+void CadScene::clearLod()
+{
+    if (m_lodJob) {
+        m_lodJob->cancelled = true;
+        m_lodJob.reset();
+    }
+    if (m_renderer) {
+        for (const auto& level : m_lodLevels) {
+            m_renderer->RemoveActor(level.actor);
+        }
+    }
+    m_lodLevels.clear();
+    if (m_modelActor) m_modelActor->VisibilityOn();
+}
+
+void CadScene::applyLod()
+{
+    if (!m_modelActor || !m_modelData) return;
+
+    // While interacting, draw the finest proxy that fits the budget.
+    const LodLevel* proxy = nullptr;
+    if (m_interacting && m_modelData->GetNumberOfCells() > m_interactiveCellBudget) {
+        for (const auto& level : m_lodLevels) {
+            if (level.cells <= m_interactiveCellBudget) {
+                proxy = &level;
+                break;
+            }
+        }
+        if (!proxy && !m_lodLevels.empty()) proxy = &m_lodLevels.back();
+    }
+
+    for (const auto& level : m_lodLevels) {
+        level.actor->SetVisibility(&level == proxy);
+    }
+    m_modelActor->SetVisibility(proxy == nullptr);
+}
+
 // ============================================================================
 // Orientation widget
 // ============================================================================
@@ -224,52 +801,107 @@ void CadScene::initOrientationWidget(vtkRenderWindowInteractor* interactor)
 // Private helpers
 // ============================================================================
 
-vtkSmartPointer<vtkPolyData> CadScene::readFile(const QString& filePath)
+vtkSmartPointer<vtkPolyData> CadScene::runLoadPipeline(const QString&           filePath,
+                                                       const MeshCache*         cache,
+                                                       const ProgressFn&        progress,
+                                                       const std::atomic<bool>* cancelled,
+                                                       QString*                 error)
+{
+    // Preprocessed geometry already carries normals: no parse, no filter.
+    QByteArray contentHash;   // computed by a missing lookup, reused by store()
+    if (cache) {
+        if (auto pd = cache->load(filePath, &contentHash)) {
+            if (progress) {
+                progress(LoadStage::Reading, 1.0);
+                progress(LoadStage::Normals, 1.0);
+            }
+            return pd;
+        }
+    }
+
+    auto pd = readFile(filePath, progress, cancelled, error);
+    if (!pd) return nullptr;
+
+    ensureNormals(pd, progress, cancelled);
+    if (isCancelled(cancelled)) {
+        if (error) *error = QStringLiteral("Loading cancelled: %1").arg(filePath);
+        return nullptr;
+    }
+
+    // Best effort: a failed store only costs the next load a parse.
+    if (cache) {
+        cache->store(filePath, pd, contentHash);
+    }
+    return pd;
+}
+
+namespace {
+
+/// Run \a reader and take its output without copying the arrays.
+template <typename Reader>
+vtkSmartPointer<vtkPolyData> runReader(const QString&                filePath,
+                                       CadScene::LoadStage           stage,
+                                       const std::function<void(CadScene::LoadStage, double)>& progress,
+                                       const std::atomic<bool>*      cancelled)
+{
+    auto reader = vtkSmartPointer<Reader>::New();
+    reader->SetFileName(filePath.toLocal8Bit().constData());
+
+    StageObserver observer{stage, &progress, cancelled};
+    observer.attach(reader);
+    reader->Update();
+
+    if (isCancelled(cancelled) || reader->GetOutput()->GetNumberOfPoints() == 0) {
+        return nullptr;
+    }
+    // ShallowCopy detaches the data object from the reader's pipeline while
+    // sharing its point / cell arrays (the old DeepCopy duplicated them).
+    auto pd = vtkSmartPointer<vtkPolyData>::New();
+    pd->ShallowCopy(reader->GetOutput());
+    return pd;
+}
+
+} // anonymous namespace
+
+vtkSmartPointer<vtkPolyData> CadScene::readFile(const QString&           filePath,
+                                                const ProgressFn&        progress,
+                                                const std::atomic<bool>* cancelled,
+                                                QString*                 error)
 {
     QFileInfo info(filePath);
     const QString ext = info.suffix().toLower();
 
+    vtkSmartPointer<vtkPolyData> pd;
     if (ext == QStringLiteral("stl")) {
-        auto reader = vtkSmartPointer<vtkSTLReader>::New();
-        reader->SetFileName(filePath.toLocal8Bit().constData());
-        reader->Update();
-        if (reader->GetOutput()->GetNumberOfPoints() == 0) {
-            return nullptr;
-        }
-        auto pd = vtkSmartPointer<vtkPolyData>::New();
-        pd->DeepCopy(reader->GetOutput());
-        return pd;
-    }
-
-    if (ext == QStringLiteral("obj")) {
-        auto reader = vtkSmartPointer<vtkOBJReader>::New();
-        reader->SetFileName(filePath.toLocal8Bit().constData());
-        reader->Update();
-        if (reader->GetOutput()->GetNumberOfPoints() == 0) {
-            return nullptr;
-        }
-        auto pd = vtkSmartPointer<vtkPolyData>::New();
-        pd->DeepCopy(reader->GetOutput());
-        return pd;
+        pd = runReader<vtkSTLReader>(filePath, LoadStage::Reading, progress, cancelled);
+    } else if (ext == QStringLiteral("obj")) {
+        pd = runReader<vtkOBJReader>(filePath, LoadStage::Reading, progress, cancelled);
+    } else if (ext == QStringLiteral("ply")) {
+        pd = runReader<vtkPLYReader>(filePath, LoadStage::Reading, progress, cancelled);
+    } else {
+        if (error) *error = QStringLiteral("Unsupported file format: .%1").arg(ext);
+        return nullptr;
     }
 
-    if (ext == QStringLiteral("ply")) {
-        auto reader = vtkSmartPointer<vtkPLYReader>::New();
-        reader->SetFileName(filePath.toLocal8Bit().constData());
-        reader->Update();
-        if (reader->GetOutput()->GetNumberOfPoints() == 0) {
-            return nullptr;
-        }
-        auto pd = vtkSmartPointer<vtkPolyData>::New();
-        pd->DeepCopy(reader->GetOutput());
-        return pd;
+    if (!pd && error) {
+        *error = isCancelled(cancelled)
+                 ? QStringLiteral("Loading cancelled: %1").arg(filePath)
+                 : QStringLiteral("Failed to read file: %1").arg(filePath);
     }
+    return pd;
+}
 
-    emit errorOccurred(QStringLiteral("Unsupported file format: .%1").arg(ext));
-    return nullptr;
+QByteArray CadScene::normalsPipelineKey()
+{
+    // Everything that changes what ensureNormals() produces.
+    const MeshNormals::Params params;
+    return QByteArrayLiteral("normals:point+cell,split=0,consistency=1,auto-orient=1")
+         + ",parallel-min-cells=" + QByteArray::number(static_cast<qlonglong>(params.minParallelCells));
 }
 
-void CadScene::ensureNormals(vtkSmartPointer<vtkPolyData>& pd)
+void CadScene::ensureNormals(vtkSmartPointer<vtkPolyData>& pd,
+                             const ProgressFn&             progress,
+                             const std::atomic<bool>*      cancelled)
 {
     // Check whether normals are already present on the point data.
     bool hasPointNormals = (pd->GetPointData()->GetNormals() != nullptr);
@@ -277,6 +909,17 @@ void CadScene::ensureNormals(vtkSmartPointer<vtkPolyData>& pd)
 
     if (hasPointNormals || hasCellNormals) return;
 
+    // Large plain polygon meshes: the multi-threaded equivalent of the
+    // filter below (same arrays, topology and orientation rules).
+    const MeshNormals::Params params;
+    if (MeshNormals::useParallel(pd, params)) {
+        const auto stageProgress = [&progress](double fraction) {
+            if (progress) progress(LoadStage::Normals, fraction);
+        };
+        if (auto out = MeshNormals::compute(pd, params, stageProgress, cancelled)) pd = out;
+        return;
+    }
+
     auto normals = vtkSmartPointer<vtkPolyDataNormals>::New();
     normals->SetInputData(pd);
     normals->ComputePointNormalsOn();
@@ -284,9 +927,36 @@ void CadScene::ensureNormals(vtkSmartPointer<vtkPolyData>& pd)
     normals->SplittingOff();          // preserve topology for picking
     normals->ConsistencyOn();
     normals->AutoOrientNormalsOn();
+
+    StageObserver observer{LoadStage::Normals, &progress, cancelled};
+    observer.attach(normals);
     normals->Update();
 
-    pd = normals->GetOutput();
+    if (isCancelled(cancelled)) return;
+
+    auto out = vtkSmartPointer<vtkPolyData>::New();
+    out->ShallowCopy(normals->GetOutput());
+    pd = out;
+}
+
+vtkSmartPointer<vtkStaticCellLocator> CadScene::buildLocator(vtkPolyData*             pd,
+                                                           const ProgressFn&        progress,
+                                                           const std::atomic<bool>* cancelled)
+{
+    if (!pd || isCancelled(cancelled)) return nullptr;
+    if (progress) progress(LoadStage::Indexing, 0.0);
+
+    // Build the cell links / cells here rather than lazily on the first
+    // GUI-thread pick.
+    pd->BuildCells();
+
+    auto locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+    locator->SetDataSet(pd);
+    locator->SetNumberOfCellsPerNode(8);
+    locator->BuildLocator();
+
+    if (progress) progress(LoadStage::Indexing, 1.0);
+    return isCancelled(cancelled) ? nullptr : locator;
 }
 
 void CadScene::setupDefaultLighting()
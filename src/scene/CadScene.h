@@ -3,13 +3,39 @@
 // CadScene – owns the VTK renderer and CAD model scene graph.
 //
 // Thread safety: all methods must be called from the Qt GUI thread.
+// loadModelAsync() parses the file and computes normals on a worker thread;
+// only the final actor swap runs on the GUI thread.
+// Large models get decimated level-of-detail proxies, built in the background
+// after load and drawn only while the camera is being dragged; the full mesh
+// returns once interaction has been idle briefly.  Proxies are never pickable:
+// modelActor() / modelPolyData() always refer to the full-resolution mesh.
+// Rendering is coalesced: scene mutations (here and in PointAnnotator) call
+// render(), which only marks the scene dirty and emits renderRequested(); the
+// viewport turns that into one repaint per display frame.  Bulk edits wrapped
+// in beginUpdate() / endUpdate() (or an UpdateBatch guard) render once.
 // The renderer is created externally (by SceneViewport) and injected via
 // setRenderer(); CadScene does not create a vtkRenderWindow itself.
+// robotTwin() is the digital-twin layer (AGV + arm at the reported state);
+// it is empty until RobotTwin::load() and does not affect camera fits.
+// planPreview() draws a planned path's camera frusta, TCP frames and arm
+// poses for every waypoint (empty until PlanPreview::show()).
+// coverage() colours the model by how many target / waypoint views see each
+// cell (CoverageEngine; off until its heatmap is shown).
 
 #pragma once
 
+#include <QByteArray>
 #include <QObject>
 #include <QString>
+#include <QTimer>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <vtkWeakPointer.h>
 
 // VTK forward declarations – avoid pulling all VTK headers into every TU
 // that includes this header.
@@ -18,8 +44,15 @@
 class vtkRenderer;
 class vtkActor;
 class vtkPolyData;
+class vtkAbstractCellLocator;
+class vtkStaticCellLocator;
 class vtkOrientationMarkerWidget;
 class vtkRenderWindowInteractor;
+class vtkInteractorObserver;
+class CoverageEngine;
+class MeshCache;
+class PlanPreview;
+class RobotTwin;
 
 /// \brief Manages the VTK scene for CAD model visualisation.
 ///
@@ -32,6 +65,15 @@ class CadScene : public QObject
     Q_OBJECT
 
 public:
+    /// Stages reported by loadProgress(), in order.
+    enum class LoadStage {
+        Reading,      ///< file parse (STL / OBJ / PLY reader)
+        Normals,      ///< MeshNormals / vtkPolyDataNormals pass
+        Indexing,     ///< cell locator build for picking
+        Finalizing,   ///< actor swap on the GUI thread
+    };
+    Q_ENUM(LoadStage)
+
     explicit CadScene(QObject* parent = nullptr);
     ~CadScene() override;
 
@@ -50,11 +92,32 @@ public:
     // Model loading
     // -----------------------------------------------------------------------
 
-    /// Load a CAD model from \a filePath.
+    /// Load a CAD model from \a filePath, blocking until done.
     /// Supports .stl, .obj, .ply (case-insensitive).
     /// Returns \c true on success; emits modelLoaded() or errorOccurred().
     bool loadModel(const QString& filePath);
 
+    /// Load a CAD model in the background and return immediately.
+    /// Emits loadStarted(), loadProgress() per stage, then exactly one of
+    /// modelLoaded(), errorOccurred() or loadCancelled().  A load already in
+    /// flight is cancelled first.  The current model stays on screen until
+    /// the new one is ready.
+    void loadModelAsync(const QString& filePath);
+
+    /// Cancel the background load, if any.  Emits loadCancelled().
+    void cancelLoad();
+
+    /// \c true while a background load is in flight.
+    bool isLoading() const;
+
+    /// Enable / disable the preprocessed mesh cache (enabled by default).
+    /// A cache hit skips both the file parse and the normals pass.
+    void setMeshCacheEnabled(bool enabled);
+    bool isMeshCacheEnabled() const;
+
+    /// The mesh cache (e.g. to clear it from a settings page).
+    MeshCache* meshCache() const;
+
     /// Remove the current model from the scene.
     void clearModel();
 
@@ -74,6 +137,11 @@ public:
     /// The VTK actor representing the model in the renderer (may be nullptr).
     vtkActor* modelActor() const;
 
+    /// Static cell locator over modelPolyData(), built once per loaded model
+    /// on the loader thread (may be nullptr).  Used by PointAnnotator for
+    /// click and hover picking.
+    vtkAbstractCellLocator* modelLocator() const;
+
     // -----------------------------------------------------------------------
     // Camera control
     // -----------------------------------------------------------------------
@@ -97,10 +165,92 @@ public:
     // Rendering
     // -----------------------------------------------------------------------
 
-    /// Request a single render frame.  Safe to call even if no render window
-    /// is attached yet.
+    /// Request a render frame.  Coalesced: any number of calls before the next
+    /// repaint produce one frame, and calls inside an update batch are deferred
+    /// until the batch ends.  When nothing is connected to renderRequested()
+    /// the scene falls back to renderNow().  Safe to call even if no render
+    /// window is attached yet.
     void render();
 
+    /// Render synchronously, bypassing coalescing and batching.
+    void renderNow();
+
+    /// Begin a batch of scene mutations; render requests are held back until
+    /// the matching endUpdate().  Calls nest.
+    void beginUpdate();
+
+    /// End a batch; issues one render request if any were held back.
+    void endUpdate();
+
+    /// \c true while inside beginUpdate() / endUpdate().
+    bool isUpdating() const;
+
+    /// RAII guard around beginUpdate() / endUpdate().
+    class UpdateBatch
+    {
+    public:
+        explicit UpdateBatch(CadScene* scene) : m_scene(scene)
+        {
+            if (m_scene) m_scene->beginUpdate();
+        }
+        ~UpdateBatch()
+        {
+            if (m_scene) m_scene->endUpdate();
+        }
+        UpdateBatch(const UpdateBatch&)            = delete;
+        UpdateBatch& operator=(const UpdateBatch&) = delete;
+
+    private:
+        CadScene* m_scene;
+    };
+
+    // -----------------------------------------------------------------------
+    // Level of detail
+    // -----------------------------------------------------------------------
+
+    /// Models above this many cells get LOD proxies.
+    static constexpr int kLodMinCells = 250000;
+
+    /// Cells drawn while interacting; the finest proxy within budget is used.
+    void setInteractiveCellBudget(int cells);
+    int  interactiveCellBudget() const;
+
+    /// Enter / leave interactive rendering.  Leaving restores full resolution
+    /// after a short idle delay so rapid wheel zooms stay on the proxy.
+    /// Normally driven by observeInteraction().
+    void setInteracting(bool interacting);
+
+    /// Leave interactive rendering immediately (no idle delay), so the full
+    /// mesh is visible – e.g. right before a pick.
+    void ensureFullResolution();
+
+    /// Follow the interactor style's Start/EndInteraction events.
+    void observeInteraction(vtkRenderWindowInteractor* interactor);
+
+    /// Number of LOD proxies currently available (0 while building).
+    int lodLevelCount() const;
+
+    /// The proxy actors, finest first (empty while building).
+    std::vector<vtkActor*> lodActors() const;
+
+    /// Copy the model cell array \a name onto every proxy: each proxy cell
+    /// shows the model cell nearest to it (mapped when the proxy was built).
+    /// Call after the model array changed or lodReady().
+    void syncLodCellArray(const char* name);
+
+    // -----------------------------------------------------------------------
+    // Digital twin
+    // -----------------------------------------------------------------------
+
+    /// The robot twin layer (owned by the scene; never null).
+    RobotTwin* robotTwin() const;
+
+    /// The plan-inspection layer (owned by the scene; never null).
+    PlanPreview* planPreview() const;
+
+    /// The inspection-coverage heatmap (owned by the scene; never null).
+    CoverageEngine* coverage() const;
+
     // -----------------------------------------------------------------------
     // Orientation widget
     // -----------------------------------------------------------------------
@@ -116,25 +266,133 @@ signals:
     /// Emitted after the model has been removed from the scene.
     void modelCleared();
 
+    /// A background load of \a filePath has started.
+    void loadStarted(const QString& filePath);
+
+    /// Progress of the background load; \a fraction is 0..1 within \a stage.
+    void loadProgress(CadScene::LoadStage stage, double fraction);
+
+    /// The background load of \a filePath was cancelled.
+    void loadCancelled(const QString& filePath);
+
+    /// LOD proxies for the current model are ready.
+    void lodReady(int levels);
+
     /// Emitted when a non-fatal or fatal error occurs (e.g. unsupported file).
     void errorOccurred(const QString& error);
 
+    /// The scene changed and needs a repaint.  Emitted at most once per batch;
+    /// connect to QVTKWidget::scheduleRender().
+    void renderRequested();
+
 private:
     vtkSmartPointer<vtkRenderer>                m_renderer;
     vtkSmartPointer<vtkActor>                   m_modelActor;
     vtkSmartPointer<vtkPolyData>                m_modelData;
+    vtkSmartPointer<vtkStaticCellLocator>       m_modelLocator;
     vtkSmartPointer<vtkOrientationMarkerWidget> m_orientationWidget;
+    RobotTwin*                                  m_robotTwin = nullptr;   ///< child QObject
+    PlanPreview*                                m_planPreview = nullptr; ///< child QObject
+    CoverageEngine*                             m_coverage = nullptr;    ///< child QObject
     QString                                     m_modelFilePath;
+    int                                         m_updateDepth = 0;
+    bool                                        m_renderDeferred = false;
+
+    // Background loading.  Superseded workers keep running until their
+    // reader notices the abort flag; they are joined once finished.
+    struct LoadJob;
+    struct LoadWorker {
+        std::shared_ptr<LoadJob> job;
+        std::thread              thread;
+    };
+    std::shared_ptr<LoadJob>                    m_loadJob;   ///< current, or null
+    std::vector<LoadWorker>                     m_loadWorkers;
+
+    // Level of detail: proxies finest first, each with its cell count.
+    struct LodLevel {
+        vtkSmartPointer<vtkActor>    actor;
+        vtkSmartPointer<vtkPolyData> data;        ///< proxy mesh + its model cell map
+        vtkIdType                    cells = 0;
+    };
+    std::vector<LodLevel>                       m_lodLevels;
+    std::shared_ptr<LoadJob>                    m_lodJob;    ///< proxy build in flight
+    int                                         m_interactiveCellBudget = 200000;
+    bool                                        m_interacting = false;
+    QTimer                                      m_lodIdleTimer;
+    vtkWeakPointer<vtkInteractorObserver>       m_observedStyle;
+    unsigned long                               m_startInteractionTag = 0;
+    unsigned long                               m_endInteractionTag   = 0;
+
+    // Shared with the workers, which are joined before it is destroyed.
+    std::unique_ptr<MeshCache>                  m_meshCache;
+    bool                                        m_meshCacheEnabled = true;
 
     // -----------------------------------------------------------------------
     // Helpers
     // -----------------------------------------------------------------------
 
-    /// Read geometry from \a filePath; returns nullptr on failure.
-    vtkSmartPointer<vtkPolyData> readFile(const QString& filePath);
+    /// Progress callback used by the load pipeline (any thread).
+    using ProgressFn = std::function<void(LoadStage stage, double fraction)>;
 
-    /// Ensure per-cell or per-point normals exist on \a pd.
-    void ensureNormals(vtkSmartPointer<vtkPolyData>& pd);
+    /// Mesh-cache lookup, else read + ensureNormals (+ cache store).
+    /// Thread-safe (touches no member state; \a cache may be null); returns
+    /// nullptr and sets \a error on failure or when \a cancelled is raised.
+    static vtkSmartPointer<vtkPolyData> runLoadPipeline(const QString&           filePath,
+                                                        const MeshCache*         cache,
+                                                        const ProgressFn&        progress,
+                                                        const std::atomic<bool>* cancelled,
+                                                        QString*                 error);
+
+    /// Read geometry from \a filePath; returns nullptr on failure.
+    static vtkSmartPointer<vtkPolyData> readFile(const QString&           filePath,
+                                                 const ProgressFn&        progress,
+                                                 const std::atomic<bool>* cancelled,
+                                                 QString*                 error);
+
+    /// Identifies the ensureNormals() configuration in MeshCache entries.
+    static QByteArray normalsPipelineKey();
+
+    /// Ensure per-cell or per-point normals exist on \a pd (MeshNormals on
+    /// all cores for large polygon meshes, vtkPolyDataNormals otherwise).
+    static void ensureNormals(vtkSmartPointer<vtkPolyData>& pd,
+                              const ProgressFn&             progress,
+                              const std::atomic<bool>*      cancelled);
+
+    /// Build the picking locator over \a pd (any thread); nullptr if cancelled.
+    static vtkSmartPointer<vtkStaticCellLocator> buildLocator(vtkPolyData*             pd,
+                                                              const ProgressFn&        progress,
+                                                              const std::atomic<bool>* cancelled);
+
+    /// Replace the current model with \a pd and its \a locator (GUI thread).
+    void installModel(const QString&                        filePath,
+                      vtkSmartPointer<vtkPolyData>          pd,
+                      vtkSmartPointer<vtkStaticCellLocator> locator);
+
+    /// Deliver the worker result for \a job (GUI thread).
+    void finishLoad(const std::shared_ptr<LoadJob>&       job,
+                    vtkSmartPointer<vtkPolyData>          pd,
+                    vtkSmartPointer<vtkStaticCellLocator> locator,
+                    const QString&                        error);
+
+    /// Join workers whose job has finished.
+    void reapLoadWorkers();
+
+    /// Start building LOD proxies for the current model (if large enough).
+    void startLodBuild();
+
+    /// Decimate \a input into successively coarser proxies (any thread).
+    static std::vector<vtkSmartPointer<vtkPolyData>>
+    buildLodLevels(vtkSmartPointer<vtkPolyData> input, const std::atomic<bool>* cancelled);
+
+    /// Install the proxies for \a job (GUI thread).
+    void finishLodBuild(const std::shared_ptr<LoadJob>&                  job,
+                        const std::vector<vtkSmartPointer<vtkPolyData>>& levels);
+
+    /// Cancel the proxy build and drop all proxies.
+    void clearLod();
+
+    /// Show the proxy or the full mesh according to m_interacting.
+    void applyLod();
 
     /// Build the default 3-point light rig for the loaded model.
     void setupDefaultLighting();
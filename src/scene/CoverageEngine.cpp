@@ -0,0 +1,836 @@
+// src/scene/CoverageEngine.cpp
+
+#include "CoverageEngine.h"
+#include "CadScene.h"
+#include "ParallelTasks.h"
+
+#include "TargetSync.h"
+
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QQuaternion>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+#include <vtkActor.h>
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkCellData.h>
+#include <vtkLookupTable.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkUnsignedShortArray.h>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr const char* kCoverageArray = "coverage";
+
+/// Polygons per extraction task / candidates per ray task.
+constexpr std::size_t kCellChunk = 16384;
+constexpr std::size_t kRayChunk  = 2048;
+
+constexpr uint32_t kLeafSize      = 4;
+constexpr float    kNearFactor    = 0.05f;   ///< near plane, in focus distances
+constexpr float    kMinFacingCos  = 0.02f;   ///< grazing angles see nothing
+constexpr float    kRayEndEpsilon = 1e-4f;   ///< relative; stops short of the target
+
+// Fallbacks for an unset CaptureConfig (as PointAnnotator draws frusta).
+constexpr double kDefaultFocusM  = 0.25;
+constexpr double kDefaultFovHDeg = 60.0;
+constexpr double kDefaultFovVDeg = 45.0;
+
+/// Heatmap colours by view count: not covered, then 1 .. kMaxLevel views.
+constexpr double kLevelColors[CoverageEngine::kMaxLevel + 1][3] = {
+    {0.85, 0.25, 0.22},   // red
+    {0.98, 0.80, 0.25},   // amber
+    {0.62, 0.85, 0.30},   // yellow-green
+    {0.25, 0.72, 0.40},   // green
+    {0.18, 0.52, 0.80},   // blue
+};
+
+struct Vec3 {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+inline Vec3 add(const Vec3& a, const Vec3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+inline Vec3 sub(const Vec3& a, const Vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+inline Vec3 scale(const Vec3& a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+inline float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3 cross(const Vec3& a, const Vec3& b)
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+inline bool normalise(Vec3& v)
+{
+    const float len = std::sqrt(dot(v, v));
+    if (!(len > 0.0f)) return false;
+    v.x /= len; v.y /= len; v.z /= len;
+    return true;
+}
+inline Vec3 toVec3(const QVector3D& v) { return { v.x(), v.y(), v.z() }; }
+
+/// FNV-1a step over \a bytes.
+uint64_t hashBytes(uint64_t h, const void* data, std::size_t bytes)
+{
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < bytes; ++i) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/// A camera frustum, in model units.
+struct View {
+    Vec3     eye;
+    Vec3     forward;   ///< unit optical axis
+    Vec3     right;     ///< unit image +x
+    Vec3     up;        ///< unit image up
+    uint64_t key = 0;   ///< view fingerprint, including the frustum shape
+};
+
+/// Frustum shape shared by every view of a job.
+struct Frustum {
+    float tanH = 0.0f, tanV = 0.0f;
+    float nearM = 0.0f, farM = 0.0f;
+    float cosTilt = kMinFacingCos;
+};
+
+Frustum frustumFor(const hmi::CaptureConfig& config, const CoverageEngine::Params& params)
+{
+    const double focus = config.focusDistanceM > 1e-6 ? config.focusDistanceM : kDefaultFocusM;
+    const double fovH  = config.fovHDeg > 1e-6 ? config.fovHDeg : kDefaultFovHDeg;
+    const double fovV  = config.fovVDeg > 1e-6 ? config.fovVDeg : kDefaultFovVDeg;
+    const double tilt  = config.maxTiltFromNormalDeg > 1e-6
+                         ? std::min(config.maxTiltFromNormalDeg, 90.0) : 90.0;
+
+    Frustum f;
+    f.tanH    = static_cast<float>(std::tan(fovH * 0.5 * kPi / 180.0));
+    f.tanV    = static_cast<float>(std::tan(fovV * 0.5 * kPi / 180.0));
+    f.nearM   = static_cast<float>(focus) * kNearFactor;
+    f.farM    = static_cast<float>(focus * std::max(1.0, params.maxRangeFactor));
+    f.cosTilt = std::max(kMinFacingCos, static_cast<float>(std::cos(tilt * kPi / 180.0)));
+    return f;
+}
+
+uint64_t frustumKey(const hmi::CaptureConfig& config, const CoverageEngine::Params& params)
+{
+    uint64_t h = hmi::TargetSync::fingerprint(config);
+    return hashBytes(h, &params.maxRangeFactor, sizeof(params.maxRangeFactor));
+}
+
+/// Target view: camera at surface - viewDirection * focus (as
+/// hmi::coord::cameraPosition()), basis as hmi::coord::frustumCorners(),
+/// rolled about the optical axis.
+View targetView(const hmi::InspectionTarget& target, double focusM, uint64_t frustum)
+{
+    Vec3 f = toVec3(target.view.viewDirection);
+    if (!normalise(f)) {
+        f = scale(toVec3(target.surface.normal), -1.0f);
+        if (!normalise(f)) f = { 0.0f, 0.0f, 1.0f };
+    }
+    Vec3 worldUp{ 0.0f, 0.0f, 1.0f };
+    if (std::abs(dot(f, worldUp)) > 0.99f) worldUp = { 0.0f, 1.0f, 0.0f };
+    Vec3 r = cross(f, worldUp);
+    normalise(r);
+    Vec3 u = cross(r, f);
+    normalise(u);
+
+    if (std::abs(target.view.rollDeg) > 1e-6) {
+        const float a = static_cast<float>(target.view.rollDeg * kPi / 180.0);
+        const float c = std::cos(a), s = std::sin(a);
+        const Vec3 rr = add(scale(r, c), scale(u, s));
+        const Vec3 uu = sub(scale(u, c), scale(r, s));
+        r = rr;
+        u = uu;
+    }
+
+    View v;
+    v.eye     = sub(toVec3(target.surface.position), scale(f, static_cast<float>(focusM)));
+    v.forward = f;
+    v.right   = r;
+    v.up      = u;
+    const uint64_t fp = hmi::TargetSync::fingerprint(target);
+    v.key = hashBytes(frustum, &fp, sizeof(fp));
+    return v;
+}
+
+/// Waypoint view: the planned camera pose (x right, y down, optical axis +Z).
+View waypointView(const hmi::InspectionPoint& wp, uint64_t frustum)
+{
+    const QQuaternion& q = wp.cameraPose.orientation;
+    View v;
+    v.eye     = toVec3(wp.cameraPose.position);
+    v.forward = toVec3(q.rotatedVector(QVector3D(0.0f, 0.0f, 1.0f)));
+    v.right   = toVec3(q.rotatedVector(QVector3D(1.0f, 0.0f, 0.0f)));
+    v.up      = toVec3(q.rotatedVector(QVector3D(0.0f, -1.0f, 0.0f)));
+    normalise(v.forward);
+    normalise(v.right);
+    normalise(v.up);
+
+    const float pose[7] = { v.eye.x, v.eye.y, v.eye.z,
+                            q.scalar(), q.x(), q.y(), q.z() };
+    uint64_t h = hashBytes(frustum, "wp", 2);
+    v.key = hashBytes(h, pose, sizeof(pose));
+    return v;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Mesh index: triangle soup + BVH
+// ============================================================================
+
+struct CoverageEngine::MeshIndex {
+    struct Triangle {
+        Vec3      a, e1, e2;   ///< vertex a, edges b - a and c - a
+        vtkIdType cellId;
+    };
+    /// Inner nodes: left child follows the node, `first` is the right
+    /// child.  Leaves: triangles [first, first + count).
+    struct Node {
+        Vec3     lo, hi;
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    std::vector<Triangle> triangles;   ///< in BVH leaf order
+    std::vector<Node>     nodes;
+    std::vector<double>   cellArea;    ///< per VTK cell (0 for non-polygons)
+    vtkIdType             cellCount = 0;
+    vtkIdType             polyCount = 0;
+    double                totalArea = 0.0;
+
+    static std::shared_ptr<const MeshIndex> build(vtkPolyData* model, int threads,
+                                                  const std::atomic<bool>* cancelled);
+
+    /// Candidate triangles (centroid in the frustum, facing the camera).
+    void query(const View& view, const Frustum& frustum, std::vector<uint32_t>& out) const;
+
+    /// Any triangle other than \a skip hit by the segment \a origin +
+    /// t * \a dir, t in (0, \a tmax)?
+    bool occluded(const Vec3& origin, const Vec3& dir, float tmax, uint32_t skip) const;
+
+private:
+    uint32_t buildNode(std::vector<uint32_t>& order, uint32_t begin, uint32_t end,
+                       const std::vector<Triangle>& tris, const std::vector<Vec3>& centroids);
+};
+
+std::shared_ptr<const CoverageEngine::MeshIndex>
+CoverageEngine::MeshIndex::build(vtkPolyData* model, int threads,
+                                 const std::atomic<bool>* cancelled)
+{
+    auto index = std::make_shared<MeshIndex>();
+    if (!model || !model->GetPoints() || !model->GetPolys()) return index;
+
+    // Polygons follow verts and lines in VTK's cell numbering.
+    const vtkIdType polyBase  = model->GetNumberOfVerts() + model->GetNumberOfLines();
+    const vtkIdType polyCount = model->GetPolys()->GetNumberOfCells();
+    index->cellCount = model->GetNumberOfCells();
+    index->polyCount = polyCount;
+    index->cellArea.assign(static_cast<std::size_t>(index->cellCount), 0.0);
+
+    // Fan triangulation, chunked across threads.
+    const std::size_t tasks = (static_cast<std::size_t>(polyCount) + kCellChunk - 1) / kCellChunk;
+    std::vector<std::vector<Triangle>> perTask(tasks);
+    parallelTasks(tasks, threads, [&](std::size_t task) {
+        if (isCancelled(cancelled)) return;
+        const vtkIdType begin = static_cast<vtkIdType>(task * kCellChunk);
+        const vtkIdType end   = std::min(polyCount, begin + static_cast<vtkIdType>(kCellChunk));
+
+        vtkPoints* points = model->GetPoints();
+        vtkSmartPointer<vtkCellArrayIterator> it =
+            vtk::TakeSmartPointer(model->GetPolys()->NewIterator());
+        std::vector<Triangle>& out = perTask[task];
+        out.reserve(static_cast<std::size_t>(end - begin) * 2);
+
+        double p[3];
+        vtkIdType npts = 0;
+        const vtkIdType* pts = nullptr;
+        std::vector<Vec3> verts;
+        for (vtkIdType poly = begin; poly < end; ++poly) {
+            it->GetCellAtId(poly, npts, pts);
+            if (npts < 3) continue;
+            verts.resize(static_cast<std::size_t>(npts));
+            for (vtkIdType k = 0; k < npts; ++k) {
+                points->GetPoint(pts[k], p);
+                verts[k] = { static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2]) };
+            }
+            const vtkIdType cellId = polyBase + poly;
+            double area = 0.0;
+            for (vtkIdType k = 1; k + 1 < npts; ++k) {
+                Triangle tri{ verts[0], sub(verts[k], verts[0]), sub(verts[k + 1], verts[0]), cellId };
+                const Vec3 n = cross(tri.e1, tri.e2);
+                const double a = 0.5 * std::sqrt(static_cast<double>(dot(n, n)));
+                if (!(a > 0.0)) continue;
+                area += a;
+                out.push_back(tri);
+            }
+            index->cellArea[static_cast<std::size_t>(cellId)] = area;   // one slot per task
+        }
+    });
+    if (isCancelled(cancelled)) return nullptr;
+
+    std::vector<Triangle> tris;
+    std::size_t total = 0;
+    for (const auto& chunk : perTask) total += chunk.size();
+    if (total >= std::numeric_limits<uint32_t>::max()) return index;   // beyond the node format
+    tris.reserve(total);
+    for (auto& chunk : perTask) {
+        tris.insert(tris.end(), chunk.begin(), chunk.end());
+        std::vector<Triangle>().swap(chunk);
+    }
+    for (double a : index->cellArea) index->totalArea += a;
+    if (tris.empty()) return index;
+
+    std::vector<Vec3> centroids(tris.size());
+    for (std::size_t i = 0; i < tris.size(); ++i) {
+        const Triangle& t = tris[i];
+        centroids[i] = add(t.a, scale(add(t.e1, t.e2), 1.0f / 3.0f));
+    }
+    std::vector<uint32_t> order(tris.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = static_cast<uint32_t>(i);
+
+    index->nodes.reserve(2 * tris.size() / kLeafSize + 1);
+    index->buildNode(order, 0, static_cast<uint32_t>(order.size()), tris, centroids);
+
+    index->triangles.resize(tris.size());
+    for (std::size_t i = 0; i < order.size(); ++i) index->triangles[i] = tris[order[i]];
+    return index;
+}
+
+uint32_t CoverageEngine::MeshIndex::buildNode(std::vector<uint32_t>& order,
+                                              uint32_t begin, uint32_t end,
+                                              const std::vector<Triangle>& tris,
+                                              const std::vector<Vec3>& centroids)
+{
+    const uint32_t self = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    Vec3 lo{ kInf, kInf, kInf }, hi{ -kInf, -kInf, -kInf };
+    Vec3 clo = lo, chi = hi;
+    auto grow = [](Vec3& l, Vec3& h, const Vec3& p) {
+        l = { std::min(l.x, p.x), std::min(l.y, p.y), std::min(l.z, p.z) };
+        h = { std::max(h.x, p.x), std::max(h.y, p.y), std::max(h.z, p.z) };
+    };
+    for (uint32_t i = begin; i < end; ++i) {
+        const Triangle& t = tris[order[i]];
+        grow(lo, hi, t.a);
+        grow(lo, hi, add(t.a, t.e1));
+        grow(lo, hi, add(t.a, t.e2));
+        grow(clo, chi, centroids[order[i]]);
+    }
+    nodes[self].lo = lo;
+    nodes[self].hi = hi;
+
+    const Vec3 extent = sub(chi, clo);
+    const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    const float axisExtent = axis == 0 ? extent.x : (axis == 1 ? extent.y : extent.z);
+    if (end - begin <= kLeafSize || !(axisExtent > 0.0f)) {
+        nodes[self].first = begin;
+        nodes[self].count = end - begin;
+        return self;
+    }
+
+    // Median split on the widest centroid axis.
+    const uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                     [&centroids, axis](uint32_t a, uint32_t b) {
+                         const Vec3& ca = centroids[a];
+                         const Vec3& cb = centroids[b];
+                         return axis == 0 ? ca.x < cb.x : (axis == 1 ? ca.y < cb.y : ca.z < cb.z);
+                     });
+    buildNode(order, begin, mid, tris, centroids);   // left = self + 1
+    const uint32_t right = buildNode(order, mid, end, tris, centroids);
+    nodes[self].first = right;
+    nodes[self].count = 0;
+    return self;
+}
+
+void CoverageEngine::MeshIndex::query(const View& view, const Frustum& frustum,
+                                      std::vector<uint32_t>& out) const
+{
+    if (nodes.empty()) return;
+
+    // Inside: dot(n, p - eye) >= c for all six planes.
+    struct Plane { Vec3 n; float c; };
+    const Plane planes[6] = {
+        { sub(scale(view.forward, frustum.tanH), view.right), 0.0f },
+        { add(scale(view.forward, frustum.tanH), view.right), 0.0f },
+        { sub(scale(view.forward, frustum.tanV), view.up),    0.0f },
+        { add(scale(view.forward, frustum.tanV), view.up),    0.0f },
+        { view.forward,              frustum.nearM },
+        { scale(view.forward, -1.0f), -frustum.farM },
+    };
+    auto boxOutside = [&](const Node& node) {
+        for (const Plane& pl : planes) {
+            const Vec3 pv{ pl.n.x >= 0.0f ? node.hi.x : node.lo.x,
+                           pl.n.y >= 0.0f ? node.hi.y : node.lo.y,
+                           pl.n.z >= 0.0f ? node.hi.z : node.lo.z };
+            if (dot(pl.n, sub(pv, view.eye)) < pl.c) return true;
+        }
+        return false;
+    };
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (boxOutside(node)) continue;
+        if (node.count == 0) {
+            const uint32_t self = static_cast<uint32_t>(&node - nodes.data());
+            if (top + 2 > 64) continue;   // deeper than any median-split tree
+            stack[top++] = node.first;
+            stack[top++] = self + 1;
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const Triangle& t = triangles[i];
+            const Vec3 c = add(t.a, scale(add(t.e1, t.e2), 1.0f / 3.0f));
+            const Vec3 d = sub(c, view.eye);
+            const float z = dot(d, view.forward);
+            if (z < frustum.nearM || z > frustum.farM) continue;
+            if (std::abs(dot(d, view.right)) > z * frustum.tanH) continue;
+            if (std::abs(dot(d, view.up)) > z * frustum.tanV) continue;
+
+            // Two-sided: an open shell is seen from either side.
+            Vec3 n = cross(t.e1, t.e2);
+            if (!normalise(n)) continue;
+            const float dist = std::sqrt(dot(d, d));
+            if (std::abs(dot(n, d)) < frustum.cosTilt * dist) continue;
+            out.push_back(i);
+        }
+    }
+}
+
+bool CoverageEngine::MeshIndex::occluded(const Vec3& o, const Vec3& dir, float tmax,
+                                         uint32_t skip) const
+{
+    auto inverse = [](float v) {
+        return std::abs(v) > 1e-12f ? 1.0f / v : std::copysign(1e30f, v);
+    };
+    const Vec3 inv{ inverse(dir.x), inverse(dir.y), inverse(dir.z) };
+
+    auto hitsBox = [&](const Node& node) {
+        float t0 = 0.0f, t1 = tmax;
+        const float lo[3] = { node.lo.x, node.lo.y, node.lo.z };
+        const float hi[3] = { node.hi.x, node.hi.y, node.hi.z };
+        const float oa[3] = { o.x, o.y, o.z };
+        const float ia[3] = { inv.x, inv.y, inv.z };
+        for (int k = 0; k < 3; ++k) {
+            float a = (lo[k] - oa[k]) * ia[k];
+            float b = (hi[k] - oa[k]) * ia[k];
+            if (a > b) std::swap(a, b);
+            t0 = std::max(t0, a);
+            t1 = std::min(t1, b);
+            if (t0 > t1) return false;
+        }
+        return true;
+    };
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const uint32_t idx = stack[--top];
+        const Node& node = nodes[idx];
+        if (!hitsBox(node)) continue;
+        if (node.count == 0) {
+            if (top + 2 > 64) continue;
+            stack[top++] = node.first;
+            stack[top++] = idx + 1;
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            if (i == skip) continue;
+            // Möller–Trumbore.
+            const Triangle& t = triangles[i];
+            const Vec3 p = cross(dir, t.e2);
+            const float det = dot(t.e1, p);
+            if (std::abs(det) < 1e-12f) continue;
+            const float invDet = 1.0f / det;
+            const Vec3 s = sub(o, t.a);
+            const float u = dot(s, p) * invDet;
+            if (u < 0.0f || u > 1.0f) continue;
+            const Vec3 q = cross(s, t.e1);
+            const float v = dot(dir, q) * invDet;
+            if (v < 0.0f || u + v > 1.0f) continue;
+            const float th = dot(t.e2, q) * invDet;
+            if (th > 0.0f && th < tmax) return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// Jobs
+// ============================================================================
+
+struct CoverageEngine::Job {
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> finished{false};
+    uint64_t          generation = 0;
+
+    // Input.
+    vtkSmartPointer<vtkPolyData>               model;   ///< for the first build
+    std::shared_ptr<const MeshIndex>           mesh;    ///< null: build it
+    Frustum                                    frustum;
+    int                                        threads = 1;
+    std::vector<View>                          views;
+    /// Per view: the cells it sees, null until traced.
+    std::vector<std::shared_ptr<const CellList>> seen;
+
+    // Output.
+    std::vector<uint16_t> counts;                ///< per VTK cell
+    Stats                 stats;
+
+    void run();
+};
+
+void CoverageEngine::Job::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!mesh) mesh = MeshIndex::build(model, threads, &cancelled);
+    model = nullptr;
+    if (!mesh || isCancelled(&cancelled)) return;
+
+    // 1. Frustum queries of the views still to trace, one task per view.
+    std::vector<std::size_t> todo;
+    for (std::size_t v = 0; v < views.size(); ++v) {
+        if (!seen[v]) todo.push_back(v);
+    }
+    std::vector<std::vector<uint32_t>> candidates(todo.size());
+    parallelTasks(todo.size(), threads, [&](std::size_t i) {
+        if (isCancelled(&cancelled)) return;
+        mesh->query(views[todo[i]], frustum, candidates[i]);
+    });
+    if (isCancelled(&cancelled)) return;
+
+    // 2. Occlusion rays, in fixed-size chunks across all traced views.
+    struct RayTask { std::size_t view; std::size_t begin, end; };
+    std::vector<RayTask> rayTasks;
+    std::vector<std::vector<char>> visible(todo.size());
+    for (std::size_t i = 0; i < todo.size(); ++i) {
+        visible[i].assign(candidates[i].size(), 0);
+        for (std::size_t b = 0; b < candidates[i].size(); b += kRayChunk) {
+            rayTasks.push_back({ i, b, std::min(candidates[i].size(), b + kRayChunk) });
+        }
+    }
+    parallelTasks(rayTasks.size(), threads, [&](std::size_t task) {
+        if (isCancelled(&cancelled)) return;
+        const RayTask& rt = rayTasks[task];
+        const View& view = views[todo[rt.view]];
+        for (std::size_t k = rt.begin; k < rt.end; ++k) {
+            const uint32_t tri = candidates[rt.view][k];
+            const MeshIndex::Triangle& t = mesh->triangles[tri];
+            const Vec3 c = add(t.a, scale(add(t.e1, t.e2), 1.0f / 3.0f));
+            Vec3 dir = sub(c, view.eye);
+            const float dist = std::sqrt(dot(dir, dir));
+            if (!(dist > 0.0f)) continue;
+            dir = scale(dir, 1.0f / dist);
+            visible[rt.view][k] = !mesh->occluded(view.eye, dir, dist * (1.0f - kRayEndEpsilon), tri);
+        }
+    });
+    if (isCancelled(&cancelled)) return;
+
+    // 3. Visible triangles -> sorted cell ids, per view.
+    parallelTasks(todo.size(), threads, [&](std::size_t i) {
+        auto cells = std::make_shared<CellList>();
+        for (std::size_t k = 0; k < candidates[i].size(); ++k) {
+            if (visible[i][k]) cells->push_back(mesh->triangles[candidates[i][k]].cellId);
+        }
+        std::sort(cells->begin(), cells->end());
+        cells->erase(std::unique(cells->begin(), cells->end()), cells->end());
+        seen[todo[i]] = std::move(cells);
+    });
+
+    // 4. View count per cell.
+    counts.assign(static_cast<std::size_t>(mesh->cellCount), 0);
+    for (const auto& cells : seen) {
+        for (vtkIdType cell : *cells) {
+            uint16_t& c = counts[static_cast<std::size_t>(cell)];
+            if (c < std::numeric_limits<uint16_t>::max()) ++c;
+        }
+    }
+
+    stats.views       = static_cast<int>(views.size());
+    stats.tracedViews = static_cast<int>(todo.size());
+    stats.totalCells  = mesh->polyCount;
+    stats.totalArea   = mesh->totalArea;
+    for (std::size_t cell = 0; cell < counts.size(); ++cell) {
+        if (counts[cell] == 0) continue;
+        ++stats.coveredCells;
+        stats.coveredArea += mesh->cellArea[cell];
+    }
+    stats.computeMs = static_cast<double>(timer.nsecsElapsed()) / 1e6;
+}
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+CoverageEngine::CoverageEngine(CadScene* scene)
+    : QObject(scene)
+    , m_scene(scene)
+    , m_lut(vtkSmartPointer<vtkLookupTable>::New())
+{
+    m_lut->SetNumberOfTableValues(kMaxLevel + 1);
+    m_lut->SetTableRange(0.0, kMaxLevel);
+    for (int i = 0; i <= kMaxLevel; ++i) {
+        m_lut->SetTableValue(i, kLevelColors[i][0], kLevelColors[i][1], kLevelColors[i][2], 1.0);
+    }
+    m_lut->Build();
+
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(kDebounceMs);
+    connect(&m_debounce, &QTimer::timeout, this, &CoverageEngine::launch);
+
+    connect(scene, &CadScene::modelLoaded, this, [this]() { onModelLoaded(); });
+    connect(scene, &CadScene::modelCleared, this, [this]() { onModelCleared(); });
+    connect(scene, &CadScene::lodReady, this, [this]() {
+        m_scene->syncLodCellArray(kCoverageArray);
+        applyMapperState();
+    });
+}
+
+CoverageEngine::~CoverageEngine()
+{
+    if (m_job) m_job->cancelled = true;
+    for (auto& w : m_workers) {
+        w.job->cancelled = true;
+        if (w.thread.joinable()) w.thread.join();
+    }
+}
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+void CoverageEngine::setParams(const Params& params)
+{
+    m_params = params;
+    schedule();
+}
+
+void CoverageEngine::setCaptureConfig(const hmi::CaptureConfig& config)
+{
+    m_config = config;
+    schedule();
+}
+
+void CoverageEngine::setTargets(const QVector<hmi::InspectionTarget>& targets)
+{
+    m_targets = targets;
+    schedule();
+}
+
+void CoverageEngine::setPlan(const hmi::InspectionPath& path)
+{
+    m_waypoints = path.waypoints;
+    schedule();
+}
+
+void CoverageEngine::setHeatmapVisible(bool visible)
+{
+    if (visible == m_visible) return;
+    m_visible = visible;
+    applyMapperState();
+    if (visible) {
+        schedule();
+    } else {
+        m_debounce.stop();
+    }
+    m_scene->render();
+}
+
+bool CoverageEngine::isBusy() const
+{
+    return m_job != nullptr || m_debounce.isActive();
+}
+
+// ============================================================================
+// Model lifecycle
+// ============================================================================
+
+void CoverageEngine::onModelLoaded()
+{
+    onModelCleared();
+
+    // The array is added once, before any worker reads the model; later
+    // results only overwrite its values.
+    vtkPolyData* model = m_scene->modelPolyData();
+    if (!model) return;
+    auto coverage = vtkSmartPointer<vtkUnsignedShortArray>::New();
+    coverage->SetName(kCoverageArray);
+    coverage->SetNumberOfComponents(1);
+    coverage->SetNumberOfTuples(model->GetNumberOfCells());
+    coverage->FillValue(0);
+    model->GetCellData()->AddArray(coverage);
+
+    applyMapperState();
+    schedule();
+}
+
+void CoverageEngine::onModelCleared()
+{
+    cancelJob();
+    m_debounce.stop();
+    m_mesh.reset();
+    m_seen.clear();
+    ++m_modelGeneration;
+    m_stats = Stats();
+    emit updated(m_stats);
+}
+
+void CoverageEngine::applyMapperState()
+{
+    // The LOD proxies carry a copy of the array (CadScene::syncLodCellArray),
+    // so the heatmap stays visible while the camera moves.
+    std::vector<vtkActor*> actors = m_scene->lodActors();
+    actors.push_back(m_scene->modelActor());
+    for (vtkActor* actor : actors) {
+        auto* mapper = actor ? vtkPolyDataMapper::SafeDownCast(actor->GetMapper()) : nullptr;
+        if (!mapper) continue;
+        if (m_visible) {
+            mapper->SetScalarModeToUseCellFieldData();
+            mapper->SelectColorArray(kCoverageArray);
+            mapper->SetColorModeToMapScalars();
+            mapper->SetLookupTable(m_lut);
+            mapper->SetScalarRange(0.0, kMaxLevel);
+            mapper->UseLookupTableScalarRangeOff();
+            mapper->ScalarVisibilityOn();
+        } else {
+            mapper->ScalarVisibilityOff();
+        }
+    }
+}
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+void CoverageEngine::schedule()
+{
+    if (!m_visible || !m_scene->hasModel()) return;
+    m_debounce.start();
+}
+
+void CoverageEngine::launch()
+{
+    if (!m_visible || !m_scene->hasModel()) return;
+    if (m_job) {
+        m_dirty = true;   // picked up when the running job finishes
+        return;
+    }
+    reapWorkers();
+
+    auto job = std::make_shared<Job>();
+    job->generation = m_modelGeneration;
+    job->mesh       = m_mesh;
+    if (!m_mesh) {
+        // The worker gets its own data object (sharing the arrays), so cell
+        // links that picking or the LOD build add to the scene model never
+        // race the BVH build.
+        if (vtkPolyData* model = m_scene->modelPolyData()) {
+            job->model = vtkSmartPointer<vtkPolyData>::New();
+            job->model->ShallowCopy(model);
+        }
+    }
+    job->frustum    = frustumFor(m_config, m_params);
+    job->threads    = workerThreads(m_params.threads);
+
+    const uint64_t frustum = frustumKey(m_config, m_params);
+    const double focusM = m_config.focusDistanceM > 1e-6 ? m_config.focusDistanceM : kDefaultFocusM;
+    job->views.reserve(static_cast<std::size_t>(m_targets.size() + m_waypoints.size()));
+    for (const auto& target : m_targets) job->views.push_back(targetView(target, focusM, frustum));
+    for (const auto& wp : m_waypoints) job->views.push_back(waypointView(wp, frustum));
+    job->seen.resize(job->views.size());
+    for (std::size_t v = 0; v < job->views.size(); ++v) {
+        auto it = m_seen.find(job->views[v].key);
+        if (it != m_seen.end()) job->seen[v] = it->second;
+    }
+
+    m_job   = job;
+    m_dirty = false;
+    std::thread worker([this, job]() {
+        job->run();
+        job->finished = true;   // before posting: finishJob() reaps this thread
+        QMetaObject::invokeMethod(this, [this, job]() { finishJob(job); },
+                                  Qt::QueuedConnection);
+    });
+    m_workers.push_back(Worker{job, std::move(worker)});
+
+    emit busy();
+}
+
+void CoverageEngine::finishJob(const std::shared_ptr<Job>& job)
+{
+    reapWorkers();
+    if (job != m_job) return;   // cancelled or superseded
+    m_job.reset();
+    if (job->cancelled || !job->mesh || job->generation != m_modelGeneration) return;
+
+    // Keep what the job knows about the current views; drop the rest.
+    m_mesh = job->mesh;
+    m_seen.clear();
+    for (std::size_t v = 0; v < job->views.size(); ++v) {
+        if (job->seen[v]) m_seen[job->views[v].key] = job->seen[v];
+    }
+
+    if (m_dirty) {
+        // The inputs moved on while tracing; trace what is still missing
+        // and show the result once it matches them.
+        launch();
+        return;
+    }
+    if (job->counts.empty()) return;
+    applyHeatmap(job->counts);
+    m_stats = job->stats;
+    emit updated(m_stats);
+}
+
+void CoverageEngine::applyHeatmap(const std::vector<uint16_t>& counts)
+{
+    vtkPolyData* model = m_scene->modelPolyData();
+    auto* coverage = model
+        ? vtkUnsignedShortArray::SafeDownCast(model->GetCellData()->GetArray(kCoverageArray))
+        : nullptr;
+    if (!coverage || coverage->GetNumberOfTuples() != static_cast<vtkIdType>(counts.size())) {
+        return;
+    }
+    std::memcpy(coverage->GetPointer(0), counts.data(), counts.size() * sizeof(uint16_t));
+    coverage->Modified();
+    m_scene->syncLodCellArray(kCoverageArray);
+    if (m_visible) m_scene->render();
+}
+
+void CoverageEngine::cancelJob()
+{
+    if (!m_job) return;
+    m_job->cancelled = true;
+    m_job.reset();
+    m_dirty = false;
+}
+
+void CoverageEngine::reapWorkers()
+{
+    auto done = [](Worker& w) {
+        if (!w.job->finished.load()) return false;
+        if (w.thread.joinable()) w.thread.join();
+        return true;
+    };
+    m_workers.erase(std::remove_if(m_workers.begin(), m_workers.end(), done),
+                    m_workers.end());
+}
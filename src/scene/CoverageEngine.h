@@ -0,0 +1,153 @@
+// src/scene/CoverageEngine.h
+//
+// CoverageEngine – the inspection-coverage layer of CadScene: which model
+// triangles the current targets and the current plan actually see, drawn as
+// a per-cell heatmap on CadScene::modelActor().
+//
+// A view is a camera frustum:
+//   - target: camera at surface - viewDirection * focusDistance (as
+//     hmi::coord::cameraPosition()), looking along the ViewHint, rolled by
+//     rollDeg, field of view from the CaptureConfig
+//   - waypoint: InspectionPoint::cameraPose (x right, y down, optical axis
+//     +Z, as PlanPreview draws it), same field of view
+// A cell counts as seen by a view when its triangle centroid lies inside the
+// frustum between 0.05 and Params::maxRangeFactor focus distances, faces the
+// camera within CaptureConfig::maxTiltFromNormalDeg (90° when unset), and
+// the ray from the camera to the centroid hits no other triangle.  The ray
+// test runs against a BVH over the triangulated model that is built once
+// per model on the worker.  The heatmap scalar is the number of views that
+// see the cell (0 = not covered, clamped at kMaxLevel).
+//
+// Recomputation never blocks the GUI thread: setTargets() / setPlan() /
+// setCaptureConfig() are coalesced for kDebounceMs and one worker job runs
+// at a time, its ray tests split across all cores.  Results are kept per
+// view fingerprint (TargetSync::fingerprint plus the capture config), so
+// adding or moving a target traces that one view only; edits made while a
+// job runs are picked up by the next job.
+//
+// Thread safety: all methods must be called from the Qt GUI thread; signals
+// are emitted on the GUI thread.
+
+#pragma once
+
+#include "Types.h"
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkType.h>
+
+class CadScene;
+class vtkLookupTable;
+
+class CoverageEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// View counts at and above this share the top heatmap colour.
+    static constexpr int kMaxLevel = 4;
+    /// Quiet period before a change starts a recomputation.
+    static constexpr int kDebounceMs = 80;
+
+    struct Params {
+        double maxRangeFactor = 1.5;   ///< depth limit, in focus distances
+        int    threads = 0;            ///< 0 = hardware concurrency
+    };
+
+    /// Result of the latest completed computation.
+    struct Stats {
+        int       views = 0;
+        int       tracedViews = 0;     ///< views traced by the job (rest reused)
+        vtkIdType coveredCells = 0;
+        vtkIdType totalCells = 0;      ///< surface cells (polygons)
+        double    coveredArea = 0.0;   ///< model units²
+        double    totalArea = 0.0;
+        double    computeMs = 0.0;     ///< worker time, including any BVH build
+
+        [[nodiscard]] double coveredFraction() const noexcept
+        {
+            return totalArea > 0.0 ? coveredArea / totalArea : 0.0;
+        }
+    };
+
+    explicit CoverageEngine(CadScene* scene);
+    ~CoverageEngine() override;
+
+    void setParams(const Params& params);
+    [[nodiscard]] Params params() const { return m_params; }
+
+    /// Field of view, focus distance and tilt limit of every view.
+    void setCaptureConfig(const hmi::CaptureConfig& config);
+
+    /// Replace the target views.
+    void setTargets(const QVector<hmi::InspectionTarget>& targets);
+
+    /// Replace the waypoint views (an empty path removes them).
+    void setPlan(const hmi::InspectionPath& path);
+
+    /// Show / hide the heatmap.  Hidden, nothing is computed; showing it
+    /// brings the result up to date.
+    void setHeatmapVisible(bool visible);
+    [[nodiscard]] bool isHeatmapVisible() const { return m_visible; }
+
+    /// \c true while a job is running or scheduled.
+    [[nodiscard]] bool isBusy() const;
+
+    [[nodiscard]] Stats stats() const { return m_stats; }
+
+signals:
+    /// A recomputation has started.
+    void busy();
+
+    /// The heatmap shows \a stats.
+    void updated(CoverageEngine::Stats stats);
+
+private:
+    struct MeshIndex;
+    struct Job;
+    struct Worker {
+        std::shared_ptr<Job> job;
+        std::thread          thread;
+    };
+    using CellList = std::vector<vtkIdType>;   ///< sorted cell ids
+
+    void onModelLoaded();
+    void onModelCleared();
+    void schedule();
+    void launch();
+    void finishJob(const std::shared_ptr<Job>& job);
+    void applyHeatmap(const std::vector<uint16_t>& counts);
+    void applyMapperState();
+    void cancelJob();
+    void reapWorkers();
+
+    CadScene*                               m_scene = nullptr;
+    Params                                  m_params;
+    hmi::CaptureConfig                      m_config;
+    QVector<hmi::InspectionTarget>          m_targets;
+    QVector<hmi::InspectionPoint>           m_waypoints;
+    bool                                    m_visible = false;
+
+    /// Built by the first job per model; shared read-only with later jobs.
+    std::shared_ptr<const MeshIndex>        m_mesh;
+    /// Cells seen per view fingerprint.
+    std::unordered_map<uint64_t, std::shared_ptr<const CellList>> m_seen;
+    uint64_t                                m_modelGeneration = 0;
+
+    std::shared_ptr<Job>                    m_job;       ///< running, or null
+    bool                                    m_dirty = false;   ///< changed since launch
+    QTimer                                  m_debounce;
+    std::vector<Worker>                     m_workers;   ///< joined in the destructor
+
+    vtkSmartPointer<vtkLookupTable>         m_lut;
+    Stats                                   m_stats;
+};
@@ -0,0 +1,420 @@
+// src/scene/MeshCache.cpp
+//
+// Implementation of MeshCache – see MeshCache.h.
+
+#include "MeshCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+// VTK – geometry
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkFloatArray.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkTypeInt64Array.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr char     kMagic[8]    = {'H', 'M', 'I', 'M', 'E', 'S', 'H', '1'};
+constexpr uint32_t kVersion     = 2;
+constexpr qint64   kAlignment   = 4096;   // page size: each section mappable
+constexpr int      kHashHexSize = 64;     // SHA-256, hex
+constexpr int      kVariantSize = 16;     // hex digits of the entry variant
+
+enum Section : int {
+    Points = 0,
+    PointNormals,
+    CellNormals,
+    Offsets,
+    Connectivity,
+    SectionCount
+};
+
+enum Flags : uint32_t {
+    HasPointNormals = 1u << 0,
+    HasCellNormals  = 1u << 1,
+};
+
+struct EntryHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t numPoints;
+    uint64_t numCells;
+    uint64_t connectivitySize;
+    uint64_t offset[SectionCount];   ///< byte offset of each section
+    uint64_t bytes[SectionCount];    ///< byte length; 0 = absent
+    char     contentHash[kHashHexSize];
+};
+static_assert(sizeof(EntryHeader) <= kAlignment, "header must fit the first page");
+
+qint64 alignUp(qint64 v)
+{
+    return (v + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+bool isHashHex(const QByteArray& hex)
+{
+    if (hex.size() != kHashHexSize) return false;
+    return std::all_of(hex.begin(), hex.end(), [](char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+    });
+}
+
+/// \a array as float32 with 3 components, or nullptr.
+vtkSmartPointer<vtkFloatArray> asFloat3(vtkDataArray* array, vtkIdType tuples)
+{
+    if (!array || array->GetNumberOfComponents() != 3
+        || array->GetNumberOfTuples() != tuples) {
+        return nullptr;
+    }
+    if (auto* f = vtkFloatArray::SafeDownCast(array)) {
+        return f;
+    }
+    auto f = vtkSmartPointer<vtkFloatArray>::New();
+    f->DeepCopy(array);   // converts element type
+    return f;
+}
+
+vtkSmartPointer<vtkFloatArray> floatArray(const uchar* src, uint64_t tuples)
+{
+    auto a = vtkSmartPointer<vtkFloatArray>::New();
+    a->SetNumberOfComponents(3);
+    a->SetNumberOfTuples(static_cast<vtkIdType>(tuples));
+    std::memcpy(a->GetPointer(0), src, tuples * 3 * sizeof(float));
+    return a;
+}
+
+vtkSmartPointer<vtkTypeInt64Array> int64Array(const uchar* src, uint64_t count)
+{
+    auto a = vtkSmartPointer<vtkTypeInt64Array>::New();
+    a->SetNumberOfValues(static_cast<vtkIdType>(count));
+    std::memcpy(a->GetPointer(0), src, count * sizeof(int64_t));
+    return a;
+}
+
+} // anonymous namespace
+
+// ===========================================================================
+// Lifetime
+// ===========================================================================
+
+MeshCache::MeshCache(const QString& rootDir, qint64 maxBytes, const QByteArray& pipelineKey)
+    : m_root(rootDir.isEmpty()
+                 ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                       + QStringLiteral("/meshes")
+                 : rootDir)
+    , m_maxBytes(std::max<qint64>(0, maxBytes))
+    , m_variant(QCryptographicHash::hash(QByteArray::number(kVersion) + '\n' + pipelineKey,
+                                         QCryptographicHash::Sha1)
+                    .toHex()
+                    .left(kVariantSize))
+{
+    QDir().mkpath(m_root + QStringLiteral("/index"));
+}
+
+QString MeshCache::indexPath(const QFileInfo& source) const
+{
+    const QByteArray key = source.absoluteFilePath().toUtf8()
+        + '\n' + QByteArray::number(source.size())
+        + '\n' + QByteArray::number(source.lastModified().toMSecsSinceEpoch());
+    return m_root + QStringLiteral("/index/")
+         + QString::fromLatin1(QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex());
+}
+
+QString MeshCache::entryPath(const QByteArray& contentHashHex) const
+{
+    return m_root + QLatin1Char('/') + QString::fromLatin1(contentHashHex)
+         + QLatin1Char('-') + QString::fromLatin1(m_variant) + QStringLiteral(".mesh");
+}
+
+QByteArray MeshCache::contentHash(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file)) return QByteArray();
+    return hash.result().toHex();
+}
+
+// ===========================================================================
+// Lookup
+// ===========================================================================
+
+vtkSmartPointer<vtkPolyData> MeshCache::load(const QString& sourcePath,
+                                             QByteArray*    contentHashHex) const
+{
+    const QFileInfo source(sourcePath);
+    if (!source.isFile()) return nullptr;
+
+    // Fast path: path + size + mtime seen before.
+    const QString index = indexPath(source);
+    QFile indexFile(index);
+    if (indexFile.open(QIODevice::ReadOnly)) {
+        const QByteArray hex = indexFile.readAll().trimmed();
+        indexFile.close();
+        if (isHashHex(hex)) {
+            if (auto pd = readEntry(entryPath(hex), hex)) return pd;
+        }
+    }
+
+    // Slow path: identical bytes may have been cached under another name.
+    const QByteArray hex = contentHash(sourcePath);
+    if (contentHashHex) *contentHashHex = hex;
+    if (!isHashHex(hex) || !QFileInfo::exists(entryPath(hex))) return nullptr;
+
+    auto pd = readEntry(entryPath(hex), hex);
+    if (pd) writeIndex(source, hex);
+    return pd;
+}
+
+vtkSmartPointer<vtkPolyData> MeshCache::readEntry(const QString&    path,
+                                                  const QByteArray& contentHashHex)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return nullptr;
+
+    const qint64 fileSize = file.size();
+    if (fileSize < kAlignment) return nullptr;
+
+    const uchar* base = file.map(0, fileSize);
+    if (!base) return nullptr;
+
+    EntryHeader h;
+    std::memcpy(&h, base, sizeof(h));
+
+    // ---------------------------------------------------------------
+    // Validate before trusting any size: a truncated or foreign file
+    // must miss, not crash the renderer later.
+    // ---------------------------------------------------------------
+    auto sectionOk = [&](int s, uint64_t expectBytes, bool required) {
+        if (h.bytes[s] == 0) return !required;
+        return h.bytes[s] == expectBytes
+            && h.offset[s] % kAlignment == 0
+            && h.offset[s] + h.bytes[s] <= static_cast<uint64_t>(fileSize);
+    };
+
+    const bool headerOk =
+        std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0
+        && h.version == kVersion
+        && QByteArray(h.contentHash, kHashHexSize) == contentHashHex
+        && h.numPoints > 0 && h.numCells > 0
+        && sectionOk(Points,       h.numPoints * 3 * sizeof(float), true)
+        && sectionOk(PointNormals, h.numPoints * 3 * sizeof(float), false)
+        && sectionOk(CellNormals,  h.numCells  * 3 * sizeof(float), false)
+        && sectionOk(Offsets,      (h.numCells + 1) * sizeof(int64_t), true)
+        && sectionOk(Connectivity, h.connectivitySize * sizeof(int64_t), true)
+        && ((h.flags & HasPointNormals) == 0) == (h.bytes[PointNormals] == 0)
+        && ((h.flags & HasCellNormals)  == 0) == (h.bytes[CellNormals]  == 0);
+    if (!headerOk) {
+        file.unmap(const_cast<uchar*>(base));
+        return nullptr;
+    }
+
+    auto offsets = int64Array(base + h.offset[Offsets], h.numCells + 1);
+    auto conn    = int64Array(base + h.offset[Connectivity], h.connectivitySize);
+
+    // Topology sanity: monotonic offsets that cover the connectivity, and
+    // every id inside the point range.
+    const int64_t* off = offsets->GetPointer(0);
+    bool topologyOk = off[0] == 0
+        && off[h.numCells] == static_cast<int64_t>(h.connectivitySize);
+    for (uint64_t c = 0; topologyOk && c < h.numCells; ++c) {
+        topologyOk = off[c] <= off[c + 1];
+    }
+    const int64_t* ids = conn->GetPointer(0);
+    const int64_t  numPoints = static_cast<int64_t>(h.numPoints);
+    for (uint64_t i = 0; topologyOk && i < h.connectivitySize; ++i) {
+        topologyOk = ids[i] >= 0 && ids[i] < numPoints;
+    }
+    if (!topologyOk) {
+        file.unmap(const_cast<uchar*>(base));
+        return nullptr;
+    }
+
+    auto pd = vtkSmartPointer<vtkPolyData>::New();
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(floatArray(base + h.offset[Points], h.numPoints));
+    pd->SetPoints(points);
+
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->SetData(offsets, conn);
+    pd->SetPolys(polys);
+
+    if (h.flags & HasPointNormals) {
+        auto n = floatArray(base + h.offset[PointNormals], h.numPoints);
+        n->SetName("Normals");
+        pd->GetPointData()->SetNormals(n);
+    }
+    if (h.flags & HasCellNormals) {
+        auto n = floatArray(base + h.offset[CellNormals], h.numCells);
+        n->SetName("Normals");
+        pd->GetCellData()->SetNormals(n);
+    }
+
+    file.unmap(const_cast<uchar*>(base));
+
+    // LRU bookkeeping for prune().
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return pd;
+}
+
+// ===========================================================================
+// Store
+// ===========================================================================
+
+bool MeshCache::store(const QString& sourcePath, vtkPolyData* pd,
+                      const QByteArray& contentHashHex) const
+{
+    if (!pd || m_maxBytes == 0) return false;
+
+    const QFileInfo source(sourcePath);
+    const QByteArray hex = isHashHex(contentHashHex) ? contentHashHex : contentHash(sourcePath);
+    if (!isHashHex(hex)) return false;
+
+    if (!writeEntry(entryPath(hex), hex, pd)) return false;
+    writeIndex(source, hex);
+    prune();
+    return true;
+}
+
+bool MeshCache::writeEntry(const QString&    path,
+                           const QByteArray& contentHashHex,
+                           vtkPolyData*      pd)
+{
+    // Only plain polygon meshes fit the layout.
+    if (pd->GetNumberOfVerts() > 0 || pd->GetNumberOfLines() > 0
+        || pd->GetNumberOfStrips() > 0 || pd->GetNumberOfPolys() == 0
+        || !pd->GetPoints()) {
+        return false;
+    }
+
+    const vtkIdType numPoints = pd->GetNumberOfPoints();
+    const vtkIdType numCells  = pd->GetNumberOfPolys();
+
+    auto points       = asFloat3(pd->GetPoints()->GetData(), numPoints);
+    auto pointNormals = asFloat3(pd->GetPointData()->GetNormals(), numPoints);
+    auto cellNormals  = asFloat3(pd->GetCellData()->GetNormals(), numCells);
+    if (!points) return false;
+
+    // vtkCellArray may store 32- or 64-bit ids; the file is always 64-bit.
+    auto offsets = vtkSmartPointer<vtkTypeInt64Array>::New();
+    offsets->DeepCopy(pd->GetPolys()->GetOffsetsArray());
+    auto conn = vtkSmartPointer<vtkTypeInt64Array>::New();
+    conn->DeepCopy(pd->GetPolys()->GetConnectivityArray());
+
+    const void* data[SectionCount] = {
+        points->GetVoidPointer(0),
+        pointNormals ? pointNormals->GetVoidPointer(0) : nullptr,
+        cellNormals  ? cellNormals->GetVoidPointer(0)  : nullptr,
+        offsets->GetVoidPointer(0),
+        conn->GetVoidPointer(0),
+    };
+
+    EntryHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version          = kVersion;
+    h.flags            = (pointNormals ? HasPointNormals : 0u)
+                       | (cellNormals  ? HasCellNormals  : 0u);
+    h.numPoints        = static_cast<uint64_t>(numPoints);
+    h.numCells         = static_cast<uint64_t>(numCells);
+    h.connectivitySize = static_cast<uint64_t>(conn->GetNumberOfValues());
+    h.bytes[Points]       = h.numPoints * 3 * sizeof(float);
+    h.bytes[PointNormals] = pointNormals ? h.numPoints * 3 * sizeof(float) : 0;
+    h.bytes[CellNormals]  = cellNormals  ? h.numCells  * 3 * sizeof(float) : 0;
+    h.bytes[Offsets]      = (h.numCells + 1) * sizeof(int64_t);
+    h.bytes[Connectivity] = h.connectivitySize * sizeof(int64_t);
+    std::memcpy(h.contentHash, contentHashHex.constData(), kHashHexSize);
+
+    qint64 pos = kAlignment;
+    for (int s = 0; s < SectionCount; ++s) {
+        if (h.bytes[s] == 0) continue;
+        h.offset[s] = static_cast<uint64_t>(pos);
+        pos = alignUp(pos + static_cast<qint64>(h.bytes[s]));
+    }
+
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly)) return false;
+
+    const QByteArray zeros(kAlignment, '\0');
+    auto writeAt = [&](qint64 offset, const void* src, qint64 bytes) {
+        const qint64 pad = offset - out.pos();
+        if (pad > 0 && out.write(zeros.constData(), pad) != pad) return false;
+        return out.write(static_cast<const char*>(src), bytes) == bytes;
+    };
+
+    bool ok = writeAt(0, &h, sizeof(h));
+    for (int s = 0; ok && s < SectionCount; ++s) {
+        if (h.bytes[s] == 0) continue;
+        ok = writeAt(static_cast<qint64>(h.offset[s]), data[s],
+                     static_cast<qint64>(h.bytes[s]));
+    }
+    if (!ok) {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
+
+void MeshCache::writeIndex(const QFileInfo& source, const QByteArray& contentHashHex) const
+{
+    QSaveFile out(indexPath(source));
+    if (!out.open(QIODevice::WriteOnly)) return;
+    out.write(contentHashHex);
+    out.commit();
+}
+
+// ===========================================================================
+// Maintenance
+// ===========================================================================
+
+void MeshCache::prune() const
+{
+    struct Found {
+        QString path;
+        qint64  size;
+        qint64  mtime;
+    };
+    std::vector<Found> found;
+    qint64 total = 0;
+
+    QDirIterator it(m_root, {QStringLiteral("*.mesh")}, QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fi = it.fileInfo();
+        found.push_back({ fi.absoluteFilePath(), fi.size(),
+                          fi.lastModified().toMSecsSinceEpoch() });
+        total += fi.size();
+    }
+    if (total <= m_maxBytes) return;
+
+    // Oldest first.  Stale index files simply miss on their next lookup.
+    std::sort(found.begin(), found.end(),
+              [](const Found& a, const Found& b) { return a.mtime < b.mtime; });
+    for (const Found& f : found) {
+        if (total <= m_maxBytes) break;
+        if (QFile::remove(f.path)) total -= f.size;
+    }
+}
+
+void MeshCache::clear() const
+{
+    QDir(m_root).removeRecursively();
+    QDir().mkpath(m_root + QStringLiteral("/index"));
+}
@@ -0,0 +1,93 @@
+// src/scene/MeshCache.h
+//
+// MeshCache – on-disk cache of preprocessed CAD geometry.
+//
+// CadScene's load pipeline (reader + ensureNormals) is expensive, above all
+// for ASCII STL / OBJ.  MeshCache stores its result – points, point / cell
+// normals and polygon connectivity – in a flat binary layout, so a repeat load
+// is a file map plus one memcpy per array, with no parsing and no normals pass.
+//
+// Keys:
+//   * index   <root>/index/<sha1(abs path, size, mtime)>  → content hash
+//   * entries <root>/<sha256 of source bytes>-<variant>.mesh
+// A known path + size + mtime resolves without touching the source file.  A
+// moved or touched file costs one content hash, after which an entry created
+// from identical bytes (e.g. the same part under another path) is reused.
+// The variant is a short hash of the entry format version and the caller's
+// pipeline key (the normals parameters), so changing either misses instead
+// of reusing stale geometry.  A cold load hashes the source once: load()
+// hands the hash it computed to the following store().
+//
+// Entry layout (native endianness, every section 4 KiB aligned so it can be
+// mapped on its own):
+//   header | float32 points[3n] | float32 pointNormals[3n] |
+//   float32 cellNormals[3m] | int64 offsets[m+1] | int64 connectivity[k]
+//
+// Only meshes made of polygons are cached (no verts / lines / strips); other
+// point data (texture coordinates, colours) is not kept since the scene never
+// shows it.
+//
+// Thread safety: load() / store() touch only the file system and may be
+// called from any thread, concurrently.  Entries are written with QSaveFile.
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <vtkSmartPointer.h>
+
+class QFileInfo;
+class vtkPolyData;
+
+class MeshCache
+{
+public:
+    static constexpr qint64 kDefaultMaxBytes = qint64(4) << 30;   // 4 GiB
+
+    /// \a rootDir empty → <CacheLocation>/meshes.  \a pipelineKey describes
+    /// the preprocessing whose result is stored (see CadScene::ensureNormals).
+    explicit MeshCache(const QString&    rootDir     = QString(),
+                       qint64            maxBytes    = kDefaultMaxBytes,
+                       const QByteArray& pipelineKey = QByteArray());
+
+    QString rootDir() const { return m_root; }
+    qint64  maxBytes() const { return m_maxBytes; }
+
+    /// Cached geometry for \a sourcePath, or nullptr when there is no entry
+    /// for the file's current contents.  When the lookup had to hash the
+    /// file, the hash is returned in \a contentHashHex (for store()).
+    vtkSmartPointer<vtkPolyData> load(const QString& sourcePath,
+                                      QByteArray*    contentHashHex = nullptr) const;
+
+    /// Store \a pd as the preprocessed geometry of \a sourcePath, under
+    /// \a contentHashHex from load() or, if that is empty, a fresh hash.
+    /// Returns false when \a pd is not cacheable or the write failed.
+    bool store(const QString& sourcePath, vtkPolyData* pd,
+               const QByteArray& contentHashHex = QByteArray()) const;
+
+    /// Remove every entry.
+    void clear() const;
+
+private:
+    QString    m_root;
+    qint64     m_maxBytes;
+    QByteArray m_variant;   ///< hex: format version + pipeline key
+
+    QString indexPath(const QFileInfo& source) const;
+    QString entryPath(const QByteArray& contentHashHex) const;
+
+    /// SHA-256 over the file bytes (hex), empty if unreadable.
+    static QByteArray contentHash(const QString& path);
+
+    static vtkSmartPointer<vtkPolyData> readEntry(const QString& entryPath,
+                                                  const QByteArray& contentHashHex);
+    static bool writeEntry(const QString& entryPath,
+                           const QByteArray& contentHashHex,
+                           vtkPolyData* pd);
+
+    void writeIndex(const QFileInfo& source, const QByteArray& contentHashHex) const;
+
+    /// Drop the least recently used entries until under maxBytes().
+    void prune() const;
+};
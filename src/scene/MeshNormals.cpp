@@ -0,0 +1,463 @@
+// src/scene/MeshNormals.cpp
+
+#include "MeshNormals.h"
+#include "ParallelTasks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+namespace {
+
+/// Cells / points per task.
+constexpr std::size_t kChunk = 65536;
+
+struct Vec3 {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+/// parallelTasks() over [0, count) in kChunk ranges; skipped once cancelled.
+void parallelRanges(vtkIdType count, int threads, const std::atomic<bool>* cancelled,
+                    const std::function<void(vtkIdType begin, vtkIdType end)>& body)
+{
+    const std::size_t tasks = (static_cast<std::size_t>(count) + kChunk - 1) / kChunk;
+    parallelTasks(tasks, threads, [&](std::size_t task) {
+        if (isCancelled(cancelled)) return;
+        const vtkIdType begin = static_cast<vtkIdType>(task * kChunk);
+        body(begin, std::min(count, begin + static_cast<vtkIdType>(kChunk)));
+    });
+}
+
+// ---------------------------------------------------------------------------
+// Lock-free union-find.  The larger root is always linked below the smaller
+// one, so every component ends up rooted at its lowest cell id whatever the
+// interleaving.
+// ---------------------------------------------------------------------------
+class Components
+{
+public:
+    explicit Components(vtkIdType count)
+        : m_parent(static_cast<std::size_t>(count))
+    {
+    }
+
+    std::atomic<vtkIdType>& parent(vtkIdType i) { return m_parent[static_cast<std::size_t>(i)]; }
+
+    vtkIdType find(vtkIdType x)
+    {
+        for (;;) {
+            vtkIdType p = parent(x).load(std::memory_order_acquire);
+            if (p == x) return x;
+            const vtkIdType gp = parent(p).load(std::memory_order_acquire);
+            if (gp != p) parent(x).compare_exchange_weak(p, gp, std::memory_order_acq_rel);   // path halving
+            x = gp;
+        }
+    }
+
+    void unite(vtkIdType a, vtkIdType b)
+    {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+            vtkIdType expected = a;
+            if (parent(a).compare_exchange_strong(expected, b, std::memory_order_acq_rel)) return;
+        }
+    }
+
+private:
+    std::vector<std::atomic<vtkIdType>> m_parent;
+};
+
+/// +1 if the polygon conn[begin, end) has the edge a -> b, -1 if b -> a,
+/// 0 if a and b are not adjacent in it.
+template <typename IdT>
+int edgeDirection(const IdT* conn, vtkIdType begin, vtkIdType end, vtkIdType a, vtkIdType b)
+{
+    const vtkIdType npts = end - begin;
+    for (vtkIdType k = 0; k < npts; ++k) {
+        if (conn[begin + k] != a) continue;
+        if (conn[begin + (k + 1) % npts] == b) return 1;
+        if (conn[begin + (k + npts - 1) % npts] == b) return -1;
+    }
+    return 0;
+}
+
+template <typename ArrayT, typename Real>
+vtkSmartPointer<vtkPolyData> computeNormals(vtkPolyData*                   input,
+                                            ArrayT*                        offsetsArray,
+                                            ArrayT*                        connArray,
+                                            const Real*                    xyz,
+                                            int                            threads,
+                                            const MeshNormals::ProgressFn& progress,
+                                            const std::atomic<bool>*       cancelled)
+{
+    using IdT = typename ArrayT::ValueType;
+
+    auto report = [&progress](double fraction) {
+        if (progress) progress(fraction);
+    };
+
+    const IdT*      offsets = offsetsArray->GetPointer(0);
+    const IdT*      conn    = connArray->GetPointer(0);
+    const vtkIdType nCells  = offsetsArray->GetNumberOfValues() - 1;
+    const vtkIdType nConn   = connArray->GetNumberOfValues();
+    const vtkIdType nPoints = input->GetNumberOfPoints();
+
+    const auto cellBegin = [offsets](vtkIdType c) { return static_cast<vtkIdType>(offsets[c]); };
+    const auto cellEnd   = [offsets](vtkIdType c) { return static_cast<vtkIdType>(offsets[c + 1]); };
+
+    // ------------------------------------------------------------------
+    // 1. Area vectors (Newell)
+    // ------------------------------------------------------------------
+    std::vector<Vec3> area(static_cast<std::size_t>(nCells));
+    parallelRanges(nCells, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType c = begin; c < end; ++c) {
+            const vtkIdType b = cellBegin(c), e = cellEnd(c), npts = e - b;
+            double n[3] = { 0.0, 0.0, 0.0 };
+            if (npts >= 3) {
+                for (vtkIdType k = 0; k < npts; ++k) {
+                    const Real* u = xyz + 3 * static_cast<vtkIdType>(conn[b + k]);
+                    const Real* v = xyz + 3 * static_cast<vtkIdType>(conn[b + (k + 1) % npts]);
+                    n[0] += (double(u[1]) - v[1]) * (double(u[2]) + v[2]);
+                    n[1] += (double(u[2]) - v[2]) * (double(u[0]) + v[0]);
+                    n[2] += (double(u[0]) - v[0]) * (double(u[1]) + v[1]);
+                }
+            }
+            area[c] = { static_cast<float>(n[0]), static_cast<float>(n[1]), static_cast<float>(n[2]) };
+        }
+    });
+    if (isCancelled(cancelled)) return nullptr;
+    report(0.1);
+
+    // ------------------------------------------------------------------
+    // 2. Point -> cell incidence (CSR, sorted, duplicates dropped)
+    // ------------------------------------------------------------------
+    std::vector<std::atomic<vtkIdType>> cursor(static_cast<std::size_t>(nPoints));
+    parallelRanges(nPoints, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType p = begin; p < end; ++p) cursor[p].store(0, std::memory_order_relaxed);
+    });
+    parallelRanges(nCells, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = cellBegin(begin); i < cellBegin(end); ++i) {
+            cursor[static_cast<vtkIdType>(conn[i])].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    if (isCancelled(cancelled)) return nullptr;
+
+    std::vector<vtkIdType> incStart(static_cast<std::size_t>(nPoints) + 1);
+    incStart[0] = 0;
+    for (vtkIdType p = 0; p < nPoints; ++p) {
+        const vtkIdType count = cursor[p].load(std::memory_order_relaxed);
+        incStart[p + 1] = incStart[p] + count;
+        cursor[p].store(incStart[p], std::memory_order_relaxed);
+    }
+
+    std::vector<vtkIdType> incidence(static_cast<std::size_t>(nConn));
+    parallelRanges(nCells, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType c = begin; c < end; ++c) {
+            for (vtkIdType i = cellBegin(c); i < cellEnd(c); ++i) {
+                incidence[cursor[static_cast<vtkIdType>(conn[i])].fetch_add(1, std::memory_order_relaxed)] = c;
+            }
+        }
+    });
+    if (isCancelled(cancelled)) return nullptr;
+    cursor = std::vector<std::atomic<vtkIdType>>();
+
+    std::vector<vtkIdType> incEnd(static_cast<std::size_t>(nPoints));
+    parallelRanges(nPoints, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType p = begin; p < end; ++p) {
+            auto first = incidence.begin() + incStart[p];
+            auto last  = incidence.begin() + incStart[p + 1];
+            std::sort(first, last);
+            incEnd[p] = std::unique(first, last) - incidence.begin();
+        }
+    });
+    if (isCancelled(cancelled)) return nullptr;
+    report(0.35);
+
+    // ------------------------------------------------------------------
+    // 3 + 4. Edge neighbours and connected components
+    // ------------------------------------------------------------------
+    // neighbour[i]: the polygon across the edge conn[i] -> conn[i + 1].
+    std::vector<vtkIdType> neighbour(static_cast<std::size_t>(nConn), -1);
+    Components components(nCells);
+    parallelRanges(nCells, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType c = begin; c < end; ++c) components.parent(c).store(c, std::memory_order_relaxed);
+    });
+    if (isCancelled(cancelled)) return nullptr;
+
+    parallelRanges(nCells, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType c = begin; c < end; ++c) {
+            const vtkIdType b = cellBegin(c), e = cellEnd(c), npts = e - b;
+            if (npts < 3) continue;
+            for (vtkIdType k = 0; k < npts; ++k) {
+                const vtkIdType pa = conn[b + k];
+                const vtkIdType pb = conn[b + (k + 1) % npts];
+                if (pa == pb) continue;
+
+                // Polygons incident to both ends, other than c.
+                vtkIdType other = -1;
+                int       found = 0;
+                vtkIdType i = incStart[pa], iEnd = incEnd[pa];
+                vtkIdType j = incStart[pb], jEnd = incEnd[pb];
+                while (i < iEnd && j < jEnd && found < 2) {
+                    if (incidence[i] < incidence[j]) {
+                        ++i;
+                    } else if (incidence[j] < incidence[i]) {
+                        ++j;
+                    } else {
+                        if (incidence[i] != c) {
+                            other = incidence[i];
+                            ++found;
+                        }
+                        ++i;
+                        ++j;
+                    }
+                }
+                if (found != 1) continue;   // boundary or non-manifold edge
+                if (edgeDirection(conn, cellBegin(other), cellEnd(other), pa, pb) == 0) continue;
+
+                neighbour[b + k] = other;
+                if (other > c) components.unite(c, other);
+            }
+        }
+    });
+    if (isCancelled(cancelled)) return nullptr;
+
+    std::vector<vtkIdType> root(static_cast<std::size_t>(nCells));
+    parallelRanges(nCells, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType c = begin; c < end; ++c) root[c] = components.find(c);
+    });
+    if (isCancelled(cancelled)) return nullptr;
+    report(0.6);
+
+    // Cells grouped by component, in ascending id order (the first cell of
+    // each group is its root).
+    std::vector<vtkIdType> groupOf(static_cast<std::size_t>(nCells), -1);
+    std::vector<vtkIdType> groupStart(1, 0);
+    for (vtkIdType c = 0; c < nCells; ++c) {
+        if (root[c] == c) {
+            groupOf[c] = static_cast<vtkIdType>(groupStart.size()) - 1;
+            groupStart.push_back(0);
+        }
+        ++groupStart[static_cast<std::size_t>(groupOf[root[c]]) + 1];
+    }
+    const std::size_t groups = groupStart.size() - 1;
+    for (std::size_t g = 0; g < groups; ++g) groupStart[g + 1] += groupStart[g];
+
+    std::vector<vtkIdType> grouped(static_cast<std::size_t>(nCells));
+    {
+        std::vector<vtkIdType> fill(groupStart.begin(), groupStart.end() - 1);
+        for (vtkIdType c = 0; c < nCells; ++c) grouped[fill[groupOf[root[c]]]++] = c;
+    }
+    root = std::vector<vtkIdType>();
+
+    std::vector<std::size_t> order(groups);
+    for (std::size_t g = 0; g < groups; ++g) order[g] = g;
+    std::stable_sort(order.begin(), order.end(), [&groupStart](std::size_t a, std::size_t b) {
+        return groupStart[a + 1] - groupStart[a] > groupStart[b + 1] - groupStart[b];
+    });
+    report(0.7);
+
+    // ------------------------------------------------------------------
+    // 5. Orientation, one component per task
+    // ------------------------------------------------------------------
+    double centre[3];
+    input->GetCenter(centre);
+
+    std::vector<char> flip(static_cast<std::size_t>(nCells), 0);
+    std::vector<char> visited(static_cast<std::size_t>(nCells), 0);
+    std::atomic<bool> anyFlip{false};
+
+    parallelTasks(groups, threads, [&](std::size_t task) {
+        if (isCancelled(cancelled)) return;
+        const std::size_t g     = order[task];
+        const vtkIdType   first = groupStart[g];
+        const vtkIdType   last  = groupStart[g + 1];
+
+        // Breadth-first from the root (the component's lowest cell keeps
+        // its point order).
+        if (last - first > 1) {
+            std::vector<vtkIdType> queue;
+            queue.reserve(static_cast<std::size_t>(last - first));
+            queue.push_back(grouped[first]);
+            visited[grouped[first]] = 1;
+            for (std::size_t head = 0; head < queue.size(); ++head) {
+                const vtkIdType c = queue[head];
+                const vtkIdType b = cellBegin(c), e = cellEnd(c), npts = e - b;
+                for (vtkIdType k = 0; k < npts; ++k) {
+                    const vtkIdType n = neighbour[b + k];
+                    if (n < 0 || visited[n]) continue;
+                    // Consistent neighbours traverse the shared edge the other way.
+                    const int dir = edgeDirection(conn, cellBegin(n), cellEnd(n),
+                                                  static_cast<vtkIdType>(conn[b + k]),
+                                                  static_cast<vtkIdType>(conn[b + (k + 1) % npts]));
+                    flip[n]    = static_cast<char>(flip[c] ^ (dir > 0 ? 1 : 0));
+                    visited[n] = 1;
+                    queue.push_back(n);
+                }
+            }
+        }
+
+        // Outward: positive signed volume.  Taken about the mesh centre so
+        // that the terms do not cancel out at large coordinates.
+        double volume = 0.0;
+        for (vtkIdType i = first; i < last; ++i) {
+            const vtkIdType c = grouped[i];
+            if (cellEnd(c) - cellBegin(c) < 3) continue;
+            const Real* p = xyz + 3 * static_cast<vtkIdType>(conn[cellBegin(c)]);
+            const Vec3& a = area[c];
+            const double v = (double(p[0]) - centre[0]) * a.x + (double(p[1]) - centre[1]) * a.y
+                           + (double(p[2]) - centre[2]) * a.z;
+            volume += flip[c] ? -v : v;
+        }
+        bool flipped = false;
+        for (vtkIdType i = first; i < last; ++i) {
+            const vtkIdType c = grouped[i];
+            if (volume < 0.0) flip[c] ^= 1;
+            flipped = flipped || flip[c];
+        }
+        if (flipped) anyFlip.store(true, std::memory_order_relaxed);
+    });
+    if (isCancelled(cancelled)) return nullptr;
+    report(0.85);
+
+    // ------------------------------------------------------------------
+    // 6. Normals + reordered polygons
+    // ------------------------------------------------------------------
+    auto cellNormals = vtkSmartPointer<vtkFloatArray>::New();
+    cellNormals->SetName("Normals");
+    cellNormals->SetNumberOfComponents(3);
+    cellNormals->SetNumberOfTuples(nCells);
+    float* cn = cellNormals->GetPointer(0);
+    parallelRanges(nCells, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType c = begin; c < end; ++c) {
+            const Vec3& a   = area[c];
+            const float len = std::sqrt(a.x * a.x + a.y * a.y + a.z * a.z);
+            const float s   = len > 0.0f ? (flip[c] ? -1.0f : 1.0f) / len : 0.0f;
+            cn[3 * c] = a.x * s; cn[3 * c + 1] = a.y * s; cn[3 * c + 2] = a.z * s;
+        }
+    });
+
+    auto pointNormals = vtkSmartPointer<vtkFloatArray>::New();
+    pointNormals->SetName("Normals");
+    pointNormals->SetNumberOfComponents(3);
+    pointNormals->SetNumberOfTuples(nPoints);
+    float* pn = pointNormals->GetPointer(0);
+    parallelRanges(nPoints, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType p = begin; p < end; ++p) {
+            double n[3] = { 0.0, 0.0, 0.0 };
+            for (vtkIdType i = incStart[p]; i < incEnd[p]; ++i) {
+                const vtkIdType c = incidence[i];
+                const Vec3&     a = area[c];
+                const double    s = flip[c] ? -1.0 : 1.0;
+                n[0] += s * a.x; n[1] += s * a.y; n[2] += s * a.z;
+            }
+            const double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            const double s   = len > 0.0 ? 1.0 / len : 0.0;
+            pn[3 * p]     = static_cast<float>(n[0] * s);
+            pn[3 * p + 1] = static_cast<float>(n[1] * s);
+            pn[3 * p + 2] = static_cast<float>(n[2] * s);
+        }
+    });
+
+    vtkSmartPointer<vtkCellArray> polys;
+    if (anyFlip.load(std::memory_order_relaxed)) {
+        auto reordered = vtkSmartPointer<ArrayT>::New();
+        reordered->SetNumberOfValues(nConn);
+        IdT* out = reordered->GetPointer(0);
+        parallelRanges(nCells, threads, cancelled, [&](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType c = begin; c < end; ++c) {
+                const vtkIdType b = cellBegin(c), e = cellEnd(c);
+                if (flip[c]) {
+                    std::reverse_copy(conn + b, conn + e, out + b);
+                } else {
+                    std::copy(conn + b, conn + e, out + b);
+                }
+            }
+        });
+        polys = vtkSmartPointer<vtkCellArray>::New();
+        polys->SetData(offsetsArray, reordered);   // offsets are shared
+    }
+    if (isCancelled(cancelled)) return nullptr;
+
+    auto result = vtkSmartPointer<vtkPolyData>::New();
+    result->ShallowCopy(input);
+    if (polys) result->SetPolys(polys);
+    result->GetPointData()->SetNormals(pointNormals);
+    result->GetCellData()->SetNormals(cellNormals);
+    report(1.0);
+    return result;
+}
+
+template <typename ArrayT>
+vtkSmartPointer<vtkPolyData> dispatchPoints(vtkPolyData*                   input,
+                                            ArrayT*                        offsets,
+                                            ArrayT*                        conn,
+                                            int                            threads,
+                                            const MeshNormals::ProgressFn& progress,
+                                            const std::atomic<bool>*       cancelled)
+{
+    vtkDataArray* data = input->GetPoints()->GetData();
+    if (auto* f = vtkFloatArray::FastDownCast(data)) {
+        return computeNormals(input, offsets, conn, f->GetPointer(0), threads, progress, cancelled);
+    }
+    if (auto* d = vtkDoubleArray::FastDownCast(data)) {
+        return computeNormals(input, offsets, conn, d->GetPointer(0), threads, progress, cancelled);
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// MeshNormals
+// ============================================================================
+
+bool MeshNormals::useParallel(vtkPolyData* input, const Params& params)
+{
+    if (!input || !input->GetPoints() || !input->GetPolys()) return false;
+    if (input->GetNumberOfVerts() > 0 || input->GetNumberOfLines() > 0
+        || input->GetNumberOfStrips() > 0) {
+        return false;
+    }
+    if (input->GetPolys()->GetNumberOfCells() < std::max<vtkIdType>(1, params.minParallelCells)) {
+        return false;
+    }
+    vtkDataArray* data = input->GetPoints()->GetData();
+    return vtkFloatArray::FastDownCast(data) || vtkDoubleArray::FastDownCast(data);
+}
+
+vtkSmartPointer<vtkPolyData> MeshNormals::compute(vtkPolyData*             input,
+                                                  const Params&            params,
+                                                  const ProgressFn&        progress,
+                                                  const std::atomic<bool>* cancelled)
+{
+    if (!useParallel(input, params) || isCancelled(cancelled)) return nullptr;
+
+    const int threads = workerThreads(params.threads);
+
+    vtkCellArray* polys = input->GetPolys();
+    if (polys->IsStorage64Bit()) {
+        return dispatchPoints(input, polys->GetOffsetsArray64(), polys->GetConnectivityArray64(),
+                              threads, progress, cancelled);
+    }
+    return dispatchPoints(input, polys->GetOffsetsArray32(), polys->GetConnectivityArray32(),
+                          threads, progress, cancelled);
+}
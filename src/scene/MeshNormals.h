@@ -0,0 +1,62 @@
+// src/scene/MeshNormals.h
+//
+// MeshNormals – multi-threaded replacement for the vtkPolyDataNormals pass
+// of CadScene::ensureNormals() (ComputePointNormals + ComputeCellNormals,
+// Splitting off, Consistency + AutoOrientNormals on).  That filter is
+// single-threaded and the slowest load stage for large scans.
+//
+// Pipeline (stages 1–4 and 6 split across worker threads):
+//   1. Polygon area vectors (Newell's method; length = twice the area).
+//   2. Point -> cell incidence (CSR), filled with atomic cursors and then
+//      sorted per point so the result does not depend on scheduling.
+//   3. Edge neighbours: for every polygon edge, the one other polygon that
+//      shares it (-1 on boundary and non-manifold edges).
+//   4. Connected components by lock-free union-find over those neighbours.
+//   5. Orientation, one component per task (largest first): breadth-first
+//      propagation from the component's lowest cell flips polygons whose
+//      shared edge runs the same way as their neighbour's, then the whole
+//      component is flipped if its signed volume is negative (outward
+//      normals on closed surfaces; a stable choice on open ones).
+//   6. Cell normals = oriented unit area vectors; point normals =
+//      normalised sum of the incident oriented area vectors (area weighted);
+//      flipped polygons have their point order reversed.
+// The output has the filter's layout: float "Normals" on point and cell
+// data, topology unchanged except for the reversed polygons.
+//
+// useParallel() is false for meshes below Params::minParallelCells, with
+// verts, lines or strips, or with non-float/double points; the caller keeps
+// running vtkPolyDataNormals for those.
+//
+// Thread safety: compute() is reentrant; it only reads its input.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include <vtkSmartPointer.h>
+#include <vtkType.h>
+
+class vtkPolyData;
+
+class MeshNormals
+{
+public:
+    struct Params {
+        int       threads          = 0;        ///< 0 = hardware concurrency
+        vtkIdType minParallelCells = 100000;   ///< smaller meshes: vtkPolyDataNormals
+    };
+
+    using ProgressFn = std::function<void(double fraction)>;
+
+    /// \a input with point and cell normals added (a new data object that
+    /// shares the unchanged arrays), or nullptr when \a cancelled was raised
+    /// or useParallel() is false.
+    static vtkSmartPointer<vtkPolyData> compute(vtkPolyData*             input,
+                                                const Params&            params,
+                                                const ProgressFn&        progress  = {},
+                                                const std::atomic<bool>* cancelled = nullptr);
+
+    /// True when compute() would run the parallel path for \a input.
+    static bool useParallel(vtkPolyData* input, const Params& params);
+};
@@ -0,0 +1,50 @@
+// src/scene/ParallelTasks.h
+//
+// Internal helpers of the hmi_scene worker kernels (SurfaceSampler,
+// CoverageEngine, MeshNormals): a small std::thread task pool for one
+// parallel stage, the thread-count default and the cancel-flag check.
+//
+// Not part of the library interface; include from .cpp files only.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/// Run \a task(i) for i in [0, count) on up to \a threads threads.
+/// Tasks are pulled from a shared counter; results must go to per-task slots.
+inline void parallelTasks(std::size_t count, int threads, const std::function<void(std::size_t)>& task)
+{
+    const std::size_t workers = std::min<std::size_t>(static_cast<std::size_t>(std::max(1, threads)), count);
+    if (workers <= 1) {
+        for (std::size_t i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto run = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1)) < count;) task(i);
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t t = 1; t < workers; ++t) pool.emplace_back(run);
+    run();
+    for (auto& t : pool) t.join();
+}
+
+/// \a requested if positive, otherwise the hardware concurrency (at least 1).
+inline int workerThreads(int requested)
+{
+    return requested > 0
+        ? requested
+        : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+inline bool isCancelled(const std::atomic<bool>* cancelled)
+{
+    return cancelled && cancelled->load(std::memory_order_relaxed);
+}
@@ -0,0 +1,456 @@
+// src/scene/PlanPreview.cpp
+
+#include "PlanPreview.h"
+#include "CadScene.h"
+#include "CoordTransform.h"
+
+#include <QQuaternion>
+
+#include <cmath>
+
+#include <vtkActor.h>
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkGlyph3DMapper.h>
+#include <vtkLineSource.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderer.h>
+#include <vtkUnsignedCharArray.h>
+
+namespace {
+
+constexpr const char* kColorsArray      = "colors";
+constexpr const char* kScaleArray       = "scale";
+constexpr const char* kOrientationArray = "orientation";
+
+/// Arm skeleton per waypoint: AGV origin, arm base, links 1–6.
+constexpr int kArmPoints = 8;
+
+/// Frustum per waypoint: apex, the four focal-plane corners (TL, TR, BR,
+/// BL) and a tick above the top edge marking image up.
+constexpr int kFrustumPoints = 6;
+
+/// Camera pose lanes per waypoint: position x, y, z, orientation w, x, y, z.
+constexpr int kPoseLanes = 7;
+
+constexpr double kTcpAxisLengthM = 0.05;   // 5 cm triad
+constexpr float  kCurrentScale   = 2.0f;
+
+constexpr unsigned char kFrustumColor[4]        = { 77, 179, 255,  90};   // light blue, 35 %
+constexpr unsigned char kFrustumCurrentColor[4] = {255, 230,   0, 255};   // yellow
+constexpr unsigned char kArmColor[4]            = {190, 195, 205,  70};   // grey, 27 %
+constexpr unsigned char kArmCurrentColor[4]     = {255, 140,   0, 255};   // orange
+
+vtkSmartPointer<vtkPolyData> newPoseData()
+{
+    auto pd = vtkSmartPointer<vtkPolyData>::New();
+    pd->SetPoints(vtkSmartPointer<vtkPoints>::New());
+
+    auto orientation = vtkSmartPointer<vtkFloatArray>::New();
+    orientation->SetName(kOrientationArray);
+    orientation->SetNumberOfComponents(4);   // (w, x, y, z)
+    pd->GetPointData()->AddArray(orientation);
+    return pd;
+}
+
+vtkSmartPointer<vtkPolyData> newColoredData()
+{
+    auto pd = vtkSmartPointer<vtkPolyData>::New();
+    pd->SetPoints(vtkSmartPointer<vtkPoints>::New());
+    auto colors = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    colors->SetName(kColorsArray);
+    colors->SetNumberOfComponents(4);
+    pd->GetPointData()->SetScalars(colors);
+    return pd;
+}
+
+vtkUnsignedCharArray* colorsOf(vtkPolyData* pd)
+{
+    return vtkUnsignedCharArray::SafeDownCast(pd->GetPointData()->GetArray(kColorsArray));
+}
+
+vtkFloatArray* floatsOf(vtkPolyData* pd, const char* name)
+{
+    return vtkFloatArray::SafeDownCast(pd->GetPointData()->GetArray(name));
+}
+
+void useColorArray(vtkMapper* mapper)
+{
+    mapper->ScalarVisibilityOn();
+    mapper->SetScalarModeToUsePointFieldData();
+    mapper->SelectColorArray(kColorsArray);
+    mapper->SetColorModeToDirectScalars();
+}
+
+void addPose(vtkPolyData* pd, const hmi::Pose3D& pose)
+{
+    pd->GetPoints()->InsertNextPoint(static_cast<double>(pose.position.x()),
+                                     static_cast<double>(pose.position.y()),
+                                     static_cast<double>(pose.position.z()));
+    QQuaternion q = pose.orientation.normalized();
+    if (q.isNull()) q = QQuaternion();
+    floatsOf(pd, kOrientationArray)->InsertNextTuple4(q.scalar(), q.x(), q.y(), q.z());
+}
+
+void resetData(vtkPolyData* pd)
+{
+    pd->GetPoints()->Reset();
+    for (int i = 0; i < pd->GetPointData()->GetNumberOfArrays(); ++i) {
+        pd->GetPointData()->GetAbstractArray(i)->Reset();
+    }
+    if (vtkCellArray* lines = pd->GetLines()) lines->Reset();
+}
+
+void markData(vtkPolyData* pd)
+{
+    pd->GetPoints()->Modified();
+    for (int i = 0; i < pd->GetPointData()->GetNumberOfArrays(); ++i) {
+        pd->GetPointData()->GetAbstractArray(i)->Modified();
+    }
+    if (vtkCellArray* lines = pd->GetLines()) lines->Modified();
+    pd->Modified();
+}
+
+/// Append the 8 frustum edges and the up tick of the waypoint whose first
+/// point is \a base.
+void appendFrustumLines(vtkCellArray* lines, vtkIdType base)
+{
+    for (vtkIdType c = 1; c <= 4; ++c) {
+        const vtkIdType toApex[2] = {base, base + c};
+        const vtkIdType edge[2]   = {base + c, base + (c % 4) + 1};
+        lines->InsertNextCell(2, toApex);
+        lines->InsertNextCell(2, edge);
+    }
+    const vtkIdType tick[3] = {base + 1, base + 5, base + 2};
+    lines->InsertNextCell(3, tick);
+}
+
+vtkSmartPointer<vtkActor> newActor(vtkMapper* mapper)
+{
+    auto actor = vtkSmartPointer<vtkActor>::New();
+    actor->SetMapper(mapper);
+    actor->PickableOff();
+    actor->UseBoundsOff();
+    actor->VisibilityOff();
+    return actor;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+PlanPreview::PlanPreview(CadScene* scene)
+    : QObject(scene)
+    , m_scene(scene)
+{
+    createPipeline();
+}
+
+PlanPreview::~PlanPreview() = default;
+
+void PlanPreview::createPipeline()
+{
+    m_frustumData = newColoredData();
+    m_frustumData->SetLines(vtkSmartPointer<vtkCellArray>::New());
+    m_tcpData = newPoseData();
+    {
+        auto scale = vtkSmartPointer<vtkFloatArray>::New();
+        scale->SetName(kScaleArray);
+        m_tcpData->GetPointData()->AddArray(scale);
+    }
+    m_armData = newColoredData();
+    m_armData->SetLines(vtkSmartPointer<vtkCellArray>::New());
+
+    // 1. Frusta: one merged wireframe, RGBA per point.
+    {
+        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        mapper->SetInputData(m_frustumData);
+        useColorArray(mapper);
+
+        m_frustumActor = newActor(mapper);
+        m_frustumActor->GetProperty()->SetRepresentationToWireframe();
+        m_frustumActor->GetProperty()->SetLineWidth(1.0);
+    }
+
+    // 2. TCP triads: one glyph mapper per axis over the same poses; the
+    //    current waypoint's triad is drawn larger.
+    static const double kAxes[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for (std::size_t a = 0; a < m_tcpAxisActors.size(); ++a) {
+        auto line = vtkSmartPointer<vtkLineSource>::New();
+        line->SetPoint1(0.0, 0.0, 0.0);
+        line->SetPoint2(kAxes[a][0] * kTcpAxisLengthM,
+                        kAxes[a][1] * kTcpAxisLengthM,
+                        kAxes[a][2] * kTcpAxisLengthM);
+
+        auto mapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+        mapper->SetInputData(m_tcpData);
+        mapper->SetSourceConnection(line->GetOutputPort());
+        mapper->ScalingOn();
+        mapper->SetScaleModeToScaleByMagnitude();
+        mapper->SetScaleArray(kScaleArray);
+        mapper->SetScaleFactor(1.0);
+        mapper->OrientOn();
+        mapper->SetOrientationModeToQuaternion();
+        mapper->SetOrientationArray(kOrientationArray);
+        mapper->ScalarVisibilityOff();
+
+        m_tcpAxisActors[a] = newActor(mapper);
+        m_tcpAxisActors[a]->GetProperty()->SetColor(kAxes[a][0] * 0.9 + 0.1,
+                                                    kAxes[a][1] * 0.9 + 0.1,
+                                                    kAxes[a][2] * 0.9 + 0.1);
+        m_tcpAxisActors[a]->GetProperty()->SetLineWidth(2.0);
+    }
+
+    // 3. Arm skeletons: one merged polyline set.
+    {
+        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        mapper->SetInputData(m_armData);
+        useColorArray(mapper);
+
+        m_armActor = newActor(mapper);
+        m_armActor->GetProperty()->SetLineWidth(2.0);
+    }
+}
+
+void PlanPreview::writeFrusta()
+{
+    // Same fallbacks as the target frusta (PointAnnotator).
+    const double focus = m_captureConfig.focusDistanceM > 1e-6 ? m_captureConfig.focusDistanceM : 0.25;
+    const double fovH  = m_captureConfig.fovHDeg > 1e-6 ? m_captureConfig.fovHDeg : 60.0;
+    const double fovV  = m_captureConfig.fovVDeg > 1e-6 ? m_captureConfig.fovVDeg : 45.0;
+
+    const std::size_t n = static_cast<std::size_t>(m_count);
+    const float* lane = m_cameraLanes.data();
+    const hmi::coord::ConstVec3Span position{lane, lane + n, lane + 2 * n};
+    const hmi::coord::ConstQuatSpan orientation{lane + 3 * n, lane + 4 * n,
+                                                lane + 5 * n, lane + 6 * n};
+
+    std::vector<float> cornerLanes(4 * 3 * n);
+    std::array<hmi::coord::Vec3Span, 4> corners;
+    for (std::size_t c = 0; c < corners.size(); ++c) {
+        float* p = cornerLanes.data() + 3 * c * n;
+        corners[c] = {p, p + n, p + 2 * n};
+    }
+    hmi::coord::frustumCornersBatch(position, orientation, n, focus, fovH, fovV, corners);
+
+    vtkPoints* pts = m_frustumData->GetPoints();
+    pts->SetNumberOfPoints(static_cast<vtkIdType>(n) * kFrustumPoints);
+    for (std::size_t i = 0; i < n; ++i) {
+        const vtkIdType base = static_cast<vtkIdType>(i) * kFrustumPoints;
+        pts->SetPoint(base, position.x[i], position.y[i], position.z[i]);
+        for (int c = 0; c < 4; ++c) {
+            pts->SetPoint(base + 1 + c, corners[c].x[i], corners[c].y[i], corners[c].z[i]);
+        }
+        // Tick 0.3 half-heights above the top edge, in the image's up.
+        constexpr float k = 0.15f;
+        const float tx = 0.5f * (corners[0].x[i] + corners[1].x[i]);
+        const float ty = 0.5f * (corners[0].y[i] + corners[1].y[i]);
+        const float tz = 0.5f * (corners[0].z[i] + corners[1].z[i]);
+        const float bx = 0.5f * (corners[3].x[i] + corners[2].x[i]);
+        const float by = 0.5f * (corners[3].y[i] + corners[2].y[i]);
+        const float bz = 0.5f * (corners[3].z[i] + corners[2].z[i]);
+        pts->SetPoint(base + 5, tx + k * (tx - bx), ty + k * (ty - by), tz + k * (tz - bz));
+    }
+}
+
+void PlanPreview::attachActors()
+{
+    if (m_actorsAttached) return;
+    vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
+    if (!ren) return;
+
+    ren->AddActor(m_frustumActor);
+    for (auto& actor : m_tcpAxisActors) ren->AddActor(actor);
+    ren->AddActor(m_armActor);
+    m_actorsAttached = true;
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+void PlanPreview::setCaptureConfig(const hmi::CaptureConfig& config)
+{
+    m_captureConfig = config;
+    if (m_count == 0) return;
+    writeFrusta();
+    markData(m_frustumData);
+    m_scene->render();
+}
+
+void PlanPreview::setRobotDescription(const RobotTwinDescription& description)
+{
+    m_robot = std::make_unique<RobotTwinDescription>(description);
+}
+
+// ============================================================================
+// Path
+// ============================================================================
+
+void PlanPreview::show(const hmi::InspectionPath& path)
+{
+    resetData(m_frustumData);
+    resetData(m_tcpData);
+    resetData(m_armData);
+    m_count   = path.waypoints.size();
+    m_current = -1;
+    m_hasArm  = m_robot != nullptr;
+
+    // Camera poses go into SoA lanes for frustumCornersBatch(); it takes
+    // the quaternions as they are (a null one draws as identity).
+    const std::size_t n = static_cast<std::size_t>(m_count);
+    m_cameraLanes.resize(kPoseLanes * n);
+    float* lane = m_cameraLanes.data();
+    vtkUnsignedCharArray* frustumColors = colorsOf(m_frustumData);
+    vtkCellArray*         frustumLines  = m_frustumData->GetLines();
+    vtkFloatArray*        tcpScale      = floatsOf(m_tcpData, kScaleArray);
+    for (std::size_t i = 0; i < n; ++i) {
+        const hmi::InspectionPoint& wp = path.waypoints[static_cast<int>(i)];
+        const hmi::Pose3D& camera = wp.cameraPose;
+        lane[i]         = camera.position.x();
+        lane[n + i]     = camera.position.y();
+        lane[2 * n + i] = camera.position.z();
+        lane[3 * n + i] = camera.orientation.scalar();
+        lane[4 * n + i] = camera.orientation.x();
+        lane[5 * n + i] = camera.orientation.y();
+        lane[6 * n + i] = camera.orientation.z();
+        for (int k = 0; k < kFrustumPoints; ++k) frustumColors->InsertNextTypedTuple(kFrustumColor);
+        appendFrustumLines(frustumLines, static_cast<vtkIdType>(i) * kFrustumPoints);
+
+        addPose(m_tcpData, wp.tcpPoseGoal);
+        tcpScale->InsertNextValue(1.0f);
+    }
+    writeFrusta();
+
+    if (m_hasArm) {
+        // Poses differ per waypoint, so the arm-chain cache never hits here.
+        RobotKinematics kinematics(*m_robot);
+        vtkPoints*            pts    = m_armData->GetPoints();
+        vtkUnsignedCharArray* colors = colorsOf(m_armData);
+        vtkCellArray*         lines  = m_armData->GetLines();
+        pts->Allocate(static_cast<vtkIdType>(m_count) * kArmPoints);
+        for (const auto& wp : path.waypoints) {
+            const TwinFrame frame = kinematics.solve(wp.agvPose.x, wp.agvPose.y,
+                                                     wp.agvPose.yaw, wp.armJointGoal);
+            vtkIdType ids[kArmPoints];
+            ids[0] = pts->InsertNextPoint(frame.agv[3], frame.agv[7], frame.agv[11]);
+            for (std::size_t i = 0; i < frame.links.size(); ++i) {
+                const TwinMatrix& m = frame.links[i];
+                ids[i + 1] = pts->InsertNextPoint(m[3], m[7], m[11]);
+            }
+            for (int k = 0; k < kArmPoints; ++k) colors->InsertNextTypedTuple(kArmColor);
+            lines->InsertNextCell(kArmPoints, ids);
+        }
+    }
+
+    attachActors();
+    markModified();
+    updateVisibility();
+    if (m_count > 0) {
+        setCurrentIndex(0);
+    } else {
+        m_scene->render();
+    }
+}
+
+void PlanPreview::clear()
+{
+    if (m_count == 0) return;
+    resetData(m_frustumData);
+    m_cameraLanes.clear();
+    resetData(m_tcpData);
+    resetData(m_armData);
+    m_count   = 0;
+    m_current = -1;
+    markModified();
+    updateVisibility();
+    m_scene->render();
+}
+
+// ============================================================================
+// Visibility / scrubbing
+// ============================================================================
+
+void PlanPreview::setVisible(bool visible)
+{
+    if (visible == m_visible) return;
+    m_visible = visible;
+    updateVisibility();
+    m_scene->render();
+}
+
+void PlanPreview::setLayerVisible(Layer layer, bool visible)
+{
+    bool& slot = m_layerVisible[static_cast<std::size_t>(layer)];
+    if (slot == visible) return;
+    slot = visible;
+    updateVisibility();
+    m_scene->render();
+}
+
+bool PlanPreview::isLayerVisible(Layer layer) const
+{
+    return m_layerVisible[static_cast<std::size_t>(layer)];
+}
+
+void PlanPreview::updateVisibility()
+{
+    const bool on = m_visible && m_count > 0;
+    m_frustumActor->SetVisibility(on && isLayerVisible(Layer::Frusta));
+    for (auto& actor : m_tcpAxisActors) {
+        actor->SetVisibility(on && isLayerVisible(Layer::TcpFrames));
+    }
+    m_armActor->SetVisibility(on && m_hasArm && isLayerVisible(Layer::ArmPoses));
+}
+
+void PlanPreview::setCurrentIndex(int index)
+{
+    if (index < 0 || index >= m_count || index == m_current) return;
+
+    if (m_current >= 0) writeAppearance(m_current, false);
+    writeAppearance(index, true);
+    m_current = index;
+
+    // Only the appearance arrays changed; the mappers re-upload colours and
+    // instance attributes, the geometry stays.
+    colorsOf(m_frustumData)->Modified();
+    m_frustumData->Modified();
+    floatsOf(m_tcpData, kScaleArray)->Modified();
+    m_tcpData->Modified();
+    if (m_hasArm) {
+        colorsOf(m_armData)->Modified();
+        m_armData->Modified();
+    }
+    m_scene->render();
+    emit currentIndexChanged(index);
+}
+
+void PlanPreview::writeAppearance(int index, bool current)
+{
+    vtkUnsignedCharArray* frustumColors = colorsOf(m_frustumData);
+    for (int k = 0; k < kFrustumPoints; ++k) {
+        frustumColors->SetTypedTuple(static_cast<vtkIdType>(index) * kFrustumPoints + k,
+                                     current ? kFrustumCurrentColor : kFrustumColor);
+    }
+    floatsOf(m_tcpData, kScaleArray)->SetValue(index, current ? kCurrentScale : 1.0f);
+    if (m_hasArm) {
+        vtkUnsignedCharArray* colors = colorsOf(m_armData);
+        for (int k = 0; k < kArmPoints; ++k) {
+            colors->SetTypedTuple(static_cast<vtkIdType>(index) * kArmPoints + k,
+                                  current ? kArmCurrentColor : kArmColor);
+        }
+    }
+}
+
+void PlanPreview::markModified()
+{
+    markData(m_frustumData);
+    markData(m_tcpData);
+    markData(m_armData);
+}
@@ -0,0 +1,116 @@
+// src/scene/PlanPreview.h
+//
+// PlanPreview – the plan-inspection layer of CadScene: every waypoint of a
+// planned InspectionPath with the data PointAnnotator::showPath() leaves
+// out.
+//   - camera frustum at InspectionPoint.cameraPose (optical axis +Z,
+//     sized from the CaptureConfig)
+//   - TCP frame (RGB axis triad) at InspectionPoint.tcpPoseGoal
+//   - arm pose: the DH skeleton at armJointGoal on agvPose, once a robot
+//     description has been set (RobotKinematics, as for the twin)
+//
+// Batched like the PointAnnotator targets: the frusta are one merged line
+// polydata, 6 points per waypoint, generated from the camera poses in one
+// hmi::coord::frustumCornersBatch() pass; triads are glyphs, one
+// vtkGlyph3DMapper per axis over a per-waypoint point set carrying
+// "orientation" quaternions plus "scale"; the skeletons are one merged
+// polyline polydata, 8 points per waypoint.  The actor count is fixed
+// (five) whatever the waypoint count, and scrubbing (setCurrentIndex)
+// rewrites the appearance tuples of two waypoints only.
+//
+// Poses are drawn as the planner reports them, in scene units (like
+// showPath()); the arm chain goes through the description's scene
+// transform.  Preview actors are not pickable and do not take part in
+// camera fits.
+//
+// Thread safety: all methods must be called from the Qt GUI thread.
+
+#pragma once
+
+#include "RobotKinematics.h"
+
+#include "Types.h"
+
+#include <QObject>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+
+class CadScene;
+class vtkActor;
+class vtkPolyData;
+
+class PlanPreview : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Layer { Frusta, TcpFrames, ArmPoses };
+
+    explicit PlanPreview(CadScene* scene);
+    ~PlanPreview() override;
+
+    /// Frustum size (focus distance, field of view); regenerates the frusta only.
+    void setCaptureConfig(const hmi::CaptureConfig& config);
+
+    /// Enable the arm-pose layer for this robot.  Applies to the next show().
+    void setRobotDescription(const RobotTwinDescription& description);
+
+    /// Replace the preview with \a path and scrub to its first waypoint.
+    void show(const hmi::InspectionPath& path);
+
+    /// Drop the preview geometry.
+    void clear();
+
+    [[nodiscard]] int waypointCount() const { return m_count; }
+
+    /// Show / hide the whole preview (the geometry is kept).
+    void setVisible(bool visible);
+    [[nodiscard]] bool isVisible() const { return m_visible; }
+
+    void setLayerVisible(Layer layer, bool visible);
+    [[nodiscard]] bool isLayerVisible(Layer layer) const;
+
+    /// Highlight waypoint \a index; out-of-range values are ignored.
+    void setCurrentIndex(int index);
+    [[nodiscard]] int currentIndex() const { return m_current; }
+
+signals:
+    void currentIndexChanged(int index);
+
+private:
+    void createPipeline();
+    void attachActors();
+    void writeFrusta();
+    void writeAppearance(int index, bool current);
+    void markModified();
+    void updateVisibility();
+
+    CadScene*                               m_scene = nullptr;
+    hmi::CaptureConfig                      m_captureConfig;
+    std::unique_ptr<RobotTwinDescription>   m_robot;   ///< null = no arm layer
+
+    // One tuple per waypoint (TCPs), 6 per waypoint (frusta), 8 per
+    // waypoint (arm).
+    vtkSmartPointer<vtkPolyData>            m_frustumData;
+    vtkSmartPointer<vtkPolyData>            m_tcpData;
+    vtkSmartPointer<vtkPolyData>            m_armData;
+
+    /// Camera poses as SoA lanes (position x, y, z, orientation w, x, y, z),
+    /// kept so a new capture config can regenerate the frusta.
+    std::vector<float>                      m_cameraLanes;
+
+    vtkSmartPointer<vtkActor>               m_frustumActor;
+    std::array<vtkSmartPointer<vtkActor>, 3> m_tcpAxisActors;   ///< X, Y, Z
+    vtkSmartPointer<vtkActor>               m_armActor;
+    bool                                    m_actorsAttached = false;
+
+    int                                     m_count   = 0;
+    int                                     m_current = -1;
+    bool                                    m_hasArm  = false;
+    bool                                    m_visible = true;
+    std::array<bool, 3>                     m_layerVisible{{true, true, true}};
+};
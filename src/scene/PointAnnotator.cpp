@@ -2,27 +2,28 @@
 
 #include "PointAnnotator.h"
 #include "CadScene.h"
+#include "CoordTransform.h"
 
 #include <QString>
 #include <QVector3D>
 
+#include <array>
 #include <cmath>
 
 // VTK – rendering
 #include <vtkRenderer.h>
-#include <vtkRenderWindow.h>
-#include <vtkCamera.h>
 #include <vtkSmartPointer.h>
 
 // VTK – actors / mappers / properties
 #include <vtkActor.h>
+#include <vtkActor2D.h>
+#include <vtkGlyph3DMapper.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkProperty.h>
 
 // VTK – geometry sources
 #include <vtkSphereSource.h>
 #include <vtkArrowSource.h>
-#include <vtkLineSource.h>
 #include <vtkCellArray.h>
 #include <vtkPoints.h>
 #include <vtkPolyLine.h>
@@ -32,21 +33,23 @@
 #include <vtkTransformPolyDataFilter.h>
 
 // VTK – picking
-#include <vtkCellPicker.h>
+#include <vtkAbstractCellLocator.h>
+#include <vtkCellData.h>
+#include <vtkGenericCell.h>
+#include <vtkPolygon.h>
 
 // VTK – text / labels
-#include <vtkBillboardTextActor3D.h>
+#include <vtkLabeledDataMapper.h>
 #include <vtkTextProperty.h>
-#include <vtkVectorText.h>
-#include <vtkFollower.h>
 
-// VTK – append / combine geometry
-#include <vtkAppendPolyData.h>
+// VTK – geometry containers
 #include <vtkPolyData.h>
 
 // VTK – data arrays
 #include <vtkPointData.h>
-#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkStringArray.h>
+#include <vtkUnsignedCharArray.h>
 
 // ============================================================================
 // Local helper functions (file-scope)
@@ -54,13 +57,23 @@
 
 namespace {
 
-/// Convert a QVector3D to a double[3] array.
-void toArray(const QVector3D& v, double out[3])
-{
-    out[0] = static_cast<double>(v.x());
-    out[1] = static_cast<double>(v.y());
-    out[2] = static_cast<double>(v.z());
-}
+// Batched array names (point data).
+constexpr const char* kColorsArray  = "colors";
+constexpr const char* kScaleArray   = "scale";
+constexpr const char* kNormalsArray = "normals";
+constexpr const char* kLabelsArray  = "labels";
+
+// Frustum layout per slot: apex + 4 far-plane corners, 8 edges.
+constexpr int kFrustumPoints = 5;
+constexpr int kFrustumLines  = 8;
+
+// Annotation colours (RGB / RGBA bytes).
+constexpr unsigned char kMarkerColor[3]          = {230,  26,  26};   // red
+constexpr unsigned char kMarkerSelectedColor[3]  = {255, 230,   0};   // yellow
+constexpr unsigned char kFrustumColor[4]         = { 77, 179, 255, 115};   // light blue, 45 %
+constexpr unsigned char kFrustumSelectedColor[4] = {255, 230,   0, 179};   // yellow, 70 %
+constexpr unsigned char kWaypointColor[4]        = {  0, 230, 102, 217};   // green, 85 %
+constexpr unsigned char kWaypointActiveColor[4]  = {255, 255,   0, 255};   // yellow
 
 /// Normalise a double[3] vector.  Returns false if the vector is near-zero.
 bool normalise3(double v[3])
@@ -71,16 +84,11 @@ bool normalise3(double v[3])
     return true;
 }
 
-/// Compute a rotation matrix R that rotates the +X axis to the direction \a dir.
-/// \a dir must be a unit vector.  If \a dir ≈ +X we fall back to +Z as the
-/// "up" reference to avoid degenerate cross products.
-///
-/// The resulting 4x4 matrix is written into \a mat in column-major VTK order.
+/// Append to \a xf a rotation that takes the +X axis to the direction \a dir.
+/// \a dir must be a unit vector.  Degenerate cases (dir ≈ ±X) are handled
+/// explicitly to avoid a zero-length rotation axis.
 void buildAlignXToDir(const double dir[3], vtkTransform* xf)
 {
-    // VTK ArrowSource points along +X.  We want it along dir[].
-    // Strategy: rotate +X to dir using an angle-axis rotation.
-
     static const double xAxis[3] = {1.0, 0.0, 0.0};
 
     // Cross product: axis = +X × dir
@@ -90,74 +98,77 @@ void buildAlignXToDir(const double dir[3], vtkTransform* xf)
         xAxis[0]*dir[1] - xAxis[1]*dir[0]
     };
 
-    double angle = 0.0;
-
     const double axisLen = std::sqrt(axis[0]*axis[0] + axis[1]*axis[1] + axis[2]*axis[2]);
     const double cosA    = xAxis[0]*dir[0] + xAxis[1]*dir[1] + xAxis[2]*dir[2];
 
     if (axisLen < 1e-10) {
         // dir ≈ +X (cosA ≈ 1) → identity, or dir ≈ -X (cosA ≈ -1) → 180°.
         if (cosA < 0.0) {
-            // Rotate 180° around +Z.
             xf->RotateWXYZ(180.0, 0.0, 0.0, 1.0);
         }
-        // else: no rotation needed
         return;
     }
 
-    // angle in degrees
-    angle = std::atan2(axisLen, cosA) * (180.0 / M_PI);
+    const double angle = std::atan2(axisLen, cosA) * (180.0 / M_PI);
     axis[0] /= axisLen; axis[1] /= axisLen; axis[2] /= axisLen;
 
     xf->RotateWXYZ(angle, axis[0], axis[1], axis[2]);
 }
 
-/// Build a wireframe frustum polydata (8 edges) representing the camera FOV.
-///
-/// The frustum apex is at the origin.  The far-plane rectangle is at distance
-/// \a depth along +X.  Half-widths at the far plane are determined by the
-/// horizontal and vertical FOV angles.
-vtkSmartPointer<vtkPolyData> buildFrustumPolyData(double depth,
-                                                   double fovHDeg,
-                                                   double fovVDeg)
+/// Append the 8 frustum edges of the slot whose first point is \a base.
+void appendFrustumLines(vtkCellArray* lines, vtkIdType base)
 {
-    const double tanH = std::tan((fovHDeg * 0.5) * (M_PI / 180.0));
-    const double tanV = std::tan((fovVDeg * 0.5) * (M_PI / 180.0));
-    const double hw   = depth * tanH;   // half-width at far plane
-    const double hh   = depth * tanV;   // half-height at far plane
-
-    // 5 vertices: apex (0) + 4 far-plane corners (1..4)
-    auto pts = vtkSmartPointer<vtkPoints>::New();
-    pts->SetNumberOfPoints(5);
-    pts->SetPoint(0, 0.0,  0.0,  0.0);   // apex
-    pts->SetPoint(1, depth, -hw, -hh);   // bottom-left
-    pts->SetPoint(2, depth,  hw, -hh);   // bottom-right
-    pts->SetPoint(3, depth,  hw,  hh);   // top-right
-    pts->SetPoint(4, depth, -hw,  hh);   // top-left
-
-    // 8 line segments: 4 from apex to corners, 4 connecting corners.
-    auto lines = vtkSmartPointer<vtkCellArray>::New();
-
     // Apex -> corners
     for (vtkIdType c = 1; c <= 4; ++c) {
-        vtkIdType ids[2] = {0, c};
+        const vtkIdType ids[2] = {base, base + c};
         lines->InsertNextCell(2, ids);
     }
     // Far-plane rectangle
-    {
-        vtkIdType ids[2];
-        ids[0] = 1; ids[1] = 2; lines->InsertNextCell(2, ids);
-        ids[0] = 2; ids[1] = 3; lines->InsertNextCell(2, ids);
-        ids[0] = 3; ids[1] = 4; lines->InsertNextCell(2, ids);
-        ids[0] = 4; ids[1] = 1; lines->InsertNextCell(2, ids);
+    for (vtkIdType c = 1; c <= 4; ++c) {
+        const vtkIdType ids[2] = {base + c, base + (c % 4) + 1};
+        lines->InsertNextCell(2, ids);
     }
+}
 
+vtkUnsignedCharArray* colorsOf(vtkPolyData* pd)
+{
+    return vtkUnsignedCharArray::SafeDownCast(pd->GetPointData()->GetArray(kColorsArray));
+}
+
+vtkFloatArray* floatsOf(vtkPolyData* pd, const char* name)
+{
+    return vtkFloatArray::SafeDownCast(pd->GetPointData()->GetArray(name));
+}
+
+vtkStringArray* labelsOf(vtkPolyData* pd)
+{
+    return vtkStringArray::SafeDownCast(pd->GetPointData()->GetAbstractArray(kLabelsArray));
+}
+
+/// New poly-data with an empty point set and a named colour array.
+vtkSmartPointer<vtkPolyData> newColoredPolyData(int colorComponents)
+{
     auto pd = vtkSmartPointer<vtkPolyData>::New();
-    pd->SetPoints(pts);
-    pd->SetLines(lines);
+    pd->SetPoints(vtkSmartPointer<vtkPoints>::New());
+
+    // Also the active scalars, so glyph mappers that colour from the point
+    // scalars pick it up as well.
+    auto colors = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    colors->SetName(kColorsArray);
+    colors->SetNumberOfComponents(colorComponents);
+    pd->GetPointData()->SetScalars(colors);
     return pd;
 }
 
+/// Colour a mapper directly from the named "colors" point array.
+void useColorArray(vtkMapper* mapper)
+{
+    mapper->ScalarVisibilityOn();
+    mapper->SetScalarModeToUsePointFieldData();
+    mapper->SelectColorArray(kColorsArray);
+    mapper->SetColorModeToDirectScalars();
+}
+
 } // anonymous namespace
 
 // ============================================================================
@@ -168,15 +179,25 @@ PointAnnotator::PointAnnotator(CadScene* scene, QObject* parent)
     : QObject(parent)
     , m_scene(scene)
 {
-    m_picker = vtkSmartPointer<vtkCellPicker>::New();
-    m_picker->SetTolerance(0.005);
+    m_pickCell = vtkSmartPointer<vtkGenericCell>::New();
+
+    createBatchPipeline();
+    attachActors();
 }
 
 PointAnnotator::~PointAnnotator()
 {
-    // Remove all annotation actors from the renderer before this object dies.
-    clearTargets();
     clearPath();
+
+    // Remove the batched actors from the renderer before this object dies.
+    vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
+    if (ren && m_actorsAttached) {
+        ren->RemoveActor(m_markerActor);
+        ren->RemoveActor(m_arrowActor);
+        ren->RemoveActor(m_frustumActor);
+        ren->RemoveActor2D(m_labelActor);
+        ren->RemoveActor(m_hoverActor);
+    }
 }
 
 // ============================================================================
@@ -201,24 +222,12 @@ void PointAnnotator::setCaptureConfig(const hmi::CaptureConfig& config)
 {
     m_captureConfig = config;
 
-    // Rebuild the frustum actors for all existing visuals.
-    vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
-
-    for (auto it = m_visuals.begin(); it != m_visuals.end(); ++it) {
-        auto& vis = it.value();
-        if (vis.frustumActor && ren) {
-            ren->RemoveActor(vis.frustumActor);
-        }
-        vis.frustumActor = createFrustumActor(vis.target.surface, vis.target.view);
-        if (vis.frustumActor && ren) {
-            ren->AddActor(vis.frustumActor);
-        }
-    }
+    // Only the frustum points depend on the config; rewrite them in place.
+    writeFrustums(0, m_slotIds.size());
+    m_frustumData->GetPoints()->Modified();
+    m_frustumData->Modified();
 
-    if (ren) {
-        auto* rw = ren->GetRenderWindow();
-        if (rw) rw->Render();
-    }
+    render();
 }
 
 // ============================================================================
@@ -227,115 +236,143 @@ void PointAnnotator::setCaptureConfig(const hmi::CaptureConfig& config)
 
 void PointAnnotator::addTarget(const hmi::InspectionTarget& target)
 {
-    if (m_visuals.contains(target.pointId)) {
+    if (m_targets.contains(target.pointId)) {
         // Already present – treat as update.
         updateTarget(target);
         return;
     }
 
-    AnnotationVisual vis = createVisual(target);
-    vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
-    if (ren) {
-        if (vis.sphereActor)   ren->AddActor(vis.sphereActor);
-        if (vis.arrowActor)    ren->AddActor(vis.arrowActor);
-        if (vis.frustumActor)  ren->AddActor(vis.frustumActor);
-        if (vis.labelActor) {
-            // vtkFollower needs the camera to be set before adding to renderer.
-            auto* follower = vtkFollower::SafeDownCast(vis.labelActor.Get());
-            if (follower && ren->GetActiveCamera()) {
-                follower->SetCamera(ren->GetActiveCamera());
-            }
-            ren->AddActor(vis.labelActor);
+    attachActors();
+    storeTarget(target);
+    writeFrustums(m_slotIds.size() - 1, 1);
+    markTargetsModified();
+
+    render();
+    emit targetAdded(target.pointId);
+}
+
+void PointAnnotator::addTargets(const QVector<hmi::InspectionTarget>& targets)
+{
+    if (targets.isEmpty()) return;
+
+    attachActors();
+
+    const int firstNew = m_slotIds.size();
+    QVector<int32_t> added;
+    added.reserve(targets.size());
+    for (const auto& target : targets) {
+        if (storeTarget(target)) {
+            added.append(target.pointId);
         }
     }
+    writeFrustums(firstNew, m_slotIds.size() - firstNew);
+    markTargetsModified();
 
-    m_visuals.insert(target.pointId, std::move(vis));
-    emit targetAdded(target.pointId);
+    render();
+    emit targetsAdded(added);
+}
+
+void PointAnnotator::replaceTargets(const QVector<hmi::InspectionTarget>& targets)
+{
+    attachActors();
+
+    resetSlots();
+    for (const auto& target : targets) {
+        storeTarget(target);
+    }
+    writeFrustums(0, m_slotIds.size());
+    markTargetsModified();
+
+    render();
+    emit targetsReplaced();
 }
 
 void PointAnnotator::removeTarget(int32_t pointId)
 {
-    auto it = m_visuals.find(pointId);
-    if (it == m_visuals.end()) return;
+    auto it = m_slotOf.find(pointId);
+    if (it == m_slotOf.end()) return;
 
-    removeVisualFromRenderer(it.value());
-    m_visuals.erase(it);
+    removeSlot(it.value());
+    m_targets.remove(pointId);
+    markTargetsModified();
 
     if (m_selectedId == pointId) {
         m_selectedId = -1;
     }
 
-    if (m_scene && m_scene->renderer()) {
-        auto* rw = m_scene->renderer()->GetRenderWindow();
-        if (rw) rw->Render();
+    render();
+    emit targetRemoved(pointId);
+}
+
+void PointAnnotator::removeTargets(const QVector<int32_t>& pointIds)
+{
+    QVector<int32_t> removed;
+    removed.reserve(pointIds.size());
+    for (int32_t pointId : pointIds) {
+        auto it = m_slotOf.find(pointId);
+        if (it == m_slotOf.end()) continue;
+        removeSlot(it.value());
+        m_targets.remove(pointId);
+        if (m_selectedId == pointId) {
+            m_selectedId = -1;
+        }
+        removed.append(pointId);
     }
+    if (removed.isEmpty()) return;
+    markTargetsModified();
 
-    emit targetRemoved(pointId);
+    render();
+    emit targetsRemoved(removed);
 }
 
 void PointAnnotator::updateTarget(const hmi::InspectionTarget& target)
 {
-    auto it = m_visuals.find(target.pointId);
-    if (it == m_visuals.end()) {
+    auto it = m_slotOf.find(target.pointId);
+    if (it == m_slotOf.end()) {
         addTarget(target);
         return;
     }
 
-    // Remove old actors.
-    removeVisualFromRenderer(it.value());
+    m_targets[target.pointId] = target;
+    writeSlot(it.value(), target);
+    writeFrustums(it.value(), 1);
+    markTargetsModified();
 
-    // Rebuild.
-    const bool wasSelected = (m_selectedId == target.pointId);
-    AnnotationVisual vis = createVisual(target);
-    updateVisualAppearance(vis, wasSelected);
-
-    vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
-    if (ren) {
-        if (vis.sphereActor)   ren->AddActor(vis.sphereActor);
-        if (vis.arrowActor)    ren->AddActor(vis.arrowActor);
-        if (vis.frustumActor)  ren->AddActor(vis.frustumActor);
-        if (vis.labelActor) {
-            // vtkFollower needs the camera to be set before adding to renderer.
-            auto* follower = vtkFollower::SafeDownCast(vis.labelActor.Get());
-            if (follower && ren->GetActiveCamera()) {
-                follower->SetCamera(ren->GetActiveCamera());
-            }
-            ren->AddActor(vis.labelActor);
-        }
-    }
-
-    *it = std::move(vis);
-
-    if (ren) {
-        auto* rw = ren->GetRenderWindow();
-        if (rw) rw->Render();
-    }
+    render();
+    emit targetUpdated(target.pointId);
 }
 
 void PointAnnotator::clearTargets()
 {
-    for (auto it = m_visuals.begin(); it != m_visuals.end(); ++it) {
-        removeVisualFromRenderer(it.value());
-    }
-    m_visuals.clear();
-    m_selectedId = -1;
+    resetSlots();
+    markTargetsModified();
 
-    if (m_scene && m_scene->renderer()) {
-        auto* rw = m_scene->renderer()->GetRenderWindow();
-        if (rw) rw->Render();
-    }
+    render();
+    emit targetsCleared();
 }
 
 QVector<hmi::InspectionTarget> PointAnnotator::targets() const
 {
     QVector<hmi::InspectionTarget> result;
-    result.reserve(m_visuals.size());
-    for (auto it = m_visuals.begin(); it != m_visuals.end(); ++it) {
-        result.append(it.value().target);
+    result.reserve(m_targets.size());
+    for (auto it = m_targets.begin(); it != m_targets.end(); ++it) {
+        result.append(it.value());
     }
     return result;
 }
 
+int PointAnnotator::targetCount() const
+{
+    return m_targets.size();
+}
+
+std::optional<hmi::InspectionTarget> PointAnnotator::target(int32_t pointId) const
+{
+    auto it = m_targets.constFind(pointId);
+    if (it == m_targets.constEnd()) return std::nullopt;
+    return it.value();
+}
+
 // ============================================================================
 // Selection
 // ============================================================================
@@ -344,39 +381,34 @@ void PointAnnotator::selectTarget(int32_t pointId)
 {
     // Deselect previous.
     if (m_selectedId != -1 && m_selectedId != pointId) {
-        auto prev = m_visuals.find(m_selectedId);
-        if (prev != m_visuals.end()) {
-            updateVisualAppearance(prev.value(), false);
+        auto prev = m_slotOf.constFind(m_selectedId);
+        if (prev != m_slotOf.constEnd()) {
+            writeSlotAppearance(prev.value(), false);
         }
     }
 
     m_selectedId = pointId;
 
-    auto it = m_visuals.find(pointId);
-    if (it != m_visuals.end()) {
-        updateVisualAppearance(it.value(), true);
-    }
-
-    if (m_scene && m_scene->renderer()) {
-        auto* rw = m_scene->renderer()->GetRenderWindow();
-        if (rw) rw->Render();
+    auto it = m_slotOf.constFind(pointId);
+    if (it != m_slotOf.constEnd()) {
+        writeSlotAppearance(it.value(), true);
     }
+    markTargetsModified();
 
+    render();
     emit targetSelected(pointId);
 }
 
 void PointAnnotator::clearSelection()
 {
     if (m_selectedId != -1) {
-        auto it = m_visuals.find(m_selectedId);
-        if (it != m_visuals.end()) {
-            updateVisualAppearance(it.value(), false);
+        auto it = m_slotOf.constFind(m_selectedId);
+        if (it != m_slotOf.constEnd()) {
+            writeSlotAppearance(it.value(), false);
+            markTargetsModified();
         }
         m_selectedId = -1;
-        if (m_scene && m_scene->renderer()) {
-            auto* rw = m_scene->renderer()->GetRenderWindow();
-            if (rw) rw->Render();
-        }
+        render();
     }
 }
 
@@ -398,79 +430,65 @@ void PointAnnotator::showPath(const hmi::InspectionPath& path)
     vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
 
     // Main connecting polyline.
-    auto lineActor = createPathLineActor(path);
-    if (lineActor) {
-        if (ren) ren->AddActor(lineActor);
-        m_pathActors.append(lineActor);
-    }
+    m_pathLineActor = createPathLineActor(path);
+    if (m_pathLineActor && ren) ren->AddActor(m_pathLineActor);
 
-    // Small cyan sphere at each waypoint position (AGV XY position).
+    // Small green dot at each waypoint position (AGV XY position), all
+    // instanced from one sphere glyph.
+    auto dots = newColoredPolyData(4);
+    m_waypointColors = colorsOf(dots);
     for (const auto& wp : path.waypoints) {
-        auto sphere = vtkSmartPointer<vtkSphereSource>::New();
-        sphere->SetRadius(0.03);   // 3 cm waypoint dot
-        sphere->SetThetaResolution(10);
-        sphere->SetPhiResolution(10);
-        sphere->SetCenter(wp.agvPose.x, wp.agvPose.y, 0.01);
-        sphere->Update();
+        dots->GetPoints()->InsertNextPoint(wp.agvPose.x, wp.agvPose.y, 0.01);
+        m_waypointColors->InsertNextTypedTuple(kWaypointColor);
+    }
 
-        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-        mapper->SetInputConnection(sphere->GetOutputPort());
-        mapper->ScalarVisibilityOff();
+    auto sphere = vtkSmartPointer<vtkSphereSource>::New();
+    sphere->SetRadius(0.03);   // 3 cm waypoint dot
+    sphere->SetThetaResolution(10);
+    sphere->SetPhiResolution(10);
 
-        auto actor = vtkSmartPointer<vtkActor>::New();
-        actor->SetMapper(mapper);
-        actor->GetProperty()->SetColor(0.0, 0.9, 0.4);
-        actor->GetProperty()->SetOpacity(0.85);
+    auto mapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+    mapper->SetInputData(dots);
+    mapper->SetSourceConnection(sphere->GetOutputPort());
+    mapper->ScalingOff();
+    mapper->OrientOff();
+    useColorArray(mapper);
 
-        if (ren) ren->AddActor(actor);
-        m_pathActors.append(actor);
-    }
+    m_waypointActor = vtkSmartPointer<vtkActor>::New();
+    m_waypointActor->SetMapper(mapper);
+    if (ren) ren->AddActor(m_waypointActor);
 
-    if (ren) {
-        auto* rw = ren->GetRenderWindow();
-        if (rw) rw->Render();
-    }
+    render();
 }
 
 void PointAnnotator::clearPath()
 {
     vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
-    for (auto& actor : m_pathActors) {
-        if (ren && actor) ren->RemoveActor(actor);
-    }
-    m_pathActors.clear();
-
     if (ren) {
-        auto* rw = ren->GetRenderWindow();
-        if (rw) rw->Render();
+        if (m_pathLineActor) ren->RemoveActor(m_pathLineActor);
+        if (m_waypointActor) ren->RemoveActor(m_waypointActor);
     }
+    m_pathLineActor  = nullptr;
+    m_waypointActor  = nullptr;
+    m_waypointColors = nullptr;
+
+    render();
 }
 
 void PointAnnotator::highlightWaypoint(int index)
 {
-    // Path actors layout: [0] = polyline, [1..N] = sphere per waypoint.
-    // The waypoint sphere is at index (index + 1).
-    const int sphereIdx = index + 1;
-    if (sphereIdx < 0 || sphereIdx >= m_pathActors.size()) return;
-
-    // Reset all waypoint spheres to default colour.
-    for (int i = 1; i < m_pathActors.size(); ++i) {
-        if (m_pathActors[i]) {
-            m_pathActors[i]->GetProperty()->SetColor(0.0, 0.9, 0.4);
-            m_pathActors[i]->GetProperty()->SetOpacity(0.85);
-        }
-    }
+    if (!m_waypointColors) return;
+    const vtkIdType count = m_waypointColors->GetNumberOfTuples();
+    if (index < 0 || index >= count) return;
 
-    // Highlight the requested waypoint.
-    if (m_pathActors[sphereIdx]) {
-        m_pathActors[sphereIdx]->GetProperty()->SetColor(1.0, 1.0, 0.0);
-        m_pathActors[sphereIdx]->GetProperty()->SetOpacity(1.0);
+    // Reset all waypoint dots to the default colour, then highlight one.
+    for (vtkIdType i = 0; i < count; ++i) {
+        m_waypointColors->SetTypedTuple(i, kWaypointColor);
     }
+    m_waypointColors->SetTypedTuple(index, kWaypointActiveColor);
+    m_waypointColors->Modified();
 
-    if (m_scene && m_scene->renderer()) {
-        auto* rw = m_scene->renderer()->GetRenderWindow();
-        if (rw) rw->Render();
-    }
+    render();
 }
 
 // ============================================================================
@@ -479,93 +497,101 @@ void PointAnnotator::highlightWaypoint(int index)
 
 std::optional<hmi::SurfacePoint> PointAnnotator::pickSurface(int screenX, int screenY)
 {
-    if (!m_scene || !m_scene->renderer()) return std::nullopt;
-    if (!m_scene->modelActor())           return std::nullopt;
-
-    vtkRenderer* ren = m_scene->renderer();
-
-    // Restrict the picker to the model actor to avoid picking annotation spheres.
-    m_picker->InitializePickList();
-    m_picker->AddPickList(m_scene->modelActor());
-    m_picker->PickFromListOn();
-
-    const int result = m_picker->Pick(
-        static_cast<double>(screenX),
-        static_cast<double>(screenY),
-        0.0,
-        ren
-    );
-
-    if (result == 0) return std::nullopt;
+    // The ray always hits the full mesh (its locator); also show it, so the
+    // new marker does not sit on a coarser proxy surface.
+    if (m_scene) m_scene->ensureFullResolution();
+    auto sp = castRay(screenX, screenY);
+    if (sp) {
+        emit surfacePicked(*sp);
+    }
+    return sp;
+}
 
-    double worldPos[3];
-    m_picker->GetPickPosition(worldPos);
+std::optional<hmi::SurfacePoint> PointAnnotator::hoverSurface(int screenX, int screenY)
+{
+    auto sp = castRay(screenX, screenY);
+    if (!sp) {
+        clearHover();
+        return sp;
+    }
 
-    double normal[3] = {0.0, 0.0, 1.0};
-    m_picker->GetPickNormal(normal);
+    attachActors();
 
-    hmi::SurfacePoint sp;
-    sp.position  = QVector3D(static_cast<float>(worldPos[0]),
-                             static_cast<float>(worldPos[1]),
-                             static_cast<float>(worldPos[2]));
-    sp.normal    = QVector3D(static_cast<float>(normal[0]),
-                             static_cast<float>(normal[1]),
-                             static_cast<float>(normal[2]));
-    sp.frameId   = QStringLiteral("cad");
-    sp.faceIndex = static_cast<uint32_t>(m_picker->GetCellId());
+    // Move the preview arrow: translate to the hit, rotate +X → normal.
+    double nDir[3] = {
+        static_cast<double>(sp->normal.x()),
+        static_cast<double>(sp->normal.y()),
+        static_cast<double>(sp->normal.z())
+    };
+    m_hoverTransform->Identity();
+    m_hoverTransform->Translate(static_cast<double>(sp->position.x()),
+                                static_cast<double>(sp->position.y()),
+                                static_cast<double>(sp->position.z()));
+    if (normalise3(nDir)) {
+        buildAlignXToDir(nDir, m_hoverTransform);
+    }
+    m_hoverActor->VisibilityOn();
+    render();
 
-    emit surfacePicked(sp);
+    emit surfaceHovered(*sp);
     return sp;
 }
 
+void PointAnnotator::clearHover()
+{
+    if (m_hoverActor && m_hoverActor->GetVisibility()) {
+        m_hoverActor->VisibilityOff();
+        render();
+    }
+}
+
 // ============================================================================
 // Private helpers
 // ============================================================================
 
-PointAnnotator::AnnotationVisual
-PointAnnotator::createVisual(const hmi::InspectionTarget& target)
+void PointAnnotator::createBatchPipeline()
 {
-    AnnotationVisual vis;
-    vis.target = target;
-
-    const double px = static_cast<double>(target.surface.position.x());
-    const double py = static_cast<double>(target.surface.position.y());
-    const double pz = static_cast<double>(target.surface.position.z());
-
     // ----------------------------------------------------------------
-    // 1. Sphere marker (red, radius ≈ 3 mm for a typical meter-scale model)
+    // Marker point set shared by the sphere and arrow glyph mappers
     // ----------------------------------------------------------------
+    m_markerData = newColoredPolyData(3);
+    {
+        auto scale = vtkSmartPointer<vtkFloatArray>::New();
+        scale->SetName(kScaleArray);
+        m_markerData->GetPointData()->AddArray(scale);
+
+        auto normals = vtkSmartPointer<vtkFloatArray>::New();
+        normals->SetName(kNormalsArray);
+        normals->SetNumberOfComponents(3);
+        m_markerData->GetPointData()->AddArray(normals);
+    }
+
+    // 1. Sphere marker (radius ≈ 3 mm for a typical meter-scale model);
+    //    per-point colour and scale carry the selection state.
     {
         auto sphere = vtkSmartPointer<vtkSphereSource>::New();
         sphere->SetRadius(0.003);
-        sphere->SetCenter(px, py, pz);
         sphere->SetThetaResolution(16);
         sphere->SetPhiResolution(16);
-        sphere->Update();
-
-        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-        mapper->SetInputConnection(sphere->GetOutputPort());
-        mapper->ScalarVisibilityOff();
 
-        vis.sphereActor = vtkSmartPointer<vtkActor>::New();
-        vis.sphereActor->SetMapper(mapper);
-        vis.sphereActor->GetProperty()->SetColor(0.9, 0.1, 0.1);  // red
-        vis.sphereActor->GetProperty()->SetAmbient(0.3);
-        vis.sphereActor->GetProperty()->SetDiffuse(0.7);
+        auto mapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+        mapper->SetInputData(m_markerData);
+        mapper->SetSourceConnection(sphere->GetOutputPort());
+        mapper->ScalingOn();
+        mapper->SetScaleModeToScaleByMagnitude();
+        mapper->SetScaleArray(kScaleArray);
+        mapper->SetScaleFactor(1.0);
+        mapper->OrientOff();
+        useColorArray(mapper);
+
+        m_markerActor = vtkSmartPointer<vtkActor>::New();
+        m_markerActor->SetMapper(mapper);
+        m_markerActor->GetProperty()->SetAmbient(0.3);
+        m_markerActor->GetProperty()->SetDiffuse(0.7);
     }
 
-    // ----------------------------------------------------------------
-    // 2. Normal arrow (blue, length ≈ 15 mm)
-    // ----------------------------------------------------------------
+    // 2. Normal arrow (blue, length ≈ 15 mm), oriented by the normals array.
     {
-        double nx = static_cast<double>(target.surface.normal.x());
-        double ny = static_cast<double>(target.surface.normal.y());
-        double nz = static_cast<double>(target.surface.normal.z());
-        double nDir[3] = {nx, ny, nz};
-        if (!normalise3(nDir)) {
-            nDir[0] = 0.0; nDir[1] = 0.0; nDir[2] = 1.0;
-        }
-
         const double arrowLen = 0.015;  // 15 mm
 
         auto arrow = vtkSmartPointer<vtkArrowSource>::New();
@@ -574,162 +600,269 @@ PointAnnotator::createVisual(const hmi::InspectionTarget& target)
         arrow->SetShaftRadius(0.02);
         arrow->SetTipResolution(12);
         arrow->SetShaftResolution(12);
-        arrow->Update();
 
-        // Transform: scale to arrowLen, rotate +X → normal, translate to surface pos.
+        // Bake the length into the glyph source; instances are unscaled.
         auto xf = vtkSmartPointer<vtkTransform>::New();
-        xf->Translate(px, py, pz);
-        buildAlignXToDir(nDir, xf);
         xf->Scale(arrowLen, arrowLen, arrowLen);
 
         auto xfFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
         xfFilter->SetInputConnection(arrow->GetOutputPort());
         xfFilter->SetTransform(xf);
-        xfFilter->Update();
 
-        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-        mapper->SetInputConnection(xfFilter->GetOutputPort());
+        auto mapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+        mapper->SetInputData(m_markerData);
+        mapper->SetSourceConnection(xfFilter->GetOutputPort());
+        mapper->ScalingOff();
+        mapper->OrientOn();
+        mapper->SetOrientationModeToDirection();     // +X → normal
+        mapper->SetOrientationArray(kNormalsArray);
         mapper->ScalarVisibilityOff();
 
-        vis.arrowActor = vtkSmartPointer<vtkActor>::New();
-        vis.arrowActor->SetMapper(mapper);
-        vis.arrowActor->GetProperty()->SetColor(0.1, 0.3, 0.9);  // blue
-        vis.arrowActor->GetProperty()->SetAmbient(0.3);
-        vis.arrowActor->GetProperty()->SetDiffuse(0.7);
+        m_arrowActor = vtkSmartPointer<vtkActor>::New();
+        m_arrowActor->SetMapper(mapper);
+        m_arrowActor->GetProperty()->SetColor(0.1, 0.3, 0.9);  // blue
+        m_arrowActor->GetProperty()->SetAmbient(0.3);
+        m_arrowActor->GetProperty()->SetDiffuse(0.7);
     }
 
-    // ----------------------------------------------------------------
-    // 3. Camera frustum (wireframe, based on CaptureConfig + ViewHint)
-    // ----------------------------------------------------------------
-    vis.frustumActor = createFrustumActor(target.surface, target.view);
+    // 3. Camera frustums: one merged wireframe, RGBA per point so the
+    //    selected frustum can be highlighted without a separate actor.
+    m_frustumData = newColoredPolyData(4);
+    m_frustumData->SetLines(vtkSmartPointer<vtkCellArray>::New());
+    {
+        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        mapper->SetInputData(m_frustumData);
+        useColorArray(mapper);
 
-    // ----------------------------------------------------------------
-    // 4. Billboard text label showing the point ID
-    // ----------------------------------------------------------------
+        m_frustumActor = vtkSmartPointer<vtkActor>::New();
+        m_frustumActor->SetMapper(mapper);
+        m_frustumActor->GetProperty()->SetRepresentationToWireframe();
+        m_frustumActor->GetProperty()->SetLineWidth(1.0);
+    }
+
+    // 4. Point-ID labels: one screen-space label mapper over the anchors.
+    m_labelData = vtkSmartPointer<vtkPolyData>::New();
+    m_labelData->SetPoints(vtkSmartPointer<vtkPoints>::New());
     {
-        auto label = vtkSmartPointer<vtkBillboardTextActor3D>::New();
-        label->SetInput(QString::number(target.pointId).toLocal8Bit().constData());
-        label->SetPosition(px, py, pz + 0.005);  // slight offset above the sphere
+        auto labels = vtkSmartPointer<vtkStringArray>::New();
+        labels->SetName(kLabelsArray);
+        m_labelData->GetPointData()->AddArray(labels);
+
+        auto mapper = vtkSmartPointer<vtkLabeledDataMapper>::New();
+        mapper->SetInputData(m_labelData);
+        mapper->SetLabelModeToLabelFieldData();
+        mapper->SetFieldDataName(kLabelsArray);
 
-        vtkTextProperty* tp = label->GetTextProperty();
+        vtkTextProperty* tp = mapper->GetLabelTextProperty();
         tp->SetFontSize(14);
-        tp->SetColor(1.0, 1.0, 1.0);           // white text
-        tp->SetBackgroundColor(0.0, 0.0, 0.0);
-        tp->SetBackgroundOpacity(0.55);
+        tp->SetColor(1.0, 1.0, 0.2);           // yellow text
         tp->SetFontFamilyToCourier();
         tp->BoldOn();
+        tp->ShadowOn();
 
-        vis.labelActor = vtkSmartPointer<vtkActor>::New();
-
-        // vtkBillboardTextActor3D is a vtkActor2D subclass, but we store it
-        // through vtkActor for interface simplicity.  We add it to the
-        // renderer explicitly below using a raw pointer cast.
-        // Actually, store as vtkActor2D-compatible by adding separately.
-        // We'll cast back when adding to renderer.
-        // Store the label as a separate member using a union trick:
-        // We reuse the labelActor field by casting — but vtkBillboardTextActor3D
-        // IS-A vtkActor2D, not vtkActor.  We store it as vtkActor using
-        // vtkSmartPointer<vtkActor> only if we downcast.
-        //
-        // VTK design: vtkBillboardTextActor3D inherits vtkActor2D, NOT vtkActor.
-        // We handle this by storing it directly via vtkActor2D and adding it to
-        // the renderer with AddActor2D.  The AnnotationVisual struct uses
-        // vtkSmartPointer<vtkActor> for labelActor; we set it to nullptr and
-        // store the text actor separately.
-        //
-        // Solution: store via a separate map – but to keep the struct clean we
-        // store the text actor pointer in a parallel map keyed by pointId.
-        // The actor is still owned by a vtkSmartPointer inside the struct; we
-        // just need the vtk2dLabel_ approach.
-        //
-        // Simpler solution chosen: use vtkFollower (IS-A vtkActor) with
-        // vtkVectorText instead.  This renders text as 3-D geometry, is a proper
-        // vtkActor subclass, and the camera parameter makes it always face the viewer.
-
-        // We will implement a vtkFollower+vtkVectorText text label in a
-        // separate block below.  The billboard label variable goes unused.
-        (void)label;
-        vis.labelActor = nullptr;  // will be replaced by vtkFollower below
+        m_labelActor = vtkSmartPointer<vtkActor2D>::New();
+        m_labelActor->SetMapper(mapper);
     }
 
-    // ----------------------------------------------------------------
-    // 4b. 3-D text label via vtkVectorText + vtkFollower
-    //     vtkFollower IS-A vtkActor and always faces the active camera.
-    // ----------------------------------------------------------------
+    // 5. Hover preview: a green normal arrow, twice the marker arrow length.
     {
-        auto vtext = vtkSmartPointer<vtkVectorText>::New();
-        vtext->SetText(QString::number(target.pointId).toLocal8Bit().constData());
-        vtext->Update();
+        auto arrow = vtkSmartPointer<vtkArrowSource>::New();
+        arrow->SetTipLength(0.25);
+        arrow->SetTipRadius(0.05);
+        arrow->SetShaftRadius(0.02);
+        arrow->SetTipResolution(12);
+        arrow->SetShaftResolution(12);
+
+        auto xf = vtkSmartPointer<vtkTransform>::New();
+        xf->Scale(0.03, 0.03, 0.03);   // 30 mm
 
-        // Scale text to ≈2 mm height and position it just above the sphere.
-        const double textScale = 0.004;  // 4 mm per unit (VTK text is ~1 unit tall)
+        auto xfFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+        xfFilter->SetInputConnection(arrow->GetOutputPort());
+        xfFilter->SetTransform(xf);
 
-        auto textMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-        textMapper->SetInputConnection(vtext->GetOutputPort());
-        textMapper->ScalarVisibilityOff();
+        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        mapper->SetInputConnection(xfFilter->GetOutputPort());
+        mapper->ScalarVisibilityOff();
 
-        auto follower = vtkSmartPointer<vtkFollower>::New();
-        follower->SetMapper(textMapper);
-        follower->SetScale(textScale, textScale, textScale);
-        follower->SetPosition(px, py, pz + 0.008);
-        follower->GetProperty()->SetColor(1.0, 1.0, 0.2);  // yellow text
-        follower->GetProperty()->SetAmbient(1.0);
-        follower->GetProperty()->SetDiffuse(0.0);
+        m_hoverTransform = vtkSmartPointer<vtkTransform>::New();
 
-        vis.labelActor = follower;
+        m_hoverActor = vtkSmartPointer<vtkActor>::New();
+        m_hoverActor->SetMapper(mapper);
+        m_hoverActor->SetUserTransform(m_hoverTransform);
+        m_hoverActor->GetProperty()->SetColor(0.1, 0.9, 0.3);
+        m_hoverActor->GetProperty()->SetAmbient(0.4);
+        m_hoverActor->PickableOff();
+        m_hoverActor->VisibilityOff();
     }
+}
+
+// ============================================================================
+
+void PointAnnotator::attachActors()
+{
+    if (m_actorsAttached) return;
+    vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
+    if (!ren) return;
 
-    return vis;
+    ren->AddActor(m_markerActor);
+    ren->AddActor(m_arrowActor);
+    ren->AddActor(m_frustumActor);
+    ren->AddActor2D(m_labelActor);
+    ren->AddActor(m_hoverActor);
+    m_actorsAttached = true;
 }
 
 // ============================================================================
 
-void PointAnnotator::updateVisualAppearance(AnnotationVisual& visual, bool selected)
+bool PointAnnotator::storeTarget(const hmi::InspectionTarget& target)
 {
-    if (!visual.sphereActor) return;
+    auto it = m_slotOf.constFind(target.pointId);
+    if (it != m_slotOf.constEnd()) {
+        m_targets[target.pointId] = target;
+        writeSlot(it.value(), target);
+        writeFrustums(it.value(), 1);
+        return false;
+    }
 
-    if (selected) {
-        // Larger yellow sphere.
-        visual.sphereActor->GetProperty()->SetColor(1.0, 0.9, 0.0);  // yellow
-        visual.sphereActor->SetScale(2.0, 2.0, 2.0);
-    } else {
-        // Normal red sphere.
-        visual.sphereActor->GetProperty()->SetColor(0.9, 0.1, 0.1);  // red
-        visual.sphereActor->SetScale(1.0, 1.0, 1.0);
-    }
-
-    if (visual.frustumActor) {
-        if (selected) {
-            visual.frustumActor->GetProperty()->SetColor(1.0, 0.9, 0.0);
-            visual.frustumActor->GetProperty()->SetOpacity(0.7);
-            visual.frustumActor->GetProperty()->SetLineWidth(2.0);
-        } else {
-            visual.frustumActor->GetProperty()->SetColor(0.3, 0.7, 1.0);
-            visual.frustumActor->GetProperty()->SetOpacity(0.45);
-            visual.frustumActor->GetProperty()->SetLineWidth(1.0);
+    m_targets.insert(target.pointId, target);
+    m_slotOf.insert(target.pointId, m_slotIds.size());
+    m_slotIds.append(target.pointId);
+    appendSlot(target);
+    return true;
+}
+
+void PointAnnotator::resetSlots()
+{
+    m_targets.clear();
+    m_slotIds.clear();
+    m_slotOf.clear();
+    m_selectedId = -1;
+
+    for (vtkPolyData* pd : {m_markerData.Get(), m_frustumData.Get(), m_labelData.Get()}) {
+        pd->GetPoints()->Reset();
+        for (int i = 0; i < pd->GetPointData()->GetNumberOfArrays(); ++i) {
+            pd->GetPointData()->GetAbstractArray(i)->Reset();
         }
     }
+    m_frustumData->GetLines()->Reset();
 }
 
 // ============================================================================
 
-void PointAnnotator::removeVisualFromRenderer(AnnotationVisual& visual)
+void PointAnnotator::appendSlot(const hmi::InspectionTarget& target)
 {
-    vtkRenderer* ren = m_scene ? m_scene->renderer() : nullptr;
-    if (!ren) return;
+    // Grow every array by one tuple, then fill the tuple in place.
+    m_markerData->GetPoints()->InsertNextPoint(0.0, 0.0, 0.0);
+    colorsOf(m_markerData)->InsertNextTypedTuple(kMarkerColor);
+    floatsOf(m_markerData, kScaleArray)->InsertNextValue(1.0f);
+    floatsOf(m_markerData, kNormalsArray)->InsertNextTuple3(0.0, 0.0, 1.0);
+
+    const vtkIdType base = m_frustumData->GetPoints()->GetNumberOfPoints();
+    for (int k = 0; k < kFrustumPoints; ++k) {
+        m_frustumData->GetPoints()->InsertNextPoint(0.0, 0.0, 0.0);
+        colorsOf(m_frustumData)->InsertNextTypedTuple(kFrustumColor);
+    }
+    appendFrustumLines(m_frustumData->GetLines(), base);
+
+    m_labelData->GetPoints()->InsertNextPoint(0.0, 0.0, 0.0);
+    labelsOf(m_labelData)->InsertNextValue("");
+
+    writeSlot(m_slotIds.size() - 1, target);
+}
+
+void PointAnnotator::writeSlot(int slot, const hmi::InspectionTarget& target)
+{
+    const double px = static_cast<double>(target.surface.position.x());
+    const double py = static_cast<double>(target.surface.position.y());
+    const double pz = static_cast<double>(target.surface.position.z());
+
+    m_markerData->GetPoints()->SetPoint(slot, px, py, pz);
+
+    double nDir[3] = {
+        static_cast<double>(target.surface.normal.x()),
+        static_cast<double>(target.surface.normal.y()),
+        static_cast<double>(target.surface.normal.z())
+    };
+    if (!normalise3(nDir)) {
+        nDir[0] = 0.0; nDir[1] = 0.0; nDir[2] = 1.0;
+    }
+    floatsOf(m_markerData, kNormalsArray)->SetTuple(slot, nDir);
 
-    if (visual.sphereActor)   ren->RemoveActor(visual.sphereActor);
-    if (visual.arrowActor)    ren->RemoveActor(visual.arrowActor);
-    if (visual.frustumActor)  ren->RemoveActor(visual.frustumActor);
-    if (visual.labelActor)    ren->RemoveActor(visual.labelActor);
+    // Label anchor just above the sphere.
+    m_labelData->GetPoints()->SetPoint(slot, px, py, pz + 0.008);
+    labelsOf(m_labelData)->SetValue(
+        slot, QString::number(target.pointId).toLocal8Bit().constData());
+}
+
+void PointAnnotator::writeSlotAppearance(int slot, bool selected)
+{
+    // Larger yellow sphere when selected, normal red otherwise.
+    colorsOf(m_markerData)->SetTypedTuple(
+        slot, selected ? kMarkerSelectedColor : kMarkerColor);
+    floatsOf(m_markerData, kScaleArray)->SetValue(slot, selected ? 2.0f : 1.0f);
+
+    vtkUnsignedCharArray* fc = colorsOf(m_frustumData);
+    for (int k = 0; k < kFrustumPoints; ++k) {
+        fc->SetTypedTuple(static_cast<vtkIdType>(slot) * kFrustumPoints + k,
+                          selected ? kFrustumSelectedColor : kFrustumColor);
+    }
+}
+
+void PointAnnotator::removeSlot(int slot)
+{
+    const int last = m_slotIds.size() - 1;
+    const int32_t removedId = m_slotIds[slot];
+
+    auto copyTuples = [](vtkPolyData* pd, vtkIdType from, vtkIdType to) {
+        pd->GetPoints()->SetPoint(to, pd->GetPoints()->GetPoint(from));
+        for (int i = 0; i < pd->GetPointData()->GetNumberOfArrays(); ++i) {
+            vtkAbstractArray* arr = pd->GetPointData()->GetAbstractArray(i);
+            arr->SetTuple(to, from, arr);
+        }
+    };
+
+    // Move the last slot into the hole so every slot stays contiguous.
+    if (slot != last) {
+        copyTuples(m_markerData, last, slot);
+        copyTuples(m_labelData,  last, slot);
+        for (int k = 0; k < kFrustumPoints; ++k) {
+            copyTuples(m_frustumData,
+                       static_cast<vtkIdType>(last) * kFrustumPoints + k,
+                       static_cast<vtkIdType>(slot) * kFrustumPoints + k);
+        }
+        m_slotIds[slot] = m_slotIds[last];
+        m_slotOf[m_slotIds[slot]] = slot;
+    }
+
+    // Drop the (now duplicated) last slot.
+    auto truncate = [](vtkPolyData* pd, vtkIdType count) {
+        pd->GetPoints()->SetNumberOfPoints(count);
+        for (int i = 0; i < pd->GetPointData()->GetNumberOfArrays(); ++i) {
+            pd->GetPointData()->GetAbstractArray(i)->SetNumberOfTuples(count);
+        }
+    };
+    truncate(m_markerData, last);
+    truncate(m_labelData,  last);
+    truncate(m_frustumData, static_cast<vtkIdType>(last) * kFrustumPoints);
+
+    // Frustum topology depends only on the slot count: drop the last slot's
+    // edges, which are the trailing two-point cells.
+    vtkCellArray* lines = m_frustumData->GetLines();
+    const vtkIdType cells = static_cast<vtkIdType>(last) * kFrustumLines;
+    lines->GetOffsetsArray()->SetNumberOfTuples(cells + 1);
+    lines->GetConnectivityArray()->SetNumberOfTuples(2 * cells);
+    lines->Modified();
+
+    m_slotIds.removeLast();
+    m_slotOf.remove(removedId);
 }
 
 // ============================================================================
 
-vtkSmartPointer<vtkActor>
-PointAnnotator::createFrustumActor(const hmi::SurfacePoint& surface,
-                                    const hmi::ViewHint&     view)
+void PointAnnotator::writeFrustums(int first, int count)
 {
+    if (count <= 0) return;
+
     // Use reasonable defaults when capture config is not yet set.
     const double focusDist = (m_captureConfig.focusDistanceM > 1e-6)
                              ? m_captureConfig.focusDistanceM
@@ -741,62 +874,165 @@ PointAnnotator::createFrustumActor(const hmi::SurfacePoint& surface,
                         ? m_captureConfig.fovVDeg
                         : 45.0;
 
-    // Build the canonical frustum pointing along +X.
-    auto frustumPD = buildFrustumPolyData(focusDist, fovH, fovV);
-
-    // View direction: from the surface point toward the camera.
-    // Convention: view_direction = camera forward.  The apex of the frustum
-    // is at surface + view_direction * focusDist (camera origin).
-    double vd[3];
-    vd[0] = static_cast<double>(view.viewDirection.x());
-    vd[1] = static_cast<double>(view.viewDirection.y());
-    vd[2] = static_cast<double>(view.viewDirection.z());
-    if (!normalise3(vd)) {
-        // Fall back to surface normal direction.
-        vd[0] = -static_cast<double>(surface.normal.x());
-        vd[1] = -static_cast<double>(surface.normal.y());
-        vd[2] = -static_cast<double>(surface.normal.z());
+    // SoA lanes: surface, opening direction, roll cos / sin, apex, corners.
+    const std::size_t n = static_cast<std::size_t>(count);
+    m_frustumScratch.resize((3 + 3 + 2 + 3 + 4 * 3) * n);
+    float* lane = m_frustumScratch.data();
+    auto next = [&lane, n]() { float* p = lane; lane += n; return p; };
+    const hmi::coord::Vec3Span surface{next(), next(), next()};
+    const hmi::coord::Vec3Span openDir{next(), next(), next()};
+    float* rollCos = next();
+    float* rollSin = next();
+    const hmi::coord::Vec3Span apex{next(), next(), next()};
+    std::array<hmi::coord::Vec3Span, 4> corners;
+    for (auto& c : corners) c = {next(), next(), next()};
+
+    bool rolled = false;
+    for (std::size_t i = 0; i < n; ++i) {
+        const hmi::InspectionTarget& target =
+            *m_targets.constFind(m_slotIds[first + static_cast<int>(i)]);
+
+        // View direction: camera forward, falling back to the surface normal.
+        double vd[3] = {
+            static_cast<double>(target.view.viewDirection.x()),
+            static_cast<double>(target.view.viewDirection.y()),
+            static_cast<double>(target.view.viewDirection.z())
+        };
         if (!normalise3(vd)) {
-            vd[0] = 0.0; vd[1] = 0.0; vd[2] = 1.0;
+            vd[0] = -static_cast<double>(target.surface.normal.x());
+            vd[1] = -static_cast<double>(target.surface.normal.y());
+            vd[2] = -static_cast<double>(target.surface.normal.z());
+            if (!normalise3(vd)) {
+                vd[0] = 0.0; vd[1] = 0.0; vd[2] = 1.0;
+            }
         }
+
+        surface.x[i] = target.surface.position.x();
+        surface.y[i] = target.surface.position.y();
+        surface.z[i] = target.surface.position.z();
+        // The camera looks along vd; the frustum opens from the apex at
+        // surface + vd * focusDist back towards the surface (-vd).
+        openDir.x[i] = static_cast<float>(-vd[0]);
+        openDir.y[i] = static_cast<float>(-vd[1]);
+        openDir.z[i] = static_cast<float>(-vd[2]);
+
+        const double roll = target.view.rollDeg * (M_PI / 180.0);
+        rolled = rolled || std::abs(target.view.rollDeg) > 1e-6;
+        rollCos[i] = static_cast<float>(std::cos(roll));
+        rollSin[i] = static_cast<float>(std::sin(roll));
     }
 
-    // Frustum apex position: surface + vd * focusDist.
-    const double ax = static_cast<double>(surface.position.x()) + vd[0] * focusDist;
-    const double ay = static_cast<double>(surface.position.y()) + vd[1] * focusDist;
-    const double az = static_cast<double>(surface.position.z()) + vd[2] * focusDist;
+    // Canonical frustum along +X (apex at the origin, far plane at
+    // focusDist) carried onto the opening direction by the shortest
+    // rotation, then rolled about it – the frame of buildAlignXToDir().
+    hmi::coord::cameraPositionBatch({surface.x, surface.y, surface.z},
+                                    {openDir.x, openDir.y, openDir.z},
+                                    n, focusDist, apex);
+    hmi::coord::frustumCornersBatch({apex.x, apex.y, apex.z},
+                                    {openDir.x, openDir.y, openDir.z},
+                                    n, focusDist, fovH, fovV, corners,
+                                    hmi::coord::FrustumBasis::ShortestArc,
+                                    rolled ? hmi::coord::RollSpan{rollCos, rollSin}
+                                           : hmi::coord::RollSpan{});
+
+    // Slot layout: apex, then bottom-left, bottom-right, top-right, top-left.
+    static constexpr int kCornerOrder[4] = {3, 2, 1, 0};
+    vtkPoints* pts = m_frustumData->GetPoints();
+    for (std::size_t i = 0; i < n; ++i) {
+        const vtkIdType base = (first + static_cast<vtkIdType>(i)) * kFrustumPoints;
+        pts->SetPoint(base, apex.x[i], apex.y[i], apex.z[i]);
+        for (int k = 0; k < 4; ++k) {
+            const hmi::coord::Vec3Span& c = corners[kCornerOrder[k]];
+            pts->SetPoint(base + 1 + k, c.x[i], c.y[i], c.z[i]);
+        }
+    }
+}
+
+// ============================================================================
+
+std::optional<hmi::SurfacePoint> PointAnnotator::castRay(int screenX, int screenY)
+{
+    if (!m_scene || !m_scene->renderer()) return std::nullopt;
+    vtkAbstractCellLocator* locator = m_scene->modelLocator();
+    vtkPolyData*            model   = m_scene->modelPolyData();
+    if (!locator || !model) return std::nullopt;
 
-    // The frustum geometry is built along +X.
-    // We need to rotate +X to POINT AWAY from the apex (opposite of viewDirection),
-    // because the frustum opens away from the camera toward the surface.
-    // Camera looks along vd; so frustum opens in the direction (-vd).
-    double openDir[3] = {-vd[0], -vd[1], -vd[2]};
+    vtkRenderer* ren = m_scene->renderer();
 
-    auto xf = vtkSmartPointer<vtkTransform>::New();
-    xf->Translate(ax, ay, az);
-    buildAlignXToDir(openDir, xf);
-    // Roll: rotate around the (now-aligned) +X axis by rollDeg.
-    if (std::abs(view.rollDeg) > 1e-6) {
-        xf->RotateX(view.rollDeg);
+    // Ray from the near to the far clipping plane through the pixel.
+    double p0[3];
+    double p1[3];
+    for (int end = 0; end < 2; ++end) {
+        ren->SetDisplayPoint(static_cast<double>(screenX),
+                             static_cast<double>(screenY),
+                             end == 0 ? 0.0 : 1.0);
+        ren->DisplayToWorld();
+        const double* w = ren->GetWorldPoint();
+        if (std::abs(w[3]) < 1e-12) return std::nullopt;
+        double* out = (end == 0) ? p0 : p1;
+        out[0] = w[0] / w[3];
+        out[1] = w[1] / w[3];
+        out[2] = w[2] / w[3];
     }
 
-    auto xfFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-    xfFilter->SetInputData(frustumPD);
-    xfFilter->SetTransform(xf);
-    xfFilter->Update();
+    // Nearest hit along the ray, via the locator built at load time.
+    double    t = 0.0;
+    double    hit[3];
+    double    pcoords[3];
+    int       subId  = 0;
+    vtkIdType cellId = -1;
+    if (!locator->IntersectWithLine(p0, p1, 0.0, t, hit, pcoords, subId, cellId, m_pickCell)
+        || cellId < 0) {
+        return std::nullopt;
+    }
 
-    auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    mapper->SetInputConnection(xfFilter->GetOutputPort());
-    mapper->ScalarVisibilityOff();
+    // Face normal: stored cell normals when present, else from the polygon.
+    double normal[3] = {0.0, 0.0, 1.0};
+    if (vtkDataArray* cellNormals = model->GetCellData()->GetNormals()) {
+        cellNormals->GetTuple(cellId, normal);
+    } else {
+        model->GetCell(cellId, m_pickCell);
+        vtkPolygon::ComputeNormal(m_pickCell->GetPoints(), normal);
+    }
+    if (!normalise3(normal)) {
+        normal[0] = 0.0; normal[1] = 0.0; normal[2] = 1.0;
+    }
+    // Face the viewer, so targets on either side of thin parts look at the
+    // surface from the camera's side.
+    const double ray[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+    if (normal[0]*ray[0] + normal[1]*ray[1] + normal[2]*ray[2] > 0.0) {
+        normal[0] = -normal[0]; normal[1] = -normal[1]; normal[2] = -normal[2];
+    }
 
-    auto actor = vtkSmartPointer<vtkActor>::New();
-    actor->SetMapper(mapper);
-    actor->GetProperty()->SetColor(0.3, 0.7, 1.0);       // light blue wireframe
-    actor->GetProperty()->SetRepresentationToWireframe();
-    actor->GetProperty()->SetLineWidth(1.0);
-    actor->GetProperty()->SetOpacity(0.45);
+    hmi::SurfacePoint sp;
+    sp.position  = QVector3D(static_cast<float>(hit[0]),
+                             static_cast<float>(hit[1]),
+                             static_cast<float>(hit[2]));
+    sp.normal    = QVector3D(static_cast<float>(normal[0]),
+                             static_cast<float>(normal[1]),
+                             static_cast<float>(normal[2]));
+    sp.frameId   = QStringLiteral("cad");
+    sp.faceIndex = static_cast<uint32_t>(cellId);
+    return sp;
+}
 
-    return actor;
+// ============================================================================
+
+void PointAnnotator::markTargetsModified()
+{
+    for (vtkPolyData* pd : {m_markerData.Get(), m_frustumData.Get(), m_labelData.Get()}) {
+        pd->GetPoints()->Modified();
+        for (int i = 0; i < pd->GetPointData()->GetNumberOfArrays(); ++i) {
+            pd->GetPointData()->GetAbstractArray(i)->Modified();
+        }
+        pd->Modified();
+    }
+    m_frustumData->GetLines()->Modified();
+}
+
+void PointAnnotator::render()
+{
+    if (m_scene) m_scene->render();
 }
 
 // ============================================================================
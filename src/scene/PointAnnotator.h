@@ -6,23 +6,43 @@
 //   - a sphere marker at the surface position
 //   - an arrow along the surface normal
 //   - a wireframe camera frustum
-//   - a billboard text label showing the point ID
+//   - a text label showing the point ID
+//
+// Batched representation: all targets share a fixed set of actors, so the
+// renderer cost does not grow with the actor count.
+//   - markers and arrows are glyphs instanced by two vtkGlyph3DMapper over one
+//     point set carrying per-point "colors", "scale" and "normals" arrays
+//   - frustums are one merged line polydata with an RGBA "colors" array
+//   - labels are one vtkLabeledDataMapper over a point set with a "labels"
+//     string array
+// Each target owns one slot (index) in those arrays.  Add appends a slot,
+// remove moves the last slot into the hole, and update / selection rewrite just
+// the slot's tuples – no actor is created or destroyed after construction.
+//
+// Mutators never render synchronously; they go through CadScene::render(),
+// so wrapping bulk edits in CadScene::UpdateBatch costs a single frame.
 //
 // Thread safety: all methods must be called from the Qt GUI thread.
 
 #pragma once
 
+#include <QHash>
 #include <QMap>
 #include <QObject>
 #include <QVector>
 #include <optional>
 #include <cstdint>
+#include <vector>
 
 // VTK forward declarations only – full headers in the .cpp
 #include <vtkSmartPointer.h>
 
 class vtkActor;
-class vtkCellPicker;
+class vtkActor2D;
+class vtkGenericCell;
+class vtkTransform;
+class vtkPolyData;
+class vtkUnsignedCharArray;
 
 // Pull in the HMI domain types (hmi_core exposes src/core/ as a PUBLIC
 // include directory, so the header is reachable as "Types.h").
@@ -34,8 +54,9 @@ class CadScene;
 /// \brief Handles interactive point annotation on a CadScene CAD model.
 ///
 /// PointAnnotator sits above CadScene in the ownership hierarchy.  It holds
-/// a non-owning pointer to the scene, creates VTK actors for every
-/// InspectionTarget, and handles surface picking via vtkCellPicker.
+/// a non-owning pointer to the scene, keeps the batched annotation geometry
+/// for every InspectionTarget, and handles surface picking by ray casting
+/// through the scene's static cell locator.
 class PointAnnotator : public QObject
 {
     Q_OBJECT
@@ -72,15 +93,35 @@ public:
     /// Remove the target with the given \a pointId and destroy its actors.
     void removeTarget(int32_t pointId);
 
-    /// Replace an existing target's data and rebuild its actors.
+    /// Replace an existing target's data and rebuild its actors; emits
+    /// targetUpdated() (or targetAdded() for an unknown pointId).
     void updateTarget(const hmi::InspectionTarget& target);
 
-    /// Remove all targets.
+    /// Bulk remove: one geometry update, one render and a single
+    /// targetsRemoved() with the IDs that were present.
+    void removeTargets(const QVector<int32_t>& pointIds);
+
+    /// Remove all targets; emits targetsCleared().
     void clearTargets();
 
+    /// Bulk add: every target is inserted (or updated when its pointId is
+    /// already present) with one geometry update, one render and a single
+    /// targetsAdded() signal – no per-target targetAdded().
+    void addTargets(const QVector<hmi::InspectionTarget>& targets);
+
+    /// Drop all targets and load \a targets in their place; emits
+    /// targetsReplaced() once.  Meant for loading a saved target list.
+    void replaceTargets(const QVector<hmi::InspectionTarget>& targets);
+
     /// Return a copy of all current targets.
     QVector<hmi::InspectionTarget> targets() const;
 
+    /// Number of targets (cheap; targets() copies).
+    int targetCount() const;
+
+    /// The target with \a pointId, without copying the others.
+    std::optional<hmi::InspectionTarget> target(int32_t pointId) const;
+
     // -----------------------------------------------------------------------
     // Selection
     // -----------------------------------------------------------------------
@@ -98,7 +139,8 @@ public:
     // Planned path visualisation
     // -----------------------------------------------------------------------
 
-    /// Display a green polyline connecting all waypoint positions.
+    /// Display a green polyline connecting all waypoint positions, with one
+    /// glyph-instanced dot per waypoint.
     void showPath(const hmi::InspectionPath& path);
 
     /// Remove the path polyline actors.
@@ -111,11 +153,22 @@ public:
     // Surface picking
     // -----------------------------------------------------------------------
 
-    /// Cast a ray from screen coordinates into the CAD model.
+    /// Cast a ray from display coordinates (VTK convention: device pixels,
+    /// origin bottom-left) into the CAD model.
     /// Returns the hit SurfacePoint, or std::nullopt if no model was hit.
     /// The face index stored in SurfacePoint::faceIndex is the VTK cell id.
+    /// Uses CadScene::modelLocator(), i.e. always the full-resolution mesh,
+    /// and calls CadScene::ensureFullResolution() so that mesh is also shown.
     std::optional<hmi::SurfacePoint> pickSurface(int screenX, int screenY);
 
+    /// Hover preview: same ray cast as pickSurface(), cheap enough to run on
+    /// every mouse move.  Shows a normal arrow at the hit and emits
+    /// surfaceHovered(); hides the arrow when nothing is hit.
+    std::optional<hmi::SurfacePoint> hoverSurface(int screenX, int screenY);
+
+    /// Hide the hover preview arrow.
+    void clearHover();
+
 signals:
     /// Emitted after a target has been added.
     void targetAdded(int32_t pointId);
@@ -123,25 +176,31 @@ signals:
     /// Emitted after a target has been removed.
     void targetRemoved(int32_t pointId);
 
+    /// Emitted once per addTargets() call with the IDs that were new.
+    void targetsAdded(QVector<int32_t> pointIds);
+
+    /// Emitted once per removeTargets() call with the IDs that were removed.
+    void targetsRemoved(QVector<int32_t> pointIds);
+
+    /// Emitted once per replaceTargets() call.
+    void targetsReplaced();
+
+    /// Emitted after updateTarget() changed an existing target.
+    void targetUpdated(int32_t pointId);
+
+    /// Emitted once per clearTargets() call.
+    void targetsCleared();
+
     /// Emitted when the selection changes.
     void targetSelected(int32_t pointId);
 
     /// Emitted when a surface point was successfully picked.
     void surfacePicked(hmi::SurfacePoint point);
 
-private:
-    // -----------------------------------------------------------------------
-    // Internal visual bundle
-    // -----------------------------------------------------------------------
-
-    struct AnnotationVisual {
-        hmi::InspectionTarget                   target;
-        vtkSmartPointer<vtkActor>               sphereActor;   ///< point marker
-        vtkSmartPointer<vtkActor>               arrowActor;    ///< normal direction
-        vtkSmartPointer<vtkActor>               frustumActor;  ///< camera frustum
-        vtkSmartPointer<vtkActor>               labelActor;    ///< billboard text
-    };
+    /// Emitted by hoverSurface() for every hit.
+    void surfaceHovered(hmi::SurfacePoint point);
 
+private:
     // -----------------------------------------------------------------------
     // Data members
     // -----------------------------------------------------------------------
@@ -150,29 +209,76 @@ private:
     bool                                  m_enabled  = false;
     hmi::CaptureConfig                    m_captureConfig;
     int32_t                               m_selectedId   = -1;
-    int32_t                               m_nextPointId  =  1;
-
-    QMap<int32_t, AnnotationVisual>       m_visuals;
-    QVector<vtkSmartPointer<vtkActor>>    m_pathActors;
 
-    vtkSmartPointer<vtkCellPicker>        m_picker;
+    QMap<int32_t, hmi::InspectionTarget>  m_targets;    ///< ordered by point ID
+    QVector<int32_t>                      m_slotIds;    ///< slot -> point ID
+    QHash<int32_t, int>                   m_slotOf;     ///< point ID -> slot
+
+    // Batched target geometry (one slot per target).
+    vtkSmartPointer<vtkPolyData>          m_markerData;   ///< positions + colors/scale/normals
+    vtkSmartPointer<vtkPolyData>          m_frustumData;  ///< 5 points + 8 lines per slot
+    vtkSmartPointer<vtkPolyData>          m_labelData;    ///< label anchors + "labels"
+    vtkSmartPointer<vtkActor>             m_markerActor;
+    vtkSmartPointer<vtkActor>             m_arrowActor;
+    vtkSmartPointer<vtkActor>             m_frustumActor;
+    vtkSmartPointer<vtkActor2D>           m_labelActor;
+    bool                                  m_actorsAttached = false;
+
+    // Path: polyline + glyph-instanced waypoint dots.
+    vtkSmartPointer<vtkActor>             m_pathLineActor;
+    vtkSmartPointer<vtkActor>             m_waypointActor;
+    vtkSmartPointer<vtkUnsignedCharArray> m_waypointColors;
+
+    // Hover preview: one arrow actor moved by its user transform.
+    vtkSmartPointer<vtkActor>             m_hoverActor;
+    vtkSmartPointer<vtkTransform>         m_hoverTransform;
+    vtkSmartPointer<vtkGenericCell>       m_pickCell;     ///< scratch for ray casts
+    std::vector<float>                    m_frustumScratch;   ///< SoA lanes of writeFrustums()
 
     // -----------------------------------------------------------------------
     // Private helpers
     // -----------------------------------------------------------------------
 
-    /// Build the full AnnotationVisual bundle for \a target.
-    AnnotationVisual createVisual(const hmi::InspectionTarget& target);
+    /// Build the shared mappers / actors for the batched target geometry.
+    void createBatchPipeline();
+
+    /// Add the batched actors to the scene renderer once it is available.
+    void attachActors();
+
+    /// Append a slot for \a target to every batched array.
+    void appendSlot(const hmi::InspectionTarget& target);
+
+    /// Rewrite the marker / label tuples of \a slot from \a target; the
+    /// frustum points are written by writeFrustums().
+    void writeSlot(int slot, const hmi::InspectionTarget& target);
+
+    /// Rewrite the frustum points of slots [first, first + count) from their
+    /// targets in one hmi::coord::frustumCornersBatch() pass.
+    void writeFrustums(int first, int count);
+
+    /// Rewrite the colour / scale tuples of \a slot.
+    void writeSlotAppearance(int slot, bool selected);
+
+    /// Insert or rewrite \a target without marking / rendering / signalling.
+    /// Returns true if a new slot was appended; its frustum is left to the
+    /// caller's writeFrustums() over the appended range.
+    bool storeTarget(const hmi::InspectionTarget& target);
+
+    /// Drop every slot without marking / rendering.
+    void resetSlots();
+
+    /// Remove \a slot by moving the last slot into its place.
+    void removeSlot(int slot);
 
-    /// Update actor colours / sizes to reflect whether \a visual is selected.
-    void updateVisualAppearance(AnnotationVisual& visual, bool selected);
+    /// Ray cast through the model locator; no signals, no side effects on
+    /// the scene.
+    std::optional<hmi::SurfacePoint> castRay(int screenX, int screenY);
 
-    /// Remove all actors belonging to \a visual from the renderer.
-    void removeVisualFromRenderer(AnnotationVisual& visual);
+    /// Mark all batched target geometry as modified.
+    void markTargetsModified();
 
-    /// Build the wireframe frustum actor for a surface point + view hint.
-    vtkSmartPointer<vtkActor> createFrustumActor(const hmi::SurfacePoint& surface,
-                                                  const hmi::ViewHint&    view);
+    /// Request a coalesced scene render (CadScene::render()).
+    void render();
 
     /// Build a polyline actor connecting all waypoint agv_pose positions.
     /// (Renders in the XY plane; Z set to a small offset above the ground.)
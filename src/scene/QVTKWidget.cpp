@@ -2,6 +2,8 @@
 
 #include "QVTKWidget.h"
 
+#include "FrameProfiler.h"
+
 #include <vtkGenericOpenGLRenderWindow.h>
 #include <vtkGenericRenderWindowInteractor.h>
 #include <vtkRendererCollection.h>
@@ -225,8 +227,12 @@ void QVTKWidget::paintGL()
         return;
     }
 
+    hmi::ProfileScope frame("QVTKWidget::paintGL", hmi::ProfileCategory::Paint);
     m_renderWindow->SetIsCurrent(true);
-    m_renderWindow->Render();
+    {
+        hmi::ProfileScope render("vtkRenderWindow::Render", hmi::ProfileCategory::Render);
+        m_renderWindow->Render();
+    }
     m_renderWindow->SetIsCurrent(false);
 }
 
@@ -235,6 +241,7 @@ void QVTKWidget::resizeGL(int w, int h)
     if (!m_renderWindow) {
         return;
     }
+    hmi::ProfileScope resize("QVTKWidget::resizeGL", hmi::ProfileCategory::Resize);
 
     const qreal dpr = devicePixelRatio();
     const int pw = static_cast<int>(w * dpr);
@@ -0,0 +1,223 @@
+// src/scene/RobotKinematics.cpp
+//
+// Description file (JSON), every key optional; defaults from defaultArm():
+//
+//   {
+//     "scene_units_per_meter": 1000,
+//     "scene_from_map": [16 numbers, row-major],
+//     "mount": { "x": 0.2, "y": 0, "z": 0.45, "yaw": 0 },
+//     "agv":   { "mesh": "agv.stl", "length": 1.2, "width": 0.8, "height": 0.45 },
+//     "dh":    [ { "a": 0, "d": 0.1807, "alpha": 1.5708, "theta_offset": 0 }, ... 6 ],
+//     "link_meshes": [ "base.stl", "shoulder.stl", ... 7 ]
+//   }
+
+#include "RobotKinematics.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cmath>
+
+namespace {
+
+/// Joint changes below this (rad) reuse the cached arm chain.
+constexpr double kJointEpsilon = 1e-6;
+
+TwinMatrix multiply(const TwinMatrix& a, const TwinMatrix& b)
+{
+    TwinMatrix out{};
+    for (int r = 0; r < 4; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            out[r * 4 + c] = a[r * 4 + 0] * b[0 * 4 + c]
+                           + a[r * 4 + 1] * b[1 * 4 + c]
+                           + a[r * 4 + 2] * b[2 * 4 + c]
+                           + a[r * 4 + 3] * b[3 * 4 + c];
+        }
+    }
+    return out;
+}
+
+/// Rz(yaw) then translation (x, y, z).
+TwinMatrix planar(double x, double y, double z, double yaw)
+{
+    const double c = std::cos(yaw), s = std::sin(yaw);
+    return { c, -s, 0, x,
+             s,  c, 0, y,
+             0,  0, 1, z,
+             0,  0, 0, 1 };
+}
+
+/// Rz(θ) · Tz(d) · Tx(a) · Rx(α).
+TwinMatrix denavitHartenberg(const RobotTwinDescription::DhJoint& j, double q)
+{
+    const double theta = q + j.thetaOffset;
+    const double ct = std::cos(theta),   st = std::sin(theta);
+    const double ca = std::cos(j.alpha), sa = std::sin(j.alpha);
+    return { ct, -st * ca,  st * sa, j.a * ct,
+             st,  ct * ca, -ct * sa, j.a * st,
+             0,   sa,       ca,      j.d,
+             0,   0,        0,       1 };
+}
+
+double number(const QJsonObject& o, const char* key, double fallback)
+{
+    const QJsonValue v = o.value(QLatin1String(key));
+    return v.isDouble() ? v.toDouble() : fallback;
+}
+
+QString resolved(const QDir& dir, const QString& path)
+{
+    return path.isEmpty() ? QString() : QDir::cleanPath(dir.absoluteFilePath(path));
+}
+
+} // anonymous namespace
+
+TwinMatrix twinIdentity()
+{
+    return { 1, 0, 0, 0,
+             0, 1, 0, 0,
+             0, 0, 1, 0,
+             0, 0, 0, 1 };
+}
+
+// ============================================================================
+// Description
+// ============================================================================
+
+RobotTwinDescription RobotTwinDescription::defaultArm()
+{
+    RobotTwinDescription d;
+    constexpr double kHalfPi = 1.57079632679489661923;
+    d.dh[0] = { 0.0,      0.1807,   kHalfPi, 0.0 };
+    d.dh[1] = { -0.6127,  0.0,      0.0,     0.0 };
+    d.dh[2] = { -0.57155, 0.0,      0.0,     0.0 };
+    d.dh[3] = { 0.0,      0.17415,  kHalfPi, 0.0 };
+    d.dh[4] = { 0.0,      0.11985, -kHalfPi, 0.0 };
+    d.dh[5] = { 0.0,      0.11655,  0.0,     0.0 };
+    d.mountX = 0.2;
+    d.mountZ = d.agvHeight;
+    return d;
+}
+
+bool RobotTwinDescription::fromJsonFile(const QString& path, RobotTwinDescription* out,
+                                        QString* error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = QStringLiteral("Cannot open %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!doc.isObject()) {
+        if (error) *error = QStringLiteral("Invalid robot description %1: %2")
+                                .arg(path, parseError.errorString());
+        return false;
+    }
+
+    const QJsonObject root = doc.object();
+    const QDir        dir  = QFileInfo(path).absoluteDir();
+    RobotTwinDescription d = defaultArm();
+
+    d.sceneUnitsPerMeter = number(root, "scene_units_per_meter", d.sceneUnitsPerMeter);
+
+    const QJsonArray sceneFromMap = root.value(QLatin1String("scene_from_map")).toArray();
+    if (!sceneFromMap.isEmpty()) {
+        if (sceneFromMap.size() != 16) {
+            if (error) *error = QStringLiteral("scene_from_map needs 16 values");
+            return false;
+        }
+        for (int i = 0; i < 16; ++i) {
+            d.sceneFromMap[std::size_t(i)] = sceneFromMap[i].toDouble();
+        }
+    }
+
+    const QJsonObject mount = root.value(QLatin1String("mount")).toObject();
+    d.mountX   = number(mount, "x",   d.mountX);
+    d.mountY   = number(mount, "y",   d.mountY);
+    d.mountZ   = number(mount, "z",   d.mountZ);
+    d.mountYaw = number(mount, "yaw", d.mountYaw);
+
+    const QJsonObject agv = root.value(QLatin1String("agv")).toObject();
+    d.agvMesh   = resolved(dir, agv.value(QLatin1String("mesh")).toString());
+    d.agvLength = number(agv, "length", d.agvLength);
+    d.agvWidth  = number(agv, "width",  d.agvWidth);
+    d.agvHeight = number(agv, "height", d.agvHeight);
+
+    const QJsonArray dh = root.value(QLatin1String("dh")).toArray();
+    if (!dh.isEmpty()) {
+        if (dh.size() != 6) {
+            if (error) *error = QStringLiteral("dh needs 6 joints, got %1").arg(dh.size());
+            return false;
+        }
+        for (int i = 0; i < 6; ++i) {
+            const QJsonObject j = dh[i].toObject();
+            auto& joint = d.dh[std::size_t(i)];
+            joint.a           = number(j, "a",            0.0);
+            joint.d           = number(j, "d",            0.0);
+            joint.alpha       = number(j, "alpha",        0.0);
+            joint.thetaOffset = number(j, "theta_offset", 0.0);
+        }
+    }
+
+    const QJsonArray links = root.value(QLatin1String("link_meshes")).toArray();
+    for (int i = 0; i < links.size() && i < 7; ++i) {
+        d.linkMeshes[std::size_t(i)] = resolved(dir, links[i].toString());
+    }
+
+    *out = d;
+    return true;
+}
+
+// ============================================================================
+// Forward kinematics
+// ============================================================================
+
+RobotKinematics::RobotKinematics(const RobotTwinDescription& description)
+    : m_desc(description)
+{
+    const double k = m_desc.sceneUnitsPerMeter;
+    const TwinMatrix scale = { k, 0, 0, 0,
+                               0, k, 0, 0,
+                               0, 0, k, 0,
+                               0, 0, 0, 1 };
+    m_sceneFromMapScaled = multiply(m_desc.sceneFromMap, scale);
+}
+
+void RobotKinematics::solveArm(const std::array<double, 6>& joints)
+{
+    TwinMatrix t = planar(m_desc.mountX, m_desc.mountY, m_desc.mountZ, m_desc.mountYaw);
+    m_armLocal[0] = t;
+    for (std::size_t i = 0; i < 6; ++i) {
+        t = multiply(t, denavitHartenberg(m_desc.dh[i], joints[i]));
+        m_armLocal[i + 1] = t;
+    }
+    m_armJoints = joints;
+    m_armValid  = true;
+}
+
+TwinFrame RobotKinematics::solve(double agvX, double agvY, double agvYaw,
+                                 const std::array<double, 6>& joints)
+{
+    bool same = m_armValid;
+    for (std::size_t i = 0; same && i < 6; ++i) {
+        same = std::abs(joints[i] - m_armJoints[i]) < kJointEpsilon;
+    }
+    if (same) {
+        ++m_cacheHits;
+    } else {
+        solveArm(joints);
+    }
+
+    TwinFrame frame;
+    frame.agv = multiply(m_sceneFromMapScaled, planar(agvX, agvY, 0.0, agvYaw));
+    for (std::size_t i = 0; i < m_armLocal.size(); ++i) {
+        frame.links[i] = multiply(frame.agv, m_armLocal[i]);
+    }
+    frame.sequence = ++m_sequence;
+    return frame;
+}
@@ -0,0 +1,100 @@
+// src/scene/RobotKinematics.h
+//
+// RobotKinematics – display-only forward kinematics for the AGV + 6-DOF arm
+// digital twin (RobotTwin).  No VTK: it runs on the SubscribeSystemState
+// reader thread and produces plain row-major 4×4 matrices that the GUI
+// thread copies into the actors' vtkMatrix4x4 user matrices.
+//
+// Chain, all in metres / radians:
+//   scene ← sceneFromMap · S(sceneUnitsPerMeter) · AGV(x, y, yaw)
+//         · mount · A1(q1) · … · A6(q6)
+// with A_i the standard Denavit–Hartenberg transform
+//   Rz(θ_i + offset_i) · Tz(d_i) · Tx(a_i) · Rx(α_i).
+//
+// The arm-local chain (mount · A1 … A6) is cached and only recomputed when a
+// joint value changes, so an idle arm on a driving AGV costs eight matrix
+// products per update.
+//
+// Thread safety: a RobotKinematics instance is used by one thread at a time.
+
+#pragma once
+
+#include <QString>
+
+#include <array>
+#include <cstdint>
+
+/// Row-major 4×4 matrix, the layout of vtkMatrix4x4::DeepCopy(const double*).
+using TwinMatrix = std::array<double, 16>;
+
+TwinMatrix twinIdentity();
+
+/// Geometry and kinematics of the twin.
+struct RobotTwinDescription {
+    struct DhJoint {
+        double a           = 0.0;   ///< link length (m)
+        double d           = 0.0;   ///< link offset (m)
+        double alpha       = 0.0;   ///< link twist (rad)
+        double thetaOffset = 0.0;   ///< added to the reported joint angle (rad)
+    };
+
+    std::array<DhJoint, 6> dh;
+
+    /// Arm base in the AGV frame.
+    double mountX = 0.0, mountY = 0.0, mountZ = 0.0, mountYaw = 0.0;
+
+    /// Map frame → scene (CAD model) frame, metres; identity by default.
+    TwinMatrix sceneFromMap = twinIdentity();
+    /// Scene units per metre (1000 for CAD models in millimetres).
+    double     sceneUnitsPerMeter = 1.0;
+
+    /// Meshes in metres, each in its own frame: the AGV body, [0] the arm
+    /// base (mount frame) and [i] link i (DH frame i).  Relative paths are
+    /// resolved against the description file.  Empty: a generated
+    /// placeholder (box for the AGV, tube along the link for the arm).
+    QString                agvMesh;
+    std::array<QString, 7> linkMeshes;
+
+    /// Placeholder AGV box (m).
+    double agvLength = 1.0, agvWidth = 0.7, agvHeight = 0.4;
+
+    /// UR10e-class DH parameters on a box AGV; a starting point until a
+    /// description file is provided.
+    static RobotTwinDescription defaultArm();
+
+    /// Read a JSON description (see docs in RobotKinematics.cpp).  Returns
+    /// false and sets \a error on failure.
+    static bool fromJsonFile(const QString& path, RobotTwinDescription* out, QString* error);
+};
+
+/// One solved twin state: the AGV body and the seven arm frames in scene
+/// coordinates.
+struct TwinFrame {
+    TwinMatrix                agv = twinIdentity();
+    std::array<TwinMatrix, 7> links{};   ///< [0] arm base, [i] link i
+    uint64_t                  sequence = 0;
+};
+
+class RobotKinematics
+{
+public:
+    explicit RobotKinematics(const RobotTwinDescription& description);
+
+    /// Solve for an AGV pose in the map frame and six joint angles.
+    TwinFrame solve(double agvX, double agvY, double agvYaw,
+                    const std::array<double, 6>& joints);
+
+    /// Number of solve() calls that reused the cached arm chain.
+    [[nodiscard]] uint64_t cacheHits() const noexcept { return m_cacheHits; }
+
+private:
+    void solveArm(const std::array<double, 6>& joints);
+
+    RobotTwinDescription      m_desc;
+    TwinMatrix                m_sceneFromMapScaled;
+    bool                      m_armValid = false;
+    std::array<double, 6>     m_armJoints{};
+    std::array<TwinMatrix, 7> m_armLocal{};   ///< in the AGV frame
+    uint64_t                  m_sequence  = 0;
+    uint64_t                  m_cacheHits = 0;
+};
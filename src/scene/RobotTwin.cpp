@@ -0,0 +1,276 @@
+// src/scene/RobotTwin.cpp
+
+#include "RobotTwin.h"
+#include "CadScene.h"
+
+#include "GatewayClient.h"
+
+#include <QFileInfo>
+
+#include <cmath>
+
+#include <vtkActor.h>
+#include <vtkCubeSource.h>
+#include <vtkLineSource.h>
+#include <vtkMatrix4x4.h>
+#include <vtkOBJReader.h>
+#include <vtkPLYReader.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkPolyDataNormals.h>
+#include <vtkProperty.h>
+#include <vtkRenderer.h>
+#include <vtkSTLReader.h>
+#include <vtkTubeFilter.h>
+
+namespace {
+
+constexpr double kLinkTubeRadiusM = 0.04;
+
+template <typename Reader>
+vtkSmartPointer<vtkPolyData> readWith(const QString& path)
+{
+    auto reader = vtkSmartPointer<Reader>::New();
+    reader->SetFileName(path.toLocal8Bit().constData());
+    reader->Update();
+    vtkPolyData* out = reader->GetOutput();
+    if (!out || out->GetNumberOfPoints() == 0) {
+        return nullptr;
+    }
+    auto normals = vtkSmartPointer<vtkPolyDataNormals>::New();
+    normals->SetInputData(out);
+    normals->SplittingOff();
+    normals->Update();
+    vtkSmartPointer<vtkPolyData> pd = normals->GetOutput();
+    return pd;
+}
+
+vtkSmartPointer<vtkPolyData> readMesh(const QString& path, QString* error)
+{
+    const QString ext = QFileInfo(path).suffix().toLower();
+    vtkSmartPointer<vtkPolyData> pd;
+    if (ext == QStringLiteral("stl")) {
+        pd = readWith<vtkSTLReader>(path);
+    } else if (ext == QStringLiteral("obj")) {
+        pd = readWith<vtkOBJReader>(path);
+    } else if (ext == QStringLiteral("ply")) {
+        pd = readWith<vtkPLYReader>(path);
+    } else {
+        if (error) *error = QStringLiteral("Unsupported file format: .%1").arg(ext);
+        return nullptr;
+    }
+    if (!pd && error) *error = QStringLiteral("Failed to read file: %1").arg(path);
+    return pd;
+}
+
+/// AGV placeholder: a box standing on the floor, origin at its centre.
+vtkSmartPointer<vtkPolyData> agvBox(const RobotTwinDescription& d)
+{
+    auto box = vtkSmartPointer<vtkCubeSource>::New();
+    box->SetXLength(d.agvLength);
+    box->SetYLength(d.agvWidth);
+    box->SetZLength(d.agvHeight);
+    box->SetCenter(0.0, 0.0, d.agvHeight / 2.0);
+    box->Update();
+    vtkSmartPointer<vtkPolyData> pd = box->GetOutput();
+    return pd;
+}
+
+/// Link placeholder: a tube from frame i back to the origin of frame i-1,
+/// which in frame i sits at (-a, -d sin α, -d cos α) whatever the angle.
+vtkSmartPointer<vtkPolyData> linkTube(const RobotTwinDescription::DhJoint& j)
+{
+    auto line = vtkSmartPointer<vtkLineSource>::New();
+    line->SetPoint1(0.0, 0.0, 0.0);
+    line->SetPoint2(-j.a, -j.d * std::sin(j.alpha), -j.d * std::cos(j.alpha));
+    auto tube = vtkSmartPointer<vtkTubeFilter>::New();
+    tube->SetInputConnection(line->GetOutputPort());
+    tube->SetRadius(kLinkTubeRadiusM);
+    tube->SetNumberOfSides(16);
+    tube->CappingOn();
+    tube->Update();
+    vtkSmartPointer<vtkPolyData> pd = tube->GetOutput();
+    return pd;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+RobotTwin::RobotTwin(CadScene* scene)
+    : QObject(scene)
+    , m_scene(scene)
+    , m_pipeline(std::make_shared<Pipeline>())
+{
+}
+
+RobotTwin::~RobotTwin()
+{
+    attach(nullptr);
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+vtkSmartPointer<vtkActor> RobotTwin::makeActor(vtkSmartPointer<vtkMatrix4x4>& matrix)
+{
+    matrix = vtkSmartPointer<vtkMatrix4x4>::New();
+    auto actor = vtkSmartPointer<vtkActor>::New();
+    actor->SetUserMatrix(matrix);
+    actor->PickableOff();
+    actor->UseBoundsOff();
+    actor->SetVisibility(m_visible);
+    return actor;
+}
+
+bool RobotTwin::load(const RobotTwinDescription& description, QString* error)
+{
+    vtkRenderer* renderer = m_scene->renderer();
+    if (!renderer) {
+        if (error) *error = QStringLiteral("Cannot load robot twin: no renderer set.");
+        return false;
+    }
+
+    // Read everything before touching the scene, so a bad file keeps the
+    // current twin.
+    vtkSmartPointer<vtkPolyData> agvMesh = description.agvMesh.isEmpty()
+        ? agvBox(description) : readMesh(description.agvMesh, error);
+    if (!agvMesh) return false;
+
+    std::array<vtkSmartPointer<vtkPolyData>, 7> linkMeshes;
+    for (std::size_t i = 0; i < linkMeshes.size(); ++i) {
+        const QString& path = description.linkMeshes[i];
+        if (!path.isEmpty()) {
+            linkMeshes[i] = readMesh(path, error);
+            if (!linkMeshes[i]) return false;
+        } else if (i > 0) {
+            linkMeshes[i] = linkTube(description.dh[i - 1]);
+        }
+        // No mesh and no placeholder for the arm base (i == 0).
+    }
+
+    unload();
+
+    auto addBody = [&](vtkActor* actor, vtkPolyData* pd, double r, double g, double b) {
+        auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        mapper->SetInputData(pd);
+        mapper->StaticOn();   // geometry never changes; only the matrix does
+        actor->SetMapper(mapper);
+        actor->GetProperty()->SetColor(r, g, b);
+        actor->GetProperty()->SetOpacity(0.9);
+        renderer->AddActor(actor);
+    };
+
+    m_agvActor = makeActor(m_agvMatrix);
+    addBody(m_agvActor, agvMesh, 0.95, 0.45, 0.15);
+    for (std::size_t i = 0; i < m_linkActors.size(); ++i) {
+        if (!linkMeshes[i]) continue;
+        m_linkActors[i] = makeActor(m_linkMatrices[i]);
+        addBody(m_linkActors[i], linkMeshes[i], 0.75, 0.78, 0.82);
+    }
+
+    m_pipeline->reset(&description);
+
+    // Rest pose until the first state arrives.
+    submit(0.0, 0.0, 0.0, true, {}, true);
+    applyLatest();
+    return true;
+}
+
+void RobotTwin::unload()
+{
+    m_pipeline->reset(nullptr);
+
+    vtkRenderer* renderer = m_scene->renderer();
+    if (renderer && m_agvActor) renderer->RemoveActor(m_agvActor);
+    m_agvActor  = nullptr;
+    m_agvMatrix = nullptr;
+    for (std::size_t i = 0; i < m_linkActors.size(); ++i) {
+        if (renderer && m_linkActors[i]) renderer->RemoveActor(m_linkActors[i]);
+        m_linkActors[i]   = nullptr;
+        m_linkMatrices[i] = nullptr;
+    }
+    m_scene->render();
+}
+
+void RobotTwin::setVisible(bool visible)
+{
+    if (visible == m_visible) return;
+    m_visible = visible;
+    if (m_agvActor) m_agvActor->SetVisibility(visible);
+    for (auto& actor : m_linkActors) {
+        if (actor) actor->SetVisibility(visible);
+    }
+    m_scene->render();
+}
+
+// ============================================================================
+// State updates
+// ============================================================================
+
+void RobotTwin::attach(hmi::GatewayClient* client)
+{
+    if (m_client) {
+        m_client->setRobotStateObserver({});
+        disconnect(m_stateConnection);
+    }
+    m_client = client;
+    if (!client) return;
+
+    // Runs on the stream thread; holds the pipeline, not the twin.
+    client->setRobotStateObserver(
+        [pipeline = m_pipeline](const hmi::GatewayClient::RobotStateSample& s) {
+            pipeline->submit(s.agvX, s.agvY, s.agvYaw, s.hasAgv, s.joints, s.hasArm);
+        });
+    m_stateConnection = connect(client, &hmi::GatewayClient::systemStateReceived,
+                                this, [this]() { applyLatest(); });
+}
+
+void RobotTwin::submit(double agvX, double agvY, double agvYaw, bool hasAgv,
+                       const std::array<double, 6>& joints, bool hasArm)
+{
+    m_pipeline->submit(agvX, agvY, agvYaw, hasAgv, joints, hasArm);
+}
+
+void RobotTwin::Pipeline::submit(double x, double y, double yaw, bool hasAgv,
+                                 const std::array<double, 6>& q, bool hasArm)
+{
+    TwinFrame frame;
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (!kinematics) return;
+        if (hasAgv) {
+            agvX   = x;
+            agvY   = y;
+            agvYaw = yaw;
+        }
+        if (hasArm) joints = q;
+        frame = kinematics->solve(agvX, agvY, agvYaw, joints);
+    }
+    frames.publish(std::move(frame));
+}
+
+void RobotTwin::Pipeline::reset(const RobotTwinDescription* description)
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        kinematics = description ? std::make_unique<RobotKinematics>(*description) : nullptr;
+    }
+    frames.clear();
+}
+
+void RobotTwin::applyLatest()
+{
+    std::optional<TwinFrame> frame = m_pipeline->frames.take();
+    if (!frame || !m_agvActor) return;
+
+    // DeepCopy marks the matrix modified; the actor picks it up at render.
+    m_agvMatrix->DeepCopy(frame->agv.data());
+    for (std::size_t i = 0; i < m_linkActors.size(); ++i) {
+        if (m_linkMatrices[i]) m_linkMatrices[i]->DeepCopy(frame->links[i].data());
+    }
+    if (m_visible) m_scene->render();
+}
@@ -0,0 +1,108 @@
+// src/scene/RobotTwin.h
+//
+// RobotTwin – the digital-twin layer of CadScene: the AGV body and the
+// 6-DOF arm drawn in the 3D scene at the pose the gateway reports
+// (AgvStatus.current_pose, ArmStatus.current_joints).  Display only.
+//
+// load() reads (or generates) the meshes once and creates one actor per
+// body, each with a persistent vtkMatrix4x4 user matrix.  attach() hooks the
+// GatewayClient robot-state observer: forward kinematics (RobotKinematics)
+// runs on the stream reader thread for every message and the solved
+// TwinFrame goes into a latest-wins LatestValueMailbox.  The GUI thread
+// takes it whenever the system-state mailbox delivers (systemStateReceived),
+// so the twin follows the same coalesced cadence as the rest of the UI and
+// all it does per update is copy eight matrices and request a render – no
+// geometry is ever rebuilt.
+//
+// Twin actors are not pickable and do not take part in CadScene's camera
+// fit (UseBounds off).
+//
+// Thread safety: GUI thread, except submit() (any thread).
+
+#pragma once
+
+#include "RobotKinematics.h"
+
+#include "LatestValueMailbox.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <array>
+#include <memory>
+#include <mutex>
+
+#include <vtkSmartPointer.h>
+
+class CadScene;
+class vtkActor;
+class vtkMatrix4x4;
+
+namespace hmi { class GatewayClient; }
+
+class RobotTwin : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RobotTwin(CadScene* scene);
+    ~RobotTwin() override;
+
+    /// Build the actors for \a description (replacing any previous twin)
+    /// and add them to the scene's renderer.  Returns false and sets \a error
+    /// when there is no renderer or a mesh cannot be read.
+    bool load(const RobotTwinDescription& description, QString* error = nullptr);
+
+    /// Remove the twin from the scene.
+    void unload();
+
+    [[nodiscard]] bool isLoaded() const { return m_agvActor != nullptr; }
+
+    void setVisible(bool visible);
+    [[nodiscard]] bool isVisible() const { return m_visible; }
+
+    /// Follow \a client (null to stop).  The twin stays where it is until
+    /// the first state arrives.
+    void attach(hmi::GatewayClient* client);
+
+    /// Solve and publish one state (any thread; the stream thread when
+    /// attached).  Missing AGV or arm fields keep their last value.
+    void submit(double agvX, double agvY, double agvYaw, bool hasAgv,
+                const std::array<double, 6>& joints, bool hasArm);
+
+    /// Apply the newest solved state, if any (GUI thread).
+    void applyLatest();
+
+    /// Published / applied / superseded frame counters.
+    [[nodiscard]] hmi::MailboxStats frameStats() const { return m_pipeline->frames.stats(); }
+
+private:
+    /// Solver, last sample and frame mailbox.  Shared with the stream-thread
+    /// observer, so a message in flight never outlives its target.
+    struct Pipeline {
+        std::mutex                         mutex;
+        std::unique_ptr<RobotKinematics>   kinematics;   ///< null = not loaded
+        double                             agvX = 0.0, agvY = 0.0, agvYaw = 0.0;
+        std::array<double, 6>              joints{};
+        hmi::LatestValueMailbox<TwinFrame> frames;
+
+        void submit(double x, double y, double yaw, bool hasAgv,
+                    const std::array<double, 6>& q, bool hasArm);
+        void reset(const RobotTwinDescription* description);
+    };
+
+    vtkSmartPointer<vtkActor> makeActor(vtkSmartPointer<vtkMatrix4x4>& matrix);
+
+    CadScene*                                 m_scene = nullptr;
+    QPointer<hmi::GatewayClient>              m_client;
+    QMetaObject::Connection                   m_stateConnection;
+
+    vtkSmartPointer<vtkActor>                 m_agvActor;
+    vtkSmartPointer<vtkMatrix4x4>             m_agvMatrix;
+    std::array<vtkSmartPointer<vtkActor>, 7>     m_linkActors;
+    std::array<vtkSmartPointer<vtkMatrix4x4>, 7> m_linkMatrices;
+    bool                                      m_visible = true;
+
+    const std::shared_ptr<Pipeline>           m_pipeline;
+};
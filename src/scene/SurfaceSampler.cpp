@@ -0,0 +1,592 @@
+// src/scene/SurfaceSampler.cpp
+
+#include "SurfaceSampler.h"
+#include "ParallelTasks.h"
+
+#include <QMetaObject>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <random>
+
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkIdList.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+// ============================================================================
+// Sampling kernels
+// ============================================================================
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+/// Polygons per extraction task / triangles per candidate task.  Fixed so
+/// that per-task RNG seeds do not depend on the thread count.
+constexpr std::size_t kCellChunk     = 16384;
+constexpr std::size_t kTriangleChunk = 4096;
+constexpr std::size_t kGridChunk     = 256;     ///< grid cells per task
+
+/// Candidates per expected output sample.
+constexpr double kCandidatesPerSample = 10.0;
+constexpr std::size_t kMaxCandidates  = std::size_t(8) << 20;
+
+/// Grid coordinates are packed 21 bits per axis.
+constexpr int64_t kGridAxisMax = (int64_t(1) << 21) - 2;
+
+struct Vec3 {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+inline Vec3 sub(const Vec3& a, const Vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+inline float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3 cross(const Vec3& a, const Vec3& b)
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+inline bool normalise(Vec3& v)
+{
+    const float len = std::sqrt(dot(v, v));
+    if (!(len > 0.0f)) return false;
+    v.x /= len; v.y /= len; v.z /= len;
+    return true;
+}
+
+struct Triangle {
+    Vec3      a, b, c;
+    Vec3      normal;        ///< unit face normal
+    vtkIdType pa, pb, pc;    ///< point ids, for normal interpolation
+    vtkIdType cellId;        ///< VTK cell id of the source polygon
+    float     area;
+};
+
+struct Candidate {
+    Vec3      position;
+    Vec3      normal;
+    vtkIdType cellId;
+    uint64_t  gridKey;
+    uint32_t  rank;          ///< random acceptance order within a grid cell
+};
+
+struct GridCell {
+    uint64_t key;
+    uint32_t begin, end;     ///< candidate range (sorted by key, rank)
+};
+
+inline uint64_t packKey(int64_t ix, int64_t iy, int64_t iz)
+{
+    return (static_cast<uint64_t>(ix) << 42) | (static_cast<uint64_t>(iy) << 21)
+         | static_cast<uint64_t>(iz);
+}
+
+inline int phaseOf(uint64_t key)
+{
+    const uint64_t mask = (uint64_t(1) << 21) - 1;
+    const int ix = static_cast<int>((key >> 42) % 3);
+    const int iy = static_cast<int>(((key >> 21) & mask) % 3);
+    const int iz = static_cast<int>((key & mask) % 3);
+    return ix + 3 * iy + 9 * iz;
+}
+
+/// Fan-triangulate polygons [begin, end) of \a polys.  \a polyNormals gets one
+/// unit normal per polygon (zero for degenerate ones).
+void extractTriangles(vtkPolyData* model, vtkIdType polyBase,
+                      vtkIdType begin, vtkIdType end,
+                      std::vector<Triangle>& out, std::vector<Vec3>& polyNormals)
+{
+    vtkPoints*    points      = model->GetPoints();
+    vtkDataArray* cellNormals = model->GetCellData()->GetNormals();
+
+    vtkSmartPointer<vtkCellArrayIterator> it =
+        vtk::TakeSmartPointer(model->GetPolys()->NewIterator());
+
+    double    p[3];
+    vtkIdType npts = 0;
+    const vtkIdType* pts = nullptr;
+    std::vector<Vec3> verts;
+
+    for (vtkIdType poly = begin; poly < end; ++poly) {
+        it->GetCellAtId(poly, npts, pts);
+        const vtkIdType cellId = polyBase + poly;
+        if (npts < 3) continue;
+
+        verts.resize(static_cast<std::size_t>(npts));
+        for (vtkIdType k = 0; k < npts; ++k) {
+            points->GetPoint(pts[k], p);
+            verts[k] = { static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2]) };
+        }
+
+        // Face normal: the mesh's own cell normals if present (consistently
+        // oriented by CadScene::ensureNormals), otherwise Newell's method.
+        Vec3 n;
+        if (cellNormals) {
+            double t[3];
+            cellNormals->GetTuple(cellId, t);
+            n = { static_cast<float>(t[0]), static_cast<float>(t[1]), static_cast<float>(t[2]) };
+        } else {
+            for (vtkIdType k = 0; k < npts; ++k) {
+                const Vec3& u = verts[k];
+                const Vec3& v = verts[(k + 1) % npts];
+                n.x += (u.y - v.y) * (u.z + v.z);
+                n.y += (u.z - v.z) * (u.x + v.x);
+                n.z += (u.x - v.x) * (u.y + v.y);
+            }
+        }
+        if (!normalise(n)) continue;
+        polyNormals[static_cast<std::size_t>(poly)] = n;
+
+        for (vtkIdType k = 1; k + 1 < npts; ++k) {
+            Triangle tri;
+            tri.a = verts[0];
+            tri.b = verts[k];
+            tri.c = verts[k + 1];
+            const Vec3 c = cross(sub(tri.b, tri.a), sub(tri.c, tri.a));
+            tri.area = 0.5f * std::sqrt(dot(c, c));
+            if (!(tri.area > 0.0f)) continue;
+            tri.normal = n;
+            tri.pa = pts[0];
+            tri.pb = pts[k];
+            tri.pc = pts[k + 1];
+            tri.cellId = cellId;
+            out.push_back(tri);
+        }
+    }
+}
+
+/// Face region around \a seedPoly: breadth-first over shared edges while the
+/// dihedral angle between neighbouring polygons stays within \a cosLimit.
+std::vector<char> growRegion(vtkPolyData* model, vtkIdType polyBase, vtkIdType seedPoly,
+                             const std::vector<Vec3>& polyNormals, float cosLimit)
+{
+    const std::size_t polyCount = polyNormals.size();
+    std::vector<char> inRegion(polyCount, 0);
+
+    // Links live on a shallow copy, so the shared model (rendered and picked
+    // on the GUI thread) is never mutated.
+    auto local = vtkSmartPointer<vtkPolyData>::New();
+    local->ShallowCopy(model);
+    local->BuildLinks();
+
+    auto neighbours = vtkSmartPointer<vtkIdList>::New();
+    std::deque<vtkIdType> queue;
+    inRegion[static_cast<std::size_t>(seedPoly)] = 1;
+    queue.push_back(seedPoly);
+
+    vtkIdType npts = 0;
+    const vtkIdType* pts = nullptr;
+    while (!queue.empty()) {
+        const vtkIdType poly = queue.front();
+        queue.pop_front();
+        const Vec3& n = polyNormals[static_cast<std::size_t>(poly)];
+
+        local->GetCellPoints(polyBase + poly, npts, pts);
+        for (vtkIdType k = 0; k < npts; ++k) {
+            local->GetCellEdgeNeighbors(polyBase + poly, pts[k], pts[(k + 1) % npts], neighbours);
+            for (vtkIdType j = 0; j < neighbours->GetNumberOfIds(); ++j) {
+                const vtkIdType other = neighbours->GetId(j) - polyBase;
+                if (other < 0 || static_cast<std::size_t>(other) >= polyCount) continue;
+                char& flag = inRegion[static_cast<std::size_t>(other)];
+                if (flag) continue;
+                if (dot(n, polyNormals[static_cast<std::size_t>(other)]) < cosLimit) continue;
+                flag = 1;
+                queue.push_back(other);
+            }
+        }
+    }
+    return inRegion;
+}
+
+} // namespace
+
+// ============================================================================
+// Synchronous sampling
+// ============================================================================
+
+QVector<hmi::InspectionTarget> SurfaceSampler::sample(vtkPolyData*             model,
+                                                      const Params&            params,
+                                                      const ProgressFn&        progress,
+                                                      const std::atomic<bool>* cancelled,
+                                                      QString*                 error)
+{
+    auto fail = [error](const QString& message) {
+        if (error) *error = message;
+        return QVector<hmi::InspectionTarget>();
+    };
+    auto report = [&progress](double fraction) {
+        if (progress) progress(fraction);
+    };
+
+    if (!model || !model->GetPoints() || !model->GetPolys()
+        || model->GetPolys()->GetNumberOfCells() == 0) {
+        return fail(QStringLiteral("No surface to sample."));
+    }
+    if (!(params.spacingM > 0.0)) {
+        return fail(QStringLiteral("Sample spacing must be positive."));
+    }
+
+    const int threads = workerThreads(params.threads);
+
+    // Polygons follow verts and lines in VTK's cell numbering.
+    const vtkIdType polyBase  = model->GetNumberOfVerts() + model->GetNumberOfLines();
+    const vtkIdType polyCount = model->GetPolys()->GetNumberOfCells();
+
+    // ------------------------------------------------------------------
+    // 1. Triangles + polygon normals
+    // ------------------------------------------------------------------
+    std::vector<Vec3> polyNormals(static_cast<std::size_t>(polyCount));
+    const std::size_t cellTasks = (static_cast<std::size_t>(polyCount) + kCellChunk - 1) / kCellChunk;
+    std::vector<std::vector<Triangle>> trianglesPerTask(cellTasks);
+    parallelTasks(cellTasks, threads, [&](std::size_t task) {
+        if (isCancelled(cancelled)) return;
+        const vtkIdType begin = static_cast<vtkIdType>(task * kCellChunk);
+        const vtkIdType end   = std::min(polyCount, begin + static_cast<vtkIdType>(kCellChunk));
+        trianglesPerTask[task].reserve(static_cast<std::size_t>(end - begin) * 2);
+        extractTriangles(model, polyBase, begin, end, trianglesPerTask[task], polyNormals);
+    });
+    if (isCancelled(cancelled)) return {};
+    report(0.2);
+
+    // ------------------------------------------------------------------
+    // 2. Region / normal filters
+    // ------------------------------------------------------------------
+    std::vector<char> inRegion;
+    if (params.regionSeedCell >= 0) {
+        const vtkIdType seedPoly = params.regionSeedCell - polyBase;
+        if (seedPoly < 0 || seedPoly >= polyCount) {
+            return fail(QStringLiteral("Region seed %1 is not a surface cell.").arg(params.regionSeedCell));
+        }
+        const float cosLimit = static_cast<float>(std::cos(params.regionMaxDihedralDeg * kPi / 180.0));
+        inRegion = growRegion(model, polyBase, seedPoly, polyNormals, cosLimit);
+    }
+    if (isCancelled(cancelled)) return {};
+
+    Vec3 axis{ params.direction.x(), params.direction.y(), params.direction.z() };
+    const bool  filterByNormal = normalise(axis);
+    const float cosCone = static_cast<float>(std::cos(params.maxAngleDeg * kPi / 180.0));
+
+    std::vector<Triangle> triangles;
+    double totalArea = 0.0;
+    for (auto& chunk : trianglesPerTask) {
+        for (const Triangle& tri : chunk) {
+            if (!inRegion.empty() && !inRegion[static_cast<std::size_t>(tri.cellId - polyBase)]) continue;
+            if (filterByNormal && dot(tri.normal, axis) < cosCone) continue;
+            totalArea += tri.area;
+            triangles.push_back(tri);
+        }
+        std::vector<Triangle>().swap(chunk);
+    }
+    if (triangles.empty()) {
+        return fail(QStringLiteral("No surface matches the region / normal filter."));
+    }
+    report(0.3);
+
+    // ------------------------------------------------------------------
+    // 3. Dart candidates
+    // ------------------------------------------------------------------
+    // Maximal Poisson-disk sets reach roughly 70 % of hexagonal packing
+    // density, where each sample covers sqrt(3)/2 * r^2.
+    const double r = params.spacingM;
+    const double expected = 0.7 * totalArea / (0.8660254037844386 * r * r);
+    if (expected > static_cast<double>(params.maxPoints)) {
+        return fail(QStringLiteral("About %1 points at %2 m spacing exceeds the limit of %3.")
+                        .arg(static_cast<qint64>(expected))
+                        .arg(r)
+                        .arg(params.maxPoints));
+    }
+    const double candidateCount = std::min(static_cast<double>(kMaxCandidates),
+                                           std::max(1.0, expected) * kCandidatesPerSample);
+    const double density = candidateCount / totalArea;
+
+    vtkDataArray* pointNormals = model->GetPointData()->GetNormals();
+
+    const std::size_t triTasks = (triangles.size() + kTriangleChunk - 1) / kTriangleChunk;
+    std::vector<std::vector<Candidate>> candidatesPerTask(triTasks);
+    parallelTasks(triTasks, threads, [&](std::size_t task) {
+        if (isCancelled(cancelled)) return;
+        std::seed_seq seq{ params.seed, static_cast<quint32>(task), static_cast<quint32>(task >> 32) };
+        std::mt19937 rng(seq);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        auto& out = candidatesPerTask[task];
+        const std::size_t begin = task * kTriangleChunk;
+        const std::size_t end   = std::min(triangles.size(), begin + kTriangleChunk);
+        double na[3], nb[3], nc[3];
+        for (std::size_t t = begin; t < end; ++t) {
+            const Triangle& tri = triangles[t];
+            const double want  = tri.area * density;
+            int count = static_cast<int>(want);
+            if (unit(rng) < static_cast<float>(want - count)) ++count;
+            if (count == 0) continue;
+
+            if (pointNormals) {
+                pointNormals->GetTuple(tri.pa, na);
+                pointNormals->GetTuple(tri.pb, nb);
+                pointNormals->GetTuple(tri.pc, nc);
+            }
+            const Vec3 ab = sub(tri.b, tri.a);
+            const Vec3 ac = sub(tri.c, tri.a);
+            for (int i = 0; i < count; ++i) {
+                float u = unit(rng);
+                float v = unit(rng);
+                if (u + v > 1.0f) { u = 1.0f - u; v = 1.0f - v; }
+                const float w = 1.0f - u - v;
+
+                Candidate c;
+                c.position = { tri.a.x + u * ab.x + v * ac.x,
+                               tri.a.y + u * ab.y + v * ac.y,
+                               tri.a.z + u * ab.z + v * ac.z };
+                c.normal = tri.normal;
+                if (pointNormals) {
+                    Vec3 n{ static_cast<float>(w * na[0] + u * nb[0] + v * nc[0]),
+                            static_cast<float>(w * na[1] + u * nb[1] + v * nc[1]),
+                            static_cast<float>(w * na[2] + u * nb[2] + v * nc[2]) };
+                    // Smoothed normals across creases can tilt far from the
+                    // face; keep the face normal when they disagree.
+                    if (normalise(n) && dot(n, tri.normal) > 0.0f) c.normal = n;
+                }
+                c.cellId  = tri.cellId;
+                c.gridKey = 0;
+                c.rank    = static_cast<uint32_t>(rng());
+                out.push_back(c);
+            }
+        }
+    });
+    if (isCancelled(cancelled)) return {};
+
+    std::vector<Candidate> candidates;
+    {
+        std::size_t total = 0;
+        for (const auto& chunk : candidatesPerTask) total += chunk.size();
+        candidates.reserve(total);
+        for (auto& chunk : candidatesPerTask) {
+            candidates.insert(candidates.end(), chunk.begin(), chunk.end());
+            std::vector<Candidate>().swap(chunk);
+        }
+    }
+    if (candidates.empty()) {
+        return fail(QStringLiteral("Sampled surface area is too small for the spacing."));
+    }
+    report(0.45);
+
+    // ------------------------------------------------------------------
+    // 4. Grid binning (cell size = r, so conflicts are within ±1 cell)
+    // ------------------------------------------------------------------
+    Vec3 lo = candidates.front().position;
+    for (const Candidate& c : candidates) {
+        lo.x = std::min(lo.x, c.position.x);
+        lo.y = std::min(lo.y, c.position.y);
+        lo.z = std::min(lo.z, c.position.z);
+    }
+    auto gridCoord = [&](float v, float origin) {
+        return static_cast<int64_t>(std::floor((v - origin) / r)) + 1;   // ≥ 1: room for -1
+    };
+    for (Candidate& c : candidates) {
+        const int64_t ix = gridCoord(c.position.x, lo.x);
+        const int64_t iy = gridCoord(c.position.y, lo.y);
+        const int64_t iz = gridCoord(c.position.z, lo.z);
+        if (ix > kGridAxisMax || iy > kGridAxisMax || iz > kGridAxisMax) {
+            return fail(QStringLiteral("Model extent is too large for %1 m spacing.").arg(r));
+        }
+        c.gridKey = packKey(ix, iy, iz);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.gridKey != b.gridKey ? a.gridKey < b.gridKey : a.rank < b.rank;
+    });
+
+    std::vector<GridCell> cells;
+    for (uint32_t i = 0; i < candidates.size();) {
+        uint32_t j = i + 1;
+        while (j < candidates.size() && candidates[j].gridKey == candidates[i].gridKey) ++j;
+        cells.push_back(GridCell{ candidates[i].gridKey, i, j });
+        i = j;
+    }
+
+    std::vector<std::vector<uint32_t>> phaseCells(27);
+    for (uint32_t ci = 0; ci < cells.size(); ++ci) {
+        phaseCells[static_cast<std::size_t>(phaseOf(cells[ci].key))].push_back(ci);
+    }
+    report(0.55);
+
+    // ------------------------------------------------------------------
+    // 5. Phased elimination
+    // ------------------------------------------------------------------
+    const float r2 = static_cast<float>(r * r);
+    std::vector<std::vector<uint32_t>> accepted(cells.size());   // candidate indices
+
+    auto findCell = [&cells](uint64_t key) -> int64_t {
+        auto it = std::lower_bound(cells.begin(), cells.end(), key,
+                                   [](const GridCell& c, uint64_t k) { return c.key < k; });
+        return (it != cells.end() && it->key == key) ? (it - cells.begin()) : -1;
+    };
+
+    const uint64_t mask = (uint64_t(1) << 21) - 1;
+    for (int phase = 0; phase < 27; ++phase) {
+        const auto& list = phaseCells[static_cast<std::size_t>(phase)];
+        const std::size_t tasks = (list.size() + kGridChunk - 1) / kGridChunk;
+        parallelTasks(tasks, threads, [&](std::size_t task) {
+            if (isCancelled(cancelled)) return;
+            int64_t neighbours[27];
+            const std::size_t end = std::min(list.size(), (task + 1) * kGridChunk);
+            for (std::size_t li = task * kGridChunk; li < end; ++li) {
+                const uint32_t  ci   = list[li];
+                const GridCell& cell = cells[ci];
+                const int64_t ix = static_cast<int64_t>(cell.key >> 42);
+                const int64_t iy = static_cast<int64_t>((cell.key >> 21) & mask);
+                const int64_t iz = static_cast<int64_t>(cell.key & mask);
+
+                int n = 0;
+                for (int dz = -1; dz <= 1; ++dz)
+                    for (int dy = -1; dy <= 1; ++dy)
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            const int64_t nc = findCell(packKey(ix + dx, iy + dy, iz + dz));
+                            if (nc >= 0) neighbours[n++] = nc;
+                        }
+
+                // Only this cell is written in this phase; every other
+                // neighbour has a different phase and is read-only here.
+                auto& mine = accepted[ci];
+                for (uint32_t k = cell.begin; k < cell.end; ++k) {
+                    const Candidate& c = candidates[k];
+                    bool ok = true;
+                    for (int j = 0; j < n && ok; ++j) {
+                        for (uint32_t q : accepted[static_cast<std::size_t>(neighbours[j])]) {
+                            const Candidate& other = candidates[q];
+                            const Vec3 d = sub(c.position, other.position);
+                            // Opposite sides of a thin wall do not compete.
+                            if (dot(d, d) < r2 && dot(c.normal, other.normal) > 0.0f) {
+                                ok = false;
+                                break;
+                            }
+                        }
+                    }
+                    if (ok) mine.push_back(k);
+                }
+            }
+        });
+        if (isCancelled(cancelled)) return {};
+        report(0.55 + 0.45 * (phase + 1) / 27.0);
+    }
+
+    // ------------------------------------------------------------------
+    // 6. Targets, in grid order (spatially coherent, deterministic)
+    // ------------------------------------------------------------------
+    std::size_t acceptedCount = 0;
+    for (const auto& list : accepted) acceptedCount += list.size();
+    if (acceptedCount > static_cast<std::size_t>(params.maxPoints)) {
+        return fail(QStringLiteral("%1 points at %2 m spacing exceeds the limit of %3.")
+                        .arg(static_cast<qint64>(acceptedCount))
+                        .arg(r)
+                        .arg(params.maxPoints));
+    }
+
+    QVector<hmi::InspectionTarget> targets;
+    targets.reserve(static_cast<int>(acceptedCount));
+    int32_t nextId = params.firstPointId;
+    for (const auto& list : accepted) {
+        for (uint32_t k : list) {
+            const Candidate& c = candidates[k];
+            hmi::InspectionTarget target;
+            target.pointId           = nextId++;
+            target.groupId           = params.groupId;
+            target.surface.position  = QVector3D(c.position.x, c.position.y, c.position.z);
+            target.surface.normal    = QVector3D(c.normal.x, c.normal.y, c.normal.z);
+            target.surface.frameId   = QStringLiteral("cad");
+            target.surface.faceIndex = static_cast<uint32_t>(c.cellId);
+            target.view.viewDirection = -target.surface.normal;   // camera looks at surface
+            targets.append(target);
+        }
+    }
+    report(1.0);
+    return targets;
+}
+
+// ============================================================================
+// Asynchronous front end
+// ============================================================================
+
+SurfaceSampler::SurfaceSampler(QObject* parent)
+    : QObject(parent)
+{
+}
+
+SurfaceSampler::~SurfaceSampler()
+{
+    if (m_job) m_job->cancelled = true;
+    for (auto& w : m_workers) {
+        w.job->cancelled = true;
+        if (w.thread.joinable()) w.thread.join();
+    }
+}
+
+void SurfaceSampler::start(vtkPolyData* model, const Params& params)
+{
+    cancel();
+    reapWorkers();
+
+    auto job = std::make_shared<Job>();
+    m_job = job;
+
+    // Own data object (sharing the arrays): cell links built on the scene
+    // model for picking never race the sampler.
+    vtkSmartPointer<vtkPolyData> input;
+    if (model) {
+        input = vtkSmartPointer<vtkPolyData>::New();
+        input->ShallowCopy(model);
+    }
+    std::thread worker([this, job, input, params]() {
+        const ProgressFn progressFn = [this, job](double fraction) {
+            QMetaObject::invokeMethod(this, [this, job, fraction]() {
+                if (job == m_job) emit progress(fraction);
+            }, Qt::QueuedConnection);
+        };
+
+        QString error;
+        QVector<hmi::InspectionTarget> targets =
+            sample(input, params, progressFn, &job->cancelled, &error);
+
+        job->finished = true;   // before posting: the next start() reaps this thread
+        QMetaObject::invokeMethod(this, [this, job, targets, error]() {
+            if (job != m_job) return;            // cancelled or superseded
+            m_job.reset();
+            if (!error.isEmpty()) {
+                emit failed(error);
+            } else {
+                emit finished(targets);
+            }
+        }, Qt::QueuedConnection);
+    });
+    m_workers.push_back(Worker{job, std::move(worker)});
+
+    emit started();
+}
+
+void SurfaceSampler::cancel()
+{
+    if (!m_job) return;
+    m_job->cancelled = true;
+    m_job.reset();
+    emit cancelled();
+}
+
+bool SurfaceSampler::isRunning() const
+{
+    return m_job != nullptr;
+}
+
+void SurfaceSampler::reapWorkers()
+{
+    auto done = [](Worker& w) {
+        if (!w.job->finished.load()) return false;
+        if (w.thread.joinable()) w.thread.join();
+        return true;
+    };
+    m_workers.erase(std::remove_if(m_workers.begin(), m_workers.end(), done),
+                    m_workers.end());
+}
@@ -0,0 +1,115 @@
+// src/scene/SurfaceSampler.h
+//
+// SurfaceSampler – automatic inspection-point generation on the CAD mesh.
+//
+// Produces an evenly spaced set of InspectionTargets on CadScene::modelPolyData()
+// by Poisson-disk sampling its triangles: no two accepted samples on the same
+// side of the surface are closer than the requested spacing, and the gaps are
+// close to uniform (unlike a grid, which aliases against the tessellation).
+//
+// Pipeline (all stages split across worker threads):
+//   1. Triangulate the polygons (fan) and take per-face normals.
+//   2. Optional filters: a face region grown from a seed cell across edges
+//      whose dihedral angle stays below a limit (an STL has no B-rep faces,
+//      so "this face" is the smooth patch around a picked cell), and a
+//      normal-angle cone around a reference direction.
+//   3. Dart candidates: area-weighted random points on the kept triangles,
+//      about ten per expected output sample.
+//   4. Parallel elimination on a uniform grid with cell size = spacing.
+//      Cells are coloured in 27 phases by (ix, iy, iz) mod 3; within a phase
+//      no two cells share a neighbourhood, so each cell accepts its
+//      candidates (in random rank order) against already accepted neighbours
+//      without locks.
+// Randomness is seeded per fixed-size chunk, so the result depends only on
+// the mesh and Params, never on the thread count.
+//
+// Each sample becomes a target with the surface normal (interpolated point
+// normals where the mesh has them), faceIndex = VTK cell id, and the default
+// ViewHint (camera looking along -normal), ready for
+// PointAnnotator::addTargets().
+//
+// Thread safety: start() / cancel() from the GUI thread; signals are emitted
+// on the GUI thread.  sample() is reentrant and only reads the model.
+
+#pragma once
+
+#include "Types.h"
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QVector3D>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkType.h>
+
+class vtkPolyData;
+
+class SurfaceSampler : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Params {
+        double    spacingM = 0.05;            ///< minimum distance between samples
+        QVector3D direction;                  ///< normal filter axis; null = off
+        double    maxAngleDeg = 45.0;         ///< normal filter half-angle
+        vtkIdType regionSeedCell = -1;        ///< face region seed; -1 = whole model
+        double    regionMaxDihedralDeg = 20.0;
+        int32_t   firstPointId = 1;           ///< IDs are assigned consecutively
+        QString   groupId;
+        int       maxPoints = 20000;          ///< refuse to exceed (spacing too small)
+        quint32   seed = 1;
+        int       threads = 0;                ///< 0 = hardware concurrency
+    };
+
+    using ProgressFn = std::function<void(double fraction)>;
+
+    explicit SurfaceSampler(QObject* parent = nullptr);
+    ~SurfaceSampler() override;
+
+    /// Sample \a model on a worker thread.  A running job is cancelled first.
+    /// The model is retained for the duration of the job.
+    void start(vtkPolyData* model, const Params& params);
+
+    /// Abandon the running job (emits cancelled()).
+    void cancel();
+
+    bool isRunning() const;
+
+    /// Synchronous sampling.  Returns the targets, or an empty vector with
+    /// \a error set (left empty when cancelled).
+    static QVector<hmi::InspectionTarget> sample(vtkPolyData*             model,
+                                                 const Params&            params,
+                                                 const ProgressFn&        progress  = {},
+                                                 const std::atomic<bool>* cancelled = nullptr,
+                                                 QString*                 error     = nullptr);
+
+signals:
+    void started();
+    void progress(double fraction);
+    void finished(QVector<hmi::InspectionTarget> targets);
+    void failed(QString message);
+    void cancelled();
+
+private:
+    struct Job {
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> finished{false};
+    };
+    struct Worker {
+        std::shared_ptr<Job> job;
+        std::thread          thread;
+    };
+
+    std::shared_ptr<Job> m_job;       ///< current job; null when idle
+    std::vector<Worker>  m_workers;   ///< joined in the destructor
+
+    void reapWorkers();
+};
@@ -0,0 +1,169 @@
+// src/ui/DiagnosticsPanel.cpp
+
+#include "DiagnosticsPanel.h"
+
+#include "core/GatewayClient.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+namespace {
+
+enum Column {
+    ColMethod,
+    ColCalls,
+    ColFailures,
+    ColP50,
+    ColP95,
+    ColP99,
+    ColRate,
+    ColBytesOut,
+    ColBytesIn,
+    ColConversion,
+    ColLag,
+    ColCount
+};
+
+QString formatMs(double us)
+{
+    return QString::number(us / 1000.0, 'f', us < 10000.0 ? 2 : 0);
+}
+
+QString formatBytes(uint64_t bytes)
+{
+    if (bytes >= 1024ull * 1024ull) {
+        return QStringLiteral("%1 MiB").arg(double(bytes) / (1024.0 * 1024.0), 0, 'f', 1);
+    }
+    if (bytes >= 1024ull) {
+        return QStringLiteral("%1 KiB").arg(double(bytes) / 1024.0, 0, 'f', 1);
+    }
+    return QString::number(bytes);
+}
+
+} // anonymous namespace
+
+DiagnosticsPanel::DiagnosticsPanel(hmi::GatewayClient* client, QWidget* parent)
+    : QWidget(parent, Qt::Tool)
+    , m_client(client)
+{
+    setWindowTitle(tr("通信诊断"));
+    resize(1100, 460);
+
+    auto* layout = new QVBoxLayout(this);
+
+    m_connectionLabel = new QLabel(this);
+    m_connectionLabel->setStyleSheet("QLabel { color: gray; }");
+    layout->addWidget(m_connectionLabel);
+
+    m_table = new QTableWidget(0, ColCount, this);
+    m_table->setHorizontalHeaderLabels({
+        tr("方法"), tr("调用"), tr("失败"),
+        tr("P50 ms"), tr("P95 ms"), tr("P99 ms"), tr("消息/s"),
+        tr("发送"), tr("接收"), tr("转换 P95 ms"), tr("投递延迟 P95 ms")
+    });
+    m_table->verticalHeader()->hide();
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(m_table, 1);
+
+    auto* buttons = new QHBoxLayout;
+    buttons->addStretch(1);
+    auto* resetButton = new QPushButton(tr("清零"), this);
+    buttons->addWidget(resetButton);
+    layout->addLayout(buttons);
+
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        if (m_client) { m_client->resetRpcMetrics(); }
+        m_previous = {};
+        refresh();
+    });
+
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(1000);
+    connect(m_refreshTimer, &QTimer::timeout, this, &DiagnosticsPanel::refresh);
+}
+
+void DiagnosticsPanel::toggle()
+{
+    if (isVisible()) {
+        hide();
+        return;
+    }
+    show();
+    raise();
+    activateWindow();
+}
+
+void DiagnosticsPanel::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    if (m_client) { m_previous = m_client->rpcMetrics(); }
+    refresh();
+    m_refreshTimer->start();
+}
+
+void DiagnosticsPanel::hideEvent(QHideEvent* event)
+{
+    m_refreshTimer->stop();   // costs nothing while hidden
+    QWidget::hideEvent(event);
+}
+
+void DiagnosticsPanel::refresh()
+{
+    if (!m_client) { return; }
+
+    const hmi::ConnectionStats conn = m_client->connectionStats();
+    m_connectionLabel->setText(
+        tr("连接: %1   断开 %2 次   重连 %3 次（最近 %4 ms，最长 %5 ms，平均 %6 ms）   自动重订阅 %7 次")
+            .arg(m_client->isConnected() ? tr("已连接") : tr("未连接"))
+            .arg(conn.drops)
+            .arg(conn.reconnects)
+            .arg(conn.lastReconnectMs)
+            .arg(conn.maxReconnectMs)
+            .arg(conn.meanReconnectMs(), 0, 'f', 0)
+            .arg(conn.resubscribes));
+
+    const hmi::RpcMetricsSnapshot now = m_client->rpcMetrics();
+
+    int row = 0;
+    for (std::size_t i = 0; i < hmi::kRpcMethodCount; ++i) {
+        const auto method = static_cast<hmi::RpcMethod>(i);
+        const hmi::RpcMethodStats& m = now[method];
+        if (m.calls == 0 && m.messages == 0) { continue; }
+
+        if (row >= m_table->rowCount()) {
+            m_table->insertRow(row);
+            for (int c = 0; c < ColCount; ++c) {
+                auto* item = new QTableWidgetItem;
+                item->setTextAlignment(c == ColMethod ? Qt::AlignLeft | Qt::AlignVCenter
+                                                      : Qt::AlignRight | Qt::AlignVCenter);
+                m_table->setItem(row, c, item);
+            }
+        }
+        auto set = [this, row](int col, const QString& text) {
+            m_table->item(row, col)->setText(text);
+        };
+        set(ColMethod,     QString::fromLatin1(hmi::rpcMethodName(method)));
+        set(ColCalls,      QString::number(m.calls));
+        set(ColFailures,   QString::number(m.failures));
+        set(ColP50,        formatMs(m.latency.percentileUs(0.50)));
+        set(ColP95,        formatMs(m.latency.percentileUs(0.95)));
+        set(ColP99,        formatMs(m.latency.percentileUs(0.99)));
+        set(ColRate,       QString::number(now.messagesPerSecond(method, m_previous), 'f', 1));
+        set(ColBytesOut,   formatBytes(m.bytesSent));
+        set(ColBytesIn,    formatBytes(m.bytesReceived));
+        set(ColConversion, formatMs(m.conversion.percentileUs(0.95)));
+        set(ColLag,        formatMs(m.deliveryLag.percentileUs(0.95)));
+        ++row;
+    }
+    m_table->setRowCount(row);
+
+    m_previous = now;
+}
@@ -0,0 +1,44 @@
+// src/ui/DiagnosticsPanel.h
+//
+// DiagnosticsPanel – hidden tool window with the GatewayClient RPC metrics
+// (per-method latency percentiles, bytes, stream rates, conversion time,
+// delivery lag) and the connection counters.  Opened with Ctrl+Shift+D from
+// either mode window (see main.cpp); refreshes once per second while shown.
+
+#pragma once
+
+#include "core/RpcMetrics.h"
+
+#include <QWidget>
+
+class QLabel;
+class QTableWidget;
+class QTimer;
+
+namespace hmi {
+class GatewayClient;
+} // namespace hmi
+
+class DiagnosticsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsPanel(hmi::GatewayClient* client, QWidget* parent = nullptr);
+
+    /// Show and raise, or hide when already visible.
+    void toggle();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    void refresh();
+
+    hmi::GatewayClient*     m_client;
+    QTimer*                 m_refreshTimer = nullptr;
+    QLabel*                 m_connectionLabel = nullptr;
+    QTableWidget*           m_table = nullptr;
+    hmi::RpcMetricsSnapshot m_previous;   ///< for messages/s
+};
@@ -1,19 +1,27 @@
 // src/ui/EditPanel.cpp
 
 #include "EditPanel.h"
+#include "EventLogModel.h"
+#include "EventTimelineView.h"
 
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDoubleSpinBox>
 #include <QFormLayout>
 #include <QGroupBox>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
-#include <QListWidget>
 #include <QProgressBar>
 #include <QPushButton>
 #include <QScrollArea>
+#include <QSignalBlocker>
+#include <QSlider>
 #include <QTabWidget>
 #include <QVBoxLayout>
 
+#include <algorithm>
+
 EditPanel::EditPanel(QWidget* parent)
     : QWidget(parent)
 {
@@ -71,6 +79,74 @@ QWidget* EditPanel::createAnnotationTab()
     });
     mainLayout->addWidget(m_deleteBtn);
 
+    // -----------------------------------------------------------------------
+    // Automatic point generation
+    // -----------------------------------------------------------------------
+    auto* sampleGroup = new QGroupBox(tr("自动布点"), content);
+    auto* sampleForm = new QFormLayout(sampleGroup);
+
+    m_spacingSpin = new QDoubleSpinBox(sampleGroup);
+    m_spacingSpin->setRange(1.0, 1000.0);
+    m_spacingSpin->setDecimals(1);
+    m_spacingSpin->setValue(50.0);
+    m_spacingSpin->setSuffix(tr(" mm"));
+    sampleForm->addRow(tr("间距:"), m_spacingSpin);
+
+    m_facingCombo = new QComboBox(sampleGroup);
+    m_facingCombo->addItem(tr("不限"), QVariant::fromValue(QVector3D()));
+    m_facingCombo->addItem(QStringLiteral("+Z"), QVariant::fromValue(QVector3D(0, 0, 1)));
+    m_facingCombo->addItem(QStringLiteral("-Z"), QVariant::fromValue(QVector3D(0, 0, -1)));
+    m_facingCombo->addItem(QStringLiteral("+X"), QVariant::fromValue(QVector3D(1, 0, 0)));
+    m_facingCombo->addItem(QStringLiteral("-X"), QVariant::fromValue(QVector3D(-1, 0, 0)));
+    m_facingCombo->addItem(QStringLiteral("+Y"), QVariant::fromValue(QVector3D(0, 1, 0)));
+    m_facingCombo->addItem(QStringLiteral("-Y"), QVariant::fromValue(QVector3D(0, -1, 0)));
+    sampleForm->addRow(tr("法向朝向:"), m_facingCombo);
+
+    m_maxAngleSpin = new QDoubleSpinBox(sampleGroup);
+    m_maxAngleSpin->setRange(0.0, 180.0);
+    m_maxAngleSpin->setDecimals(0);
+    m_maxAngleSpin->setValue(45.0);
+    m_maxAngleSpin->setSuffix(tr(" °"));
+    m_maxAngleSpin->setEnabled(false);
+    sampleForm->addRow(tr("最大偏角:"), m_maxAngleSpin);
+    connect(m_facingCombo, &QComboBox::currentIndexChanged, this, [this](int index) {
+        m_maxAngleSpin->setEnabled(index > 0);
+    });
+
+    m_selectedFaceCheck = new QCheckBox(tr("仅选中点所在面"), sampleGroup);
+    sampleForm->addRow(QString(), m_selectedFaceCheck);
+
+    m_sampleBtn = new QPushButton(tr("生成点位"), sampleGroup);
+    connect(m_sampleBtn, &QPushButton::clicked, this, [this]() {
+        if (m_samplingBusy) {
+            emit surfaceSamplingCancelRequested();
+            return;
+        }
+        emit surfaceSamplingRequested(m_spacingSpin->value() / 1000.0,
+                                      m_facingCombo->currentData().value<QVector3D>(),
+                                      m_maxAngleSpin->value(),
+                                      m_selectedFaceCheck->isChecked());
+    });
+    sampleForm->addRow(QString(), m_sampleBtn);
+
+    mainLayout->addWidget(sampleGroup);
+
+    // -----------------------------------------------------------------------
+    // Coverage heatmap (targets + plan views, computed in the background)
+    // -----------------------------------------------------------------------
+    auto* coverageGroup = new QGroupBox(tr("覆盖分析"), content);
+    auto* coverageLayout = new QVBoxLayout(coverageGroup);
+
+    m_coverageCheck = new QCheckBox(tr("显示覆盖热图"), coverageGroup);
+    connect(m_coverageCheck, &QCheckBox::toggled, this, &EditPanel::coverageToggled);
+    coverageLayout->addWidget(m_coverageCheck);
+
+    m_coverageLabel = new QLabel(QStringLiteral("-"), coverageGroup);
+    m_coverageLabel->setStyleSheet("QLabel { color: gray; }");
+    coverageLayout->addWidget(m_coverageLabel);
+
+    mainLayout->addWidget(coverageGroup);
+
     // -----------------------------------------------------------------------
     // Point count summary
     // -----------------------------------------------------------------------
@@ -129,6 +205,30 @@ QWidget* EditPanel::createTaskTab()
     m_planStatsLabel->setStyleSheet("QLabel { color: gray; }");
     resultLayout->addWidget(m_planStatsLabel);
 
+    // 3D preview of every waypoint's camera / TCP / arm pose, scrubbable.
+    m_previewCheck = new QCheckBox(tr("三维预览 (相机 / TCP / 机械臂)"), resultGroup);
+    m_previewCheck->setChecked(true);
+    m_previewCheck->setEnabled(false);
+    connect(m_previewCheck, &QCheckBox::toggled, this, [this](bool checked) {
+        m_previewSlider->setEnabled(checked && m_previewSlider->maximum() > 0);
+        emit planPreviewToggled(checked);
+    });
+    resultLayout->addWidget(m_previewCheck);
+
+    auto* previewRow = new QHBoxLayout();
+    m_previewSlider = new QSlider(Qt::Horizontal, resultGroup);
+    m_previewSlider->setRange(0, 0);
+    m_previewSlider->setEnabled(false);
+    connect(m_previewSlider, &QSlider::valueChanged, this, [this](int value) {
+        m_previewLabel->setText(
+            tr("航点 %1 / %2").arg(value + 1).arg(m_previewSlider->maximum() + 1));
+        emit planPreviewIndexChanged(value);
+    });
+    previewRow->addWidget(m_previewSlider, 1);
+    m_previewLabel = new QLabel(QStringLiteral("-"), resultGroup);
+    previewRow->addWidget(m_previewLabel);
+    resultLayout->addLayout(previewRow);
+
     mainLayout->addWidget(resultGroup);
 
     // -----------------------------------------------------------------------
@@ -212,7 +312,9 @@ QWidget* EditPanel::createTaskTab()
     auto* eventsGroup = new QGroupBox(tr("事件"), content);
     auto* eventsLayout = new QVBoxLayout(eventsGroup);
 
-    m_eventList = new QListWidget(eventsGroup);
+    m_eventModel = new EventLogModel(kMaxEvents, this);
+    m_eventList = new EventTimelineView(eventsGroup);
+    m_eventList->setEventModel(m_eventModel);
     m_eventList->setMaximumHeight(200);
     eventsLayout->addWidget(m_eventList);
 
@@ -234,15 +336,15 @@ void EditPanel::showTargetDetails(const hmi::InspectionTarget& target)
 
     m_pointIdLabel->setText(QString::number(target.pointId));
     m_positionLabel->setText(
-        tr("(%.3f, %.3f, %.3f)")
-            .arg(static_cast<double>(target.surface.position.x()))
-            .arg(static_cast<double>(target.surface.position.y()))
-            .arg(static_cast<double>(target.surface.position.z())));
+        tr("(%1, %2, %3)")
+            .arg(static_cast<double>(target.surface.position.x()), 0, 'f', 3)
+            .arg(static_cast<double>(target.surface.position.y()), 0, 'f', 3)
+            .arg(static_cast<double>(target.surface.position.z()), 0, 'f', 3));
     m_normalLabel->setText(
-        tr("(%.3f, %.3f, %.3f)")
-            .arg(static_cast<double>(target.surface.normal.x()))
-            .arg(static_cast<double>(target.surface.normal.y()))
-            .arg(static_cast<double>(target.surface.normal.z())));
+        tr("(%1, %2, %3)")
+            .arg(static_cast<double>(target.surface.normal.x()), 0, 'f', 3)
+            .arg(static_cast<double>(target.surface.normal.y()), 0, 'f', 3)
+            .arg(static_cast<double>(target.surface.normal.z()), 0, 'f', 3));
 
     m_deleteBtn->setEnabled(true);
 }
@@ -261,6 +363,23 @@ void EditPanel::setPointCount(int count)
     m_pointCountLabel->setText(tr("共 %1 个检测点位").arg(count));
 }
 
+void EditPanel::setCoverageSummary(bool busy, double coveredFraction, int views)
+{
+    if (busy) {
+        m_coverageLabel->setText(tr("正在计算覆盖..."));
+    } else {
+        m_coverageLabel->setText(tr("覆盖率 %1% | %2 个视角")
+                                     .arg(coveredFraction * 100.0, 0, 'f', 1)
+                                     .arg(views));
+    }
+}
+
+void EditPanel::setSamplingBusy(bool busy, int percent)
+{
+    m_samplingBusy = busy;
+    m_sampleBtn->setText(busy ? tr("取消 (%1%)").arg(percent) : tr("生成点位"));
+}
+
 // ===========================================================================
 // Default configurations (hard-coded)
 // ===========================================================================
@@ -303,17 +422,36 @@ void EditPanel::showPlanResult(const hmi::PlanResponse& response)
 
     m_currentPlanId = response.planId;
 
+    const int waypoints = response.path.waypoints.size();
+    {
+        const QSignalBlocker blocker(m_previewSlider);
+        m_previewSlider->setRange(0, std::max(0, waypoints - 1));
+        m_previewSlider->setValue(0);
+    }
+    m_previewLabel->setText(waypoints > 0 ? tr("航点 %1 / %2").arg(1).arg(waypoints)
+                                          : QStringLiteral("-"));
+    m_previewCheck->setEnabled(waypoints > 0);
+    m_previewSlider->setEnabled(waypoints > 1 && m_previewCheck->isChecked());
+
     const QString stats = tr(
-        "✓ %1个点位 | %.2f m | %.1f ms")
+        "✓ %1个点位 | %2 m | %3 ms")
                               .arg(response.path.totalPoints)
-                              .arg(response.path.estimatedDistanceM)
-                              .arg(response.stats.planningTimeMs);
+                              .arg(response.path.estimatedDistanceM, 0, 'f', 2)
+                              .arg(response.stats.planningTimeMs, 0, 'f', 1);
 
     m_planStatsLabel->setText(stats);
     m_planStatsLabel->setStyleSheet("QLabel { color: green; }");
     m_startBtn->setEnabled(true);
 }
 
+void EditPanel::setPlanPreviewIndex(int index)
+{
+    const QSignalBlocker blocker(m_previewSlider);
+    m_previewSlider->setValue(index);
+    m_previewLabel->setText(
+        tr("航点 %1 / %2").arg(m_previewSlider->value() + 1).arg(m_previewSlider->maximum() + 1));
+}
+
 // ===========================================================================
 // Tab 2 -- Task API: Task status
 // ===========================================================================
@@ -434,29 +572,24 @@ void EditPanel::addEvent(const hmi::InspectionEvent& event)
                              .arg(event.pointId)
                              .arg(event.message);
 
-    auto* item = new QListWidgetItem(text, m_eventList);
-
     // Color code by event type
+    QColor color;
     using T = hmi::InspectionEventType;
     switch (event.type) {
     case T::Warn:
-        item->setForeground(QColor(255, 140, 0)); // orange
+        color = QColor(255, 140, 0); // orange
         break;
     case T::Error:
-        item->setForeground(Qt::red);
+        color = Qt::red;
         break;
     case T::DefectFound:
-        item->setForeground(QColor(255, 0, 255)); // magenta
+        color = QColor(255, 0, 255); // magenta
         break;
     default:
         break;
     }
 
-    m_eventList->addItem(item);
-    m_eventList->scrollToBottom();
-
-    // Limit event list size to last 100 items
-    while (m_eventList->count() > 100) {
-        delete m_eventList->takeItem(0);
-    }
+    // Batched into the view once per frame; the model keeps the last
+    // kMaxEvents entries.
+    m_eventModel->append(EventLogEntry{ event.timestamp, text, color });
 }
@@ -10,14 +10,20 @@
 
 #include "core/Types.h"
 
+#include <QVector3D>
 #include <QWidget>
 
+class QCheckBox;
+class QComboBox;
+class QDoubleSpinBox;
 class QTabWidget;
 class QLabel;
 class QLineEdit;
 class QPushButton;
 class QProgressBar;
-class QListWidget;
+class QSlider;
+class EventLogModel;
+class EventTimelineView;
 class QScrollArea;
 class QHBoxLayout;
 
@@ -34,8 +40,19 @@ public:
     void clearTargetDetails();
     void setPointCount(int count);
 
+    /// Reflect a running automatic sampling job: the generate button turns
+    /// into a cancel button and shows \a percent.
+    void setSamplingBusy(bool busy, int percent = 0);
+
+    /// Coverage heatmap summary: covered fraction of the surface area over
+    /// \a views views, or a "computing" note while \a busy.
+    void setCoverageSummary(bool busy, double coveredFraction = 0.0, int views = 0);
+
     // Tab 2 -- Task
     void showPlanResult(const hmi::PlanResponse& response);
+
+    /// Follow the 3D plan preview's current waypoint (no signal).
+    void setPlanPreviewIndex(int index);
     void updateTaskStatus(const hmi::TaskStatus& status);
     void addEvent(const hmi::InspectionEvent& event);
 
@@ -47,7 +64,21 @@ public:
 
 signals:
     void targetDeleteRequested(int32_t pointId);
+
+    /// Automatic point generation.  \a direction is a unit axis for the
+    /// normal filter, or null for no filter.  \a selectedFaceOnly limits
+    /// sampling to the face around the selected point.
+    void surfaceSamplingRequested(double spacingM, QVector3D direction,
+                                  double maxAngleDeg, bool selectedFaceOnly);
+    void surfaceSamplingCancelRequested();
+
+    /// Coverage heatmap toggled.
+    void coverageToggled(bool enabled);
     void planRequested(QString taskName);
+
+    /// 3D plan preview toggled / scrubbed to waypoint \a index.
+    void planPreviewToggled(bool enabled);
+    void planPreviewIndexChanged(int index);
     void startRequested(QString planId, bool dryRun);
     void pauseRequested();
     void resumeRequested();
@@ -68,6 +99,18 @@ private:
     QPushButton* m_deleteBtn       = nullptr;
     QLabel*      m_pointCountLabel = nullptr;
 
+    // -- Automatic point generation
+    QDoubleSpinBox* m_spacingSpin     = nullptr;
+    QComboBox*      m_facingCombo     = nullptr;
+    QDoubleSpinBox* m_maxAngleSpin    = nullptr;
+    QCheckBox*      m_selectedFaceCheck = nullptr;
+    QPushButton*    m_sampleBtn       = nullptr;
+    bool            m_samplingBusy    = false;
+
+    // -- Coverage heatmap
+    QCheckBox*      m_coverageCheck   = nullptr;
+    QLabel*         m_coverageLabel   = nullptr;
+
     int32_t m_currentPointId = -1;
 
     // -----------------------------------------------------------------------
@@ -78,6 +121,9 @@ private:
     QLineEdit*   m_taskNameEdit    = nullptr;
     QPushButton* m_planBtn         = nullptr;
     QLabel*      m_planStatsLabel  = nullptr;
+    QCheckBox*   m_previewCheck    = nullptr;
+    QSlider*     m_previewSlider   = nullptr;
+    QLabel*      m_previewLabel    = nullptr;
 
     // -- Execute section
     QPushButton* m_startBtn        = nullptr;
@@ -94,7 +140,9 @@ private:
     QLabel*      m_interlockLabel  = nullptr;
 
     // -- Events section
-    QListWidget* m_eventList       = nullptr;
+    static constexpr int kMaxEvents = 100;
+    EventLogModel*     m_eventModel = nullptr;
+    EventTimelineView* m_eventList  = nullptr;
 
     QString m_currentPlanId;
     QString m_currentTaskId;
@@ -0,0 +1,117 @@
+// src/ui/EventLogModel.cpp
+
+#include "EventLogModel.h"
+
+#include <QBrush>
+
+#include <algorithm>
+#include <utility>
+
+EventLogModel::EventLogModel(int capacity, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_rows(static_cast<std::size_t>(std::max(1, capacity)))
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &EventLogModel::flush);
+}
+
+// ---------------------------------------------------------------------------
+// QAbstractListModel
+// ---------------------------------------------------------------------------
+
+int EventLogModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+QVariant EventLogModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0
+        || static_cast<std::size_t>(index.row()) >= m_rows.size()) {
+        return QVariant();
+    }
+
+    const EventLogEntry& entry = m_rows[static_cast<std::size_t>(index.row())];
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::ToolTipRole:
+        return entry.text;
+    case Qt::ForegroundRole:
+        return entry.color.isValid() ? QVariant(QBrush(entry.color)) : QVariant();
+    case TimestampRole:
+        return entry.timestamp;
+    default:
+        return QVariant();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Appending
+// ---------------------------------------------------------------------------
+
+void EventLogModel::append(EventLogEntry entry)
+{
+    // Never queue more than can be shown.
+    if (m_pending.size() >= capacity()) {
+        m_pending.removeFirst();
+        ++m_dropped;
+    }
+    m_pending.append(std::move(entry));
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void EventLogModel::append(const QString& text, const QColor& color)
+{
+    append(EventLogEntry{ QDateTime::currentDateTime(), text, color });
+}
+
+void EventLogModel::flush()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    const int batch = m_pending.size();
+    const int cap   = capacity();
+    const int size  = rowCount();
+
+    // Trim the oldest rows the batch would push out, as one removal.
+    const int overflow = std::min(size, size + batch - cap);
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        m_rows.pop_front(static_cast<std::size_t>(overflow));
+        m_dropped += static_cast<quint64>(overflow);
+        endRemoveRows();
+    }
+
+    const int first = rowCount();
+    beginInsertRows(QModelIndex(), first, first + batch - 1);
+    for (EventLogEntry& entry : m_pending) {
+        m_rows.push_back(std::move(entry));
+    }
+    endInsertRows();
+    m_pending.clear();
+}
+
+void EventLogModel::clear()
+{
+    m_flushTimer.stop();
+    beginResetModel();
+    m_pending.clear();
+    m_rows.clear();
+    endResetModel();
+}
+
+void EventLogModel::setCapacity(int capacity)
+{
+    flush();
+    beginResetModel();
+    const int before = rowCount();
+    m_rows.setCapacity(static_cast<std::size_t>(std::max(1, capacity)));
+    m_dropped += static_cast<quint64>(before - rowCount());
+    endResetModel();
+}
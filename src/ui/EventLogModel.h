@@ -0,0 +1,73 @@
+// src/ui/EventLogModel.h
+//
+// EventLogModel – bounded, batched list model for log lines and event
+// timelines (StatusLog, EditPanel events, ResultPanel timeline).
+//
+// * Storage is a hmi::RingBuffer of fixed capacity: once full, the oldest
+//   rows are trimmed (the QPlainTextEdit::setMaximumBlockCount behaviour),
+//   so a multi-hour shift costs the same memory as the first minutes.
+// * append() only queues the entry.  Pending entries are flushed once per
+//   frame tick as one rowsRemoved (trim) + one rowsInserted (batch), so a
+//   burst of gateway warnings costs one view layout instead of one per line.
+//
+// Thread safety: GUI thread only.
+
+#pragma once
+
+#include "core/RingBuffer.h"
+
+#include <QAbstractListModel>
+#include <QColor>
+#include <QDateTime>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+/// One timeline / log row.
+struct EventLogEntry {
+    QDateTime timestamp;
+    QString   text;      ///< fully formatted display text
+    QColor    color;     ///< foreground; invalid = palette default
+};
+
+class EventLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Role {
+        TimestampRole = Qt::UserRole + 1,   ///< QDateTime
+    };
+
+    static constexpr int kDefaultCapacity = 2000;
+    static constexpr int kFlushIntervalMs = 16;    ///< one frame at 60 Hz
+
+    explicit EventLogModel(int capacity = kDefaultCapacity, QObject* parent = nullptr);
+
+    int      rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /// Queue \a entry; it becomes a row at the next flush.
+    void append(EventLogEntry entry);
+
+    /// Convenience overload, timestamped now.
+    void append(const QString& text, const QColor& color = QColor());
+
+    /// Apply pending entries immediately.
+    void flush();
+
+    /// Drop all rows and pending entries.
+    void clear();
+
+    void setCapacity(int capacity);
+    [[nodiscard]] int capacity() const { return static_cast<int>(m_rows.capacity()); }
+
+    /// Entries discarded since construction (trimmed or never shown).
+    [[nodiscard]] quint64 droppedCount() const noexcept { return m_dropped; }
+
+private:
+    hmi::RingBuffer<EventLogEntry> m_rows;
+    QVector<EventLogEntry>         m_pending;
+    QTimer                         m_flushTimer;
+    quint64                        m_dropped = 0;
+};
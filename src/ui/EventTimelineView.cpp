@@ -0,0 +1,61 @@
+// src/ui/EventTimelineView.cpp
+
+#include "EventTimelineView.h"
+#include "EventLogModel.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QKeyEvent>
+#include <QScrollBar>
+
+#include <algorithm>
+
+EventTimelineView::EventTimelineView(QWidget* parent)
+    : QListView(parent)
+{
+    setUniformItemSizes(true);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setSelectionMode(QAbstractItemView::ExtendedSelection);
+    setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    setWordWrap(false);
+    setTextElideMode(Qt::ElideRight);
+}
+
+void EventTimelineView::setEventModel(EventLogModel* model)
+{
+    if (QAbstractItemModel* old = this->model()) {
+        disconnect(old, nullptr, this, nullptr);
+    }
+    setModel(model);
+    if (!model) {
+        return;
+    }
+
+    // Decide before the batch lands whether we are at the tail ...
+    connect(model, &QAbstractItemModel::rowsAboutToBeInserted, this, [this]() {
+        const QScrollBar* bar = verticalScrollBar();
+        m_followTail = bar->value() >= bar->maximum();
+    });
+    // ... and stay there afterwards (once per flushed batch).
+    connect(model, &QAbstractItemModel::rowsInserted, this, [this]() {
+        if (m_followTail) {
+            scrollToBottom();
+        }
+    });
+}
+
+void EventTimelineView::keyPressEvent(QKeyEvent* event)
+{
+    if (event->matches(QKeySequence::Copy) && selectionModel()) {
+        QModelIndexList rows = selectionModel()->selectedRows();
+        std::sort(rows.begin(), rows.end());
+        QStringList lines;
+        lines.reserve(rows.size());
+        for (const QModelIndex& index : rows) {
+            lines << index.data(Qt::DisplayRole).toString();
+        }
+        QApplication::clipboard()->setText(lines.join(QLatin1Char('\n')));
+        return;
+    }
+    QListView::keyPressEvent(event);
+}
@@ -0,0 +1,30 @@
+// src/ui/EventTimelineView.h
+//
+// EventTimelineView – virtualized list view for an EventLogModel.
+//
+// Uniform row heights let QListView lay out only the visible rows.  The view
+// follows the tail while it is scrolled to the bottom and stays put once the
+// operator scrolls up to read.  Ctrl+C copies the selected rows as text.
+
+#pragma once
+
+#include <QListView>
+
+class EventLogModel;
+
+class EventTimelineView : public QListView
+{
+    Q_OBJECT
+
+public:
+    explicit EventTimelineView(QWidget* parent = nullptr);
+
+    /// Attach \a model (not owned).
+    void setEventModel(EventLogModel* model);
+
+protected:
+    void keyPressEvent(QKeyEvent* event) override;
+
+private:
+    bool m_followTail = true;
+};
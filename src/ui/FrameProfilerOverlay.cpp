@@ -0,0 +1,151 @@
+// src/ui/FrameProfilerOverlay.cpp
+
+#include "FrameProfilerOverlay.h"
+
+#include "core/FrameProfiler.h"
+
+#include <QEvent>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTimer>
+#include <QVBoxLayout>
+
+namespace {
+
+constexpr int kWorstSections = 6;
+constexpr int kMargin        = 12;
+
+QString ms(double us)
+{
+    return QString::number(us / 1000.0, 'f', us < 10000.0 ? 2 : 0);
+}
+
+} // anonymous namespace
+
+FrameProfilerOverlay::FrameProfilerOverlay(QWidget* window)
+    : QWidget(window)
+{
+    setAttribute(Qt::WA_StyledBackground);
+    setObjectName(QStringLiteral("frameProfilerOverlay"));
+    setStyleSheet(QStringLiteral(
+        "#frameProfilerOverlay { background-color: rgba(20, 20, 20, 210);"
+        " border: 1px solid #4a4a4a; border-radius: 4px; }"
+        "QLabel { color: #e0e0e0; font-family: monospace; }"));
+
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 8, 8, 8);
+
+    m_text = new QLabel(this);
+    m_text->setTextFormat(Qt::RichText);
+    layout->addWidget(m_text);
+
+    auto* buttons = new QHBoxLayout;
+    buttons->addStretch(1);
+    auto* resetButton  = new QPushButton(tr("清零"), this);
+    auto* exportButton = new QPushButton(tr("导出 Trace"), this);
+    buttons->addWidget(resetButton);
+    buttons->addWidget(exportButton);
+    layout->addLayout(buttons);
+
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        hmi::FrameProfiler::instance().reset();
+        refresh();
+    });
+    connect(exportButton, &QPushButton::clicked, this, &FrameProfilerOverlay::exportTrace);
+
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(500);
+    connect(m_refreshTimer, &QTimer::timeout, this, &FrameProfilerOverlay::refresh);
+
+    if (window) { window->installEventFilter(this); }
+    hide();
+}
+
+void FrameProfilerOverlay::toggle()
+{
+    if (isVisible()) {
+        hide();
+        return;
+    }
+    hmi::FrameProfiler::instance().setEnabled(true);
+    show();
+    raise();
+}
+
+bool FrameProfilerOverlay::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == parentWidget() && event->type() == QEvent::Resize && isVisible()) {
+        reposition();
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void FrameProfilerOverlay::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    refresh();
+    m_refreshTimer->start();
+}
+
+void FrameProfilerOverlay::hideEvent(QHideEvent* event)
+{
+    m_refreshTimer->stop();
+    QWidget::hideEvent(event);
+}
+
+void FrameProfilerOverlay::reposition()
+{
+    adjustSize();
+    if (auto* window = parentWidget()) {
+        move(window->width() - width() - kMargin, kMargin);
+    }
+}
+
+void FrameProfilerOverlay::refresh()
+{
+    const hmi::FrameProfileSnapshot s = hmi::FrameProfiler::instance().snapshot();
+
+    QString html = QStringLiteral("<b>%1</b><br>").arg(tr("帧耗时分析"));
+    html += tr("帧 P50 %1 ms  P99 %2 ms  (%3 帧)<br>")
+                .arg(ms(s.frames.percentileUs(0.50)), ms(s.frames.percentileUs(0.99)))
+                .arg(s.frames.count);
+    html += tr("事件循环延迟 P99 %1 ms<br>").arg(ms(s.eventLoopLag.percentileUs(0.99)));
+    html += tr("长卡顿 (≥ %1 ms): %2<br>")
+                .arg(s.stallThresholdMs, 0, 'f', 0)
+                .arg(s.longStalls);
+
+    html += QStringLiteral("<table cellspacing='4'><tr><th align='left'>%1</th>"
+                           "<th>%2</th><th>P99</th><th>%3</th><th>%4</th></tr>")
+                .arg(tr("最慢"), tr("次数"), tr("最大"), tr("卡顿"));
+    int shown = 0;
+    for (const hmi::ProfileSectionStats& section : s.sections) {
+        if (shown++ == kWorstSections) { break; }
+        html += QStringLiteral("<tr><td>%1</td><td align='right'>%2</td>"
+                               "<td align='right'>%3</td><td align='right'>%4</td>"
+                               "<td align='right'>%5</td></tr>")
+                    .arg(section.name.toHtmlEscaped())
+                    .arg(section.histogram.count)
+                    .arg(ms(section.histogram.percentileUs(0.99)), ms(double(section.maxUs)))
+                    .arg(section.stalls);
+    }
+    html += QStringLiteral("</table>");
+
+    m_text->setText(html);
+    reposition();
+}
+
+void FrameProfilerOverlay::exportTrace()
+{
+    const QString path = QFileDialog::getSaveFileName(
+        this, tr("导出 Chrome Trace"), QStringLiteral("hmi-trace.json"),
+        tr("Chrome Trace (*.json)"));
+    if (path.isEmpty()) { return; }
+
+    QString error;
+    if (!hmi::FrameProfiler::instance().writeChromeTrace(path, &error)) {
+        QMessageBox::warning(this, tr("导出失败"), error);
+    }
+}
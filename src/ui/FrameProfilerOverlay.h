@@ -0,0 +1,40 @@
+// src/ui/FrameProfilerOverlay.h
+//
+// FrameProfilerOverlay – translucent panel in the top-right corner of a
+// window with the FrameProfiler numbers: p50 / p99 frame time, event-loop
+// latency, long-stall count and the worst sections.  Toggled with
+// Ctrl+Shift+P (see main.cpp); showing it enables the profiler.  "导出"
+// writes the trace ring as Chrome trace JSON.  Refreshes twice a second
+// while shown.
+
+#pragma once
+
+#include <QWidget>
+
+class QLabel;
+class QTimer;
+
+class FrameProfilerOverlay : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /// Overlay \a window (its parent; follows its size).
+    explicit FrameProfilerOverlay(QWidget* window);
+
+    /// Show and enable the profiler, or hide.
+    void toggle();
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    void refresh();
+    void reposition();
+    void exportTrace();
+
+    QLabel* m_text = nullptr;
+    QTimer* m_refreshTimer = nullptr;
+};
@@ -6,18 +6,35 @@
 #include "SceneViewport.h"
 #include "EditPanel.h"
 #include "StatusLog.h"
+#include "TargetEditCommand.h"
 
+#include "core/FrameProfiler.h"
 #include "core/GatewayClient.h"
 #include "core/Types.h"
 #include "scene/CadScene.h"
+#include "scene/CoverageEngine.h"
+#include "scene/PlanPreview.h"
 #include "scene/PointAnnotator.h"
 #include "scene/QVTKWidget.h"
+#include "scene/SurfaceSampler.h"
 
 #include <QDockWidget>
+#include <QEvent>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QStatusBar>
+#include <QUndoStack>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/// Undo steps kept; each holds only the targets it changed.
+constexpr int kUndoLimit = 200;
+
+} // anonymous namespace
 
 // ---------------------------------------------------------------------------
 // Construction / destruction
@@ -28,6 +45,7 @@ MainWindow::MainWindow(QWidget* parent)
 {
     setWindowTitle(tr("工程师模式 – 巡检 HMI"));
     setMinimumSize(1280, 720);
+    m_eventFilter.includeThumbnails = false;
 
     setupUi();
     setupDocks();
@@ -76,8 +94,14 @@ void MainWindow::setGatewayClient(hmi::GatewayClient* client)
     connect(m_client, &hmi::GatewayClient::uploadCadFinished,
             this, [this](hmi::Result result, QString modelId) {
                 if (result.ok()) {
+                    if (!result.message.isEmpty()) {
+                        m_statusLog->logInfo(tr("网关: %1").arg(result.message));
+                    }
                     m_statusLog->logInfo(tr("CAD 模型上传完成，模型ID: %1").arg(modelId));
                     setAppState(AppState::ModelLoaded);
+                } else if (result.code == hmi::ErrorCode::Unspecified
+                           && result.message == QLatin1String("Cancelled")) {
+                    m_statusLog->logWarning(tr("CAD 模型上传已取消"));
                 } else {
                     m_statusLog->logError(tr("CAD 模型上传失败: %1").arg(result.message));
                 }
@@ -85,14 +109,19 @@ void MainWindow::setGatewayClient(hmi::GatewayClient* client)
 
     // Plan finished
     connect(m_client, &hmi::GatewayClient::planInspectionFinished,
-            this, [this](hmi::PlanResponse response) {
+            this, [this](const hmi::PlanResponseSnapshot& snapshot) {
+                hmi::ProfileScope profile("MainWindow::planInspectionFinished");
+                const hmi::PlanResponse& response = *snapshot;
                 if (response.result.ok()) {
                     m_editPanel->showPlanResult(response);
+                    m_plans.append({response.planId, m_pendingTaskName, response.path});
                     m_projectPanel->setPath(response.path);
+                    m_sceneViewport->cadScene()->planPreview()->show(response.path);
+                    m_sceneViewport->cadScene()->coverage()->setPlan(response.path);
                     m_statusLog->logInfo(
-                        tr("规划完成: %1 个点位, 距离 %.2f m")
+                        tr("规划完成: %1 个点位, 距离 %2 m")
                             .arg(response.path.totalPoints)
-                            .arg(response.path.estimatedDistanceM));
+                            .arg(response.path.estimatedDistanceM, 0, 'f', 2));
                     setAppState(AppState::Ready);
                 } else {
                     m_statusLog->logError(tr("规划失败: %1").arg(response.result.message));
@@ -102,16 +131,15 @@ void MainWindow::setGatewayClient(hmi::GatewayClient* client)
 
     // Task status streaming
     connect(m_client, &hmi::GatewayClient::systemStateReceived,
-            this, [this](hmi::TaskStatus status) {
-                m_editPanel->updateTaskStatus(status);
+            this, [this](const hmi::TaskStatusSnapshot& status) {
+                if (m_activity.offerStatus(status)) applyTaskStatus(*status);
             });
 
     // Inspection events
     connect(m_client, &hmi::GatewayClient::inspectionEventReceived,
-            this, [this](hmi::InspectionEvent event) {
-                m_editPanel->addEvent(event);
-                m_statusLog->logInfo(
-                    tr("[事件] 点%1: %2").arg(event.pointId).arg(event.message));
+            this, [this](const hmi::InspectionEventSnapshot& event) {
+                if (!m_eventFilter.accepts(*event)) return;
+                if (m_activity.offerEvent(event)) applyEvent(*event);
             });
 
     // Generic errors
@@ -150,7 +178,8 @@ void MainWindow::setGatewayClient(hmi::GatewayClient* client)
                     m_statusLog->logInfo(tr("任务已启动: %1").arg(taskId));
                     setAppState(AppState::Running);
                     m_client->subscribeSystemState(taskId);
-                    m_client->subscribeInspectionEvents(taskId);
+                    m_client->subscribeInspectionEvents(
+                        taskId, m_subscriptionFilter.value_or(m_eventFilter));
                 } else {
                     m_statusLog->logError(tr("启动失败: %1").arg(result.message));
                 }
@@ -159,6 +188,63 @@ void MainWindow::setGatewayClient(hmi::GatewayClient* client)
 
 hmi::GatewayClient* MainWindow::gatewayClient() const { return m_client; }
 
+void MainWindow::setEventFilter(const hmi::InspectionEventFilter& filter)
+{
+    m_eventFilter = filter;
+}
+
+void MainWindow::setSubscriptionFilter(const hmi::InspectionEventFilter& filter)
+{
+    m_subscriptionFilter = filter;
+}
+
+// ---------------------------------------------------------------------------
+// Stream updates / view activity
+// ---------------------------------------------------------------------------
+
+void MainWindow::applyTaskStatus(const hmi::TaskStatus& status)
+{
+    hmi::ProfileScope profile("MainWindow::systemStateReceived");
+    m_editPanel->updateTaskStatus(status);
+}
+
+void MainWindow::applyEvent(const hmi::InspectionEvent& event)
+{
+    hmi::ProfileScope profile("MainWindow::inspectionEventReceived");
+    m_editPanel->addEvent(event);
+    m_statusLog->logInfo(tr("[事件] 点%1: %2").arg(event.pointId).arg(event.message));
+}
+
+void MainWindow::showEvent(QShowEvent* event)
+{
+    QMainWindow::showEvent(event);
+    updateActivity();
+}
+
+void MainWindow::hideEvent(QHideEvent* event)
+{
+    QMainWindow::hideEvent(event);
+    updateActivity();
+}
+
+void MainWindow::changeEvent(QEvent* event)
+{
+    QMainWindow::changeEvent(event);
+    if (event->type() == QEvent::WindowStateChange) updateActivity();
+}
+
+void MainWindow::updateActivity()
+{
+    if (!isVisible() || isMinimized()) {
+        m_activity.deactivate();
+        return;
+    }
+    hmi::ProfileScope profile("MainWindow::catchUp");
+    m_activity.activate(
+        [this](const hmi::TaskStatus& status) { applyTaskStatus(status); },
+        [this](const hmi::InspectionEvent& event) { applyEvent(event); });
+}
+
 // ---------------------------------------------------------------------------
 // App state
 // ---------------------------------------------------------------------------
@@ -173,6 +259,204 @@ void MainWindow::setAppState(AppState state)
     emit appStateChanged(state);
 }
 
+void MainWindow::importTargets(const QVector<hmi::InspectionTarget>& targets, bool replace)
+{
+    auto* annotator = m_sceneViewport->annotator();
+    if (replace) {
+        m_undoStack->clear();   // a loaded target list starts a new history
+        annotator->replaceTargets(targets);
+        m_projectPanel->replaceTargets(targets);
+        m_editPanel->clearTargetDetails();
+        m_editPanel->setPointCount(annotator->targetCount());
+    } else {
+        QVector<hmi::InspectionTarget> before;
+        for (const auto& target : targets) {
+            if (auto previous = annotator->target(target.pointId)) {
+                before.append(std::move(*previous));
+            }
+        }
+        pushTargetEdit(tr("导入 %1 个点位").arg(targets.size()), std::move(before), targets);
+    }
+
+    for (const auto& target : targets) {
+        m_nextPointId = std::max(m_nextPointId, target.pointId + 1);
+    }
+    if (annotator->targetCount() > 0) {
+        setAppState(AppState::Editing);
+    }
+    m_statusLog->logInfo(tr("导入 %1 个点位").arg(targets.size()));
+}
+
+// ---------------------------------------------------------------------------
+// Annotation history
+// ---------------------------------------------------------------------------
+
+void MainWindow::pushTargetEdit(const QString& text,
+                                QVector<hmi::InspectionTarget> before,
+                                QVector<hmi::InspectionTarget> after)
+{
+    m_undoStack->push(new TargetEditCommand(
+        text, std::move(before), std::move(after),
+        [this](const QVector<int32_t>& removedIds,
+               const QVector<hmi::InspectionTarget>& stored) {
+            applyTargetEdit(removedIds, stored);
+        }));
+}
+
+void MainWindow::applyTargetEdit(const QVector<int32_t>& removedIds,
+                                 const QVector<hmi::InspectionTarget>& stored)
+{
+    auto* annotator = m_sceneViewport->annotator();
+    {
+        CadScene::UpdateBatch batch(m_sceneViewport->cadScene());
+        annotator->removeTargets(removedIds);
+        annotator->addTargets(stored);
+    }
+    if (!removedIds.isEmpty()) {
+        m_projectPanel->removeTargets(removedIds);
+        m_editPanel->clearTargetDetails();
+    }
+    if (!stored.isEmpty()) {
+        m_projectPanel->addTargets(stored);
+    }
+    m_editPanel->setPointCount(annotator->targetCount());
+
+    if (m_appState == AppState::Editing && annotator->targetCount() == 0) {
+        setAppState(AppState::ModelLoaded);
+    } else if (m_appState == AppState::ModelLoaded && annotator->targetCount() > 0) {
+        setAppState(AppState::Editing);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Project file
+// ---------------------------------------------------------------------------
+
+void MainWindow::resetProject()
+{
+    m_projectPanel->clearModel();
+    m_projectPanel->clearTargets();
+    m_projectPanel->clearPath();
+    m_editPanel->clearTargetDetails();
+    m_editPanel->setPointCount(0);
+    m_sampler->cancel();
+    {
+        CadScene::UpdateBatch batch(m_sceneViewport->cadScene());
+        m_sceneViewport->cadScene()->cancelLoad();
+        m_sceneViewport->cadScene()->clearModel();
+        m_sceneViewport->annotator()->clearTargets();
+        m_sceneViewport->annotator()->clearPath();
+        m_sceneViewport->cadScene()->planPreview()->clear();
+        m_sceneViewport->cadScene()->coverage()->setPlan({});
+    }
+    m_projectPath.clear();
+    m_modelPath.clear();
+    m_modelSha256.clear();
+    m_plans.clear();
+    m_pendingProject.reset();
+    m_undoStack->clear();
+    setAppState(AppState::Idle);
+}
+
+void MainWindow::openProject()
+{
+    const QString path = QFileDialog::getOpenFileName(
+        this,
+        tr("打开项目"),
+        QString(),
+        tr("巡检项目 (*.%1);;所有文件 (*)").arg(QLatin1String(hmi::ProjectFile::kSuffix)));
+    if (path.isEmpty()) return;
+
+    hmi::Project project;
+    QString error;
+    if (!hmi::ProjectFile::load(path, &project, &error)) {
+        m_statusLog->logError(tr("打开项目失败: %1").arg(error));
+        return;
+    }
+    resetProject();
+    m_projectPath = path;
+
+    // Targets and plans follow the model (CadScene::modelLoaded) so that
+    // they are not reset by its ModelLoaded state.
+    const QFileInfo model(project.modelPath);
+    if (project.modelPath.isEmpty()) {
+        applyProject(project);
+        return;
+    }
+    if (!model.exists()) {
+        m_statusLog->logWarning(tr("项目的模型文件不存在: %1").arg(project.modelPath));
+        applyProject(project);
+        return;
+    }
+    if (model.size() != project.modelBytes) {
+        m_statusLog->logWarning(tr("模型文件已在保存项目后改动: %1").arg(project.modelPath));
+    }
+    m_statusLog->logInfo(tr("正在加载模型: %1").arg(project.modelPath));
+    const QString modelPath = project.modelPath;
+    m_pendingProject = std::move(project);
+    m_sceneViewport->loadModel(modelPath);
+}
+
+void MainWindow::applyProject(const hmi::Project& project)
+{
+    importTargets(project.targets, true);
+    m_plans = project.plans;
+    if (!m_plans.isEmpty()) {
+        // The newest plan is shown for review; running it needs a fresh
+        // plan from the gateway.
+        const hmi::InspectionPath& path = m_plans.constLast().path;
+        m_projectPanel->setPath(path);
+        m_sceneViewport->cadScene()->planPreview()->show(path);
+        m_sceneViewport->cadScene()->coverage()->setPlan(path);
+    }
+    m_statusLog->logInfo(tr("已打开项目: %1（%2 个点位, %3 个规划）")
+                             .arg(QFileInfo(m_projectPath).fileName())
+                             .arg(project.targets.size())
+                             .arg(project.plans.size()));
+}
+
+void MainWindow::saveProject()
+{
+    QString path = m_projectPath;
+    if (path.isEmpty()) {
+        const QLatin1String suffix(hmi::ProjectFile::kSuffix);
+        path = QFileDialog::getSaveFileName(
+            this, tr("保存项目"), QString(), tr("巡检项目 (*.%1)").arg(suffix));
+        if (path.isEmpty()) return;
+        if (QFileInfo(path).suffix().isEmpty()) path += QLatin1Char('.') + suffix;
+    }
+
+    hmi::Project project;
+    project.modelPath = m_modelPath;
+    if (!m_modelPath.isEmpty()) {
+        if (m_modelSha256.isEmpty()) {
+            m_modelSha256 = hmi::ProjectFile::fileSha256(m_modelPath);
+        }
+        project.modelSha256 = m_modelSha256;
+        project.modelBytes  = QFileInfo(m_modelPath).size();
+    }
+    project.captureConfig = EditPanel::defaultCaptureConfig();
+    project.planOptions   = EditPanel::defaultPlanOptions();
+    project.targets       = m_sceneViewport->annotator()->targets();
+    project.plans         = m_plans;
+
+    hmi::ProjectSaveStats stats;
+    QString error;
+    if (!hmi::ProjectFile::save(path, project, &stats, &error)) {
+        m_statusLog->logError(tr("保存项目失败: %1").arg(error));
+        return;
+    }
+    m_projectPath = path;
+    if (stats.sectionsWritten == 0 && !stats.rewritten) {
+        m_statusLog->logInfo(tr("项目未改动: %1").arg(QFileInfo(path).fileName()));
+    } else {
+        m_statusLog->logInfo(tr("项目已保存: %1（写入 %2 个分段, %3 KB）")
+                                 .arg(QFileInfo(path).fileName())
+                                 .arg(stats.sectionsWritten)
+                                 .arg((stats.bytesWritten + 1023) / 1024));
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Private – UI construction
 // ---------------------------------------------------------------------------
@@ -185,6 +469,9 @@ void MainWindow::setupUi()
     m_sceneViewport = new SceneViewport(this);
     m_editPanel     = new EditPanel(this);
     m_statusLog     = new StatusLog(this);
+    m_sampler       = new SurfaceSampler(this);
+    m_undoStack     = new QUndoStack(this);
+    m_undoStack->setUndoLimit(kUndoLimit);
 
     // Central widget is the 3-D viewport
     setCentralWidget(m_sceneViewport);
@@ -229,16 +516,30 @@ void MainWindow::connectSignals()
 {
     // TopBar actions
     connect(m_topBar, &TopBar::newProjectRequested, this, [this]() {
-        m_projectPanel->clearModel();
-        m_projectPanel->clearTargets();
-        m_projectPanel->clearPath();
-        m_editPanel->clearTargetDetails();
-        m_editPanel->setPointCount(0);
-        m_sceneViewport->cadScene()->clearModel();
-        m_sceneViewport->annotator()->clearTargets();
-        setAppState(AppState::Idle);
+        resetProject();
         m_statusLog->logInfo(tr("新建项目"));
     });
+    connect(m_topBar, &TopBar::openProjectRequested, this, &MainWindow::openProject);
+    connect(m_topBar, &TopBar::saveProjectRequested, this, &MainWindow::saveProject);
+
+    // Annotation undo / redo
+    connect(m_topBar, &TopBar::undoRequested, this, [this]() {
+        if (!m_undoStack->canUndo()) return;
+        m_statusLog->logInfo(tr("撤销: %1").arg(m_undoStack->undoText()));
+        m_undoStack->undo();
+    });
+    connect(m_topBar, &TopBar::redoRequested, this, [this]() {
+        if (!m_undoStack->canRedo()) return;
+        m_statusLog->logInfo(tr("重做: %1").arg(m_undoStack->redoText()));
+        m_undoStack->redo();
+    });
+    auto syncUndoState = [this]() {
+        m_topBar->setUndoState(m_undoStack->canUndo(), m_undoStack->undoText(),
+                               m_undoStack->canRedo(), m_undoStack->redoText());
+    };
+    connect(m_undoStack, &QUndoStack::indexChanged,   this, syncUndoState);
+    connect(m_undoStack, &QUndoStack::canUndoChanged, this, syncUndoState);
+    connect(m_undoStack, &QUndoStack::canRedoChanged, this, syncUndoState);
 
     connect(m_topBar, &TopBar::importCadRequested, this, [this]() {
         const QString path = QFileDialog::getOpenFileName(
@@ -247,20 +548,9 @@ void MainWindow::connectSignals()
             QString(),
             tr("三维模型 (*.stl *.obj *.ply);;所有文件 (*)"));
         if (path.isEmpty()) return;
+        m_pendingProject.reset();   // the opened project's model is replaced
         m_statusLog->logInfo(tr("正在加载模型: %1").arg(path));
-        const bool ok = m_sceneViewport->loadModel(path);
-        if (ok) {
-            const QFileInfo fi(path);
-            m_topBar->setModelLoaded(true, fi.fileName());
-            m_projectPanel->setModelInfo(fi.fileName(), path);
-            setAppState(AppState::ModelLoaded);
-            m_statusLog->logInfo(tr("模型加载成功: %1").arg(fi.fileName()));
-            if (m_client) {
-                m_client->uploadCad(path);
-            }
-        } else {
-            m_statusLog->logError(tr("模型加载失败: %1").arg(path));
-        }
+        m_sceneViewport->loadModel(path);   // completes via CadScene::modelLoaded
     });
 
     connect(m_topBar, &TopBar::connectRequested, this, [this](const QString& addr) {
@@ -285,26 +575,20 @@ void MainWindow::connectSignals()
     // MainWindow is the single place that creates InspectionTarget objects.
     connect(m_sceneViewport, &SceneViewport::surfaceClicked,
             this, [this](hmi::SurfacePoint pt) {
-                static int32_t s_nextId = 1;
                 hmi::InspectionTarget target;
-                target.pointId            = s_nextId++;
+                target.pointId            = m_nextPointId++;
                 target.surface            = pt;
                 target.view.viewDirection = -pt.normal; // camera looks at surface
 
-                auto* annotator = m_sceneViewport->annotator();
-                annotator->addTarget(target);
-                m_sceneViewport->vtkWidget()->scheduleRender();
-
-                m_projectPanel->addTarget(target);
+                pushTargetEdit(tr("添加点位 %1").arg(target.pointId), {}, {target});
                 m_editPanel->showTargetDetails(target);
-                m_editPanel->setPointCount(annotator->targets().size());
                 setAppState(AppState::Editing);
                 m_statusLog->logInfo(
-                    tr("添加点位 %1 (%.3f, %.3f, %.3f)")
+                    tr("添加点位 %1 (%2, %3, %4)")
                         .arg(target.pointId)
-                        .arg(static_cast<double>(pt.position.x()))
-                        .arg(static_cast<double>(pt.position.y()))
-                        .arg(static_cast<double>(pt.position.z())));
+                        .arg(static_cast<double>(pt.position.x()), 0, 'f', 3)
+                        .arg(static_cast<double>(pt.position.y()), 0, 'f', 3)
+                        .arg(static_cast<double>(pt.position.z()), 0, 'f', 3));
             });
 
     // ProjectPanel selection -> EditPanel detail
@@ -316,11 +600,9 @@ void MainWindow::connectSignals()
 
     // Helper lambda for deleting a target from all components
     auto deleteTarget = [this](int32_t pointId) {
-        m_sceneViewport->annotator()->removeTarget(pointId);
-        m_sceneViewport->vtkWidget()->scheduleRender();
-        m_projectPanel->removeTarget(pointId);
-        m_editPanel->clearTargetDetails();
-        m_editPanel->setPointCount(m_sceneViewport->annotator()->targets().size());
+        const auto target = m_sceneViewport->annotator()->target(pointId);
+        if (!target) return;
+        pushTargetEdit(tr("删除点位 %1").arg(pointId), {*target}, {});
         m_statusLog->logInfo(tr("删除点位 %1").arg(pointId));
     };
 
@@ -331,6 +613,64 @@ void MainWindow::connectSignals()
     connect(m_editPanel, &EditPanel::targetDeleteRequested,
             this, deleteTarget);
 
+    // Automatic point generation: EditPanel parameters -> SurfaceSampler
+    // (worker thread) -> importTargets() as one batch.
+    connect(m_editPanel, &EditPanel::surfaceSamplingRequested,
+            this, [this](double spacingM, QVector3D direction,
+                         double maxAngleDeg, bool selectedFaceOnly) {
+                vtkPolyData* model = m_sceneViewport->cadScene()->modelPolyData();
+                if (!model) {
+                    m_statusLog->logError(tr("未加载模型，无法自动布点"));
+                    return;
+                }
+
+                SurfaceSampler::Params params;
+                params.spacingM     = spacingM;
+                params.direction    = direction;
+                params.maxAngleDeg  = maxAngleDeg;
+                params.firstPointId = m_nextPointId;
+                params.groupId      = QStringLiteral("auto");
+                if (selectedFaceOnly) {
+                    auto* annotator = m_sceneViewport->annotator();
+                    const auto selected = annotator->target(annotator->selectedTargetId());
+                    if (!selected) {
+                        m_statusLog->logError(tr("请先选中一个点位以确定所在面"));
+                        return;
+                    }
+                    params.regionSeedCell = static_cast<vtkIdType>(selected->surface.faceIndex);
+                }
+                m_statusLog->logInfo(tr("自动布点: 间距 %1 mm").arg(spacingM * 1000.0, 0, 'f', 1));
+                m_sampler->start(model, params);
+            });
+
+    connect(m_editPanel, &EditPanel::surfaceSamplingCancelRequested,
+            m_sampler, &SurfaceSampler::cancel);
+
+    connect(m_sampler, &SurfaceSampler::started, this, [this]() {
+        m_editPanel->setSamplingBusy(true, 0);
+    });
+    connect(m_sampler, &SurfaceSampler::progress, this, [this](double fraction) {
+        m_editPanel->setSamplingBusy(true, static_cast<int>(fraction * 100.0));
+    });
+    connect(m_sampler, &SurfaceSampler::finished,
+            this, [this](QVector<hmi::InspectionTarget> targets) {
+                m_editPanel->setSamplingBusy(false);
+                // Points clicked while the sampler ran have taken IDs from
+                // params.firstPointId on; renumber so none is overwritten.
+                for (auto& target : targets) {
+                    target.pointId = m_nextPointId++;
+                }
+                importTargets(targets);
+            });
+    connect(m_sampler, &SurfaceSampler::failed, this, [this](const QString& message) {
+        m_editPanel->setSamplingBusy(false);
+        m_statusLog->logError(tr("自动布点失败: %1").arg(message));
+    });
+    connect(m_sampler, &SurfaceSampler::cancelled, this, [this]() {
+        m_editPanel->setSamplingBusy(false);
+        m_statusLog->logInfo(tr("自动布点已取消"));
+    });
+
     // Plan request: collect targets -> SetInspectionTargets -> PlanInspection
     connect(m_editPanel, &EditPanel::planRequested,
             this, [this](QString taskName) {
@@ -344,6 +684,7 @@ void MainWindow::connectSignals()
                     return;
                 }
                 setAppState(AppState::Planning);
+                m_pendingTaskName = taskName;
                 m_statusLog->logInfo(
                     tr("提交 %1 个点位并开始规划: %2")
                         .arg(targets.size())
@@ -353,13 +694,48 @@ void MainWindow::connectSignals()
                 const auto planOptions   = EditPanel::defaultPlanOptions();
 
                 // Step 1: submit targets + capture config
-                m_client->setInspectionTargets(
+                m_client->syncInspectionTargets(
                     QString(), targets, captureConfig, QString());
 
                 // Step 2: request plan
                 m_client->planInspection(QString(), taskName, planOptions);
             });
 
+    // Plan preview: checkbox / slider <-> the scene layer
+    auto* preview = m_sceneViewport->cadScene()->planPreview();
+    preview->setCaptureConfig(EditPanel::defaultCaptureConfig());
+    connect(m_editPanel, &EditPanel::planPreviewToggled,
+            preview, &PlanPreview::setVisible);
+    connect(m_editPanel, &EditPanel::planPreviewIndexChanged,
+            preview, &PlanPreview::setCurrentIndex);
+    connect(preview, &PlanPreview::currentIndexChanged,
+            m_editPanel, &EditPanel::setPlanPreviewIndex);
+
+    // Coverage heatmap: every target edit and the latest plan feed the
+    // engine, which recomputes in the background.
+    auto* coverage = m_sceneViewport->cadScene()->coverage();
+    coverage->setCaptureConfig(EditPanel::defaultCaptureConfig());
+    auto* annotator = m_sceneViewport->annotator();
+    auto syncCoverageTargets = [coverage, annotator]() {
+        coverage->setTargets(annotator->targets());
+    };
+    connect(annotator, &PointAnnotator::targetAdded,     coverage, syncCoverageTargets);
+    connect(annotator, &PointAnnotator::targetRemoved,   coverage, syncCoverageTargets);
+    connect(annotator, &PointAnnotator::targetsRemoved,  coverage, syncCoverageTargets);
+    connect(annotator, &PointAnnotator::targetUpdated,   coverage, syncCoverageTargets);
+    connect(annotator, &PointAnnotator::targetsAdded,    coverage, syncCoverageTargets);
+    connect(annotator, &PointAnnotator::targetsReplaced, coverage, syncCoverageTargets);
+    connect(annotator, &PointAnnotator::targetsCleared,  coverage, syncCoverageTargets);
+    connect(m_editPanel, &EditPanel::coverageToggled,
+            coverage, &CoverageEngine::setHeatmapVisible);
+    connect(coverage, &CoverageEngine::busy, this, [this]() {
+        m_editPanel->setCoverageSummary(true);
+    });
+    connect(coverage, &CoverageEngine::updated,
+            this, [this](const CoverageEngine::Stats& stats) {
+                m_editPanel->setCoverageSummary(false, stats.coveredFraction(), stats.views);
+            });
+
     // Start request
     connect(m_editPanel, &EditPanel::startRequested,
             this, [this](QString planId, bool dryRun) {
@@ -401,10 +777,63 @@ void MainWindow::connectSignals()
                 setAppState(AppState::Ready);
             });
 
+    // CadScene background load
+    auto* scene = m_sceneViewport->cadScene();
+    connect(scene, &CadScene::loadProgress,
+            this, [this](CadScene::LoadStage stage, double fraction) {
+                QString what;
+                switch (stage) {
+                case CadScene::LoadStage::Reading:    what = tr("读取文件");  break;
+                case CadScene::LoadStage::Normals:    what = tr("计算法线");  break;
+                case CadScene::LoadStage::Indexing:   what = tr("建立索引");  break;
+                case CadScene::LoadStage::Finalizing: what = tr("构建场景");  break;
+                }
+                statusBar()->showMessage(
+                    tr("正在加载模型: %1 %2%").arg(what)
+                        .arg(static_cast<int>(fraction * 100.0)));
+            });
+
+    // Samples of the previous model are meaningless once it is replaced.
+    connect(scene, &CadScene::loadStarted, m_sampler, &SurfaceSampler::cancel);
+
+    connect(scene, &CadScene::modelLoaded,
+            this, [this](const QString& path) {
+                const QFileInfo fi(path);
+                m_topBar->setModelLoaded(true, fi.fileName());
+                m_projectPanel->setModelInfo(fi.fileName(), path);
+                setAppState(AppState::ModelLoaded);
+                m_statusLog->logInfo(tr("模型加载成功: %1").arg(fi.fileName()));
+                m_modelPath = path;
+                m_modelSha256.clear();
+                if (m_client) {
+                    m_client->cancelCadUploads();   // superseded by this model
+                    m_client->uploadCad(path);
+                }
+                if (m_pendingProject) {
+                    const hmi::Project project = std::move(*m_pendingProject);
+                    m_pendingProject.reset();
+                    if (fi.size() == project.modelBytes) m_modelSha256 = project.modelSha256;
+                    applyProject(project);
+                }
+            });
+
+    connect(scene, &CadScene::loadCancelled,
+            this, [this](const QString& path) {
+                m_statusLog->logWarning(tr("模型加载已取消: %1").arg(path));
+                updateUiForState(m_appState);
+                m_pendingProject.reset();
+            });
+
     // CadScene error propagation
-    connect(m_sceneViewport->cadScene(), &CadScene::errorOccurred,
+    connect(scene, &CadScene::errorOccurred,
             this, [this](const QString& err) {
-                m_statusLog->logError(err);
+                m_statusLog->logError(tr("模型加载失败: %1").arg(err));
+                updateUiForState(m_appState);
+                if (m_pendingProject) {
+                    const hmi::Project project = std::move(*m_pendingProject);
+                    m_pendingProject.reset();
+                    applyProject(project);   // targets without their model
+                }
             });
 }
 
@@ -9,10 +9,24 @@
 //   SceneViewport: setCentralWidget
 //   EditPanel   : QDockWidget, right
 //   StatusLog   : QDockWidget, bottom
+//
+// While the window is hidden or minimised (operator mode) the system-state
+// and event streams are only held (ViewActivity) and applied in one step
+// when it is shown again.  Events outside eventFilter() are dropped before
+// that; the event subscription opened for a started task uses
+// subscriptionFilter(), which main.cpp widens to cover the operator window.
 
 #pragma once
 
 #include <QMainWindow>
+#include <QVector>
+
+#include "ViewActivity.h"
+#include "core/ProjectFile.h"
+#include "core/Types.h"
+
+#include <cstdint>
+#include <optional>
 
 // Forward declarations – keep compile times short.
 class TopBar;
@@ -20,9 +34,12 @@ class ProjectPanel;
 class SceneViewport;
 class EditPanel;
 class StatusLog;
+class SurfaceSampler;
+class QUndoStack;
 
 namespace hmi {
 class GatewayClient;
+struct InspectionTarget;
 } // namespace hmi
 
 /// \brief Top-level application window for Engineer mode.
@@ -45,6 +62,16 @@ public:
     void setGatewayClient(hmi::GatewayClient* client);
     hmi::GatewayClient* gatewayClient() const;
 
+    /// Events this window shows (default: every type, no inline thumbnails –
+    /// the event lists are text only).
+    void setEventFilter(const hmi::InspectionEventFilter& filter);
+    [[nodiscard]] const hmi::InspectionEventFilter& eventFilter() const { return m_eventFilter; }
+
+    /// Filter of the event subscription opened when a task starts; every
+    /// window that consumes the stream must be covered (default:
+    /// eventFilter()).  Applies from the next subscription.
+    void setSubscriptionFilter(const hmi::InspectionEventFilter& filter);
+
     /// Application-level state that drives toolbar / button enable states.
     enum class AppState {
         Idle,
@@ -61,25 +88,68 @@ public:
     AppState appState() const;
     void     setAppState(AppState state);
 
+    /// Load a batch of targets into the annotator, the point list and the
+    /// edit panel with one render / one list update (saved target lists,
+    /// generated grids).  \a replace drops the current targets first.
+    /// Later interactive picks are numbered after the highest imported ID.
+    /// An added batch is one undo step; a replacing one clears the history.
+    void importTargets(const QVector<hmi::InspectionTarget>& targets,
+                       bool replace = false);
+
 signals:
     void appStateChanged(AppState state);
     void switchToOperatorMode();
 
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+    void changeEvent(QEvent* event) override;
+
 private:
     void setupUi();
     void setupDocks();
     void connectSignals();
     void updateUiForState(AppState state);
+    void applyTaskStatus(const hmi::TaskStatus& status);
+    void applyEvent(const hmi::InspectionEvent& event);
+    void updateActivity();
+
+    void resetProject();
+    void openProject();
+    void saveProject();
+    void applyProject(const hmi::Project& project);
+
+    /// Push an undoable edit (applied at once) – see TargetEditCommand.
+    void pushTargetEdit(const QString& text,
+                        QVector<hmi::InspectionTarget> before,
+                        QVector<hmi::InspectionTarget> after);
+    /// One undo / redo step: bulk remove + bulk store, one render.
+    void applyTargetEdit(const QVector<int32_t>& removedIds,
+                         const QVector<hmi::InspectionTarget>& stored);
 
     TopBar*        m_topBar        = nullptr;
     ProjectPanel*  m_projectPanel  = nullptr;
     SceneViewport* m_sceneViewport = nullptr;
     EditPanel*     m_editPanel     = nullptr;
     StatusLog*     m_statusLog     = nullptr;
+    SurfaceSampler* m_sampler      = nullptr;   ///< automatic point generation
+    QUndoStack*    m_undoStack     = nullptr;   ///< annotation edits
 
     hmi::GatewayClient* m_client   = nullptr;
     AppState            m_appState = AppState::Idle;
     QString             m_currentTaskId;
+    int32_t             m_nextPointId = 1;
+    ViewActivity        m_activity;
+    hmi::InspectionEventFilter m_eventFilter;
+    std::optional<hmi::InspectionEventFilter> m_subscriptionFilter;
+
+    // Project file
+    QString                     m_projectPath;      ///< empty until saved / opened
+    QString                     m_modelPath;        ///< model shown in the scene
+    QString                     m_modelSha256;      ///< of m_modelPath, at first save
+    QString                     m_pendingTaskName;  ///< of the plan request in flight
+    QVector<hmi::ProjectPlan>   m_plans;            ///< plans generated this project
+    std::optional<hmi::Project> m_pendingProject;   ///< opened, waiting for its model
 
     // Dock wrappers
     QDockWidget* m_projectDock  = nullptr;
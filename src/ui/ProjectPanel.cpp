@@ -1,10 +1,11 @@
 // src/ui/ProjectPanel.cpp
 
 #include "ProjectPanel.h"
+#include "TargetListModel.h"
 
 #include <QGroupBox>
 #include <QLabel>
-#include <QListWidget>
+#include <QListView>
 #include <QPushButton>
 #include <QSplitter>
 #include <QTreeWidget>
@@ -47,19 +48,24 @@ void ProjectPanel::setupUi()
     m_pointCountLabel->setStyleSheet("QLabel { color: gray; }");
     pointLayout->addWidget(m_pointCountLabel);
 
-    m_pointList = new QListWidget(pointGroup);
+    m_pointModel = new TargetListModel(this);
+
+    m_pointList = new QListView(pointGroup);
+    m_pointList->setModel(m_pointModel);
+    m_pointList->setUniformItemSizes(true);
+    m_pointList->setEditTriggers(QAbstractItemView::NoEditTriggers);
     m_pointList->setSelectionMode(QAbstractItemView::SingleSelection);
-    connect(m_pointList, &QListWidget::itemClicked, this, [this](QListWidgetItem* item) {
-        const int32_t pointId = item->data(Qt::UserRole).toInt();
+    connect(m_pointList, &QListView::clicked, this, [this](const QModelIndex& index) {
+        const int32_t pointId = index.data(TargetListModel::PointIdRole).toInt();
         emit targetSelected(pointId);
     });
 
     // Context menu for delete
     m_pointList->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(m_pointList, &QWidget::customContextMenuRequested, this, [this](const QPoint& pos) {
-        QListWidgetItem* item = m_pointList->itemAt(pos);
-        if (!item) return;
-        const int32_t pointId = item->data(Qt::UserRole).toInt();
+        const QModelIndex index = m_pointList->indexAt(pos);
+        if (!index.isValid()) return;
+        const int32_t pointId = index.data(TargetListModel::PointIdRole).toInt();
         emit targetDeleteRequested(pointId);
     });
 
@@ -106,60 +112,50 @@ void ProjectPanel::clearModel()
 
 void ProjectPanel::addTarget(const hmi::InspectionTarget& target)
 {
-    // Check if already exists
-    if (m_pointItems.contains(target.pointId)) {
-        updateTarget(target);
-        return;
-    }
-
-    const QString text = tr("点 %1 (%2)")
-                             .arg(target.pointId)
-                             .arg(target.groupId.isEmpty() ? tr("未分组") : target.groupId);
-
-    auto* item = new QListWidgetItem(text, m_pointList);
-    item->setData(Qt::UserRole, target.pointId);
-    m_pointList->addItem(item);
-    m_pointItems[target.pointId] = item;
-
-    m_pointCountLabel->setText(tr("共 %1 个点位").arg(m_pointItems.size()));
+    m_pointModel->addTarget(target);
+    updatePointCount();
 }
 
 void ProjectPanel::removeTarget(int32_t pointId)
 {
-    QListWidgetItem* item = findPointItem(pointId);
-    if (!item) return;
-
-    const int row = m_pointList->row(item);
-    m_pointList->takeItem(row);
-    m_pointItems.remove(pointId);
-    delete item;
-
-    m_pointCountLabel->setText(tr("共 %1 个点位").arg(m_pointItems.size()));
+    m_pointModel->removeTarget(pointId);
+    updatePointCount();
 }
 
 void ProjectPanel::updateTarget(const hmi::InspectionTarget& target)
 {
-    QListWidgetItem* item = findPointItem(target.pointId);
-    if (!item) return;
-
-    const QString text = tr("点 %1 (%2)")
-                             .arg(target.pointId)
-                             .arg(target.groupId.isEmpty() ? tr("未分组") : target.groupId);
-    item->setText(text);
+    m_pointModel->updateTarget(target);
 }
 
 void ProjectPanel::clearTargets()
 {
-    m_pointList->clear();
-    m_pointItems.clear();
-    m_pointCountLabel->setText(tr("共 0 个点位"));
+    m_pointModel->clear();
+    updatePointCount();
 }
 
 void ProjectPanel::selectTarget(int32_t pointId)
 {
-    QListWidgetItem* item = findPointItem(pointId);
-    if (!item) return;
-    m_pointList->setCurrentItem(item);
+    const int row = m_pointModel->rowOf(pointId);
+    if (row < 0) return;
+    m_pointList->setCurrentIndex(m_pointModel->index(row));
+}
+
+void ProjectPanel::addTargets(const QVector<hmi::InspectionTarget>& targets)
+{
+    m_pointModel->appendTargets(targets);
+    updatePointCount();
+}
+
+void ProjectPanel::removeTargets(const QVector<int32_t>& pointIds)
+{
+    m_pointModel->removeTargets(pointIds);
+    updatePointCount();
+}
+
+void ProjectPanel::replaceTargets(const QVector<hmi::InspectionTarget>& targets)
+{
+    m_pointModel->replaceTargets(targets);
+    updatePointCount();
 }
 
 // ---------------------------------------------------------------------------
@@ -171,22 +167,22 @@ void ProjectPanel::setPath(const hmi::InspectionPath& path)
     // Optionally display path statistics in the model tree or a separate panel.
     // For now, we update the point count to include path info.
     m_pointCountLabel->setText(
-        tr("共 %1 个点位 | 路径 %2 点, %.2f m")
-            .arg(m_pointItems.size())
+        tr("共 %1 个点位 | 路径 %2 点, %3 m")
+            .arg(m_pointModel->rowCount())
             .arg(path.totalPoints)
-            .arg(path.estimatedDistanceM));
+            .arg(path.estimatedDistanceM, 0, 'f', 2));
 }
 
 void ProjectPanel::clearPath()
 {
-    m_pointCountLabel->setText(tr("共 %1 个点位").arg(m_pointItems.size()));
+    updatePointCount();
 }
 
 // ---------------------------------------------------------------------------
 // Helpers
 // ---------------------------------------------------------------------------
 
-QListWidgetItem* ProjectPanel::findPointItem(int32_t pointId)
+void ProjectPanel::updatePointCount()
 {
-    return m_pointItems.value(pointId, nullptr);
+    m_pointCountLabel->setText(tr("共 %1 个点位").arg(m_pointModel->rowCount()));
 }
@@ -7,13 +7,13 @@
 #include "core/Types.h"
 
 #include <QWidget>
-#include <QMap>
+#include <QVector>
 
 class QTreeWidget;
 class QTreeWidgetItem;
-class QListWidget;
-class QListWidgetItem;
+class QListView;
 class QLabel;
+class TargetListModel;
 
 /// \brief Left dock panel showing model info and point list.
 class ProjectPanel : public QWidget
@@ -34,6 +34,11 @@ public:
     void clearTargets();
     void selectTarget(int32_t pointId);
 
+    // Bulk variants: one list insertion / one model reset per call.
+    void addTargets(const QVector<hmi::InspectionTarget>& targets);
+    void removeTargets(const QVector<int32_t>& pointIds);
+    void replaceTargets(const QVector<hmi::InspectionTarget>& targets);
+
     // Path display
     void setPath(const hmi::InspectionPath& path);
     void clearPath();
@@ -44,14 +49,12 @@ signals:
 
 private:
     void setupUi();
-    QListWidgetItem* findPointItem(int32_t pointId);
+    void updatePointCount();
 
-    QTreeWidget* m_modelTree      = nullptr;
-    QListWidget* m_pointList      = nullptr;
-    QLabel*      m_pointCountLabel = nullptr;
+    QTreeWidget*     m_modelTree       = nullptr;
+    QListView*       m_pointList       = nullptr;
+    TargetListModel* m_pointModel      = nullptr;
+    QLabel*          m_pointCountLabel = nullptr;
 
     QString m_modelId;
-
-    // pointId -> QListWidgetItem*
-    QMap<int32_t, QListWidgetItem*> m_pointItems;
 };
@@ -1,6 +1,7 @@
 // src/ui/SceneViewport.cpp
 
 #include "SceneViewport.h"
+#include "core/StartupTimeline.h"
 #include "scene/CadScene.h"
 #include "scene/PointAnnotator.h"
 #include "scene/QVTKWidget.h"
@@ -10,6 +11,7 @@
 #include <vtkRenderWindowInteractor.h>
 
 #include <QEvent>
+#include <QLabel>
 #include <QMouseEvent>
 #include <QToolBar>
 #include <QVBoxLayout>
@@ -35,10 +37,11 @@ QVTKWidget*     SceneViewport::vtkWidget() const { return m_vtkWidget; }
 // Model loading
 // ---------------------------------------------------------------------------
 
-bool SceneViewport::loadModel(const QString& filePath)
+void SceneViewport::loadModel(const QString& filePath)
 {
-    if (!m_cadScene) return false;
-    return m_cadScene->loadModel(filePath);
+    if (!m_cadScene) return;
+    initializeView();
+    m_cadScene->loadModelAsync(filePath);
 }
 
 // ---------------------------------------------------------------------------
@@ -51,36 +54,79 @@ void SceneViewport::setupUi()
     layout->setContentsMargins(0, 0, 0, 0);
     layout->setSpacing(0);
 
-    // Create VTK widget
-    m_vtkWidget = new QVTKWidget(this);
-
-    // Create render window
-    auto* renderWindow = vtkGenericOpenGLRenderWindow::New();
-    m_vtkWidget->setRenderWindow(renderWindow);
-    renderWindow->Delete();
-
-    // Create renderer
+    // Create renderer; it joins a render window in initializeView().
     auto* renderer = vtkRenderer::New();
     renderer->SetBackground(0.15, 0.15, 0.18);
-    renderWindow->AddRenderer(renderer);
 
     // Create CadScene and attach renderer
     m_cadScene = new CadScene(this);
     m_cadScene->setRenderer(renderer);
     renderer->Delete();
 
-    // Initialize orientation widget with the interactor
-    m_cadScene->initOrientationWidget(m_vtkWidget->interactor());
-
     // Create PointAnnotator
     m_annotator = new PointAnnotator(m_cadScene, this);
 
     // View control toolbar
     createViewToolbar();
 
+    // Stands in for the VTK widget until initializeView().
+    m_placeholder = new QLabel(tr("3D 视图初始化中…"), this);
+    m_placeholder->setAlignment(Qt::AlignCenter);
+    m_placeholder->setStyleSheet(QStringLiteral(
+        "QLabel { background-color: #26262e; color: #808080; }"));
+
     // Layout
     layout->addWidget(m_viewToolbar);
-    layout->addWidget(m_vtkWidget, 1);
+    layout->addWidget(m_placeholder, 1);
+}
+
+void SceneViewport::initializeView()
+{
+    if (m_vtkWidget) return;
+    hmi::StartupScope phase("3D view initialization");
+
+    // Create VTK widget
+    m_vtkWidget = new QVTKWidget(this);
+
+    // Create render window
+    auto* renderWindow = vtkGenericOpenGLRenderWindow::New();
+    m_vtkWidget->setRenderWindow(renderWindow);
+    renderWindow->Delete();
+    renderWindow->AddRenderer(m_cadScene->renderer());
+
+    // Scene mutations request a repaint; the widget coalesces them into one
+    // frame per display refresh.
+    connect(m_cadScene, &CadScene::renderRequested,
+            m_vtkWidget, &QVTKWidget::scheduleRender);
+
+    // Initialize orientation widget with the interactor
+    m_cadScene->initOrientationWidget(m_vtkWidget->interactor());
+
+    // Camera drags switch large models to their LOD proxy.
+    m_cadScene->observeInteraction(m_vtkWidget->interactor());
+
+    // Install event filter on vtkWidget to intercept mouse clicks for picking
+    m_vtkWidget->installEventFilter(this);
+
+    auto* vlay = static_cast<QVBoxLayout*>(layout());
+    vlay->replaceWidget(m_placeholder, m_vtkWidget);
+    vlay->setStretchFactor(m_vtkWidget, 1);
+    delete m_placeholder;
+    m_placeholder = nullptr;
+    m_vtkWidget->show();   // added after the parent may already be visible
+
+    // Whatever the scene received before now.
+    m_cadScene->render();
+}
+
+void SceneViewport::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    // First use: initialise right after the window's first frame, so the
+    // window itself appears without waiting for the GL set-up.
+    if (!m_vtkWidget) {
+        QTimer::singleShot(0, this, &SceneViewport::initializeView);
+    }
 }
 
 void SceneViewport::createViewToolbar()
@@ -94,27 +140,27 @@ void SceneViewport::createViewToolbar()
 
     auto* actFront = m_viewToolbar->addAction(tr("前视图"));
     connect(actFront, &QAction::triggered, this, [this]() {
-        if (m_cadScene) { m_cadScene->setViewFront(); m_vtkWidget->scheduleRender(); }
+        if (m_cadScene) m_cadScene->setViewFront();
     });
 
     auto* actTop = m_viewToolbar->addAction(tr("俯视图"));
     connect(actTop, &QAction::triggered, this, [this]() {
-        if (m_cadScene) { m_cadScene->setViewTop(); m_vtkWidget->scheduleRender(); }
+        if (m_cadScene) m_cadScene->setViewTop();
     });
 
     auto* actRight = m_viewToolbar->addAction(tr("右视图"));
     connect(actRight, &QAction::triggered, this, [this]() {
-        if (m_cadScene) { m_cadScene->setViewRight(); m_vtkWidget->scheduleRender(); }
+        if (m_cadScene) m_cadScene->setViewRight();
     });
 
     auto* actIso = m_viewToolbar->addAction(tr("等轴测"));
     connect(actIso, &QAction::triggered, this, [this]() {
-        if (m_cadScene) { m_cadScene->setViewIsometric(); m_vtkWidget->scheduleRender(); }
+        if (m_cadScene) m_cadScene->setViewIsometric();
     });
 
     auto* actReset = m_viewToolbar->addAction(tr("复位"));
     connect(actReset, &QAction::triggered, this, [this]() {
-        if (m_cadScene) { m_cadScene->resetCamera(); m_vtkWidget->scheduleRender(); }
+        if (m_cadScene) m_cadScene->resetCamera();
     });
 
     // Spacer
@@ -125,8 +171,29 @@ void SceneViewport::createViewToolbar()
 
 void SceneViewport::setupInteraction()
 {
-    // Install event filter on vtkWidget to intercept mouse clicks for picking
-    m_vtkWidget->installEventFilter(this);
+    // Hover ray casts: the latest cursor position wins, at most one per frame.
+    m_hoverTimer.setSingleShot(true);
+    m_hoverTimer.setInterval(16);
+    connect(&m_hoverTimer, &QTimer::timeout, this, [this]() {
+        if (m_annotator) m_annotator->hoverSurface(m_hoverPos.x(), m_hoverPos.y());
+    });
+}
+
+void SceneViewport::setHoverPickEnabled(bool enabled)
+{
+    m_hoverEnabled = enabled;
+    if (!enabled) {
+        m_hoverTimer.stop();
+        if (m_annotator) m_annotator->clearHover();
+    }
+}
+
+QPoint SceneViewport::toDisplay(const QPointF& widgetPos) const
+{
+    const qreal dpr = m_vtkWidget->devicePixelRatio();
+    const int   h   = static_cast<int>(m_vtkWidget->height() * dpr);
+    return QPoint(static_cast<int>(widgetPos.x() * dpr),
+                  h - static_cast<int>(widgetPos.y() * dpr) - 1);
 }
 
 // ---------------------------------------------------------------------------
@@ -139,14 +206,30 @@ bool SceneViewport::eventFilter(QObject* obj, QEvent* event)
         auto* mouseEvent = static_cast<QMouseEvent*>(event);
         if (mouseEvent->button() == Qt::LeftButton && (mouseEvent->modifiers() & Qt::ControlModifier)) {
             // Ctrl + Left Click -> pick surface for annotation
-            const int x = static_cast<int>(mouseEvent->position().x());
-            const int y = static_cast<int>(mouseEvent->position().y());
-            auto result = m_annotator->pickSurface(x, y);
+            const QPoint p = toDisplay(mouseEvent->position());
+            auto result = m_annotator->pickSurface(p.x(), p.y());
             if (result.has_value()) {
                 emit surfaceClicked(result.value());
             }
             return true;  // consume the event so VTK doesn't rotate
         }
     }
+    if (obj == m_vtkWidget && event->type() == QEvent::MouseMove && m_hoverEnabled) {
+        auto* mouseEvent = static_cast<QMouseEvent*>(event);
+        const bool preview = (mouseEvent->modifiers() & Qt::ControlModifier)
+                          && mouseEvent->buttons() == Qt::NoButton;
+        if (preview) {
+            m_hoverPos = toDisplay(mouseEvent->position());
+            if (!m_hoverTimer.isActive()) m_hoverTimer.start();
+        } else {
+            m_hoverTimer.stop();
+            m_annotator->clearHover();
+        }
+        // Not consumed: VTK still sees the move.
+    }
+    if (obj == m_vtkWidget && event->type() == QEvent::Leave) {
+        m_hoverTimer.stop();
+        m_annotator->clearHover();
+    }
     return QWidget::eventFilter(obj, event);
 }
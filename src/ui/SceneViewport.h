@@ -1,16 +1,25 @@
 // src/ui/SceneViewport.h
 //
 // SceneViewport – central widget wrapping VTK 3D viewport and CadScene.
+//
+// The CadScene, its renderer and the PointAnnotator exist from construction;
+// the OpenGL side (QVTKWidget, render window, interactor, orientation
+// widget) is created by initializeView(): on first use (the first show, a
+// model load) or up front when main() is told to initialise eagerly.  Until
+// then a placeholder label fills the view and scene changes are only kept.
 
 #pragma once
 
 #include "core/Types.h"
 
+#include <QPoint>
+#include <QTimer>
 #include <QWidget>
 
 class QVTKWidget;
 class CadScene;
 class PointAnnotator;
+class QLabel;
 class QToolBar;
 
 /// \brief VTK 3D viewport widget with integrated scene and annotator.
@@ -24,23 +33,44 @@ public:
 
     CadScene*       cadScene()   const;
     PointAnnotator* annotator()  const;
+    /// Null until initializeView().
     QVTKWidget*     vtkWidget()  const;
 
-    bool loadModel(const QString& filePath);
+    /// Create the VTK widget and its render window (no-op once done).
+    void initializeView();
+    [[nodiscard]] bool isViewInitialized() const { return m_vtkWidget != nullptr; }
+
+    /// Start a background model load; completion is reported by CadScene
+    /// (modelLoaded / errorOccurred / loadCancelled).
+    void loadModel(const QString& filePath);
+
+    /// Hover preview of the surface normal under the cursor while Ctrl is
+    /// held (the modifier that turns a click into a new target).  On by
+    /// default; ray casts are coalesced to one per frame.
+    void setHoverPickEnabled(bool enabled);
 
 signals:
     void surfaceClicked(hmi::SurfacePoint point);
 
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
+    void showEvent(QShowEvent* event) override;
 
 private:
     void setupUi();
     void setupInteraction();
     void createViewToolbar();
 
+    /// Qt widget position → VTK display coordinates (device pixels, y up).
+    QPoint toDisplay(const QPointF& widgetPos) const;
+
     QVTKWidget*     m_vtkWidget  = nullptr;
     CadScene*       m_cadScene   = nullptr;
     PointAnnotator* m_annotator  = nullptr;
     QToolBar*       m_viewToolbar = nullptr;
+    QLabel*         m_placeholder = nullptr;   ///< until initializeView()
+
+    bool            m_hoverEnabled = true;
+    QPoint          m_hoverPos;           ///< latest display position
+    QTimer          m_hoverTimer;         ///< one ray cast per frame
 };
@@ -1,11 +1,12 @@
 // src/ui/StatusLog.cpp
 
 #include "StatusLog.h"
+#include "EventLogModel.h"
+#include "EventTimelineView.h"
 
 #include <QDateTime>
 #include <QHBoxLayout>
 #include <QLabel>
-#include <QPlainTextEdit>
 #include <QPushButton>
 #include <QVBoxLayout>
 
@@ -37,11 +38,11 @@ void StatusLog::setupUi()
 
     mainLayout->addWidget(topBar);
 
-    // Log text area
-    m_logText = new QPlainTextEdit(this);
-    m_logText->setReadOnly(true);
-    m_logText->setMaximumBlockCount(500);  // limit history
-    mainLayout->addWidget(m_logText);
+    // Log lines: ring buffer of kMaxLines, batched per frame
+    m_logModel = new EventLogModel(kMaxLines, this);
+    m_logView = new EventTimelineView(this);
+    m_logView->setEventModel(m_logModel);
+    mainLayout->addWidget(m_logView);
 }
 
 void StatusLog::logInfo(const QString& message)
@@ -51,27 +52,17 @@ void StatusLog::logInfo(const QString& message)
 
 void StatusLog::logWarning(const QString& message)
 {
-    const QString ts = QDateTime::currentDateTime().toString("HH:mm:ss");
-    const QString html = QString(
-        "<span style='color: orange;'>[%1] <b>警告</b>: %2</span>")
-                             .arg(ts)
-                             .arg(message.toHtmlEscaped());
-    m_logText->appendHtml(html);
+    appendLog(tr("警告"), message, QColor("orange"));
 }
 
 void StatusLog::logError(const QString& message)
 {
-    const QString ts = QDateTime::currentDateTime().toString("HH:mm:ss");
-    const QString html = QString(
-        "<span style='color: red;'>[%1] <b>错误</b>: %2</span>")
-                             .arg(ts)
-                             .arg(message.toHtmlEscaped());
-    m_logText->appendHtml(html);
+    appendLog(tr("错误"), message, QColor("red"));
 }
 
 void StatusLog::clear()
 {
-    m_logText->clear();
+    m_logModel->clear();
 }
 
 void StatusLog::setStatusText(const QString& text)
@@ -79,9 +70,11 @@ void StatusLog::setStatusText(const QString& text)
     m_statusLabel->setText(text);
 }
 
-void StatusLog::appendLog(const QString& level, const QString& message)
+void StatusLog::appendLog(const QString& level, const QString& message,
+                          const QColor& color)
 {
-    const QString ts = QDateTime::currentDateTime().toString("HH:mm:ss");
-    const QString line = QString("[%1] %2: %3").arg(ts).arg(level).arg(message);
-    m_logText->appendPlainText(line);
+    const QDateTime now = QDateTime::currentDateTime();
+    const QString line = QString("[%1] %2: %3")
+                             .arg(now.toString("HH:mm:ss"), level, message);
+    m_logModel->append(EventLogEntry{ now, line, color });
 }
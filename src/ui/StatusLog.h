@@ -1,14 +1,19 @@
 // src/ui/StatusLog.h
 //
 // StatusLog – bottom dock log panel with color-coded output.
+//
+// Lines go into a bounded EventLogModel (ring buffer, flushed once per frame)
+// shown by an EventTimelineView, so bursts and long shifts stay cheap.
 
 #pragma once
 
+#include <QColor>
 #include <QWidget>
 
-class QPlainTextEdit;
 class QLabel;
 class QPushButton;
+class EventLogModel;
+class EventTimelineView;
 
 /// \brief Bottom status log widget with info/warning/error color coding.
 class StatusLog : public QWidget
@@ -27,9 +32,13 @@ public:
 
 private:
     void setupUi();
-    void appendLog(const QString& level, const QString& message);
+    void appendLog(const QString& level, const QString& message,
+                   const QColor& color = QColor());
+
+    static constexpr int kMaxLines = 1000;
 
-    QPlainTextEdit* m_logText     = nullptr;
-    QLabel*         m_statusLabel = nullptr;
-    QPushButton*    m_clearBtn    = nullptr;
+    EventLogModel*     m_logModel    = nullptr;
+    EventTimelineView* m_logView     = nullptr;
+    QLabel*            m_statusLabel = nullptr;
+    QPushButton*       m_clearBtn    = nullptr;
 };
@@ -0,0 +1,47 @@
+// src/ui/TargetEditCommand.cpp
+
+#include "TargetEditCommand.h"
+
+#include <QSet>
+
+#include <utility>
+
+TargetEditCommand::TargetEditCommand(const QString&                 text,
+                                     QVector<hmi::InspectionTarget> before,
+                                     QVector<hmi::InspectionTarget> after,
+                                     ApplyFn                        apply,
+                                     QUndoCommand*                  parent)
+    : QUndoCommand(text, parent)
+    , m_before(std::move(before))
+    , m_after(std::move(after))
+    , m_apply(std::move(apply))
+{
+}
+
+void TargetEditCommand::undo()
+{
+    transition(m_after, m_before);
+}
+
+void TargetEditCommand::redo()
+{
+    transition(m_before, m_after);
+}
+
+void TargetEditCommand::transition(const QVector<hmi::InspectionTarget>& from,
+                                   const QVector<hmi::InspectionTarget>& to) const
+{
+    QSet<int32_t> kept;
+    kept.reserve(to.size());
+    for (const auto& target : to) {
+        kept.insert(target.pointId);
+    }
+
+    QVector<int32_t> removed;
+    for (const auto& target : from) {
+        if (!kept.contains(target.pointId)) {
+            removed.append(target.pointId);
+        }
+    }
+    m_apply(removed, to);
+}
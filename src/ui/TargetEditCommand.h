@@ -0,0 +1,56 @@
+// src/ui/TargetEditCommand.h
+//
+// TargetEditCommand – one undoable annotation edit on MainWindow's
+// QUndoStack.
+//
+// Every edit (pick, delete, imported batch) is stored as the targets it
+// touches and nothing else:
+//   before   the previous versions of those targets that existed
+//   after    their new versions (empty for a delete)
+// Undo takes the target set from `after` to `before`, redo the other way:
+// IDs that only the source side has are removed, the destination side is
+// stored (existing IDs are updated in place).  A step therefore costs
+// O(changed) no matter how many targets the project holds, and it goes
+// through the bulk PointAnnotator / ProjectPanel calls – one render, one
+// list update.
+//
+// The vectors are implicitly shared with the data they came from: an
+// imported grid is held by the command without a copy, and the QStrings in
+// every target share their buffers with the annotator's own targets.
+//
+// Thread safety: GUI thread only.
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <QUndoCommand>
+#include <QVector>
+
+#include <cstdint>
+#include <functional>
+
+class TargetEditCommand : public QUndoCommand
+{
+public:
+    /// Applies one step: remove \a removedIds, then store \a stored.
+    using ApplyFn = std::function<void(const QVector<int32_t>&              removedIds,
+                                       const QVector<hmi::InspectionTarget>& stored)>;
+
+    TargetEditCommand(const QString&                  text,
+                      QVector<hmi::InspectionTarget>  before,
+                      QVector<hmi::InspectionTarget>  after,
+                      ApplyFn                         apply,
+                      QUndoCommand*                   parent = nullptr);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    void transition(const QVector<hmi::InspectionTarget>& from,
+                    const QVector<hmi::InspectionTarget>& to) const;
+
+    QVector<hmi::InspectionTarget> m_before;
+    QVector<hmi::InspectionTarget> m_after;
+    ApplyFn                        m_apply;
+};
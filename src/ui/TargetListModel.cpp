@@ -0,0 +1,201 @@
+// src/ui/TargetListModel.cpp
+
+#include "TargetListModel.h"
+
+#include <algorithm>
+#include <utility>
+
+TargetListModel::TargetListModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+// ---------------------------------------------------------------------------
+// QAbstractListModel
+// ---------------------------------------------------------------------------
+
+int TargetListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant TargetListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+
+    const Row& row = m_rows[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+        return row.text;
+    case PointIdRole:
+        return row.pointId;
+    default:
+        return QVariant();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Editing
+// ---------------------------------------------------------------------------
+
+void TargetListModel::addTarget(const hmi::InspectionTarget& target)
+{
+    if (contains(target.pointId)) {
+        updateTarget(target);
+        return;
+    }
+
+    const int row = m_rows.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.append(Row{ target.pointId, displayText(target) });
+    m_rowOf.insert(target.pointId, row);
+    endInsertRows();
+}
+
+void TargetListModel::appendTargets(const QVector<hmi::InspectionTarget>& targets)
+{
+    // Known IDs are updated in place (one dataChanged over the touched
+    // range); the rest become one contiguous insert.
+    QVector<Row> fresh;
+    QHash<int32_t, int> freshIndex;
+    int changedFirst = m_rows.size();
+    int changedLast  = -1;
+    for (const auto& target : targets) {
+        const int row = rewriteRow(target);
+        if (row >= 0) {
+            changedFirst = std::min(changedFirst, row);
+            changedLast  = std::max(changedLast, row);
+            continue;
+        }
+        auto dup = freshIndex.constFind(target.pointId);
+        if (dup != freshIndex.constEnd()) {
+            fresh[dup.value()].text = displayText(target);   // last one wins
+            continue;
+        }
+        freshIndex.insert(target.pointId, fresh.size());
+        fresh.append(Row{ target.pointId, displayText(target) });
+    }
+    if (changedLast >= 0) {
+        emit dataChanged(index(changedFirst), index(changedLast), { Qt::DisplayRole });
+    }
+    if (fresh.isEmpty()) {
+        return;
+    }
+
+    const int first = m_rows.size();
+    beginInsertRows(QModelIndex(), first, first + fresh.size() - 1);
+    m_rows.reserve(first + fresh.size());
+    for (Row& row : fresh) {
+        m_rowOf.insert(row.pointId, m_rows.size());
+        m_rows.append(std::move(row));
+    }
+    endInsertRows();
+}
+
+void TargetListModel::replaceTargets(const QVector<hmi::InspectionTarget>& targets)
+{
+    beginResetModel();
+    m_rows.clear();
+    m_rowOf.clear();
+    m_rows.reserve(targets.size());
+    for (const auto& target : targets) {
+        auto it = m_rowOf.constFind(target.pointId);
+        if (it != m_rowOf.constEnd()) {
+            m_rows[it.value()].text = displayText(target);
+            continue;
+        }
+        m_rowOf.insert(target.pointId, m_rows.size());
+        m_rows.append(Row{ target.pointId, displayText(target) });
+    }
+    endResetModel();
+}
+
+void TargetListModel::updateTarget(const hmi::InspectionTarget& target)
+{
+    const int row = rewriteRow(target);
+    if (row >= 0) {
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx, { Qt::DisplayRole });
+    }
+}
+
+void TargetListModel::removeTarget(int32_t pointId)
+{
+    const int row = rowOf(pointId);
+    if (row < 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_rows.remove(row);
+    m_rowOf.remove(pointId);
+    rebuildIndex(row);
+    endRemoveRows();
+}
+
+void TargetListModel::removeTargets(const QVector<int32_t>& pointIds)
+{
+    QVector<int> rows;
+    rows.reserve(pointIds.size());
+    for (int32_t pointId : pointIds) {
+        const int row = rowOf(pointId);
+        if (row >= 0) rows.append(row);
+    }
+    if (rows.isEmpty()) {
+        return;
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // Back to front, so the rows of earlier runs keep their numbers.
+    for (int i = rows.size() - 1; i >= 0; --i) {
+        const int last = rows[i];
+        while (i > 0 && rows[i - 1] == rows[i] - 1) --i;
+        const int first = rows[i];
+
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int row = first; row <= last; ++row) {
+            m_rowOf.remove(m_rows[row].pointId);
+        }
+        m_rows.remove(first, last - first + 1);
+        endRemoveRows();
+    }
+    rebuildIndex(rows.first());
+}
+
+void TargetListModel::clear()
+{
+    beginResetModel();
+    m_rows.clear();
+    m_rowOf.clear();
+    endResetModel();
+}
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+QString TargetListModel::displayText(const hmi::InspectionTarget& target)
+{
+    return tr("点 %1 (%2)")
+        .arg(target.pointId)
+        .arg(target.groupId.isEmpty() ? tr("未分组") : target.groupId);
+}
+
+int TargetListModel::rewriteRow(const hmi::InspectionTarget& target)
+{
+    const int row = rowOf(target.pointId);
+    if (row >= 0) {
+        m_rows[row].text = displayText(target);
+    }
+    return row;
+}
+
+void TargetListModel::rebuildIndex(int fromRow)
+{
+    for (int row = fromRow; row < m_rows.size(); ++row) {
+        m_rowOf[m_rows[row].pointId] = row;
+    }
+}
@@ -0,0 +1,74 @@
+// src/ui/TargetListModel.h
+//
+// TargetListModel – list model behind ProjectPanel's point list.
+//
+// One row per InspectionTarget, in insertion order.  Single edits are
+// ordinary row inserts / removals; appendTargets() lands a whole batch as one
+// rowsInserted() and replaceTargets() as one model reset, so importing a
+// thousand points costs one view layout instead of a thousand.
+// removeTargets() removes each run of adjacent rows as one rowsRemoved(), so
+// undoing an imported batch is a single removal as well.
+//
+// Thread safety: GUI thread only.
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class TargetListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Role {
+        PointIdRole = Qt::UserRole,   ///< int32_t point ID
+    };
+
+    explicit TargetListModel(QObject* parent = nullptr);
+
+    int      rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /// Append \a target, or update its row if the ID is already listed.
+    void addTarget(const hmi::InspectionTarget& target);
+
+    /// Append all new targets as one insertion; known IDs are updated.
+    void appendTargets(const QVector<hmi::InspectionTarget>& targets);
+
+    /// Replace every row (one model reset).
+    void replaceTargets(const QVector<hmi::InspectionTarget>& targets);
+
+    void updateTarget(const hmi::InspectionTarget& target);
+    void removeTarget(int32_t pointId);
+
+    /// Remove the rows of \a pointIds, one rowsRemoved() per contiguous run.
+    void removeTargets(const QVector<int32_t>& pointIds);
+
+    void clear();
+
+    /// Row of \a pointId, or -1.
+    [[nodiscard]] int rowOf(int32_t pointId) const { return m_rowOf.value(pointId, -1); }
+    [[nodiscard]] bool contains(int32_t pointId) const { return m_rowOf.contains(pointId); }
+
+private:
+    struct Row {
+        int32_t pointId = 0;
+        QString text;       ///< pre-formatted display text
+    };
+
+    QVector<Row>        m_rows;
+    QHash<int32_t, int> m_rowOf;    ///< point ID -> row
+
+    static QString displayText(const hmi::InspectionTarget& target);
+
+    /// Rewrite the row of an already listed \a target without signalling;
+    /// returns the row, or -1 if the ID is not listed.
+    int rewriteRow(const hmi::InspectionTarget& target);
+
+    void rebuildIndex(int fromRow);
+};
@@ -4,6 +4,7 @@
 
 #include <QAction>
 #include <QInputDialog>
+#include <QKeySequence>
 #include <QLabel>
 #include <QLineEdit>
 #include <QStyle>
@@ -27,10 +28,32 @@ void TopBar::setupActions()
     m_actNewProject->setIcon(style()->standardIcon(QStyle::SP_FileIcon));
     connect(m_actNewProject, &QAction::triggered, this, &TopBar::newProjectRequested);
 
+    m_actOpenProject = addAction(tr("打开"));
+    m_actOpenProject->setIcon(style()->standardIcon(QStyle::SP_DialogOpenButton));
+    connect(m_actOpenProject, &QAction::triggered, this, &TopBar::openProjectRequested);
+
+    m_actSaveProject = addAction(tr("保存"));
+    m_actSaveProject->setIcon(style()->standardIcon(QStyle::SP_DialogSaveButton));
+    m_actSaveProject->setShortcut(QKeySequence::Save);
+    connect(m_actSaveProject, &QAction::triggered, this, &TopBar::saveProjectRequested);
+
     m_actImportCad = addAction(tr("导入 CAD"));
     m_actImportCad->setIcon(style()->standardIcon(QStyle::SP_DirOpenIcon));
     connect(m_actImportCad, &QAction::triggered, this, &TopBar::importCadRequested);
 
+    // Edit group
+    m_actUndo = addAction(tr("撤销"));
+    m_actUndo->setIcon(style()->standardIcon(QStyle::SP_ArrowBack));
+    m_actUndo->setShortcut(QKeySequence::Undo);
+    m_actUndo->setEnabled(false);
+    connect(m_actUndo, &QAction::triggered, this, &TopBar::undoRequested);
+
+    m_actRedo = addAction(tr("重做"));
+    m_actRedo->setIcon(style()->standardIcon(QStyle::SP_ArrowForward));
+    m_actRedo->setShortcut(QKeySequence::Redo);
+    m_actRedo->setEnabled(false);
+    connect(m_actRedo, &QAction::triggered, this, &TopBar::redoRequested);
+
     addSeparator();
 
     // Model label
@@ -111,3 +134,12 @@ void TopBar::setModelLoaded(bool loaded, const QString& filename)
         m_modelLabel->setStyleSheet("QLabel { color: gray; margin: 0 8px; }");
     }
 }
+
+void TopBar::setUndoState(bool canUndo, const QString& undoText,
+                          bool canRedo, const QString& redoText)
+{
+    m_actUndo->setEnabled(canUndo);
+    m_actUndo->setToolTip(canUndo ? tr("撤销: %1").arg(undoText) : tr("撤销"));
+    m_actRedo->setEnabled(canRedo);
+    m_actRedo->setToolTip(canRedo ? tr("重做: %1").arg(redoText) : tr("重做"));
+}
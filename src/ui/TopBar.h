@@ -21,16 +21,29 @@ public:
     void setConnectionState(bool connected);
     void setModelLoaded(bool loaded, const QString& filename = {});
 
+    /// Enable the undo / redo actions; \a undoText / \a redoText name the
+    /// step in their tool tips.
+    void setUndoState(bool canUndo, const QString& undoText,
+                      bool canRedo, const QString& redoText);
+
 signals:
     void newProjectRequested();
+    void openProjectRequested();
+    void saveProjectRequested();
     void importCadRequested();
+    void undoRequested();
+    void redoRequested();
     void connectRequested(const QString& address);
     void disconnectRequested();
     void switchModeRequested();
 
 private:
     QAction*   m_actNewProject  = nullptr;
+    QAction*   m_actOpenProject = nullptr;
+    QAction*   m_actSaveProject = nullptr;
     QAction*   m_actImportCad   = nullptr;
+    QAction*   m_actUndo        = nullptr;
+    QAction*   m_actRedo        = nullptr;
     QAction*   m_actConnect     = nullptr;
     QAction*   m_actDisconnect  = nullptr;
     QAction*   m_actSwitchMode  = nullptr;
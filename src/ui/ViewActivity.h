@@ -0,0 +1,100 @@
+// src/ui/ViewActivity.h
+//
+// ViewActivity – the active / idle state of a top-level window that renders
+// the gateway streams (MainWindow, OperatorWindow).
+//
+// main.cpp builds both windows up front and only one is on screen at a
+// time.  Both stay connected to systemStateReceived / inspectionEventReceived,
+// but while a window is idle (hidden or minimised) its handlers only hold
+// the snapshots without touching any widget:
+//   - system state: the latest TaskStatusSnapshot replaces the previous one
+//     (one pointer copy; every TaskStatus is a complete state)
+//   - events: appended to a bounded RingBuffer of snapshots, oldest
+//     overwritten first once capacity() is reached
+// activate() replays the held events oldest first, then applies the latest
+// status once, so the window catches up in a single step when it comes back
+// on screen.
+//
+// Thread safety: none; GUI thread only.
+
+#pragma once
+
+#include "core/RingBuffer.h"
+#include "core/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+class ViewActivity
+{
+public:
+    /// Matches EventLogModel::kDefaultCapacity, the longest event list a
+    /// window keeps, so an idle window loses no event it would still show.
+    static constexpr std::size_t kDefaultEventCapacity = 2000;
+
+    /// Delivery counters since construction.
+    struct Stats {
+        uint64_t heldStatuses  = 0;   ///< statuses received while idle
+        uint64_t droppedEvents = 0;   ///< events overwritten while idle
+        uint64_t activations   = 0;
+    };
+
+    explicit ViewActivity(std::size_t eventCapacity = kDefaultEventCapacity)
+        : m_events(eventCapacity)
+    {}
+
+    [[nodiscard]] bool  isActive() const noexcept { return m_active; }
+    [[nodiscard]] Stats stats() const noexcept { return m_stats; }
+
+    /// Returns true when the window is active and should apply \a status
+    /// now; otherwise holds it as the latest status.
+    bool offerStatus(const hmi::TaskStatusSnapshot& status)
+    {
+        if (m_active) return true;
+        m_status = status;
+        ++m_stats.heldStatuses;
+        return false;
+    }
+
+    /// Returns true when the window is active and should apply \a event
+    /// now; otherwise queues it for activate().
+    bool offerEvent(const hmi::InspectionEventSnapshot& event)
+    {
+        if (m_active) return true;
+        if (m_events.push_back(event)) ++m_stats.droppedEvents;
+        return false;
+    }
+
+    /// Become active: \a applyEvent(const hmi::InspectionEvent&) for every
+    /// held event, oldest first, then \a applyStatus(const hmi::TaskStatus&)
+    /// once with the latest held status.  No-op when already active.
+    template <typename StatusFn, typename EventFn>
+    void activate(StatusFn&& applyStatus, EventFn&& applyEvent)
+    {
+        if (m_active) return;
+        m_active = true;
+        ++m_stats.activations;
+
+        for (std::size_t i = 0; i < m_events.size(); ++i) {
+            applyEvent(*m_events[i]);
+        }
+        m_events.clear();
+
+        if (m_status) {
+            const hmi::TaskStatusSnapshot status = std::move(*m_status);
+            m_status.reset();
+            applyStatus(*status);
+        }
+    }
+
+    /// Become idle; later offers are held until activate().
+    void deactivate() noexcept { m_active = false; }
+
+private:
+    bool                                        m_active = false;
+    std::optional<hmi::TaskStatusSnapshot>      m_status;
+    hmi::RingBuffer<hmi::InspectionEventSnapshot> m_events;
+    Stats                                       m_stats;
+};
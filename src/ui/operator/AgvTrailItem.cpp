@@ -0,0 +1,96 @@
+// src/ui/operator/AgvTrailItem.cpp
+
+#include "AgvTrailItem.h"
+
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QPainter>
+#include <QPen>
+#include <QStyleOptionGraphicsItem>
+#include <QVector>
+
+namespace {
+
+const QColor kTrailColor(255, 87, 34, 160);   // AGV orange, translucent
+constexpr double kTrailWidthPx = 2.0;
+
+} // anonymous namespace
+
+AgvTrailItem::AgvTrailItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+{
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+void AgvTrailItem::setExtent(const QRectF& extent)
+{
+    prepareGeometryChange();
+    m_extent = extent;
+}
+
+void AgvTrailItem::setCapacity(std::size_t points)
+{
+    m_points.setCapacity(points);
+    update();
+}
+
+void AgvTrailItem::append(const QPointF& point)
+{
+    if (m_points.full() && m_points.size() >= 2) {
+        updateSegment(m_points[0], m_points[1]);
+    }
+    const QPointF previous = m_points.empty() ? point : m_points[m_points.size() - 1];
+    m_points.push_back(point);
+    updateSegment(previous, point);
+}
+
+void AgvTrailItem::clear()
+{
+    m_points.clear();
+    update();
+}
+
+void AgvTrailItem::updateSegment(const QPointF& a, const QPointF& b)
+{
+    // The pen is cosmetic: convert its width back to scene units.
+    double pad = kTrailWidthPx;
+    if (scene() && !scene()->views().isEmpty()) {
+        const double scale = scene()->views().first()->transform().m11();
+        if (scale > 0.0) { pad = (kTrailWidthPx + 1.0) / scale; }
+    }
+    update(QRectF(a, b).normalized().adjusted(-pad, -pad, pad, pad));
+}
+
+QRectF AgvTrailItem::boundingRect() const
+{
+    return m_extent;
+}
+
+void AgvTrailItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                         QWidget* /*widget*/)
+{
+    if (m_points.size() < 2) { return; }
+
+    QPen pen(kTrailColor, kTrailWidthPx, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+    pen.setCosmetic(true);
+    painter->setPen(pen);
+
+    // Draw the runs of segments that touch the exposed rect.
+    const QRectF exposed = option->exposedRect;
+    QVector<QPointF> run;
+    run.reserve(int(m_points.size()));
+    for (std::size_t i = 1; i < m_points.size(); ++i) {
+        const QPointF& a = m_points[i - 1];
+        const QPointF& b = m_points[i];
+        if (exposed.intersects(QRectF(a, b).normalized().adjusted(-1, -1, 1, 1))) {
+            if (run.isEmpty()) { run.append(a); }
+            run.append(b);
+        } else if (!run.isEmpty()) {
+            painter->drawPolyline(run.constData(), run.size());
+            run.clear();
+        }
+    }
+    if (run.size() >= 2) {
+        painter->drawPolyline(run.constData(), run.size());
+    }
+}
@@ -0,0 +1,44 @@
+// src/ui/operator/AgvTrailItem.h
+//
+// AgvTrailItem – the recent AGV track on the nav map, kept in a fixed-size
+// hmi::RingBuffer of scene points.  append() only invalidates the new
+// segment (and the one that fell off the tail), so a 30 Hz pose stream does
+// not repaint the map below the whole trail.
+
+#pragma once
+
+#include "core/RingBuffer.h"
+
+#include <QGraphicsItem>
+#include <QPointF>
+#include <QRectF>
+
+class AgvTrailItem : public QGraphicsItem
+{
+public:
+    static constexpr std::size_t kDefaultCapacity = 4096;
+
+    explicit AgvTrailItem(QGraphicsItem* parent = nullptr);
+
+    /// Area the trail may cover (the map rect, scene coordinates).
+    void setExtent(const QRectF& extent);
+
+    void setCapacity(std::size_t points);
+
+    /// Append the newest point; the oldest drops off when full.
+    void append(const QPointF& point);
+    void clear();
+
+    [[nodiscard]] std::size_t size() const { return m_points.size(); }
+
+    QRectF boundingRect() const override;
+    void   paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                 QWidget* widget = nullptr) override;
+
+private:
+    /// Repaint the segment a–b, padded for the cosmetic pen.
+    void updateSegment(const QPointF& a, const QPointF& b);
+
+    hmi::RingBuffer<QPointF> m_points{ kDefaultCapacity };
+    QRectF                   m_extent;
+};
@@ -0,0 +1,138 @@
+// src/ui/operator/CaptureDecoder.cpp
+
+#include "CaptureDecoder.h"
+
+#include <QBuffer>
+#include <QFont>
+#include <QImageReader>
+#include <QPainter>
+#include <QThread>
+
+#include <algorithm>
+#include <utility>
+
+// ---------------------------------------------------------------------------
+// Construction
+// ---------------------------------------------------------------------------
+
+CaptureDecoder::CaptureDecoder(int threads, QObject* parent)
+    : QObject(parent)
+{
+    if (threads <= 0) {
+        threads = std::max(1, QThread::idealThreadCount() - 1);
+    }
+    m_pool.setMaxThreadCount(threads);
+}
+
+CaptureDecoder::~CaptureDecoder()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+// ---------------------------------------------------------------------------
+// Queueing
+// ---------------------------------------------------------------------------
+
+void CaptureDecoder::decode(Request request)
+{
+    const int generation = m_generation;
+    m_pool.start([this, generation, request = std::move(request)]() {
+        QImage image = render(request);
+        // The pool is drained in the destructor, so `this` outlives the task;
+        // the queued call is dropped by Qt if the decoder is gone by then.
+        QMetaObject::invokeMethod(this,
+            [this, generation, key = request.key, image = std::move(image)]() {
+                if (generation == m_generation) {
+                    emit decoded(key, image);
+                }
+            }, Qt::QueuedConnection);
+    });
+}
+
+void CaptureDecoder::cancelAll()
+{
+    m_pool.clear();
+    ++m_generation;
+}
+
+// ---------------------------------------------------------------------------
+// Rendering (worker thread)
+// ---------------------------------------------------------------------------
+
+QImage CaptureDecoder::render(const Request& request)
+{
+    QBuffer buffer;
+    buffer.setData(request.encoded);
+    if (!buffer.open(QIODevice::ReadOnly)) {
+        return QImage();
+    }
+
+    QImageReader reader(&buffer);
+    const QSize native = reader.size();   // from the header, no decode
+
+    // Let the codec scale while decoding (DCT scaling for JPEG).
+    const QSize& target = request.targetSize;
+    if (target.isValid() && native.isValid()
+        && (native.width() > target.width() || native.height() > target.height())) {
+        reader.setScaledSize(native.scaled(target, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return QImage();
+    }
+
+    // Codecs without scaled decode, or a header without a size.
+    if (target.isValid()
+        && (image.width() > target.width() || image.height() > target.height())) {
+        image = image.scaled(target, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    // Formats QPixmap::fromImage() can upload without another conversion.
+    const QImage::Format fast = image.hasAlphaChannel()
+        ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32;
+    if (image.format() != fast) {
+        image = image.convertToFormat(fast);
+    }
+
+    if (request.defects.isEmpty()) {
+        return image;
+    }
+
+    // Bounding boxes are in source-frame pixels.
+    const QSize ref = request.sourceSize.isValid() ? request.sourceSize
+                    : native.isValid()             ? native
+                                                   : image.size();
+    const double sx = static_cast<double>(image.width())  / ref.width();
+    const double sy = static_cast<double>(image.height()) / ref.height();
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QFont font = painter.font();
+    font.setPointSize(8);
+    font.setBold(true);
+    painter.setFont(font);
+
+    for (const auto& defect : request.defects) {
+        if (!defect.hasDefect) {
+            continue;
+        }
+
+        const QRectF rect(defect.bbox.x * sx, defect.bbox.y * sy,
+                          defect.bbox.w * sx, defect.bbox.h * sy);
+        painter.setPen(QPen(QColor("#ff0000"), 2, Qt::SolidLine));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(rect);
+
+        // Confidence label above the box (inside the image near the top).
+        const QString label = QStringLiteral("%1%").arg(static_cast<int>(defect.confidence * 100));
+        const QRectF labelRect(rect.x(), std::max(0.0, rect.y() - 16), 40, 14);
+        painter.fillRect(labelRect, QColor(255, 0, 0, 180));
+        painter.setPen(Qt::white);
+        painter.drawText(labelRect, Qt::AlignCenter, label);
+    }
+
+    return image;
+}
@@ -0,0 +1,66 @@
+// src/ui/operator/CaptureDecoder.h
+//
+// CaptureDecoder – decodes capture JPEGs and draws the defect overlay on a
+// private thread pool so the operator window never blocks on image work.
+//
+// Each request is decoded straight to its display size: QImageReader's
+// scaled-size path lets the JPEG plugin use libjpeg DCT scaling (1/2, 1/4,
+// 1/8), so a 20 MP frame shown at 400 px is never expanded at full
+// resolution.  Defect bounding boxes are given in source-frame pixels and
+// are scaled to the decoded size before drawing.
+//
+// The worker produces a QImage; only QPixmap::fromImage() is left for the
+// GUI thread (QPixmap is not usable off the GUI thread).
+//
+// Thread safety: decode()/cancelAll() are GUI-thread only; decoded() is
+// emitted on the GUI thread.
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <QByteArray>
+#include <QImage>
+#include <QObject>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+class CaptureDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Request {
+        QString                    key;          ///< echoed by decoded()
+        QByteArray                 encoded;      ///< JPEG/PNG bytes
+        QSize                      targetSize;   ///< fit inside, keep aspect; invalid = native
+        QSize                      sourceSize;   ///< frame the bbox coordinates refer to
+        QVector<hmi::DefectResult> defects;      ///< empty = no overlay
+    };
+
+    /// \a threads workers (0 → idealThreadCount - 1, at least 1).
+    explicit CaptureDecoder(int threads = 0, QObject* parent = nullptr);
+
+    /// Drops queued work and waits for running decodes.
+    ~CaptureDecoder() override;
+
+    /// Queue \a request.  decoded() follows unless cancelAll() intervenes.
+    void decode(Request request);
+
+    /// Drop queued requests and discard results of running ones.
+    void cancelAll();
+
+    /// Decode and render synchronously on the calling thread.  Returns a
+    /// null image when \a request.encoded cannot be decoded.
+    static QImage render(const Request& request);
+
+signals:
+    /// \a image is null when the data could not be decoded.
+    void decoded(QString key, QImage image);
+
+private:
+    QThreadPool m_pool;
+    int         m_generation = 0;   ///< bumped by cancelAll(); GUI thread only
+};
@@ -0,0 +1,67 @@
+// src/ui/operator/CaptureGalleryDelegate.cpp
+
+#include "CaptureGalleryDelegate.h"
+#include "CaptureGalleryModel.h"
+
+#include <QPainter>
+#include <QPixmap>
+
+CaptureGalleryDelegate::CaptureGalleryDelegate(const QSize& thumbnailSize, QObject* parent)
+    : QStyledItemDelegate(parent)
+    , m_thumbSize(thumbnailSize)
+{
+}
+
+void CaptureGalleryDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option,
+                                   const QModelIndex& index) const
+{
+    painter->save();
+
+    const QRect cell = option.rect;
+    const bool selected  = option.state & QStyle::State_Selected;
+    const bool hasDefect = index.data(CaptureGalleryModel::HasDefectRole).toBool();
+
+    // Background: selection, then defect highlight (light red)
+    if (selected) {
+        painter->fillRect(cell, option.palette.highlight());
+    } else if (hasDefect) {
+        painter->fillRect(cell, QColor("#ffe5e5"));
+    }
+
+    // Thumbnail, centred in the icon area
+    const QRect iconRect(cell.x() + (cell.width() - m_thumbSize.width()) / 2,
+                         cell.y() + kPadding,
+                         m_thumbSize.width(), m_thumbSize.height());
+    const QPixmap pixmap = index.data(Qt::DecorationRole).value<QPixmap>();
+    if (!pixmap.isNull()) {
+        const QSize fitted = pixmap.size().scaled(iconRect.size(), Qt::KeepAspectRatio);
+        const QRect target(iconRect.x() + (iconRect.width() - fitted.width()) / 2,
+                           iconRect.y() + (iconRect.height() - fitted.height()) / 2,
+                           fitted.width(), fitted.height());
+        painter->drawPixmap(target, pixmap);
+    }
+
+    // Caption
+    const QRect textRect(cell.x() + kPadding, iconRect.bottom() + kPadding,
+                         cell.width() - 2 * kPadding,
+                         cell.bottom() - iconRect.bottom() - kPadding);
+    QColor textColor = option.palette.color(QPalette::Text);
+    if (selected) {
+        textColor = option.palette.color(QPalette::HighlightedText);
+    } else if (hasDefect) {
+        textColor = QColor("#1e1e1e");   // dark text on the light red cell
+    }
+    painter->setPen(textColor);
+    const QString text = option.fontMetrics.elidedText(
+        index.data(Qt::DisplayRole).toString(), Qt::ElideRight, textRect.width());
+    painter->drawText(textRect, Qt::AlignHCenter | Qt::AlignTop, text);
+
+    painter->restore();
+}
+
+QSize CaptureGalleryDelegate::sizeHint(const QStyleOptionViewItem& option,
+                                       const QModelIndex& /*index*/) const
+{
+    return QSize(m_thumbSize.width() + 2 * kPadding,
+                 m_thumbSize.height() + option.fontMetrics.height() + 3 * kPadding);
+}
@@ -0,0 +1,28 @@
+// src/ui/operator/CaptureGalleryDelegate.h
+//
+// CaptureGalleryDelegate – paints one gallery cell (thumbnail + caption)
+// straight from CaptureGalleryModel roles.  Every cell has the same size, so
+// the view can lay out thousands of rows without asking for their data.
+
+#pragma once
+
+#include <QSize>
+#include <QStyledItemDelegate>
+
+class CaptureGalleryDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureGalleryDelegate(const QSize& thumbnailSize, QObject* parent = nullptr);
+
+    void  paint(QPainter* painter, const QStyleOptionViewItem& option,
+                const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option,
+                   const QModelIndex& index) const override;
+
+private:
+    static constexpr int kPadding = 4;
+
+    QSize m_thumbSize;
+};
@@ -0,0 +1,278 @@
+// src/ui/operator/CaptureGalleryModel.cpp
+
+#include "CaptureGalleryModel.h"
+#include "CaptureDecoder.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+int pixmapCostKb(const QPixmap& pixmap)
+{
+    const qint64 bytes = static_cast<qint64>(pixmap.width()) * pixmap.height()
+                       * pixmap.depth() / 8;
+    return static_cast<int>(std::max<qint64>(1, bytes / 1024));
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Construction
+// ---------------------------------------------------------------------------
+
+CaptureGalleryModel::CaptureGalleryModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_thumbs(kDefaultThumbnailBudgetKb)
+{
+    m_placeholder = QPixmap(m_thumbSize);
+    m_placeholder.fill(Qt::darkGray);
+
+    m_decoder = new CaptureDecoder(0, this);
+    connect(m_decoder, &CaptureDecoder::decoded,
+            this, &CaptureGalleryModel::onThumbnailDecoded);
+}
+
+// ---------------------------------------------------------------------------
+// QAbstractListModel
+// ---------------------------------------------------------------------------
+
+int CaptureGalleryModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_captures.size();
+}
+
+QVariant CaptureGalleryModel::data(const QModelIndex& index, int role) const
+{
+    const Capture* capture = captureAt(index.row());
+    if (!index.isValid() || !capture) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return QStringLiteral("点位 %1").arg(capture->pointId);
+
+    case Qt::DecorationRole: {
+        if (const QPixmap* pm = m_thumbs.object(capture->captureId)) {
+            return *pm;
+        }
+        requestThumbnail(*capture);
+        return m_placeholder;
+    }
+
+    case CaptureIdRole:   return capture->captureId;
+    case PointIdRole:     return capture->pointId;
+    case HasDefectRole:   return !capture->defects.isEmpty();
+    case DefectCountRole: return static_cast<int>(capture->defects.size());
+    default:              return QVariant();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Row updates
+// ---------------------------------------------------------------------------
+
+void CaptureGalleryModel::addCapture(const Capture& capture)
+{
+    const int existing = rowOf(capture.captureId);
+    if (existing >= 0) {
+        m_rowOfMedia.remove(m_captures[existing].image.media.mediaId);
+        m_captures[existing] = capture;
+        if (!capture.image.media.mediaId.isEmpty()) {
+            m_rowOfMedia.insert(capture.image.media.mediaId, existing);
+        }
+        m_thumbs.remove(capture.captureId);
+        const QModelIndex idx = index(existing);
+        emit dataChanged(idx, idx);
+        return;
+    }
+
+    const int row = m_captures.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_captures.append(capture);
+    m_rowOfCapture.insert(capture.captureId, row);
+    if (!capture.image.media.mediaId.isEmpty()) {
+        m_rowOfMedia.insert(capture.image.media.mediaId, row);
+    }
+    endInsertRows();
+}
+
+void CaptureGalleryModel::appendCaptures(const QVector<Capture>& captures)
+{
+    QVector<Capture> fresh;
+    fresh.reserve(captures.size());
+    for (const Capture& capture : captures) {
+        if (rowOf(capture.captureId) >= 0) {
+            addCapture(capture);
+        } else {
+            fresh.append(capture);
+        }
+    }
+    if (fresh.isEmpty()) {
+        return;
+    }
+
+    const int first = m_captures.size();
+    beginInsertRows(QModelIndex(), first, first + fresh.size() - 1);
+    for (Capture& capture : fresh) {
+        const int row = m_captures.size();
+        m_rowOfCapture.insert(capture.captureId, row);
+        if (!capture.image.media.mediaId.isEmpty()) {
+            m_rowOfMedia.insert(capture.image.media.mediaId, row);
+        }
+        m_captures.append(std::move(capture));
+    }
+    endInsertRows();
+}
+
+void CaptureGalleryModel::setCaptures(const QVector<Capture>& captures)
+{
+    beginResetModel();
+    resetThumbnails();
+    m_captures = captures;
+    rebuildIndex();
+    endResetModel();
+}
+
+void CaptureGalleryModel::clear()
+{
+    beginResetModel();
+    resetThumbnails();
+    m_captures.clear();
+    rebuildIndex();
+    endResetModel();
+}
+
+void CaptureGalleryModel::rebuildIndex()
+{
+    m_rowOfCapture.clear();
+    m_rowOfMedia.clear();
+    for (int row = 0; row < m_captures.size(); ++row) {
+        const Capture& c = m_captures[row];
+        m_rowOfCapture.insert(c.captureId, row);
+        if (!c.image.media.mediaId.isEmpty()) {
+            m_rowOfMedia.insert(c.image.media.mediaId, row);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Lookups
+// ---------------------------------------------------------------------------
+
+int CaptureGalleryModel::rowOf(const QString& captureId) const
+{
+    return m_rowOfCapture.value(captureId, -1);
+}
+
+int CaptureGalleryModel::rowOfMedia(const QString& mediaId) const
+{
+    return m_rowOfMedia.value(mediaId, -1);
+}
+
+const CaptureGalleryModel::Capture* CaptureGalleryModel::captureAt(int row) const
+{
+    return (row >= 0 && row < m_captures.size()) ? &m_captures[row] : nullptr;
+}
+
+QPixmap CaptureGalleryModel::cachedThumbnail(int row) const
+{
+    const Capture* capture = captureAt(row);
+    if (!capture) {
+        return QPixmap();
+    }
+    const QPixmap* pm = m_thumbs.object(capture->captureId);
+    return pm ? *pm : QPixmap();
+}
+
+// ---------------------------------------------------------------------------
+// Thumbnails
+// ---------------------------------------------------------------------------
+
+void CaptureGalleryModel::setThumbnailSize(const QSize& size)
+{
+    if (size == m_thumbSize || !size.isValid()) {
+        return;
+    }
+    m_thumbSize = size;
+    m_placeholder = QPixmap(m_thumbSize);
+    m_placeholder.fill(Qt::darkGray);
+    resetThumbnails();
+    if (!m_captures.isEmpty()) {
+        emit dataChanged(index(0), index(m_captures.size() - 1), { Qt::DecorationRole });
+    }
+}
+
+void CaptureGalleryModel::setThumbnailBudgetKb(int kb)
+{
+    m_thumbs.setMaxCost(std::max(0, kb));
+}
+
+void CaptureGalleryModel::requestThumbnail(const Capture& capture) const
+{
+    if (m_decoding.contains(capture.captureId)) {
+        return;
+    }
+    if (capture.image.thumbnailJpeg.isEmpty()) {
+        // Not inlined: fetch the thumbnail media, or the full frame (decoded
+        // straight to thumbnail size), once per row.
+        const hmi::MediaRef& source = capture.image.thumbnailMedia.mediaId.isEmpty()
+                                    ? capture.image.media : capture.image.thumbnailMedia;
+        if (!source.mediaId.isEmpty()) {
+            if (!m_fetching.contains(source.mediaId)) {
+                m_fetching.insert(source.mediaId, capture.captureId);
+                emit const_cast<CaptureGalleryModel*>(this)->thumbnailMediaRequested(source);
+            }
+            return;
+        }
+        // Nothing to decode – cache the placeholder so we do not ask again.
+        m_thumbs.insert(capture.captureId, new QPixmap(m_placeholder),
+                        pixmapCostKb(m_placeholder));
+        return;
+    }
+    m_decoding.insert(capture.captureId);
+    m_decoder->decode({ capture.captureId, capture.image.thumbnailJpeg,
+                        m_thumbSize, capture.frameSize(), capture.defects });
+}
+
+bool CaptureGalleryModel::setThumbnailSource(const QString& mediaId, const QByteArray& encoded)
+{
+    const auto it = m_fetching.constFind(mediaId);
+    if (it == m_fetching.constEnd()) {
+        return false;
+    }
+    const QString captureId = it.value();
+    m_fetching.erase(it);
+
+    const Capture* capture = captureAt(rowOf(captureId));
+    if (capture) {
+        m_decoding.insert(captureId);
+        m_decoder->decode({ captureId, encoded, m_thumbSize,
+                            capture->frameSize(), capture->defects });
+    }
+    return true;
+}
+
+void CaptureGalleryModel::onThumbnailDecoded(const QString& captureId, const QImage& image)
+{
+    m_decoding.remove(captureId);
+    const int row = rowOf(captureId);
+    if (row < 0) {
+        return;
+    }
+
+    const QPixmap pixmap = image.isNull() ? m_placeholder : QPixmap::fromImage(image);
+    m_thumbs.insert(captureId, new QPixmap(pixmap), pixmapCostKb(pixmap));
+
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx, { Qt::DecorationRole });
+}
+
+void CaptureGalleryModel::resetThumbnails()
+{
+    m_decoder->cancelAll();
+    m_decoding.clear();
+    m_fetching.clear();
+    m_thumbs.clear();
+}
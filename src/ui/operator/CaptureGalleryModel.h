@@ -0,0 +1,119 @@
+// src/ui/operator/CaptureGalleryModel.h
+//
+// CaptureGalleryModel – list model behind the ResultPanel gallery.
+//
+// Rows hold only the capture metadata and the small encoded thumbnail JPEG.
+// Decoded thumbnails are produced lazily: data(Qt::DecorationRole) is only
+// asked for rows the view actually paints, and a miss queues a decode on a
+// CaptureDecoder and returns a placeholder; the row is refreshed through
+// dataChanged() once the pixmap is ready.  Decoded thumbnails live in a
+// QCache bounded by decoded size, so scrolling through a long task keeps
+// memory flat.
+//
+// Rows listed without an inlined thumbnail (metadata-only ListCaptures) ask
+// for one through thumbnailMediaRequested() when first painted – the
+// thumbnail media if the gateway offers one, else the full image – and
+// decode whatever setThumbnailSource() is handed to thumbnail size.
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <QAbstractListModel>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QVector>
+
+class CaptureDecoder;
+
+class CaptureGalleryModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Role {
+        CaptureIdRole = Qt::UserRole + 1,   ///< QString
+        PointIdRole,                        ///< int
+        HasDefectRole,                      ///< bool
+        DefectCountRole,                    ///< int
+    };
+
+    struct Capture {
+        QString                    captureId;
+        int32_t                    pointId = 0;
+        hmi::ImageRef              image;
+        QVector<hmi::DefectResult> defects;
+
+        /// Full-frame size the bbox coordinates refer to.
+        [[nodiscard]] QSize frameSize() const
+        {
+            return QSize(static_cast<int>(image.width), static_cast<int>(image.height));
+        }
+    };
+
+    static constexpr int kDefaultThumbnailBudgetKb = 32 * 1024;
+
+    explicit CaptureGalleryModel(QObject* parent = nullptr);
+
+    int      rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /// Append \a capture, or update the row with the same captureId.
+    void addCapture(const Capture& capture);
+
+    /// Append \a captures with one row insertion; known captureIds are
+    /// updated in place as by addCapture().
+    void appendCaptures(const QVector<Capture>& captures);
+
+    /// Replace all rows.
+    void setCaptures(const QVector<Capture>& captures);
+
+    void clear();
+
+    /// Row lookups; -1 when unknown.
+    [[nodiscard]] int rowOf(const QString& captureId) const;
+    [[nodiscard]] int rowOfMedia(const QString& mediaId) const;
+
+    /// Capture at \a row, or nullptr.
+    [[nodiscard]] const Capture* captureAt(int row) const;
+
+    /// Decoded thumbnail of \a row if cached; never queues a decode.
+    [[nodiscard]] QPixmap cachedThumbnail(int row) const;
+
+    /// Size thumbnails are decoded to.  Changing it drops cached thumbnails.
+    void setThumbnailSize(const QSize& size);
+    [[nodiscard]] QSize thumbnailSize() const { return m_thumbSize; }
+
+    void setThumbnailBudgetKb(int kb);
+
+    /// Downloaded bytes of \a mediaId.  Returns true when a row requested it
+    /// as its thumbnail source (and queues the decode).
+    bool setThumbnailSource(const QString& mediaId, const QByteArray& encoded);
+
+signals:
+    /// A painted row has no inlined thumbnail; download \a media.
+    void thumbnailMediaRequested(hmi::MediaRef media);
+
+private:
+    void requestThumbnail(const Capture& capture) const;
+    void onThumbnailDecoded(const QString& captureId, const QImage& image);
+    void resetThumbnails();
+    void rebuildIndex();
+
+    QVector<Capture>           m_captures;
+    QHash<QString, int>        m_rowOfCapture;
+    QHash<QString, int>        m_rowOfMedia;
+
+    QSize                      m_thumbSize{ 120, 90 };
+    QPixmap                    m_placeholder;
+
+    // Lazily filled from const data(); GUI thread only.
+    mutable QCache<QString, QPixmap> m_thumbs;
+    mutable QSet<QString>            m_decoding;
+    mutable QHash<QString, QString>  m_fetching;   ///< thumbnail source media → captureId
+    CaptureDecoder*                  m_decoder = nullptr;
+};
@@ -122,6 +122,10 @@ void ControlPanel::setupUi()
 
     boxLayout->addLayout(btnRow);
 
+    m_exportBtn = new QPushButton(QStringLiteral("导出结果"), box);
+    m_exportBtn->setEnabled(false);
+    boxLayout->addWidget(m_exportBtn);
+
     // Connect signals
     connect(m_startBtn, &QPushButton::clicked, this, [this]() {
         bool dryRun = m_dryRunCheck->isChecked();
@@ -180,6 +184,10 @@ void ControlPanel::setupUi()
             }
         }
     });
+
+    connect(m_exportBtn, &QPushButton::clicked, this, [this]() {
+        emit exportRequested(m_taskId);
+    });
 }
 
 // ---------------------------------------------------------------------------
@@ -194,6 +202,7 @@ void ControlPanel::setTaskPhase(hmi::TaskPhase phase)
 void ControlPanel::setTaskId(const QString& taskId)
 {
     m_taskId = taskId;
+    m_exportBtn->setEnabled(!m_exporting && !m_taskId.isEmpty());
 }
 
 void ControlPanel::setPlanId(const QString& planId)
@@ -201,6 +210,15 @@ void ControlPanel::setPlanId(const QString& planId)
     m_planId = planId;
 }
 
+void ControlPanel::setExportProgress(int done, int listed)
+{
+    m_exporting = done >= 0;
+    m_exportBtn->setText(m_exporting
+        ? QStringLiteral("导出中 %1/%2").arg(done).arg(listed)
+        : QStringLiteral("导出结果"));
+    m_exportBtn->setEnabled(!m_exporting && !m_taskId.isEmpty());
+}
+
 void ControlPanel::updateButtonStates(hmi::TaskPhase phase)
 {
     // Button enable states based on phase:
@@ -17,6 +17,9 @@
 ///  - Idle/Completed/Failed/Stopped: Start enabled, others disabled
 ///  - Executing: Pause + Stop enabled
 ///  - Paused: Resume + Stop enabled
+///
+/// "导出结果" exports the current task (see ResultExporter) and is enabled
+/// once a task ID is known and no export is running.
 class ControlPanel : public QWidget
 {
     Q_OBJECT
@@ -28,11 +31,16 @@ public:
     void setTaskId(const QString& taskId);
     void setPlanId(const QString& planId);
 
+    /// Show a running result export (\a done of \a listed records); a
+    /// negative \a done re-enables the export button.
+    void setExportProgress(int done, int listed);
+
 signals:
     void startRequested(const QString& planId, bool dryRun);
     void pauseRequested(const QString& taskId, const QString& reason);
     void resumeRequested(const QString& taskId, const QString& reason);
     void stopRequested(const QString& taskId, const QString& reason);
+    void exportRequested(const QString& taskId);
 
 private:
     void setupUi();
@@ -42,8 +50,10 @@ private:
     QPushButton* m_pauseBtn  = nullptr;
     QPushButton* m_resumeBtn = nullptr;
     QPushButton* m_stopBtn   = nullptr;
+    QPushButton* m_exportBtn = nullptr;
     QCheckBox*   m_dryRunCheck = nullptr;
 
     QString m_taskId;
     QString m_planId;
+    bool    m_exporting = false;
 };
@@ -0,0 +1,163 @@
+// src/ui/operator/FleetStatusModel.cpp
+
+#include "FleetStatusModel.h"
+
+#include "TaskCardWidget.h"
+
+#include <QBrush>
+
+#include <algorithm>
+
+FleetStatusModel::FleetStatusModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void FleetStatusModel::setFleet(hmi::FleetClient* fleet)
+{
+    if (m_fleet) {
+        disconnect(m_fleet, nullptr, this, nullptr);
+    }
+    m_fleet = fleet;
+    if (fleet) {
+        connect(fleet, &hmi::FleetClient::robotAdded,   this, [this]() { reload(); });
+        connect(fleet, &hmi::FleetClient::robotRemoved, this, [this]() { reload(); });
+        connect(fleet, &hmi::FleetClient::connectionStateChanged,
+                this, [this](const QString& robotId) { updateRow(robotId); });
+        connect(fleet, &hmi::FleetClient::systemStateReceived,
+                this, [this](const QString& robotId) { updateRow(robotId); });
+    }
+    reload();
+}
+
+// ---------------------------------------------------------------------------
+// QAbstractTableModel
+// ---------------------------------------------------------------------------
+
+int FleetStatusModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int FleetStatusModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant FleetStatusModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size() ||
+        index.column() < 0 || index.column() >= ColumnCount) {
+        return QVariant();
+    }
+
+    const Row& row = m_rows[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+        return row.text[static_cast<std::size_t>(index.column())];
+    case Qt::ForegroundRole:
+        if (index.column() == PhaseColumn) return QBrush(row.phaseColor);
+        if (row.alert && (index.column() == ConnectionColumn ||
+                          index.column() == InterlockColumn)) {
+            return QBrush(QColor(0xdc, 0x35, 0x45));
+        }
+        return QVariant();
+    case RobotIdRole:
+        return row.robotId;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant FleetStatusModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    switch (section) {
+    case RobotColumn:      return QStringLiteral("机器人");
+    case ConnectionColumn: return QStringLiteral("连接");
+    case PhaseColumn:      return QStringLiteral("任务阶段");
+    case ProgressColumn:   return QStringLiteral("进度");
+    case PointColumn:      return QStringLiteral("当前点位");
+    case BatteryColumn:    return QStringLiteral("电量");
+    case InterlockColumn:  return QStringLiteral("联锁");
+    default:               return QVariant();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Rows
+// ---------------------------------------------------------------------------
+
+FleetStatusModel::Row FleetStatusModel::formatRow(const hmi::FleetRobotStatus& robot)
+{
+    Row row;
+    row.robotId = robot.robotId;
+    row.text[RobotColumn]      = robot.robotId;
+    row.text[ConnectionColumn] = robot.connected ? QStringLiteral("在线")
+                                                 : QStringLiteral("离线");
+    row.alert = !robot.connected;
+
+    if (!robot.hasStatus) {
+        for (int c = PhaseColumn; c < ColumnCount; ++c) {
+            row.text[static_cast<std::size_t>(c)] = QStringLiteral("--");
+        }
+        row.phaseColor = QColor(TaskCardWidget::phaseToColor(hmi::TaskPhase::Unspecified));
+        return row;
+    }
+
+    const hmi::TaskStatus& s = *robot.status;
+    row.text[PhaseColumn]    = TaskCardWidget::phaseToString(s.phase);
+    row.phaseColor           = QColor(TaskCardWidget::phaseToColor(s.phase));
+    row.text[ProgressColumn] = QStringLiteral("%1%").arg(s.progressPercent, 0, 'f', 0);
+    row.text[PointColumn]    = s.totalWaypoints > 0
+        ? QStringLiteral("%1/%2").arg(s.currentWaypointIndex + 1).arg(s.totalWaypoints)
+        : QStringLiteral("--");
+    row.text[BatteryColumn]  = QStringLiteral("%1%").arg(s.agv.batteryPercent, 0, 'f', 0);
+    row.text[InterlockColumn] = s.interlockOk ? QStringLiteral("正常")
+                                              : QStringLiteral("断开");
+    row.alert = row.alert || !s.interlockOk;
+    return row;
+}
+
+void FleetStatusModel::reload()
+{
+    beginResetModel();
+    m_rows.clear();
+    if (m_fleet) {
+        const QVector<hmi::FleetRobotStatus> robots = m_fleet->statuses();
+        m_rows.reserve(robots.size());
+        for (const auto& robot : robots) {
+            m_rows.append(formatRow(robot));
+        }
+    }
+    endResetModel();
+}
+
+void FleetStatusModel::updateRow(const QString& robotId)
+{
+    if (!m_fleet) return;
+    const int i = m_fleet->indexOf(robotId);
+    if (i < 0 || i >= m_rows.size()) return;
+
+    Row next = formatRow(m_fleet->statusAt(i));
+    Row& row = m_rows[i];
+    int first = ColumnCount;
+    int last  = -1;
+    for (int c = 0; c < ColumnCount; ++c) {
+        const auto col = static_cast<std::size_t>(c);
+        if (next.text[col] != row.text[col]) {
+            first = std::min(first, c);
+            last  = std::max(last, c);
+        }
+    }
+    if (next.alert != row.alert) {
+        first = std::min<int>(first, ConnectionColumn);
+        last  = std::max<int>(last, InterlockColumn);
+    }
+    row = std::move(next);
+    if (last >= 0) {
+        emit dataChanged(index(i, first), index(i, last));
+    }
+}
@@ -0,0 +1,71 @@
+// src/ui/operator/FleetStatusModel.h
+//
+// FleetStatusModel – one row per robot of a hmi::FleetClient: connection,
+// task phase, progress, current point, battery and interlock.
+//
+// Rows follow the fleet's robotAdded / robotRemoved (one model reset each;
+// a fleet changes rarely).  A status update re-formats only its robot's row
+// and emits dataChanged over the columns whose text actually changed, so the
+// table repaints nothing while a robot idles.  The update rate of each row
+// is the rate of its robot's client (FleetClient::setSystemStateMaxRate()).
+//
+// Thread safety: GUI thread only.
+
+#pragma once
+
+#include "core/FleetClient.h"
+
+#include <QAbstractTableModel>
+#include <QColor>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+
+#include <array>
+
+class FleetStatusModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        RobotColumn,
+        ConnectionColumn,
+        PhaseColumn,
+        ProgressColumn,
+        PointColumn,
+        BatteryColumn,
+        InterlockColumn,
+        ColumnCount
+    };
+
+    enum Role {
+        RobotIdRole = Qt::UserRole,   ///< QString
+    };
+
+    explicit FleetStatusModel(QObject* parent = nullptr);
+
+    /// Show \a fleet's robots (null: no rows).
+    void setFleet(hmi::FleetClient* fleet);
+
+    int      rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int      columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+private:
+    struct Row {
+        QString                          robotId;
+        std::array<QString, ColumnCount> text;
+        QColor                           phaseColor;
+        bool                             alert = false;   ///< offline or interlock open
+    };
+
+    static Row formatRow(const hmi::FleetRobotStatus& robot);
+    void reload();
+    void updateRow(const QString& robotId);
+
+    QPointer<hmi::FleetClient> m_fleet;
+    QVector<Row>               m_rows;
+};
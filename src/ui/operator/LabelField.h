@@ -0,0 +1,114 @@
+// src/ui/operator/LabelField.h
+//
+// LabelField – one status QLabel whose text and style sheet are written only
+// when they change.
+//
+// The operator status widgets get a full TaskStatus at the stream rate
+// (50 Hz), but most fields do not change between two messages and a float
+// that does usually changes below the displayed precision.  A field is
+// therefore keyed by its values quantised to that precision (quantizedKey()):
+// the caller only formats a string when needsText() says the key differs
+// from the one on screen, and setText() / setStyleSheet() skip the QLabel
+// call (relayout, re-polish) when the cached text or style is the same.
+//
+// A numeric field may also cap its refresh rate: a change that arrives
+// sooner than minIntervalMs after the last one is held back and reported
+// by isPending(); the owner re-offers the latest values from a timer so
+// the last change always reaches the screen.
+//
+// Thread safety: none; GUI thread only.
+
+#pragma once
+
+#include <QLabel>
+#include <QString>
+
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+/// Hash of \a values rounded to multiples of \a step (the displayed
+/// precision), so two values that print the same give the same key.
+inline uint64_t quantizedKey(std::initializer_list<double> values, double step)
+{
+    uint64_t h = 1469598103934665603ULL;   // FNV-1a
+    for (double v : values) {
+        const double q = std::isfinite(v) ? std::round(v / step) : 0.0;
+        h ^= static_cast<uint64_t>(static_cast<int64_t>(q));
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+class LabelField
+{
+public:
+    LabelField() = default;
+    explicit LabelField(QLabel* label, int minIntervalMs = 0)
+        : m_label(label)
+        , m_minIntervalMs(minIntervalMs)
+    {}
+
+    /// True when the text for \a key has to be formatted now: the key
+    /// differs from the shown one and the refresh interval has passed since
+    /// the last text.  A change held back by the interval leaves the field
+    /// pending until a later call lets it through.
+    bool needsText(uint64_t key, qint64 nowMs)
+    {
+        if (m_hasKey && key == m_key) {
+            m_pending = false;
+            return false;
+        }
+        if (m_hasKey && nowMs - m_lastTextMs < m_minIntervalMs) {
+            m_pending = true;
+            return false;
+        }
+        m_key        = key;
+        m_hasKey     = true;
+        m_lastTextMs = nowMs;
+        m_pending    = false;
+        return true;
+    }
+
+    [[nodiscard]] bool isPending() const noexcept { return m_pending; }
+
+    void setText(const QString& text)
+    {
+        if (m_hasText && text == m_text) return;
+        m_text    = text;
+        m_hasText = true;
+        m_label->setText(text);
+    }
+
+    /// Re-polishes the label only when \a styleSheet differs from the
+    /// applied one; pass shared constants, not freshly built strings.
+    void setStyleSheet(const QString& styleSheet)
+    {
+        if (m_styled && styleSheet == m_style) return;
+        m_style  = styleSheet;
+        m_styled = true;
+        m_label->setStyleSheet(styleSheet);
+    }
+
+    /// Forget the cached state; the next update writes everything.
+    void invalidate()
+    {
+        m_hasKey  = false;
+        m_pending = false;
+        m_hasText = false;
+        m_styled  = false;
+    }
+
+private:
+    QLabel*  m_label = nullptr;
+    int      m_minIntervalMs = 0;
+    QString  m_text;
+    bool     m_hasText = false;
+    QString  m_style;
+    bool     m_styled = false;
+    uint64_t m_key = 0;
+    bool     m_hasKey = false;
+    bool     m_pending = false;
+    qint64   m_lastTextMs = std::numeric_limits<qint64>::min() / 2;
+};
@@ -0,0 +1,144 @@
+// src/ui/operator/NavMapTileItem.cpp
+
+#include "NavMapTileItem.h"
+#include "NavMapTilePyramid.h"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+
+NavMapTileItem::NavMapTileItem(NavMapTilePyramid* pyramid, QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , m_pyramid(pyramid)
+    , m_pixmaps(kCacheBudgetKb)
+{
+    // Needed for option->exposedRect in paint().
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+void NavMapTileItem::resetPyramid()
+{
+    prepareGeometryChange();
+    m_pixmaps.clear();
+    m_fullSize = m_pyramid->fullSize();
+    // The one-tile top level is the fallback for everything below it.
+    const int top = m_pyramid->levelCount() - 1;
+    if (top >= 0) {
+        m_pyramid->requestTiles(top, { NavMapTilePyramid::tileKey(top, 0, 0) });
+    }
+    update();
+}
+
+void NavMapTileItem::clearCache()
+{
+    m_pixmaps.clear();
+    update();
+}
+
+void NavMapTileItem::insertTile(quint64 key, const QImage& tile)
+{
+    if (tile.isNull()) {
+        return;
+    }
+    auto* pixmap = new QPixmap(QPixmap::fromImage(tile));
+    const int costKb = std::max<qint64>(1, qint64(pixmap->width()) * pixmap->height()
+                                               * pixmap->depth() / 8 / 1024);
+    m_pixmaps.insert(key, pixmap, costKb);
+    update(itemRect(key));
+}
+
+QRectF NavMapTileItem::itemRect(quint64 key) const
+{
+    const int   level = NavMapTilePyramid::keyLevel(key);
+    const QSize size  = m_pyramid->levelSize(level);
+    if (size.isEmpty()) {
+        return QRectF();
+    }
+    const QRect  r  = m_pyramid->tileRect(level, NavMapTilePyramid::keyCol(key),
+                                          NavMapTilePyramid::keyRow(key));
+    const double sx = double(m_fullSize.width())  / size.width();
+    const double sy = double(m_fullSize.height()) / size.height();
+    return QRectF(r.x() * sx, r.y() * sy, r.width() * sx, r.height() * sy);
+}
+
+QRectF NavMapTileItem::boundingRect() const
+{
+    return QRectF(QPointF(0, 0), QSizeF(m_fullSize));
+}
+
+// ---------------------------------------------------------------------------
+// Painting
+// ---------------------------------------------------------------------------
+
+void NavMapTileItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                           QWidget* /*widget*/)
+{
+    const int levels = m_pyramid->levelCount();
+    if (levels == 0 || m_fullSize.isEmpty()) {
+        return;
+    }
+
+    // Coarsest level whose texels are still no larger than a screen pixel.
+    const double lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(
+        painter->worldTransform());
+    int level = 0;
+    if (lod > 0.0) {
+        level = std::clamp(int(std::floor(std::log2(1.0 / lod))), 0, levels - 1);
+    }
+
+    const QSize  levelSize = m_pyramid->levelSize(level);
+    const QSize  grid      = m_pyramid->tileGrid(level);
+    const double spanX = NavMapTilePyramid::kTileSize * double(m_fullSize.width())  / levelSize.width();
+    const double spanY = NavMapTilePyramid::kTileSize * double(m_fullSize.height()) / levelSize.height();
+
+    const QRectF exposed = option->exposedRect.intersected(boundingRect());
+    if (exposed.isEmpty()) {
+        return;
+    }
+    const int col0 = std::clamp(int(exposed.left()   / spanX), 0, grid.width()  - 1);
+    const int col1 = std::clamp(int(exposed.right()  / spanX), 0, grid.width()  - 1);
+    const int row0 = std::clamp(int(exposed.top()    / spanY), 0, grid.height() - 1);
+    const int row1 = std::clamp(int(exposed.bottom() / spanY), 0, grid.height() - 1);
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, lod < 1.0);
+
+    QVector<quint64> missing;
+    for (int row = row0; row <= row1; ++row) {
+        for (int col = col0; col <= col1; ++col) {
+            const quint64 key    = NavMapTilePyramid::tileKey(level, col, row);
+            const QRectF  target = itemRect(key);
+            if (const QPixmap* pixmap = m_pixmaps.object(key)) {
+                painter->drawPixmap(target, *pixmap, QRectF(pixmap->rect()));
+            } else {
+                missing.append(key);
+                paintFallback(painter, level, col, row, target);
+            }
+        }
+    }
+    if (!missing.isEmpty()) {
+        m_pyramid->requestTiles(level, missing);
+    }
+}
+
+void NavMapTileItem::paintFallback(QPainter* painter, int level, int col, int row,
+                                   const QRectF& target)
+{
+    const int levels = m_pyramid->levelCount();
+    for (int k = 1; level + k < levels; ++k) {
+        const quint64  key    = NavMapTilePyramid::tileKey(level + k, col >> k, row >> k);
+        const QPixmap* pixmap = m_pixmaps.object(key);
+        if (!pixmap) { continue; }
+
+        const QRectF r = itemRect(key);
+        const QRectF source((target.x() - r.x()) * pixmap->width()  / r.width(),
+                            (target.y() - r.y()) * pixmap->height() / r.height(),
+                            target.width()  * pixmap->width()  / r.width(),
+                            target.height() * pixmap->height() / r.height());
+        painter->drawPixmap(target, *pixmap, source);
+        return;
+    }
+    // Nothing cached: the thumbnail below shows through.
+}
@@ -0,0 +1,56 @@
+// src/ui/operator/NavMapTileItem.h
+//
+// NavMapTileItem – draws the NavMapTilePyramid tiles that intersect the
+// exposed rect, at the level that matches the current zoom (the coarsest
+// level with at least one texel per screen pixel).  Item coordinates are
+// full-resolution map pixels.
+//
+// Tiles are uploaded (QPixmap::fromImage) as they arrive and kept in a
+// bounded LRU cache.  A tile that is not there yet is requested from the
+// pyramid and drawn from the nearest cached coarser tile meanwhile, so
+// zooming in sharpens progressively instead of flashing the thumbnail.
+
+#pragma once
+
+#include <QCache>
+#include <QGraphicsItem>
+#include <QImage>
+#include <QPixmap>
+#include <QRectF>
+#include <QSize>
+
+class NavMapTilePyramid;
+
+class NavMapTileItem : public QGraphicsItem
+{
+public:
+    /// Upload budget for cached tile pixmaps.
+    static constexpr int kCacheBudgetKb = 128 * 1024;
+
+    explicit NavMapTileItem(NavMapTilePyramid* pyramid, QGraphicsItem* parent = nullptr);
+
+    /// Call after the pyramid's ready(true): picks up its size.
+    void resetPyramid();
+
+    /// Drop every cached pixmap.
+    void clearCache();
+
+    /// Upload a tile delivered by NavMapTilePyramid::tileReady().
+    void insertTile(quint64 key, const QImage& tile);
+
+    QRectF boundingRect() const override;
+    void   paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                 QWidget* widget = nullptr) override;
+
+private:
+    /// Tile rect of \a key in item (full-resolution) coordinates.
+    QRectF itemRect(quint64 key) const;
+
+    /// Draw \a target from the nearest cached tile coarser than \a level.
+    void paintFallback(QPainter* painter, int level, int col, int row,
+                       const QRectF& target);
+
+    NavMapTilePyramid*       m_pyramid = nullptr;
+    QSize                    m_fullSize;
+    QCache<quint64, QPixmap> m_pixmaps;
+};
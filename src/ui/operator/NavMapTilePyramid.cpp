@@ -0,0 +1,186 @@
+// src/ui/operator/NavMapTilePyramid.cpp
+
+#include "NavMapTilePyramid.h"
+
+#include <QBuffer>
+#include <QImageReader>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/// Decoding / level building and tile cutting share the pool; two workers
+/// keep one free for tiles while a new map is being built.
+constexpr int kWorkers = 2;
+
+/// Qt refuses images above 256 MB by default; an 8k × 8k RGB map is just
+/// that.  Maps are trusted gateway data.
+constexpr int kAllocationLimitMb = 1024;
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Construction
+// ---------------------------------------------------------------------------
+
+NavMapTilePyramid::NavMapTilePyramid(QObject* parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(kWorkers);
+}
+
+NavMapTilePyramid::~NavMapTilePyramid()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+// ---------------------------------------------------------------------------
+// Source
+// ---------------------------------------------------------------------------
+
+void NavMapTilePyramid::setSource(QByteArray encoded)
+{
+    clear();
+    const int generation = m_generation;
+    m_pool.start([this, generation, encoded = std::move(encoded)]() {
+        std::shared_ptr<const Levels> levels = build(encoded);
+        // The pool is drained in the destructor, so `this` outlives the task.
+        QMetaObject::invokeMethod(this,
+            [this, generation, levels = std::move(levels)]() {
+                if (generation != m_generation) { return; }
+                m_levels = levels;
+                emit ready(m_levels != nullptr);
+            }, Qt::QueuedConnection);
+    });
+}
+
+void NavMapTilePyramid::clear()
+{
+    m_pool.clear();
+    ++m_generation;
+    m_levels.reset();
+    m_queued.clear();
+    m_running.clear();
+}
+
+std::shared_ptr<const NavMapTilePyramid::Levels>
+NavMapTilePyramid::build(const QByteArray& encoded)
+{
+    QBuffer buffer;
+    buffer.setData(encoded);
+    if (!buffer.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    QImageReader reader(&buffer);
+    reader.setAllocationLimit(kAllocationLimitMb);
+
+    QImage full = reader.read();
+    if (full.isNull()) {
+        return nullptr;
+    }
+    // Occupancy grids are grayscale: keep them at one byte per pixel.
+    full = full.convertToFormat(full.isGrayscale() ? QImage::Format_Grayscale8
+                                                   : QImage::Format_RGB32);
+
+    auto levels = std::make_shared<Levels>();
+    levels->images.append(full);
+    while (levels->images.back().width() > kTileSize
+           || levels->images.back().height() > kTileSize) {
+        const QImage& prev = levels->images.back();
+        levels->images.append(prev.scaled(std::max(1, (prev.width() + 1) / 2),
+                                          std::max(1, (prev.height() + 1) / 2),
+                                          Qt::IgnoreAspectRatio,
+                                          Qt::SmoothTransformation));
+    }
+    return levels;
+}
+
+// ---------------------------------------------------------------------------
+// Geometry
+// ---------------------------------------------------------------------------
+
+int NavMapTilePyramid::levelCount() const
+{
+    return m_levels ? m_levels->images.size() : 0;
+}
+
+QSize NavMapTilePyramid::levelSize(int level) const
+{
+    if (!m_levels || level < 0 || level >= m_levels->images.size()) {
+        return QSize();
+    }
+    return m_levels->images[level].size();
+}
+
+QSize NavMapTilePyramid::tileGrid(int level) const
+{
+    const QSize size = levelSize(level);
+    if (size.isEmpty()) {
+        return QSize();
+    }
+    return QSize((size.width()  + kTileSize - 1) / kTileSize,
+                 (size.height() + kTileSize - 1) / kTileSize);
+}
+
+QRect NavMapTilePyramid::tileRect(int level, int col, int row) const
+{
+    return QRect(col * kTileSize, row * kTileSize, kTileSize, kTileSize)
+        .intersected(QRect(QPoint(0, 0), levelSize(level)));
+}
+
+quint64 NavMapTilePyramid::tileKey(int level, int col, int row)
+{
+    return (quint64(level) << 48) | (quint64(row & 0xffffff) << 24) | quint64(col & 0xffffff);
+}
+
+// ---------------------------------------------------------------------------
+// Tiles
+// ---------------------------------------------------------------------------
+
+void NavMapTilePyramid::requestTiles(int level, const QVector<quint64>& keys)
+{
+    if (!m_levels) {
+        return;
+    }
+    m_queued.erase(std::remove_if(m_queued.begin(), m_queued.end(),
+                                  [level](quint64 key) { return keyLevel(key) != level; }),
+                   m_queued.end());
+
+    // Newest first, keeping the order within this request.
+    for (auto it = keys.crbegin(); it != keys.crend(); ++it) {
+        if (m_running.contains(*it)) { continue; }
+        m_queued.removeOne(*it);
+        m_queued.prepend(*it);
+    }
+    while (m_queued.size() > kMaxQueued) {
+        m_queued.removeLast();
+    }
+    pump();
+}
+
+void NavMapTilePyramid::pump()
+{
+    while (!m_queued.isEmpty() && m_running.size() < kWorkers) {
+        const quint64 key   = m_queued.takeFirst();
+        const int     level = keyLevel(key);
+        if (level >= levelCount()) { continue; }
+
+        const QRect rect = tileRect(level, keyCol(key), keyRow(key));
+        if (rect.isEmpty()) { continue; }
+
+        m_running.insert(key);
+        const int generation = m_generation;
+        m_pool.start([this, generation, key, rect, source = m_levels->images[level]]() {
+            QImage tile = source.copy(rect);
+            QMetaObject::invokeMethod(this,
+                [this, generation, key, tile = std::move(tile)]() {
+                    if (generation != m_generation) { return; }
+                    m_running.remove(key);
+                    emit tileReady(key, tile);
+                    pump();
+                }, Qt::QueuedConnection);
+        });
+    }
+}
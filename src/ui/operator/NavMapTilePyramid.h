@@ -0,0 +1,99 @@
+// src/ui/operator/NavMapTilePyramid.h
+//
+// NavMapTilePyramid – multi-resolution tile source for large navigation
+// maps (8k × 8k at 2 cm is common).
+//
+// setSource() hands the encoded full-resolution map (fetched with
+// DownloadMedia) to a private thread pool, which decodes it once and builds
+// the pyramid: level 0 is the full image, every further level halves it
+// until it fits in one tile.  Tiles (kTileSize squared, smaller at the
+// right / bottom edge) are cut from their level on demand, also on the pool,
+// and handed to the GUI thread as QImage; converting them to QPixmap – the
+// upload – is left to the caller (NavMapTileItem), which only asks for the
+// tiles that are visible at the current zoom.
+//
+// requestTiles() is newest-first: the tiles the view asked for last are cut
+// first, queued tiles of another level are dropped when the level changes,
+// and the queue is bounded so a fast pan does not pile up stale work.
+//
+// Thread safety: GUI-thread only; signals are emitted on the GUI thread.
+
+#pragma once
+
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QRect>
+#include <QSet>
+#include <QSize>
+#include <QThreadPool>
+#include <QVector>
+
+#include <memory>
+
+class NavMapTilePyramid : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kTileSize  = 512;
+    static constexpr int kMaxQueued = 256;
+
+    explicit NavMapTilePyramid(QObject* parent = nullptr);
+
+    /// Drops queued work and waits for running tasks.
+    ~NavMapTilePyramid() override;
+
+    /// Decode \a encoded (PNG / JPEG / PGM ...) and build the levels in the
+    /// background; ready() follows.  Replaces any previous source.
+    void setSource(QByteArray encoded);
+
+    /// Forget the source and every queued tile.
+    void clear();
+
+    [[nodiscard]] bool  isReady()    const { return m_levels != nullptr; }
+    [[nodiscard]] QSize fullSize()   const { return levelSize(0); }
+    [[nodiscard]] int   levelCount() const;
+    [[nodiscard]] QSize levelSize(int level) const;
+
+    /// Number of tile columns / rows of \a level.
+    [[nodiscard]] QSize tileGrid(int level) const;
+
+    /// Pixel rect of a tile within its level image.
+    [[nodiscard]] QRect tileRect(int level, int col, int row) const;
+
+    static quint64 tileKey(int level, int col, int row);
+    static int     keyLevel(quint64 key) { return int(key >> 48); }
+    static int     keyRow(quint64 key)   { return int((key >> 24) & 0xffffff); }
+    static int     keyCol(quint64 key)   { return int(key & 0xffffff); }
+
+    /// Ask for the tiles \a keys of \a level, most wanted first.  Tiles
+    /// already queued move to the front; queued tiles of other levels are
+    /// dropped.
+    void requestTiles(int level, const QVector<quint64>& keys);
+
+signals:
+    /// The pyramid for the last setSource() is built; \a ok is false when
+    /// the data could not be decoded.
+    void ready(bool ok);
+
+    /// One requested tile, cut from its level.
+    void tileReady(quint64 key, QImage tile);
+
+private:
+    struct Levels {
+        QVector<QImage> images;   ///< [0] = full resolution
+    };
+
+    /// Start queued tiles while workers are free.
+    void pump();
+
+    static std::shared_ptr<const Levels> build(const QByteArray& encoded);
+
+    QThreadPool                   m_pool;
+    int                           m_generation = 0;   ///< bumped by setSource()/clear()
+    std::shared_ptr<const Levels> m_levels;
+    QList<quint64>                m_queued;           ///< front = next to cut
+    QSet<quint64>                 m_running;
+};
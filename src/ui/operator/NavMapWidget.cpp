@@ -1,15 +1,50 @@
 // src/ui/operator/NavMapWidget.cpp
 
 #include "NavMapWidget.h"
+#include "AgvTrailItem.h"
+#include "NavMapTileItem.h"
+#include "NavMapTilePyramid.h"
+#include "WaypointLayerItem.h"
+
+#include "CoordTransform.h"
 
 #include <QVBoxLayout>
 #include <QGraphicsRectItem>
+#include <QOpenGLWidget>
 #include <QPen>
 #include <QBrush>
+#include <QLineF>
 #include <QPainterPath>
 #include <QTransform>
 #include <QWheelEvent>
+#include <algorithm>
 #include <cmath>
+#include <utility>
+
+namespace {
+
+/// AGV marker animation tick (display rate).
+constexpr int kAgvFrameMs = 16;
+
+/// Bounds for the smoothed pose-sample interval the marker glides over.
+constexpr double kMinSampleIntervalMs = 10.0;
+constexpr double kMaxSampleIntervalMs = 250.0;
+
+/// Farther jumps (relocalisation, map switch) are not animated.
+constexpr double kTeleportDistanceM = 2.0;
+
+/// Minimum travel before a trail point is added.
+constexpr double kTrailStepM = 0.05;
+
+double shortestAngleDeg(double from, double to)
+{
+    double d = std::fmod(to - from, 360.0);
+    if (d > 180.0)  { d -= 360.0; }
+    if (d < -180.0) { d += 360.0; }
+    return d;
+}
+
+} // anonymous namespace
 
 // ---------------------------------------------------------------------------
 // Construction
@@ -38,6 +73,49 @@ void NavMapWidget::setupUi()
     m_view->setResizeAnchor(QGraphicsView::AnchorUnderMouse);
     m_view->setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing, true);
 
+    // A handful of large or moving items: the BSP index only costs.
+    m_scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+    // Full-resolution tiles above the thumbnail placeholder.
+    m_tiles    = new NavMapTilePyramid(this);
+    m_tileItem = new NavMapTileItem(m_tiles);
+    m_tileItem->setZValue(1);
+    m_tileItem->setVisible(false);
+    m_scene->addItem(m_tileItem);
+    connect(m_tiles, &NavMapTilePyramid::ready, this, [this](bool ok) {
+        if (!ok || m_mapSize.isEmpty()) { return; }
+        m_tileItem->resetPyramid();
+        // Stretch to the map size should the image differ from the metadata.
+        const QSize full = m_tiles->fullSize();
+        m_tileItem->setTransform(QTransform::fromScale(m_mapSize.width()  / full.width(),
+                                                       m_mapSize.height() / full.height()));
+        m_tileItem->setVisible(true);
+    });
+    connect(m_tiles, &NavMapTilePyramid::tileReady, this, [this](quint64 key, const QImage& tile) {
+        m_tileItem->insertTile(key, tile);
+    });
+
+    // Persistent overlay items; their geometry is replaced, not the items.
+    // The path pen is cosmetic: a full-resolution map is zoomed far out.
+    QPen pathPen(QColor("#00e676"), 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+    pathPen.setCosmetic(true);
+    m_pathItem = m_scene->addPath(QPainterPath(), pathPen);
+    m_pathItem->setZValue(5);
+    m_pathItem->setVisible(false);
+
+    m_waypointLayer = new WaypointLayerItem;
+    m_waypointLayer->setZValue(6);
+    m_scene->addItem(m_waypointLayer);
+
+    m_trailItem = new AgvTrailItem;
+    m_trailItem->setZValue(7);
+    m_scene->addItem(m_trailItem);
+
+    m_clock.start();
+    m_agvAnimation.setTimerType(Qt::PreciseTimer);
+    m_agvAnimation.setInterval(kAgvFrameMs);
+    connect(&m_agvAnimation, &QTimer::timeout, this, &NavMapWidget::animateAgv);
+
     QVBoxLayout* vlay = new QVBoxLayout(this);
     vlay->setContentsMargins(0, 0, 0, 0);
     vlay->addWidget(m_view);
@@ -47,6 +125,42 @@ void NavMapWidget::setupUi()
     m_view->viewport()->installEventFilter(this);
 }
 
+void NavMapWidget::setRenderMode(RenderMode mode)
+{
+    m_renderMode = mode;
+    // The GL viewport (and its context) is only worth creating once the
+    // map is on screen; a hidden operator window starts without it.
+    if (isVisible()) {
+        applyRenderMode();
+    }
+}
+
+void NavMapWidget::showEvent(QShowEvent* event)
+{
+    applyRenderMode();
+    QWidget::showEvent(event);
+}
+
+void NavMapWidget::applyRenderMode()
+{
+    if (m_viewportMode == m_renderMode) {
+        return;
+    }
+    const RenderMode mode = m_renderMode;
+    m_viewportMode = mode;
+
+    if (mode == RenderMode::OpenGL) {
+        m_view->setViewport(new QOpenGLWidget);
+        // Partial updates buy nothing on a GL surface.
+        m_view->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+    } else {
+        m_view->setViewport(new QWidget);
+        m_view->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+    }
+    // setViewport() deleted the old viewport together with its filter.
+    m_view->viewport()->installEventFilter(this);
+}
+
 // Override eventFilter to handle mouse wheel zoom
 bool NavMapWidget::eventFilter(QObject* obj, QEvent* event)
 {
@@ -78,14 +192,45 @@ void NavMapWidget::setNavMap(const hmi::NavMapInfo& mapInfo, const QImage& mapIm
         m_mapItem = nullptr;
     }
 
-    // Create new map pixmap
-    if (!mapImage.isNull()) {
+    // Full-resolution tiles belong to the previous map.
+    m_tiles->clear();
+    m_tileItem->setVisible(false);
+    m_tileItem->clearCache();
+
+    m_trailItem->clear();
+    m_lastSampleMs = -1;
+
+    m_mapSize = QSizeF(mapInfo.width, mapInfo.height);
+    if (m_mapSize.isEmpty()) {
+        m_mapSize = QSizeF(mapImage.size());
+    }
+
+    // Thumbnail placeholder, stretched to the full-resolution extent.
+    if (!mapImage.isNull() && !m_mapSize.isEmpty()) {
         QPixmap pix = QPixmap::fromImage(mapImage);
         m_mapItem = m_scene->addPixmap(pix);
         m_mapItem->setZValue(0);
-        m_scene->setSceneRect(m_mapItem->boundingRect());
-        m_view->fitInView(m_mapItem, Qt::KeepAspectRatio);
+        m_mapItem->setTransformationMode(Qt::SmoothTransformation);
+        m_mapItem->setTransform(QTransform::fromScale(m_mapSize.width()  / pix.width(),
+                                                      m_mapSize.height() / pix.height()));
+    }
+    if (!m_mapSize.isEmpty()) {
+        const QRectF mapRect(QPointF(0, 0), m_mapSize);
+        m_trailItem->setExtent(mapRect);
+        m_scene->setSceneRect(mapRect);
+        m_view->fitInView(mapRect, Qt::KeepAspectRatio);
     }
+
+    // The pixel mapping changed with the map.
+    updatePathDisplay();
+}
+
+void NavMapWidget::setMapImageData(const QString& mediaId, const QByteArray& data)
+{
+    if (mediaId.isEmpty() || mediaId != m_mapInfo.image.media.mediaId || data.isEmpty()) {
+        return;
+    }
+    m_tiles->setSource(data);
 }
 
 // ---------------------------------------------------------------------------
@@ -94,30 +239,79 @@ void NavMapWidget::setNavMap(const hmi::NavMapInfo& mapInfo, const QImage& mapIm
 
 void NavMapWidget::updateAgvPose(const hmi::Pose2D& pose)
 {
-    if (!m_mapItem) {
+    if (m_mapSize.isEmpty()) {
         return;  // No map loaded
     }
 
-    QPointF pixelPos = worldToPixel(pose.x, pose.y);
-
-    // Create triangle pointing in the direction of yaw
-    // Triangle: base = 12px, height = 20px
-    QPolygonF triangle;
-    triangle << QPointF(0, -10) << QPointF(-6, 6) << QPointF(6, 6);
+    // yaw is in radians; the map's Y-axis is inverted (screen coordinates),
+    // so the rotation is negated.
+    const MarkerPose sample{ worldToPixel(pose.x, pose.y), -pose.yaw * 180.0 / M_PI };
+    const qint64 now = m_clock.elapsed();
 
     if (!m_agvItem) {
+        // Triangle pointing along +yaw: base = 12px, height = 20px.
+        QPolygonF triangle;
+        triangle << QPointF(0, -10) << QPointF(-6, 6) << QPointF(6, 6);
         m_agvItem = m_scene->addPolygon(triangle, QPen(Qt::NoPen), QBrush(QColor("#ff5722")));
         m_agvItem->setZValue(10);
+        // Constant screen size at any zoom (setRotation still applies).
+        m_agvItem->setFlag(QGraphicsItem::ItemIgnoresTransformations, true);
+    }
+
+    const double jumpM = QLineF(m_poseTo.pos, sample.pos).length()
+                         * m_mapInfo.resolutionMPerPixel;
+    if (m_lastSampleMs < 0 || jumpM > kTeleportDistanceM) {
+        // First sample or a relocalisation: place it, no glide, new trail.
+        m_poseFrom = sample;
+        m_poseTo   = sample;
+        m_agvAnimation.stop();
+        m_agvItem->setPos(sample.pos);
+        m_agvItem->setRotation(sample.yawDeg);
+        m_trailItem->clear();
+        m_trailItem->append(sample.pos);
+        m_lastTrailPoint = sample.pos;
     } else {
-        m_agvItem->setPolygon(triangle);
+        // Glide from what is on screen now to the new sample over one
+        // (smoothed) sample interval.
+        const double interval = std::clamp(double(now - m_lastSampleMs),
+                                           kMinSampleIntervalMs, kMaxSampleIntervalMs);
+        m_sampleInterval = 0.8 * m_sampleInterval + 0.2 * interval;
+        m_poseFrom = interpolatedPose(now);
+        m_poseTo   = sample;
+        m_poseStartMs = now;
+        if (!m_agvAnimation.isActive()) { m_agvAnimation.start(); }
+
+        if (QLineF(m_lastTrailPoint, sample.pos).length() * m_mapInfo.resolutionMPerPixel
+            >= kTrailStepM) {
+            m_trailItem->append(sample.pos);
+            m_lastTrailPoint = sample.pos;
+        }
     }
+    m_lastSampleMs = now;
+}
 
-    // Position and rotate
-    m_agvItem->setPos(pixelPos);
-    // yaw is in radians, convert to degrees
-    double yawDeg = pose.yaw * 180.0 / M_PI;
-    // Since the map's Y-axis is inverted (screen coordinates), we need to negate the rotation
-    m_agvItem->setRotation(-yawDeg);
+NavMapWidget::MarkerPose NavMapWidget::interpolatedPose(qint64 nowMs) const
+{
+    const double t = std::clamp(double(nowMs - m_poseStartMs) / m_sampleInterval, 0.0, 1.0);
+    MarkerPose pose;
+    pose.pos    = m_poseFrom.pos + (m_poseTo.pos - m_poseFrom.pos) * t;
+    pose.yawDeg = m_poseFrom.yawDeg + shortestAngleDeg(m_poseFrom.yawDeg, m_poseTo.yawDeg) * t;
+    return pose;
+}
+
+void NavMapWidget::animateAgv()
+{
+    if (!m_agvItem) {
+        m_agvAnimation.stop();
+        return;
+    }
+    const qint64 now = m_clock.elapsed();
+    const MarkerPose pose = interpolatedPose(now);
+    m_agvItem->setPos(pose.pos);
+    m_agvItem->setRotation(pose.yawDeg);
+    if (now - m_poseStartMs >= qint64(m_sampleInterval)) {
+        m_agvAnimation.stop();
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -134,7 +328,7 @@ void NavMapWidget::setPath(const hmi::InspectionPath& path)
 void NavMapWidget::highlightWaypoint(int index)
 {
     m_highlightedIndex = index;
-    updatePathDisplay();
+    m_waypointLayer->setHighlighted(index);
 }
 
 void NavMapWidget::clearPath()
@@ -146,58 +340,36 @@ void NavMapWidget::clearPath()
 
 void NavMapWidget::updatePathDisplay()
 {
-    // Remove old path
-    if (m_pathItem) {
-        m_scene->removeItem(m_pathItem);
-        delete m_pathItem;
-        m_pathItem = nullptr;
-    }
-
-    // Remove old waypoint markers
-    for (auto* marker : m_waypointMarkers) {
-        m_scene->removeItem(marker);
-        delete marker;
-    }
-    m_waypointMarkers.clear();
-
-    if (m_currentPath.waypoints.isEmpty() || !m_mapItem) {
+    if (m_currentPath.waypoints.isEmpty() || m_mapSize.isEmpty()) {
+        m_pathItem->setPath(QPainterPath());
+        m_pathItem->setVisible(false);
+        m_waypointLayer->clear();
         return;
     }
 
-    // Draw path as green polyline
-    QPainterPath polyline;
-    bool first = true;
+    // The polyline and the packed marker array share the points: gather the
+    // world positions, then convert the whole path in one SIMD pass.
+    QVector<QPointF> points;
+    points.reserve(m_currentPath.waypoints.size());
     for (const auto& wp : m_currentPath.waypoints) {
-        QPointF pt = worldToPixel(wp.agvPose.x, wp.agvPose.y);
-        if (first) {
-            polyline.moveTo(pt);
-            first = false;
-        } else {
-            polyline.lineTo(pt);
-        }
+        points.append(QPointF(wp.agvPose.x, wp.agvPose.y));
+    }
+    if (m_mapInfo.resolutionMPerPixel > 0.0) {
+        hmi::coord::worldToPixelBatch(points.data(), std::size_t(points.size()),
+                                      m_mapInfo.origin.x, m_mapInfo.origin.y,
+                                      m_mapInfo.resolutionMPerPixel);
+    } else {
+        points.fill(QPointF(0, 0));
     }
 
-    QPen pathPen(QColor("#00e676"), 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
-    m_pathItem = m_scene->addPath(polyline, pathPen);
-    m_pathItem->setZValue(5);
-
-    // Draw waypoint markers
-    for (int i = 0; i < m_currentPath.waypoints.size(); ++i) {
-        const auto& wp = m_currentPath.waypoints[i];
-        QPointF pt = worldToPixel(wp.agvPose.x, wp.agvPose.y);
-
-        bool isHighlighted = (i == m_highlightedIndex);
-        double radius = isHighlighted ? 6.0 : 3.0;
-        QColor color = isHighlighted ? QColor("#ffeb3b") : QColor("#4caf50");
+    QPainterPath polyline;
+    polyline.reserve(points.size());
+    polyline.addPolygon(QPolygonF(points));
+    m_pathItem->setPath(polyline);
+    m_pathItem->setVisible(true);
 
-        QGraphicsEllipseItem* marker = m_scene->addEllipse(
-            pt.x() - radius, pt.y() - radius, 2 * radius, 2 * radius,
-            QPen(Qt::NoPen),
-            QBrush(color)
-        );
-        marker->setZValue(6);
-        m_waypointMarkers.append(marker);
-    }
+    m_waypointLayer->setPoints(std::move(points));
+    m_waypointLayer->setHighlighted(m_highlightedIndex);
 }
 
 // ---------------------------------------------------------------------------
@@ -3,6 +3,25 @@
 // NavMapWidget – 2D navigation map visualization using QGraphicsView.
 //
 // Displays the occupancy grid, planned path, AGV pose, and waypoint markers.
+// The markers are drawn by one WaypointLayerItem; setPath() rebuilds the
+// path geometry once and highlightWaypoint() only repaints two markers.
+//
+// Scene units are full-resolution map pixels.  The thumbnail from
+// GetNavMap is stretched over the whole map as a placeholder; once the
+// full-resolution image arrives (setMapImageData()), a NavMapTilePyramid is
+// built in the background and NavMapTileItem draws only the visible tiles
+// at the level matching the zoom, so an 8k × 8k map can be zoomed to full
+// resolution without ever uploading it whole.
+//
+// RenderMode::OpenGL swaps the view's viewport for a QOpenGLWidget: the map
+// pixmaps become textures uploaded once, and the path, trail and AGV marker
+// are drawn by the GL paint engine, so a moving marker no longer costs a
+// raster repaint of the map below it.  Pose samples are not applied
+// directly: the marker glides from where it is drawn to the newest sample
+// over the measured sample interval, and every sample is appended to an
+// AgvTrailItem ring buffer.  The GL viewport is created when the widget is
+// first shown, not by setRenderMode(), so a hidden window never pays for
+// the context.
 
 #pragma once
 
@@ -12,13 +31,20 @@
 #include <QGraphicsPixmapItem>
 #include <QGraphicsPathItem>
 #include <QGraphicsPolygonItem>
-#include <QGraphicsEllipseItem>
+#include <QElapsedTimer>
 #include <QImage>
+#include <QSizeF>
+#include <QTimer>
 #include <QVector>
 #include <QEvent>
 
 #include "core/Types.h"
 
+class AgvTrailItem;
+class NavMapTileItem;
+class NavMapTilePyramid;
+class WaypointLayerItem;
+
 /// \brief A 2D navigation map visualization using QGraphicsView.
 ///
 /// Coordinate system mapping:
@@ -33,12 +59,26 @@ class NavMapWidget : public QWidget
     Q_OBJECT
 
 public:
+    enum class RenderMode {
+        Raster,   ///< QWidget viewport, minimal repaints (default)
+        OpenGL,   ///< QOpenGLWidget viewport, full-viewport GPU redraws
+    };
+
     explicit NavMapWidget(QWidget* parent = nullptr);
 
-    /// Load and display a navigation map.
+    void       setRenderMode(RenderMode mode);
+    RenderMode renderMode() const { return m_renderMode; }
+
+    /// Load and display a navigation map.  \a mapImage may be a thumbnail;
+    /// it is stretched to mapInfo.width × mapInfo.height.
     void setNavMap(const hmi::NavMapInfo& mapInfo, const QImage& mapImage);
 
-    /// Update the AGV triangle marker to reflect current pose.
+    /// Full-resolution map image bytes (DownloadMedia of
+    /// mapInfo.image.media).  Other media ids are ignored.
+    void setMapImageData(const QString& mediaId, const QByteArray& data);
+
+    /// New AGV pose sample: the marker is animated towards it and the
+    /// point is added to the trail.
     void updateAgvPose(const hmi::Pose2D& pose);
 
     /// Set the inspection path and render it as a polyline with waypoint markers.
@@ -53,25 +93,54 @@ public:
 protected:
     /// Event filter for mouse wheel zoom on the viewport.
     bool eventFilter(QObject* obj, QEvent* event) override;
+    void showEvent(QShowEvent* event) override;
 
 private:
     void setupUi();
 
+    /// Install the viewport of m_renderMode if another one is installed.
+    void applyRenderMode();
+
     /// Convert world (metric) coordinates to pixel coordinates.
     QPointF worldToPixel(double x, double y) const;
 
-    /// Redraw the path polyline and waypoint markers.
+    /// Rebuild the path polyline and waypoint markers from m_currentPath.
     void updatePathDisplay();
 
+    /// Animation tick: place the AGV marker between m_poseFrom and m_poseTo.
+    void animateAgv();
+
+    struct MarkerPose {
+        QPointF pos;        ///< scene pixels
+        double  yawDeg = 0.0;
+    };
+    MarkerPose interpolatedPose(qint64 nowMs) const;
+
     QGraphicsView*  m_view        = nullptr;
     QGraphicsScene* m_scene       = nullptr;
 
-    QGraphicsPixmapItem*  m_mapItem     = nullptr;
+    QGraphicsPixmapItem*  m_mapItem     = nullptr;   // thumbnail placeholder
+    NavMapTilePyramid*    m_tiles       = nullptr;
+    NavMapTileItem*       m_tileItem    = nullptr;
     QGraphicsPathItem*    m_pathItem    = nullptr;
     QGraphicsPolygonItem* m_agvItem     = nullptr;   // AGV triangle
-    QVector<QGraphicsEllipseItem*> m_waypointMarkers;
+    AgvTrailItem*         m_trailItem   = nullptr;
+    WaypointLayerItem*    m_waypointLayer = nullptr;
 
     hmi::NavMapInfo m_mapInfo;
+    QSizeF m_mapSize;                    ///< full-resolution pixels; empty = no map
+    RenderMode m_renderMode = RenderMode::Raster;     ///< requested
+    RenderMode m_viewportMode = RenderMode::Raster;   ///< installed
+
+    // AGV marker interpolation
+    QElapsedTimer m_clock;
+    QTimer        m_agvAnimation;
+    MarkerPose    m_poseFrom;
+    MarkerPose    m_poseTo;
+    qint64        m_poseStartMs    = 0;
+    qint64        m_lastSampleMs   = -1;
+    double        m_sampleInterval = 33.0;   ///< ms, smoothed
+    QPointF       m_lastTrailPoint;
     hmi::InspectionPath m_currentPath;
     int m_highlightedIndex = -1;
 };
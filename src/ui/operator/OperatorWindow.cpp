@@ -7,7 +7,13 @@
 #include "RobotStatusWidget.h"
 #include "ControlPanel.h"
 #include "ResultPanel.h"
+#include "FleetStatusModel.h"
+#include "core/FleetClient.h"
+#include "core/FrameProfiler.h"
 
+#include <QEvent>
+#include <QHeaderView>
+#include <QTableView>
 #include <QToolBar>
 #include <QSplitter>
 #include <QVBoxLayout>
@@ -57,6 +63,18 @@ void OperatorWindow::setupUi()
     m_taskCard->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     vlay->addWidget(m_taskCard);
 
+    // Fleet overview, shown by setFleetClient()
+    m_fleetModel = new FleetStatusModel(this);
+    m_fleetTable = new QTableView(central);
+    m_fleetTable->setModel(m_fleetModel);
+    m_fleetTable->setSelectionMode(QAbstractItemView::NoSelection);
+    m_fleetTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_fleetTable->verticalHeader()->hide();
+    m_fleetTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_fleetTable->setMaximumHeight(160);
+    m_fleetTable->hide();
+    vlay->addWidget(m_fleetTable);
+
     // Middle: horizontal splitter – nav map left, robot status right
     QSplitter* midSplitter = new QSplitter(Qt::Horizontal, central);
     midSplitter->setChildrenCollapsible(false);
@@ -120,8 +138,15 @@ ResultPanel* OperatorWindow::resultPanel() const
 // Data routing
 // ---------------------------------------------------------------------------
 
+void OperatorWindow::setFleetClient(hmi::FleetClient* fleet)
+{
+    m_fleetModel->setFleet(fleet);
+    m_fleetTable->setVisible(fleet != nullptr);
+}
+
 void OperatorWindow::updateTaskStatus(const hmi::TaskStatus& status)
 {
+    hmi::ProfileScope profile("OperatorWindow::updateTaskStatus");
     m_taskCard->updateStatus(status);
     m_navMap->updateAgvPose(status.agv.currentPose);
     m_robotStatus->updateAgvStatus(status.agv);
@@ -134,6 +159,7 @@ void OperatorWindow::updateTaskStatus(const hmi::TaskStatus& status)
 
 void OperatorWindow::addEvent(const hmi::InspectionEvent& event)
 {
+    hmi::ProfileScope profile("OperatorWindow::addEvent");
     m_resultPanel->addEvent(event);
     if (event.type == hmi::InspectionEventType::Captured ||
         event.type == hmi::InspectionEventType::DefectFound)
@@ -141,3 +167,48 @@ void OperatorWindow::addEvent(const hmi::InspectionEvent& event)
         m_resultPanel->addCaptureEvent(event);
     }
 }
+
+void OperatorWindow::updateTaskStatus(const hmi::TaskStatusSnapshot& status)
+{
+    if (m_activity.offerStatus(status)) updateTaskStatus(*status);
+}
+
+void OperatorWindow::addEvent(const hmi::InspectionEventSnapshot& event)
+{
+    if (!m_eventFilter.accepts(*event)) return;
+    if (m_activity.offerEvent(event)) addEvent(*event);
+}
+
+// ---------------------------------------------------------------------------
+// View activity
+// ---------------------------------------------------------------------------
+
+void OperatorWindow::showEvent(QShowEvent* event)
+{
+    QMainWindow::showEvent(event);
+    updateActivity();
+}
+
+void OperatorWindow::hideEvent(QHideEvent* event)
+{
+    QMainWindow::hideEvent(event);
+    updateActivity();
+}
+
+void OperatorWindow::changeEvent(QEvent* event)
+{
+    QMainWindow::changeEvent(event);
+    if (event->type() == QEvent::WindowStateChange) updateActivity();
+}
+
+void OperatorWindow::updateActivity()
+{
+    if (!isVisible() || isMinimized()) {
+        m_activity.deactivate();
+        return;
+    }
+    hmi::ProfileScope profile("OperatorWindow::catchUp");
+    m_activity.activate(
+        [this](const hmi::TaskStatus& status) { updateTaskStatus(status); },
+        [this](const hmi::InspectionEvent& event) { addEvent(event); });
+}
@@ -6,9 +6,15 @@
 // -----------------------------------------------
 //   Toolbar        : "切换到工程师模式" action
 //   TaskCardWidget : task summary bar at the top
+//   Fleet table    : one row per robot (FleetStatusModel); only in fleet mode
 //   QSplitter      : NavMapWidget (left) | RobotStatusWidget (right)
 //   ControlPanel   : start / pause / resume / stop
 //   ResultPanel    : capture gallery + event timeline
+//
+// Stream updates arrive through the snapshot overloads of updateTaskStatus()
+// and addEvent().  While the window is hidden or minimised they are only
+// held (ViewActivity) and applied in one step when it is shown again.
+// Events outside eventFilter() are dropped before that.
 
 #pragma once
 
@@ -19,7 +25,12 @@
 
 #include "core/Types.h"
 
+namespace hmi { class FleetClient; }
+#include "ViewActivity.h"
+
 // Forward declarations
+class FleetStatusModel;
+class QTableView;
 class TaskCardWidget;
 class NavMapWidget;
 class RobotStatusWidget;
@@ -51,12 +62,34 @@ public:
     /// Append an inspection event to the result panel.
     void addEvent(const hmi::InspectionEvent& event);
 
+    /// Stream entry points: applied now while the window is on screen,
+    /// otherwise held until it is shown (latest status, bounded events).
+    void updateTaskStatus(const hmi::TaskStatusSnapshot& status);
+    void addEvent(const hmi::InspectionEventSnapshot& event);
+
+    /// Events the stream entry point passes on (default: every type, with
+    /// thumbnails for the capture gallery).
+    void setEventFilter(const hmi::InspectionEventFilter& filter) { m_eventFilter = filter; }
+    [[nodiscard]] const hmi::InspectionEventFilter& eventFilter() const { return m_eventFilter; }
+
+    [[nodiscard]] const ViewActivity& activity() const { return m_activity; }
+
+    /// Show the status of every robot of \a fleet in the fleet table (null:
+    /// hide it).  The single-robot widgets keep following updateTaskStatus().
+    void setFleetClient(hmi::FleetClient* fleet);
+
 signals:
     /// Emitted when the user activates "切换到工程师模式".
     void switchToEngineerMode();
 
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+    void changeEvent(QEvent* event) override;
+
 private:
     void setupUi();
+    void updateActivity();
 
     TaskCardWidget*    m_taskCard     = nullptr;
     NavMapWidget*      m_navMap       = nullptr;
@@ -64,4 +97,9 @@ private:
     ControlPanel*      m_controlPanel = nullptr;
     ResultPanel*       m_resultPanel  = nullptr;
     QAction*           m_switchModeAction = nullptr;
+    QTableView*        m_fleetTable   = nullptr;
+    FleetStatusModel*  m_fleetModel   = nullptr;
+
+    ViewActivity       m_activity;
+    hmi::InspectionEventFilter m_eventFilter;
 };
@@ -0,0 +1,468 @@
+// src/ui/operator/ResultExporter.cpp
+
+#include "ResultExporter.h"
+
+#include "CaptureDecoder.h"
+#include "core/GatewayClient.h"
+#include "core/MediaFetchManager.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageWriter>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+constexpr qint64 kProgressIntervalMs = 100;
+
+/// \a value as one CSV field (quoted when it contains a separator).
+QByteArray csvField(const QString& value)
+{
+    QByteArray out = value.toUtf8();
+    if (out.contains(',') || out.contains('"') || out.contains('\n') || out.contains('\r')) {
+        out.replace("\"", "\"\"");
+        out.prepend('"');
+        out.append('"');
+    }
+    return out;
+}
+
+QByteArray csvRow(std::initializer_list<QString> fields)
+{
+    QByteArray row;
+    for (const QString& field : fields) {
+        if (!row.isEmpty()) row += ',';
+        row += csvField(field);
+    }
+    row += '\n';
+    return row;
+}
+
+/// Compact serialization of \a object without its closing brace, so more
+/// members can be streamed after it.
+QByteArray openObject(const QJsonObject& object)
+{
+    QByteArray json = QJsonDocument(object).toJson(QJsonDocument::Compact);
+    json.chop(1);
+    return json;
+}
+
+bool hasVisibleDefect(const hmi::CaptureRecord& record)
+{
+    return std::any_of(record.defects.begin(), record.defects.end(),
+                       [](const hmi::DefectResult& d) { return d.hasDefect; });
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Construction
+// ---------------------------------------------------------------------------
+
+ResultExporter::ResultExporter(hmi::GatewayClient* client, hmi::MediaCache* cache,
+                               QObject* parent)
+    : QObject(parent)
+    , m_client(client)
+    , m_fetcher(new hmi::MediaFetchManager(client, this))
+{
+    m_fetcher->setCache(cache);
+    m_fetcher->setMaxConcurrent(kDownloadStreams);
+    connect(m_fetcher, &hmi::MediaFetchManager::fetched, this, &ResultExporter::onFetched);
+    if (client) {
+        connect(client, &hmi::GatewayClient::connectionStateChanged, this, [this](bool connected) {
+            if (!connected && m_running) {
+                finish({ hmi::ErrorCode::Unavailable, QStringLiteral("Disconnected") });
+            }
+        });
+    }
+}
+
+ResultExporter::~ResultExporter()
+{
+    if (m_running) {
+        cancel();
+    }
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+// ---------------------------------------------------------------------------
+// Control
+// ---------------------------------------------------------------------------
+
+bool ResultExporter::start(const QString& taskId, const Options& options, QString* error)
+{
+    const auto fail = [error](const QString& message) {
+        if (error) *error = message;
+        return false;
+    };
+    if (m_running) {
+        return fail(QStringLiteral("An export is already running"));
+    }
+    if (!m_client) {
+        return fail(QStringLiteral("No gateway client"));
+    }
+
+    const QDir dir(options.outputDir);
+    if (options.outputDir.isEmpty() || !dir.mkpath(QStringLiteral("images"))) {
+        return fail(QStringLiteral("Cannot create %1").arg(options.outputDir));
+    }
+    m_csv.setFileName(dir.filePath(QStringLiteral("captures.csv")));
+    m_json.setFileName(dir.filePath(QStringLiteral("report.json")));
+    if (!m_csv.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return fail(m_csv.errorString());
+    }
+    if (!m_json.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_csv.close();
+        return fail(m_json.errorString());
+    }
+
+    m_running       = true;
+    ++m_generation;
+    m_taskId        = taskId;
+    m_options       = options;
+    m_options.pageSize    = std::max(1, options.pageSize);
+    m_options.maxInFlight = std::max(1, options.maxInFlight);
+    m_pool.setMaxThreadCount(options.threads > 0
+                                 ? options.threads
+                                 : std::max(1, QThread::idealThreadCount() - 1));
+
+    m_nextPageToken.clear();
+    m_pageInFlight    = false;
+    m_listingDone     = false;
+    m_listed          = 0;
+    m_queue.clear();
+    m_waiting.clear();
+    m_inFlight        = 0;
+    m_firstJsonRecord = true;
+    m_summary         = Summary();
+    m_summary.taskId    = taskId;
+    m_summary.outputDir = dir.absolutePath();
+    m_lastProgressMs  = -1;
+    m_clock.start();
+
+    // UTF-8 BOM: spreadsheet tools otherwise misread Chinese defect types.
+    m_csv.write("\xEF\xBB\xBF");
+    m_csv.write(csvRow({ QStringLiteral("task_id"), QStringLiteral("point_id"),
+                         QStringLiteral("capture_id"), QStringLiteral("camera_id"),
+                         QStringLiteral("captured_at"), QStringLiteral("image"),
+                         QStringLiteral("defect_type"), QStringLiteral("confidence"),
+                         QStringLiteral("bbox_x"), QStringLiteral("bbox_y"),
+                         QStringLiteral("bbox_w"), QStringLiteral("bbox_h") }));
+    m_json.write(openObject({
+        { QStringLiteral("task_id"),     taskId },
+        { QStringLiteral("exported_at"),
+          QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs) },
+    }));
+    m_json.write(",\"captures\":[");
+
+    requestPage();
+    return true;
+}
+
+void ResultExporter::cancel()
+{
+    if (m_running) {
+        finish({ hmi::ErrorCode::Unspecified, QStringLiteral("Cancelled") });
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Listing
+// ---------------------------------------------------------------------------
+
+void ResultExporter::requestPage()
+{
+    hmi::CaptureListOptions listOptions;
+    listOptions.includeThumbnails = false;   // images come through the fetcher
+    listOptions.pageSize          = m_options.pageSize;
+
+    m_pageInFlight = true;
+    QPointer<ResultExporter> self(this);
+    const int generation = m_generation;
+    m_client->fetchCapturePage(
+        m_taskId, m_options.pointId, listOptions, m_nextPageToken,
+        [self, generation](const hmi::Result& result, QVector<hmi::CaptureRecord> page,
+                           QString nextPageToken) {
+            if (self && self->m_running && self->m_generation == generation) {
+                self->onPage(result, std::move(page), nextPageToken);
+            }
+        });
+}
+
+void ResultExporter::onPage(const hmi::Result& result, QVector<hmi::CaptureRecord> page,
+                            const QString& nextPageToken)
+{
+    m_pageInFlight = false;
+    if (!result.ok()) {
+        finish(result);
+        return;
+    }
+
+    m_listed += page.size();
+    for (auto& record : page) {
+        m_queue.push_back(std::move(record));
+    }
+    m_nextPageToken = nextPageToken;
+    m_listingDone   = nextPageToken.isEmpty();
+    reportProgress(false);
+    pump();
+}
+
+// ---------------------------------------------------------------------------
+// Pipeline
+// ---------------------------------------------------------------------------
+
+void ResultExporter::pump()
+{
+    if (!m_running) return;
+
+    while (m_inFlight < m_options.maxInFlight && !m_queue.empty()) {
+        hmi::CaptureRecord record = std::move(m_queue.front());
+        m_queue.pop_front();
+        startRecord(std::move(record));
+        if (!m_running) return;
+    }
+
+    // Keep the next page on its way while half a page is still queued.
+    if (!m_listingDone && !m_pageInFlight
+        && static_cast<int>(m_queue.size()) < m_options.pageSize / 2 + 1) {
+        requestPage();
+    }
+
+    if (m_listingDone && !m_pageInFlight && m_queue.empty() && m_inFlight == 0) {
+        finish({ hmi::ErrorCode::Ok, {} });
+    }
+}
+
+void ResultExporter::startRecord(hmi::CaptureRecord record)
+{
+    const hmi::MediaRef media = record.image.media;
+    if (!m_options.images || media.mediaId.isEmpty()) {
+        writeRecord(record, {});
+        return;
+    }
+
+    ++m_inFlight;
+    // Several records may share one image; one download serves them all.
+    auto& waiting = m_waiting[media.mediaId];
+    waiting.append(std::move(record));
+    if (waiting.size() == 1) {
+        m_fetcher->request(media, hmi::MediaFetchManager::Priority::Prefetch);
+    }
+}
+
+void ResultExporter::onFetched(const hmi::Result& result, const hmi::MediaPayload& payload)
+{
+    if (!m_running) return;
+    const QList<hmi::CaptureRecord> records = m_waiting.take(payload.mediaId);
+    for (const auto& record : records) {
+        if (result.ok() && !payload.data.isEmpty()) {
+            render(record, payload.data);
+        } else {
+            ++m_summary.imageFailures;
+            --m_inFlight;
+            writeRecord(record, {});
+        }
+    }
+    pump();
+}
+
+void ResultExporter::render(hmi::CaptureRecord record, const QByteArray& encoded)
+{
+    const bool reencode = m_options.imageSize.isValid()
+                          || (m_options.overlay && hasVisibleDefect(record));
+    const QString relativePath = imagePathFor(record, reencode);
+    const QString path = QDir(m_summary.outputDir).filePath(relativePath);
+    const int generation = m_generation;
+    Options options = m_options;
+    if (!reencode) {
+        options.overlay = false;
+    }
+
+    m_pool.start([this, generation, record = std::move(record), encoded, options,
+                  relativePath, path]() {
+        Rendered rendered = renderToFile(record, encoded, options, relativePath, path);
+        // The pool is drained in the destructor, so `this` outlives the task.
+        QMetaObject::invokeMethod(this,
+            [this, generation, record, rendered = std::move(rendered)]() {
+                if (m_running && generation == m_generation) {
+                    onRendered(record, rendered);
+                }
+            }, Qt::QueuedConnection);
+    });
+}
+
+void ResultExporter::onRendered(const hmi::CaptureRecord& record, const Rendered& rendered)
+{
+    --m_inFlight;
+    if (rendered.ok) {
+        ++m_summary.imagesWritten;
+        m_summary.imageBytes += rendered.bytes;
+    } else {
+        ++m_summary.imageFailures;
+    }
+    writeRecord(record, rendered.relativePath);
+    pump();
+}
+
+// ---------------------------------------------------------------------------
+// Rendering (worker thread)
+// ---------------------------------------------------------------------------
+
+ResultExporter::Rendered ResultExporter::renderToFile(const hmi::CaptureRecord& record,
+                                                      const QByteArray& encoded,
+                                                      const Options& options,
+                                                      const QString& relativePath,
+                                                      const QString& path)
+{
+    const bool reencode = options.imageSize.isValid() || options.overlay;
+    if (!reencode) {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(encoded) != encoded.size()) {
+            return {};
+        }
+        return { true, relativePath, encoded.size() };
+    }
+
+    CaptureDecoder::Request request{
+        record.captureId, encoded, options.imageSize,
+        QSize(static_cast<int>(record.image.width), static_cast<int>(record.image.height)),
+        options.overlay ? record.defects : QVector<hmi::DefectResult>() };
+    const QImage image = CaptureDecoder::render(request);
+    if (image.isNull()) {
+        return {};
+    }
+
+    QImageWriter writer(path, "jpg");
+    writer.setQuality(options.jpegQuality);
+    if (!writer.write(image)) {
+        return {};
+    }
+    return { true, relativePath, QFileInfo(path).size() };
+}
+
+QString ResultExporter::imagePathFor(const hmi::CaptureRecord& record, bool reencode)
+{
+    QString id = record.captureId.isEmpty() ? record.image.media.mediaId : record.captureId;
+    for (QChar& c : id) {
+        if (!c.isLetterOrNumber() && c != QLatin1Char('-') && c != QLatin1Char('_')) {
+            c = QLatin1Char('_');
+        }
+    }
+    const bool png = !reencode
+        && record.image.media.mimeType.compare(QLatin1String("image/png"), Qt::CaseInsensitive) == 0;
+    return QStringLiteral("images/p%1_%2.%3")
+        .arg(record.pointId).arg(id, png ? QStringLiteral("png") : QStringLiteral("jpg"));
+}
+
+// ---------------------------------------------------------------------------
+// Report files
+// ---------------------------------------------------------------------------
+
+void ResultExporter::writeRecord(const hmi::CaptureRecord& record, const QString& image)
+{
+    const QString pointId    = QString::number(record.pointId);
+    const QString capturedAt = record.capturedAt.toString(Qt::ISODateWithMs);
+
+    QJsonArray defects;
+    QByteArray rows;
+    for (const auto& defect : record.defects) {
+        if (!defect.hasDefect) continue;
+        ++m_summary.defects;
+        ++m_summary.defectsByType[defect.defectType];
+        rows += csvRow({ m_taskId, pointId, record.captureId, record.cameraId, capturedAt, image,
+                         defect.defectType, QString::number(defect.confidence, 'f', 3),
+                         QString::number(defect.bbox.x), QString::number(defect.bbox.y),
+                         QString::number(defect.bbox.w), QString::number(defect.bbox.h) });
+        defects.append(QJsonObject{
+            { QStringLiteral("type"),       defect.defectType },
+            { QStringLiteral("confidence"), defect.confidence },
+            { QStringLiteral("bbox"),       QJsonArray{ defect.bbox.x, defect.bbox.y,
+                                                        defect.bbox.w, defect.bbox.h } },
+        });
+    }
+    if (rows.isEmpty()) {
+        rows = csvRow({ m_taskId, pointId, record.captureId, record.cameraId, capturedAt, image,
+                        {}, {}, {}, {}, {}, {} });
+    } else {
+        ++m_summary.defectiveCaptures;
+    }
+    ++m_summary.captures;
+    m_csv.write(rows);
+
+    const QJsonObject object{
+        { QStringLiteral("point_id"),    record.pointId },
+        { QStringLiteral("capture_id"),  record.captureId },
+        { QStringLiteral("camera_id"),   record.cameraId },
+        { QStringLiteral("captured_at"), capturedAt },
+        { QStringLiteral("image"),       image.isEmpty() ? QJsonValue() : QJsonValue(image) },
+        { QStringLiteral("width"),       static_cast<qint64>(record.image.width) },
+        { QStringLiteral("height"),      static_cast<qint64>(record.image.height) },
+        { QStringLiteral("defects"),     defects },
+    };
+    if (!m_firstJsonRecord) {
+        m_json.write(",");
+    }
+    m_firstJsonRecord = false;
+    m_json.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+
+    reportProgress(false);
+}
+
+void ResultExporter::finish(const hmi::Result& result)
+{
+    m_running = false;
+    ++m_generation;   // drops renders still running
+    m_queue.clear();
+    m_waiting.clear();
+    m_inFlight = 0;
+    m_fetcher->cancelAll();
+    m_pool.clear();
+
+    m_summary.elapsedMs = m_clock.elapsed();
+    reportProgress(true);
+
+    QJsonObject byType;
+    for (auto it = m_summary.defectsByType.cbegin(); it != m_summary.defectsByType.cend(); ++it) {
+        byType.insert(it.key(), it.value());
+    }
+    const QJsonObject summary{
+        { QStringLiteral("complete"),           result.ok() },
+        { QStringLiteral("message"),            result.message },
+        { QStringLiteral("captures"),           m_summary.captures },
+        { QStringLiteral("defective_captures"), m_summary.defectiveCaptures },
+        { QStringLiteral("defects"),            m_summary.defects },
+        { QStringLiteral("defects_by_type"),    byType },
+        { QStringLiteral("images_written"),     m_summary.imagesWritten },
+        { QStringLiteral("image_failures"),     m_summary.imageFailures },
+        { QStringLiteral("image_bytes"),        m_summary.imageBytes },
+        { QStringLiteral("elapsed_ms"),         m_summary.elapsedMs },
+    };
+    m_json.write("],\"summary\":");
+    m_json.write(QJsonDocument(summary).toJson(QJsonDocument::Compact));
+    m_json.write("}\n");
+    m_json.close();
+    m_csv.close();
+
+    emit finished(result, m_summary);
+}
+
+void ResultExporter::reportProgress(bool force)
+{
+    const qint64 now = m_clock.elapsed();
+    if (!force && m_lastProgressMs >= 0 && now - m_lastProgressMs < kProgressIntervalMs) {
+        return;
+    }
+    m_lastProgressMs = now;
+    emit progress(m_summary.captures, m_listed);
+}
@@ -0,0 +1,179 @@
+// src/ui/operator/ResultExporter.h
+//
+// ResultExporter – offline export of one task's results: the capture images
+// with their defect overlays, plus a defect list (CSV) and a task report
+// (JSON) in an output directory.
+//
+// Output layout:
+//
+//   <outputDir>/captures.csv   one row per defect (a capture without defects
+//                              has one row with empty defect columns)
+//   <outputDir>/report.json    { task_id, exported_at, captures: [...],
+//                                summary: {...} }
+//   <outputDir>/images/p<pointId>_<captureId>.jpg
+//
+// Pipeline
+// --------
+// Capture records are pulled one ListCaptures page at a time
+// (GatewayClient::fetchCapturePage(), metadata only); the next page is only
+// requested when fewer than half a page is left to process.  Images go
+// through a private MediaFetchManager on the same client and MediaCache, so
+// images already viewed are read from disk instead of downloaded, and the
+// export never queues ahead of the operator's own gallery requests.  Each
+// payload is rendered on a thread pool with CaptureDecoder::render() – the
+// same overlay the gallery draws – and written there; an image that needs
+// neither an overlay nor rescaling is written as received.  At most
+// maxInFlight records are downloading or rendering, so memory stays
+// bounded by roughly 1.5 pages of metadata plus maxInFlight images,
+// whatever the task size.
+//
+// The CSV and JSON are appended on the GUI thread as each record completes
+// (completion order, not listing order); nothing but counters is kept for
+// the summary written at the end.
+//
+// Thread safety: GUI thread only; progress() and finished() are emitted on
+// the GUI thread.
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+
+#include <deque>
+
+namespace hmi {
+class GatewayClient;
+class MediaCache;
+class MediaFetchManager;
+}
+
+class ResultExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString outputDir;            ///< created if missing
+        int32_t pointId     = 0;      ///< 0 = every point of the task
+        bool    images      = true;   ///< write the capture images
+        bool    overlay     = true;   ///< draw the defect boxes into them
+        QSize   imageSize;            ///< fit inside, keep aspect; invalid = native
+        int     jpegQuality = 90;
+        int     pageSize    = 200;    ///< records per ListCaptures page
+        int     maxInFlight = 8;      ///< records downloading or rendering at once
+        int     threads     = 0;      ///< render workers (0 → idealThreadCount - 1)
+    };
+
+    /// Counters of one export, written to report.json and reported by
+    /// finished().
+    struct Summary {
+        QString            taskId;
+        QString            outputDir;
+        int                captures          = 0;
+        int                defectiveCaptures = 0;
+        int                defects           = 0;
+        QMap<QString, int> defectsByType;
+        int                imagesWritten     = 0;
+        int                imageFailures     = 0;
+        qint64             imageBytes        = 0;
+        qint64             elapsedMs         = 0;
+    };
+
+    /// Parallel DownloadMedia streams of the exporter's fetch manager.
+    static constexpr int kDownloadStreams = 4;
+
+    /// Exports through \a client; \a cache (may be null) serves and stores
+    /// the images.  Neither is owned.
+    explicit ResultExporter(hmi::GatewayClient* client, hmi::MediaCache* cache = nullptr,
+                            QObject* parent = nullptr);
+
+    /// Cancels a running export and waits for its render workers.
+    ~ResultExporter() override;
+
+    /// Start exporting \a taskId.  Returns false with \a error set when an
+    /// export is already running or the output files cannot be created.
+    bool start(const QString& taskId, const Options& options, QString* error = nullptr);
+
+    /// Stop the running export; finished() reports ErrorCode::Unspecified
+    /// with message "Cancelled".  The files written so far are kept.
+    void cancel();
+
+    [[nodiscard]] bool isRunning() const { return m_running; }
+
+signals:
+    /// \a done records written of \a listed received so far; \a listed is
+    /// final once the last page has arrived.  At most every 100 ms.
+    void progress(int done, int listed);
+
+    void finished(hmi::Result result, ResultExporter::Summary summary);
+
+private:
+    /// One finished render (GUI thread).
+    struct Rendered {
+        bool    ok = false;
+        QString relativePath;   ///< below outputDir; empty on failure
+        qint64  bytes = 0;
+    };
+
+    void requestPage();
+    void onPage(const hmi::Result& result, QVector<hmi::CaptureRecord> page,
+                const QString& nextPageToken);
+
+    /// Start records while fewer than maxInFlight are in flight, refill the
+    /// queue and finish once everything is written.
+    void pump();
+    void startRecord(hmi::CaptureRecord record);
+    void onFetched(const hmi::Result& result, const hmi::MediaPayload& payload);
+    void render(hmi::CaptureRecord record, const QByteArray& encoded);
+    void onRendered(const hmi::CaptureRecord& record, const Rendered& rendered);
+
+    /// Append \a record's CSV rows and JSON object; \a image is relative to
+    /// outputDir, empty when no image was written.
+    void writeRecord(const hmi::CaptureRecord& record, const QString& image);
+
+    void finish(const hmi::Result& result);
+    void reportProgress(bool force);
+
+    /// Worker thread: write \a encoded (or its rendering) to \a path.
+    static Rendered renderToFile(const hmi::CaptureRecord& record, const QByteArray& encoded,
+                                 const Options& options, const QString& relativePath,
+                                 const QString& path);
+
+    /// images/p<pointId>_<captureId>.<ext>, with unsafe characters replaced.
+    static QString imagePathFor(const hmi::CaptureRecord& record, bool reencode);
+
+    QPointer<hmi::GatewayClient> m_client;
+    hmi::MediaFetchManager*      m_fetcher = nullptr;   ///< child
+    QThreadPool                  m_pool;
+
+    bool    m_running    = false;
+    int     m_generation = 0;   ///< bumped per export; stale renders are dropped
+    QString m_taskId;
+    Options m_options;
+
+    QString m_nextPageToken;
+    bool    m_pageInFlight = false;
+    bool    m_listingDone  = false;
+    int     m_listed       = 0;
+
+    std::deque<hmi::CaptureRecord>            m_queue;     ///< listed, not started
+    QHash<QString, QList<hmi::CaptureRecord>> m_waiting;   ///< by mediaId, downloading
+    int                                       m_inFlight = 0;
+
+    QFile         m_csv;
+    QFile         m_json;
+    bool          m_firstJsonRecord = true;
+    Summary       m_summary;
+    QElapsedTimer m_clock;
+    qint64        m_lastProgressMs = -1;
+};
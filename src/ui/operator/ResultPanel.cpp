@@ -2,13 +2,43 @@
 
 #include "ResultPanel.h"
 
+#include "CaptureDecoder.h"
+#include "CaptureGalleryDelegate.h"
+#include "CaptureGalleryModel.h"
+#include "EventLogModel.h"
+#include "EventTimelineView.h"
+#include "core/FrameProfiler.h"
+#include "core/MediaCache.h"
+#include "core/StartupTimeline.h"
+
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QSplitter>
 #include <QScrollArea>
-#include <QPainter>
 #include <QDateTime>
 
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+QVector<CaptureGalleryModel::Capture> toCaptures(const QVector<hmi::CaptureRecord>& records)
+{
+    QVector<CaptureGalleryModel::Capture> captures;
+    captures.reserve(records.size());
+    for (const auto& record : records) {
+        CaptureGalleryModel::Capture capture;
+        capture.captureId = record.captureId;
+        capture.pointId   = record.pointId;
+        capture.image     = record.image;
+        capture.defects   = record.defects;
+        captures.append(std::move(capture));
+    }
+    return captures;
+}
+
+} // anonymous namespace
+
 // ---------------------------------------------------------------------------
 // Construction
 // ---------------------------------------------------------------------------
@@ -16,22 +46,49 @@
 ResultPanel::ResultPanel(QWidget* parent)
     : QWidget(parent)
 {
-    setupUi();
+    // The models hold every capture and event from the start; the views are
+    // built by ensureContents().
+    const QSize thumbSize(kThumbnailWidth, kThumbnailHeight);
+    m_galleryModel = new CaptureGalleryModel(this);
+    m_galleryModel->setThumbnailSize(thumbSize);
+    connect(m_galleryModel, &CaptureGalleryModel::thumbnailMediaRequested,
+            this, &ResultPanel::thumbnailImageRequested);
+
+    m_eventModel = new EventLogModel(EventLogModel::kDefaultCapacity, this);
+
+    // Thumbnails are decoded by the gallery model's pool; the detail image
+    // has its own worker so a burst of thumbnails never delays the image the
+    // operator clicked.
+    m_detailDecoder = new CaptureDecoder(1, this);
+    connect(m_detailDecoder, &CaptureDecoder::decoded,
+            this, &ResultPanel::onDetailDecoded);
+
+    QVBoxLayout* vlay = new QVBoxLayout(this);
+    vlay->setContentsMargins(0, 0, 0, 0);
 }
 
 // ---------------------------------------------------------------------------
 // UI setup
 // ---------------------------------------------------------------------------
 
-void ResultPanel::setupUi()
+void ResultPanel::ensureContents()
 {
-    QVBoxLayout* vlay = new QVBoxLayout(this);
-    vlay->setContentsMargins(0, 0, 0, 0);
+    if (m_tabs) {
+        return;
+    }
+    hmi::StartupScope phase("ResultPanel contents");
 
     m_tabs = new QTabWidget(this);
     m_tabs->addTab(createGalleryTab(), QStringLiteral("抓拍结果"));
     m_tabs->addTab(createTimelineTab(), QStringLiteral("事件时间轴"));
-    vlay->addWidget(m_tabs);
+    layout()->addWidget(m_tabs);
+    m_tabs->show();   // may be added from the panel's own showEvent
+}
+
+void ResultPanel::showEvent(QShowEvent* event)
+{
+    ensureContents();   // before the first paint
+    QWidget::showEvent(event);
 }
 
 QWidget* ResultPanel::createGalleryTab()
@@ -41,14 +98,21 @@ QWidget* ResultPanel::createGalleryTab()
     hlay->setContentsMargins(4, 4, 4, 4);
     hlay->setSpacing(4);
 
-    // Left: thumbnail list (icon mode)
-    m_thumbnailList = new QListWidget(tab);
-    m_thumbnailList->setViewMode(QListWidget::IconMode);
-    m_thumbnailList->setIconSize(QSize(120, 90));
-    m_thumbnailList->setResizeMode(QListWidget::Adjust);
-    m_thumbnailList->setSpacing(8);
-    m_thumbnailList->setUniformItemSizes(false);
-    hlay->addWidget(m_thumbnailList, 1);
+    // Left: virtualized thumbnail grid (icon mode, uniform cells)
+    const QSize thumbSize(kThumbnailWidth, kThumbnailHeight);
+    m_galleryView = new QListView(tab);
+    m_galleryView->setModel(m_galleryModel);
+    m_galleryView->setItemDelegate(new CaptureGalleryDelegate(thumbSize, m_galleryView));
+    m_galleryView->setViewMode(QListView::IconMode);
+    m_galleryView->setIconSize(thumbSize);
+    m_galleryView->setResizeMode(QListView::Adjust);
+    m_galleryView->setMovement(QListView::Static);
+    m_galleryView->setSpacing(8);
+    m_galleryView->setUniformItemSizes(true);
+    m_galleryView->setLayoutMode(QListView::Batched);
+    m_galleryView->setBatchSize(200);
+    m_galleryView->setSelectionMode(QAbstractItemView::SingleSelection);
+    hlay->addWidget(m_galleryView, 1);
 
     // Right: detail view
     QWidget* detailPane = new QWidget(tab);
@@ -79,51 +143,15 @@ QWidget* ResultPanel::createGalleryTab()
     hlay->addWidget(detailPane, 0);
 
     // Connect thumbnail click to detail view
-    connect(m_thumbnailList, &QListWidget::itemClicked, this, [this](QListWidgetItem* item) {
-        QString captureId = item->data(Qt::UserRole).toString();
-        if (!m_captures.contains(captureId)) {
+    connect(m_galleryView, &QListView::clicked, this, [this](const QModelIndex& index) {
+        const auto* capture = m_galleryModel->captureAt(index.row());
+        if (!capture) {
             return;
         }
 
-        const CaptureInfo& info = m_captures[captureId];
-        emit captureSelected(captureId);
-
-        // Show full image if available, otherwise thumbnail
-        QPixmap displayImage = info.fullImage.isNull() ? info.thumbnail : info.fullImage;
-        if (!displayImage.isNull()) {
-            // Scale to fit label while keeping aspect ratio
-            QPixmap scaled = displayImage.scaled(
-                m_detailImage->size(),
-                Qt::KeepAspectRatio,
-                Qt::SmoothTransformation
-            );
-            m_detailImage->setPixmap(scaled);
-        }
-
-        // Show defect info
-        QString defectText;
-        if (info.defects.isEmpty()) {
-            defectText = QStringLiteral("点位 %1\n未发现缺陷").arg(info.pointId);
-        } else {
-            defectText = QStringLiteral("点位 %1\n发现 %2 个缺陷:\n")
-                .arg(info.pointId)
-                .arg(info.defects.size());
-            for (int i = 0; i < info.defects.size(); ++i) {
-                const auto& defect = info.defects[i];
-                defectText += QStringLiteral("\n%1. 类型: %2, 置信度: %3%")
-                    .arg(i + 1)
-                    .arg(defect.defectType)
-                    .arg(static_cast<int>(defect.confidence * 100));
-            }
-        }
-        m_defectInfoLabel->setText(defectText);
-
-        // If full image not yet loaded, request download
-        if (info.fullImage.isNull() && !info.captureId.isEmpty()) {
-            // Assume the media ID is embedded in the event; for now we'll just use captureId
-            // In a real implementation, you'd extract the mediaId from the ImageRef
-            // emit downloadImageRequested(info.image.media.mediaId);
-        }
+        emit captureSelected(capture->captureId);
+        showCaptureDetail(index.row());
+        requestImages(index.row());
     });
 
     return tab;
@@ -135,7 +163,8 @@ QWidget* ResultPanel::createTimelineTab()
     QVBoxLayout* vlay = new QVBoxLayout(tab);
     vlay->setContentsMargins(4, 4, 4, 4);
 
-    m_eventTimeline = new QListWidget(tab);
+    m_eventTimeline = new EventTimelineView(tab);
+    m_eventTimeline->setEventModel(m_eventModel);
     m_eventTimeline->setAlternatingRowColors(true);
     vlay->addWidget(m_eventTimeline);
 
@@ -143,80 +172,134 @@ QWidget* ResultPanel::createTimelineTab()
 }
 
 // ---------------------------------------------------------------------------
-// Data updates
+// Detail view
 // ---------------------------------------------------------------------------
 
-void ResultPanel::addCaptureEvent(const hmi::InspectionEvent& event)
+void ResultPanel::showCaptureDetail(int row)
 {
-    if (event.captureId.isEmpty()) {
+    const auto* capture = m_galleryModel->captureAt(row);
+    if (!capture) {
         return;
     }
+    m_selectedCaptureId = capture->captureId;
 
-    // Create or update capture info
-    CaptureInfo info;
-    info.captureId = event.captureId;
-    info.pointId = event.pointId;
-    info.defects = event.defects;
-
-    // Render thumbnail with defects
-    if (!event.image.thumbnailJpeg.isEmpty()) {
-        info.thumbnail = renderThumbnailWithDefects(
-            event.image.thumbnailJpeg,
-            event.defects,
-            static_cast<int>(event.image.width),
-            static_cast<int>(event.image.height)
+    // Show full image if available, otherwise thumbnail
+    QPixmap displayImage = fullImageOf(capture->image.media);
+    if (displayImage.isNull()) {
+        displayImage = m_galleryModel->cachedThumbnail(row);
+    }
+    if (!displayImage.isNull()) {
+        // Scale to fit label while keeping aspect ratio
+        QPixmap scaled = displayImage.scaled(
+            m_detailImage->size(),
+            Qt::KeepAspectRatio,
+            Qt::SmoothTransformation
         );
+        m_detailImage->setPixmap(scaled);
     }
 
-    m_captures[event.captureId] = info;
-
-    // Add to thumbnail list
-    QListWidgetItem* item = new QListWidgetItem(m_thumbnailList);
-    item->setText(QStringLiteral("点位 %1").arg(event.pointId));
-    if (!info.thumbnail.isNull()) {
-        item->setIcon(QIcon(info.thumbnail));
+    // Show defect info
+    QString defectText;
+    if (capture->defects.isEmpty()) {
+        defectText = QStringLiteral("点位 %1\n未发现缺陷").arg(capture->pointId);
+    } else {
+        defectText = QStringLiteral("点位 %1\n发现 %2 个缺陷:\n")
+            .arg(capture->pointId)
+            .arg(capture->defects.size());
+        for (int i = 0; i < capture->defects.size(); ++i) {
+            const auto& defect = capture->defects[i];
+            defectText += QStringLiteral("\n%1. 类型: %2, 置信度: %3%")
+                .arg(i + 1)
+                .arg(defect.defectType)
+                .arg(static_cast<int>(defect.confidence * 100));
+        }
     }
-    item->setData(Qt::UserRole, event.captureId);
+    m_defectInfoLabel->setText(defectText);
+}
+
+void ResultPanel::setMediaCache(hmi::MediaCache* cache)
+{
+    m_mediaCache = cache;
+    m_fullImages.clear();
+}
+
+void ResultPanel::setPrefetchDepth(int neighbours)
+{
+    m_prefetchDepth = std::max(0, neighbours);
+}
 
-    // Color code by defect presence
-    if (!event.defects.isEmpty()) {
-        item->setBackground(QBrush(QColor("#ffe5e5")));  // light red
+QPixmap ResultPanel::fullImageOf(const hmi::MediaRef& media) const
+{
+    const QString key = hmi::MediaCache::keyFor(media);
+    if (m_mediaCache) {
+        return m_mediaCache->pixmap(key);
     }
+    const QPixmap* pm = m_fullImages.object(key);
+    return pm ? *pm : QPixmap();
 }
 
-void ResultPanel::setCaptureRecords(const QVector<hmi::CaptureRecord>& records)
+bool ResultPanel::hasFullImage(const hmi::MediaRef& media) const
 {
-    m_captures.clear();
-    m_thumbnailList->clear();
+    const QString key = hmi::MediaCache::keyFor(media);
+    return m_mediaCache ? m_mediaCache->containsPixmap(key) : m_fullImages.contains(key);
+}
 
-    for (const auto& record : records) {
-        CaptureInfo info;
-        info.captureId = record.captureId;
-        info.pointId = record.pointId;
-        info.defects = record.defects;
-
-        if (!record.image.thumbnailJpeg.isEmpty()) {
-            info.thumbnail = renderThumbnailWithDefects(
-                record.image.thumbnailJpeg,
-                record.defects,
-                static_cast<int>(record.image.width),
-                static_cast<int>(record.image.height)
-            );
+void ResultPanel::requestImages(int row)
+{
+    auto wanted = [this](int r) -> const hmi::MediaRef* {
+        const auto* capture = m_galleryModel->captureAt(r);
+        if (!capture || capture->image.media.mediaId.isEmpty()
+            || hasFullImage(capture->image.media)) {
+            return nullptr;
         }
+        return &capture->image.media;
+    };
 
-        m_captures[record.captureId] = info;
+    // Full image of the clicked capture first ...
+    if (const hmi::MediaRef* media = wanted(row)) {
+        emit downloadImageRequested(*media);
+    }
 
-        QListWidgetItem* item = new QListWidgetItem(m_thumbnailList);
-        item->setText(QStringLiteral("点位 %1").arg(record.pointId));
-        if (!info.thumbnail.isNull()) {
-            item->setIcon(QIcon(info.thumbnail));
+    // ... then the neighbours, nearest first.
+    for (int d = 1; d <= m_prefetchDepth; ++d) {
+        for (int r : { row + d, row - d }) {
+            if (const hmi::MediaRef* media = wanted(r)) {
+                emit prefetchImageRequested(*media);
+            }
         }
-        item->setData(Qt::UserRole, record.captureId);
+    }
+}
 
-        if (!record.defects.isEmpty()) {
-            item->setBackground(QBrush(QColor("#ffe5e5")));
-        }
+// ---------------------------------------------------------------------------
+// Data updates
+// ---------------------------------------------------------------------------
+
+void ResultPanel::addCaptureEvent(const hmi::InspectionEvent& event)
+{
+    hmi::ProfileScope profile("ResultPanel::addCaptureEvent");
+    if (event.captureId.isEmpty()) {
+        return;
     }
+
+    CaptureGalleryModel::Capture capture;
+    capture.captureId = event.captureId;
+    capture.pointId   = event.pointId;
+    capture.image     = event.image;
+    capture.defects   = event.defects;
+    m_galleryModel->addCapture(capture);   // one beginInsertRows per capture
+}
+
+void ResultPanel::setCaptureRecords(const QVector<hmi::CaptureRecord>& records)
+{
+    m_detailDecoder->cancelAll();
+    m_selectedCaptureId.clear();
+    m_galleryModel->setCaptures(toCaptures(records));
+}
+
+void ResultPanel::appendCaptureRecords(const QVector<hmi::CaptureRecord>& records)
+{
+    hmi::ProfileScope profile("ResultPanel::appendCaptureRecords");
+    m_galleryModel->appendCaptures(toCaptures(records));   // one row insertion per page
 }
 
 void ResultPanel::addEvent(const hmi::InspectionEvent& event)
@@ -232,82 +315,68 @@ void ResultPanel::addEvent(const hmi::InspectionEvent& event)
         .arg(timeStr)
         .arg(event.message);
 
-    QListWidgetItem* item = new QListWidgetItem(text, m_eventTimeline);
-    item->setForeground(QBrush(QColor(color)));
-
-    m_eventTimeline->scrollToBottom();
+    m_eventModel->append(EventLogEntry{ event.timestamp, text, QColor(color) });
 }
 
 void ResultPanel::clear()
 {
-    m_captures.clear();
-    m_thumbnailList->clear();
-    m_eventTimeline->clear();
-    m_detailImage->clear();
-    m_defectInfoLabel->setText(QStringLiteral("点击缩略图查看详细信息"));
+    m_detailDecoder->cancelAll();
+    m_galleryModel->clear();
+    m_fullImages.clear();
+    m_selectedCaptureId.clear();
+    m_eventModel->clear();
+    if (m_detailImage) {
+        m_detailImage->clear();
+        m_defectInfoLabel->setText(QStringLiteral("点击缩略图查看详细信息"));
+    }
 }
 
-void ResultPanel::setFullImage(const QString& captureId, const QByteArray& imageData)
+void ResultPanel::setFullImage(const QString& mediaId, const QByteArray& imageData)
 {
-    if (!m_captures.contains(captureId)) {
+    const bool forThumbnail = m_galleryModel->setThumbnailSource(mediaId, imageData);
+    const auto* capture = m_galleryModel->captureAt(m_galleryModel->rowOfMedia(mediaId));
+    if (!capture) {
         return;
     }
-
-    QPixmap fullImage;
-    if (fullImage.loadFromData(imageData)) {
-        m_captures[captureId].fullImage = fullImage;
+    // Fetched only to draw a gallery cell: no detail decode unless open.
+    if (forThumbnail && capture->captureId != m_selectedCaptureId) {
+        return;
     }
+
+    // Decode straight to detail size; the frame is never expanded at full
+    // resolution only to be shown in the detail label.
+    const QSize labelPx = m_detailImage
+        ? m_detailImage->size() * m_detailImage->devicePixelRatioF() : QSize();
+    const QSize target = labelPx.expandedTo(kMinDetailDecodeSize);
+    m_detailDecoder->decode({ mediaId, imageData, target,
+                              capture->frameSize(), capture->defects });
 }
 
 // ---------------------------------------------------------------------------
-// Rendering
+// Decoder results
 // ---------------------------------------------------------------------------
 
-QPixmap ResultPanel::renderThumbnailWithDefects(const QByteArray& jpegData,
-                                                 const QVector<hmi::DefectResult>& defects,
-                                                 int imgW, int imgH)
+void ResultPanel::onDetailDecoded(const QString& mediaId, const QImage& image)
 {
-    Q_UNUSED(imgW)
-    Q_UNUSED(imgH)
-
-    QPixmap pixmap;
-    if (!pixmap.loadFromData(jpegData)) {
-        // Fallback: create a placeholder
-        pixmap = QPixmap(120, 90);
-        pixmap.fill(Qt::darkGray);
-        return pixmap;
+    const int row = m_galleryModel->rowOfMedia(mediaId);
+    const auto* capture = m_galleryModel->captureAt(row);
+    if (!capture || image.isNull()) {
+        return;
     }
 
-    // Draw bounding boxes on the pixmap
-    if (!defects.isEmpty()) {
-        QPainter painter(&pixmap);
-        painter.setRenderHint(QPainter::Antialiasing);
-
-        QPen pen(QColor("#ff0000"), 2, Qt::SolidLine);
-        painter.setPen(pen);
-        painter.setBrush(Qt::NoBrush);
-
-        for (const auto& defect : defects) {
-            if (defect.hasDefect) {
-                QRect rect(defect.bbox.x, defect.bbox.y, defect.bbox.w, defect.bbox.h);
-                painter.drawRect(rect);
-
-                // Draw confidence label
-                QString label = QStringLiteral("%1%").arg(static_cast<int>(defect.confidence * 100));
-                QFont font = painter.font();
-                font.setPointSize(8);
-                font.setBold(true);
-                painter.setFont(font);
-                painter.setBrush(QBrush(QColor(255, 0, 0, 180)));
-                QRect labelRect(rect.x(), rect.y() - 16, 40, 14);
-                painter.fillRect(labelRect, painter.brush());
-                painter.setPen(Qt::white);
-                painter.drawText(labelRect, Qt::AlignCenter, label);
-            }
-        }
+    const QPixmap fullImage = QPixmap::fromImage(image);
+    const QString key = hmi::MediaCache::keyFor(capture->image.media);
+    if (m_mediaCache) {
+        m_mediaCache->insertPixmap(key, fullImage);
+    } else {
+        const qint64 bytes = static_cast<qint64>(fullImage.width()) * fullImage.height()
+                           * fullImage.depth() / 8;
+        m_fullImages.insert(key, new QPixmap(fullImage),
+                            std::max<qint64>(1, bytes / 1024));
+    }
+    if (capture->captureId == m_selectedCaptureId) {
+        showCaptureDetail(row);
     }
-
-    return pixmap;
 }
 
 // ---------------------------------------------------------------------------
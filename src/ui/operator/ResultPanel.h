@@ -6,14 +6,22 @@
 
 #include <QWidget>
 #include <QTabWidget>
-#include <QListWidget>
+#include <QListView>
 #include <QLabel>
-#include <QMap>
+#include <QCache>
 #include <QPixmap>
 #include <QByteArray>
+#include <QImage>
+#include <QSize>
 
 #include "core/Types.h"
 
+namespace hmi { class MediaCache; }
+class CaptureDecoder;
+class CaptureGalleryModel;
+class EventLogModel;
+class EventTimelineView;
+
 /// \brief Displays inspection results: capture thumbnails and event timeline.
 ///
 /// Two tabs:
@@ -21,6 +29,17 @@
 ///  - Timeline: chronological list of all inspection events with icons/colors
 ///
 /// Clicking a thumbnail shows a detail view with defect information.
+/// The gallery is a CaptureGalleryModel in a uniform-size QListView, so only
+/// visible rows are painted and only their thumbnails are decoded.  JPEG
+/// decoding and defect overlays run on CaptureDecoder worker threads; only
+/// the QPixmap conversion happens on the GUI thread.  Decoded full images
+/// live in the MediaCache memory tier (or a local budgeted QCache without
+/// one) and are evicted under that budget.
+///
+/// Only the models are created with the panel; the tabs and views are built
+/// by ensureContents(), at the latest when the panel is first shown, so a
+/// hidden operator window costs nothing to construct.  Data arriving before
+/// that goes into the models and is on screen with the first frame.
 class ResultPanel : public QWidget
 {
     Q_OBJECT
@@ -34,55 +53,99 @@ public:
     /// Batch-set all capture records (e.g., from GetCaptureRecords RPC).
     void setCaptureRecords(const QVector<hmi::CaptureRecord>& records);
 
+    /// Merge one ListCaptures page into the gallery (known captures update).
+    void appendCaptureRecords(const QVector<hmi::CaptureRecord>& records);
+
     /// Append an event to the timeline.
     void addEvent(const hmi::InspectionEvent& event);
 
     /// Clear all captures and events.
     void clear();
 
-    /// When a full image is downloaded, update the detail view.
-    void setFullImage(const QString& captureId, const QByteArray& imageData);
+    /// Build the tabs and views (no-op once built).
+    void ensureContents();
+
+    /// Keep decoded full images in \a cache (may be null, not owned).
+    void setMediaCache(hmi::MediaCache* cache);
+
+    /// Gallery neighbours prefetched on each side of a clicked thumbnail
+    /// (default kDefaultPrefetchNeighbours; 0 = none).
+    void setPrefetchDepth(int neighbours);
+
+    /// When a full image is downloaded, update the detail view.  Also takes
+    /// the media requested through thumbnailImageRequested().
+    void setFullImage(const QString& mediaId, const QByteArray& imageData);
 
 signals:
     /// Emitted when the user clicks a thumbnail to request the full image download.
-    void downloadImageRequested(const QString& mediaId);
+    void downloadImageRequested(const hmi::MediaRef& media);
+
+    /// Emitted for the gallery neighbours of the clicked thumbnail so their
+    /// full images are likely to be ready when the operator steps on.
+    void prefetchImageRequested(const hmi::MediaRef& media);
+
+    /// Emitted when a painted gallery row has no inlined thumbnail
+    /// (metadata-only listing); deliver the bytes through setFullImage().
+    void thumbnailImageRequested(const hmi::MediaRef& media);
 
     /// Emitted when a capture is selected in the gallery.
     void captureSelected(const QString& captureId);
 
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private:
-    void setupUi();
     QWidget* createGalleryTab();
     QWidget* createTimelineTab();
 
-    /// Render a thumbnail with red bounding boxes for defects.
-    QPixmap renderThumbnailWithDefects(const QByteArray& jpegData,
-                                       const QVector<hmi::DefectResult>& defects,
-                                       int imgW, int imgH);
+    /// Detail decoder result (GUI thread).
+    void onDetailDecoded(const QString& mediaId, const QImage& image);
 
     /// Get event type icon/text/color
     static QString eventTypeIcon(hmi::InspectionEventType type);
     static QString eventTypeColor(hmi::InspectionEventType type);
 
-    QTabWidget*   m_tabs         = nullptr;
+    /// Show gallery \a row in the detail view (full image if loaded).
+    void showCaptureDetail(int row);
+
+    /// Request the full image of the clicked capture and prefetch its
+    /// neighbours.
+    void requestImages(int row);
+
+    QTabWidget*   m_tabs         = nullptr;   ///< null until ensureContents()
 
     // Gallery tab
-    QListWidget*  m_thumbnailList = nullptr;
+    QListView*           m_galleryView  = nullptr;
+    CaptureGalleryModel* m_galleryModel = nullptr;
 
-    // Timeline tab
-    QListWidget*  m_eventTimeline = nullptr;
+    // Timeline tab (bounded ring buffer, flushed once per frame)
+    EventLogModel*     m_eventModel    = nullptr;
+    EventTimelineView* m_eventTimeline = nullptr;
 
     // Detail view (shared between tabs)
     QLabel*       m_detailImage      = nullptr;
     QLabel*       m_defectInfoLabel  = nullptr;
 
-    struct CaptureInfo {
-        QString captureId;
-        int32_t pointId = 0;
-        QVector<hmi::DefectResult> defects;
-        QPixmap thumbnail;
-        QPixmap fullImage;
-    };
+    /// Full image of \a media from the cache (or the panel), null if absent.
+    QPixmap fullImageOf(const hmi::MediaRef& media) const;
+    bool hasFullImage(const hmi::MediaRef& media) const;
+
+    QString                    m_selectedCaptureId;
+    hmi::MediaCache*           m_mediaCache = nullptr;
+    CaptureDecoder*            m_detailDecoder = nullptr;
+
+    /// Decoded full images when no MediaCache is attached (cost in KB).
+    QCache<QString, QPixmap>   m_fullImages{ kFullImageBudgetKb };
+
+    static constexpr int       kThumbnailWidth  = 120;
+    static constexpr int       kThumbnailHeight = 90;
+    static constexpr int       kFullImageBudgetKb = 64 * 1024;
+
+    /// Lower bound for the detail decode, so a small label at click time
+    /// does not pin the image to a postage-stamp resolution.
+    static constexpr QSize     kMinDetailDecodeSize{ 800, 600 };
 
-    QMap<QString, CaptureInfo> m_captures;
+    /// Gallery neighbours prefetched on each side of the clicked thumbnail.
+    static constexpr int kDefaultPrefetchNeighbours = 2;
+    int                  m_prefetchDepth = kDefaultPrefetchNeighbours;
 };
@@ -6,6 +6,48 @@
 #include <QHBoxLayout>
 #include <QFormLayout>
 #include <QGroupBox>
+#include <QHash>
+
+#include <cmath>
+
+namespace {
+
+constexpr double kRadToDeg = 180.0 / M_PI;
+
+// Style sheets are built once and shared: LabelField only re-polishes a
+// label when the applied sheet changes.
+const QString& styleOk()
+{
+    static const QString s = QStringLiteral("QLabel { color: #28a745; font-weight: bold; }");
+    return s;
+}
+
+const QString& styleFault()
+{
+    static const QString s = QStringLiteral("QLabel { color: #dc3545; font-weight: bold; }");
+    return s;
+}
+
+const QString& motionStyle(bool moving, bool arrived)
+{
+    static const QString movingStyle  = QStringLiteral("QLabel { color: #007bff; }");  // blue
+    static const QString arrivedStyle = QStringLiteral("QLabel { color: #28a745; }");  // green
+    static const QString plain;
+    return moving ? movingStyle : arrived ? arrivedStyle : plain;
+}
+
+/// \a level 0 = low (red), 1 = medium (yellow), 2 = good (green).
+const QString& batteryStyle(int level)
+{
+    static const QString styles[3] = {
+        QStringLiteral("QProgressBar::chunk { background-color: #dc3545; }"),
+        QStringLiteral("QProgressBar::chunk { background-color: #ffc107; }"),
+        QStringLiteral("QProgressBar::chunk { background-color: #28a745; }"),
+    };
+    return styles[level];
+}
+
+} // anonymous namespace
 
 // ---------------------------------------------------------------------------
 // Construction
@@ -15,6 +57,32 @@ RobotStatusWidget::RobotStatusWidget(QWidget* parent)
     : QWidget(parent)
 {
     setupUi();
+
+    m_agvConn       = LabelField(m_agvConnLabel);
+    m_agvState      = LabelField(m_agvStateLabel);
+    m_agvPose       = LabelField(m_agvPoseLabel, kNumericRefreshMs);
+    m_agvBattery    = LabelField(m_agvBatteryLabel);
+    m_agvVelocity   = LabelField(m_agvVelocityLabel, kNumericRefreshMs);
+    m_agvLocQuality = LabelField(m_agvLocQualityLabel, kNumericRefreshMs);
+    m_armConn       = LabelField(m_armConnLabel);
+    m_armState      = LabelField(m_armStateLabel);
+    m_armJoints     = LabelField(m_armJointsLabel, kNumericRefreshMs);
+    m_armManip      = LabelField(m_armManipLabel, kNumericRefreshMs);
+    m_armTcp        = LabelField(m_armTcpLabel, kNumericRefreshMs);
+    m_interlock     = LabelField(m_interlockLabel);
+
+    // The construction-time "未连接" indicators count as rendered.
+    setConnectionIndicator(m_agvConn, false);
+    setConnectionIndicator(m_armConn, false);
+
+    m_clock.start();
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(kNumericRefreshMs);
+    connect(&m_refreshTimer, &QTimer::timeout, this, [this]() {
+        if (m_hasAgv) renderAgv();
+        if (m_hasArm) renderArm();
+        scheduleRefresh();
+    });
 }
 
 // ---------------------------------------------------------------------------
@@ -41,7 +109,6 @@ QWidget* RobotStatusWidget::createAgvSection()
     form->setSpacing(4);
 
     m_agvConnLabel = new QLabel(QStringLiteral("● 未连接"), box);
-    setConnectionIndicator(m_agvConnLabel, false);
     form->addRow(QStringLiteral("连接:"), m_agvConnLabel);
 
     m_agvStateLabel = new QLabel(QStringLiteral("--"), box);
@@ -83,7 +150,6 @@ QWidget* RobotStatusWidget::createArmSection()
     form->setSpacing(4);
 
     m_armConnLabel = new QLabel(QStringLiteral("● 未连接"), box);
-    setConnectionIndicator(m_armConnLabel, false);
     form->addRow(QStringLiteral("连接:"), m_armConnLabel);
 
     m_armStateLabel = new QLabel(QStringLiteral("--"), box);
@@ -122,130 +188,157 @@ QWidget* RobotStatusWidget::createInterlockSection()
 
 void RobotStatusWidget::updateAgvStatus(const hmi::AgvStatus& status)
 {
-    // Connection
-    setConnectionIndicator(m_agvConnLabel, status.connected);
+    m_agv = status;
+    m_hasAgv = true;
+    renderAgv();
+    scheduleRefresh();
+}
 
-    // State
-    QStringList stateFlags;
-    if (status.arrived)  stateFlags << QStringLiteral("已到达");
-    if (status.moving)   stateFlags << QStringLiteral("运动中");
-    if (status.stopped)  stateFlags << QStringLiteral("已停止");
-    QString stateText = stateFlags.isEmpty() ? QStringLiteral("--") : stateFlags.join(", ");
-    m_agvStateLabel->setText(stateText);
-
-    // State label color
-    if (status.moving) {
-        m_agvStateLabel->setStyleSheet(QStringLiteral("QLabel { color: #007bff; }"));  // blue
-    } else if (status.arrived) {
-        m_agvStateLabel->setStyleSheet(QStringLiteral("QLabel { color: #28a745; }"));  // green
+void RobotStatusWidget::updateArmStatus(const hmi::ArmStatus& status)
+{
+    m_arm = status;
+    m_hasArm = true;
+    renderArm();
+    scheduleRefresh();
+}
+
+void RobotStatusWidget::updateInterlockStatus(bool ok, const QString& message)
+{
+    if (!m_interlock.needsText(quantizedKey({ ok ? 1.0 : 0.0 }, 1.0) ^ qHash(message), 0)) {
+        return;
+    }
+    if (ok) {
+        m_interlock.setText(QStringLiteral("● 联锁正常"));
     } else {
-        m_agvStateLabel->setStyleSheet(QString());
+        m_interlock.setText(QStringLiteral("● 联锁异常: %1")
+                                .arg(message.isEmpty() ? QStringLiteral("--") : message));
+    }
+    m_interlock.setStyleSheet(ok ? styleOk() : styleFault());
+}
+
+void RobotStatusWidget::renderAgv()
+{
+    const hmi::AgvStatus& status = m_agv;
+    const qint64 now = m_clock.elapsed();
+
+    setConnectionIndicator(m_agvConn, status.connected);
+
+    // State
+    const uint64_t stateKey = quantizedKey({ double(status.arrived), double(status.moving),
+                                             double(status.stopped) }, 1.0);
+    if (m_agvState.needsText(stateKey, now)) {
+        QStringList stateFlags;
+        if (status.arrived)  stateFlags << QStringLiteral("已到达");
+        if (status.moving)   stateFlags << QStringLiteral("运动中");
+        if (status.stopped)  stateFlags << QStringLiteral("已停止");
+        m_agvState.setText(stateFlags.isEmpty() ? QStringLiteral("--") : stateFlags.join(", "));
+        m_agvState.setStyleSheet(motionStyle(status.moving, status.arrived));
     }
 
-    // Pose
-    m_agvPoseLabel->setText(
-        QStringLiteral("x:%.2f y:%.2f θ:%.2f°")
-            .arg(status.currentPose.x)
-            .arg(status.currentPose.y)
-            .arg(status.currentPose.yaw * 180.0 / 3.14159265)
-    );
+    // Pose: keyed at the displayed precision (cm, 0.01°)
+    const double yawDeg = status.currentPose.yaw * kRadToDeg;
+    if (m_agvPose.needsText(quantizedKey({ status.currentPose.x, status.currentPose.y, yawDeg },
+                                         0.01), now)) {
+        m_agvPose.setText(QStringLiteral("x:%1 y:%2 θ:%3°")
+                              .arg(status.currentPose.x, 0, 'f', 2)
+                              .arg(status.currentPose.y, 0, 'f', 2)
+                              .arg(yawDeg, 0, 'f', 2));
+    }
 
     // Battery
-    int batteryPct = static_cast<int>(status.batteryPercent);
-    m_agvBatteryLabel->setText(QStringLiteral("%1%").arg(batteryPct));
-    m_batteryBar->setValue(batteryPct);
-
-    QColor batteryColor;
-    if (batteryPct > 50) {
-        batteryColor = QColor("#28a745");  // green
-    } else if (batteryPct > 20) {
-        batteryColor = QColor("#ffc107");  // yellow
-    } else {
-        batteryColor = QColor("#dc3545");  // red
+    const int batteryPct = static_cast<int>(status.batteryPercent);
+    if (m_agvBattery.needsText(quantizedKey({ double(batteryPct) }, 1.0), now)) {
+        m_agvBattery.setText(QStringLiteral("%1%").arg(batteryPct));
+        m_batteryBar->setValue(batteryPct);
+
+        // The chunk colour is a style sheet: re-polished on a level change only.
+        const int level = batteryPct > 50 ? 2 : batteryPct > 20 ? 1 : 0;
+        if (level != m_batteryLevel) {
+            m_batteryLevel = level;
+            m_batteryBar->setStyleSheet(batteryStyle(level));
+        }
     }
-    m_batteryBar->setStyleSheet(QStringLiteral(
-        "QProgressBar::chunk { background-color: %1; }"
-    ).arg(batteryColor.name()));
 
     // Velocity
-    m_agvVelocityLabel->setText(
-        QStringLiteral("线速:%.2f m/s 角速:%.2f r/s")
-            .arg(static_cast<double>(status.linearVelocityMps))
-            .arg(static_cast<double>(status.angularVelocityRps))
-    );
+    if (m_agvVelocity.needsText(quantizedKey({ double(status.linearVelocityMps),
+                                               double(status.angularVelocityRps) }, 0.01), now)) {
+        m_agvVelocity.setText(QStringLiteral("线速:%1 m/s 角速:%2 r/s")
+                                  .arg(double(status.linearVelocityMps), 0, 'f', 2)
+                                  .arg(double(status.angularVelocityRps), 0, 'f', 2));
+    }
 
-    // Localization quality
-    m_agvLocQualityLabel->setText(
-        QStringLiteral("%.1f%%").arg(static_cast<double>(status.localizationQuality * 100.0f))
-    );
+    // Localization quality (percent, one decimal)
+    const double quality = double(status.localizationQuality) * 100.0;
+    if (m_agvLocQuality.needsText(quantizedKey({ quality }, 0.1), now)) {
+        m_agvLocQuality.setText(QStringLiteral("%1%").arg(quality, 0, 'f', 1));
+    }
 }
 
-void RobotStatusWidget::updateArmStatus(const hmi::ArmStatus& status)
+void RobotStatusWidget::renderArm()
 {
-    // Connection
-    setConnectionIndicator(m_armConnLabel, status.connected);
+    const hmi::ArmStatus& status = m_arm;
+    const qint64 now = m_clock.elapsed();
+
+    setConnectionIndicator(m_armConn, status.connected);
 
     // State
-    QStringList stateFlags;
-    if (status.arrived) stateFlags << QStringLiteral("已到达");
-    if (status.moving)  stateFlags << QStringLiteral("运动中");
-    if (status.servoEnabled) stateFlags << QStringLiteral("伺服使能");
-    QString stateText = stateFlags.isEmpty() ? QStringLiteral("--") : stateFlags.join(", ");
-    m_armStateLabel->setText(stateText);
-
-    // State label color
-    if (status.moving) {
-        m_armStateLabel->setStyleSheet(QStringLiteral("QLabel { color: #007bff; }"));  // blue
-    } else if (status.arrived) {
-        m_armStateLabel->setStyleSheet(QStringLiteral("QLabel { color: #28a745; }"));  // green
-    } else {
-        m_armStateLabel->setStyleSheet(QString());
+    const uint64_t stateKey = quantizedKey({ double(status.arrived), double(status.moving),
+                                             double(status.servoEnabled) }, 1.0);
+    if (m_armState.needsText(stateKey, now)) {
+        QStringList stateFlags;
+        if (status.arrived) stateFlags << QStringLiteral("已到达");
+        if (status.moving)  stateFlags << QStringLiteral("运动中");
+        if (status.servoEnabled) stateFlags << QStringLiteral("伺服使能");
+        m_armState.setText(stateFlags.isEmpty() ? QStringLiteral("--") : stateFlags.join(", "));
+        m_armState.setStyleSheet(motionStyle(status.moving, status.arrived));
     }
 
-    // Joints (abbreviated)
-    QString jointsText = QStringLiteral("[%.1f, %.1f, %.1f, ...]")
-        .arg(status.currentJoints[0] * 180.0 / 3.14159265)
-        .arg(status.currentJoints[1] * 180.0 / 3.14159265)
-        .arg(status.currentJoints[2] * 180.0 / 3.14159265);
-    m_armJointsLabel->setText(jointsText);
+    // Joints (abbreviated, 0.1°)
+    const double j0 = status.currentJoints[0] * kRadToDeg;
+    const double j1 = status.currentJoints[1] * kRadToDeg;
+    const double j2 = status.currentJoints[2] * kRadToDeg;
+    if (m_armJoints.needsText(quantizedKey({ j0, j1, j2 }, 0.1), now)) {
+        m_armJoints.setText(QStringLiteral("[%1, %2, %3, ...]")
+                                .arg(j0, 0, 'f', 1)
+                                .arg(j1, 0, 'f', 1)
+                                .arg(j2, 0, 'f', 1));
+    }
 
     // Manipulability
-    m_armManipLabel->setText(QStringLiteral("%.3f").arg(status.manipulability));
+    if (m_armManip.needsText(quantizedKey({ status.manipulability }, 0.001), now)) {
+        m_armManip.setText(QString::number(status.manipulability, 'f', 3));
+    }
 
     // TCP pose (abbreviated)
-    QString tcpText = QStringLiteral("xyz:(%.2f, %.2f, %.2f)")
-        .arg(static_cast<double>(status.tcpPose.position.x()))
-        .arg(static_cast<double>(status.tcpPose.position.y()))
-        .arg(static_cast<double>(status.tcpPose.position.z()));
-    m_armTcpLabel->setText(tcpText);
+    const QVector3D& p = status.tcpPose.position;
+    if (m_armTcp.needsText(quantizedKey({ double(p.x()), double(p.y()), double(p.z()) }, 0.01),
+                           now)) {
+        m_armTcp.setText(QStringLiteral("xyz:(%1, %2, %3)")
+                             .arg(double(p.x()), 0, 'f', 2)
+                             .arg(double(p.y()), 0, 'f', 2)
+                             .arg(double(p.z()), 0, 'f', 2));
+    }
 }
 
-void RobotStatusWidget::updateInterlockStatus(bool ok, const QString& message)
+void RobotStatusWidget::scheduleRefresh()
 {
-    QString text;
-    QString style;
-    if (ok) {
-        text = QStringLiteral("● 联锁正常");
-        style = QStringLiteral("QLabel { color: #28a745; font-weight: bold; }");  // green
-    } else {
-        text = QStringLiteral("● 联锁异常: %1").arg(message.isEmpty() ? QStringLiteral("--") : message);
-        style = QStringLiteral("QLabel { color: #dc3545; font-weight: bold; }");  // red
+    // A numeric change held back by its refresh interval is shown from the
+    // latest status once the interval has passed, even if no message follows.
+    const bool pending = m_agvPose.isPending() || m_agvVelocity.isPending()
+                      || m_agvLocQuality.isPending() || m_armJoints.isPending()
+                      || m_armManip.isPending() || m_armTcp.isPending();
+    if (pending && !m_refreshTimer.isActive()) {
+        m_refreshTimer.start();
     }
-    m_interlockLabel->setText(text);
-    m_interlockLabel->setStyleSheet(style);
 }
 
 // ---------------------------------------------------------------------------
 // Helpers
 // ---------------------------------------------------------------------------
 
-void RobotStatusWidget::setConnectionIndicator(QLabel* label, bool connected)
+void RobotStatusWidget::setConnectionIndicator(LabelField& field, bool connected)
 {
-    if (connected) {
-        label->setText(QStringLiteral("● 已连接"));
-        label->setStyleSheet(QStringLiteral("QLabel { color: #28a745; font-weight: bold; }"));  // green
-    } else {
-        label->setText(QStringLiteral("● 未连接"));
-        label->setStyleSheet(QStringLiteral("QLabel { color: #dc3545; font-weight: bold; }"));  // red
-    }
+    if (!field.needsText(connected ? 1 : 0, 0)) return;
+    field.setText(connected ? QStringLiteral("● 已连接") : QStringLiteral("● 未连接"));
+    field.setStyleSheet(connected ? styleOk() : styleFault());
 }
@@ -3,6 +3,12 @@
 // RobotStatusWidget – displays AGV and Arm status in a compact card layout.
 //
 // Shows connection state, motion state, pose/joints, battery, interlock, etc.
+//
+// Updates arrive at the stream rate; each label is a LabelField, so a label
+// is only formatted and written when its value changes at the displayed
+// precision, style sheets are re-applied only when the state they show
+// changes, and numeric fields are capped at one text change per
+// kNumericRefreshMs (the latest value is shown once the interval passes).
 
 #pragma once
 
@@ -10,7 +16,10 @@
 #include <QLabel>
 #include <QProgressBar>
 #include <QGroupBox>
+#include <QElapsedTimer>
+#include <QTimer>
 
+#include "LabelField.h"
 #include "core/Types.h"
 
 /// \brief Displays AGV and Arm status in a compact, two-section card.
@@ -24,6 +33,10 @@ class RobotStatusWidget : public QWidget
     Q_OBJECT
 
 public:
+    /// Numeric fields (pose, velocity, joints, ...) change text at most
+    /// this often.
+    static constexpr int kNumericRefreshMs = 100;
+
     explicit RobotStatusWidget(QWidget* parent = nullptr);
 
     void updateAgvStatus(const hmi::AgvStatus& status);
@@ -36,8 +49,15 @@ private:
     QWidget* createArmSection();
     QWidget* createInterlockSection();
 
+    /// Write the changed fields of m_agv / m_arm.
+    void renderAgv();
+    void renderArm();
+
+    /// Start m_refreshTimer while a rate-capped field holds back a change.
+    void scheduleRefresh();
+
     /// Set connection indicator: green if connected, red otherwise.
-    static void setConnectionIndicator(QLabel* label, bool connected);
+    static void setConnectionIndicator(LabelField& field, bool connected);
 
     // AGV section
     QLabel* m_agvConnLabel       = nullptr;
@@ -57,4 +77,18 @@ private:
 
     // Interlock section
     QLabel* m_interlockLabel    = nullptr;
+
+    // Rendered state of the labels above
+    LabelField m_agvConn, m_agvState, m_agvPose, m_agvBattery, m_agvVelocity, m_agvLocQuality;
+    LabelField m_armConn, m_armState, m_armJoints, m_armManip, m_armTcp;
+    LabelField m_interlock;
+    int        m_batteryLevel = -1;   ///< applied chunk style, -1 = none
+
+    // Latest values, re-rendered by m_refreshTimer
+    hmi::AgvStatus m_agv;
+    hmi::ArmStatus m_arm;
+    bool           m_hasAgv = false;
+    bool           m_hasArm = false;
+    QElapsedTimer  m_clock;
+    QTimer         m_refreshTimer;
 };
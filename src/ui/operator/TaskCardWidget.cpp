@@ -5,6 +5,9 @@
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QDateTime>
+#include <QHash>
+
+#include <array>
 
 // ---------------------------------------------------------------------------
 // Construction
@@ -14,6 +17,12 @@ TaskCardWidget::TaskCardWidget(QWidget* parent)
     : QFrame(parent)
 {
     setupUi();
+
+    m_taskName = LabelField(m_taskNameLabel);
+    m_phase    = LabelField(m_phaseLabel);
+    m_progress = LabelField(m_progressLabel);
+    m_waypoint = LabelField(m_waypointLabel);
+    m_time     = LabelField(m_timeLabel);
     clear();
 }
 
@@ -53,15 +62,6 @@ void TaskCardWidget::setupUi()
     m_phaseLabel = new QLabel(QStringLiteral("空闲"), this);
     m_phaseLabel->setAlignment(Qt::AlignCenter);
     m_phaseLabel->setMinimumWidth(80);
-    m_phaseLabel->setStyleSheet(QStringLiteral(
-        "QLabel {"
-        "  background-color: #6c757d;"  // default gray
-        "  color: white;"
-        "  border-radius: 4px;"
-        "  padding: 4px 8px;"
-        "  font-weight: bold;"
-        "}"
-    ));
     topRow->addWidget(m_phaseLabel, 0);
 
     vlay->addLayout(topRow);
@@ -104,73 +104,60 @@ void TaskCardWidget::setupUi()
 void TaskCardWidget::updateStatus(const hmi::TaskStatus& status)
 {
     // Task name
-    if (status.taskName.isEmpty()) {
-        m_taskNameLabel->setText(QStringLiteral("任务: %1").arg(status.taskId.left(8)));
-    } else {
-        m_taskNameLabel->setText(QStringLiteral("任务: %1").arg(status.taskName));
+    const QString& name = status.taskName.isEmpty() ? status.taskId : status.taskName;
+    if (m_taskName.needsText(qHash(name) ^ uint64_t(status.taskName.isEmpty()), 0)) {
+        m_taskName.setText(QStringLiteral("任务: %1")
+                               .arg(status.taskName.isEmpty() ? status.taskId.left(8)
+                                                              : status.taskName));
     }
 
-    // Phase badge
-    QString phaseText = phaseToString(status.phase);
-    QString phaseColor = phaseToColor(status.phase);
-    m_phaseLabel->setText(phaseText);
-    m_phaseLabel->setStyleSheet(QStringLiteral(
-        "QLabel {"
-        "  background-color: %1;"
-        "  color: white;"
-        "  border-radius: 4px;"
-        "  padding: 4px 8px;"
-        "  font-weight: bold;"
-        "}"
-    ).arg(phaseColor));
+    // Phase badge: the style sheet is re-applied on a phase change only
+    if (m_phase.needsText(uint64_t(status.phase), 0)) {
+        m_phase.setText(phaseToString(status.phase));
+        m_phase.setStyleSheet(phaseStyle(status.phase));
+    }
 
     // Progress
-    int progressInt = static_cast<int>(status.progressPercent);
-    m_progressLabel->setText(QStringLiteral("进度: %1%").arg(progressInt));
-    m_progressBar->setValue(progressInt);
+    const int progressInt = static_cast<int>(status.progressPercent);
+    if (m_progress.needsText(uint64_t(progressInt), 0)) {
+        m_progress.setText(QStringLiteral("进度: %1%").arg(progressInt));
+        m_progressBar->setValue(progressInt);
+    }
 
     // Waypoint
-    m_waypointLabel->setText(
-        QStringLiteral("当前点位: %1 / %2")
-            .arg(status.currentWaypointIndex)
-            .arg(status.totalWaypoints)
-    );
-
-    // Time
-    QString elapsedStr = QStringLiteral("--");
-    QString remainingStr = QStringLiteral("--");
-
-    if (status.startedAt.isValid()) {
-        qint64 elapsedSec = status.startedAt.secsTo(QDateTime::currentDateTime());
-        int elapsedMin = static_cast<int>(elapsedSec / 60);
-        elapsedStr = QStringLiteral("%1 分").arg(elapsedMin);
+    if (m_waypoint.needsText((uint64_t(status.currentWaypointIndex) << 32)
+                                 | status.totalWaypoints, 0)) {
+        m_waypoint.setText(QStringLiteral("当前点位: %1 / %2")
+                               .arg(status.currentWaypointIndex)
+                               .arg(status.totalWaypoints));
     }
 
-    if (status.remainingTimeEstS > 0.0) {
-        int remainingMin = static_cast<int>(status.remainingTimeEstS / 60.0);
-        remainingStr = QStringLiteral("%1 分").arg(remainingMin);
+    // Time, in whole minutes
+    const qint64 elapsedMin = status.startedAt.isValid()
+        ? status.startedAt.secsTo(QDateTime::currentDateTime()) / 60 : -1;
+    const qint64 remainingMin = status.remainingTimeEstS > 0.0
+        ? static_cast<qint64>(status.remainingTimeEstS / 60.0) : -1;
+    if (m_time.needsText(quantizedKey({ double(elapsedMin), double(remainingMin) }, 1.0), 0)) {
+        const QString elapsedStr = elapsedMin >= 0
+            ? QStringLiteral("%1 分").arg(elapsedMin) : QStringLiteral("--");
+        const QString remainingStr = remainingMin >= 0
+            ? QStringLiteral("%1 分").arg(remainingMin) : QStringLiteral("--");
+        m_time.setText(QStringLiteral("用时: %1 / 剩余: %2").arg(elapsedStr, remainingStr));
     }
-
-    m_timeLabel->setText(QStringLiteral("用时: %1 / 剩余: %2").arg(elapsedStr, remainingStr));
 }
 
 void TaskCardWidget::clear()
 {
-    m_taskNameLabel->setText(QStringLiteral("任务: --"));
-    m_phaseLabel->setText(QStringLiteral("空闲"));
-    m_phaseLabel->setStyleSheet(QStringLiteral(
-        "QLabel {"
-        "  background-color: #6c757d;"
-        "  color: white;"
-        "  border-radius: 4px;"
-        "  padding: 4px 8px;"
-        "  font-weight: bold;"
-        "}"
-    ));
-    m_progressLabel->setText(QStringLiteral("进度: 0%"));
+    for (LabelField* field : { &m_taskName, &m_phase, &m_progress, &m_waypoint, &m_time }) {
+        field->invalidate();
+    }
+    m_taskName.setText(QStringLiteral("任务: --"));
+    m_phase.setText(QStringLiteral("空闲"));
+    m_phase.setStyleSheet(phaseStyle(hmi::TaskPhase::Idle));
+    m_progress.setText(QStringLiteral("进度: 0%"));
     m_progressBar->setValue(0);
-    m_waypointLabel->setText(QStringLiteral("当前点位: --/--"));
-    m_timeLabel->setText(QStringLiteral("用时: -- / 剩余: --"));
+    m_waypoint.setText(QStringLiteral("当前点位: --/--"));
+    m_time.setText(QStringLiteral("用时: -- / 剩余: --"));
 }
 
 // ---------------------------------------------------------------------------
@@ -192,6 +179,30 @@ QString TaskCardWidget::phaseToString(hmi::TaskPhase phase)
     }
 }
 
+const QString& TaskCardWidget::phaseStyle(hmi::TaskPhase phase)
+{
+    // One badge style sheet per phase, built once; out-of-range phases share
+    // the Unspecified slot (gray, as phaseToColor()).
+    constexpr int kPhases = static_cast<int>(hmi::TaskPhase::Stopped) + 1;
+    static const std::array<QString, kPhases> styles = []() {
+        std::array<QString, kPhases> out;
+        for (int i = 0; i < kPhases; ++i) {
+            out[i] = QStringLiteral(
+                "QLabel {"
+                "  background-color: %1;"
+                "  color: white;"
+                "  border-radius: 4px;"
+                "  padding: 4px 8px;"
+                "  font-weight: bold;"
+                "}"
+            ).arg(phaseToColor(static_cast<hmi::TaskPhase>(i)));
+        }
+        return out;
+    }();
+    const int index = static_cast<int>(phase);
+    return styles[index >= 0 && index < kPhases ? index : 0];
+}
+
 QString TaskCardWidget::phaseToColor(hmi::TaskPhase phase)
 {
     switch (phase) {
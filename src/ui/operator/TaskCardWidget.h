@@ -3,6 +3,9 @@
 // TaskCardWidget – displays task summary information in a compact card.
 //
 // Shows: task name, phase, progress bar, current waypoint, elapsed/remaining time.
+// Each label is a LabelField: updateStatus() formats and writes only the
+// fields whose displayed value changed, and the phase badge style sheet is
+// re-applied on a phase change only.
 
 #pragma once
 
@@ -10,6 +13,7 @@
 #include <QLabel>
 #include <QProgressBar>
 
+#include "LabelField.h"
 #include "core/Types.h"
 
 /// \brief A compact card widget that displays task summary.
@@ -29,11 +33,14 @@ public:
     /// Reset the card to an empty "no task" state.
     void clear();
 
+    /// Display name and badge colour of \a phase (also the fleet table's).
+    static QString phaseToString(hmi::TaskPhase phase);
+    static QString phaseToColor(hmi::TaskPhase phase);
+
 private:
     void setupUi();
 
-    static QString phaseToString(hmi::TaskPhase phase);
-    static QString phaseToColor(hmi::TaskPhase phase);
+    static const QString& phaseStyle(hmi::TaskPhase phase);
 
     QLabel*       m_taskNameLabel  = nullptr;
     QLabel*       m_phaseLabel     = nullptr;
@@ -41,4 +48,6 @@ private:
     QProgressBar* m_progressBar    = nullptr;
     QLabel*       m_waypointLabel  = nullptr;   // "当前点位: 3/15"
     QLabel*       m_timeLabel      = nullptr;   // elapsed / remaining
+
+    LabelField    m_taskName, m_phase, m_progress, m_waypoint, m_time;
 };
@@ -0,0 +1,125 @@
+// src/ui/operator/WaypointLayerItem.cpp
+
+#include "WaypointLayerItem.h"
+
+#include <QBrush>
+#include <QColor>
+#include <QPainter>
+#include <QPen>
+#include <QStyleOptionGraphicsItem>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const QColor kMarkerColor("#4caf50");
+const QColor kHighlightColor("#ffeb3b");
+
+/// Below this on-screen radius (px) a marker is drawn as a single point.
+constexpr double kMinScreenRadius = 1.0;
+
+} // anonymous namespace
+
+WaypointLayerItem::WaypointLayerItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+{
+    // Needed for option->exposedRect in paint().
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+void WaypointLayerItem::setPoints(QVector<QPointF> points)
+{
+    prepareGeometryChange();
+    m_points      = std::move(points);
+    m_highlighted = -1;
+
+    if (m_points.isEmpty()) {
+        m_bounds = QRectF();
+    } else {
+        double minX = m_points.front().x(), maxX = minX;
+        double minY = m_points.front().y(), maxY = minY;
+        for (const QPointF& p : m_points) {
+            minX = std::min(minX, p.x());
+            maxX = std::max(maxX, p.x());
+            minY = std::min(minY, p.y());
+            maxY = std::max(maxY, p.y());
+        }
+        m_bounds = QRectF(QPointF(minX, minY), QPointF(maxX, maxY))
+                       .adjusted(-kHighlightRadius, -kHighlightRadius,
+                                 kHighlightRadius, kHighlightRadius);
+    }
+    update();
+}
+
+void WaypointLayerItem::clear()
+{
+    setPoints({});
+}
+
+void WaypointLayerItem::setHighlighted(int index)
+{
+    if (index < 0 || index >= m_points.size()) { index = -1; }
+    if (index == m_highlighted) { return; }
+
+    const int previous = m_highlighted;
+    m_highlighted = index;
+    if (previous >= 0) { update(markerRect(previous)); }
+    if (index >= 0)    { update(markerRect(index)); }
+}
+
+QRectF WaypointLayerItem::markerRect(int index) const
+{
+    const QPointF& p = m_points[index];
+    // One pixel of slack for antialiasing.
+    constexpr double r = kHighlightRadius + 1.0;
+    return QRectF(p.x() - r, p.y() - r, 2 * r, 2 * r);
+}
+
+QRectF WaypointLayerItem::boundingRect() const
+{
+    return m_bounds;
+}
+
+void WaypointLayerItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                              QWidget* /*widget*/)
+{
+    if (m_points.isEmpty()) { return; }
+
+    // Culling: only markers whose circle intersects the exposed region.
+    const QRectF cull = option->exposedRect.adjusted(-kRadius, -kRadius, kRadius, kRadius);
+    const double lod  = QStyleOptionGraphicsItem::levelOfDetailFromTransform(
+        painter->worldTransform());
+
+    painter->save();
+    if (kRadius * lod < kMinScreenRadius) {
+        // Zoomed far out: a cosmetic point per marker is indistinguishable
+        // from the circle and much cheaper.
+        QPen pen(kMarkerColor);
+        pen.setWidthF(2.0);
+        pen.setCosmetic(true);
+        painter->setPen(pen);
+        for (const QPointF& p : m_points) {
+            if (cull.contains(p)) { painter->drawPoint(p); }
+        }
+    } else {
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(kMarkerColor);
+        for (int i = 0; i < m_points.size(); ++i) {
+            const QPointF& p = m_points[i];
+            if (i == m_highlighted || !cull.contains(p)) { continue; }
+            painter->drawEllipse(p, kRadius, kRadius);
+        }
+    }
+
+    if (m_highlighted >= 0) {
+        const QPointF& p = m_points[m_highlighted];
+        if (cull.adjusted(-kHighlightRadius, -kHighlightRadius,
+                          kHighlightRadius, kHighlightRadius).contains(p)) {
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(kHighlightColor);
+            painter->drawEllipse(p, kHighlightRadius, kHighlightRadius);
+        }
+    }
+    painter->restore();
+}
@@ -0,0 +1,47 @@
+// src/ui/operator/WaypointLayerItem.h
+//
+// WaypointLayerItem – every waypoint marker of NavMapWidget in one
+// QGraphicsItem.  The markers are a packed array of scene points drawn with
+// a single pen / brush; paint() skips the points outside the exposed rect,
+// and highlighting a waypoint only invalidates the old and the new marker.
+// One item instead of one QGraphicsEllipseItem per waypoint keeps the scene
+// index and the per-item paint overhead flat for plans with thousands of
+// waypoints.
+
+#pragma once
+
+#include <QGraphicsItem>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+class WaypointLayerItem : public QGraphicsItem
+{
+public:
+    static constexpr double kRadius          = 3.0;
+    static constexpr double kHighlightRadius = 6.0;
+
+    explicit WaypointLayerItem(QGraphicsItem* parent = nullptr);
+
+    /// Replace all markers (scene coordinates).  Clears the highlight.
+    void setPoints(QVector<QPointF> points);
+    void clear();
+
+    /// Draw marker \a index enlarged; -1 for none.  Only the two affected
+    /// marker regions are repainted.
+    void setHighlighted(int index);
+    int  highlighted() const { return m_highlighted; }
+
+    int count() const { return m_points.size(); }
+
+    QRectF boundingRect() const override;
+    void   paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                 QWidget* widget = nullptr) override;
+
+private:
+    QRectF markerRect(int index) const;
+
+    QVector<QPointF> m_points;
+    QRectF           m_bounds;        ///< cached: points + highlight radius
+    int              m_highlighted = -1;
+};
@@ -7,6 +7,7 @@
 //   - Pose2D <-> Pose3D conversions
 //   - Yaw angles <-> quaternions
 //   - Camera/view geometry computations
+//   - SIMD batch variants of the above for whole paths / target sets
 //   - Formatting utilities for display
 //
 // All functions are inline for zero-overhead abstraction. This header depends
@@ -25,6 +26,13 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace hmi {
 namespace coord {
@@ -204,6 +212,586 @@ inline std::array<QVector3D, 4> frustumCorners(const QVector3D& cameraPos,
     };
 }
 
+// ---------------------------------------------------------------------------
+// Batch kernels
+// ---------------------------------------------------------------------------
+//
+// Structure-of-arrays variants of the helpers above for whole paths and
+// target sets.  Each kernel is written once against a lane type and
+// instantiated for the widest vector unit the build targets – AVX (4 double
+// / 8 float), SSE2 (2 / 4) or AArch64 NEON (2 / 4) – with the remainder
+// run through the scalar lane.  The kernels use the scalar formulas in the
+// same order: world <-> pixel results are bit-identical (divisions stay
+// divisions), the float camera kernels agree to rounding.
+//
+// The frustum kernels cover the three camera conventions in the tree: the
+// world-up basis of frustumCorners() (CoverageEngine's target views), the
+// shortest-arc frame PointAnnotator draws targets with, each optionally
+// rolled about the optical axis, and full camera poses (PlanPreview).
+//
+// Outputs may be the inputs themselves (in-place) but must not otherwise
+// overlap them.
+
+/// Three parallel coordinate arrays, one element per point.
+struct Vec3Span {
+    float* x = nullptr;
+    float* y = nullptr;
+    float* z = nullptr;
+};
+
+struct ConstVec3Span {
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+};
+
+/// Orientation quaternions as parallel (w, x, y, z) arrays.
+struct ConstQuatSpan {
+    const float* w = nullptr;
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+};
+
+/// Per-camera roll about the optical axis as parallel cos / sin arrays;
+/// a default-constructed span means no roll.  The image axes turn as
+///   right' = right·cos + up·sin,   up' = up·cos − right·sin.
+struct RollSpan {
+    const float* cos = nullptr;
+    const float* sin = nullptr;
+};
+
+/// How frustumCornersBatch() lays the image rectangle around the optical
+/// axis before any roll.
+enum class FrustumBasis {
+    /// As frustumCorners(): right = forward × Z (× Y when forward ≈ ±Z),
+    /// up = right × forward.
+    WorldUp,
+    /// right / up = the +Y / +Z axes carried by the shortest rotation that
+    /// takes +X onto forward (a 180° turn about Z when forward ≈ −X).
+    ShortestArc,
+};
+
+namespace detail {
+
+/// Scalar lane: the tail of every kernel, and the whole loop on targets
+/// without a vector unit.
+template <typename T>
+struct ScalarLanes {
+    using V = T;
+    using M = bool;
+    static constexpr std::size_t kWidth = 1;
+
+    static V load(const T* p) noexcept { return *p; }
+    static void store(T* p, V a) noexcept { *p = a; }
+    static V set1(T a) noexcept { return a; }
+    static V add(V a, V b) noexcept { return a + b; }
+    static V sub(V a, V b) noexcept { return a - b; }
+    static V mul(V a, V b) noexcept { return a * b; }
+    static V div(V a, V b) noexcept { return a / b; }
+    static V sqrt(V a) noexcept { return std::sqrt(a); }
+    static V abs(V a) noexcept { return std::abs(a); }
+    static M gt(V a, V b) noexcept { return a > b; }
+    static V select(M m, V a, V b) noexcept { return m ? a : b; }
+};
+
+#if defined(__AVX__)
+
+struct FloatLanes {
+    using V = __m256;
+    using M = __m256;
+    static constexpr std::size_t kWidth = 8;
+
+    static V load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    static void store(float* p, V a) noexcept { _mm256_storeu_ps(p, a); }
+    static V set1(float a) noexcept { return _mm256_set1_ps(a); }
+    static V add(V a, V b) noexcept { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) noexcept { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) noexcept { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) noexcept { return _mm256_div_ps(a, b); }
+    static V sqrt(V a) noexcept { return _mm256_sqrt_ps(a); }
+    static V abs(V a) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static M gt(V a, V b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static V select(M m, V a, V b) noexcept { return _mm256_blendv_ps(b, a, m); }
+};
+
+struct DoubleLanes {
+    using V = __m256d;
+    static constexpr std::size_t kWidth = 4;
+
+    static V load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+    static void store(double* p, V a) noexcept { _mm256_storeu_pd(p, a); }
+    static V set1(double a) noexcept { return _mm256_set1_pd(a); }
+    static V add(V a, V b) noexcept { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) noexcept { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) noexcept { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) noexcept { return _mm256_div_pd(a, b); }
+};
+
+#elif defined(__SSE2__)
+
+struct FloatLanes {
+    using V = __m128;
+    using M = __m128;
+    static constexpr std::size_t kWidth = 4;
+
+    static V load(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(float* p, V a) noexcept { _mm_storeu_ps(p, a); }
+    static V set1(float a) noexcept { return _mm_set1_ps(a); }
+    static V add(V a, V b) noexcept { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) noexcept { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) noexcept { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) noexcept { return _mm_div_ps(a, b); }
+    static V sqrt(V a) noexcept { return _mm_sqrt_ps(a); }
+    static V abs(V a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static M gt(V a, V b) noexcept { return _mm_cmpgt_ps(a, b); }
+    static V select(M m, V a, V b) noexcept
+    {
+        return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+    }
+};
+
+struct DoubleLanes {
+    using V = __m128d;
+    static constexpr std::size_t kWidth = 2;
+
+    static V load(const double* p) noexcept { return _mm_loadu_pd(p); }
+    static void store(double* p, V a) noexcept { _mm_storeu_pd(p, a); }
+    static V set1(double a) noexcept { return _mm_set1_pd(a); }
+    static V add(V a, V b) noexcept { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) noexcept { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) noexcept { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) noexcept { return _mm_div_pd(a, b); }
+};
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+struct FloatLanes {
+    using V = float32x4_t;
+    using M = uint32x4_t;
+    static constexpr std::size_t kWidth = 4;
+
+    static V load(const float* p) noexcept { return vld1q_f32(p); }
+    static void store(float* p, V a) noexcept { vst1q_f32(p, a); }
+    static V set1(float a) noexcept { return vdupq_n_f32(a); }
+    static V add(V a, V b) noexcept { return vaddq_f32(a, b); }
+    static V sub(V a, V b) noexcept { return vsubq_f32(a, b); }
+    static V mul(V a, V b) noexcept { return vmulq_f32(a, b); }
+    static V div(V a, V b) noexcept { return vdivq_f32(a, b); }
+    static V sqrt(V a) noexcept { return vsqrtq_f32(a); }
+    static V abs(V a) noexcept { return vabsq_f32(a); }
+    static M gt(V a, V b) noexcept { return vcgtq_f32(a, b); }
+    static V select(M m, V a, V b) noexcept { return vbslq_f32(m, a, b); }
+};
+
+struct DoubleLanes {
+    using V = float64x2_t;
+    static constexpr std::size_t kWidth = 2;
+
+    static V load(const double* p) noexcept { return vld1q_f64(p); }
+    static void store(double* p, V a) noexcept { vst1q_f64(p, a); }
+    static V set1(double a) noexcept { return vdupq_n_f64(a); }
+    static V add(V a, V b) noexcept { return vaddq_f64(a, b); }
+    static V sub(V a, V b) noexcept { return vsubq_f64(a, b); }
+    static V mul(V a, V b) noexcept { return vmulq_f64(a, b); }
+    static V div(V a, V b) noexcept { return vdivq_f64(a, b); }
+};
+
+#else
+
+using FloatLanes  = ScalarLanes<float>;
+using DoubleLanes = ScalarLanes<double>;
+
+#endif
+
+// Each kernel handles the leading multiple of L::kWidth elements and
+// returns how many it processed.
+
+template <typename L>
+inline std::size_t worldToPixelLanes(const double* x, const double* y, std::size_t n,
+                                     double originX, double originY, double resolution,
+                                     double* u, double* v) noexcept
+{
+    const auto ox = L::set1(originX), oy = L::set1(originY), r = L::set1(resolution);
+    std::size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        const auto px = L::load(x + i), py = L::load(y + i);
+        L::store(u + i, L::div(L::sub(px, ox), r));
+        L::store(v + i, L::div(L::sub(oy, py), r));
+    }
+    return i;
+}
+
+template <typename L>
+inline std::size_t pixelToWorldLanes(const double* u, const double* v, std::size_t n,
+                                     double originX, double originY, double resolution,
+                                     double* x, double* y) noexcept
+{
+    const auto ox = L::set1(originX), oy = L::set1(originY), r = L::set1(resolution);
+    std::size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        const auto pu = L::load(u + i), pv = L::load(v + i);
+        L::store(x + i, L::add(L::mul(pu, r), ox));
+        L::store(y + i, L::sub(oy, L::mul(pv, r)));
+    }
+    return i;
+}
+
+/// Interleaved (x0, y0, x1, y1, …) world → pixel: the lanes alternate
+/// between the u and v formulas.  (origin.y − y) / r is computed as
+/// (y − origin.y) / −r, which is the same value bit for bit.
+template <typename L>
+inline std::size_t worldToPixelInterleavedLanes(double* xy, std::size_t count,
+                                                double originX, double originY,
+                                                double resolution) noexcept
+{
+    if (L::kWidth % 2 != 0) return 0;
+    alignas(32) double origin[L::kWidth];
+    alignas(32) double scale[L::kWidth];
+    for (std::size_t k = 0; k < L::kWidth; ++k) {
+        origin[k] = (k % 2 == 0) ? originX : originY;
+        scale[k]  = (k % 2 == 0) ? resolution : -resolution;
+    }
+    const auto o = L::load(origin), r = L::load(scale);
+    std::size_t i = 0;
+    for (; i + L::kWidth <= count; i += L::kWidth) {
+        L::store(xy + i, L::div(L::sub(L::load(xy + i), o), r));
+    }
+    return i;
+}
+
+/// 1 / |(x, y, z)|, or 0 for a zero vector (matching QVector3D::normalized()).
+template <typename L>
+inline typename L::V inverseLength(typename L::V x, typename L::V y, typename L::V z) noexcept
+{
+    const auto len2 = L::add(L::add(L::mul(x, x), L::mul(y, y)), L::mul(z, z));
+    const auto zero = L::set1(0.0f);
+    return L::select(L::gt(len2, zero), L::div(L::set1(1.0f), L::sqrt(len2)), zero);
+}
+
+template <typename L>
+inline std::size_t cameraPositionLanes(ConstVec3Span surface, ConstVec3Span viewDir,
+                                       std::size_t n, float focusDistance,
+                                       Vec3Span out) noexcept
+{
+    const auto d = L::set1(focusDistance);
+    std::size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        const auto fx = L::load(viewDir.x + i), fy = L::load(viewDir.y + i),
+                   fz = L::load(viewDir.z + i);
+        const auto s  = L::mul(inverseLength<L>(fx, fy, fz), d);
+        const auto px = L::load(surface.x + i), py = L::load(surface.y + i),
+                   pz = L::load(surface.z + i);
+        L::store(out.x + i, L::sub(px, L::mul(fx, s)));
+        L::store(out.y + i, L::sub(py, L::mul(fy, s)));
+        L::store(out.z + i, L::sub(pz, L::mul(fz, s)));
+    }
+    return i;
+}
+
+/// Camera frame of one lane block: unit forward, right and up.
+template <typename L>
+struct FrameLanes {
+    typename L::V fx, fy, fz;
+    typename L::V rx, ry, rz;
+    typename L::V ux, uy, uz;
+};
+
+/// Image axes around the unit optical axis (fx, fy, fz) for basis \a B.
+template <typename L, FrustumBasis B>
+inline FrameLanes<L> frustumFrame(typename L::V fx, typename L::V fy, typename L::V fz) noexcept
+{
+    const auto zero = L::set1(0.0f);
+    FrameLanes<L> f;
+    f.fx = fx;  f.fy = fy;  f.fz = fz;
+
+    if constexpr (B == FrustumBasis::WorldUp) {
+        // right = forward × worldUp, worldUp = Z, or Y when looking along Z:
+        //   × Z = ( fy, −fx, 0),   × Y = (−fz, 0, fx)
+        const auto alongZ = L::gt(L::abs(fz), L::set1(0.99f));
+        auto rx = L::select(alongZ, L::sub(zero, fz), fy);
+        auto ry = L::select(alongZ, zero, L::sub(zero, fx));
+        auto rz = L::select(alongZ, fx, zero);
+        const auto invR = inverseLength<L>(rx, ry, rz);
+        f.rx = L::mul(rx, invR);  f.ry = L::mul(ry, invR);  f.rz = L::mul(rz, invR);
+
+        // up = right × forward is already unit length (orthonormal factors).
+        f.ux = L::sub(L::mul(f.ry, fz), L::mul(f.rz, fy));
+        f.uy = L::sub(L::mul(f.rz, fx), L::mul(f.rx, fz));
+        f.uz = L::sub(L::mul(f.rx, fy), L::mul(f.ry, fx));
+    } else {
+        // Rodrigues with axis X × forward, k = 1 / (1 + fx):
+        //   Y -> (−fy, 1 − fy²·k, −fy·fz·k),   Z -> (−fz, −fy·fz·k, 1 − fz²·k)
+        // Near forward = −X the axis vanishes; turn 180° about Z instead.
+        const auto one      = L::set1(1.0f);
+        const auto onePlusX = L::add(one, fx);
+        const auto regular  = L::gt(onePlusX, L::set1(1e-6f));
+        const auto k  = L::div(one, L::select(regular, onePlusX, one));
+        const auto yz = L::mul(L::mul(fy, fz), k);
+        f.rx = L::select(regular, L::sub(zero, fy), zero);
+        f.ry = L::select(regular, L::sub(one, L::mul(L::mul(fy, fy), k)), L::sub(zero, one));
+        f.rz = L::select(regular, L::sub(zero, yz), zero);
+        f.ux = L::select(regular, L::sub(zero, fz), zero);
+        f.uy = L::select(regular, L::sub(zero, yz), zero);
+        f.uz = L::select(regular, L::sub(one, L::mul(L::mul(fz, fz), k)), one);
+    }
+    return f;
+}
+
+/// Store [TL, TR, BR, BL] = centre ∓ right·halfW ± up·halfH, centre =
+/// camera + forward·d, for the lane block at \a i.
+template <typename L>
+inline void storeFrustumCorners(const FrameLanes<L>& f,
+                                typename L::V px, typename L::V py, typename L::V pz,
+                                typename L::V d, typename L::V hw, typename L::V hh,
+                                const std::array<Vec3Span, 4>& corners, std::size_t i) noexcept
+{
+    const auto cx = L::add(px, L::mul(f.fx, d));
+    const auto cy = L::add(py, L::mul(f.fy, d));
+    const auto cz = L::add(pz, L::mul(f.fz, d));
+
+    const auto wx = L::mul(f.rx, hw), wy = L::mul(f.ry, hw), wz = L::mul(f.rz, hw);
+    const auto hx = L::mul(f.ux, hh), hy = L::mul(f.uy, hh), hz = L::mul(f.uz, hh);
+
+    const Vec3Span& tl = corners[0];
+    L::store(tl.x + i, L::add(L::sub(cx, wx), hx));
+    L::store(tl.y + i, L::add(L::sub(cy, wy), hy));
+    L::store(tl.z + i, L::add(L::sub(cz, wz), hz));
+    const Vec3Span& tr = corners[1];
+    L::store(tr.x + i, L::add(L::add(cx, wx), hx));
+    L::store(tr.y + i, L::add(L::add(cy, wy), hy));
+    L::store(tr.z + i, L::add(L::add(cz, wz), hz));
+    const Vec3Span& br = corners[2];
+    L::store(br.x + i, L::sub(L::add(cx, wx), hx));
+    L::store(br.y + i, L::sub(L::add(cy, wy), hy));
+    L::store(br.z + i, L::sub(L::add(cz, wz), hz));
+    const Vec3Span& bl = corners[3];
+    L::store(bl.x + i, L::sub(L::sub(cx, wx), hx));
+    L::store(bl.y + i, L::sub(L::sub(cy, wy), hy));
+    L::store(bl.z + i, L::sub(L::sub(cz, wz), hz));
+}
+
+template <typename L, FrustumBasis B>
+inline std::size_t frustumCornersLanes(ConstVec3Span cameraPos, ConstVec3Span viewDir,
+                                       RollSpan roll, std::size_t n, float focusDistance,
+                                       float halfW, float halfH,
+                                       const std::array<Vec3Span, 4>& corners) noexcept
+{
+    const auto d  = L::set1(focusDistance);
+    const auto hw = L::set1(halfW);
+    const auto hh = L::set1(halfH);
+
+    std::size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        auto fx = L::load(viewDir.x + i), fy = L::load(viewDir.y + i),
+             fz = L::load(viewDir.z + i);
+        const auto invF = inverseLength<L>(fx, fy, fz);
+        fx = L::mul(fx, invF);  fy = L::mul(fy, invF);  fz = L::mul(fz, invF);
+
+        FrameLanes<L> f = frustumFrame<L, B>(fx, fy, fz);
+        if (roll.cos) {
+            const auto c = L::load(roll.cos + i), s = L::load(roll.sin + i);
+            const auto rx = L::add(L::mul(f.rx, c), L::mul(f.ux, s));
+            const auto ry = L::add(L::mul(f.ry, c), L::mul(f.uy, s));
+            const auto rz = L::add(L::mul(f.rz, c), L::mul(f.uz, s));
+            f.ux = L::sub(L::mul(f.ux, c), L::mul(f.rx, s));
+            f.uy = L::sub(L::mul(f.uy, c), L::mul(f.ry, s));
+            f.uz = L::sub(L::mul(f.uz, c), L::mul(f.rz, s));
+            f.rx = rx;  f.ry = ry;  f.rz = rz;
+        }
+
+        storeFrustumCorners<L>(f, L::load(cameraPos.x + i), L::load(cameraPos.y + i),
+                               L::load(cameraPos.z + i), d, hw, hh, corners, i);
+    }
+    return i;
+}
+
+/// Camera poses in the x right / y down / optical axis +Z convention:
+/// forward = q·Z, right = q·X, up = −(q·Y).
+template <typename L>
+inline std::size_t frustumCornersPoseLanes(ConstVec3Span cameraPos, ConstQuatSpan orientation,
+                                           std::size_t n, float focusDistance,
+                                           float halfW, float halfH,
+                                           const std::array<Vec3Span, 4>& corners) noexcept
+{
+    const auto zero = L::set1(0.0f);
+    const auto one  = L::set1(1.0f);
+    const auto two  = L::set1(2.0f);
+    const auto d    = L::set1(focusDistance);
+    const auto hw   = L::set1(halfW);
+    const auto hh   = L::set1(halfH);
+
+    std::size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        const auto w = L::load(orientation.w + i), x = L::load(orientation.x + i),
+                   y = L::load(orientation.y + i), z = L::load(orientation.z + i);
+
+        // Rotation matrix columns, scaled by 2 / |q|² so a quaternion that is
+        // not quite unit length still yields a rotation.
+        const auto n2 = L::add(L::add(L::mul(w, w), L::mul(x, x)),
+                               L::add(L::mul(y, y), L::mul(z, z)));
+        const auto s  = L::select(L::gt(n2, zero), L::div(two, n2), zero);
+        const auto sx = L::mul(x, s), sy = L::mul(y, s), sz = L::mul(z, s);
+        const auto xx = L::mul(x, sx), yy = L::mul(y, sy), zz = L::mul(z, sz);
+        const auto xy = L::mul(x, sy), xz = L::mul(x, sz), yz = L::mul(y, sz);
+        const auto wx = L::mul(w, sx), wy = L::mul(w, sy), wz = L::mul(w, sz);
+
+        FrameLanes<L> f;
+        f.rx = L::sub(one, L::add(yy, zz));
+        f.ry = L::add(xy, wz);
+        f.rz = L::sub(xz, wy);
+        f.ux = L::sub(wz, xy);
+        f.uy = L::sub(L::add(xx, zz), one);
+        f.uz = L::sub(zero, L::add(yz, wx));
+        f.fx = L::add(xz, wy);
+        f.fy = L::sub(yz, wx);
+        f.fz = L::sub(one, L::add(xx, yy));
+
+        storeFrustumCorners<L>(f, L::load(cameraPos.x + i), L::load(cameraPos.y + i),
+                               L::load(cameraPos.z + i), d, hw, hh, corners, i);
+    }
+    return i;
+}
+
+inline Vec3Span offset(Vec3Span s, std::size_t i) noexcept
+{
+    return { s.x + i, s.y + i, s.z + i };
+}
+
+inline ConstVec3Span offset(ConstVec3Span s, std::size_t i) noexcept
+{
+    return { s.x + i, s.y + i, s.z + i };
+}
+
+inline ConstQuatSpan offset(ConstQuatSpan s, std::size_t i) noexcept
+{
+    return { s.w + i, s.x + i, s.y + i, s.z + i };
+}
+
+inline RollSpan offset(RollSpan s, std::size_t i) noexcept
+{
+    return s.cos ? RollSpan{ s.cos + i, s.sin + i } : RollSpan{};
+}
+
+inline std::array<Vec3Span, 4> offset(const std::array<Vec3Span, 4>& s, std::size_t i) noexcept
+{
+    return { offset(s[0], i), offset(s[1], i), offset(s[2], i), offset(s[3], i) };
+}
+
+template <FrustumBasis B>
+inline void frustumCornersRun(ConstVec3Span cameraPos, ConstVec3Span viewDir, RollSpan roll,
+                           std::size_t n, float d, float hw, float hh,
+                           const std::array<Vec3Span, 4>& corners) noexcept
+{
+    const std::size_t i = frustumCornersLanes<FloatLanes, B>(
+        cameraPos, viewDir, roll, n, d, hw, hh, corners);
+    if (i == n) return;
+    frustumCornersLanes<ScalarLanes<float>, B>(
+        offset(cameraPos, i), offset(viewDir, i), offset(roll, i), n - i, d, hw, hh,
+        offset(corners, i));
+}
+
+/// Half extents of the focal-plane rectangle.
+inline float halfExtent(double focusDistance, double fovDeg) noexcept
+{
+    return static_cast<float>(focusDistance * std::tan(qDegreesToRadians(fovDeg / 2.0)));
+}
+
+} // namespace detail
+
+/// worldToPixel() for \a n points given as parallel X / Y arrays.
+inline void worldToPixelBatch(const double* worldX, const double* worldY, std::size_t n,
+                              double originX, double originY, double resolution,
+                              double* u, double* v) noexcept
+{
+    const std::size_t i = detail::worldToPixelLanes<detail::DoubleLanes>(
+        worldX, worldY, n, originX, originY, resolution, u, v);
+    detail::worldToPixelLanes<detail::ScalarLanes<double>>(
+        worldX + i, worldY + i, n - i, originX, originY, resolution, u + i, v + i);
+}
+
+/// worldToPixel() in place over \a n world points, e.g. a whole navigation
+/// path gathered into a QVector<QPointF>.
+inline void worldToPixelBatch(QPointF* points, std::size_t n,
+                              double originX, double originY,
+                              double resolution) noexcept
+{
+    static_assert(sizeof(QPointF) == 2 * sizeof(double),
+                  "QPointF must be two doubles (qreal == double)");
+    double* xy = reinterpret_cast<double*>(points);
+    const std::size_t i = detail::worldToPixelInterleavedLanes<detail::DoubleLanes>(
+        xy, 2 * n, originX, originY, resolution);
+    for (std::size_t p = i / 2; p < n; ++p) {
+        points[p] = worldToPixel(points[p].x(), points[p].y(), originX, originY, resolution);
+    }
+}
+
+/// pixelToWorld() for \a n points given as parallel U / V arrays.
+inline void pixelToWorldBatch(const double* u, const double* v, std::size_t n,
+                              double originX, double originY, double resolution,
+                              double* worldX, double* worldY) noexcept
+{
+    const std::size_t i = detail::pixelToWorldLanes<detail::DoubleLanes>(
+        u, v, n, originX, originY, resolution, worldX, worldY);
+    detail::pixelToWorldLanes<detail::ScalarLanes<double>>(
+        u + i, v + i, n - i, originX, originY, resolution, worldX + i, worldY + i);
+}
+
+/// cameraPosition() for \a n surface points sharing one focus distance.
+inline void cameraPositionBatch(ConstVec3Span surfacePos, ConstVec3Span viewDir,
+                                std::size_t n, double focusDistance,
+                                Vec3Span cameraPos) noexcept
+{
+    const float d = static_cast<float>(focusDistance);
+    const std::size_t i = detail::cameraPositionLanes<detail::FloatLanes>(
+        surfacePos, viewDir, n, d, cameraPos);
+    detail::cameraPositionLanes<detail::ScalarLanes<float>>(
+        detail::offset(surfacePos, i), detail::offset(viewDir, i), n - i, d,
+        detail::offset(cameraPos, i));
+}
+
+/// frustumCorners() for \a n cameras sharing one focus distance and field
+/// of view.  \a corners receives the [TL, TR, BR, BL] corner arrays, each
+/// with room for \a n points.  \a basis picks the image axes around each
+/// view direction and \a roll, when set, turns them about it.
+inline void frustumCornersBatch(ConstVec3Span cameraPos, ConstVec3Span viewDir,
+                                std::size_t n, double focusDistance,
+                                double fovHDeg, double fovVDeg,
+                                const std::array<Vec3Span, 4>& corners,
+                                FrustumBasis basis = FrustumBasis::WorldUp,
+                                RollSpan roll = {}) noexcept
+{
+    const float d  = static_cast<float>(focusDistance);
+    const float hw = detail::halfExtent(focusDistance, fovHDeg);
+    const float hh = detail::halfExtent(focusDistance, fovVDeg);
+    if (basis == FrustumBasis::WorldUp) {
+        detail::frustumCornersRun<FrustumBasis::WorldUp>(
+            cameraPos, viewDir, roll, n, d, hw, hh, corners);
+    } else {
+        detail::frustumCornersRun<FrustumBasis::ShortestArc>(
+            cameraPos, viewDir, roll, n, d, hw, hh, corners);
+    }
+}
+
+/// Frustum corners for \a n camera poses (x right, y down, optical axis +Z;
+/// the camera-pose convention of the plan), [TL, TR, BR, BL] as above with
+/// "up" the image's up (−Y).
+inline void frustumCornersBatch(ConstVec3Span cameraPos, ConstQuatSpan orientation,
+                                std::size_t n, double focusDistance,
+                                double fovHDeg, double fovVDeg,
+                                const std::array<Vec3Span, 4>& corners) noexcept
+{
+    const float d  = static_cast<float>(focusDistance);
+    const float hw = detail::halfExtent(focusDistance, fovHDeg);
+    const float hh = detail::halfExtent(focusDistance, fovVDeg);
+    const std::size_t i = detail::frustumCornersPoseLanes<detail::FloatLanes>(
+        cameraPos, orientation, n, d, hw, hh, corners);
+    if (i == n) return;
+    detail::frustumCornersPoseLanes<detail::ScalarLanes<float>>(
+        detail::offset(cameraPos, i), detail::offset(orientation, i), n - i, d, hw, hh,
+        detail::offset(corners, i));
+}
+
 // ---------------------------------------------------------------------------
 // Angle unit conversion
 // ---------------------------------------------------------------------------